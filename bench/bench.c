@@ -0,0 +1,237 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+
+#define ZP_BENCH_DEFAULT_SAMPLE_MS 100
+#define ZP_BENCH_DEFAULT_SAMPLES 5
+#define ZP_BENCH_MAX_SAMPLES 64
+#define ZP_BENCH_MAX_ITERS ((size_t)1 << 34)
+
+typedef struct {
+    char *name;
+    size_t iters;
+    size_t samples;
+    double ns_min;
+    double ns_median;
+    double ns_mean;
+    double ns_max;
+} zp_bench_result_t;
+
+struct zp_bench_t {
+    const char *filter;
+    unsigned long sample_us;
+    size_t samples;
+    bool list_only;
+    zp_bench_result_t *results;
+    size_t results_len;
+    size_t results_cap;
+};
+
+static volatile const void *zp_bench_sink;
+
+void zp_bench_do_not_optimize(const void *p) { zp_bench_sink = p; }
+
+bool zp_bench_enabled(const zp_bench_t *b, const char *name) {
+    return b->filter == NULL || strstr(name, b->filter) != NULL;
+}
+
+static unsigned long zp_bench_measure_us(zp_bench_fn_t fn, void *ctx, size_t iters) {
+    z_clock_t start = z_clock_now();
+    fn(ctx, iters);
+    return z_clock_elapsed_us(&start);
+}
+
+static char *zp_bench_strdup(const char *s) {
+    size_t len = strlen(s) + 1;
+    char *ret = (char *)malloc(len);
+    if (ret != NULL) {
+        memcpy(ret, s, len);
+    }
+    return ret;
+}
+
+static int zp_bench_cmp_double(const void *a, const void *b) {
+    double l = *(const double *)a;
+    double r = *(const double *)b;
+    return (l > r) - (l < r);
+}
+
+static void zp_bench_record(zp_bench_t *b, const zp_bench_result_t *res) {
+    if (res->name == NULL) {
+        return;
+    }
+    if (b->results_len == b->results_cap) {
+        size_t cap = (b->results_cap == 0) ? 32 : b->results_cap * 2;
+        zp_bench_result_t *results = (zp_bench_result_t *)realloc(b->results, cap * sizeof(zp_bench_result_t));
+        if (results == NULL) {
+            fprintf(stderr, "Failed to record result of %s\n", res->name);
+            free(res->name);
+            return;
+        }
+        b->results = results;
+        b->results_cap = cap;
+    }
+    b->results[b->results_len++] = *res;
+}
+
+void zp_bench_run(zp_bench_t *b, const char *name, zp_bench_fn_t fn, void *ctx) {
+    if (!zp_bench_enabled(b, name)) {
+        return;
+    }
+    if (b->list_only) {
+        printf("%s\n", name);
+        return;
+    }
+    // Calibrate the number of iterations so that one sample lasts at least sample_us, this also warms up caches
+    size_t iters = 1;
+    for (;;) {
+        unsigned long elapsed = zp_bench_measure_us(fn, ctx, iters);
+        if (elapsed >= b->sample_us || iters >= ZP_BENCH_MAX_ITERS) {
+            break;
+        }
+        size_t next = iters * 100;
+        if (elapsed > 0) {
+            double scaled = (double)iters * (double)b->sample_us * 1.2 / (double)elapsed;
+            if (scaled < (double)next) {
+                next = (size_t)scaled;
+            }
+        }
+        iters = (next > iters) ? next : iters + 1;
+    }
+    double ns[ZP_BENCH_MAX_SAMPLES];
+    double sum = 0.0;
+    for (size_t i = 0; i < b->samples; i++) {
+        unsigned long elapsed = zp_bench_measure_us(fn, ctx, iters);
+        ns[i] = (double)elapsed * 1000.0 / (double)iters;
+        sum += ns[i];
+    }
+    qsort(ns, b->samples, sizeof(double), zp_bench_cmp_double);
+
+    zp_bench_result_t res;
+    res.name = zp_bench_strdup(name);
+    res.iters = iters;
+    res.samples = b->samples;
+    res.ns_min = ns[0];
+    res.ns_max = ns[b->samples - 1];
+    res.ns_mean = sum / (double)b->samples;
+    res.ns_median =
+        (b->samples % 2 == 1) ? ns[b->samples / 2] : (ns[b->samples / 2 - 1] + ns[b->samples / 2]) / 2.0;
+    fprintf(stderr, "%-56s %12.1f ns/op (min %.1f, max %.1f, %zu iters)\n", name, res.ns_median, res.ns_min,
+            res.ns_max, iters);
+    zp_bench_record(b, &res);
+}
+
+static void zp_bench_write_json(const zp_bench_t *b, FILE *out) {
+    fprintf(out, "{\n");
+    fprintf(out, "  \"suite\": \"zenohpico_bench\",\n");
+    fprintf(out, "  \"version\": \"%s\",\n", ZENOH_PICO);
+    fprintf(out, "  \"config\": {\n");
+    fprintf(out, "    \"sample_ms\": %lu,\n", b->sample_us / 1000);
+    fprintf(out, "    \"samples\": %zu,\n", b->samples);
+    fprintf(out, "    \"multi_thread\": %d,\n", Z_FEATURE_MULTI_THREAD);
+    fprintf(out, "    \"rx_cache\": %d,\n", Z_FEATURE_RX_CACHE);
+    fprintf(out, "    \"local_subscriber\": %d,\n", Z_FEATURE_LOCAL_SUBSCRIBER);
+    fprintf(out, "    \"batch_unicast_size\": %d\n", Z_BATCH_UNICAST_SIZE);
+    fprintf(out, "  },\n");
+    fprintf(out, "  \"benchmarks\": [");
+    for (size_t i = 0; i < b->results_len; i++) {
+        const zp_bench_result_t *r = &b->results[i];
+        fprintf(out, "%s\n    {\"name\": \"%s\", \"iterations\": %zu, \"samples\": %zu, ", (i == 0) ? "" : ",",
+                r->name, r->iters, r->samples);
+        fprintf(out, "\"ns_per_op\": {\"min\": %.3f, \"median\": %.3f, \"mean\": %.3f, \"max\": %.3f}, ", r->ns_min,
+                r->ns_median, r->ns_mean, r->ns_max);
+        fprintf(out, "\"ops_per_sec\": %.1f}", (r->ns_median > 0.0) ? 1e9 / r->ns_median : 0.0);
+    }
+    fprintf(out, "%s]\n}\n", (b->results_len == 0) ? "" : "\n  ");
+}
+
+static void zp_bench_usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [OPTIONS]\n"
+            "  -f, --filter <SUBSTR>   Only run benchmarks whose name contains SUBSTR\n"
+            "  -t, --sample-ms <MS>    Minimum duration of one sample (default: %d)\n"
+            "  -n, --samples <N>       Number of samples per benchmark (default: %d, max: %d)\n"
+            "  -o, --output <FILE>     Write the JSON report to FILE instead of stdout\n"
+            "  -l, --list              List the benchmark names and exit\n",
+            prog, ZP_BENCH_DEFAULT_SAMPLE_MS, ZP_BENCH_DEFAULT_SAMPLES, ZP_BENCH_MAX_SAMPLES);
+}
+
+int main(int argc, char **argv) {
+    zp_bench_t b = {0};
+    b.sample_us = ZP_BENCH_DEFAULT_SAMPLE_MS * 1000UL;
+    b.samples = ZP_BENCH_DEFAULT_SAMPLES;
+    const char *output = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(arg, "-f") == 0 || strcmp(arg, "--filter") == 0) {
+            b.filter = val;
+            i++;
+        } else if (strcmp(arg, "-t") == 0 || strcmp(arg, "--sample-ms") == 0) {
+            b.sample_us = (val != NULL) ? strtoul(val, NULL, 10) * 1000UL : 0;
+            i++;
+        } else if (strcmp(arg, "-n") == 0 || strcmp(arg, "--samples") == 0) {
+            b.samples = (val != NULL) ? strtoul(val, NULL, 10) : 0;
+            i++;
+        } else if (strcmp(arg, "-o") == 0 || strcmp(arg, "--output") == 0) {
+            output = val;
+            i++;
+        } else if (strcmp(arg, "-l") == 0 || strcmp(arg, "--list") == 0) {
+            b.list_only = true;
+        } else {
+            zp_bench_usage(argv[0]);
+            return (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) ? 0 : 1;
+        }
+        if (i >= argc) {
+            zp_bench_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (b.samples == 0 || b.samples > ZP_BENCH_MAX_SAMPLES || b.sample_us == 0) {
+        zp_bench_usage(argv[0]);
+        return 1;
+    }
+
+    zp_bench_suite_codec(&b);
+    zp_bench_suite_keyexpr(&b);
+    zp_bench_suite_collections(&b);
+    zp_bench_suite_session(&b);
+
+    int ret = 0;
+    if (!b.list_only) {
+        FILE *out = (output != NULL) ? fopen(output, "w") : stdout;
+        if (out == NULL) {
+            fprintf(stderr, "Failed to open %s\n", output);
+            ret = 1;
+        } else {
+            zp_bench_write_json(&b, out);
+            if (out != stdout) {
+                fclose(out);
+            }
+        }
+    }
+    for (size_t i = 0; i < b.results_len; i++) {
+        free(b.results[i].name);
+    }
+    free(b.results);
+    return ret;
+}
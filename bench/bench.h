@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_BENCH_BENCH_H
+#define ZENOH_PICO_BENCH_BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct zp_bench_t zp_bench_t;
+
+/**
+ * A benchmark body. It must perform `iters` operations on `ctx`, the reported figures are per operation.
+ */
+typedef void (*zp_bench_fn_t)(void *ctx, size_t iters);
+
+/**
+ * Calibrates, runs and records the benchmark `name` if it is selected by the command line filter.
+ * Setup and teardown of `ctx` are done by the caller, around this call.
+ */
+void zp_bench_run(zp_bench_t *b, const char *name, zp_bench_fn_t fn, void *ctx);
+
+/**
+ * Returns true if the benchmark `name` is selected by the command line filter, so that suites can skip expensive
+ * setups.
+ */
+bool zp_bench_enabled(const zp_bench_t *b, const char *name);
+
+/**
+ * Prevents the compiler from optimizing away a computed value.
+ */
+void zp_bench_do_not_optimize(const void *p);
+
+// Suites, one per translation unit
+void zp_bench_suite_codec(zp_bench_t *b);
+void zp_bench_suite_keyexpr(zp_bench_t *b);
+void zp_bench_suite_collections(zp_bench_t *b);
+void zp_bench_suite_session(zp_bench_t *b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_BENCH_BENCH_H */
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "zenoh-pico/collections/arc_slice.h"
+#include "zenoh-pico/collections/bytes.h"
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/session/keyexpr.h"
+
+#define BENCH_KEYEXPR "robot/fleet/unit-042/sensors/lidar/front/points"
+#define BENCH_IOBUF_CHUNK 64
+
+static const size_t BENCH_PAYLOAD_SIZES[] = {8, 64, 1024};
+
+typedef struct {
+    _z_network_message_t msg;
+    _z_bytes_t payload;
+    _z_wbuf_t wbf;
+    _z_zbuf_t zbf;
+} bench_push_ctx_t;
+
+static z_result_t bench_push_ctx_init(bench_push_ctx_t *ctx, const uint8_t *data, size_t len) {
+    memset(ctx, 0, sizeof(*ctx));
+    _Z_RETURN_IF_ERR(_z_bytes_from_buf(&ctx->payload, data, len));
+    _z_keyexpr_t ke = _z_keyexpr_alias_from_str(BENCH_KEYEXPR);
+    _z_wireexpr_t wireexpr = _z_keyexpr_alias_to_wire(&ke);
+    _z_encoding_t encoding = _z_encoding_null();
+    _z_timestamp_t ts = _z_timestamp_null();
+    _z_bytes_t attachment = _z_bytes_null();
+    _z_source_info_t source_info = _z_source_info_null();
+    _z_n_msg_make_push_put(&ctx->msg, &wireexpr, &ctx->payload, &encoding, _Z_N_QOS_DEFAULT, &ts, &attachment,
+                           Z_RELIABILITY_RELIABLE, &source_info);
+    ctx->wbf = _z_wbuf_make(Z_BATCH_UNICAST_SIZE, false);
+    if (_z_wbuf_capacity(&ctx->wbf) == 0) {
+        _z_bytes_drop(&ctx->payload);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _z_network_message_encode(&ctx->wbf, &ctx->msg);
+}
+
+static void bench_push_ctx_clear(bench_push_ctx_t *ctx) {
+    _z_zbuf_clear(&ctx->zbf);
+    _z_wbuf_clear(&ctx->wbf);
+    _z_bytes_drop(&ctx->payload);
+}
+
+static void bench_push_encode(void *arg, size_t iters) {
+    bench_push_ctx_t *ctx = (bench_push_ctx_t *)arg;
+    for (size_t i = 0; i < iters; i++) {
+        _z_wbuf_reset(&ctx->wbf);
+        (void)_z_network_message_encode(&ctx->wbf, &ctx->msg);
+    }
+    zp_bench_do_not_optimize(&ctx->wbf);
+}
+
+static void bench_push_decode(void *arg, size_t iters) {
+    bench_push_ctx_t *ctx = (bench_push_ctx_t *)arg;
+    for (size_t i = 0; i < iters; i++) {
+        _z_network_message_t decoded;
+        _z_arc_slice_t arcs = _z_arc_slice_empty();
+        _z_zbuf_set_rpos(&ctx->zbf, 0);
+        (void)_z_network_message_decode(&decoded, &ctx->zbf, &arcs, _Z_KEYEXPR_MAPPING_LOCAL);
+        zp_bench_do_not_optimize(&decoded);
+        _z_n_msg_clear(&decoded);
+        _z_arc_slice_drop(&arcs);
+    }
+}
+
+static void bench_codec_push(zp_bench_t *b) {
+    static uint8_t data[1024];
+    memset(data, 0xa5, sizeof(data));
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(BENCH_PAYLOAD_SIZES); i++) {
+        size_t len = BENCH_PAYLOAD_SIZES[i];
+        char enc_name[64];
+        char dec_name[64];
+        snprintf(enc_name, sizeof(enc_name), "codec/push_put/encode/%zuB", len);
+        snprintf(dec_name, sizeof(dec_name), "codec/push_put/decode/%zuB", len);
+        if (!zp_bench_enabled(b, enc_name) && !zp_bench_enabled(b, dec_name)) {
+            continue;
+        }
+        bench_push_ctx_t ctx;
+        if (bench_push_ctx_init(&ctx, data, len) != _Z_RES_OK) {
+            fprintf(stderr, "Failed to set up %s\n", enc_name);
+            bench_push_ctx_clear(&ctx);
+            continue;
+        }
+        zp_bench_run(b, enc_name, bench_push_encode, &ctx);
+        ctx.zbf = _z_wbuf_to_zbuf(&ctx.wbf);
+        zp_bench_run(b, dec_name, bench_push_decode, &ctx);
+        bench_push_ctx_clear(&ctx);
+    }
+}
+
+typedef struct {
+    _z_wbuf_t wbf;
+    _z_zbuf_t zbf;
+    uint8_t chunk[BENCH_IOBUF_CHUNK];
+} bench_iobuf_ctx_t;
+
+static void bench_wbuf_write(void *arg, size_t iters) {
+    bench_iobuf_ctx_t *ctx = (bench_iobuf_ctx_t *)arg;
+    for (size_t i = 0; i < iters; i++) {
+        if (_z_wbuf_space_left(&ctx->wbf) == 0) {
+            _z_wbuf_reset(&ctx->wbf);
+        }
+        (void)_z_wbuf_write(&ctx->wbf, (uint8_t)i);
+    }
+    zp_bench_do_not_optimize(&ctx->wbf);
+}
+
+static void bench_wbuf_write_bytes(void *arg, size_t iters) {
+    bench_iobuf_ctx_t *ctx = (bench_iobuf_ctx_t *)arg;
+    for (size_t i = 0; i < iters; i++) {
+        if (_z_wbuf_space_left(&ctx->wbf) < BENCH_IOBUF_CHUNK) {
+            _z_wbuf_reset(&ctx->wbf);
+        }
+        (void)_z_wbuf_write_bytes(&ctx->wbf, ctx->chunk, 0, BENCH_IOBUF_CHUNK);
+    }
+    zp_bench_do_not_optimize(&ctx->wbf);
+}
+
+static void bench_zbuf_read(void *arg, size_t iters) {
+    bench_iobuf_ctx_t *ctx = (bench_iobuf_ctx_t *)arg;
+    uint8_t acc = 0;
+    for (size_t i = 0; i < iters; i++) {
+        if (!_z_zbuf_can_read(&ctx->zbf)) {
+            _z_zbuf_set_rpos(&ctx->zbf, 0);
+        }
+        acc ^= _z_zbuf_read(&ctx->zbf);
+    }
+    zp_bench_do_not_optimize(&acc);
+}
+
+static void bench_zbuf_read_bytes(void *arg, size_t iters) {
+    bench_iobuf_ctx_t *ctx = (bench_iobuf_ctx_t *)arg;
+    for (size_t i = 0; i < iters; i++) {
+        if (_z_zbuf_len(&ctx->zbf) < BENCH_IOBUF_CHUNK) {
+            _z_zbuf_set_rpos(&ctx->zbf, 0);
+        }
+        _z_zbuf_read_bytes(&ctx->zbf, ctx->chunk, 0, BENCH_IOBUF_CHUNK);
+    }
+    zp_bench_do_not_optimize(ctx->chunk);
+}
+
+static void bench_codec_iobuf(zp_bench_t *b) {
+    bench_iobuf_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.wbf = _z_wbuf_make(Z_BATCH_UNICAST_SIZE, false);
+    ctx.zbf = _z_zbuf_make(Z_BATCH_UNICAST_SIZE);
+    if (_z_wbuf_capacity(&ctx.wbf) == 0 || _z_zbuf_capacity(&ctx.zbf) == 0) {
+        fprintf(stderr, "Failed to set up iobuf benchmarks\n");
+    } else {
+        _z_zbuf_set_wpos(&ctx.zbf, _z_zbuf_capacity(&ctx.zbf));
+        zp_bench_run(b, "iobuf/wbuf/write/1B", bench_wbuf_write, &ctx);
+        zp_bench_run(b, "iobuf/wbuf/write_bytes/64B", bench_wbuf_write_bytes, &ctx);
+        zp_bench_run(b, "iobuf/zbuf/read/1B", bench_zbuf_read, &ctx);
+        zp_bench_run(b, "iobuf/zbuf/read_bytes/64B", bench_zbuf_read_bytes, &ctx);
+    }
+    _z_zbuf_clear(&ctx.zbf);
+    _z_wbuf_clear(&ctx.wbf);
+}
+
+void zp_bench_suite_codec(zp_bench_t *b) {
+    bench_codec_push(b);
+    bench_codec_iobuf(b);
+}
@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "zenoh-pico/collections/ring_mt.h"
+#include "zenoh-pico/system/common/platform.h"
+
+#define BENCH_MAP_SIZE 1024u
+#define BENCH_RING_CAPACITY 256
+
+static inline size_t bench_u32_hash(const uint32_t *k) { return (size_t)(*k * 2654435761u); }
+static inline bool bench_u32_eq(const uint32_t *a, const uint32_t *b) { return *a == *b; }
+
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE uint32_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE uint32_t
+#define _ZP_HASHMAP_TEMPLATE_NAME bench_u32map
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN bench_u32_hash
+#define _ZP_HASHMAP_TEMPLATE_KEY_EQ_FN bench_u32_eq
+#include "zenoh-pico/collections/hashmap_template.h"
+
+#define _ZP_VECTOR_TEMPLATE_ELEM_TYPE uint32_t
+#define _ZP_VECTOR_TEMPLATE_NAME bench_u32vec
+#include "zenoh-pico/collections/vector_template.h"
+
+// Map insertion, the map is cleared every BENCH_MAP_SIZE entries so that growth is part of the measurement
+static void bench_hashmap_insert(void *arg, size_t iters) {
+    bench_u32map_t *map = (bench_u32map_t *)arg;
+    for (size_t i = 0; i < iters; i++) {
+        uint32_t key = (uint32_t)(i % BENCH_MAP_SIZE);
+        uint32_t val = key;
+        if (key == 0) {
+            bench_u32map_destroy(map);
+        }
+        (void)bench_u32map_insert(map, &key, &val);
+    }
+    zp_bench_do_not_optimize(map);
+}
+
+static void bench_hashmap_get(void *arg, size_t iters) {
+    bench_u32map_t *map = (bench_u32map_t *)arg;
+    uint32_t acc = 0;
+    for (size_t i = 0; i < iters; i++) {
+        uint32_t key = (uint32_t)(i % BENCH_MAP_SIZE);
+        const uint32_t *val = bench_u32map_get(map, &key);
+        acc += (val != NULL) ? *val : 0;
+    }
+    zp_bench_do_not_optimize(&acc);
+}
+
+static void bench_hashmap_get_miss(void *arg, size_t iters) {
+    bench_u32map_t *map = (bench_u32map_t *)arg;
+    size_t hits = 0;
+    for (size_t i = 0; i < iters; i++) {
+        uint32_t key = (uint32_t)(BENCH_MAP_SIZE + (i % BENCH_MAP_SIZE));
+        hits += bench_u32map_contains(map, &key) ? 1u : 0u;
+    }
+    zp_bench_do_not_optimize(&hits);
+}
+
+// Remove followed by re-insert of the same key, to keep the map size stable
+static void bench_hashmap_remove_insert(void *arg, size_t iters) {
+    bench_u32map_t *map = (bench_u32map_t *)arg;
+    for (size_t i = 0; i < iters; i++) {
+        uint32_t key = (uint32_t)(i % BENCH_MAP_SIZE);
+        uint32_t val = 0;
+        (void)bench_u32map_remove(map, &key, &val);
+        (void)bench_u32map_insert(map, &key, &val);
+    }
+    zp_bench_do_not_optimize(map);
+}
+
+static void bench_collections_hashmap(zp_bench_t *b) {
+    bench_u32map_t map = bench_u32map_new();
+    zp_bench_run(b, "collections/hashmap/insert/1024", bench_hashmap_insert, &map);
+    bench_u32map_destroy(&map);
+    for (uint32_t i = 0; i < BENCH_MAP_SIZE; i++) {
+        uint32_t key = i;
+        uint32_t val = i;
+        (void)bench_u32map_insert(&map, &key, &val);
+    }
+    zp_bench_run(b, "collections/hashmap/get_hit/1024", bench_hashmap_get, &map);
+    zp_bench_run(b, "collections/hashmap/get_miss/1024", bench_hashmap_get_miss, &map);
+    zp_bench_run(b, "collections/hashmap/remove_insert/1024", bench_hashmap_remove_insert, &map);
+    bench_u32map_destroy(&map);
+}
+
+static void bench_vector_push_back(void *arg, size_t iters) {
+    bench_u32vec_t *vec = (bench_u32vec_t *)arg;
+    for (size_t i = 0; i < iters; i++) {
+        uint32_t elem = (uint32_t)i;
+        if (bench_u32vec_size(vec) == BENCH_MAP_SIZE) {
+            bench_u32vec_destroy(vec);
+        }
+        (void)bench_u32vec_push_back(vec, &elem);
+    }
+    zp_bench_do_not_optimize(vec);
+}
+
+// One operation is a full scan of a BENCH_MAP_SIZE elements vector
+static void bench_vector_iterate(void *arg, size_t iters) {
+    bench_u32vec_t *vec = (bench_u32vec_t *)arg;
+    uint32_t acc = 0;
+    for (size_t i = 0; i < iters; i++) {
+        size_t len = bench_u32vec_size(vec);
+        for (size_t j = 0; j < len; j++) {
+            acc += *bench_u32vec_get(vec, j);
+        }
+        zp_bench_do_not_optimize(&acc);
+    }
+}
+
+static void bench_collections_vector(zp_bench_t *b) {
+    bench_u32vec_t vec = bench_u32vec_new();
+    zp_bench_run(b, "collections/vector/push_back/1024", bench_vector_push_back, &vec);
+    bench_u32vec_destroy(&vec);
+    for (uint32_t i = 0; i < BENCH_MAP_SIZE; i++) {
+        uint32_t elem = i;
+        (void)bench_u32vec_push_back(&vec, &elem);
+    }
+    zp_bench_run(b, "collections/vector/iterate/1024", bench_vector_iterate, &vec);
+    bench_u32vec_destroy(&vec);
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+typedef struct {
+    _z_ring_mt_t ring;
+    size_t received;
+} bench_ring_ctx_t;
+
+static uint32_t bench_ring_token = 42;
+
+static void bench_ring_elem_free(void **elem) { *elem = NULL; }
+
+static void bench_ring_elem_move(void *dst, void *src) { *(void **)dst = src; }
+
+static void *bench_ring_consumer(void *arg) {
+    bench_ring_ctx_t *ctx = (bench_ring_ctx_t *)arg;
+    void *elem = NULL;
+    while (_z_ring_mt_pull(&elem, &ctx->ring, bench_ring_elem_move) == _Z_RES_OK) {
+        ctx->received++;
+    }
+    return NULL;
+}
+
+// One operation is one push handed off to a consumer thread. The ring drops the oldest element when full, as the
+// ring handler does, so this measures the producer side of the handoff under contention.
+static void bench_ring_mt_push(void *arg, size_t iters) {
+    bench_ring_ctx_t *ctx = (bench_ring_ctx_t *)arg;
+    for (size_t i = 0; i < iters; i++) {
+        (void)_z_ring_mt_push(&bench_ring_token, &ctx->ring, bench_ring_elem_free);
+    }
+}
+
+static void bench_collections_ring_mt(zp_bench_t *b) {
+    const char *name = "collections/ring_mt/handoff";
+    if (!zp_bench_enabled(b, name)) {
+        return;
+    }
+    bench_ring_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    if (_z_ring_mt_init(&ctx.ring, BENCH_RING_CAPACITY) != _Z_RES_OK) {
+        fprintf(stderr, "Failed to set up %s\n", name);
+        return;
+    }
+    _z_task_t consumer;
+    if (_z_task_init(&consumer, NULL, bench_ring_consumer, &ctx) != _Z_RES_OK) {
+        fprintf(stderr, "Failed to start the consumer of %s\n", name);
+    } else {
+        zp_bench_run(b, name, bench_ring_mt_push, &ctx);
+        (void)_z_ring_mt_close(&ctx.ring);
+        (void)_z_task_join(&consumer);
+    }
+    _z_ring_mt_clear(&ctx.ring, bench_ring_elem_free);
+}
+#endif
+
+void zp_bench_suite_collections(zp_bench_t *b) {
+    bench_collections_hashmap(b);
+    bench_collections_vector(b);
+#if Z_FEATURE_MULTI_THREAD == 1
+    bench_collections_ring_mt(b);
+#endif
+}
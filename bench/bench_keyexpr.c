@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "zenoh-pico/session/keyexpr.h"
+
+#define BENCH_CANON_BUF_SIZE 256
+
+typedef struct {
+    const char *name;
+    const char *left;
+    const char *right;
+} bench_ke_pair_t;
+
+// Representative pairs: verbatim keys, single chunk wildcards, multi chunk wildcards and long near-miss keys
+static const bench_ke_pair_t BENCH_KE_PAIRS[] = {
+    {"verbatim_equal", "robot/fleet/unit-042/sensors/lidar/front/points",
+     "robot/fleet/unit-042/sensors/lidar/front/points"},
+    {"verbatim_differ", "robot/fleet/unit-042/sensors/lidar/front/points",
+     "robot/fleet/unit-042/sensors/lidar/front/pointz"},
+    {"star", "robot/fleet/*/sensors/*/front/points", "robot/fleet/unit-042/sensors/lidar/front/points"},
+    {"double_star", "robot/**/points", "robot/fleet/unit-042/sensors/lidar/front/points"},
+    {"double_star_mid", "robot/fleet/**/lidar/**/points", "robot/fleet/unit-042/sensors/lidar/front/points"},
+    {"sub_chunk", "robot/fleet/unit-*/sensors/li*ar/front/po*", "robot/fleet/unit-042/sensors/lidar/front/points"},
+    {"long_miss",
+     "building/tower-a/floor-17/room-1742/hvac/zone-3/thermostat/setpoint/current/celsius/value/raw/sample",
+     "building/tower-a/floor-17/room-1742/hvac/zone-3/thermostat/setpoint/current/celsius/value/raw/sampl"},
+};
+
+static const char *BENCH_KE_CANON[] = {
+    "robot/fleet/unit-042/sensors/lidar/front/points",
+    "robot/**/**/*/**/points/$*",
+    "building/tower-a/floor-17/room-1742/hvac/zone-3/**/**/value/raw/**/**/sample",
+};
+
+typedef struct {
+    _z_keyexpr_t left;
+    _z_keyexpr_t right;
+} bench_ke_ctx_t;
+
+static void bench_ke_intersects(void *arg, size_t iters) {
+    bench_ke_ctx_t *ctx = (bench_ke_ctx_t *)arg;
+    size_t hits = 0;
+    for (size_t i = 0; i < iters; i++) {
+        hits += _z_keyexpr_intersects(&ctx->left, &ctx->right) ? 1u : 0u;
+    }
+    zp_bench_do_not_optimize(&hits);
+}
+
+static void bench_ke_includes(void *arg, size_t iters) {
+    bench_ke_ctx_t *ctx = (bench_ke_ctx_t *)arg;
+    size_t hits = 0;
+    for (size_t i = 0; i < iters; i++) {
+        hits += _z_keyexpr_includes(&ctx->left, &ctx->right) ? 1u : 0u;
+    }
+    zp_bench_do_not_optimize(&hits);
+}
+
+typedef struct {
+    const char *src;
+    size_t src_len;
+    char buf[BENCH_CANON_BUF_SIZE];
+} bench_canon_ctx_t;
+
+// Canonization works in place, each operation includes copying the source key expression into the work buffer
+static void bench_ke_canonize(void *arg, size_t iters) {
+    bench_canon_ctx_t *ctx = (bench_canon_ctx_t *)arg;
+    for (size_t i = 0; i < iters; i++) {
+        size_t len = ctx->src_len;
+        memcpy(ctx->buf, ctx->src, len);
+        (void)_z_keyexpr_canonize(ctx->buf, &len);
+        zp_bench_do_not_optimize(ctx->buf);
+    }
+}
+
+static void bench_ke_is_canon(void *arg, size_t iters) {
+    bench_canon_ctx_t *ctx = (bench_canon_ctx_t *)arg;
+    int acc = 0;
+    for (size_t i = 0; i < iters; i++) {
+        acc += (int)_z_keyexpr_is_canon(ctx->src, ctx->src_len);
+    }
+    zp_bench_do_not_optimize(&acc);
+}
+
+void zp_bench_suite_keyexpr(zp_bench_t *b) {
+    char name[96];
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(BENCH_KE_PAIRS); i++) {
+        bench_ke_ctx_t ctx;
+        ctx.left = _z_keyexpr_alias_from_str(BENCH_KE_PAIRS[i].left);
+        ctx.right = _z_keyexpr_alias_from_str(BENCH_KE_PAIRS[i].right);
+        snprintf(name, sizeof(name), "keyexpr/intersects/%s", BENCH_KE_PAIRS[i].name);
+        zp_bench_run(b, name, bench_ke_intersects, &ctx);
+        snprintf(name, sizeof(name), "keyexpr/includes/%s", BENCH_KE_PAIRS[i].name);
+        zp_bench_run(b, name, bench_ke_includes, &ctx);
+    }
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(BENCH_KE_CANON); i++) {
+        bench_canon_ctx_t ctx;
+        ctx.src = BENCH_KE_CANON[i];
+        ctx.src_len = strlen(ctx.src);
+        snprintf(name, sizeof(name), "keyexpr/canonize/%zuB", ctx.src_len);
+        zp_bench_run(b, name, bench_ke_canonize, &ctx);
+        snprintf(name, sizeof(name), "keyexpr/is_canon/%zuB", ctx.src_len);
+        zp_bench_run(b, name, bench_ke_is_canon, &ctx);
+    }
+}
@@ -0,0 +1,234 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/loopback.h"
+#include "zenoh-pico/session/resource.h"
+#include "zenoh-pico/session/session.h"
+#include "zenoh-pico/session/subscription.h"
+#include "zenoh-pico/session/utils.h"
+
+#if Z_FEATURE_SUBSCRIPTION == 1
+
+static const size_t BENCH_SUB_COUNTS[] = {1, 10, 100, 1000, 10000};
+static const size_t BENCH_FANOUT_COUNTS[] = {1, 10, 100};
+
+typedef struct {
+    _z_session_rc_t rc;
+    _z_link_t link;
+    size_t delivered;
+    _z_subscription_rc_t *subs;  // Declared subscribers, oldest at subs[oldest]
+    size_t sub_nb;
+    size_t oldest;
+} bench_session_t;
+
+static void bench_sample_callback(_z_sample_t *sample, void *arg) {
+    _ZP_UNUSED(sample);
+    bench_session_t *bs = (bench_session_t *)arg;
+    bs->delivered++;
+}
+
+// A session without any transport, attached to a dummy unicast link so that local delivery goes through the same
+// code path as messages received from the network.
+static z_result_t bench_session_open(bench_session_t *bs) {
+    memset(bs, 0, sizeof(*bs));
+    _z_session_t *s = (_z_session_t *)z_malloc(sizeof(_z_session_t));
+    if (s == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    z_result_t ret = _z_session_init(s, &zid);
+    if (ret != _Z_RES_OK) {
+        z_free(s);
+        return ret;
+    }
+    bs->rc = _z_session_rc_new(s);
+    if (_Z_RC_IS_NULL(&bs->rc)) {
+        _z_session_clear(s);
+        z_free(s);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    s->_tp._type = _Z_TRANSPORT_UNICAST_TYPE;
+    s->_tp._transport._unicast._common._session = _z_session_rc_clone_as_weak(&bs->rc);
+    s->_tp._transport._unicast._common._link = &bs->link;
+    return _Z_RES_OK;
+}
+
+static void bench_session_close(bench_session_t *bs) {
+    _z_session_t *s = _Z_RC_IN_VAL(&bs->rc);
+    for (size_t i = 0; i < bs->sub_nb; i++) {
+        _z_subscription_rc_drop(&bs->subs[i]);
+    }
+    z_free(bs->subs);
+    _z_session_weak_drop(&s->_tp._transport._unicast._common._session);
+    s->_tp._transport._unicast._common._link = NULL;
+    s->_tp._type = _Z_TRANSPORT_NONE;
+    _z_session_rc_drop(&bs->rc);
+}
+
+static z_result_t bench_session_declare(bench_session_t *bs, const _z_declared_keyexpr_t *ke,
+                                        _z_subscription_rc_t *out) {
+    _z_session_t *s = _Z_RC_IN_VAL(&bs->rc);
+    _z_subscription_t sub = {0};
+    sub._id = _z_get_entity_id(s);
+    _Z_RETURN_IF_ERR(_z_declared_keyexpr_copy(&sub._key, ke));
+    sub._callback = bench_sample_callback;
+    sub._arg = bs;
+    sub._allowed_origin = Z_LOCALITY_ANY;
+    *out = _z_register_subscription(s, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    if (_Z_RC_IS_NULL(out)) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _Z_RES_OK;
+}
+
+static z_result_t bench_session_subscribe(bench_session_t *bs, const char *key) {
+    _z_declared_keyexpr_t ke = _z_declared_keyexpr_alias_from_str(key);
+    _Z_RETURN_IF_ERR(bench_session_declare(bs, &ke, &bs->subs[bs->sub_nb]));
+    bs->sub_nb++;
+    return _Z_RES_OK;
+}
+
+typedef struct {
+    bench_session_t *bs;
+    _z_keyexpr_t ke;
+} bench_dispatch_ctx_t;
+
+// One operation is the dispatch of an empty put received from the network to the matching subscribers
+static void bench_dispatch_put(void *arg, size_t iters) {
+    bench_dispatch_ctx_t *ctx = (bench_dispatch_ctx_t *)arg;
+    _z_session_t *s = _Z_RC_IN_VAL(&ctx->bs->rc);
+    for (size_t i = 0; i < iters; i++) {
+        _z_wireexpr_t wireexpr = _z_keyexpr_alias_to_wire(&ctx->ke);
+        _z_bytes_t payload = _z_bytes_null();
+        _z_encoding_t encoding = _z_encoding_null();
+        _z_bytes_t attachment = _z_bytes_null();
+        _z_timestamp_t ts = _z_timestamp_null();
+        _z_source_info_t source_info = _z_source_info_null();
+        (void)_z_trigger_subscriptions_put(s, &wireexpr, &payload, &encoding, &ts, _Z_N_QOS_DEFAULT, &attachment,
+                                           Z_RELIABILITY_RELIABLE, &source_info, NULL);
+    }
+}
+
+// One operation is the undeclaration of the oldest subscriber followed by the declaration of a new one on its key
+static void bench_declare_undeclare(void *arg, size_t iters) {
+    bench_dispatch_ctx_t *ctx = (bench_dispatch_ctx_t *)arg;
+    bench_session_t *bs = ctx->bs;
+    _z_session_t *s = _Z_RC_IN_VAL(&bs->rc);
+    for (size_t i = 0; i < iters; i++) {
+        _z_subscription_rc_t *slot = &bs->subs[bs->oldest];
+        _z_declared_keyexpr_t ke;
+        if (_z_declared_keyexpr_copy(&ke, &_Z_RC_IN_VAL(slot)->_key) != _Z_RES_OK) {
+            return;
+        }
+        _z_unregister_subscription(s, _Z_SUBSCRIBER_KIND_SUBSCRIBER, slot);
+        z_result_t ret = bench_session_declare(bs, &ke, slot);
+        _z_declared_keyexpr_clear(&ke);
+        if (ret != _Z_RES_OK) {
+            return;
+        }
+        bs->oldest = (bs->oldest + 1) % bs->sub_nb;
+    }
+}
+
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+// One operation is a local put with a 64 bytes payload, from the network message construction to the callback
+static void bench_loopback_put(void *arg, size_t iters) {
+    bench_dispatch_ctx_t *ctx = (bench_dispatch_ctx_t *)arg;
+    _z_session_t *s = _Z_RC_IN_VAL(&ctx->bs->rc);
+    uint8_t data[64] = {0};
+    for (size_t i = 0; i < iters; i++) {
+        _z_bytes_t payload;
+        if (_z_bytes_from_buf(&payload, data, sizeof(data)) != _Z_RES_OK) {
+            continue;
+        }
+        _z_encoding_t encoding = _z_encoding_null();
+        _z_bytes_t attachment = _z_bytes_null();
+        _z_timestamp_t ts = _z_timestamp_null();
+        _z_source_info_t source_info = _z_source_info_null();
+        (void)_z_session_deliver_push_locally(s, &ctx->ke, &payload, &encoding, Z_SAMPLE_KIND_PUT, _Z_N_QOS_DEFAULT,
+                                              &ts, &attachment, Z_RELIABILITY_RELIABLE, &source_info);
+    }
+}
+#endif
+
+// Declares sub_nb subscribers on sub_key, suffixed with their index when indexed is true, then runs fn on pub_key
+static void bench_session_run(zp_bench_t *b, const char *name, const char *pub_key, const char *sub_key, bool indexed,
+                              size_t sub_nb, zp_bench_fn_t fn) {
+    if (!zp_bench_enabled(b, name)) {
+        return;
+    }
+    bench_session_t bs;
+    if (bench_session_open(&bs) != _Z_RES_OK) {
+        fprintf(stderr, "Failed to set up %s\n", name);
+        return;
+    }
+    bs.subs = (_z_subscription_rc_t *)z_malloc(sizeof(_z_subscription_rc_t) * sub_nb);
+    z_result_t ret = (bs.subs != NULL) ? _Z_RES_OK : _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    for (size_t i = 0; (ret == _Z_RES_OK) && (i < sub_nb); i++) {
+        char key[64];
+        if (indexed) {
+            snprintf(key, sizeof(key), "%s/%zu", sub_key, i);
+        } else {
+            snprintf(key, sizeof(key), "%s", sub_key);
+        }
+        ret = bench_session_subscribe(&bs, key);
+    }
+    if (ret == _Z_RES_OK) {
+        bench_dispatch_ctx_t ctx;
+        ctx.bs = &bs;
+        ctx.ke = _z_keyexpr_alias_from_str(pub_key);
+        zp_bench_run(b, name, fn, &ctx);
+    } else {
+        fprintf(stderr, "Failed to declare the subscribers of %s\n", name);
+    }
+    bench_session_close(&bs);
+}
+
+void zp_bench_suite_session(zp_bench_t *b) {
+    char name[96];
+    char pub_key[64];
+    // Many subscribers on distinct keys, a single one of them matches
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(BENCH_SUB_COUNTS); i++) {
+        size_t n = BENCH_SUB_COUNTS[i];
+        snprintf(name, sizeof(name), "session/dispatch/match_one/%zu_subs", n);
+        snprintf(pub_key, sizeof(pub_key), "bench/sub/%zu", n - 1);
+        bench_session_run(b, name, pub_key, "bench/sub", true, n, bench_dispatch_put);
+    }
+    // Declaration cost with many subscribers already declared
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(BENCH_SUB_COUNTS); i++) {
+        size_t n = BENCH_SUB_COUNTS[i];
+        snprintf(name, sizeof(name), "session/declare_undeclare/%zu_subs", n);
+        bench_session_run(b, name, "bench/sub/0", "bench/sub", true, n, bench_declare_undeclare);
+    }
+    // Many subscribers on the same wildcard, all of them match
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(BENCH_FANOUT_COUNTS); i++) {
+        size_t n = BENCH_FANOUT_COUNTS[i];
+        snprintf(name, sizeof(name), "session/dispatch/fanout/%zu_subs", n);
+        bench_session_run(b, name, "bench/fanout/a/b", "bench/fanout/**", false, n, bench_dispatch_put);
+    }
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+    bench_session_run(b, "session/loopback/put/64B", "bench/loopback", "bench/loopback", false, 1, bench_loopback_put);
+#endif
+}
+
+#else
+void zp_bench_suite_session(zp_bench_t *b) { _ZP_UNUSED(b); }
+#endif
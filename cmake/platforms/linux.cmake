@@ -3,8 +3,11 @@ set(ZP_PLATFORM_COMPILE_DEFINITIONS ZENOH_LINUX)
 set(ZP_PLATFORM_SOURCE_FILES
     "${PROJECT_SOURCE_DIR}/src/system/unix/system.c"
     "${PROJECT_SOURCE_DIR}/src/system/unix/network.c"
+    "${PROJECT_SOURCE_DIR}/src/system/unix/io_uring.c"
     "${PROJECT_SOURCE_DIR}/src/link/transport/udp/raweth_unix.c"
     "${PROJECT_SOURCE_DIR}/src/link/transport/tcp/tcp_posix.c"
+    "${PROJECT_SOURCE_DIR}/src/link/transport/unixsock/unixsock_posix.c"
+    "${PROJECT_SOURCE_DIR}/src/link/transport/shm/shm_ring_linux.c"
     "${PROJECT_SOURCE_DIR}/src/link/transport/udp/udp_posix.c"
     "${PROJECT_SOURCE_DIR}/src/link/transport/serial/tty_posix.c")
 if(ZP_UDP_MULTICAST_ENABLED)
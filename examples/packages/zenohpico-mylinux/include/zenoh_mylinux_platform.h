@@ -67,6 +67,14 @@ typedef struct {
     };
 } _z_sys_net_endpoint_t;
 
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+typedef struct {
+    uint8_t *_addr;
+    size_t _size;
+    int _fd;
+} _z_mapped_file_t;
+#endif
+
 #ifdef __cplusplus
 }
 #endif
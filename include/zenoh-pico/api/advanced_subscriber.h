@@ -19,7 +19,6 @@
 #include "zenoh-pico/api/types.h"
 #include "zenoh-pico/collections/hashmap.h"
 #include "zenoh-pico/collections/refcount.h"
-#include "zenoh-pico/collections/sortedmap.h"
 #include "zenoh-pico/runtime/runtime.h"
 
 #ifdef __cplusplus
@@ -38,16 +37,32 @@ static inline int _z_uint32_cmp(const uint32_t *left, const uint32_t *right) {
 }
 _Z_ELEM_DEFINE(_z_uint32, uint32_t, _z_uint32_size, _z_noop_clear, _z_uint32_copy, _z_noop_move, _z_noop_eq,
                _z_uint32_cmp, _z_noop_hash)
-_Z_SORTEDMAP_DEFINE(_z_uint32, _z_sample, uint32_t, _z_sample_t)
 
-_Z_SORTEDMAP_DEFINE(_z_timestamp, _z_sample, _z_timestamp_t, _z_sample_t)
+// Samples buffered while queries are pending, ordered by source sequence number or by timestamp.
+// Values are moved in bitwise, the map owns them from then on.
+#define _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE uint32_t
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE _z_sample_t
+#define _ZP_ORDERED_MAP_TEMPLATE_NAME _ze_sn_sample_omap
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_DESTROY_FN _z_sample_clear
+#define _ZP_ORDERED_MAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_ORDERED_MAP_TEMPLATE_FREE_FN z_free
+#include "zenoh-pico/collections/ordered_map_template.h"
+
+#define _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE _z_timestamp_t
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE _z_sample_t
+#define _ZP_ORDERED_MAP_TEMPLATE_NAME _ze_timestamp_sample_omap
+#define _ZP_ORDERED_MAP_TEMPLATE_KEY_CMP_FN _z_timestamp_cmp
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_DESTROY_FN _z_sample_clear
+#define _ZP_ORDERED_MAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_ORDERED_MAP_TEMPLATE_FREE_FN z_free
+#include "zenoh-pico/collections/ordered_map_template.h"
 
 typedef struct {
     _z_session_weak_t _zn;
     bool _has_last_delivered;
     uint32_t _last_delivered;
     uint64_t _pending_queries;
-    _z_uint32__z_sample_sortedmap_t _pending_samples;
+    _ze_sn_sample_omap_t _pending_samples;
     _z_fut_handle_t _periodic_query_handle;
     z_owned_keyexpr_t _query_keyexpr;
 } _ze_advanced_subscriber_sequenced_state_t;
@@ -66,7 +81,7 @@ typedef struct {
     bool _has_last_delivered;
     _z_timestamp_t _last_delivered;
     uint64_t _pending_queries;
-    _z_timestamp__z_sample_sortedmap_t _pending_samples;
+    _ze_timestamp_sample_omap_t _pending_samples;
 } _ze_advanced_subscriber_timestamped_state_t;
 
 static inline size_t _ze_advanced_subscriber_timestamped_state_size(_ze_advanced_subscriber_timestamped_state_t *s) {
@@ -79,6 +79,36 @@ z_result_t z_liveliness_declare_token(const z_loaned_session_t *zs, z_owned_live
  */
 z_result_t z_liveliness_undeclare_token(z_moved_liveliness_token_t *token);
 
+/**
+ * Constructs and declares several liveliness tokens at once. The tokens are registered under a single lock and their
+ * declarations are batched together.
+ *
+ * Parameters:
+ *   zs: A Zenoh session to declare the liveliness tokens.
+ *   tokens: An array of ``len`` uninitialized memory locations where the liveliness tokens will be constructed.
+ *   keyexprs: An array of ``len`` keyexprs to declare a liveliness token for.
+ *   len: Number of tokens to declare.
+ *   options: Liveliness token declaration options, shared by all the tokens.
+ *
+ * Return:
+ *   ``0`` if all the tokens are declared, ``negative value`` otherwise, in which case none of them is declared.
+ */
+z_result_t z_liveliness_declare_tokens(const z_loaned_session_t *zs, z_owned_liveliness_token_t *tokens,
+                                       const z_loaned_keyexpr_t *const *keyexprs, size_t len,
+                                       const z_liveliness_token_options_t *options);
+
+/**
+ * Undeclares several liveliness tokens at once, batching their undeclarations together.
+ *
+ * Parameters:
+ *   tokens: Array of ``len`` moved :c:type:`z_owned_liveliness_token_t` to undeclare.
+ *   len: Number of tokens to undeclare.
+ *
+ * Return:
+ *   ``0`` if undeclare is successful, ``negative value`` otherwise. All the tokens are released in both cases.
+ */
+z_result_t z_liveliness_undeclare_tokens(z_moved_liveliness_token_t **tokens, size_t len);
+
 /**************** Liveliness Subscriber ****************/
 
 #if Z_FEATURE_SUBSCRIPTION == 1
@@ -2391,6 +2391,14 @@ z_result_t z_undeclare_publisher(z_moved_publisher_t *pub);
  */
 void z_publisher_put_options_default(z_publisher_put_options_t *options);
 
+/**
+ * Builds a :c:type:`z_publisher_put_many_options_t` with default values.
+ *
+ * Parameters:
+ *   options: Pointer to an uninitialized :c:type:`z_publisher_put_many_options_t`.
+ */
+void z_publisher_put_many_options_default(z_publisher_put_many_options_t *options);
+
 /**
  * Builds a :c:type:`z_publisher_delete_options_t` with default values.
  *
@@ -2413,6 +2421,83 @@ void z_publisher_delete_options_default(z_publisher_delete_options_t *options);
 z_result_t z_publisher_put(const z_loaned_publisher_t *pub, z_moved_bytes_t *payload,
                            const z_publisher_put_options_t *options);
 
+/**
+ * Puts a burst of samples for the keyexpr bound to the given publisher.
+ *
+ * The samples are encoded back to back under a single acquisition of the transmission lock and flushed once at the
+ * end, only the ones that do not fit in a batch are fragmented. If batching was started with :c:func:`zp_batch_start`,
+ * the samples are appended to the current batch instead.
+ *
+ * Parameters:
+ *   pub: Pointer to a :c:type:`z_loaned_publisher_t` from where to put the data.
+ *   payloads: Array of ``len`` moved :c:type:`z_owned_bytes_t` containing the data to put.
+ *   len: Number of samples to put.
+ *   options: Pointer to a :c:type:`z_publisher_put_many_options_t` to configure the operation.
+ *
+ * Return:
+ *   ``0`` if put operation is successful, ``negative value`` otherwise. If sending fails partway, the samples before
+ *   the one that failed are still sent and the following ones are not. The payloads and attachments are consumed in
+ *   both cases.
+ */
+z_result_t z_publisher_put_many(const z_loaned_publisher_t *pub, z_moved_bytes_t **payloads, size_t len,
+                                const z_publisher_put_many_options_t *options);
+
+/**
+ * Lends a transmission buffer to write the payload of a put in place.
+ *
+ * The message headers are encoded right away and ``len`` bytes are reserved for the payload directly in the current
+ * transport batch, or in the buffer the message will be fragmented from if it is too large for a batch. The payload is
+ * then written through :c:func:`zp_publisher_tx_buf_data` and sent with :c:func:`zp_publisher_tx_buf_commit`, which
+ * avoids both building a :c:type:`z_owned_bytes_t` and copying it in the batch. When the transport can't lend its
+ * buffer, the payload is written aside and sent as with :c:func:`z_publisher_put`.
+ *
+ * The transmission lock of the session is held until the buffer is committed or aborted: it must be released promptly
+ * and no other operation may be performed on the session in between. Samples put this way are not added to the cache
+ * of an advanced publisher.
+ *
+ * Parameters:
+ *   pub: Pointer to a :c:type:`z_loaned_publisher_t` from where to put the data.
+ *   buf: Pointer to an uninitialized :c:type:`zp_publisher_tx_buf_t`.
+ *   len: Length of the payload.
+ *   options: Pointer to a :c:type:`z_publisher_put_options_t` to configure the operation.
+ *
+ * Return:
+ *   ``0`` if the buffer was lent, ``negative value`` otherwise. The encoding and attachment are consumed in both
+ *   cases.
+ */
+z_result_t zp_publisher_loan_tx_buf(const z_loaned_publisher_t *pub, zp_publisher_tx_buf_t *buf, size_t len,
+                                    const z_publisher_put_options_t *options);
+
+/**
+ * Gets the payload area of a lent transmission buffer.
+ *
+ * Parameters:
+ *   buf: Pointer to a :c:type:`zp_publisher_tx_buf_t` lent by :c:func:`zp_publisher_loan_tx_buf`.
+ *
+ * Return:
+ *   Pointer to the ``len`` writable bytes of the payload.
+ */
+uint8_t *zp_publisher_tx_buf_data(zp_publisher_tx_buf_t *buf);
+
+/**
+ * Sends the put whose payload was written in a lent transmission buffer and gives the buffer back.
+ *
+ * Parameters:
+ *   buf: Pointer to a :c:type:`zp_publisher_tx_buf_t` lent by :c:func:`zp_publisher_loan_tx_buf`.
+ *
+ * Return:
+ *   ``0`` if put operation is successful, ``negative value`` otherwise.
+ */
+z_result_t zp_publisher_tx_buf_commit(zp_publisher_tx_buf_t *buf);
+
+/**
+ * Gives a lent transmission buffer back without sending anything.
+ *
+ * Parameters:
+ *   buf: Pointer to a :c:type:`zp_publisher_tx_buf_t` lent by :c:func:`zp_publisher_loan_tx_buf`.
+ */
+void zp_publisher_tx_buf_abort(zp_publisher_tx_buf_t *buf);
+
 #if Z_FEATURE_ADVANCED_PUBLICATION == 1
 z_result_t _z_publisher_put_impl(const z_loaned_publisher_t *pub, z_moved_bytes_t *payload,
                                  const z_publisher_put_options_t *options, _ze_advanced_cache_t *cache);
@@ -2784,6 +2869,38 @@ z_result_t z_declare_queryable(const z_loaned_session_t *zs, z_owned_queryable_t
  */
 z_result_t z_undeclare_queryable(z_moved_queryable_t *pub);
 
+/**
+ * Declares several queryables at once. The queryables are registered under a single lock and their declarations are
+ * batched together.
+ *
+ * Parameters:
+ *   zs: Pointer to a :c:type:`z_loaned_session_t` to declare the queryables through.
+ *   queryables: Array of ``len`` :c:type:`z_owned_queryable_t` to contain the queryables.
+ *   keyexprs: Array of ``len`` :c:type:`z_loaned_keyexpr_t` to bind the queryables with.
+ *   callbacks: Array of ``len`` moved :c:type:`z_owned_closure_query_t` callbacks.
+ *   len: Number of queryables to declare.
+ *   options: Pointer to a :c:type:`z_queryable_options_t` to configure the operation, shared by all the queryables.
+ *
+ * Return:
+ *   ``0`` if all the queryables are declared, ``negative value`` otherwise, in which case none of them is declared
+ *   and the callbacks are dropped.
+ */
+z_result_t z_declare_queryables(const z_loaned_session_t *zs, z_owned_queryable_t *queryables,
+                                const z_loaned_keyexpr_t *const *keyexprs, z_moved_closure_query_t **callbacks,
+                                size_t len, const z_queryable_options_t *options);
+
+/**
+ * Undeclares several queryables at once, batching their undeclarations together.
+ *
+ * Parameters:
+ *   queryables: Array of ``len`` moved :c:type:`z_owned_queryable_t` to undeclare.
+ *   len: Number of queryables to undeclare.
+ *
+ * Return:
+ *   ``0`` if undeclare is successful, ``negative value`` otherwise. All the queryables are released in both cases.
+ */
+z_result_t z_undeclare_queryables(z_moved_queryable_t **queryables, size_t len);
+
 /**
  * Declares a background queryable for a given keyexpr. The queryable callback will be called
  * to proccess incoming queries until the corresponding session is closed or dropped.
@@ -3087,6 +3204,38 @@ z_result_t z_declare_subscriber(const z_loaned_session_t *zs, z_owned_subscriber
  */
 z_result_t z_undeclare_subscriber(z_moved_subscriber_t *pub);
 
+/**
+ * Declares several subscribers at once. The subscribers are registered under a single lock and their declarations are
+ * batched together.
+ *
+ * Parameters:
+ *   zs: Pointer to a :c:type:`z_loaned_session_t` to declare the subscribers through.
+ *   subs: Array of ``len`` :c:type:`z_owned_subscriber_t` to contain the subscribers.
+ *   keyexprs: Array of ``len`` :c:type:`z_loaned_keyexpr_t` to bind the subscribers with.
+ *   callbacks: Array of ``len`` moved :c:type:`z_owned_closure_sample_t` callbacks.
+ *   len: Number of subscribers to declare.
+ *   options: Pointer to a :c:type:`z_subscriber_options_t` to configure the operation, shared by all the subscribers.
+ *
+ * Return:
+ *   ``0`` if all the subscribers are declared, ``negative value`` otherwise, in which case none of them is declared
+ *   and the callbacks are dropped.
+ */
+z_result_t z_declare_subscribers(const z_loaned_session_t *zs, z_owned_subscriber_t *subs,
+                                 const z_loaned_keyexpr_t *const *keyexprs, z_moved_closure_sample_t **callbacks,
+                                 size_t len, const z_subscriber_options_t *options);
+
+/**
+ * Undeclares several subscribers at once, batching their undeclarations together.
+ *
+ * Parameters:
+ *   subs: Array of ``len`` moved :c:type:`z_owned_subscriber_t` to undeclare.
+ *   len: Number of subscribers to undeclare.
+ *
+ * Return:
+ *   ``0`` if undeclare is successful, ``negative value`` otherwise. All the subscribers are released in both cases.
+ */
+z_result_t z_undeclare_subscribers(z_moved_subscriber_t **subs, size_t len);
+
 /**
  * Declares a background subscriber for a given keyexpr. Subscriber callback will be called to process the messages,
  * until the corresponding session is closed or dropped.
@@ -443,6 +443,57 @@ typedef struct {
 #endif
 } z_publisher_put_options_t;
 
+/**
+ * Represents the configuration used to configure a batched put operation by a previously declared publisher,
+ * sent via :c:func:`z_publisher_put_many`.
+ *
+ * Members:
+ *   z_moved_encoding_t* encoding: The encoding of all the payloads.
+ *   z_timestamp_t *timestamps: An optional array of API level timestamps, one per payload.
+ *   z_moved_bytes_t** attachments: An optional array of attachments, one per payload. Entries can be ``NULL``.
+ *   z_source_info_t* source_info: The source info for the messages (unstable).
+ */
+typedef struct {
+    z_moved_encoding_t *encoding;
+    z_timestamp_t *timestamps;
+    z_moved_bytes_t **attachments;
+#ifdef Z_FEATURE_UNSTABLE_API
+    z_source_info_t *source_info;
+#endif
+} z_publisher_put_many_options_t;
+
+/**
+ * Represents a transmission buffer lent by a publisher, obtained with :c:func:`zp_publisher_loan_tx_buf`.
+ *
+ * The payload is written in place through :c:func:`zp_publisher_tx_buf_data`, then the buffer is either sent with
+ * :c:func:`zp_publisher_tx_buf_commit` or given back with :c:func:`zp_publisher_tx_buf_abort`. Its members are
+ * private.
+ */
+typedef struct {
+    _z_transport_tx_loan_t _tx;
+    _z_session_t *_session;
+#if Z_FEATURE_SESSION_CHECK == 1
+    _z_session_rc_t _session_rc;
+#endif
+    const _z_declared_keyexpr_t *_key;
+    _z_slice_t _fallback;
+    uint8_t *_buf;
+    size_t _len;
+    _z_encoding_t _encoding;
+    _z_bytes_t _attachment;
+    _z_timestamp_t _timestamp;
+    _z_source_info_t _source_info;
+    z_congestion_control_t _congestion_control;
+    z_priority_t _priority;
+    z_reliability_t _reliability;
+    z_locality_t _destination;
+    bool _is_express;
+    bool _has_timestamp;
+    bool _has_source_info;
+    bool _is_remote;
+    bool _is_local;
+} zp_publisher_tx_buf_t;
+
 /**
  * Represents the configuration used to configure a delete operation by a previously declared publisher,
  * sent via :c:func:`z_publisher_delete`.
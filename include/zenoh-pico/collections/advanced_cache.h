@@ -19,12 +19,17 @@
 
 #include "zenoh-pico/api/liveliness.h"
 #include "zenoh-pico/api/types.h"
+#include "zenoh-pico/collections/advanced_cache_file.h"
 #include "zenoh-pico/collections/ring.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+#define ZE_ADVANCED_PUBLISHER_CACHE_PERSISTENCE_SIZE_DEFAULT (64 * 1024)
+#endif
+
 /**
  * Represents the set of options that can be applied to an advaned publishers cache.
  * The cache allows advanced subscribers to recover history and/or lost samples.
@@ -36,6 +41,10 @@ extern "C" {
  *   z_priority_t priority: The priority of replies.
  *   bool is_express: If set to ``true``, this cache replies will not be batched. This usually
  *     has a positive impact on latency but negative impact on throughput.
+ *   const char *persistence_path: Path of a file in which to keep the cache instead of the heap, or ``NULL``.
+ *     The history found in this file is served again when a publisher is declared with the same path and sizes,
+ *     so that it survives restarts. Requires ``Z_FEATURE_ADVANCED_CACHE_PERSISTENCE``.
+ *   size_t persistence_size: Number of bytes reserved in the file for the serialized samples.
  */
 typedef struct {
     bool is_enabled;
@@ -43,13 +52,34 @@ typedef struct {
     z_congestion_control_t congestion_control;
     z_priority_t priority;
     bool is_express;
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+    const char *persistence_path;
+    size_t persistence_size;
+#endif
     bool _liveliness;  // TODO: Private as not yet exposed in Zenoh implementation.
 } ze_advanced_publisher_cache_options_t;
 
 typedef struct {
-    _z_sample_ring_t _cache;
-    _z_sample_t *_outbox;
+    _z_sample_rc_t _sample;
+    // Set when this sample cannot be located by binary search from its predecessor
+    bool _sn_unordered;
+    bool _time_unordered;
+} _ze_advanced_cache_entry_t;
+
+typedef struct {
+    _ze_advanced_cache_entry_t *_entries;
+    size_t _capacity;
+    size_t _start;  // Index of the oldest entry
+    size_t _len;
+    // Number of entries without a source sequence number (resp. timestamp) or out of order with their predecessor,
+    // ranges are resolved by binary search only when these are 0
+    size_t _sn_unindexed;
+    size_t _time_unindexed;
+    _z_sample_rc_t *_outbox;
     size_t _outbox_cap;
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+    _ze_advanced_cache_file_t *_file;  // When set, samples are stored in this file and _entries is not used
+#endif
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_t _mutex;
     _z_mutex_t _outbox_mutex;
@@ -71,6 +101,20 @@ z_result_t _ze_advanced_cache_add(_ze_advanced_cache_t *cache, _z_sample_t *samp
 
 void _ze_advanced_cache_free(_ze_advanced_cache_t **xs);
 
+#if defined(Z_TEST_HOOKS)
+// Creates a cache storing up to max_samples samples, without declaring its queryable nor liveliness token.
+_ze_advanced_cache_t *_ze_advanced_cache_new_detached(size_t max_samples);
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+// Same as _ze_advanced_cache_new_detached, for a cache kept in the file at path.
+_ze_advanced_cache_t *_ze_advanced_cache_new_detached_persistent(size_t max_samples, const char *path,
+                                                                 size_t persistence_size);
+#endif
+// Resolves a query with the given parameters at time now, as the queryable would.
+// Stores references to the matching samples in out, newest first, and returns their number.
+size_t _ze_advanced_cache_query(_ze_advanced_cache_t *cache, const char *parameters, _z_ntp64_t now,
+                                _z_sample_rc_t *out, size_t out_cap);
+#endif
+
 #endif
 
 #ifdef __cplusplus
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+#ifndef INCLUDE_ZENOH_PICO_COLLECTIONS_ADVANCED_CACHE_FILE_H
+#define INCLUDE_ZENOH_PICO_COLLECTIONS_ADVANCED_CACHE_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/net/sample.h"
+#include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/system/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+
+// File layout, in host byte order:
+//   header | capacity slots | data ring of data_size bytes
+// Slots form a ring of sample descriptors: the samples first to end - 1 ever added are kept, sample n in slot
+// n % capacity. Records are appended to the data ring at the stream position head, a record never wraps around the end
+// of the ring so that it can be decoded in place. Counters only grow and are each updated by a single store after the
+// data they cover, so a crash while adding or evicting a sample leaves a consistent file.
+#define _ZE_ADVANCED_CACHE_FILE_MAGIC 0x4341505aU  // "ZPAC"
+#define _ZE_ADVANCED_CACHE_FILE_VERSION 1U
+
+#define _ZE_ADVANCED_CACHE_FILE_SLOT_HAS_SN 0x01U
+#define _ZE_ADVANCED_CACHE_FILE_SLOT_HAS_TIME 0x02U
+#define _ZE_ADVANCED_CACHE_FILE_SLOT_SN_UNORDERED 0x04U
+#define _ZE_ADVANCED_CACHE_FILE_SLOT_TIME_UNORDERED 0x08U
+
+typedef struct {
+    uint32_t _magic;
+    uint32_t _version;
+    uint64_t _capacity;
+    uint64_t _data_size;
+    uint64_t _first;
+    uint64_t _end;
+    uint64_t _head;
+} _ze_advanced_cache_file_header_t;
+
+typedef struct {
+    uint64_t _time;
+    uint64_t _offset;  // Stream position of the record, its position in the data ring is _offset % data_size
+    uint32_t _len;
+    uint32_t _sn;
+    uint32_t _flags;
+    uint32_t _reserved;
+} _ze_advanced_cache_file_slot_t;
+
+typedef struct {
+    _z_mapped_file_t _map;
+    _ze_advanced_cache_file_header_t *_header;
+    _ze_advanced_cache_file_slot_t *_slots;
+    uint8_t *_data;
+    _z_wbuf_t _scratch;  // Serialized record waiting to be committed
+} _ze_advanced_cache_file_t;
+
+// Maps the file at path, restoring the samples it contains if it was written with the same capacity and data_size.
+// Otherwise, the file is reinitialized empty.
+z_result_t _ze_advanced_cache_file_open(_ze_advanced_cache_file_t *file, const char *path, size_t capacity,
+                                        size_t data_size);
+void _ze_advanced_cache_file_close(_ze_advanced_cache_file_t *file);
+
+static inline size_t _ze_advanced_cache_file_len(const _ze_advanced_cache_file_t *file) {
+    return (size_t)(file->_header->_end - file->_header->_first);
+}
+
+// Returns the slot of the i-th oldest sample
+static inline _ze_advanced_cache_file_slot_t *_ze_advanced_cache_file_slot(const _ze_advanced_cache_file_t *file,
+                                                                           size_t i) {
+    return &file->_slots[(file->_header->_first + i) % file->_header->_capacity];
+}
+
+void _ze_advanced_cache_file_pop_oldest(_ze_advanced_cache_file_t *file);
+
+// Serializes sample in the scratch buffer and returns the size of its record in len.
+z_result_t _ze_advanced_cache_file_prepare(_ze_advanced_cache_file_t *file, const _z_sample_t *sample, size_t *len);
+// Returns true if a record of len bytes can be appended without evicting samples.
+bool _ze_advanced_cache_file_fits(const _ze_advanced_cache_file_t *file, size_t len);
+// Appends the prepared record as the newest sample, described by slot. _ze_advanced_cache_file_fits must hold.
+void _ze_advanced_cache_file_commit(_ze_advanced_cache_file_t *file, _ze_advanced_cache_file_slot_t slot);
+
+// Decodes a copy of the i-th oldest sample.
+z_result_t _ze_advanced_cache_file_read(const _ze_advanced_cache_file_t *file, size_t i, _z_sample_t *sample);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // INCLUDE_ZENOH_PICO_COLLECTIONS_ADVANCED_CACHE_FILE_H
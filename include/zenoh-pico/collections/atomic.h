@@ -16,6 +16,7 @@
 #define ZENOH_PICO_COLLECTIONS_ATOMIC_H
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 typedef struct {
     size_t _value;
@@ -63,4 +64,23 @@ static inline bool _z_atomic_bool_compare_exchange_weak(_z_atomic_bool_t *var, b
     return result;
 }
 
+typedef _z_atomic_size_t _z_atomic_ptr_t;
+static inline void _z_atomic_ptr_init(_z_atomic_ptr_t *var, void *value) {
+    _z_atomic_size_init(var, (size_t)(uintptr_t)value);
+}
+static inline void *_z_atomic_ptr_load(_z_atomic_ptr_t *var, _z_memory_order_t order) {
+    return (void *)(uintptr_t)_z_atomic_size_load(var, order);
+}
+static inline void _z_atomic_ptr_store(_z_atomic_ptr_t *var, void *val, _z_memory_order_t order) {
+    _z_atomic_size_store(var, (size_t)(uintptr_t)val, order);
+}
+static inline bool _z_atomic_ptr_compare_exchange_strong(_z_atomic_ptr_t *var, void **expected, void *desired,
+                                                         _z_memory_order_t success, _z_memory_order_t failure) {
+    size_t expected_val = (size_t)(uintptr_t)*expected;
+    bool result = _z_atomic_size_compare_exchange_strong(var, &expected_val, (size_t)(uintptr_t)desired, success,
+                                                         failure);
+    *expected = (void *)(uintptr_t)expected_val;
+    return result;
+}
+
 #endif
@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_COLLECTIONS_EPOCH_H
+#define ZENOH_PICO_COLLECTIONS_EPOCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "zenoh-pico/collections/atomic.h"
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Header embedded at the start of the objects published in an epoch cell, links them while they wait for reclamation
+typedef struct _z_epoch_node_t {
+    struct _z_epoch_node_t *_next;
+    size_t _grace;
+} _z_epoch_node_t;
+
+typedef void (*_z_epoch_free_f)(_z_epoch_node_t *node);
+
+/**
+ * Holds a pointer to an immutable object that readers use without locking, between _z_epoch_cell_enter and
+ * _z_epoch_cell_exit. Readers register in one of two counters picked by the parity of the epoch. An object replaced by
+ * _z_epoch_cell_publish is freed once both counters have been seen empty after its replacement, the epoch being
+ * advanced in between so that new readers do not keep the counter of the old ones busy. Reclamation is attempted by
+ * writers after publishing and by the last reader leaving a counter, objects are freed without any lock held. Once
+ * _z_epoch_cell_clear started, the last reader leaving a counter wakes it up instead.
+ */
+typedef struct {
+    _z_atomic_ptr_t _current;
+    _z_atomic_size_t _epoch;
+    _z_atomic_size_t _readers[2];
+    _z_atomic_bool_t _has_retired;
+    _z_atomic_bool_t _clearing;
+    // Guarded by _mutex
+    _z_epoch_node_t *_retired;  // Oldest first
+    _z_epoch_node_t *_retired_last;
+    size_t _grace;
+    _z_epoch_free_f _free;
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_t _mutex;
+    _z_condvar_t _condvar;  // Signaled for _z_epoch_cell_clear when readers leave
+#endif
+} _z_epoch_cell_t;
+
+z_result_t _z_epoch_cell_init(_z_epoch_cell_t *cell, _z_epoch_free_f free_f);
+// Frees the current and retired objects, waiting for the readers still using them
+void _z_epoch_cell_clear(_z_epoch_cell_t *cell);
+
+// Enters a read section and returns the token to hand to _z_epoch_cell_exit
+static inline size_t _z_epoch_cell_enter(_z_epoch_cell_t *cell) {
+    size_t slot = _z_atomic_size_load(&cell->_epoch, _z_memory_order_relaxed) & 1;
+    _z_atomic_size_fetch_add(&cell->_readers[slot], 1, _z_memory_order_seq_cst);
+    return slot;
+}
+// Returns the current object, valid until the read section is exited
+static inline _z_epoch_node_t *_z_epoch_cell_load(_z_epoch_cell_t *cell) {
+    return (_z_epoch_node_t *)_z_atomic_ptr_load(&cell->_current, _z_memory_order_seq_cst);
+}
+void _z_epoch_cell_exit(_z_epoch_cell_t *cell, size_t token);
+
+/**
+ * Replaces the current object by node, which may be NULL. Writers must be serialized by the caller. The replaced
+ * object is only queued for reclamation, call _z_epoch_cell_reclaim once the locks needed by the free function are
+ * released.
+ */
+void _z_epoch_cell_publish(_z_epoch_cell_t *cell, _z_epoch_node_t *node);
+// Frees the replaced objects that no reader can still use
+void _z_epoch_cell_reclaim(_z_epoch_cell_t *cell);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_COLLECTIONS_EPOCH_H */
@@ -15,6 +15,7 @@
 #ifndef ZENOH_PICO_COLLECTIONS_LRUCACHE_H
 #define ZENOH_PICO_COLLECTIONS_LRUCACHE_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -27,37 +28,58 @@ extern "C" {
 
 // Three way comparison function pointer
 typedef int (*_z_lru_val_cmp_f)(const void *first, const void *second);
+// Hash function pointer, values comparing equal must have the same hash
+typedef size_t (*_z_lru_val_hash_f)(const void *value);
+// Predicate function pointer, used to select the values to remove
+typedef bool (*_z_lru_val_pred_f)(const void *value, const void *arg);
 
 // Node struct: {node_data; generic type}
 typedef void _z_lru_cache_node_t;
 
 /*-------- Dynamically allocated vector --------*/
 /**
- * A least recently used cache implementation
+ * A least recently used cache implementation. Nodes are chained in recency order and indexed by the hash of their
+ * value, kept in the node so that it is computed once, which makes lookup, insertion and eviction O(1).
  */
 typedef struct _z_lru_cache_t {
-    size_t capacity;              // Max number of node
-    size_t len;                   // Number of node
-    _z_lru_cache_node_t *head;    // List head
-    _z_lru_cache_node_t *tail;    // List tail
-    _z_lru_cache_node_t **slist;  // Sorted node list
+    size_t capacity;                // Max number of node
+    size_t len;                     // Number of node
+    _z_lru_cache_node_t *head;      // List head
+    _z_lru_cache_node_t *tail;      // List tail
+    _z_lru_cache_node_t **buckets;  // Hash index, allocated on first insertion
+    size_t bucket_count;            // Power of two, at least capacity
 } _z_lru_cache_t;
 
 _z_lru_cache_t _z_lru_cache_init(size_t capacity);
-void *_z_lru_cache_get(_z_lru_cache_t *cache, void *value, _z_lru_val_cmp_f compare);
-z_result_t _z_lru_cache_insert(_z_lru_cache_t *cache, void *value, size_t value_size, _z_lru_val_cmp_f compare,
+void *_z_lru_cache_get(_z_lru_cache_t *cache, void *value, _z_lru_val_hash_f hash, _z_lru_val_cmp_f compare);
+/**
+ * Moves value into the cache, evicting the least recently used value if the cache is full. Value must not be in the
+ * cache already. With a capacity of 0 the value is cleared instead.
+ */
+z_result_t _z_lru_cache_insert(_z_lru_cache_t *cache, void *value, size_t value_size, _z_lru_val_hash_f hash,
                                z_element_clear_f clear);
+// Removes the values for which pred returns true, returns the number of removed values
+size_t _z_lru_cache_remove_if(_z_lru_cache_t *cache, _z_lru_val_pred_f pred, const void *arg, z_element_clear_f clear);
+// Changes the capacity, evicting the least recently used values that no longer fit
+void _z_lru_cache_resize(_z_lru_cache_t *cache, size_t capacity, z_element_clear_f clear);
 void _z_lru_cache_clear(_z_lru_cache_t *cache, z_element_clear_f clear);
 void _z_lru_cache_delete(_z_lru_cache_t *cache, z_element_clear_f clear);
 
-#define _Z_LRU_CACHE_DEFINE(name, type, compare_f)                                                                  \
+#define _Z_LRU_CACHE_DEFINE(name, type, compare_f, hash_f)                                                          \
     typedef _z_lru_cache_t name##_lru_cache_t;                                                                      \
     static inline name##_lru_cache_t name##_lru_cache_init(size_t capacity) { return _z_lru_cache_init(capacity); } \
     static inline type *name##_lru_cache_get(name##_lru_cache_t *cache, type *val) {                                \
-        return (type *)_z_lru_cache_get(cache, (void *)val, compare_f);                                             \
+        return (type *)_z_lru_cache_get(cache, (void *)val, hash_f, compare_f);                                     \
     }                                                                                                               \
     static inline z_result_t name##_lru_cache_insert(name##_lru_cache_t *cache, type *val) {                        \
-        return _z_lru_cache_insert(cache, (void *)val, sizeof(type), compare_f, name##_elem_clear);                 \
+        return _z_lru_cache_insert(cache, (void *)val, sizeof(type), hash_f, name##_elem_clear);                    \
+    }                                                                                                               \
+    static inline size_t name##_lru_cache_remove_if(name##_lru_cache_t *cache, _z_lru_val_pred_f pred,              \
+                                                    const void *arg) {                                              \
+        return _z_lru_cache_remove_if(cache, pred, arg, name##_elem_clear);                                         \
+    }                                                                                                               \
+    static inline void name##_lru_cache_resize(name##_lru_cache_t *cache, size_t capacity) {                        \
+        _z_lru_cache_resize(cache, capacity, name##_elem_clear);                                                    \
     }                                                                                                               \
     static inline void name##_lru_cache_clear(name##_lru_cache_t *cache) {                                          \
         _z_lru_cache_clear(cache, name##_elem_clear);                                                               \
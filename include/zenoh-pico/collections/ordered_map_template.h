@@ -0,0 +1,432 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Heap-allocated ordered map implemented as a skip list.
+//
+// Keeps its entries sorted by key and provides O(log n) expected insert,
+// lookup and removal, O(1) access to the smallest key and in-order iteration.
+//
+// Design highlights:
+//   * Each entry lives in a single heap allocation holding the key/value pair
+//     followed by its forward links, so no allocation happens on lookup or
+//     iteration.
+//   * Node levels are drawn with p = 1/4 from a per-map xorshift generator:
+//     the layout only depends on the insertion sequence and needs no platform
+//     random source.
+//   * Iterators are node pointers and remain STABLE across the insertion and
+//     removal of *other* keys.
+//
+// User must define the following macros before including this file:
+//
+// Required:
+//   _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE
+//       type of the key
+//   _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE
+//       type of the value
+//
+// Optional:
+//   _ZP_ORDERED_MAP_TEMPLATE_KEY_CMP_FN(key_a_ptr, key_b_ptr) -> int
+//       three-way comparison of keys, negative / zero / positive
+//       (default: compares *key_a_ptr and *key_b_ptr with < and >)
+//   _ZP_ORDERED_MAP_TEMPLATE_NAME
+//       base name for all generated symbols
+//       (default: _ZP_CAT(key_type, _ZP_CAT(val_type, omap)))
+//   _ZP_ORDERED_MAP_TEMPLATE_MAX_LEVEL
+//       maximum number of levels of the skip list, keeps lookups logarithmic
+//       up to 4^MAX_LEVEL entries (default: 16)
+//   _ZP_ORDERED_MAP_TEMPLATE_KEY_DESTROY_FN(key_ptr)
+//       destroy a key (default: no-op)
+//   _ZP_ORDERED_MAP_TEMPLATE_VAL_DESTROY_FN(val_ptr)
+//       destroy a value (default: no-op)
+//   _ZP_ORDERED_MAP_TEMPLATE_KEY_MOVE_FN(dst_ptr, src_ptr)
+//       move a key (default: copy without destroying src)
+//   _ZP_ORDERED_MAP_TEMPLATE_VAL_MOVE_FN(dst_ptr, src_ptr)
+//       move a value (default: copy without destroying src)
+//   _ZP_ORDERED_MAP_TEMPLATE_ALLOC_FN(bytes) -> void *
+//       allocate memory (default: malloc)
+//   _ZP_ORDERED_MAP_TEMPLATE_FREE_FN(ptr)
+//       free memory (default: free)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "zenoh-pico/collections/cat.h"
+
+// ── Required macros ──────────────────────────────────────────────────────────
+
+#ifndef _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE
+#error "_ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE must be defined before including ordered_map_template.h"
+#define _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE int
+#endif
+
+#ifndef _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE
+#error "_ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE must be defined before including ordered_map_template.h"
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE int
+#endif
+
+// ── Optional macros ──────────────────────────────────────────────────────────
+
+#ifndef _ZP_ORDERED_MAP_TEMPLATE_NAME
+#define _ZP_ORDERED_MAP_TEMPLATE_NAME \
+    _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE, _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE, omap))
+#endif
+#ifndef _ZP_ORDERED_MAP_TEMPLATE_KEY_CMP_FN
+#define _ZP_ORDERED_MAP_TEMPLATE_KEY_CMP_FN(a, b) ((*(a) < *(b)) ? -1 : ((*(a) > *(b)) ? 1 : 0))
+#endif
+#ifndef _ZP_ORDERED_MAP_TEMPLATE_MAX_LEVEL
+#define _ZP_ORDERED_MAP_TEMPLATE_MAX_LEVEL 16
+#endif
+#ifndef _ZP_ORDERED_MAP_TEMPLATE_KEY_DESTROY_FN
+#define _ZP_ORDERED_MAP_TEMPLATE_KEY_DESTROY_FN(key) (void)(key)
+#endif
+#ifndef _ZP_ORDERED_MAP_TEMPLATE_VAL_DESTROY_FN
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_DESTROY_FN(val) (void)(val)
+#endif
+#ifndef _ZP_ORDERED_MAP_TEMPLATE_KEY_MOVE_FN
+#define _ZP_ORDERED_MAP_TEMPLATE_KEY_MOVE_FN(dst, src) *(dst) = *(src);
+#endif
+#ifndef _ZP_ORDERED_MAP_TEMPLATE_VAL_MOVE_FN
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_MOVE_FN(dst, src) *(dst) = *(src);
+#endif
+#ifndef _ZP_ORDERED_MAP_TEMPLATE_ALLOC_FN
+#define _ZP_ORDERED_MAP_TEMPLATE_ALLOC_FN(bytes) malloc(bytes)
+#endif
+#ifndef _ZP_ORDERED_MAP_TEMPLATE_FREE_FN
+#define _ZP_ORDERED_MAP_TEMPLATE_FREE_FN(ptr) free(ptr)
+#endif
+
+// ── Internal name helpers ─────────────────────────────────────────────────────
+
+#define _ZP_ORDERED_MAP_TEMPLATE_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, t)
+#define _ZP_ORDERED_MAP_TEMPLATE_ELEM_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, elem_t)
+#define _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, node_t)
+#define _ZP_ORDERED_MAP_TEMPLATE_ITER_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, iter_t)
+
+// ── Node ──────────────────────────────────────────────────────────────────────
+//
+// _elem  : key/value payload exposed to callers through NAME_at.
+// _level : number of forward links of this node, in [1, MAX_LEVEL].
+// _next  : forward links, _next[i] is the following node at level i. They are
+//          stored right after the node in the same allocation.
+
+typedef struct _ZP_ORDERED_MAP_TEMPLATE_ELEM_TYPE {
+    _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE key;
+    _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE val;
+} _ZP_ORDERED_MAP_TEMPLATE_ELEM_TYPE;
+
+typedef struct _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE {
+    _ZP_ORDERED_MAP_TEMPLATE_ELEM_TYPE _elem;
+    struct _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE **_next;
+    uint8_t _level;
+} _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE;
+
+// See hashmap_template_internal.h for why const is applied to these typedefs rather than to the raw types.
+typedef _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, key_t);
+typedef _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, val_t);
+
+// Iterators are node pointers, NULL is the end iterator.
+typedef _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *_ZP_ORDERED_MAP_TEMPLATE_ITER_TYPE;
+
+// ── Map type ──────────────────────────────────────────────────────────────────
+// _head  : forward links of the head sentinel, _head[i] is the first node at level i.
+// _size  : number of entries.
+// _seed  : state of the level generator.
+// _level : number of levels currently in use.
+
+typedef struct _ZP_ORDERED_MAP_TEMPLATE_TYPE {
+    _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *_head[_ZP_ORDERED_MAP_TEMPLATE_MAX_LEVEL];
+    size_t _size;
+    uint32_t _seed;
+    uint8_t _level;
+} _ZP_ORDERED_MAP_TEMPLATE_TYPE;
+
+// ── init ──────────────────────────────────────────────────────────────────────
+// Initializes a new, empty map. Does not allocate.
+static inline void _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, init)(_ZP_ORDERED_MAP_TEMPLATE_TYPE *map) {
+    for (size_t i = 0; i < _ZP_ORDERED_MAP_TEMPLATE_MAX_LEVEL; i++) {
+        map->_head[i] = NULL;
+    }
+    map->_size = 0;
+    map->_seed = 0x9E3779B9u;
+    map->_level = 0;
+}
+
+// ── new ───────────────────────────────────────────────────────────────────────
+// Creates a new, empty map.
+static inline _ZP_ORDERED_MAP_TEMPLATE_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, new)(void) {
+    _ZP_ORDERED_MAP_TEMPLATE_TYPE map;
+    _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, init)(&map);
+    return map;
+}
+
+// ── size / is_empty ───────────────────────────────────────────────────────────
+static inline size_t _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, size)(const _ZP_ORDERED_MAP_TEMPLATE_TYPE *map) {
+    return map->_size;
+}
+
+static inline bool _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, is_empty)(const _ZP_ORDERED_MAP_TEMPLATE_TYPE *map) {
+    return map->_size == 0;
+}
+
+// ── Internal: level generator ─────────────────────────────────────────────────
+// Returns a level in [1, min(MAX_LEVEL, current level + 1)], each extra level
+// being drawn with probability 1/4.
+static inline uint8_t _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, random_level)(_ZP_ORDERED_MAP_TEMPLATE_TYPE *map) {
+    uint32_t x = map->_seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    map->_seed = x;
+
+    uint8_t max_level = (uint8_t)_ZP_ORDERED_MAP_TEMPLATE_MAX_LEVEL;
+    if (map->_level < max_level) {
+        max_level = (uint8_t)(map->_level + 1);
+    }
+    uint8_t level = 1;
+    while (level < max_level && (x & 3u) == 0) {
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+// ── Internal: search ──────────────────────────────────────────────────────────
+// Returns the first node whose key is not less than key, or NULL.
+// If update != NULL, update[i] is set to the level i link pointing to that
+// node, for every level in use.
+static inline _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *_ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, search)(
+    _ZP_ORDERED_MAP_TEMPLATE_TYPE *map, const _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, key_t) * key,
+    _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE ***update) {
+    _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE **links = map->_head;
+    for (size_t i = map->_level; i-- > 0;) {
+        while (links[i] != NULL && _ZP_ORDERED_MAP_TEMPLATE_KEY_CMP_FN(&links[i]->_elem.key, key) < 0) {
+            links = links[i]->_next;
+        }
+        if (update != NULL) {
+            update[i] = &links[i];
+        }
+    }
+    return links[0];
+}
+
+// ── Internal: unlink ──────────────────────────────────────────────────────────
+// Unlinks node from the levels it belongs to, update being filled by search.
+static inline void _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, unlink)(_ZP_ORDERED_MAP_TEMPLATE_TYPE *map,
+                                                                  _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *node,
+                                                                  _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE ***update) {
+    for (size_t i = 0; i < node->_level; i++) {
+        *update[i] = node->_next[i];
+    }
+    while (map->_level > 0 && map->_head[map->_level - 1] == NULL) {
+        map->_level--;
+    }
+    map->_size--;
+}
+
+// ── get / contains ────────────────────────────────────────────────────────────
+// Returns a pointer to the value stored for key, or NULL if absent.
+static inline _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE *_ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, get)(
+    _ZP_ORDERED_MAP_TEMPLATE_TYPE *map, const _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, key_t) * key) {
+    _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *n = _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, search)(map, key, NULL);
+    if (n == NULL || _ZP_ORDERED_MAP_TEMPLATE_KEY_CMP_FN(&n->_elem.key, key) != 0) {
+        return NULL;
+    }
+    return &n->_elem.val;
+}
+
+static inline bool _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, contains)(
+    _ZP_ORDERED_MAP_TEMPLATE_TYPE *map, const _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, key_t) * key) {
+    return _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, get)(map, key) != NULL;
+}
+
+// ── insert ────────────────────────────────────────────────────────────────────
+// Takes ownership of *key and *val via move.
+// If key already exists: the old value is destroyed and the new value is moved
+// in; the incoming key is destroyed (the existing key is kept).
+// Returns the iterator to the inserted/updated node, or an end iterator if the
+// allocation of a new node failed, in which case *key and *val are left
+// untouched.
+static inline _ZP_ORDERED_MAP_TEMPLATE_ITER_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, insert)(
+    _ZP_ORDERED_MAP_TEMPLATE_TYPE *map, _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE *key,
+    _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE *val) {
+    _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE **update[_ZP_ORDERED_MAP_TEMPLATE_MAX_LEVEL];
+    _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *n = _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, search)(map, key, update);
+    if (n != NULL && _ZP_ORDERED_MAP_TEMPLATE_KEY_CMP_FN(&n->_elem.key, key) == 0) {
+        _ZP_ORDERED_MAP_TEMPLATE_KEY_DESTROY_FN(key);
+        _ZP_ORDERED_MAP_TEMPLATE_VAL_DESTROY_FN(&n->_elem.val);
+        _ZP_ORDERED_MAP_TEMPLATE_VAL_MOVE_FN(&n->_elem.val, val);
+        return n;
+    }
+
+    uint8_t level = _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, random_level)(map);
+    n = (_ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *)_ZP_ORDERED_MAP_TEMPLATE_ALLOC_FN(
+        sizeof(_ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE) + (size_t)level * sizeof(_ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *));
+    if (n == NULL) {
+        return NULL;
+    }
+    n->_next = (_ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE **)(void *)(n + 1);
+    n->_level = level;
+    _ZP_ORDERED_MAP_TEMPLATE_KEY_MOVE_FN(&n->_elem.key, key);
+    _ZP_ORDERED_MAP_TEMPLATE_VAL_MOVE_FN(&n->_elem.val, val);
+
+    // A new level starts from the head sentinel.
+    for (size_t i = map->_level; i < level; i++) {
+        update[i] = &map->_head[i];
+    }
+    if (level > map->_level) {
+        map->_level = level;
+    }
+    for (size_t i = 0; i < level; i++) {
+        n->_next[i] = *update[i];
+        *update[i] = n;
+    }
+    map->_size++;
+    return n;
+}
+
+// ── Iteration ─────────────────────────────────────────────────────────────────
+//
+// Entries are visited in increasing key order:
+//   for (map_iter_t it = map_begin(&map); it != map_end(&map); it = map_iter_next(&map, it)) {
+//       map_elem_t *e = map_at(&map, it);
+//       // use e->key, e->val
+//   }
+
+// Returns the iterator to the entry with the smallest key, or an end iterator if the map is empty.
+static inline _ZP_ORDERED_MAP_TEMPLATE_ITER_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME,
+                                                         begin)(const _ZP_ORDERED_MAP_TEMPLATE_TYPE *map) {
+    return map->_head[0];
+}
+
+// Returns the post-end iterator.
+static inline _ZP_ORDERED_MAP_TEMPLATE_ITER_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME,
+                                                         end)(const _ZP_ORDERED_MAP_TEMPLATE_TYPE *map) {
+    (void)map;
+    return NULL;
+}
+
+// Returns the iterator following 'it'.
+static inline _ZP_ORDERED_MAP_TEMPLATE_ITER_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, iter_next)(
+    const _ZP_ORDERED_MAP_TEMPLATE_TYPE *map, _ZP_ORDERED_MAP_TEMPLATE_ITER_TYPE it) {
+    (void)map;
+    return it == NULL ? NULL : it->_next[0];
+}
+
+// Returns the entry at a valid iterator.
+static inline _ZP_ORDERED_MAP_TEMPLATE_ELEM_TYPE *_ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, at)(
+    _ZP_ORDERED_MAP_TEMPLATE_TYPE *map, _ZP_ORDERED_MAP_TEMPLATE_ITER_TYPE it) {
+    (void)map;
+    return &it->_elem;
+}
+
+// Returns the iterator to the first entry whose key is not less than key, or an end iterator.
+static inline _ZP_ORDERED_MAP_TEMPLATE_ITER_TYPE _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, lower_bound)(
+    _ZP_ORDERED_MAP_TEMPLATE_TYPE *map, const _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, key_t) * key) {
+    return _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, search)(map, key, NULL);
+}
+
+// ── front ─────────────────────────────────────────────────────────────────────
+// Returns the entry with the smallest key, or NULL if the map is empty.
+static inline _ZP_ORDERED_MAP_TEMPLATE_ELEM_TYPE *_ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME,
+                                                          front)(_ZP_ORDERED_MAP_TEMPLATE_TYPE *map) {
+    return map->_head[0] == NULL ? NULL : &map->_head[0]->_elem;
+}
+
+// ── remove ────────────────────────────────────────────────────────────────────
+// Removes the entry for key. Returns true if the key was found.
+// If out_val != NULL the value is moved out; otherwise it is destroyed.
+static inline bool _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, remove)(
+    _ZP_ORDERED_MAP_TEMPLATE_TYPE *map, const _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, key_t) * key,
+    _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE *out_val) {
+    _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE **update[_ZP_ORDERED_MAP_TEMPLATE_MAX_LEVEL];
+    _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *n = _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, search)(map, key, update);
+    if (n == NULL || _ZP_ORDERED_MAP_TEMPLATE_KEY_CMP_FN(&n->_elem.key, key) != 0) {
+        return false;
+    }
+    _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, unlink)(map, n, update);
+    _ZP_ORDERED_MAP_TEMPLATE_KEY_DESTROY_FN(&n->_elem.key);
+    if (out_val != NULL) {
+        _ZP_ORDERED_MAP_TEMPLATE_VAL_MOVE_FN(out_val, &n->_elem.val);
+    } else {
+        _ZP_ORDERED_MAP_TEMPLATE_VAL_DESTROY_FN(&n->_elem.val);
+    }
+    _ZP_ORDERED_MAP_TEMPLATE_FREE_FN(n);
+    return true;
+}
+
+// ── pop_first ─────────────────────────────────────────────────────────────────
+// Removes the entry with the smallest key in O(1). Returns false if the map is empty.
+// The key and value are moved to out_key / out_val when not NULL; otherwise they are destroyed.
+static inline bool _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, pop_first)(_ZP_ORDERED_MAP_TEMPLATE_TYPE *map,
+                                                                     _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE *out_key,
+                                                                     _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE *out_val) {
+    _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *n = map->_head[0];
+    if (n == NULL) {
+        return false;
+    }
+    // The first node is directly linked from the head at every one of its levels.
+    _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE **update[_ZP_ORDERED_MAP_TEMPLATE_MAX_LEVEL];
+    for (size_t i = 0; i < n->_level; i++) {
+        update[i] = &map->_head[i];
+    }
+    _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, unlink)(map, n, update);
+    if (out_key != NULL) {
+        _ZP_ORDERED_MAP_TEMPLATE_KEY_MOVE_FN(out_key, &n->_elem.key);
+    } else {
+        _ZP_ORDERED_MAP_TEMPLATE_KEY_DESTROY_FN(&n->_elem.key);
+    }
+    if (out_val != NULL) {
+        _ZP_ORDERED_MAP_TEMPLATE_VAL_MOVE_FN(out_val, &n->_elem.val);
+    } else {
+        _ZP_ORDERED_MAP_TEMPLATE_VAL_DESTROY_FN(&n->_elem.val);
+    }
+    _ZP_ORDERED_MAP_TEMPLATE_FREE_FN(n);
+    return true;
+}
+
+// ── destroy ───────────────────────────────────────────────────────────────────
+// Destroys all entries, frees all nodes and resets the map for reuse.
+static inline void _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, destroy)(_ZP_ORDERED_MAP_TEMPLATE_TYPE *map) {
+    _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *n = map->_head[0];
+    while (n != NULL) {
+        _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE *next = n->_next[0];
+        _ZP_ORDERED_MAP_TEMPLATE_KEY_DESTROY_FN(&n->_elem.key);
+        _ZP_ORDERED_MAP_TEMPLATE_VAL_DESTROY_FN(&n->_elem.val);
+        _ZP_ORDERED_MAP_TEMPLATE_FREE_FN(n);
+        n = next;
+    }
+    uint32_t seed = map->_seed;
+    _ZP_CAT(_ZP_ORDERED_MAP_TEMPLATE_NAME, init)(map);
+    map->_seed = seed;
+}
+
+// ── Undef all macros ──────────────────────────────────────────────────────────
+
+#undef _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE
+#undef _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE
+#undef _ZP_ORDERED_MAP_TEMPLATE_NAME
+#undef _ZP_ORDERED_MAP_TEMPLATE_KEY_CMP_FN
+#undef _ZP_ORDERED_MAP_TEMPLATE_MAX_LEVEL
+#undef _ZP_ORDERED_MAP_TEMPLATE_KEY_DESTROY_FN
+#undef _ZP_ORDERED_MAP_TEMPLATE_VAL_DESTROY_FN
+#undef _ZP_ORDERED_MAP_TEMPLATE_KEY_MOVE_FN
+#undef _ZP_ORDERED_MAP_TEMPLATE_VAL_MOVE_FN
+#undef _ZP_ORDERED_MAP_TEMPLATE_ALLOC_FN
+#undef _ZP_ORDERED_MAP_TEMPLATE_FREE_FN
+#undef _ZP_ORDERED_MAP_TEMPLATE_TYPE
+#undef _ZP_ORDERED_MAP_TEMPLATE_ELEM_TYPE
+#undef _ZP_ORDERED_MAP_TEMPLATE_NODE_TYPE
+#undef _ZP_ORDERED_MAP_TEMPLATE_ITER_TYPE
@@ -44,6 +44,12 @@ extern "C" {
 #if Z_FEATURE_LINK_TLS == 1
 #define TLS_SCHEMA "tls"
 #endif
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
+#define UNIXSOCK_STREAM_SCHEMA "unixsock-stream"
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+#define SHM_RING_SCHEMA "shm-ring"
+#endif
 
 #define LOCATOR_PROTOCOL_SEPARATOR '/'
 #define LOCATOR_METADATA_SEPARATOR '?'
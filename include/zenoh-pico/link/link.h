@@ -21,6 +21,9 @@
 #include "zenoh-pico/link/transport/raweth.h"
 #include "zenoh-pico/link/transport/tcp.h"
 #include "zenoh-pico/link/transport/udp_unicast.h"
+#include "zenoh-pico/link/transport/shm_ring.h"
+#include "zenoh-pico/link/transport/socket.h"
+#include "zenoh-pico/link/transport/unixsock_stream.h"
 #include "zenoh-pico/link/transport/ws.h"
 #include "zenoh-pico/protocol/iobuf.h"
 #include "zenoh-pico/system/platform.h"
@@ -90,6 +93,8 @@ typedef void (*_z_f_link_close)(struct _z_link_t *self);
 typedef size_t (*_z_f_link_write)(const struct _z_link_t *self, const uint8_t *ptr, size_t len,
                                   _z_sys_net_socket_t *socket);
 typedef size_t (*_z_f_link_write_all)(const struct _z_link_t *self, const uint8_t *ptr, size_t len);
+// Writes out the data kept by the writes of a link that buffers them, NULL for the links writing through
+typedef z_result_t (*_z_f_link_flush)(const struct _z_link_t *self, _z_sys_net_socket_t *socket);
 typedef size_t (*_z_f_link_read)(const struct _z_link_t *self, uint8_t *ptr, size_t len, _z_slice_t *addr);
 typedef size_t (*_z_f_link_read_exact)(const struct _z_link_t *self, uint8_t *ptr, size_t len, _z_slice_t *addr,
                                        _z_sys_net_socket_t *socket);
@@ -112,6 +117,8 @@ enum _z_link_type_e {
     _Z_LINK_TYPE_WS,
     _Z_LINK_TYPE_TLS,
     _Z_LINK_TYPE_RAWETH,
+    _Z_LINK_TYPE_UNIXSOCK_STREAM,
+    _Z_LINK_TYPE_SHM_RING,
 };
 
 typedef struct _z_link_t {
@@ -138,6 +145,12 @@ typedef struct _z_link_t {
 #endif
 #if Z_FEATURE_RAWETH_TRANSPORT == 1
         _z_raweth_socket_t _raweth;
+#endif
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
+        _z_unixsock_stream_socket_t _unixsock;
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+        _z_shm_ring_socket_t _shm;
 #endif
     } _socket;
 
@@ -146,6 +159,7 @@ typedef struct _z_link_t {
     _z_f_link_close _close_f;
     _z_f_link_write _write_f;
     _z_f_link_write_all _write_all_f;
+    _z_f_link_flush _flush_f;
     _z_f_link_read _read_f;
     _z_f_link_read_exact _read_exact_f;
     _z_f_link_read_socket _read_socket_f;
@@ -161,12 +175,21 @@ z_result_t _z_open_socket(const _z_string_t *locator, const _z_config_t *session
 z_result_t _z_open_link(_z_link_t *zl, const _z_string_t *locator, const _z_config_t *session_cfg);
 z_result_t _z_listen_link(_z_link_t *zl, const _z_string_t *locator, const _z_config_t *session_cfg);
 
+// Writes wbf on the link and flushes it
 z_result_t _z_link_send_wbuf(const _z_link_t *zl, const _z_wbuf_t *wbf, _z_sys_net_socket_t *socket);
+// Writes wbf on the link, which may keep its end buffered until the next write or _z_link_flush
+z_result_t _z_link_write_wbuf(const _z_link_t *zl, const _z_wbuf_t *wbf, _z_sys_net_socket_t *socket);
+z_result_t _z_link_flush(const _z_link_t *zl, _z_sys_net_socket_t *socket);
 size_t _z_link_recv_zbuf(const _z_link_t *zl, _z_zbuf_t *zbf, _z_slice_t *addr);
 size_t _z_link_recv_exact_zbuf(const _z_link_t *zl, _z_zbuf_t *zbf, size_t len, _z_slice_t *addr,
                                _z_sys_net_socket_t *socket);
 size_t _z_link_socket_recv_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, const _z_sys_net_socket_t socket);
 const _z_sys_net_socket_t *_z_link_get_socket(const _z_link_t *link);
+#if Z_FEATURE_IO_URING == 1
+// True if writing on the link is a plain send on its socket, which io_uring can do in its place
+bool _z_link_supports_uring(const _z_link_t *link);
+z_result_t _z_link_send_wbuf_uring(const _z_wbuf_t *wbf, _z_socket_uring_t *ring, _z_socket_wait_iter_t *iter);
+#endif
 
 #ifdef __cplusplus
 }
@@ -53,6 +53,16 @@ z_result_t _z_endpoint_tls_valid(_z_endpoint_t *ep);
 z_result_t _z_new_peer_tls(_z_endpoint_t *endpoint, _z_sys_net_socket_t *socket, const _z_config_t *session_cfg);
 z_result_t _z_new_link_tls(_z_link_t *zl, _z_endpoint_t *ep, const _z_config_t *session_cfg);
 #endif
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
+z_result_t _z_endpoint_unixsock_stream_valid(_z_endpoint_t *ep);
+z_result_t _z_new_peer_unixsock_stream(_z_endpoint_t *endpoint, _z_sys_net_socket_t *socket);
+z_result_t _z_new_link_unixsock_stream(_z_link_t *zl, _z_endpoint_t *ep);
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+z_result_t _z_endpoint_shm_ring_valid(_z_endpoint_t *ep);
+z_result_t _z_new_peer_shm_ring(_z_endpoint_t *endpoint, _z_sys_net_socket_t *socket);
+z_result_t _z_new_link_shm_ring(_z_link_t *zl, _z_endpoint_t *ep);
+#endif
 
 #ifdef __cplusplus
 }
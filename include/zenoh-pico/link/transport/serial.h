@@ -24,6 +24,19 @@
 extern "C" {
 #endif
 
+/**
+ * Largest read the serial framing hands to _z_serial_read. Drivers whose read returns as soon as some bytes are
+ * available are read in bulk, the others wait for the whole request and are therefore read one byte at a time so that
+ * no read spans the end of a frame.
+ */
+#ifndef _Z_SERIAL_READ_CHUNK_SIZE
+#if defined(ZENOH_LINUX) || defined(ZENOH_MACOS) || defined(ZENOH_BSD) || defined(ZENOH_THREADX_STM32)
+#define _Z_SERIAL_READ_CHUNK_SIZE 512
+#else
+#define _Z_SERIAL_READ_CHUNK_SIZE 1
+#endif
+#endif
+
 z_result_t _z_serial_open_from_pins(_z_sys_net_socket_t *sock, uint32_t txpin, uint32_t rxpin, uint32_t baudrate);
 z_result_t _z_serial_open_from_dev(_z_sys_net_socket_t *sock, const char *dev, uint32_t baudrate);
 z_result_t _z_serial_listen_from_pins(_z_sys_net_socket_t *sock, uint32_t txpin, uint32_t rxpin, uint32_t baudrate);
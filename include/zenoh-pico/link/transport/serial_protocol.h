@@ -33,18 +33,37 @@ extern "C" {
 #define _Z_SERIAL_MAX_COBS_BUF_SIZE \
     1516  // Max On-the-wire length for an MFS/MTU of 1510/1500 (MFS + Overhead Byte (OHB) + End of packet (EOP))
 
+/**
+ * Framing buffers of a serial link, allocated once when the link is opened. The RX and TX sides are used concurrently
+ * by the read task and the writers, so they do not share any buffer.
+ */
+typedef struct {
+    // Bytes read from the device and not yet consumed, frames are delimited by a 0x00 byte
+    uint8_t _rx_raw[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+    size_t _rx_start;
+    size_t _rx_end;
+    size_t _rx_scanned;  // No delimiter in [_rx_start, _rx_scanned)
+    // The decoder wants room for the whole encoded frame, not only for the decoded one
+    uint8_t _rx_tmp[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+    uint8_t _tx_raw[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+    uint8_t _tx_tmp[_Z_SERIAL_MFS_SIZE];
+} _z_serial_buffers_t;
+
 typedef struct {
     _z_sys_net_socket_t _sock;
+    _z_serial_buffers_t *_bufs;
 } _z_serial_socket_t;
 
 z_result_t _z_serial_endpoint_valid(const _z_endpoint_t *endpoint);
 z_result_t _z_serial_protocol_open(_z_serial_socket_t *sock, const _z_endpoint_t *endpoint);
 z_result_t _z_serial_protocol_listen(_z_serial_socket_t *sock, const _z_endpoint_t *endpoint);
 void _z_serial_protocol_close(_z_serial_socket_t *sock);
-z_result_t _z_connect_serial(const _z_sys_net_socket_t sock);
-size_t _z_read_serial(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
-size_t _z_send_serial(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t len);
-size_t _z_read_exact_serial(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
+z_result_t _z_connect_serial(const _z_serial_socket_t *sock);
+size_t _z_read_serial(const _z_serial_socket_t *sock, uint8_t *ptr, size_t len);
+size_t _z_send_serial(const _z_serial_socket_t *sock, const uint8_t *ptr, size_t len);
+size_t _z_read_exact_serial(const _z_serial_socket_t *sock, uint8_t *ptr, size_t len);
+// Reads a frame from a socket that is not owned by a link, one byte at a time through temporary buffers
+size_t _z_read_serial_socket(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
 
 #endif
 
@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_LINK_TRANSPORT_SHM_RING_H
+#define ZENOH_PICO_LINK_TRANSPORT_SHM_RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/system/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Size of each direction of a connection, must be a power of two
+#define _Z_SHM_RING_CAPACITY ((size_t)1 << 20)
+
+/**
+ * A shared-memory link carries a byte stream in each direction through a single-producer single-consumer ring mapped
+ * by both processes, with an eventfd per direction to wake up the reader. The locator address is the path of a Unix
+ * socket used only to hand over the mapping and the eventfds when a connection is established.
+ *
+ * A connected socket has its ``_fd`` set to the eventfd signalled when data is available, so it can be waited on like
+ * any other socket, and ``_shm_ring`` pointing to the local view of the mapping.
+ */
+typedef struct {
+    _z_sys_net_socket_t _sock;
+    char *_path;
+    bool _is_listener;  // The listener owns the socket file and removes it on close
+} _z_shm_ring_socket_t;
+
+z_result_t _z_shm_ring_address_valid(const _z_string_t *address);
+
+// flawfinder: ignore
+z_result_t _z_shm_ring_open(_z_sys_net_socket_t *sock, const char *path, uint32_t tout);
+z_result_t _z_shm_ring_listen(_z_sys_net_socket_t *sock, const char *path);
+z_result_t _z_shm_ring_accept(const _z_sys_net_socket_t *sock_in, _z_sys_net_socket_t *sock_out);
+void _z_shm_ring_close(_z_sys_net_socket_t *sock);
+void _z_shm_ring_unlink(const char *path);
+// Releases the mapping of a connected socket and tells the other side, the eventfd is left to _z_socket_close
+void _z_close_shm_ring_socket(_z_sys_net_socket_t *sock);
+
+// flawfinder: ignore
+size_t _z_shm_ring_read(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
+size_t _z_shm_ring_read_exact(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
+size_t _z_shm_ring_write(_z_sys_net_socket_t sock, const uint8_t *ptr, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_LINK_TRANSPORT_SHM_RING_H */
@@ -49,6 +49,8 @@ static inline void _z_socket_wait_iter_set_ready(_z_socket_wait_iter_t *iter, bo
 }
 
 z_result_t _z_socket_wait_readable(_z_socket_wait_iter_t *iter, uint32_t timeout_ms);
+// Waits for sock to accept more data, returns _Z_NO_DATA_PROCESSED on timeout. Provided by the ports with TLS links.
+z_result_t _z_socket_wait_writable(const _z_sys_net_socket_t *sock, uint32_t timeout_ms);
 
 z_result_t _z_socket_set_blocking(const _z_sys_net_socket_t *sock, bool blocking);
 z_result_t _z_ip_port_to_endpoint(const uint8_t *address, size_t address_len, uint16_t port, char *dst, size_t dst_len);
@@ -56,6 +58,24 @@ z_result_t _z_socket_get_endpoints(const _z_sys_net_socket_t *sock, char *local,
                                    size_t remote_len);
 void _z_socket_close(_z_sys_net_socket_t *sock);
 
+#if Z_FEATURE_IO_URING == 1
+// An io_uring instance used to send the same buffer to many sockets with few system calls
+typedef struct _z_socket_uring_t _z_socket_uring_t;
+
+z_result_t _z_socket_uring_new(_z_socket_uring_t **ring);
+void _z_socket_uring_free(_z_socket_uring_t **ring);
+/**
+ * Sends ``len`` bytes from ``ptr`` on every socket of ``iter``, submitting as many sends per system call as the ring
+ * holds. Only ``_reset``, ``_next`` and ``_get_socket`` of the iterator are used. As with sequential sends, a socket
+ * that fails or takes only part of the buffer does not prevent the others from being served.
+ *
+ * Returns an error only if nothing could be submitted, in which case the caller is expected to fall back to sending on
+ * each socket in turn.
+ */
+z_result_t _z_socket_uring_send_all(_z_socket_uring_t *ring, _z_socket_wait_iter_t *iter, const uint8_t *ptr,
+                                    size_t len);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,12 @@ extern "C" {
 #include "mbedtls/pk.h"
 #include "mbedtls/ssl.h"
 #include "mbedtls/x509_crt.h"
+#if defined(MBEDTLS_SSL_CACHE_C)
+#include "mbedtls/ssl_cache.h"
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+#include "mbedtls/ssl_ticket.h"
+#endif
 
 typedef struct {
     mbedtls_ssl_context _ssl;
@@ -46,6 +52,19 @@ typedef struct {
     mbedtls_pk_context _client_key;
     mbedtls_x509_crt _client_cert;
     bool _enable_mtls;
+    // Listening side, shared by the accepted sockets through the SSL config
+#if defined(MBEDTLS_SSL_CACHE_C)
+    mbedtls_ssl_cache_context _session_cache;
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+    mbedtls_ssl_ticket_context _session_ticket;
+#endif
+    // Connecting side, the peer address, hostname and configuration a saved session can be resumed with
+    _z_slice_t _session_identity;
+    // Buffered writes are coalesced in records of up to _tx_cap bytes, written through without a buffer
+    uint8_t *_tx_buf;
+    size_t _tx_len;
+    size_t _tx_cap;
 } _z_tls_context_t;
 
 typedef struct {
@@ -58,11 +77,23 @@ z_result_t _z_open_tls(_z_tls_socket_t *sock, const _z_sys_net_endpoint_t *rep,
                        const _z_str_intmap_t *config, bool peer_socket);
 z_result_t _z_listen_tls(_z_tls_socket_t *sock, const _z_sys_net_endpoint_t *rep, const _z_str_intmap_t *config);
 z_result_t _z_tls_accept(_z_sys_net_socket_t *socket, const _z_sys_net_socket_t *listen_sock);
+// Non-blocking accept: the setup attaches the TLS socket, then the handshake is driven until it stops returning
+// _Z_NO_DATA_PROCESSED. On failure after the setup, the socket is released with _z_close_tls_socket.
+z_result_t _z_tls_accept_setup(_z_sys_net_socket_t *socket, const _z_sys_net_socket_t *listen_sock);
+z_result_t _z_tls_accept_handshake(_z_sys_net_socket_t *socket);
 void _z_close_tls_socket(_z_sys_net_socket_t *socket);
 void _z_close_tls(_z_tls_socket_t *sock);
 size_t _z_read_tls(const _z_tls_socket_t *sock, uint8_t *ptr, size_t len);
 size_t _z_write_tls(const _z_tls_socket_t *sock, const uint8_t *ptr, size_t len);
 size_t _z_write_all_tls(const _z_tls_socket_t *sock, const uint8_t *ptr, size_t len);
+// Writes the whole buffer, the end of the last record may be kept until the next write or _z_flush_tls
+size_t _z_write_buffered_tls(const _z_tls_socket_t *sock, const uint8_t *ptr, size_t len);
+z_result_t _z_flush_tls(const _z_tls_socket_t *sock);
+
+#if defined(Z_TEST_HOOKS)
+// Number of handshakes the listening side of the process resumed from a cached session or a ticket.
+size_t _z_tls_resumed_handshakes(void);
+#endif
 
 #endif  // Z_FEATURE_LINK_TLS == 1
 
@@ -0,0 +1,53 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_LINK_TRANSPORT_UNIXSOCK_STREAM_H
+#define ZENOH_PICO_LINK_TRANSPORT_UNIXSOCK_STREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/system/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    _z_sys_net_socket_t _sock;
+    char *_path;
+    bool _is_listener;  // The listener owns the socket file and removes it on close
+} _z_unixsock_stream_socket_t;
+
+z_result_t _z_unixsock_stream_address_valid(const _z_string_t *address);
+
+// flawfinder: ignore
+z_result_t _z_unixsock_stream_open(_z_sys_net_socket_t *sock, const char *path, uint32_t tout);
+z_result_t _z_unixsock_stream_listen(_z_sys_net_socket_t *sock, const char *path);
+z_result_t _z_unixsock_stream_accept(const _z_sys_net_socket_t *sock_in, _z_sys_net_socket_t *sock_out);
+void _z_unixsock_stream_close(_z_sys_net_socket_t *sock);
+void _z_unixsock_stream_unlink(const char *path);
+
+// flawfinder: ignore
+size_t _z_unixsock_stream_read(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
+size_t _z_unixsock_stream_read_exact(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
+size_t _z_unixsock_stream_write(_z_sys_net_socket_t sock, const uint8_t *ptr, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_LINK_TRANSPORT_UNIXSOCK_STREAM_H */
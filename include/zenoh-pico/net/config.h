@@ -54,6 +54,18 @@ z_result_t _z_config_default(_z_config_t *config);
  */
 z_result_t _z_config_client(_z_config_t *config, const char *locator);
 
+/**
+ * Get the multicast locators to scout on, or the default one if none was set.
+ *
+ * Parameters:
+ *   config:   A :c:type:`_z_config_t` to read the locators from.
+ *   locators: A :c:type:`_z_string_svec_t` the locators are appended to.
+ *
+ * Returns:
+ *     `0`` in case of success, or a ``negative value`` otherwise.
+ */
+z_result_t _z_config_get_scouting_locators(const _z_config_t *config, _z_string_svec_t *locators);
+
 #ifdef __cplusplus
 }
 #endif
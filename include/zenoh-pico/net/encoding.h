@@ -38,7 +38,20 @@ static inline bool _z_encoding_check(const _z_encoding_t *encoding) {
 }
 static inline void _z_encoding_clear(_z_encoding_t *encoding) { _z_string_clear(&encoding->schema); }
 _z_encoding_t _z_encoding_wrap(uint16_t id, const char *schema);
+#if Z_FEATURE_ENCODING_VALUES == 1
+// Number of predefined encodings, whose ids go from 0 to this value excluded
+extern const size_t _z_encoding_values_len;
+#endif
 z_result_t _z_encoding_make(_z_encoding_t *encoding, uint16_t id, const char *schema, size_t len);
+/**
+ * Stores a copy of the schema in a refcounted buffer, so that subsequent :c:func:`_z_encoding_copy` calls share it.
+ * The last interned schemas are kept, interning one of them again shares its buffer.
+ */
+z_result_t _z_encoding_schema_intern(_z_string_t *dst, const char *schema, size_t len);
+/**
+ * Converts an aliased or owned schema of the encoding into an interned one, in place.
+ */
+z_result_t _z_encoding_intern(_z_encoding_t *encoding);
 z_result_t _z_encoding_copy(_z_encoding_t *dst, const _z_encoding_t *src);
 z_result_t _z_encoding_move(_z_encoding_t *dst, _z_encoding_t *src);
 static inline _z_encoding_t _z_encoding_alias(const _z_encoding_t *src) {
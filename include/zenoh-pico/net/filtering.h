@@ -19,6 +19,7 @@
 #include "zenoh-pico/api/constants.h"
 #include "zenoh-pico/net/session.h"
 #include "zenoh-pico/protocol/core.h"
+#include "zenoh-pico/session/keyexpr_intern.h"
 #include "zenoh-pico/utils/locality.h"
 
 #ifdef __cplusplus
@@ -57,7 +58,7 @@ typedef struct {
 #if Z_FEATURE_MATCHING == 1
     _z_closure_matching_status_intmap_t callbacks;
 #endif
-    _z_keyexpr_t key;
+    _z_interned_keyexpr_t key;
     uint8_t state;
     bool is_complete;
     bool is_aggregate;
@@ -88,6 +89,11 @@ void _z_write_filter_notify_subscriber(struct _z_session_t *session, const _z_ke
                                        z_locality_t allowed_origin, bool add);
 void _z_write_filter_notify_queryable(struct _z_session_t *session, const _z_keyexpr_t *key,
                                       z_locality_t allowed_origin, bool is_complete, bool add);
+// Notify the write filters of several local entities at once, under a single acquisition of the session mutex
+void _z_write_filter_notify_subscribers(struct _z_session_t *session, const _z_subscription_rc_t *subs, size_t len,
+                                        bool add);
+void _z_write_filter_notify_queryables(struct _z_session_t *session, const _z_session_queryable_rc_t *qles,
+                                       size_t len, bool add);
 
 #if Z_FEATURE_MATCHING
 z_result_t _z_write_filter_ctx_add_callback(_z_write_filter_ctx_t *filter, size_t id, _z_closure_matching_status_t *v);
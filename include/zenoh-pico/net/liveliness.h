@@ -28,6 +28,12 @@ extern "C" {
 z_result_t _z_declare_liveliness_token(const _z_session_rc_t *zn, _z_liveliness_token_t *ret_token,
                                        const _z_declared_keyexpr_t *keyexpr);
 z_result_t _z_undeclare_liveliness_token(_z_liveliness_token_t *token);
+// Declares len tokens with their declarations batched together. Either all the tokens are declared or none of them,
+// the tokens whose declaration may have reached the network are then undeclared.
+z_result_t _z_declare_liveliness_tokens(const _z_session_rc_t *zn, _z_liveliness_token_t *tokens,
+                                        const _z_declared_keyexpr_t *const *keyexprs, size_t len);
+// Undeclares len tokens with their undeclarations batched together, returns the first error met
+z_result_t _z_undeclare_liveliness_tokens(_z_liveliness_token_t *tokens, size_t len);
 
 #if Z_FEATURE_SUBSCRIPTION == 1
 /**
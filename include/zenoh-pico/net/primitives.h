@@ -32,6 +32,18 @@ extern "C" {
 /*------------- Declaration Helpers --------------*/
 z_result_t _z_send_declare(_z_session_t *zn, const _z_network_message_t *n_msg);
 z_result_t _z_send_undeclare(_z_session_t *zn, const _z_network_message_t *n_msg);
+// Send len (un)declarations back to back under a single acquisition of the transmission lock
+z_result_t _z_send_declares(_z_session_t *zn, const _z_network_message_t *n_msgs, size_t len);
+z_result_t _z_send_undeclares(_z_session_t *zn, const _z_network_message_t *n_msgs, size_t len);
+// Sends the undeclarations of a bulk declaration that failed once handed to _z_send_declares, which may have sent part
+// of it. The remote side ignores undeclarations of entities it does not know. cached tells whether _z_send_declares
+// succeeded and cached the declarations for reconnection, they are then removed from the cache.
+void _z_send_declares_rollback(_z_session_t *zn, const _z_network_message_t *n_msgs, size_t len, bool cached);
+// Batch the messages sent by a bulk (un)declaration, including the key expressions it declares. Returns true if
+// batching was started, false if it is not available or was already started by the user.
+bool _z_declare_batch_start(_z_session_t *zn);
+// Stops the batching started by _z_declare_batch_start and flushes the batch. Returns ret, or the flush error.
+z_result_t _z_declare_batch_stop(_z_session_t *zn, bool started, z_result_t ret);
 
 /*------------------ Discovery ------------------*/
 #if Z_FEATURE_SCOUTING == 1
@@ -41,10 +53,10 @@ z_result_t _z_send_undeclare(_z_session_t *zn, const _z_network_message_t *n_msg
  * Parameters:
  *     what: A what bitmask of zenoh entities kind to scout for.
  *     zid: The ZenohID of the scouting origin.
- *     locator: The locator where to scout.
+ *     locators: The multicast locators where to scout, all at once.
  *     timeout: The time that should be spent scouting before returning the results.
  */
-void _z_scout(const z_what_t what, const _z_id_t zid, _z_string_t *locator, const uint32_t timeout,
+void _z_scout(const z_what_t what, const _z_id_t zid, const _z_string_svec_t *locators, const uint32_t timeout,
               _z_closure_hello_callback_t callback, void *arg_call, _z_drop_handler_t dropper, void *arg_drop);
 #endif
 /*------------------ Declarations ------------------*/
@@ -151,6 +163,74 @@ z_result_t _z_write(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, _z_b
                     _z_encoding_t *encoding, const z_sample_kind_t kind, const z_congestion_control_t cong_ctrl,
                     z_priority_t priority, bool is_express, const _z_timestamp_t *timestamp, _z_bytes_t *attachment,
                     z_reliability_t reliability, const _z_source_info_t *source_info, z_locality_t allowed_destination);
+
+/**
+ * Reserves room for the payload of a put directly in the transmission buffer of the session transport.
+ *
+ * The message headers are encoded right away and ``payload_len`` bytes are left for the payload at ``loan->_buf``.
+ * The transmission lock is held until the loan is committed with :c:func:`_z_send_n_msg_loan_commit` or aborted
+ * with :c:func:`_z_send_n_msg_loan_abort`. When the transport can't lend its buffer, ``loan->_buf`` is ``NULL`` and
+ * the payload has to be sent with :c:func:`_z_write`.
+ *
+ * Parameters:
+ *     zn: The zenoh-net session. The caller keeps its ownership.
+ *     keyexpr: The resource key to write. The caller keeps its ownership.
+ *     payload_len: The length of the payload to reserve.
+ *     encoding: The encoding of the payload. The caller keeps its ownership.
+ *     cong_ctrl: The congestion control of this write. Possible values defined
+ *                in :c:type:`_z_congestion_control_t`.
+ *     is_express: If true, Zenoh will not wait to batch this operation with others to reduce the bandwidth.
+ *     timestamp: The timestamp of this write. The API level timestamp (e.g. of the data when it was created).
+ *     attachment: An optional attachment to this write.
+ *     reliability: The message reliability.
+ *     source_info: The message source info.
+ *     loan: The loan to fill.
+ * Returns:
+ *     ``0`` in case of success, negative error code otherwise.
+ */
+z_result_t _z_write_loan(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, size_t payload_len,
+                         _z_encoding_t *encoding, z_congestion_control_t cong_ctrl, z_priority_t priority,
+                         bool is_express, const _z_timestamp_t *timestamp, _z_bytes_t *attachment,
+                         z_reliability_t reliability, const _z_source_info_t *source_info,
+                         _z_transport_tx_loan_t *loan);
+
+/**
+ * A single sample of a :c:func:`_z_write_many` operation.
+ *
+ * Members:
+ *     payload: The data to write.
+ *     attachment: An optional attachment to this sample.
+ *     timestamp: An optional timestamp of this sample.
+ */
+typedef struct {
+    _z_bytes_t *payload;
+    _z_bytes_t *attachment;
+    const _z_timestamp_t *timestamp;
+} _z_write_item_t;
+
+/**
+ * Write several put samples for a given resource key. The samples are encoded back to back under a single
+ * acquisition of the transmission lock and flushed once, only the ones that do not fit in a batch are fragmented.
+ *
+ * Parameters:
+ *     zn: The zenoh-net session. The caller keeps its ownership.
+ *     keyexpr: The resource key to write. The caller keeps its ownership.
+ *     items: The samples to write. The caller keeps their ownership.
+ *     len: The number of samples.
+ *     encoding: The encoding shared by all the payloads.
+ *     cong_ctrl: The congestion control of this write. Possible values defined
+ *                in :c:type:`_z_congestion_control_t`.
+ *     is_express: If true, Zenoh will not wait to batch this operation with others to reduce the bandwidth.
+ *     reliability: The message reliability.
+ *     source_info: The message source info.
+ *     allowed_destination: The allowed destination locality.
+ * Returns:
+ *     ``0`` in case of success, negative error code otherwise.
+ */
+z_result_t _z_write_many(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, const _z_write_item_t *items,
+                         size_t len, _z_encoding_t *encoding, z_congestion_control_t cong_ctrl, z_priority_t priority,
+                         bool is_express, z_reliability_t reliability, const _z_source_info_t *source_info,
+                         z_locality_t allowed_destination);
 #endif
 
 #if Z_FEATURE_SUBSCRIPTION == 1
@@ -187,6 +267,52 @@ z_result_t _z_register_subscriber(uint32_t *out_sub_id, const _z_session_rc_t *z
  *    0 if success, or a negative value identifying the error.
  */
 z_result_t _z_undeclare_subscriber(_z_subscriber_t *sub);
+
+/**
+ * A single subscriber of a :c:func:`_z_declare_subscribers` operation.
+ *
+ * Members:
+ *     keyexpr: The resource key to subscribe.
+ *     callback: The callback function that will be called each time a data matching the subscribed resource is
+ * received.
+ *     dropper: A function that will be called once subscriber is undeclared.
+ *     arg: A pointer that will be passed to the **callback** on each call.
+ */
+typedef struct {
+    const _z_declared_keyexpr_t *keyexpr;
+    _z_closure_sample_callback_t callback;
+    _z_drop_handler_t dropper;
+    void *arg;
+} _z_subscriber_item_t;
+
+/**
+ * Declare several :c:type:`_z_subscriber_t` at once. The subscribers are registered under a single lock and their
+ * declarations are batched together. Either all the subscribers are declared, or none of them and their droppers are
+ * called. In that case, undeclarations are sent for the declarations that may have reached the network.
+ *
+ * Parameters:
+ *     subscribers: The len subscribers to initialize.
+ *     zn: The zenoh-net session. The caller keeps its ownership.
+ *     items: The subscribers to declare.
+ *     len: The number of subscribers.
+ *     allowed_origin: The allowed origin locality, shared by all the subscribers.
+ *
+ * Returns:
+ *    0 in case of success, negative error code otherwise.
+ */
+z_result_t _z_declare_subscribers(_z_subscriber_t *subscribers, const _z_session_rc_t *zn,
+                                  const _z_subscriber_item_t *items, size_t len, z_locality_t allowed_origin);
+
+/**
+ * Undeclare several :c:type:`_z_subscriber_t` at once, batching their undeclarations together.
+ *
+ * Parameters:
+ *     subs: The len subscribers to undeclare. The callee releases all of them.
+ *     len: The number of subscribers.
+ * Returns:
+ *    0 if success, or the first error met.
+ */
+z_result_t _z_undeclare_subscribers(_z_subscriber_t *subs, size_t len);
 #endif
 
 #if Z_FEATURE_QUERYABLE == 1
@@ -225,6 +351,53 @@ z_result_t _z_register_queryable(uint32_t *queryable_id, const _z_session_rc_t *
  */
 z_result_t _z_undeclare_queryable(_z_queryable_t *qle);
 
+/**
+ * A single queryable of a :c:func:`_z_declare_queryables` operation.
+ *
+ * Members:
+ *     keyexpr: The resource key the :c:type:`_z_queryable_t` will reply to.
+ *     callback: The callback function that will be called each time a matching query is received.
+ *     dropper: A function that will be called once queryable is undeclared.
+ *     arg: A pointer that will be passed to the **callback** on each call.
+ */
+typedef struct {
+    const _z_declared_keyexpr_t *keyexpr;
+    _z_closure_query_callback_t callback;
+    _z_drop_handler_t dropper;
+    void *arg;
+} _z_queryable_item_t;
+
+/**
+ * Declare several :c:type:`_z_queryable_t` at once. The queryables are registered under a single lock and their
+ * declarations are batched together. Either all the queryables are declared, or none of them and their droppers are
+ * called. In that case, undeclarations are sent for the declarations that may have reached the network.
+ *
+ * Parameters:
+ *     queryables: The len queryables to initialize.
+ *     zn: The zenoh-net session. The caller keeps its ownership.
+ *     items: The queryables to declare.
+ *     len: The number of queryables.
+ *     complete: The complete of the queryables.
+ *     allowed_origin: The allowed origin locality, shared by all the queryables.
+ *
+ * Returns:
+ *    0 in case of success, negative error code otherwise.
+ */
+z_result_t _z_declare_queryables(_z_queryable_t *queryables, const _z_session_rc_t *zn,
+                                 const _z_queryable_item_t *items, size_t len, bool complete,
+                                 z_locality_t allowed_origin);
+
+/**
+ * Undeclare several :c:type:`_z_queryable_t` at once, batching their undeclarations together.
+ *
+ * Parameters:
+ *     qles: The len queryables to undeclare. The callee releases all of them.
+ *     len: The number of queryables.
+ * Returns:
+ *    0 if success, or the first error met.
+ */
+z_result_t _z_undeclare_queryables(_z_queryable_t *qles, size_t len);
+
 /**
  * Send a reply to a query.
  *
@@ -94,6 +94,7 @@ z_result_t _z_reply_copy(_z_reply_t *dst, const _z_reply_t *src);
 typedef struct _z_pending_reply_t {
     _z_reply_t _reply;
     _z_timestamp_t _tstamp;
+    size_t _hash;  // Hash of the key expression of _reply, compared before it by the consolidation
 } _z_pending_reply_t;
 
 bool _z_pending_reply_eq(const _z_pending_reply_t *one, const _z_pending_reply_t *two);
@@ -15,6 +15,7 @@
 #define ZENOH_PICO_SAMPLE_NETAPI_H
 
 #include "zenoh-pico/collections/element.h"
+#include "zenoh-pico/collections/refcount.h"
 #include "zenoh-pico/collections/ring.h"
 #include "zenoh-pico/net/encoding.h"
 #include "zenoh-pico/protocol/core.h"
@@ -82,6 +83,7 @@ _z_sample_t _z_sample_duplicate(const _z_sample_t *src);
 _Z_ELEM_DEFINE(_z_sample, _z_sample_t, _z_sample_size, _z_sample_clear, _z_sample_copy, _z_sample_move, _z_noop_eq,
                _z_noop_cmp, _z_noop_hash)
 _Z_RING_DEFINE(_z_sample, _z_sample_t)
+_Z_REFCOUNT_DEFINE(_z_sample, _z_sample)
 
 #ifdef __cplusplus
 }
@@ -19,11 +19,13 @@
 
 #include "zenoh-pico/collections/atomic.h"
 #include "zenoh-pico/collections/element.h"
+#include "zenoh-pico/collections/epoch.h"
 #include "zenoh-pico/collections/list.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/definitions/network.h"
 #include "zenoh-pico/runtime/runtime.h"
+#include "zenoh-pico/session/declaration_cache.h"
 #include "zenoh-pico/session/liveliness.h"
 #include "zenoh-pico/session/matching.h"
 #include "zenoh-pico/session/queryable.h"
@@ -35,6 +37,13 @@
 extern "C" {
 #endif
 
+// The last generated timestamp is advanced with a compare-and-swap when a size_t can hold it
+#if SIZE_MAX >= UINT64_MAX
+#define _Z_SESSION_ATOMIC_LAST_TIMESTAMP 1
+#else
+#define _Z_SESSION_ATOMIC_LAST_TIMESTAMP 0
+#endif
+
 /**
  * A zenoh-net session.
  */
@@ -122,6 +131,20 @@ typedef struct _z_session_t {
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_t _mutex_inner;
     _z_mutex_rec_t _mutex_transport;
+    // Registry locks, so that dispatching on the RX task does not wait on declarations of unrelated entities.
+    // _mutex_inner may be held while taking one of them, never the other way around.
+#if Z_FEATURE_SUBSCRIPTION == 1
+    _z_mutex_t _mutex_subscriptions;  // Subscriptions, liveliness subscriptions and the publication of their snapshots
+#if Z_FEATURE_RX_CACHE == 1
+    _z_mutex_t _mutex_subscription_cache;  // Subscription cache, may be taken while holding _mutex_subscriptions
+#endif
+#endif
+#if Z_FEATURE_QUERYABLE == 1
+    _z_mutex_t _mutex_queryables;  // Local queryables and their cache
+#endif
+#if Z_FEATURE_QUERY == 1
+    _z_mutex_t _mutex_queries;  // Pending queries and the query id counter
+#endif
 #if Z_FEATURE_ADMIN_SPACE == 1
     _z_mutex_t _mutex_admin_space;
 #endif
@@ -139,9 +162,13 @@ typedef struct _z_session_t {
     uint32_t _entity_id;
     _z_zint_t _query_id;
     _z_zint_t _interest_id;
+#if _Z_SESSION_ATOMIC_LAST_TIMESTAMP == 1
+    _z_atomic_size_t _last_timestamp;
+#else
     _z_ntp64_t _last_timestamp;
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_t _mutex_last_timestamp;
+#endif
 #endif
 
     // Session declarations
@@ -149,17 +176,28 @@ typedef struct _z_session_t {
 
     // Information for session restoring and asynchronous peer connection
     _z_config_t _config;
+#if Z_FEATURE_SCOUTING == 1
+    // Receiving buffer of the scouting done to open the session, kept for the scouting of the reconnections
+    _z_zbuf_t _scout_zbuf;
+#endif
 
 #if Z_FEATURE_AUTO_RECONNECT == 1
-    _z_network_message_slist_t *_declaration_cache;
+    _z_declaration_cache_t _declaration_cache;
 #endif
 
     // Session subscriptions
 #if Z_FEATURE_SUBSCRIPTION == 1
-    _z_subscription_rc_slist_t *_subscriptions;
-    _z_subscription_rc_slist_t *_liveliness_subscriptions;
+    _z_subscription_rc_hmap_t _subscriptions;
+    _z_subscription_rc_hmap_t _liveliness_subscriptions;
+    // Immutable views of the above, replaced on each change so that samples are dispatched without locking
+    _z_epoch_cell_t _subscriptions_snapshot;
+    _z_epoch_cell_t _liveliness_subscriptions_snapshot;
+    // Key expressions of the snapshots, guarded by _mutex_subscriptions
+    _z_keyexpr_intern_table_t _subscription_keyexprs;
 #if Z_FEATURE_RX_CACHE == 1
+    // Matches of the last received key expressions, looked up before walking a snapshot
     _z_subscription_lru_cache_t _subscription_cache;
+    size_t _subscription_cache_generation;  // Advanced on each invalidation, a match is only cached if it was not
 #endif
 #endif
 
@@ -174,19 +212,20 @@ typedef struct _z_session_t {
 
     // Session queryables
 #if Z_FEATURE_QUERYABLE == 1
-    _z_session_queryable_rc_slist_t *_local_queryable;
+    _z_session_queryable_rc_hmap_t _local_queryable;
+    _z_keyexpr_intern_table_t _queryable_keyexprs;
 #if Z_FEATURE_RX_CACHE == 1
     _z_queryable_lru_cache_t _queryable_cache;
 #endif
 #endif
 #if Z_FEATURE_QUERY == 1
-    _z_pending_query_slist_t *_pending_queries;
+    _z_pending_query_hmap_t _pending_queries;
 #endif
 
     // Session interests
 #if Z_FEATURE_INTEREST == 1
-    _z_session_interest_rc_slist_t *_local_interests;
-    _z_declare_data_slist_t *_remote_declares;
+    _z_session_interest_rc_hmap_t _local_interests;
+    _z_declare_data_hmap_t _remote_declares;
     struct _z_write_filter_registration_t *_write_filters;
 #endif
 
@@ -239,6 +278,7 @@ _z_fut_fn_result_t _z_client_reopen_task_fn(void *ztc_arg, _z_executor_t *execut
  *     z_msg: Network message with declaration
  */
 void _z_cache_declaration(_z_session_t *zs, const _z_network_message_t *n_msg);
+void _z_cache_declarations(_z_session_t *zs, const _z_network_message_t *n_msgs, size_t len);
 
 /**
  * Remove corresponding declaration from the cache
@@ -248,6 +288,18 @@ void _z_cache_declaration(_z_session_t *zs, const _z_network_message_t *n_msg);
  *     z_msg: Network message with undeclaration
  */
 void _z_prune_declaration(_z_session_t *zs, const _z_network_message_t *n_msg);
+void _z_prune_declarations(_z_session_t *zs, const _z_network_message_t *n_msgs, size_t len);
+
+/**
+ * Send the cached declarations, key expressions first and interests last, batching them in as few frames as possible
+ *
+ * Parameters:
+ *     zs: A zenoh-net session.
+ *
+ * Returns:
+ *     ``0`` in case of success, or a ``negative value`` in case of failure.
+ */
+z_result_t _z_replay_declarations(_z_session_t *zs);
 
 /**
  * Return true is session and all associated transports were closed.
@@ -101,6 +101,19 @@ extern "C" {
 #define _Z_CURRENT_PATCH 0x01
 #define _Z_PATCH_HAS_FRAGMENT_MARKERS(patch) (patch >= 1)
 
+/*=============================*/
+/*        Batch header         */
+/*=============================*/
+/// Only present once compression has been negotiated in the INIT messages, right after the length on stream links.
+/// If C==1 then the rest of the batch is a LZ4 block, otherwise it is left as is.
+///
+///  7 6 5 4 3 2 1 0
+/// +-+-+-+-+-+-+-+-+
+/// |X|X|X|X|X|X|X|C|
+/// +-+-+-+-+-+-+-+-+
+#define _Z_BATCH_HEADER_SIZE 1
+#define _Z_BATCH_HEADER_COMPRESSION 0x01
+
 /*=============================*/
 /*     Transport Messages      */
 /*=============================*/
@@ -331,6 +344,9 @@ typedef struct {
 #if Z_FEATURE_FRAGMENTATION == 1
     uint8_t _patch;
 #endif
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    bool _compression;
+#endif
 } _z_t_msg_init_t;
 void _z_t_msg_init_clear(_z_t_msg_init_t *msg);
 
@@ -175,6 +175,9 @@ size_t _z_wbuf_space_left(const _z_wbuf_t *wbf);
 z_result_t _z_wbuf_write(_z_wbuf_t *wbf, uint8_t b);
 z_result_t _z_wbuf_write_bytes(_z_wbuf_t *wbf, const uint8_t *bs, size_t offset, size_t length);
 z_result_t _z_wbuf_wrap_bytes(_z_wbuf_t *wbf, const uint8_t *bs, size_t offset, size_t length);
+// Reserves length contiguous bytes at the write position and returns a pointer to them, or NULL if they don't fit.
+// The caller is expected to fill them before the buffer is sent.
+uint8_t *_z_wbuf_reserve(_z_wbuf_t *wbf, size_t length);
 void _z_wbuf_put(_z_wbuf_t *wbf, uint8_t b, size_t pos);
 
 size_t _z_wbuf_get_rpos(const _z_wbuf_t *wbf);
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_SESSION_DECLARATION_CACHE_H
+#define ZENOH_PICO_SESSION_DECLARATION_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/system/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if Z_FEATURE_AUTO_RECONNECT == 1
+
+// Number of cached messages handed at once to the replay callback
+#define _Z_DECLARATION_CACHE_REPLAY_CHUNK 64
+
+static inline size_t _z_declaration_cache_id_hash(const uint32_t *id) { return (size_t)*id; }
+
+// Cached declaration messages of one kind, keyed by entity id. Values are moved in bitwise, the map owns them.
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE uint32_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_network_message_t
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_n_msg_id_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN _z_declaration_cache_id_hash
+#define _ZP_HASHMAP_TEMPLATE_VAL_DESTROY_FN _z_n_msg_clear
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#include "zenoh-pico/collections/hashmap_template.h"
+
+// Declarations sent by the session, replayed when the session reconnects.
+typedef struct {
+    _z_n_msg_id_hmap_t _kexprs;
+    _z_n_msg_id_hmap_t _subscribers;
+    _z_n_msg_id_hmap_t _queryables;
+    _z_n_msg_id_hmap_t _tokens;
+    _z_n_msg_id_hmap_t _interests;
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_t _mutex;
+#endif
+} _z_declaration_cache_t;
+
+typedef z_result_t (*_z_declaration_cache_replay_fn)(const _z_network_message_t *n_msgs, size_t len, void *arg);
+
+z_result_t _z_declaration_cache_init(_z_declaration_cache_t *cache);
+// Removes every cached message, the cache remains usable
+void _z_declaration_cache_clear(_z_declaration_cache_t *cache);
+void _z_declaration_cache_drop(_z_declaration_cache_t *cache);
+size_t _z_declaration_cache_len(_z_declaration_cache_t *cache);
+
+/**
+ * Stores a copy of a declaration or interest message, replacing the one previously cached for the same entity.
+ */
+z_result_t _z_declaration_cache_insert(_z_declaration_cache_t *cache, const _z_network_message_t *n_msg);
+// Same as _z_declaration_cache_insert for len messages under a single lock, stopping at the first error
+z_result_t _z_declaration_cache_insert_many(_z_declaration_cache_t *cache, const _z_network_message_t *n_msgs,
+                                            size_t len);
+
+/**
+ * Removes the declaration matching an undeclaration or interest final message.
+ *
+ * Returns:
+ *     ``true`` if a cached message was removed.
+ */
+bool _z_declaration_cache_remove(_z_declaration_cache_t *cache, const _z_network_message_t *n_msg);
+// Same as _z_declaration_cache_remove for len messages under a single lock, returns the number of removed messages
+size_t _z_declaration_cache_remove_many(_z_declaration_cache_t *cache, const _z_network_message_t *n_msgs,
+                                        size_t len);
+
+/**
+ * Hands the cached messages to fn by chunks of up to _Z_DECLARATION_CACHE_REPLAY_CHUNK messages, stopping at the first
+ * error. Key expressions come first as other declarations may refer to them, interests come last. The cache is locked
+ * for the whole replay and the messages are only borrowed by fn.
+ */
+z_result_t _z_declaration_cache_replay(_z_declaration_cache_t *cache, _z_declaration_cache_replay_fn fn, void *arg);
+
+#endif  // Z_FEATURE_AUTO_RECONNECT == 1
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_SESSION_DECLARATION_CACHE_H */
@@ -25,9 +25,10 @@ extern "C" {
 #endif
 
 #if Z_FEATURE_INTEREST == 1
-_z_session_interest_rc_t *_z_get_interest_by_id(_z_session_t *zn, const _z_zint_t id);
-_z_session_interest_rc_t *_z_register_interest(_z_session_t *zn, _z_session_interest_t *intr);
-void _z_unregister_interest(_z_session_t *zn, _z_session_interest_rc_t *intr);
+_z_session_interest_rc_t _z_get_interest_by_id(_z_session_t *zn, const _z_zint_t id);
+// Takes ownership of intr, which is cleared on failure
+z_result_t _z_register_interest(_z_session_t *zn, _z_session_interest_t *intr);
+void _z_unregister_interest(_z_session_t *zn, uint32_t id);
 #endif  // Z_FEATURE_INTEREST == 1
 
 void _z_interest_init(_z_session_t *zn);
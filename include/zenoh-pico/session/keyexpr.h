@@ -15,11 +15,13 @@
 #define INCLUDE_ZENOH_PICO_SESSION_KEYEXPR_H
 
 #include <stdbool.h>
+#include <string.h>
 
 #include "zenoh-pico/api/constants.h"
 #include "zenoh-pico/collections/refcount.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/session/weak_session.h"
+#include "zenoh-pico/utils/string.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -108,12 +110,18 @@ static inline _z_keyexpr_t _z_keyexpr_steal(_Z_MOVE(_z_keyexpr_t) src) {
 
 size_t _z_keyexpr_non_wild_prefix_len(const _z_keyexpr_t *key);
 
+enum _zp_wildness_t { _ZP_WILDNESS_ANY = 1, _ZP_WILDNESS_SUPERCHUNKS = 2, _ZP_WILDNESS_SUBCHUNK_DSL = 4 };
+// Returns the _zp_wildness_t flags of ke, adding its number of '/' to n_segments and of '@' to n_verbatims
+int8_t _zp_ke_wildness(_z_str_se_t ke, size_t *n_segments, size_t *n_verbatims);
+
 static inline int _z_keyexpr_compare(const _z_keyexpr_t *first, const _z_keyexpr_t *second) {
     return _z_string_compare(&first->_keyexpr, &second->_keyexpr);
 }
 static inline bool _z_keyexpr_equals(const _z_keyexpr_t *first, const _z_keyexpr_t *second) {
     return _z_keyexpr_compare(first, second) == 0;
 }
+// FNV-1a hash of the key expression string, equal key expressions have equal hashes
+size_t _z_keyexpr_hash(const _z_keyexpr_t *key);
 static inline size_t _z_keyexpr_size(_z_keyexpr_t *p) {
     _ZP_UNUSED(p);
     return sizeof(_z_keyexpr_t);
@@ -192,7 +200,22 @@ static inline bool _z_declared_keyexpr_is_non_wild_prefix_optimized(const _z_dec
            _Z_RC_IN_VAL(&key->_declaration)->_prefix_len == _z_keyexpr_non_wild_prefix_len(&key->_inner);
 }
 
+// Key expressions extending the same declaration share its prefix, only their suffixes are compared
 static inline bool _z_declared_keyexpr_equals(const _z_declared_keyexpr_t *left, const _z_declared_keyexpr_t *right) {
+    if (!_Z_RC_IS_NULL(&left->_declaration) &&
+        (_Z_RC_IN_VAL(&left->_declaration) == _Z_RC_IN_VAL(&right->_declaration))) {
+        size_t len = _z_string_len(&left->_inner._keyexpr);
+        if (len != _z_string_len(&right->_inner._keyexpr)) {
+            return false;
+        }
+        size_t prefix_len = _Z_RC_IN_VAL(&left->_declaration)->_prefix_len;
+        if (len == prefix_len) {
+            return true;
+        }
+        const char *left_suffix = _z_string_data(&left->_inner._keyexpr) + prefix_len;
+        const char *right_suffix = _z_string_data(&right->_inner._keyexpr) + prefix_len;
+        return memcmp(left_suffix, right_suffix, len - prefix_len) == 0;
+    }
     return _z_keyexpr_equals(&left->_inner, &right->_inner);
 }
 z_result_t _z_declared_keyexpr_move(_z_declared_keyexpr_t *dst, _z_declared_keyexpr_t *src);
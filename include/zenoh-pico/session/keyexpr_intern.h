@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef INCLUDE_ZENOH_PICO_SESSION_KEYEXPR_INTERN_H
+#define INCLUDE_ZENOH_PICO_SESSION_KEYEXPR_INTERN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/collections/refcount.h"
+#include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A key expression along with the properties used to match it, computed once. Instances obtained from the same intern
+ * table for equal key expressions are shared, so that they compare by pointer.
+ */
+typedef struct {
+    _z_keyexpr_t _key;
+    size_t _hash;
+    size_t _n_chunks;
+    int8_t _wildness;  // _zp_wildness_t flags
+} _z_interned_keyexpr_t;
+
+static inline _z_interned_keyexpr_t _z_interned_keyexpr_null(void) {
+    _z_interned_keyexpr_t ike = {0};
+    return ike;
+}
+static inline void _z_interned_keyexpr_clear(_z_interned_keyexpr_t *ike) { _z_keyexpr_clear(&ike->_key); }
+// Computes the properties of key without copying it, the result is only valid as long as key is
+_z_interned_keyexpr_t _z_interned_keyexpr_alias(const _z_keyexpr_t *key);
+
+_Z_REFCOUNT_DEFINE(_z_interned_keyexpr, _z_interned_keyexpr)
+
+static inline bool _z_interned_keyexpr_is_verbatim(const _z_interned_keyexpr_t *ike) { return ike->_wildness == 0; }
+static inline bool _z_interned_keyexpr_equals(const _z_interned_keyexpr_t *left, const _z_interned_keyexpr_t *right) {
+    return (left == right) || ((left->_hash == right->_hash) && _z_keyexpr_equals(&left->_key, &right->_key));
+}
+// Same as _z_keyexpr_intersects, without running the wildcard matcher when the properties are enough to decide
+bool _z_interned_keyexpr_intersects(const _z_interned_keyexpr_t *left, const _z_interned_keyexpr_t *right);
+// Same as _z_keyexpr_includes, without running the wildcard matcher when the properties are enough to decide
+bool _z_interned_keyexpr_includes(const _z_interned_keyexpr_t *left, const _z_interned_keyexpr_t *right);
+
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE _z_keyexpr_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_interned_keyexpr_weak_t
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_interned_keyexpr_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN _z_keyexpr_hash
+#define _ZP_HASHMAP_TEMPLATE_KEY_EQ_FN _z_keyexpr_equals
+#define _ZP_HASHMAP_TEMPLATE_KEY_DESTROY_FN _z_keyexpr_clear
+#define _ZP_HASHMAP_TEMPLATE_VAL_DESTROY_FN _z_interned_keyexpr_weak_drop
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#define _ZP_HASHMAP_TEMPLATE_REALLOC_FN z_realloc
+#include "zenoh-pico/collections/hashmap_template.h"
+
+/**
+ * Maps key expressions to their interned instance. The table only holds weak references: an instance is freed once
+ * its last user drops it, and its entry is purged when the table grows. Not thread-safe, callers serialize the calls.
+ */
+typedef struct {
+    _z_interned_keyexpr_hmap_t _map;
+    size_t _purge_len;
+} _z_keyexpr_intern_table_t;
+
+void _z_keyexpr_intern_table_init(_z_keyexpr_intern_table_t *table);
+void _z_keyexpr_intern_table_clear(_z_keyexpr_intern_table_t *table);
+static inline size_t _z_keyexpr_intern_table_len(const _z_keyexpr_intern_table_t *table) {
+    return _z_interned_keyexpr_hmap_size(&table->_map);
+}
+// Returns the instance of key interned in table, creating it if none is alive
+z_result_t _z_keyexpr_intern(_z_keyexpr_intern_table_t *table, const _z_keyexpr_t *key,
+                             _z_interned_keyexpr_rc_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INCLUDE_ZENOH_PICO_SESSION_KEYEXPR_INTERN_H */
@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include "zenoh-pico/collections/cat.h"
+#include "zenoh-pico/session/keyexpr_scan.h"
 
 const char _Z_VERBATIM = '@';
 const char _Z_DELIMITER = '/';
@@ -49,9 +50,12 @@ typedef struct _z_chunk_backward_match_data_t {
     const char *rbegin;  // only valid if result is _Z_CHUNK_MATCH_RESULT_YES
 } _z_chunk_backward_match_data_t;
 
-static inline const char *_z_chunk_end(const char *begin, const char *end) {
-    const char *sep = (const char *)memchr(begin, _Z_DELIMITER, (size_t)(end - begin));
-    return sep ? sep : end;
+static inline const char *_z_chunk_end(const char *begin, const char *end) { return _z_ke_scan_delimiter(begin, end); }
+
+static inline size_t _z_min_len(const char *lbegin, const char *lend, const char *rbegin, const char *rend) {
+    size_t llen = (size_t)(lend - lbegin);
+    size_t rlen = (size_t)(rend - rbegin);
+    return (llen < rlen) ? llen : rlen;
 }
 
 static inline const char *_z_chunk_begin(const char *begin, const char *end) {
@@ -168,6 +172,10 @@ _z_chunk_forward_match_data_t _ZP_CAT(_z_chunk_forward_backward, _ZP_KE_MATCH_OP
     const char *lend = result.lend;
     const char *rend = result.rend;
 
+    // skip the common suffix without stardsl at once, the loop below resumes on the first differing byte or '*'
+    size_t common = _z_ke_scan_common_suffix(lend, rend, _z_min_len(lbegin, lend, rbegin, rend));
+    lend -= common;
+    rend -= common;
     while (lend > lbegin && rend > rbegin) {
         lend--;
         rend--;
@@ -233,6 +241,10 @@ _z_chunk_forward_match_data_t _ZP_CAT(_z_chunk_forward, _ZP_KE_MATCH_OP)(const c
         return result;
     }
     // at this stage we should only care about stardsl, as the presence of verbatim or wild is already checked.
+    // skip the common prefix without stardsl at once, the loop below resumes on the first differing byte, '$' or '/'
+    size_t common = _z_ke_scan_common_prefix(lbegin, rbegin, _z_min_len(lbegin, lkend, rbegin, rkend));
+    lbegin += common;
+    rbegin += common;
     while (lbegin < lkend && rbegin < rkend && *lbegin != _Z_DELIMITER && *rbegin != _Z_DELIMITER) {
         if (*lbegin == _Z_DSL0) {
             return _ZP_CAT(_z_chunk_forward_backward, _ZP_KE_MATCH_OP)(lbegin + _Z_DSL_LEN, lkend, rbegin, rkend);
@@ -281,6 +293,9 @@ _z_chunk_backward_match_data_t _ZP_CAT(_z_chunk_backward_forward,
     result.rbegin = rbegin;
 
     // chunks can not be star, nor doublestar
+    size_t common = _z_ke_scan_common_prefix(lbegin, rbegin, _z_min_len(lbegin, lend, rbegin, rend));
+    lbegin += common;
+    rbegin += common;
     while (lbegin < lend && rbegin < rend) {
         if (_ZP_KE_MATCH_TYPE_INTERSECTS && *rbegin == _Z_DSL0) {
             result.result = _Z_CHUNK_MATCH_RESULT_YES;
@@ -342,6 +357,10 @@ _z_chunk_backward_match_data_t _ZP_CAT(_z_chunk_backward, _ZP_KE_MATCH_OP)(const
         return result;
     }
 
+    // skip the common suffix without stardsl at once, the loop below resumes on the first differing byte, '*' or '/'
+    size_t common = _z_ke_scan_common_suffix(lend, rend, _z_min_len(lkbegin, lend, rkbegin, rend));
+    llast -= common;
+    rlast -= common;
     while (llast >= lkbegin && rlast >= rkbegin && *llast != _Z_DELIMITER && *rlast != _Z_DELIMITER) {
         if (*llast == _Z_DSL1) {
             return _ZP_CAT(_z_chunk_backward_forward, _ZP_KE_MATCH_OP)(lkbegin, llast + 1 - _Z_DSL_LEN, rkbegin,
@@ -417,7 +436,8 @@ bool _ZP_CAT(_z_keyexpr_special, _ZP_KE_MATCH_OP)(const char *lbegin, const char
                 rcbegin = rbegin;
             }
         }
-        lbegin = lcbegin;
+        // skip the doublestar separating the current left subke from the next one
+        lbegin = lcbegin < lend ? lcbegin + _Z_DOUBLE_STAR_LEN + _Z_DELIMITER_LEN : lcbegin;
         rbegin = rcbegin;
     }
     return true;
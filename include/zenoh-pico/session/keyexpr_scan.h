@@ -0,0 +1,256 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_SESSION_KEYEXPR_SCAN_H
+#define ZENOH_PICO_SESSION_KEYEXPR_SCAN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "zenoh-pico/config.h"
+
+// Byte scanning primitives of key expression canonization and matching.
+//
+// When Z_FEATURE_KEYEXPR_SIMD is enabled and the compiler targets AVX2, SSE2 or little-endian NEON, the input is
+// classified one vector (32 or 16 bytes) at a time into bitmasks, and the first interesting byte is found with a bit
+// scan. Inputs shorter than a vector, and targets without SIMD support, use the scalar versions. The instruction set is
+// selected at build time from the compiler flags (e.g. -mavx2), there is no runtime dispatch.
+//
+// Both versions are always compiled so that they can be tested against each other.
+
+#if Z_FEATURE_KEYEXPR_SIMD == 1 && (defined(__GNUC__) || defined(__clang__))
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define _Z_KE_SIMD_AVX2 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define _Z_KE_SIMD_SSE2 1
+#elif defined(__ARM_NEON) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#include <arm_neon.h>
+#define _Z_KE_SIMD_NEON 1
+#endif
+#endif
+
+#if defined(_Z_KE_SIMD_AVX2) || defined(_Z_KE_SIMD_SSE2) || defined(_Z_KE_SIMD_NEON)
+#define _Z_KE_SIMD 1
+#else
+#define _Z_KE_SIMD 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*------------------ Scalar versions ------------------*/
+// Returns a pointer to the first '/' in [begin, end), or end.
+static inline const char *_z_ke_scan_delimiter_scalar(const char *begin, const char *end) {
+    const char *sep = (const char *)memchr(begin, '/', (size_t)(end - begin));
+    return (sep != NULL) ? sep : end;
+}
+
+// Returns a pointer to the first '*', '$', '#' or '?' in [begin, end), or end.
+// The bytes before it need no canonization check.
+static inline const char *_z_ke_scan_special_scalar(const char *begin, const char *end) {
+    for (; begin < end; begin++) {
+        if ((*begin == '*') || (*begin == '$') || (*begin == '#') || (*begin == '?')) {
+            break;
+        }
+    }
+    return begin;
+}
+
+// Returns the length of the longest common prefix of l and r, at most n bytes long, that contains neither '/' nor '$'.
+static inline size_t _z_ke_scan_common_prefix_scalar(const char *l, const char *r, size_t n) {
+    size_t i = 0;
+    while ((i < n) && (l[i] == r[i]) && (l[i] != '/') && (l[i] != '$')) {
+        i++;
+    }
+    return i;
+}
+
+// Returns the length of the longest common suffix of the n bytes before lend and rend, that contains neither '/' nor
+// '*'.
+static inline size_t _z_ke_scan_common_suffix_scalar(const char *lend, const char *rend, size_t n) {
+    size_t i = 0;
+    while ((i < n) && (lend[-1 - (ptrdiff_t)i] == rend[-1 - (ptrdiff_t)i]) && (lend[-1 - (ptrdiff_t)i] != '/') &&
+           (lend[-1 - (ptrdiff_t)i] != '*')) {
+        i++;
+    }
+    return i;
+}
+
+#if _Z_KE_SIMD == 1
+/*------------------ Vector primitives ------------------*/
+// Masks hold (1 << _Z_KE_MASK_SHIFT) bits per byte, the lowest ones for the first byte.
+#if defined(_Z_KE_SIMD_AVX2)
+typedef __m256i _z_ke_vec_t;
+#define _Z_KE_VEC_WIDTH ((size_t)32)
+#define _Z_KE_MASK_SHIFT 0
+#define _Z_KE_MASK_ALL ((uint64_t)0xFFFFFFFF)
+static inline _z_ke_vec_t _z_ke_vec_load(const char *p) { return _mm256_loadu_si256((const __m256i *)(const void *)p); }
+static inline _z_ke_vec_t _z_ke_vec_splat(char c) { return _mm256_set1_epi8(c); }
+static inline _z_ke_vec_t _z_ke_vec_eq(_z_ke_vec_t a, _z_ke_vec_t b) { return _mm256_cmpeq_epi8(a, b); }
+static inline _z_ke_vec_t _z_ke_vec_or(_z_ke_vec_t a, _z_ke_vec_t b) { return _mm256_or_si256(a, b); }
+static inline _z_ke_vec_t _z_ke_vec_andnot(_z_ke_vec_t a, _z_ke_vec_t b) { return _mm256_andnot_si256(b, a); }
+static inline uint64_t _z_ke_vec_mask(_z_ke_vec_t v) { return (uint64_t)(uint32_t)_mm256_movemask_epi8(v); }
+#elif defined(_Z_KE_SIMD_SSE2)
+typedef __m128i _z_ke_vec_t;
+#define _Z_KE_VEC_WIDTH ((size_t)16)
+#define _Z_KE_MASK_SHIFT 0
+#define _Z_KE_MASK_ALL ((uint64_t)0xFFFF)
+static inline _z_ke_vec_t _z_ke_vec_load(const char *p) { return _mm_loadu_si128((const __m128i *)(const void *)p); }
+static inline _z_ke_vec_t _z_ke_vec_splat(char c) { return _mm_set1_epi8(c); }
+static inline _z_ke_vec_t _z_ke_vec_eq(_z_ke_vec_t a, _z_ke_vec_t b) { return _mm_cmpeq_epi8(a, b); }
+static inline _z_ke_vec_t _z_ke_vec_or(_z_ke_vec_t a, _z_ke_vec_t b) { return _mm_or_si128(a, b); }
+static inline _z_ke_vec_t _z_ke_vec_andnot(_z_ke_vec_t a, _z_ke_vec_t b) { return _mm_andnot_si128(b, a); }
+static inline uint64_t _z_ke_vec_mask(_z_ke_vec_t v) { return (uint64_t)(uint32_t)_mm_movemask_epi8(v); }
+#else  // _Z_KE_SIMD_NEON
+typedef uint8x16_t _z_ke_vec_t;
+#define _Z_KE_VEC_WIDTH ((size_t)16)
+#define _Z_KE_MASK_SHIFT 2
+#define _Z_KE_MASK_ALL (~(uint64_t)0)
+static inline _z_ke_vec_t _z_ke_vec_load(const char *p) { return vld1q_u8((const uint8_t *)(const void *)p); }
+static inline _z_ke_vec_t _z_ke_vec_splat(char c) { return vdupq_n_u8((uint8_t)c); }
+static inline _z_ke_vec_t _z_ke_vec_eq(_z_ke_vec_t a, _z_ke_vec_t b) { return vceqq_u8(a, b); }
+static inline _z_ke_vec_t _z_ke_vec_or(_z_ke_vec_t a, _z_ke_vec_t b) { return vorrq_u8(a, b); }
+static inline _z_ke_vec_t _z_ke_vec_andnot(_z_ke_vec_t a, _z_ke_vec_t b) { return vbicq_u8(a, b); }
+// NEON has no movemask, narrowing each 16 bits lane by 4 packs one nibble per byte into 64 bits
+static inline uint64_t _z_ke_vec_mask(_z_ke_vec_t v) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0);
+}
+#endif
+
+// Index of the first, respectively last, byte flagged in a non-zero mask
+static inline size_t _z_ke_mask_first(uint64_t m) { return (size_t)__builtin_ctzll(m) >> _Z_KE_MASK_SHIFT; }
+static inline size_t _z_ke_mask_last(uint64_t m) { return (size_t)(63 - __builtin_clzll(m)) >> _Z_KE_MASK_SHIFT; }
+
+/*------------------ SIMD versions ------------------*/
+static inline const char *_z_ke_scan_delimiter_simd(const char *begin, const char *end) {
+    const _z_ke_vec_t delim = _z_ke_vec_splat('/');
+    while ((size_t)(end - begin) >= _Z_KE_VEC_WIDTH) {
+        uint64_t m = _z_ke_vec_mask(_z_ke_vec_eq(_z_ke_vec_load(begin), delim));
+        if (m != 0) {
+            return begin + _z_ke_mask_first(m);
+        }
+        begin += _Z_KE_VEC_WIDTH;
+    }
+    return _z_ke_scan_delimiter_scalar(begin, end);
+}
+
+static inline const char *_z_ke_scan_special_simd(const char *begin, const char *end) {
+    const _z_ke_vec_t star = _z_ke_vec_splat('*');
+    const _z_ke_vec_t dollar = _z_ke_vec_splat('$');
+    const _z_ke_vec_t sharp = _z_ke_vec_splat('#');
+    const _z_ke_vec_t qmark = _z_ke_vec_splat('?');
+    while ((size_t)(end - begin) >= _Z_KE_VEC_WIDTH) {
+        _z_ke_vec_t v = _z_ke_vec_load(begin);
+        _z_ke_vec_t wild = _z_ke_vec_or(_z_ke_vec_eq(v, star), _z_ke_vec_eq(v, dollar));
+        _z_ke_vec_t invalid = _z_ke_vec_or(_z_ke_vec_eq(v, sharp), _z_ke_vec_eq(v, qmark));
+        uint64_t m = _z_ke_vec_mask(_z_ke_vec_or(wild, invalid));
+        if (m != 0) {
+            return begin + _z_ke_mask_first(m);
+        }
+        begin += _Z_KE_VEC_WIDTH;
+    }
+    return _z_ke_scan_special_scalar(begin, end);
+}
+
+static inline size_t _z_ke_scan_common_prefix_simd(const char *l, const char *r, size_t n) {
+    const _z_ke_vec_t delim = _z_ke_vec_splat('/');
+    const _z_ke_vec_t dollar = _z_ke_vec_splat('$');
+    size_t i = 0;
+    while (n - i >= _Z_KE_VEC_WIDTH) {
+        _z_ke_vec_t lv = _z_ke_vec_load(l + i);
+        _z_ke_vec_t stop = _z_ke_vec_or(_z_ke_vec_eq(lv, delim), _z_ke_vec_eq(lv, dollar));
+        uint64_t m = _z_ke_vec_mask(_z_ke_vec_andnot(_z_ke_vec_eq(lv, _z_ke_vec_load(r + i)), stop));
+        if (m != _Z_KE_MASK_ALL) {
+            return i + _z_ke_mask_first(~m & _Z_KE_MASK_ALL);
+        }
+        i += _Z_KE_VEC_WIDTH;
+    }
+    return i + _z_ke_scan_common_prefix_scalar(l + i, r + i, n - i);
+}
+
+static inline size_t _z_ke_scan_common_suffix_simd(const char *lend, const char *rend, size_t n) {
+    const _z_ke_vec_t delim = _z_ke_vec_splat('/');
+    const _z_ke_vec_t star = _z_ke_vec_splat('*');
+    size_t i = 0;
+    while (n - i >= _Z_KE_VEC_WIDTH) {
+        const char *lp = lend - (ptrdiff_t)(i + _Z_KE_VEC_WIDTH);
+        const char *rp = rend - (ptrdiff_t)(i + _Z_KE_VEC_WIDTH);
+        _z_ke_vec_t lv = _z_ke_vec_load(lp);
+        _z_ke_vec_t stop = _z_ke_vec_or(_z_ke_vec_eq(lv, delim), _z_ke_vec_eq(lv, star));
+        uint64_t m = _z_ke_vec_mask(_z_ke_vec_andnot(_z_ke_vec_eq(lv, _z_ke_vec_load(rp)), stop));
+        if (m != _Z_KE_MASK_ALL) {
+            return i + (_Z_KE_VEC_WIDTH - 1 - _z_ke_mask_last(~m & _Z_KE_MASK_ALL));
+        }
+        i += _Z_KE_VEC_WIDTH;
+    }
+    return i + _z_ke_scan_common_suffix_scalar(lend - (ptrdiff_t)i, rend - (ptrdiff_t)i, n - i);
+}
+#endif  // _Z_KE_SIMD == 1
+
+/*------------------ Dispatch ------------------*/
+#if defined(Z_TEST_HOOKS)
+// Allows tests to run the scalar versions on SIMD capable builds.
+void _z_ke_scan_set_simd_enabled(bool enabled);
+bool _z_ke_scan_simd_is_enabled(void);
+#define _Z_KE_SCAN_USE_SIMD() _z_ke_scan_simd_is_enabled()
+#else
+#define _Z_KE_SCAN_USE_SIMD() true
+#endif
+
+static inline const char *_z_ke_scan_delimiter(const char *begin, const char *end) {
+#if _Z_KE_SIMD == 1
+    if (_Z_KE_SCAN_USE_SIMD()) {
+        return _z_ke_scan_delimiter_simd(begin, end);
+    }
+#endif
+    return _z_ke_scan_delimiter_scalar(begin, end);
+}
+
+static inline const char *_z_ke_scan_special(const char *begin, const char *end) {
+#if _Z_KE_SIMD == 1
+    if (_Z_KE_SCAN_USE_SIMD()) {
+        return _z_ke_scan_special_simd(begin, end);
+    }
+#endif
+    return _z_ke_scan_special_scalar(begin, end);
+}
+
+static inline size_t _z_ke_scan_common_prefix(const char *l, const char *r, size_t n) {
+#if _Z_KE_SIMD == 1
+    if (_Z_KE_SCAN_USE_SIMD()) {
+        return _z_ke_scan_common_prefix_simd(l, r, n);
+    }
+#endif
+    return _z_ke_scan_common_prefix_scalar(l, r, n);
+}
+
+static inline size_t _z_ke_scan_common_suffix(const char *lend, const char *rend, size_t n) {
+#if _Z_KE_SIMD == 1
+    if (_Z_KE_SCAN_USE_SIMD()) {
+        return _z_ke_scan_common_suffix_simd(lend, rend, n);
+    }
+#endif
+    return _z_ke_scan_common_suffix_scalar(lend, rend, n);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_SESSION_KEYEXPR_SCAN_H */
@@ -26,16 +26,34 @@ typedef struct _z_session_rc_t _z_session_rc_t;
 
 // Queryable infos
 _Z_SVEC_DEFINE(_z_session_queryable_rc, _z_session_queryable_rc_t)
+
+// Copies the queryables of map into out, so that they can be walked once the session mutex is released
+static inline z_result_t _z_session_queryable_rc_hmap_snapshot(const _z_session_queryable_rc_hmap_t *map,
+                                                               _z_session_queryable_rc_svec_t *out) {
+    *out = _z_session_queryable_rc_svec_make(_z_session_queryable_rc_hmap_size(map));
+    for (_z_session_queryable_rc_hmap_iter_t it = _z_session_queryable_rc_hmap_begin(map);
+         it != _z_session_queryable_rc_hmap_end(map); it = _z_session_queryable_rc_hmap_iter_next(map, it)) {
+        _z_session_queryable_rc_t qle =
+            _z_session_queryable_rc_clone(&_z_session_queryable_rc_hmap_const_at(map, it)->val);
+        _Z_CLEAN_RETURN_IF_ERR(_z_session_queryable_rc_svec_append(out, &qle, false),
+                               _z_session_queryable_rc_drop(&qle);
+                               _z_session_queryable_rc_svec_clear(out));
+    }
+    return _Z_RES_OK;
+}
 _Z_REFCOUNT_DEFINE(_z_session_queryable_rc_svec, _z_session_queryable_rc_svec)
 
 typedef struct {
     _z_keyexpr_t ke;
     _z_session_queryable_rc_svec_rc_t infos;
     bool is_remote;
+    size_t hash;  // Of ke and is_remote, computed once per lookup
 } _z_queryable_cache_data_t;
 
-void _z_unsafe_queryable_cache_invalidate(_z_session_t *zn);
+// Drops the cached matches of the key expressions intersecting key, or all of them if key is NULL
+void _z_unsafe_queryable_cache_invalidate(_z_session_t *zn, const _z_keyexpr_t *key);
 int _z_queryable_cache_data_compare(const void *first, const void *second);
+size_t _z_queryable_cache_data_hash(const void *val);
 void _z_queryable_cache_data_clear(_z_queryable_cache_data_t *val);
 
 #if Z_FEATURE_QUERYABLE == 1
@@ -45,15 +63,23 @@ void _z_queryable_cache_data_clear(_z_queryable_cache_data_t *val);
 #if Z_FEATURE_RX_CACHE == 1
 _Z_ELEM_DEFINE(_z_queryable, _z_queryable_cache_data_t, _z_noop_size, _z_queryable_cache_data_clear, _z_noop_copy,
                _z_noop_move, _z_noop_eq, _z_noop_cmp, _z_noop_hash)
-_Z_LRU_CACHE_DEFINE(_z_queryable, _z_queryable_cache_data_t, _z_queryable_cache_data_compare)
+_Z_LRU_CACHE_DEFINE(_z_queryable, _z_queryable_cache_data_t, _z_queryable_cache_data_compare,
+                    _z_queryable_cache_data_hash)
 #endif
 
 /*------------------ Queryable ------------------*/
 _z_session_queryable_rc_t _z_get_session_queryable_by_id(_z_session_t *zn, const _z_zint_t id);
 _z_session_queryable_rc_t _z_register_session_queryable(_z_session_t *zn, _z_session_queryable_t *q);
+// Clones the queryables with the given ids into out, a null refcount marks an unknown id
+void _z_get_session_queryables_by_id(_z_session_t *zn, const uint32_t *ids, size_t len, _z_session_queryable_rc_t *out);
+// Registers len queryables under a single acquisition of the session mutex, either all of them or none. The queryables
+// are consumed in both cases, on success out holds a reference to each of them.
+z_result_t _z_register_session_queryables(_z_session_t *zn, _z_session_queryable_t *qles, size_t len,
+                                          _z_session_queryable_rc_t *out);
 z_result_t _z_trigger_queryables(_z_transport_common_t *transport, _z_msg_query_t *query, _z_wireexpr_t *q_key,
                                  uint32_t qid, _z_n_qos_t qos, _z_transport_peer_common_t *peer);
 void _z_unregister_session_queryable(_z_session_t *zn, _z_session_queryable_rc_t *q);
+void _z_unregister_session_queryables(_z_session_t *zn, _z_session_queryable_rc_t *qles, size_t len);
 void _z_flush_session_queryable(_z_session_t *zn);
 #endif
 
@@ -23,10 +23,12 @@
 #include "zenoh-pico/collections/list.h"
 #include "zenoh-pico/collections/refcount.h"
 #include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/collections/vec.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/session/cancellation.h"
 #include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/keyexpr_intern.h"
 #include "zenoh-pico/transport/manager.h"
 
 #ifdef __cplusplus
@@ -44,6 +46,10 @@ static inline void _z_drop_handler_execute(_z_drop_handler_t dropper, void *arg)
     }
 }
 
+// Entity ids are allocated sequentially by the session, so they are spread evenly over the buckets as they are.
+static inline size_t _z_session_id_hash(const uint32_t *id) { return (size_t)*id; }
+static inline size_t _z_session_zint_id_hash(const _z_zint_t *id) { return (size_t)*id; }
+
 typedef enum {
     _Z_SUBSCRIBER_KIND_SUBSCRIBER = 0,
     _Z_SUBSCRIBER_KIND_LIVELINESS_SUBSCRIBER = 1,
@@ -51,6 +57,7 @@ typedef enum {
 
 typedef struct {
     _z_keyexpr_t _key;
+    size_t _hash;  // Hash of _key, compared before it by the lookups
     uint16_t _id;
     uint16_t _refcount;
 } _z_resource_t;
@@ -107,6 +114,17 @@ _Z_ELEM_DEFINE(_z_subscription_rc, _z_subscription_rc_t, _z_subscription_rc_size
                _z_subscription_rc_copy, _z_noop_move, _z_noop_eq, _z_noop_cmp, _z_noop_hash)
 _Z_SLIST_DEFINE(_z_subscription_rc, _z_subscription_rc_t, true)
 
+// Session subscriptions, keyed by entity id
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE uint32_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_subscription_rc_t
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_subscription_rc_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN _z_session_id_hash
+#define _ZP_HASHMAP_TEMPLATE_VAL_DESTROY_FN _z_subscription_rc_drop
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#define _ZP_HASHMAP_TEMPLATE_REALLOC_FN z_realloc
+#include "zenoh-pico/collections/hashmap_template.h"
+
 typedef struct {
     _z_keyexpr_t _key;
     uint32_t _id;
@@ -122,6 +140,7 @@ typedef void (*_z_closure_query_callback_t)(_z_query_rc_t *query, void *arg);
 
 typedef struct {
     _z_declared_keyexpr_t _key;
+    _z_interned_keyexpr_rc_t _interned_key;  // Set on registration, may stay null if interning fails
     uint32_t _id;
     _z_closure_query_callback_t _callback;
     _z_drop_handler_t _dropper;
@@ -148,6 +167,17 @@ _Z_ELEM_DEFINE(_z_session_queryable_rc, _z_session_queryable_rc_t, _z_session_qu
                _z_noop_hash)
 _Z_SLIST_DEFINE(_z_session_queryable_rc, _z_session_queryable_rc_t, true)
 
+// Session queryables, keyed by entity id
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE uint32_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_session_queryable_rc_t
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_session_queryable_rc_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN _z_session_id_hash
+#define _ZP_HASHMAP_TEMPLATE_VAL_DESTROY_FN _z_session_queryable_rc_drop
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#define _ZP_HASHMAP_TEMPLATE_REALLOC_FN z_realloc
+#include "zenoh-pico/collections/hashmap_template.h"
+
 // Forward declaration to avoid cyclical includes
 typedef struct _z_reply_t _z_reply_t;
 typedef _z_slist_t _z_pending_reply_slist_t;
@@ -204,12 +234,19 @@ struct _z_pending_query_t {
 #endif
 };
 
-bool _z_pending_query_eq(const _z_pending_query_t *one, const _z_pending_query_t *two);
 void _z_pending_query_clear(_z_pending_query_t *res);
 
-_Z_ELEM_DEFINE(_z_pending_query, _z_pending_query_t, _z_noop_size, _z_pending_query_clear, _z_noop_copy, _z_noop_move,
-               _z_pending_query_eq, _z_noop_cmp, _z_noop_hash)
-_Z_SLIST_DEFINE(_z_pending_query, _z_pending_query_t, false)
+// Pending queries, keyed by query id. Values are stored in place: pointers to them are only valid under the
+// session lock.
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE _z_zint_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_pending_query_t
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_pending_query_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN _z_session_zint_id_hash
+#define _ZP_HASHMAP_TEMPLATE_VAL_DESTROY_FN _z_pending_query_clear
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#define _ZP_HASHMAP_TEMPLATE_REALLOC_FN z_realloc
+#include "zenoh-pico/collections/hashmap_template.h"
 
 struct __z_hello_handler_wrapper_t;  // Forward declaration to be used in _z_closure_hello_callback_t
 /**
@@ -264,6 +301,33 @@ _Z_ELEM_DEFINE(_z_session_interest_rc, _z_session_interest_rc_t, _z_session_inte
                _z_session_interest_rc_drop, _z_session_interest_rc_copy, _z_noop_move, _z_noop_eq, _z_noop_cmp,
                _z_noop_hash)
 _Z_SLIST_DEFINE(_z_session_interest_rc, _z_session_interest_rc_t, true)
+_Z_SVEC_DEFINE(_z_session_interest_rc, _z_session_interest_rc_t)
+
+// Session interests, keyed by interest id
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE uint32_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_session_interest_rc_t
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_session_interest_rc_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN _z_session_id_hash
+#define _ZP_HASHMAP_TEMPLATE_VAL_DESTROY_FN _z_session_interest_rc_drop
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#define _ZP_HASHMAP_TEMPLATE_REALLOC_FN z_realloc
+#include "zenoh-pico/collections/hashmap_template.h"
+
+// Copies the interests of map into out, so that they can be walked once the session mutex is released
+static inline z_result_t _z_session_interest_rc_hmap_snapshot(const _z_session_interest_rc_hmap_t *map,
+                                                              _z_session_interest_rc_svec_t *out) {
+    *out = _z_session_interest_rc_svec_make(_z_session_interest_rc_hmap_size(map));
+    for (_z_session_interest_rc_hmap_iter_t it = _z_session_interest_rc_hmap_begin(map);
+         it != _z_session_interest_rc_hmap_end(map); it = _z_session_interest_rc_hmap_iter_next(map, it)) {
+        _z_session_interest_rc_t intr =
+            _z_session_interest_rc_clone(&_z_session_interest_rc_hmap_const_at(map, it)->val);
+        _Z_CLEAN_RETURN_IF_ERR(_z_session_interest_rc_svec_append(out, &intr, false),
+                               _z_session_interest_rc_drop(&intr);
+                               _z_session_interest_rc_svec_clear(out));
+    }
+    return _Z_RES_OK;
+}
 
 typedef enum {
     _Z_DECLARE_TYPE_SUBSCRIBER = 0,
@@ -285,6 +349,35 @@ void _z_declare_data_copy(_z_declare_data_t *dst, const _z_declare_data_t *src);
 _Z_ELEM_DEFINE(_z_declare_data, _z_declare_data_t, _z_declare_data_size, _z_declare_data_clear, _z_declare_data_copy,
                _z_noop_move, _z_noop_eq, _z_noop_cmp, _z_noop_hash)
 _Z_SLIST_DEFINE(_z_declare_data, _z_declare_data_t, true)
+_Z_SVEC_DEFINE(_z_declare_data, _z_declare_data_t)
+
+// Remote declarations are keyed by their type and entity id, see _z_declare_data_key
+static inline uint64_t _z_declare_data_key(uint8_t type, uint32_t id) { return ((uint64_t)type << 32) | id; }
+static inline size_t _z_declare_data_key_hash(const uint64_t *key) { return (size_t)(*key ^ (*key >> 32)); }
+
+// Declarations received from remote nodes
+#define _ZP_HASHMAP_TEMPLATE_KEY_TYPE uint64_t
+#define _ZP_HASHMAP_TEMPLATE_VAL_TYPE _z_declare_data_t
+#define _ZP_HASHMAP_TEMPLATE_NAME _z_declare_data_hmap
+#define _ZP_HASHMAP_TEMPLATE_KEY_HASH_FN _z_declare_data_key_hash
+#define _ZP_HASHMAP_TEMPLATE_VAL_DESTROY_FN _z_declare_data_clear
+#define _ZP_HASHMAP_TEMPLATE_ALLOC_FN z_malloc
+#define _ZP_HASHMAP_TEMPLATE_FREE_FN z_free
+#define _ZP_HASHMAP_TEMPLATE_REALLOC_FN z_realloc
+#include "zenoh-pico/collections/hashmap_template.h"
+
+// Copies the declarations of map into out, so that they can be walked once the session mutex is released
+static inline z_result_t _z_declare_data_hmap_snapshot(const _z_declare_data_hmap_t *map, _z_declare_data_svec_t *out) {
+    *out = _z_declare_data_svec_make(_z_declare_data_hmap_size(map));
+    for (_z_declare_data_hmap_iter_t it = _z_declare_data_hmap_begin(map);
+         it != _z_declare_data_hmap_end(map); it = _z_declare_data_hmap_iter_next(map, it)) {
+        _z_declare_data_t decl;
+        _z_declare_data_copy(&decl, &_z_declare_data_hmap_const_at(map, it)->val);
+        _Z_CLEAN_RETURN_IF_ERR(_z_declare_data_svec_append(out, &decl, false), _z_declare_data_clear(&decl);
+                               _z_declare_data_svec_clear(out));
+    }
+    return _Z_RES_OK;
+}
 
 #ifdef __cplusplus
 }
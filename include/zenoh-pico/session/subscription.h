@@ -18,6 +18,7 @@
 #include "zenoh-pico/collections/lru_cache.h"
 #include "zenoh-pico/net/encoding.h"
 #include "zenoh-pico/protocol/core.h"
+#include "zenoh-pico/session/keyexpr_intern.h"
 #include "zenoh-pico/session/session.h"
 
 #ifdef __cplusplus
@@ -28,23 +29,20 @@ extern "C" {
 typedef struct _z_session_t _z_session_t;
 
 _Z_SVEC_DEFINE(_z_subscription_rc, _z_subscription_rc_t)
-_Z_REFCOUNT_DEFINE(_z_subscription_rc_svec, _z_subscription_rc_svec)
 
-typedef struct {
-    _z_keyexpr_t ke;
-    _z_subscription_rc_svec_rc_t infos;
-    bool is_remote;
-} _z_subscription_cache_data_t;
-
-static inline _z_subscription_cache_data_t _z_subscription_cache_data_null(void) {
-    _z_subscription_cache_data_t ret = {0};
-    return ret;
+// Copies the subscriptions of map into out, so that they can be walked once the session mutex is released
+static inline z_result_t _z_subscription_rc_hmap_snapshot(const _z_subscription_rc_hmap_t *map,
+                                                          _z_subscription_rc_svec_t *out) {
+    *out = _z_subscription_rc_svec_make(_z_subscription_rc_hmap_size(map));
+    for (_z_subscription_rc_hmap_iter_t it = _z_subscription_rc_hmap_begin(map);
+         it != _z_subscription_rc_hmap_end(map); it = _z_subscription_rc_hmap_iter_next(map, it)) {
+        _z_subscription_rc_t sub = _z_subscription_rc_clone(&_z_subscription_rc_hmap_const_at(map, it)->val);
+        _Z_CLEAN_RETURN_IF_ERR(_z_subscription_rc_svec_append(out, &sub, false), _z_subscription_rc_drop(&sub);
+                               _z_subscription_rc_svec_clear(out));
+    }
+    return _Z_RES_OK;
 }
 
-void _z_unsafe_subscription_cache_invalidate(_z_session_t *zn);
-int _z_subscription_cache_data_compare(const void *first, const void *second);
-void _z_subscription_cache_data_clear(_z_subscription_cache_data_t *val);
-
 /*------------------ Subscription ------------------*/
 z_result_t _z_trigger_liveliness_subscriptions_declare(_z_session_t *zn, const _z_wireexpr_t *wireexpr,
                                                        const _z_timestamp_t *timestamp,
@@ -55,20 +53,72 @@ z_result_t _z_trigger_liveliness_subscriptions_undeclare(_z_session_t *zn, const
 
 #if Z_FEATURE_SUBSCRIPTION == 1
 
+/**
+ * Matching data of a subscription, shared by the dispatch snapshots. The subscription is strongly referenced, so that
+ * samples are dispatched without any reference count operation. It is released once no snapshot holding the entry can
+ * be read anymore, an undeclaration thus waits for the dispatches in progress and can't be done from a callback of a
+ * subscription of the same kind.
+ */
+typedef struct {
+    _z_subscription_rc_t _sub;
+    _z_interned_keyexpr_rc_t _key;
+    z_locality_t _allowed_origin;
+    uint32_t _id;
+} _z_subscription_entry_t;
+
+void _z_subscription_entry_clear(_z_subscription_entry_t *entry);
+
+_Z_REFCOUNT_DEFINE(_z_subscription_entry, _z_subscription_entry)
+_Z_ELEM_DEFINE(_z_subscription_entry_rc, _z_subscription_entry_rc_t, _z_subscription_entry_rc_size,
+               _z_subscription_entry_rc_drop, _z_subscription_entry_rc_copy, _z_noop_move, _z_noop_eq, _z_noop_cmp,
+               _z_noop_hash)
+_Z_SVEC_DEFINE(_z_subscription_entry_rc, _z_subscription_entry_rc_t)
+_Z_REFCOUNT_DEFINE(_z_subscription_entry_rc_svec, _z_subscription_entry_rc_svec)
+
+typedef struct {
+    _z_keyexpr_t ke;
+    _z_subscription_entry_rc_svec_rc_t infos;  // Entries matching ke and the origin
+    _z_subscriber_kind_t kind;
+    bool is_remote;
+    size_t hash;  // Of ke, kind and is_remote, computed once per lookup
+} _z_subscription_cache_data_t;
+
+static inline _z_subscription_cache_data_t _z_subscription_cache_data_null(void) {
+    _z_subscription_cache_data_t ret = {0};
+    return ret;
+}
+
 #if Z_FEATURE_RX_CACHE == 1
+int _z_subscription_cache_data_compare(const void *first, const void *second);
+size_t _z_subscription_cache_data_hash(const void *val);
+void _z_subscription_cache_data_clear(_z_subscription_cache_data_t *val);
+
 _Z_ELEM_DEFINE(_z_subscription, _z_subscription_cache_data_t, _z_noop_size, _z_subscription_cache_data_clear,
                _z_noop_copy, _z_noop_move, _z_noop_eq, _z_noop_cmp, _z_noop_hash)
-_Z_LRU_CACHE_DEFINE(_z_subscription, _z_subscription_cache_data_t, _z_subscription_cache_data_compare)
+_Z_LRU_CACHE_DEFINE(_z_subscription, _z_subscription_cache_data_t, _z_subscription_cache_data_compare,
+                    _z_subscription_cache_data_hash)
 #endif
 
+// Dispatch snapshots of the subscriptions, see _z_session_t
+z_result_t _z_subscription_snapshots_init(_z_session_t *zn);
+void _z_subscription_snapshots_clear(_z_session_t *zn);
+
 _z_subscription_rc_t _z_get_subscription_by_id(_z_session_t *zn, _z_subscriber_kind_t kind, const _z_zint_t id);
 _z_subscription_rc_t _z_register_subscription(_z_session_t *zn, _z_subscriber_kind_t kind, _z_subscription_t *sub);
+// Clones the subscriptions with the given ids into out, a null refcount marks an unknown id
+void _z_get_subscriptions_by_id(_z_session_t *zn, _z_subscriber_kind_t kind, const uint32_t *ids, size_t len,
+                                _z_subscription_rc_t *out);
+// Registers len subscriptions under a single acquisition of the session mutex, either all of them or none. The
+// subscriptions are consumed in both cases, on success out holds a reference to each of them.
+z_result_t _z_register_subscriptions(_z_session_t *zn, _z_subscriber_kind_t kind, _z_subscription_t *subs, size_t len,
+                                     _z_subscription_rc_t *out);
 z_result_t _z_trigger_subscriptions_impl(_z_session_t *zn, _z_subscriber_kind_t sub_kind, _z_wireexpr_t *wireexpr,
                                          _z_bytes_t *payload, _z_encoding_t *encoding, const _z_zint_t sample_kind,
                                          const _z_timestamp_t *timestamp, const _z_n_qos_t qos, _z_bytes_t *attachment,
                                          z_reliability_t reliability, _z_source_info_t *source_info,
                                          _z_transport_peer_common_t *peer);
 void _z_unregister_subscription(_z_session_t *zn, _z_subscriber_kind_t kind, _z_subscription_rc_t *sub);
+void _z_unregister_subscriptions(_z_session_t *zn, _z_subscriber_kind_t kind, _z_subscription_rc_t *subs, size_t len);
 void _z_flush_subscriptions(_z_session_t *zn);
 
 static inline z_result_t _z_trigger_subscriptions_put(_z_session_t *zn, _z_wireexpr_t *wireexpr, _z_bytes_t *payload,
@@ -28,8 +28,10 @@ extern "C" {
 #endif
 
 /*------------------ Session ------------------*/
-_z_hello_slist_t *_z_scout_inner(const z_what_t what, _z_id_t id, _z_string_t *locator, const uint32_t timeout,
-                                 const bool exit_on_first);
+// zbf is the buffer the hellos are received on, allocated on first use and left to the caller to clear so that
+// successive scouting rounds can reuse it
+_z_hello_slist_t *_z_scout_inner(const z_what_t what, _z_id_t id, const _z_string_svec_t *locators,
+                                 const uint32_t timeout, const bool exit_on_first, _z_zbuf_t *zbf);
 
 z_result_t _z_session_init(_z_session_t *zn, const _z_id_t *zid);
 void _z_session_clear(_z_session_t *zn);
@@ -49,16 +51,61 @@ static inline z_result_t _z_session_mutex_lock_if_open(_z_session_t *zn) {
     return _Z_RES_OK;
 }
 static inline void _z_session_mutex_unlock(_z_session_t *zn) { (void)_z_mutex_unlock(&zn->_mutex_inner); }
+#if _Z_SESSION_ATOMIC_LAST_TIMESTAMP == 0
 static inline z_result_t _z_session_last_timestamp_mutex_lock(_z_session_t *zn) {
     return _z_mutex_lock(&zn->_mutex_last_timestamp);
 }
 static inline void _z_session_last_timestamp_mutex_unlock(_z_session_t *zn) {
     (void)_z_mutex_unlock(&zn->_mutex_last_timestamp);
 }
+#endif
 static inline void _z_session_transport_mutex_lock(_z_session_t *zn) { (void)_z_mutex_rec_lock(&zn->_mutex_transport); }
 static inline void _z_session_transport_mutex_unlock(_z_session_t *zn) {
     (void)_z_mutex_rec_unlock(&zn->_mutex_transport);
 }
+static inline z_result_t _z_session_registry_mutex_lock_if_open(_z_session_t *zn, _z_mutex_t *mutex) {
+    _Z_RETURN_IF_ERR(_z_mutex_lock(mutex));
+    if (_z_session_is_closed(zn)) {
+        _z_mutex_unlock(mutex);
+        return _Z_ERR_SESSION_CLOSED;
+    }
+    return _Z_RES_OK;
+}
+#if Z_FEATURE_SUBSCRIPTION == 1
+static inline void _z_session_subscriptions_mutex_lock(_z_session_t *zn) {
+    (void)_z_mutex_lock(&zn->_mutex_subscriptions);
+}
+static inline z_result_t _z_session_subscriptions_mutex_lock_if_open(_z_session_t *zn) {
+    return _z_session_registry_mutex_lock_if_open(zn, &zn->_mutex_subscriptions);
+}
+static inline void _z_session_subscriptions_mutex_unlock(_z_session_t *zn) {
+    (void)_z_mutex_unlock(&zn->_mutex_subscriptions);
+}
+#if Z_FEATURE_RX_CACHE == 1
+static inline void _z_session_subscription_cache_mutex_lock(_z_session_t *zn) {
+    (void)_z_mutex_lock(&zn->_mutex_subscription_cache);
+}
+static inline void _z_session_subscription_cache_mutex_unlock(_z_session_t *zn) {
+    (void)_z_mutex_unlock(&zn->_mutex_subscription_cache);
+}
+#endif
+#endif
+#if Z_FEATURE_QUERYABLE == 1
+static inline void _z_session_queryables_mutex_lock(_z_session_t *zn) { (void)_z_mutex_lock(&zn->_mutex_queryables); }
+static inline z_result_t _z_session_queryables_mutex_lock_if_open(_z_session_t *zn) {
+    return _z_session_registry_mutex_lock_if_open(zn, &zn->_mutex_queryables);
+}
+static inline void _z_session_queryables_mutex_unlock(_z_session_t *zn) {
+    (void)_z_mutex_unlock(&zn->_mutex_queryables);
+}
+#endif
+#if Z_FEATURE_QUERY == 1
+static inline void _z_session_queries_mutex_lock(_z_session_t *zn) { (void)_z_mutex_lock(&zn->_mutex_queries); }
+static inline z_result_t _z_session_queries_mutex_lock_if_open(_z_session_t *zn) {
+    return _z_session_registry_mutex_lock_if_open(zn, &zn->_mutex_queries);
+}
+static inline void _z_session_queries_mutex_unlock(_z_session_t *zn) { (void)_z_mutex_unlock(&zn->_mutex_queries); }
+#endif
 #if Z_FEATURE_ADMIN_SPACE == 1
 static inline void _z_session_admin_space_mutex_lock(_z_session_t *zn) { (void)_z_mutex_lock(&zn->_mutex_admin_space); }
 static inline void _z_session_admin_space_mutex_unlock(_z_session_t *zn) {
@@ -84,6 +131,23 @@ static inline z_result_t _z_session_last_timestamp_mutex_lock(_z_session_t *zn)
 static inline void _z_session_last_timestamp_mutex_unlock(_z_session_t *zn) { _ZP_UNUSED(zn); }
 static inline void _z_session_transport_mutex_lock(_z_session_t *zn) { _ZP_UNUSED(zn); }
 static inline void _z_session_transport_mutex_unlock(_z_session_t *zn) { _ZP_UNUSED(zn); }
+static inline void _z_session_subscriptions_mutex_lock(_z_session_t *zn) { _ZP_UNUSED(zn); }
+static inline z_result_t _z_session_subscriptions_mutex_lock_if_open(_z_session_t *zn) {
+    return _z_session_is_closed(zn) ? _Z_ERR_SESSION_CLOSED : _Z_RES_OK;
+}
+static inline void _z_session_subscriptions_mutex_unlock(_z_session_t *zn) { _ZP_UNUSED(zn); }
+static inline void _z_session_subscription_cache_mutex_lock(_z_session_t *zn) { _ZP_UNUSED(zn); }
+static inline void _z_session_subscription_cache_mutex_unlock(_z_session_t *zn) { _ZP_UNUSED(zn); }
+static inline void _z_session_queryables_mutex_lock(_z_session_t *zn) { _ZP_UNUSED(zn); }
+static inline z_result_t _z_session_queryables_mutex_lock_if_open(_z_session_t *zn) {
+    return _z_session_is_closed(zn) ? _Z_ERR_SESSION_CLOSED : _Z_RES_OK;
+}
+static inline void _z_session_queryables_mutex_unlock(_z_session_t *zn) { _ZP_UNUSED(zn); }
+static inline void _z_session_queries_mutex_lock(_z_session_t *zn) { _ZP_UNUSED(zn); }
+static inline z_result_t _z_session_queries_mutex_lock_if_open(_z_session_t *zn) {
+    return _z_session_is_closed(zn) ? _Z_ERR_SESSION_CLOSED : _Z_RES_OK;
+}
+static inline void _z_session_queries_mutex_unlock(_z_session_t *zn) { _ZP_UNUSED(zn); }
 static inline void _z_session_admin_space_mutex_lock(_z_session_t *zn) { _ZP_UNUSED(zn); }
 static inline void _z_session_admin_space_mutex_unlock(_z_session_t *zn) { _ZP_UNUSED(zn); }
 #endif
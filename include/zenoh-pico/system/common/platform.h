@@ -550,6 +550,17 @@ typedef struct {
 
 z_result_t _z_get_time_since_epoch(_z_time_since_epoch *t);
 
+/*------------------ Mapped files ------------------*/
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+// Platforms supporting persistence define _z_mapped_file_t in their platform header.
+// Maps the file at path in memory for reading and writing, creating it or resizing it to size bytes if needed.
+// Bytes added to the file read as 0 and writes to the mapping are shared with the file.
+z_result_t _z_mapped_file_open(_z_mapped_file_t *file, const char *path, size_t size);
+// Schedules the write back of the mapping to the storage without waiting for it.
+z_result_t _z_mapped_file_flush(_z_mapped_file_t *file);
+void _z_mapped_file_close(_z_mapped_file_t *file);
+#endif
+
 /*------------------ P2p unicast internal functions ------------------*/
 
 z_result_t _z_socket_set_blocking(const _z_sys_net_socket_t *sock, bool blocking);
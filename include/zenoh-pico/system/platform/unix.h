@@ -44,13 +44,17 @@ typedef struct timeval z_time_t;
 typedef struct {
     union {
 #if Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_UDP_MULTICAST == 1 || Z_FEATURE_LINK_UDP_UNICAST == 1 || \
-    Z_FEATURE_RAWETH_TRANSPORT == 1 || Z_FEATURE_LINK_SERIAL == 1
+    Z_FEATURE_RAWETH_TRANSPORT == 1 || Z_FEATURE_LINK_SERIAL == 1 || Z_FEATURE_LINK_UNIXSOCK_STREAM == 1 ||  \
+    Z_FEATURE_LINK_SHM_RING == 1
         int _fd;
 #endif
     };
 #if Z_FEATURE_LINK_TLS == 1
     void *_tls_sock;  // Pointer to _z_tls_socket_t
 #endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+    void *_shm_ring;  // Local view of the shared-memory rings of a connected socket
+#endif
 } _z_sys_net_socket_t;
 
 typedef struct {
@@ -61,6 +65,14 @@ typedef struct {
     };
 } _z_sys_net_endpoint_t;
 
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+typedef struct {
+    uint8_t *_addr;
+    size_t _size;
+    int _fd;
+} _z_mapped_file_t;
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,7 +38,18 @@ z_result_t _z_send_t_msg(_z_transport_t *zt, const _z_transport_message_t *t_msg
 z_result_t _z_link_send_t_msg(const _z_link_t *zl, const _z_transport_message_t *t_msg, _z_sys_net_socket_t *socket);
 z_result_t _z_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg, z_reliability_t reliability,
                          z_congestion_control_t cong_ctrl, void *peer);
+// Sends the messages under a single acquisition of the tx mutex, encoded back to back and flushed once at the end.
+// Sending stops at the first message that fails, the ones encoded before it are flushed and the error is returned.
+z_result_t _z_send_n_msgs(_z_session_t *zn, const _z_network_message_t *n_msgs, size_t len,
+                          z_reliability_t reliability, z_congestion_control_t cong_ctrl);
 z_result_t _z_send_n_batch(_z_session_t *zn, z_congestion_control_t cong_ctrl);
+// Encodes the push message n_msg, whose payload must be empty, and reserves payload_len bytes for its payload in the tx
+// buffer. On success with loan->_buf set, the tx mutex is held until the loan is committed or aborted. A NULL
+// loan->_buf means that the transport can't lend its buffer and the message has to be sent with _z_send_n_msg.
+z_result_t _z_send_n_msg_loan(_z_session_t *zn, _z_transport_tx_loan_t *loan, const _z_network_message_t *n_msg,
+                              size_t payload_len, z_reliability_t reliability, z_congestion_control_t cong_ctrl);
+z_result_t _z_send_n_msg_loan_commit(_z_transport_tx_loan_t *loan);
+void _z_send_n_msg_loan_abort(_z_transport_tx_loan_t *loan);
 
 #ifdef __cplusplus
 }
@@ -28,6 +28,7 @@
 #include "zenoh-pico/protocol/definitions/transport.h"
 #include "zenoh-pico/runtime/runtime.h"
 #include "zenoh-pico/session/weak_session.h"
+#include "zenoh-pico/utils/lz4.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -175,6 +176,18 @@ typedef struct {
     _z_zint_t _sn_tx_best_effort;
     volatile _z_zint_t _lease;
     volatile bool _transmitted;
+#if Z_FEATURE_IO_URING == 1
+    // Sends each batch to all the unicast peers at once, NULL when the link or the kernel does not support it
+    _z_socket_uring_t *_uring;
+#endif
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    // Negotiated in the handshake, every batch then starts with a header byte after the stream length
+    bool _compression;
+    uint8_t *_compression_buf;
+    _z_lz4_ctx_t *_compression_ctx;
+    // Decompressed batches, allocated on the first compressed batch received
+    _z_zbuf_t _zbuf_decompressed;
+#endif
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_t _mutex_tx;
     _z_mutex_rec_t _mutex_peer;
@@ -262,6 +275,23 @@ typedef struct {
     _z_transport_type_t _type;
 } _z_transport_t;
 
+// Room reserved in the tx buffer for the payload of a network message, held with the tx mutex until committed
+typedef struct {
+    _z_transport_common_t *_ztc;
+    _z_transport_peer_unicast_slist_t *_peers;
+#if Z_FEATURE_FRAGMENTATION == 1
+    _z_wbuf_t _frag_buff;
+#endif
+    uint8_t *_buf;
+    size_t _prev_wpos;
+    _z_zint_t _prev_sn;
+    _z_zint_t _first_sn;
+    z_reliability_t _reliability;
+    bool _is_express;
+    bool _is_fragmented;
+    bool _is_peer_locked;
+} _z_transport_tx_loan_t;
+
 typedef struct {
     _z_id_t _remote_zid;
     uint16_t _batch_size;
@@ -276,6 +306,9 @@ typedef struct {
 #if Z_FEATURE_FRAGMENTATION == 1
     uint8_t _patch;
 #endif
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    bool _compression;
+#endif
 } _z_transport_unicast_establish_param_t;
 
 typedef struct {
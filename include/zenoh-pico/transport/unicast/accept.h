@@ -22,9 +22,12 @@
 extern "C" {
 #endif
 
-#if Z_FEATURE_UNICAST_TRANSPORT == 1 && Z_FEATURE_UNICAST_PEER == 1 && \
-    (Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_TLS == 1)
-_z_fut_fn_result_t _zp_unicast_accept_task_fn(void *ztu_arg, _z_executor_t *executor);
+#if Z_FEATURE_UNICAST_TRANSPORT == 1 && Z_FEATURE_UNICAST_PEER == 1 &&                               \
+    (Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_TLS == 1 || Z_FEATURE_LINK_UNIXSOCK_STREAM == 1 || \
+     Z_FEATURE_LINK_SHM_RING == 1)
+// Creates the task accepting the connections of a listening unicast transport, it owns the pending connections
+z_result_t _zp_unicast_accept_fut_new(_z_transport_unicast_t *ztu, _z_fut_t *fut);
+_z_fut_fn_result_t _zp_unicast_accept_task_fn(void *task_arg, _z_executor_t *executor);
 #endif
 
 #ifdef __cplusplus
@@ -25,6 +25,10 @@ z_result_t _z_unicast_recv_t_msg(_z_transport_unicast_t *ztu, _z_transport_messa
 z_result_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_transport_message_t *t_msg,
                                                _z_transport_peer_unicast_t *peer);
 z_result_t _z_unicast_update_rx_buffer(_z_transport_unicast_t *ztu);
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+// Skips the batch header of a batch received on a transport with compression, and decompresses it if needed
+z_result_t _z_unicast_decompress_batch(_z_transport_unicast_t *ztu, _z_zbuf_t *zbf);
+#endif
 
 #ifdef __cplusplus
 }
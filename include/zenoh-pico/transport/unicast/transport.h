@@ -23,8 +23,12 @@ extern "C" {
 
 z_result_t _z_unicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
                                        _z_transport_unicast_establish_param_t *param);
-z_result_t _z_unicast_handshake_listen(_z_transport_unicast_establish_param_t *param, const _z_link_t *zl,
-                                       const _z_id_t *local_zid, z_whatami_t mode, _z_sys_net_socket_t *socket);
+// Listening side of the handshake, one step per received message so that it can be driven without blocking
+z_result_t _z_unicast_handshake_listen_init(_z_transport_unicast_establish_param_t *param, const _z_link_t *zl,
+                                            const _z_id_t *local_zid, z_whatami_t mode, _z_sys_net_socket_t *socket,
+                                            const _z_transport_message_t *tmsg);
+z_result_t _z_unicast_handshake_listen_open(_z_transport_unicast_establish_param_t *param, const _z_link_t *zl,
+                                            _z_sys_net_socket_t *socket, const _z_transport_message_t *tmsg);
 z_result_t _z_unicast_open_client(_z_transport_unicast_establish_param_t *param, const _z_link_t *zl,
                                   const _z_id_t *local_zid);
 z_result_t _z_unicast_open_peer(_z_transport_unicast_establish_param_t *param, const _z_link_t *zl,
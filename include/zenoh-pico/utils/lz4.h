@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_UTILS_LZ4_H
+#define ZENOH_PICO_UTILS_LZ4_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+
+#define _Z_LZ4_HASH_LOG 12
+// Match positions are kept on 16 bits, which covers any batch
+#define _Z_LZ4_MAX_INPUT_SIZE 65535
+
+// Match finder state, kept by the caller to stay off the stack of small targets
+typedef struct {
+    uint16_t _table[1 << _Z_LZ4_HASH_LOG];
+} _z_lz4_ctx_t;
+
+/**
+ * Compresses ``src`` as a single LZ4 block, the raw block format without frame or size prefix.
+ *
+ * Returns the compressed size, or 0 if the result does not fit in ``dst_cap`` bytes or the input is larger than
+ * ``_Z_LZ4_MAX_INPUT_SIZE``.
+ */
+size_t _z_lz4_compress(_z_lz4_ctx_t *ctx, const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap);
+
+/**
+ * Decompresses a single LZ4 block. Every offset and length is checked against both buffers, so malformed input is
+ * safely rejected.
+ *
+ * Returns the decompressed size, or SIZE_MAX if the block is malformed or does not fit in ``dst_cap`` bytes.
+ */
+size_t _z_lz4_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_UTILS_LZ4_H */
@@ -332,6 +332,12 @@ static z_result_t _ze_admin_space_encode_link(_z_json_encoder_t *je, const _z_li
         case _Z_LINK_TYPE_RAWETH:
             _Z_RETURN_IF_ERR(_z_json_encoder_write_string(je, "raweth"));
             break;
+        case _Z_LINK_TYPE_UNIXSOCK_STREAM:
+            _Z_RETURN_IF_ERR(_z_json_encoder_write_string(je, "unixsock-stream"));
+            break;
+        case _Z_LINK_TYPE_SHM_RING:
+            _Z_RETURN_IF_ERR(_z_json_encoder_write_string(je, "shm-ring"));
+            break;
         default:
             return _Z_ERR_INVALID;
     }
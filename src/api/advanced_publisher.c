@@ -104,6 +104,10 @@ void ze_advanced_publisher_cache_options_default(ze_advanced_publisher_cache_opt
     options->congestion_control = z_internal_congestion_control_default_push();
     options->priority = z_priority_default();
     options->is_express = false;
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+    options->persistence_path = NULL;
+    options->persistence_size = ZE_ADVANCED_PUBLISHER_CACHE_PERSISTENCE_SIZE_DEFAULT;
+#endif
     options->_liveliness = false;
 }
 
@@ -97,7 +97,7 @@ static z_result_t _ze_advanced_subscriber_sequenced_state_init(_ze_advanced_subs
     state->_last_delivered = 0;
     state->_pending_queries = 0;
     state->_periodic_query_handle = _z_fut_handle_null();
-    _z_uint32__z_sample_sortedmap_init(&state->_pending_samples);
+    _ze_sn_sample_omap_init(&state->_pending_samples);
 
     z_id_t zid = z_entity_global_id_zid(id);
     z_owned_string_t zid_str;
@@ -144,7 +144,7 @@ void _ze_advanced_subscriber_sequenced_state_clear(_ze_advanced_subscriber_seque
     }
     _z_session_weak_drop(&state->_zn);
     state->_zn = _z_session_weak_null();
-    _z_uint32__z_sample_sortedmap_clear(&state->_pending_samples);
+    _ze_sn_sample_omap_destroy(&state->_pending_samples);
     z_keyexpr_drop(z_keyexpr_move(&state->_query_keyexpr));
 }
 
@@ -152,14 +152,14 @@ static void _ze_advanced_subscriber_timestamped_state_init(_ze_advanced_subscrib
     state->_has_last_delivered = false;
     state->_last_delivered = _z_timestamp_null();
     state->_pending_queries = 0;
-    _z_timestamp__z_sample_sortedmap_init(&state->_pending_samples);
+    _ze_timestamp_sample_omap_init(&state->_pending_samples);
 }
 
 void _ze_advanced_subscriber_timestamped_state_clear(_ze_advanced_subscriber_timestamped_state_t *state) {
     state->_has_last_delivered = false;
     _z_timestamp_clear(&state->_last_delivered);
     state->_pending_queries = 0;
-    _z_timestamp__z_sample_sortedmap_clear(&state->_pending_samples);
+    _ze_timestamp_sample_omap_destroy(&state->_pending_samples);
 }
 
 _ze_advanced_subscriber_state_t _ze_advanced_subscriber_state_null(void) {
@@ -431,15 +431,15 @@ static inline void __unsafe_ze_advanced_subscriber_deliver_and_flush(_z_sample_t
     state->_has_last_delivered = true;
 
     uint32_t next_sn = _z_seqnumber_next(source_sn);
-    _z_sample_t *next_sample = _z_uint32__z_sample_sortedmap_get(&state->_pending_samples, &next_sn);
+    _z_sample_t *next_sample = _ze_sn_sample_omap_get(&state->_pending_samples, &next_sn);
     while (next_sample != NULL) {
         if (callback != NULL) {
             callback(next_sample, ctx);
         }
-        _z_uint32__z_sample_sortedmap_remove(&state->_pending_samples, &next_sn);
+        _ze_sn_sample_omap_remove(&state->_pending_samples, &next_sn, NULL);
         state->_last_delivered = next_sn;
         next_sn = _z_seqnumber_next(next_sn);
-        next_sample = _z_uint32__z_sample_sortedmap_get(&state->_pending_samples, &next_sn);
+        next_sample = _ze_sn_sample_omap_get(&state->_pending_samples, &next_sn);
     }
 }
 
@@ -448,14 +448,16 @@ static inline void __unsafe_ze_advanced_subscriber_deliver_and_flush(_z_sample_t
 static inline void __unsafe_ze_advanced_subscriber_flush_sequenced_source(
     _ze_advanced_subscriber_sequenced_state_t *state, _z_closure_sample_callback_t callback, void *ctx,
     const _z_entity_global_id_t *source_id, _ze_closure_miss_intmap_t *miss_handlers) {
-    if (state->_pending_queries != 0 || _z_uint32__z_sample_sortedmap_is_empty(&state->_pending_samples)) {
+    if (state->_pending_queries != 0 || _ze_sn_sample_omap_is_empty(&state->_pending_samples)) {
         return;  // Pending queries or no samples to deliver
     }
 
-    _z_uint32__z_sample_sortedmap_iterator_t it = _z_uint32__z_sample_sortedmap_iterator_make(&state->_pending_samples);
-    while (_z_uint32__z_sample_sortedmap_iterator_next(&it)) {
-        const uint32_t *source_sn = _z_uint32__z_sample_sortedmap_iterator_key(&it);
-        _z_sample_t *sample = _z_uint32__z_sample_sortedmap_iterator_value(&it);
+    for (_ze_sn_sample_omap_iter_t it = _ze_sn_sample_omap_begin(&state->_pending_samples);
+         it != _ze_sn_sample_omap_end(&state->_pending_samples);
+         it = _ze_sn_sample_omap_iter_next(&state->_pending_samples, it)) {
+        _ze_sn_sample_omap_elem_t *elem = _ze_sn_sample_omap_at(&state->_pending_samples, it);
+        const uint32_t *source_sn = &elem->key;
+        _z_sample_t *sample = &elem->val;
 
         if (!state->_has_last_delivered) {
             state->_last_delivered = *source_sn;
@@ -478,19 +480,19 @@ static inline void __unsafe_ze_advanced_subscriber_flush_sequenced_source(
             }  // else older or duplicate sample
         }
     }
-    _z_uint32__z_sample_sortedmap_clear(&state->_pending_samples);
+    _ze_sn_sample_omap_destroy(&state->_pending_samples);
 }
 
 // SAFETY: Must be called with _ze_advanced_subscriber_state_t mutex locked
 static inline void __unsafe_ze_advanced_subscriber_flush_timestamped_source(
     _ze_advanced_subscriber_timestamped_state_t *state, _z_closure_sample_callback_t callback, void *ctx) {
-    if (state->_pending_queries == 0 && !_z_timestamp__z_sample_sortedmap_is_empty(&state->_pending_samples)) {
-        _z_timestamp__z_sample_sortedmap_iterator_t it =
-            _z_timestamp__z_sample_sortedmap_iterator_make(&state->_pending_samples);
-
-        while (_z_timestamp__z_sample_sortedmap_iterator_next(&it)) {
-            _z_timestamp_t *timestamp = _z_timestamp__z_sample_sortedmap_iterator_key(&it);
-            _z_sample_t *sample = _z_timestamp__z_sample_sortedmap_iterator_value(&it);
+    if (state->_pending_queries == 0 && !_ze_timestamp_sample_omap_is_empty(&state->_pending_samples)) {
+        for (_ze_timestamp_sample_omap_iter_t it = _ze_timestamp_sample_omap_begin(&state->_pending_samples);
+             it != _ze_timestamp_sample_omap_end(&state->_pending_samples);
+             it = _ze_timestamp_sample_omap_iter_next(&state->_pending_samples, it)) {
+            _ze_timestamp_sample_omap_elem_t *elem = _ze_timestamp_sample_omap_at(&state->_pending_samples, it);
+            _z_timestamp_t *timestamp = &elem->key;
+            _z_sample_t *sample = &elem->val;
 
             if (!state->_has_last_delivered || _z_timestamp_cmp(timestamp, &state->_last_delivered) > 0) {
                 _z_timestamp_copy(&state->_last_delivered, timestamp);
@@ -500,8 +502,23 @@ static inline void __unsafe_ze_advanced_subscriber_flush_timestamped_source(
                 }
             }
         }
-        _z_timestamp__z_sample_sortedmap_clear(&state->_pending_samples);
+        _ze_timestamp_sample_omap_destroy(&state->_pending_samples);
+    }
+}
+
+// SAFETY: Must be called with _ze_advanced_subscriber_state_t mutex locked
+// Stores a copy of sample until it can be delivered in order
+static z_result_t __unsafe_ze_advanced_subscriber_buffer_sequenced_sample(
+    _ze_advanced_subscriber_sequenced_state_t *state, uint32_t source_sn, const _z_sample_t *sample) {
+    _z_sample_t new_sample;
+    _Z_RETURN_IF_ERR(_z_sample_copy(&new_sample, sample));
+    if (_ze_sn_sample_omap_insert(&state->_pending_samples, &source_sn, &new_sample) ==
+        _ze_sn_sample_omap_end(&state->_pending_samples)) {
+        _Z_ERROR("Failed to insert sample into sequenced state");
+        _z_sample_clear(&new_sample);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
+    return _Z_RES_OK;
 }
 
 // SAFETY: Must be called with _ze_advanced_subscriber_state_t mutex locked
@@ -561,41 +578,17 @@ static z_result_t __unsafe_ze_advanced_subscriber_handle_sample(_ze_advanced_sub
                     states->_callback(sample, states->_ctx);
                 }
             } else {
-                uint32_t *new_source_sn = z_malloc(sizeof(uint32_t));
-                if (new_source_sn == NULL) {
-                    _Z_ERROR("Failed to allocate memory for new source_sn");
-                    _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-                }
-                *new_source_sn = source_sn;
-
-                _z_sample_t *new_sample = z_malloc(sizeof(_z_sample_t));
-                if (new_sample == NULL) {
-                    _Z_ERROR("Failed to allocate memory for new sample");
-                    z_free(new_source_sn);
-                    _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-                }
-                _Z_CLEAN_RETURN_IF_ERR(_z_sample_copy(new_sample, sample), z_free(new_source_sn); z_free(new_sample));
-
-                _z_sample_t *entry =
-                    _z_uint32__z_sample_sortedmap_insert(&state->_pending_samples, new_source_sn, new_sample);
-                if (entry == NULL) {
-                    _Z_ERROR("Failed to insert sample into sequenced state");
-                    z_free(new_source_sn);
-                    z_free(new_sample);
-                    _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-                }
+                _Z_RETURN_IF_ERR(__unsafe_ze_advanced_subscriber_buffer_sequenced_sample(state, source_sn, sample));
 
                 // _history_depth = 0 = wait for all global queries to complete
                 if (states->_history_depth > 0 &&
-                    _z_uint32__z_sample_sortedmap_len(&state->_pending_samples) >= states->_history_depth) {
-                    _z_uint32__z_sample_sortedmap_entry_t *first_entry =
-                        _z_uint32__z_sample_sortedmap_pop_first(&state->_pending_samples);
-                    if (first_entry != NULL) {
-                        uint32_t *first_source_sn = _z_uint32__z_sample_sortedmap_entry_key(first_entry);
-                        _z_sample_t *first_sample = _z_uint32__z_sample_sortedmap_entry_val(first_entry);
-                        __unsafe_ze_advanced_subscriber_deliver_and_flush(first_sample, *first_source_sn,
+                    _ze_sn_sample_omap_size(&state->_pending_samples) >= states->_history_depth) {
+                    uint32_t first_source_sn;
+                    _z_sample_t first_sample;
+                    if (_ze_sn_sample_omap_pop_first(&state->_pending_samples, &first_source_sn, &first_sample)) {
+                        __unsafe_ze_advanced_subscriber_deliver_and_flush(&first_sample, first_source_sn,
                                                                           states->_callback, states->_ctx, state);
-                        _z_uint32__z_sample_sortedmap_entry_free(&first_entry);
+                        _z_sample_clear(&first_sample);
                     }
                 }
             }
@@ -606,30 +599,7 @@ static z_result_t __unsafe_ze_advanced_subscriber_handle_sample(_ze_advanced_sub
                                                                   state);
             } else if (_z_seqnumber_diff(source_sn, next_sn) > 0) {
                 if (states->_retransmission) {
-                    uint32_t *new_source_sn = z_malloc(sizeof(uint32_t));
-                    if (new_source_sn == NULL) {
-                        _Z_ERROR("Failed to allocate memory for new source_sn");
-                        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-                    }
-                    *new_source_sn = source_sn;
-
-                    _z_sample_t *new_sample = z_malloc(sizeof(_z_sample_t));
-                    if (new_sample == NULL) {
-                        _Z_ERROR("Failed to allocate memory for new sample");
-                        z_free(new_source_sn);
-                        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-                    }
-                    _Z_CLEAN_RETURN_IF_ERR(_z_sample_copy(new_sample, sample), z_free(new_source_sn);
-                                           z_free(new_sample));
-
-                    _z_sample_t *entry =
-                        _z_uint32__z_sample_sortedmap_insert(&state->_pending_samples, new_source_sn, new_sample);
-                    if (entry == NULL) {
-                        _Z_ERROR("Failed to insert sample into sequenced state");
-                        z_free(new_source_sn);
-                        z_free(new_sample);
-                        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-                    }
+                    _Z_RETURN_IF_ERR(__unsafe_ze_advanced_subscriber_buffer_sequenced_sample(state, source_sn, sample));
                 } else {
                     uint32_t nb = (uint32_t)_z_seqnumber_diff(source_sn, next_sn);
                     if (nb > 0) {
@@ -682,36 +652,21 @@ static z_result_t __unsafe_ze_advanced_subscriber_handle_sample(_ze_advanced_sub
                     states->_callback(sample, states->_ctx);
                 }
             } else {
-                _z_sample_t *entry = _z_timestamp__z_sample_sortedmap_get(&state->_pending_samples, timestamp);
-                if (entry == NULL) {
-                    z_timestamp_t *new_timestamp = z_malloc(sizeof(z_timestamp_t));
-                    if (new_timestamp == NULL) {
-                        _Z_ERROR("Failed to allocate memory for new timestamp");
-                        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-                    }
-                    _z_timestamp_copy(new_timestamp, timestamp);
-
-                    _z_sample_t *new_sample = z_malloc(sizeof(_z_sample_t));
-                    if (new_sample == NULL) {
-                        _Z_ERROR("Failed to allocate memory for new sample");
-                        z_free(new_timestamp);
-                        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-                    }
-                    _Z_CLEAN_RETURN_IF_ERR(_z_sample_copy(new_sample, sample), z_free(new_timestamp);
-                                           z_free(new_sample));
-
-                    entry =
-                        _z_timestamp__z_sample_sortedmap_insert(&state->_pending_samples, new_timestamp, new_sample);
-                    if (entry == NULL) {
+                if (!_ze_timestamp_sample_omap_contains(&state->_pending_samples, timestamp)) {
+                    _z_timestamp_t new_timestamp;
+                    _z_timestamp_copy(&new_timestamp, timestamp);
+                    _z_sample_t new_sample;
+                    _Z_RETURN_IF_ERR(_z_sample_copy(&new_sample, sample));
+                    if (_ze_timestamp_sample_omap_insert(&state->_pending_samples, &new_timestamp, &new_sample) ==
+                        _ze_timestamp_sample_omap_end(&state->_pending_samples)) {
                         _Z_ERROR("Failed to insert sample into timestamped state");
-                        z_free(new_timestamp);
-                        z_free(new_sample);
+                        _z_sample_clear(&new_sample);
                         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
                     }
                 }
                 // _history_depth = 0 = query all history
                 if (states->_history_depth > 0 &&
-                    _z_timestamp__z_sample_sortedmap_len(&state->_pending_samples) >= states->_history_depth) {
+                    _ze_timestamp_sample_omap_size(&state->_pending_samples) >= states->_history_depth) {
                     __unsafe_ze_advanced_subscriber_flush_timestamped_source(state, states->_callback, states->_ctx);
                 }
             }
@@ -1164,7 +1119,7 @@ void _ze_advanced_subscriber_subscriber_callback(z_loaned_sample_t *sample, void
         __unsafe_ze_advanced_subscriber_spawn_periodic_query(state, rc_states, &source_id);
     }
     if (state != NULL && states->_retransmission && state->_pending_queries == 0 &&
-        !_z_uint32__z_sample_sortedmap_is_empty(&state->_pending_samples)) {
+        !_ze_sn_sample_omap_is_empty(&state->_pending_samples)) {
         char params[ZE_ADVANCED_SUBSCRIBER_QUERY_PARAM_BUF_SIZE];
         _z_query_param_range_t range = {
             ._has_start = state->_has_last_delivered,
@@ -38,6 +38,7 @@
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/definitions/interest.h"
 #include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/loopback.h"
 #include "zenoh-pico/session/queryable.h"
 #include "zenoh-pico/session/resource.h"
 #include "zenoh-pico/session/subscription.h"
@@ -431,6 +432,22 @@ z_result_t z_timestamp_new(z_timestamp_t *ts, const z_loaned_session_t *zs) {
 
     _z_session_t *s = _Z_RC_IN_VAL(zs);
     _z_ntp64_t time = _z_timestamp_ntp64_from_time(t.secs, t.nanos);
+#if _Z_SESSION_ATOMIC_LAST_TIMESTAMP == 1
+    // Retried until no other thread generated a timestamp in between
+    size_t last = _z_atomic_size_load(&s->_last_timestamp, _z_memory_order_relaxed);
+    _z_ntp64_t next;
+    do {
+        if (time > last) {
+            next = time;
+        } else if (last == UINT64_MAX) {
+            _Z_ERROR_RETURN(_Z_ERR_TIMESTAMP_GENERATION_FAILED);
+        } else {
+            next = last + 1;
+        }
+    } while (!_z_atomic_size_compare_exchange_weak(&s->_last_timestamp, &last, (size_t)next, _z_memory_order_relaxed,
+                                                   _z_memory_order_relaxed));
+    time = next;
+#else
     _Z_RETURN_IF_ERR(_z_session_last_timestamp_mutex_lock(s));
     if (time > s->_last_timestamp) {
         s->_last_timestamp = time;
@@ -443,6 +460,7 @@ z_result_t z_timestamp_new(z_timestamp_t *ts, const z_loaned_session_t *zs) {
         s->_last_timestamp = time;
     }
     _z_session_last_timestamp_mutex_unlock(s);
+#endif
 
     ts->valid = true;
     ts->time = time;
@@ -833,12 +851,17 @@ z_result_t z_scout(z_moved_config_t *config, z_moved_closure_hello_t *callback,
         what = strtol(opt_as_str, NULL, 10);
     }
 
-    char *opt_as_str = _z_config_get(&config->_this._val, Z_CONFIG_MULTICAST_LOCATOR_KEY);
-    if (opt_as_str == NULL) {
-        opt_as_str = (char *)Z_CONFIG_MULTICAST_LOCATOR_DEFAULT;
+    _z_string_svec_t mcast_locators = _z_string_svec_make(1);
+    z_result_t ret = _z_config_get_scouting_locators(&config->_this._val, &mcast_locators);
+    if (ret != _Z_RES_OK) {
+        _z_string_svec_clear(&mcast_locators);
+        z_free(wrapped_ctx);
+        z_config_drop(config);
+        z_internal_closure_hello_null(&callback->_this);
+        _Z_ERROR_RETURN(ret);
     }
-    _z_string_t mcast_locator = _z_string_alias_str(opt_as_str);
 
+    char *opt_as_str = NULL;
     uint32_t timeout;
     if (options != NULL) {
         timeout = options->timeout_ms;
@@ -856,7 +879,8 @@ z_result_t z_scout(z_moved_config_t *config, z_moved_closure_hello_t *callback,
         _z_uuid_to_bytes(zid.id, zid_str);
     }
 
-    _z_scout(what, zid, &mcast_locator, timeout, __z_hello_handler, wrapped_ctx, callback->_this._val.drop, ctx);
+    _z_scout(what, zid, &mcast_locators, timeout, __z_hello_handler, wrapped_ctx, callback->_this._val.drop, ctx);
+    _z_string_svec_clear(&mcast_locators);
 
     z_free(wrapped_ctx);
     z_config_drop(config);
@@ -1470,6 +1494,15 @@ void z_publisher_put_options_default(z_publisher_put_options_t *options) {
 #endif
 }
 
+void z_publisher_put_many_options_default(z_publisher_put_many_options_t *options) {
+    options->encoding = NULL;
+    options->timestamps = NULL;
+    options->attachments = NULL;
+#ifdef Z_FEATURE_UNSTABLE_API
+    options->source_info = NULL;
+#endif
+}
+
 void z_publisher_delete_options_default(z_publisher_delete_options_t *options) {
     options->timestamp = NULL;
 #ifdef Z_FEATURE_UNSTABLE_API
@@ -1584,6 +1617,239 @@ z_result_t z_publisher_put(const z_loaned_publisher_t *pub, z_moved_bytes_t *pay
 #endif
 }
 
+z_result_t z_publisher_put_many(const z_loaned_publisher_t *pub, z_moved_bytes_t **payloads, size_t len,
+                                const z_publisher_put_many_options_t *options) {
+    z_result_t ret = _Z_RES_OK;
+    // Build options
+    z_publisher_put_many_options_t opt;
+    z_publisher_put_many_options_default(&opt);
+    if (options != NULL) {
+        opt = *options;
+    }
+    z_reliability_t reliability = Z_RELIABILITY_DEFAULT;
+    _z_source_info_t *source_info = NULL;
+#ifdef Z_FEATURE_UNSTABLE_API
+    reliability = pub->reliability;
+    if (opt.source_info != NULL) {
+        source_info = opt.source_info;
+    }
+#endif
+
+    _z_encoding_t encoding;
+    if (opt.encoding == NULL) {
+        encoding = _z_encoding_alias(&pub->_encoding);
+    } else {
+        encoding = _z_encoding_steal(&opt.encoding->_this._val);
+    }
+
+    _z_session_t *session = NULL;
+#if Z_FEATURE_SESSION_CHECK == 1
+    // Try to upgrade session rc
+    _z_session_rc_t sess_rc = _z_session_weak_upgrade_if_open(&pub->_zn);
+    if (!_Z_RC_IS_NULL(&sess_rc)) {
+        session = _Z_RC_IN_VAL(&sess_rc);
+    } else {
+        _Z_ERROR_LOG(_Z_ERR_SESSION_CLOSED);
+        ret = _Z_ERR_SESSION_CLOSED;
+    }
+#else
+    session = _Z_RC_IN_VAL(&pub->_zn);
+#endif
+
+    _z_write_item_t *items = NULL;
+    if ((session != NULL) && (len > 0)) {
+        items = (_z_write_item_t *)z_malloc(len * sizeof(_z_write_item_t));
+        if (items == NULL) {
+            _Z_ERROR_LOG(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        }
+    }
+    if (items != NULL) {
+        for (size_t i = 0; i < len; i++) {
+            items[i].payload = _z_bytes_from_moved(payloads[i]);
+            items[i].attachment = (opt.attachments != NULL) ? _z_bytes_from_moved(opt.attachments[i]) : NULL;
+            items[i].timestamp = (opt.timestamps != NULL) ? &opt.timestamps[i] : NULL;
+        }
+        // Check if write filter is active before writing
+        if (
+#if Z_FEATURE_MULTICAST_DECLARATIONS == 0
+            session->_tp._type == _Z_TRANSPORT_MULTICAST_TYPE ||
+#endif
+            !_z_write_filter_active(&pub->_filter)) {
+            ret = _z_write_many(session, &pub->_key, items, len, &encoding, pub->_congestion_control, pub->_priority,
+                                pub->_is_express, reliability, source_info, pub->_allowed_destination);
+        }
+        z_free(items);
+    }
+
+#if Z_FEATURE_SESSION_CHECK == 1
+    _z_session_rc_drop(&sess_rc);
+#endif
+
+    // Clean-up
+    _z_encoding_clear(&encoding);
+    for (size_t i = 0; i < len; i++) {
+        z_bytes_drop(payloads[i]);
+        if (opt.attachments != NULL) {
+            z_bytes_drop(opt.attachments[i]);
+        }
+    }
+    return ret;
+}
+
+static void _zp_publisher_tx_buf_clear(zp_publisher_tx_buf_t *buf) {
+#if Z_FEATURE_SESSION_CHECK == 1
+    _z_session_rc_drop(&buf->_session_rc);
+#endif
+    _z_slice_clear(&buf->_fallback);
+    _z_encoding_clear(&buf->_encoding);
+    _z_bytes_drop(&buf->_attachment);
+    buf->_session = NULL;
+    buf->_buf = NULL;
+}
+
+z_result_t zp_publisher_loan_tx_buf(const z_loaned_publisher_t *pub, zp_publisher_tx_buf_t *buf, size_t len,
+                                    const z_publisher_put_options_t *options) {
+    z_result_t ret = _Z_RES_OK;
+    *buf = (zp_publisher_tx_buf_t){0};
+    // Build options
+    z_publisher_put_options_t opt;
+    z_publisher_put_options_default(&opt);
+    if (options != NULL) {
+        opt = *options;
+    }
+    buf->_reliability = Z_RELIABILITY_DEFAULT;
+#ifdef Z_FEATURE_UNSTABLE_API
+    buf->_reliability = pub->reliability;
+    if (opt.source_info != NULL) {
+        buf->_source_info = *opt.source_info;
+        buf->_has_source_info = true;
+    }
+#endif
+    if (opt.timestamp != NULL) {
+        buf->_timestamp = *opt.timestamp;
+        buf->_has_timestamp = true;
+    }
+    if (opt.encoding == NULL) {
+        buf->_encoding = _z_encoding_alias(&pub->_encoding);
+    } else {
+        buf->_encoding = _z_encoding_steal(&opt.encoding->_this._val);
+    }
+    _z_bytes_t *attachment = _z_bytes_from_moved(opt.attachment);
+    if (attachment != NULL) {
+        buf->_attachment = _z_bytes_steal(attachment);
+    }
+    buf->_key = &pub->_key;
+    buf->_len = len;
+    buf->_congestion_control = pub->_congestion_control;
+    buf->_priority = pub->_priority;
+    buf->_is_express = pub->_is_express;
+    buf->_destination = pub->_allowed_destination;
+
+#if Z_FEATURE_SESSION_CHECK == 1
+    // Try to upgrade session rc
+    buf->_session_rc = _z_session_weak_upgrade_if_open(&pub->_zn);
+    if (!_Z_RC_IS_NULL(&buf->_session_rc)) {
+        buf->_session = _Z_RC_IN_VAL(&buf->_session_rc);
+    }
+#else
+    buf->_session = _Z_RC_IN_VAL(&pub->_zn);
+#endif
+    if (buf->_session == NULL) {
+        _zp_publisher_tx_buf_clear(buf);
+        _Z_ERROR_RETURN(_Z_ERR_SESSION_CLOSED);
+    }
+    // Check if write filter is active before writing
+    buf->_is_remote = _z_locality_allows_remote(buf->_destination) &&
+                      (
+#if Z_FEATURE_MULTICAST_DECLARATIONS == 0
+                          buf->_session->_tp._type == _Z_TRANSPORT_MULTICAST_TYPE ||
+#endif
+                          !_z_write_filter_active(&pub->_filter));
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+    buf->_is_local = _z_locality_allows_local(buf->_destination);
+#endif
+    if (buf->_is_remote) {
+        ret = _z_write_loan(buf->_session, buf->_key, len, &buf->_encoding, buf->_congestion_control, buf->_priority,
+                            buf->_is_express, buf->_has_timestamp ? &buf->_timestamp : NULL, &buf->_attachment,
+                            buf->_reliability, buf->_has_source_info ? &buf->_source_info : NULL, &buf->_tx);
+        buf->_buf = buf->_tx._buf;
+    }
+    if ((ret == _Z_RES_OK) && (buf->_buf == NULL)) {
+        // The transport can't lend its buffer, the payload is written aside and sent as a regular put
+        if (len > 0) {
+            buf->_fallback = _z_slice_make(len);
+            if (buf->_fallback.len != len) {
+                _Z_ERROR_LOG(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+                ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+            }
+            buf->_buf = (uint8_t *)buf->_fallback.start;
+        }
+    }
+    if (ret != _Z_RES_OK) {
+        _zp_publisher_tx_buf_clear(buf);
+    }
+    return ret;
+}
+
+uint8_t *zp_publisher_tx_buf_data(zp_publisher_tx_buf_t *buf) { return buf->_buf; }
+
+z_result_t zp_publisher_tx_buf_commit(zp_publisher_tx_buf_t *buf) {
+    z_result_t ret = _Z_RES_OK;
+    if (buf->_session == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    const _z_timestamp_t *timestamp = buf->_has_timestamp ? &buf->_timestamp : NULL;
+    const _z_source_info_t *source_info = buf->_has_source_info ? &buf->_source_info : NULL;
+    _z_bytes_t payload = _z_bytes_null();
+    if (buf->_tx._buf != NULL) {
+        // Local subscribers get their own copy since the transport buffer is reused as soon as it is sent
+        if (buf->_is_local) {
+            ret = _z_bytes_from_buf(&payload, buf->_buf, buf->_len);
+        }
+        if (ret == _Z_RES_OK) {
+            ret = _z_send_n_msg_loan_commit(&buf->_tx);
+        } else {
+            _z_send_n_msg_loan_abort(&buf->_tx);
+        }
+        if (ret != _Z_RES_OK) {
+            _Z_ERROR_LOG(_Z_ERR_TRANSPORT_TX_FAILED);
+            ret = _Z_ERR_TRANSPORT_TX_FAILED;
+        }
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+        if ((ret == _Z_RES_OK) && buf->_is_local) {
+            _z_qos_t qos = _z_n_qos_make(buf->_is_express, buf->_congestion_control == Z_CONGESTION_CONTROL_BLOCK,
+                                         buf->_priority);
+            ret = _z_session_deliver_push_locally(buf->_session, &buf->_key->_inner, &payload, &buf->_encoding,
+                                                  Z_SAMPLE_KIND_PUT, qos, timestamp, &buf->_attachment,
+                                                  buf->_reliability, source_info);
+        }
+#endif
+    } else if (buf->_is_remote || buf->_is_local) {
+        if (buf->_fallback.len > 0) {
+            _z_slice_t fallback = _z_slice_steal(&buf->_fallback);
+            ret = _z_bytes_from_slice(&payload, &fallback);
+        }
+        if (ret == _Z_RES_OK) {
+            ret = _z_write(buf->_session, buf->_key, &payload, &buf->_encoding, Z_SAMPLE_KIND_PUT,
+                           buf->_congestion_control, buf->_priority, buf->_is_express, timestamp, &buf->_attachment,
+                           buf->_reliability, source_info,
+                           buf->_is_remote ? buf->_destination : Z_LOCALITY_SESSION_LOCAL);
+        }
+    }
+    _z_bytes_drop(&payload);
+    _zp_publisher_tx_buf_clear(buf);
+    return ret;
+}
+
+void zp_publisher_tx_buf_abort(zp_publisher_tx_buf_t *buf) {
+    if (buf->_session == NULL) {
+        return;
+    }
+    _z_send_n_msg_loan_abort(&buf->_tx);
+    _zp_publisher_tx_buf_clear(buf);
+}
+
 #if Z_FEATURE_ADVANCED_PUBLICATION == 1
 z_result_t _z_publisher_delete_impl(const z_loaned_publisher_t *pub, const z_publisher_delete_options_t *options,
                                     _ze_advanced_cache_t *cache) {
@@ -2108,6 +2374,77 @@ z_result_t z_undeclare_queryable(z_moved_queryable_t *queryable) {
     return ret;
 }
 
+z_result_t z_declare_queryables(const z_loaned_session_t *zs, z_owned_queryable_t *queryables,
+                                const z_loaned_keyexpr_t *const *keyexprs, z_moved_closure_query_t **callbacks,
+                                size_t len, const z_queryable_options_t *options) {
+    z_queryable_options_t opt;
+    z_queryable_options_default(&opt);
+    if (options != NULL) {
+        opt = *options;
+    }
+    z_locality_t allowed_origin = z_locality_default();
+#if Z_FEATURE_LOCAL_QUERYABLE == 1
+    allowed_origin = opt.allowed_origin;
+#endif
+
+    _z_queryable_item_t *items = (_z_queryable_item_t *)z_malloc(len * sizeof(_z_queryable_item_t));
+    _z_queryable_t *vals = (_z_queryable_t *)z_malloc(len * sizeof(_z_queryable_t));
+    for (size_t i = 0; i < len; i++) {
+        _z_closure_query_t closure = callbacks[i]->_this._val;
+        z_internal_closure_query_null(&callbacks[i]->_this);
+        queryables[i]._val = _z_queryable_null();
+        if (items != NULL) {
+            items[i] = (_z_queryable_item_t){
+                .keyexpr = keyexprs[i], .callback = closure.call, .dropper = closure.drop, .arg = closure.context};
+        } else if (closure.drop != NULL) {
+            closure.drop(closure.context);
+        }
+    }
+    if ((items == NULL) || (vals == NULL)) {
+        if (items != NULL) {
+            for (size_t i = 0; i < len; i++) {
+                if (items[i].dropper != NULL) {
+                    items[i].dropper(items[i].arg);
+                }
+            }
+        }
+        z_free(items);
+        z_free(vals);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    z_result_t ret = _z_declare_queryables(vals, zs, items, len, opt.complete, allowed_origin);
+    if (ret == _Z_RES_OK) {
+        for (size_t i = 0; i < len; i++) {
+            queryables[i]._val = vals[i];
+        }
+    }
+    z_free(items);
+    z_free(vals);
+    return ret;
+}
+
+z_result_t z_undeclare_queryables(z_moved_queryable_t **queryables, size_t len) {
+    _z_queryable_t *vals = (_z_queryable_t *)z_malloc(len * sizeof(_z_queryable_t));
+    if (vals == NULL) {
+        z_result_t ret = _Z_RES_OK;
+        for (size_t i = 0; i < len; i++) {
+            z_result_t res = z_undeclare_queryable(queryables[i]);
+            _Z_SET_IF_OK(ret, res);
+        }
+        return ret;
+    }
+    for (size_t i = 0; i < len; i++) {
+        vals[i] = queryables[i]->_this._val;
+        queryables[i]->_this._val = _z_queryable_null();
+    }
+    z_result_t ret = _z_undeclare_queryables(vals, len);
+    for (size_t i = 0; i < len; i++) {
+        _z_queryable_clear(&vals[i]);
+    }
+    z_free(vals);
+    return ret;
+}
+
 const z_loaned_keyexpr_t *z_queryable_keyexpr(const z_loaned_queryable_t *queryable) {
     // Retrieve keyexpr from session
     const z_loaned_keyexpr_t *ret = NULL;
@@ -2121,23 +2458,18 @@ const z_loaned_keyexpr_t *z_queryable_keyexpr(const z_loaned_queryable_t *querya
 #else
     _z_session_t *zn = _z_session_weak_as_unsafe_ptr((_z_session_weak_t *)&queryable->_zn);
 #endif
-    if (_z_session_mutex_lock_if_open(zn) != _Z_RES_OK) {
+    if (_z_session_queryables_mutex_lock_if_open(zn) != _Z_RES_OK) {
         _Z_WARN("Failed to lock session for queryable keyexpr retrieval - session may be closing");
 #if Z_FEATURE_SESSION_CHECK == 1
         _z_session_rc_drop(&sess_rc);
 #endif
         return ret;
     }
-    _z_session_queryable_rc_slist_t *node = zn->_local_queryable;
-    while (node != NULL) {
-        _z_session_queryable_rc_t *val = _z_session_queryable_rc_slist_value(node);
-        if (_Z_RC_IN_VAL(val)->_id == lookup) {
-            ret = (const z_loaned_keyexpr_t *)&_Z_RC_IN_VAL(val)->_key;
-            break;
-        }
-        node = _z_session_queryable_rc_slist_next(node);
+    _z_session_queryable_rc_t *val = _z_session_queryable_rc_hmap_get(&zn->_local_queryable, &lookup);
+    if (val != NULL) {
+        ret = (const z_loaned_keyexpr_t *)&_Z_RC_IN_VAL(val)->_key;
     }
-    _z_session_mutex_unlock(zn);
+    _z_session_queryables_mutex_unlock(zn);
 #if Z_FEATURE_SESSION_CHECK == 1
     _z_session_rc_drop(&sess_rc);
 #endif
@@ -2404,6 +2736,77 @@ z_result_t z_undeclare_subscriber(z_moved_subscriber_t *sub) {
     return ret;
 }
 
+z_result_t z_declare_subscribers(const z_loaned_session_t *zs, z_owned_subscriber_t *subs,
+                                 const z_loaned_keyexpr_t *const *keyexprs, z_moved_closure_sample_t **callbacks,
+                                 size_t len, const z_subscriber_options_t *options) {
+    z_subscriber_options_t opt;
+    z_subscriber_options_default(&opt);
+    if (options != NULL) {
+        opt = *options;
+    }
+    z_locality_t allowed_origin = z_locality_default();
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+    allowed_origin = opt.allowed_origin;
+#endif
+
+    _z_subscriber_item_t *items = (_z_subscriber_item_t *)z_malloc(len * sizeof(_z_subscriber_item_t));
+    _z_subscriber_t *vals = (_z_subscriber_t *)z_malloc(len * sizeof(_z_subscriber_t));
+    for (size_t i = 0; i < len; i++) {
+        _z_closure_sample_t closure = callbacks[i]->_this._val;
+        z_internal_closure_sample_null(&callbacks[i]->_this);
+        subs[i]._val = _z_subscriber_null();
+        if (items != NULL) {
+            items[i] = (_z_subscriber_item_t){
+                .keyexpr = keyexprs[i], .callback = closure.call, .dropper = closure.drop, .arg = closure.context};
+        } else if (closure.drop != NULL) {
+            closure.drop(closure.context);
+        }
+    }
+    if ((items == NULL) || (vals == NULL)) {
+        if (items != NULL) {
+            for (size_t i = 0; i < len; i++) {
+                if (items[i].dropper != NULL) {
+                    items[i].dropper(items[i].arg);
+                }
+            }
+        }
+        z_free(items);
+        z_free(vals);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    z_result_t ret = _z_declare_subscribers(vals, zs, items, len, allowed_origin);
+    if (ret == _Z_RES_OK) {
+        for (size_t i = 0; i < len; i++) {
+            subs[i]._val = vals[i];
+        }
+    }
+    z_free(items);
+    z_free(vals);
+    return ret;
+}
+
+z_result_t z_undeclare_subscribers(z_moved_subscriber_t **subs, size_t len) {
+    _z_subscriber_t *vals = (_z_subscriber_t *)z_malloc(len * sizeof(_z_subscriber_t));
+    if (vals == NULL) {
+        z_result_t ret = _Z_RES_OK;
+        for (size_t i = 0; i < len; i++) {
+            z_result_t res = z_undeclare_subscriber(subs[i]);
+            _Z_SET_IF_OK(ret, res);
+        }
+        return ret;
+    }
+    for (size_t i = 0; i < len; i++) {
+        vals[i] = subs[i]->_this._val;
+        subs[i]->_this._val = _z_subscriber_null();
+    }
+    z_result_t ret = _z_undeclare_subscribers(vals, len);
+    for (size_t i = 0; i < len; i++) {
+        _z_subscriber_clear(&vals[i]);
+    }
+    z_free(vals);
+    return ret;
+}
+
 const z_loaned_keyexpr_t *z_subscriber_keyexpr(const z_loaned_subscriber_t *sub) {
     const z_loaned_keyexpr_t *ret = NULL;
     // Retrieve keyexpr from session
@@ -2417,23 +2820,18 @@ const z_loaned_keyexpr_t *z_subscriber_keyexpr(const z_loaned_subscriber_t *sub)
 #else
     _z_session_t *zn = _z_session_weak_as_unsafe_ptr((_z_session_weak_t *)&sub->_zn);
 #endif
-    if (_z_session_mutex_lock_if_open(zn) != _Z_RES_OK) {
+    if (_z_session_subscriptions_mutex_lock_if_open(zn) != _Z_RES_OK) {
         _Z_WARN("Failed to lock session for subscriber keyexpr retrieval - session may be closing");
 #if Z_FEATURE_SESSION_CHECK == 1
         _z_session_rc_drop(&sess_rc);
 #endif
         return ret;
     }
-    _z_subscription_rc_slist_t *node = zn->_subscriptions;
-    while (node != NULL) {
-        _z_subscription_rc_t *val = _z_subscription_rc_slist_value(node);
-        if (_Z_RC_IN_VAL(val)->_id == lookup) {
-            ret = (const z_loaned_keyexpr_t *)&_Z_RC_IN_VAL(val)->_key;
-            break;
-        }
-        node = _z_subscription_rc_slist_next(node);
+    _z_subscription_rc_t *val = _z_subscription_rc_hmap_get(&zn->_subscriptions, &lookup);
+    if (val != NULL) {
+        ret = (const z_loaned_keyexpr_t *)&_Z_RC_IN_VAL(val)->_key;
     }
-    _z_session_mutex_unlock(zn);
+    _z_session_subscriptions_mutex_unlock(zn);
 #if Z_FEATURE_SESSION_CHECK == 1
     _z_session_rc_drop(&sess_rc);
 #endif
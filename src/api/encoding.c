@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include "zenoh-pico.h"
+#include "zenoh-pico/collections/atomic.h"
 #include "zenoh-pico/utils/string.h"
 
 #if Z_FEATURE_ENCODING_VALUES == 1
@@ -142,10 +143,78 @@ const char *ENCODING_VALUES_ID_TO_STR[] = {
     "video/vp9",
 };
 
+static int _z_encoding_values_cmp(const char *schema, size_t len, const char *value) {
+    size_t value_len = strlen(value);
+    int res = memcmp(schema, value, (len < value_len) ? len : value_len);
+    if (res != 0) {
+        return res;
+    }
+    if (len == value_len) {
+        return 0;
+    }
+    return (len < value_len) ? -1 : 1;
+}
+
+#define _Z_ENCODING_VALUES_LEN _ZP_ARRAY_SIZE(ENCODING_VALUES_ID_TO_STR)
+const size_t _z_encoding_values_len = _Z_ENCODING_VALUES_LEN;
+#define _Z_ENCODING_VALUES_IDX_UNSORTED 0
+#define _Z_ENCODING_VALUES_IDX_SORTING 1
+#define _Z_ENCODING_VALUES_IDX_READY 2
+
+// Indexes of ENCODING_VALUES_ID_TO_STR in lexicographic order of their string, sorted on first use for binary search
+static uint16_t _z_encoding_values_sorted_idx[_Z_ENCODING_VALUES_LEN];
+static _z_atomic_size_t _z_encoding_values_idx_state = {_Z_ENCODING_VALUES_IDX_UNSORTED};
+
+static void _z_encoding_values_sort_idx(void) {
+    // Insertion sort, the table is small and only sorted once
+    for (size_t i = 0; i < _Z_ENCODING_VALUES_LEN; i++) {
+        const char *value = ENCODING_VALUES_ID_TO_STR[i];
+        size_t j = i;
+        while ((j > 0) && (strcmp(ENCODING_VALUES_ID_TO_STR[_z_encoding_values_sorted_idx[j - 1]], value) > 0)) {
+            _z_encoding_values_sorted_idx[j] = _z_encoding_values_sorted_idx[j - 1];
+            j--;
+        }
+        _z_encoding_values_sorted_idx[j] = (uint16_t)i;
+    }
+}
+
+// Returns whether the sorted index can be used, a caller racing with the thread sorting it does not wait
+static bool _z_encoding_values_idx_ready(void) {
+    size_t state = _z_atomic_size_load(&_z_encoding_values_idx_state, _z_memory_order_acquire);
+    if (state == _Z_ENCODING_VALUES_IDX_READY) {
+        return true;
+    }
+    if ((state == _Z_ENCODING_VALUES_IDX_UNSORTED) &&
+        _z_atomic_size_compare_exchange_strong(&_z_encoding_values_idx_state, &state, _Z_ENCODING_VALUES_IDX_SORTING,
+                                               _z_memory_order_acquire, _z_memory_order_relaxed)) {
+        _z_encoding_values_sort_idx();
+        _z_atomic_size_store(&_z_encoding_values_idx_state, _Z_ENCODING_VALUES_IDX_READY, _z_memory_order_release);
+        return true;
+    }
+    return false;
+}
+
 static uint16_t _z_encoding_values_str_to_int(const char *schema, size_t len) {
-    for (size_t i = 0; i < _ZP_ARRAY_SIZE(ENCODING_VALUES_ID_TO_STR); i++) {
-        if (strncmp(schema, ENCODING_VALUES_ID_TO_STR[i], len) == 0) {
-            return (uint16_t)i;
+    if (!_z_encoding_values_idx_ready()) {
+        for (size_t id = 0; id < _Z_ENCODING_VALUES_LEN; id++) {
+            if (_z_encoding_values_cmp(schema, len, ENCODING_VALUES_ID_TO_STR[id]) == 0) {
+                return (uint16_t)id;
+            }
+        }
+        return UINT16_MAX;
+    }
+    size_t lo = 0;
+    size_t hi = _Z_ENCODING_VALUES_LEN;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        uint16_t id = _z_encoding_values_sorted_idx[mid];
+        int res = _z_encoding_values_cmp(schema, len, ENCODING_VALUES_ID_TO_STR[id]);
+        if (res == 0) {
+            return id;
+        } else if (res < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
         }
     }
     return UINT16_MAX;
@@ -247,11 +316,7 @@ z_result_t z_encoding_set_schema_from_substr(z_loaned_encoding_t *encoding, cons
     if (schema == NULL && len > 0) {
         _Z_ERROR_RETURN(_Z_ERR_INVALID);
     }
-    encoding->schema = _z_string_copy_from_substr(schema, len);
-    if (_z_string_len(&encoding->schema) != len) {
-        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-    }
-    return _Z_RES_OK;
+    return _z_encoding_schema_intern(&encoding->schema, schema, len);
 }
 
 z_result_t z_encoding_to_string(const z_loaned_encoding_t *encoding, z_owned_string_t *s) {
@@ -66,6 +66,55 @@ z_result_t z_liveliness_undeclare_token(z_moved_liveliness_token_t *token) {
     return _z_liveliness_token_clear(&token->_this._val);
 }
 
+z_result_t z_liveliness_declare_tokens(const z_loaned_session_t *zs, z_owned_liveliness_token_t *tokens,
+                                       const z_loaned_keyexpr_t *const *keyexprs, size_t len,
+                                       const z_liveliness_token_options_t *options) {
+    (void)options;
+    _z_liveliness_token_t *vals = (_z_liveliness_token_t *)z_malloc(len * sizeof(_z_liveliness_token_t));
+    for (size_t i = 0; i < len; i++) {
+        tokens[i]._val = _z_liveliness_token_null();
+    }
+    if (vals == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    z_result_t ret = _z_declare_liveliness_tokens(zs, vals, keyexprs, len);
+    if (ret == _Z_RES_OK) {
+        for (size_t i = 0; i < len; i++) {
+            tokens[i]._val = vals[i];
+        }
+    }
+    z_free(vals);
+    return ret;
+}
+
+z_result_t z_liveliness_undeclare_tokens(z_moved_liveliness_token_t **tokens, size_t len) {
+    _z_liveliness_token_t *vals = (_z_liveliness_token_t *)z_malloc(len * sizeof(_z_liveliness_token_t));
+    z_result_t ret = _Z_RES_OK;
+    size_t count = 0;
+    for (size_t i = 0; i < len; i++) {
+        _z_liveliness_token_t *token = &tokens[i]->_this._val;
+        _z_session_rc_t sess_rc = _z_session_weak_upgrade_if_open(&token->_zn);
+        if ((vals != NULL) && !_Z_RC_IS_NULL(&sess_rc)) {
+            vals[count++] = *token;
+            *token = _z_liveliness_token_null();
+        } else {
+            // Tokens of a closed session only need to be released
+            z_result_t res = _z_liveliness_token_clear(token);
+            _Z_SET_IF_OK(ret, res);
+        }
+        _z_session_rc_drop(&sess_rc);
+    }
+    if (count > 0) {
+        z_result_t res = _z_undeclare_liveliness_tokens(vals, count);
+        _Z_SET_IF_OK(ret, res);
+    }
+    for (size_t i = 0; i < count; i++) {
+        _z_session_weak_drop(&vals[i]._zn);
+    }
+    z_free(vals);
+    return ret;
+}
+
 /**************** Liveliness Subscriber ****************/
 
 #if Z_FEATURE_SUBSCRIPTION == 1
@@ -119,6 +119,376 @@ static bool _ze_advanced_cache_range_contains(const _ze_advanced_cache_range_t *
             (range->end == _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED || sn <= range->end));
 }
 
+static inline _ze_advanced_cache_entry_t *_ze_advanced_cache_entry(_ze_advanced_cache_t *cache, size_t i) {
+    return &cache->_entries[(cache->_start + i) % cache->_capacity];
+}
+
+// Ordering keys of a cached sample
+typedef struct {
+    _z_ntp64_t time;
+    uint32_t sn;
+    bool has_sn;
+    bool has_time;
+} _ze_advanced_cache_key_t;
+
+static _ze_advanced_cache_key_t _ze_advanced_cache_sample_key(const _z_sample_t *sample) {
+    _ze_advanced_cache_key_t key;
+    key.has_sn = _z_source_info_check(&sample->source_info);
+    key.sn = sample->source_info._source_sn;
+    key.has_time = _z_timestamp_check(&sample->timestamp);
+    key.time = sample->timestamp.time;
+    return key;
+}
+
+static _ze_advanced_cache_key_t _ze_advanced_cache_key(_ze_advanced_cache_t *cache, size_t i) {
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+    if (cache->_file != NULL) {
+        const _ze_advanced_cache_file_slot_t *slot = _ze_advanced_cache_file_slot(cache->_file, i);
+        _ze_advanced_cache_key_t key;
+        key.has_sn = (slot->_flags & _ZE_ADVANCED_CACHE_FILE_SLOT_HAS_SN) != 0;
+        key.sn = slot->_sn;
+        key.has_time = (slot->_flags & _ZE_ADVANCED_CACHE_FILE_SLOT_HAS_TIME) != 0;
+        key.time = slot->_time;
+        return key;
+    }
+#endif
+    return _ze_advanced_cache_sample_key(_Z_RC_IN_VAL(&_ze_advanced_cache_entry(cache, i)->_sample));
+}
+
+// Returns a reference to the i-th oldest sample, or a null reference on failure
+static _z_sample_rc_t _ze_advanced_cache_reference(_ze_advanced_cache_t *cache, size_t i) {
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+    if (cache->_file != NULL) {
+        _z_sample_t *sample = (_z_sample_t *)z_malloc(sizeof(_z_sample_t));
+        if (sample == NULL) {
+            return _z_sample_rc_null();
+        }
+        if (_ze_advanced_cache_file_read(cache->_file, i, sample) != _Z_RES_OK) {
+            z_free(sample);
+            return _z_sample_rc_null();
+        }
+        _z_sample_rc_t rc = _z_sample_rc_new(sample);
+        if (_Z_RC_IS_NULL(&rc)) {
+            _z_sample_clear(sample);
+            z_free(sample);
+        }
+        return rc;
+    }
+#endif
+    return _z_sample_rc_clone(&_ze_advanced_cache_entry(cache, i)->_sample);
+}
+
+// Accounts for a new sample with the given key, setting whether it is out of order with the newest cached sample
+static void _ze_advanced_cache_index(_ze_advanced_cache_t *cache, const _ze_advanced_cache_key_t *key,
+                                     bool *sn_unordered, bool *time_unordered) {
+    *sn_unordered = false;
+    *time_unordered = false;
+    _ze_advanced_cache_key_t prev = {0};
+    if (cache->_len > 0) {
+        prev = _ze_advanced_cache_key(cache, cache->_len - 1);
+    }
+    // Samples missing the key are counted once, ordering is only checked between samples having it
+    if (!key->has_sn) {
+        cache->_sn_unindexed++;
+    } else if (prev.has_sn && key->sn < prev.sn) {
+        *sn_unordered = true;
+        cache->_sn_unindexed++;
+    }
+    if (!key->has_time) {
+        cache->_time_unindexed++;
+    } else if (prev.has_time && key->time < prev.time) {
+        *time_unordered = true;
+        cache->_time_unindexed++;
+    }
+}
+
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+static z_result_t _ze_advanced_cache_file_attach(_ze_advanced_cache_t *cache, size_t capacity, const char *path,
+                                                 size_t persistence_size) {
+    cache->_file = (_ze_advanced_cache_file_t *)z_malloc(sizeof(_ze_advanced_cache_file_t));
+    if (cache->_file == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    z_result_t ret = _ze_advanced_cache_file_open(cache->_file, path, capacity, persistence_size);
+    if (ret != _Z_RES_OK) {
+        z_free(cache->_file);
+        cache->_file = NULL;
+        _Z_ERROR_RETURN(ret);
+    }
+
+    // Rebuild the counters from the restored samples, the oldest one has no predecessor to be out of order with
+    cache->_len = _ze_advanced_cache_file_len(cache->_file);
+    for (size_t i = 0; i < cache->_len; i++) {
+        _ze_advanced_cache_file_slot_t *slot = _ze_advanced_cache_file_slot(cache->_file, i);
+        if (i == 0) {
+            slot->_flags &= ~(_ZE_ADVANCED_CACHE_FILE_SLOT_SN_UNORDERED | _ZE_ADVANCED_CACHE_FILE_SLOT_TIME_UNORDERED);
+        }
+        if ((slot->_flags & _ZE_ADVANCED_CACHE_FILE_SLOT_HAS_SN) == 0 ||
+            (slot->_flags & _ZE_ADVANCED_CACHE_FILE_SLOT_SN_UNORDERED) != 0) {
+            cache->_sn_unindexed++;
+        }
+        if ((slot->_flags & _ZE_ADVANCED_CACHE_FILE_SLOT_HAS_TIME) == 0 ||
+            (slot->_flags & _ZE_ADVANCED_CACHE_FILE_SLOT_TIME_UNORDERED) != 0) {
+            cache->_time_unindexed++;
+        }
+    }
+    if (cache->_len > 0) {
+        _Z_DEBUG("Restored %zu samples in advanced cache from %s", cache->_len, path);
+    }
+    return _Z_RES_OK;
+}
+#endif
+
+// Allocates storage for capacity samples, in the heap or in the file at path if not NULL
+static z_result_t _ze_advanced_cache_entries_init(_ze_advanced_cache_t *cache, size_t capacity, const char *path,
+                                                  size_t persistence_size) {
+    cache->_entries = NULL;
+    cache->_capacity = capacity;
+    cache->_start = 0;
+    cache->_len = 0;
+    cache->_sn_unindexed = 0;
+    cache->_time_unindexed = 0;
+    cache->_outbox = (_z_sample_rc_t *)z_malloc(sizeof(_z_sample_rc_t) * capacity);
+    if (cache->_outbox == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    cache->_outbox_cap = capacity;
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+    cache->_file = NULL;
+    if (path != NULL) {
+        _Z_CLEAN_RETURN_IF_ERR(_ze_advanced_cache_file_attach(cache, capacity, path, persistence_size),
+                               z_free(cache->_outbox);
+                               cache->_outbox = NULL);
+        return _Z_RES_OK;
+    }
+#else
+    _ZP_UNUSED(persistence_size);
+    if (path != NULL) {
+        z_free(cache->_outbox);
+        cache->_outbox = NULL;
+        _Z_ERROR("Advanced cache persistence requires Z_FEATURE_ADVANCED_CACHE_PERSISTENCE");
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+#endif
+    cache->_entries = (_ze_advanced_cache_entry_t *)z_malloc(sizeof(_ze_advanced_cache_entry_t) * capacity);
+    if (cache->_entries == NULL) {
+        z_free(cache->_outbox);
+        cache->_outbox = NULL;
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _Z_RES_OK;
+}
+
+static void _ze_advanced_cache_entries_clear(_ze_advanced_cache_t *cache) {
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+    if (cache->_file != NULL) {
+        _ze_advanced_cache_file_close(cache->_file);
+        z_free(cache->_file);
+        cache->_file = NULL;
+        cache->_len = 0;
+    }
+#endif
+    for (size_t i = 0; i < cache->_len; i++) {
+        _z_sample_rc_drop(&_ze_advanced_cache_entry(cache, i)->_sample);
+    }
+    z_free(cache->_entries);
+    z_free(cache->_outbox);
+    cache->_entries = NULL;
+    cache->_outbox = NULL;
+    cache->_len = 0;
+}
+
+// SAFETY: Must be called with the cache mutex locked
+// Removes the oldest sample and returns whether its successor was out of order with it
+static void _ze_advanced_cache_pop_oldest(_ze_advanced_cache_t *cache, bool *sn_unordered, bool *time_unordered) {
+    *sn_unordered = false;
+    *time_unordered = false;
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+    if (cache->_file != NULL) {
+        _ze_advanced_cache_file_pop_oldest(cache->_file);
+        cache->_len--;
+        if (cache->_len > 0) {
+            _ze_advanced_cache_file_slot_t *next = _ze_advanced_cache_file_slot(cache->_file, 0);
+            *sn_unordered = (next->_flags & _ZE_ADVANCED_CACHE_FILE_SLOT_SN_UNORDERED) != 0;
+            *time_unordered = (next->_flags & _ZE_ADVANCED_CACHE_FILE_SLOT_TIME_UNORDERED) != 0;
+            next->_flags &= ~(_ZE_ADVANCED_CACHE_FILE_SLOT_SN_UNORDERED | _ZE_ADVANCED_CACHE_FILE_SLOT_TIME_UNORDERED);
+        }
+        return;
+    }
+#endif
+    _z_sample_rc_drop(&_ze_advanced_cache_entry(cache, 0)->_sample);
+    cache->_start = (cache->_start + 1) % cache->_capacity;
+    cache->_len--;
+    if (cache->_len > 0) {
+        _ze_advanced_cache_entry_t *next = _ze_advanced_cache_entry(cache, 0);
+        *sn_unordered = next->_sn_unordered;
+        *time_unordered = next->_time_unordered;
+        next->_sn_unordered = false;
+        next->_time_unordered = false;
+    }
+}
+
+// SAFETY: Must be called with the cache mutex locked
+static void _ze_advanced_cache_evict_oldest(_ze_advanced_cache_t *cache) {
+    _ze_advanced_cache_key_t key = _ze_advanced_cache_key(cache, 0);
+    if (!key.has_sn) {
+        cache->_sn_unindexed--;
+    }
+    if (!key.has_time) {
+        cache->_time_unindexed--;
+    }
+    // The new oldest sample has no predecessor to be out of order with
+    bool sn_unordered;
+    bool time_unordered;
+    _ze_advanced_cache_pop_oldest(cache, &sn_unordered, &time_unordered);
+    if (sn_unordered) {
+        cache->_sn_unindexed--;
+    }
+    if (time_unordered) {
+        cache->_time_unindexed--;
+    }
+}
+
+// SAFETY: Must be called with the cache mutex locked
+static void _ze_advanced_cache_push(_ze_advanced_cache_t *cache, _z_sample_rc_t *rc) {
+    if (cache->_len == cache->_capacity) {
+        _ze_advanced_cache_evict_oldest(cache);
+    }
+    _ze_advanced_cache_key_t key = _ze_advanced_cache_sample_key(_Z_RC_IN_VAL(rc));
+    _ze_advanced_cache_entry_t *entry = &cache->_entries[(cache->_start + cache->_len) % cache->_capacity];
+    _ze_advanced_cache_index(cache, &key, &entry->_sn_unordered, &entry->_time_unordered);
+    entry->_sample = *rc;
+    *rc = _z_sample_rc_null();
+    cache->_len++;
+}
+
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+// SAFETY: Must be called with the cache mutex locked
+static z_result_t _ze_advanced_cache_push_to_file(_ze_advanced_cache_t *cache, const _z_sample_t *sample) {
+    size_t len;
+    _Z_RETURN_IF_ERR(_ze_advanced_cache_file_prepare(cache->_file, sample, &len));
+    while (!_ze_advanced_cache_file_fits(cache->_file, len)) {
+        _ze_advanced_cache_evict_oldest(cache);
+    }
+    _ze_advanced_cache_key_t key = _ze_advanced_cache_sample_key(sample);
+    bool sn_unordered;
+    bool time_unordered;
+    _ze_advanced_cache_index(cache, &key, &sn_unordered, &time_unordered);
+
+    _ze_advanced_cache_file_slot_t slot = {0};
+    slot._sn = key.sn;
+    slot._time = key.time;
+    slot._flags = (key.has_sn ? _ZE_ADVANCED_CACHE_FILE_SLOT_HAS_SN : 0) |
+                  (key.has_time ? _ZE_ADVANCED_CACHE_FILE_SLOT_HAS_TIME : 0) |
+                  (sn_unordered ? _ZE_ADVANCED_CACHE_FILE_SLOT_SN_UNORDERED : 0) |
+                  (time_unordered ? _ZE_ADVANCED_CACHE_FILE_SLOT_TIME_UNORDERED : 0);
+    _ze_advanced_cache_file_commit(cache->_file, slot);
+    cache->_len++;
+    return _Z_RES_OK;
+}
+#endif
+
+typedef bool (*_ze_advanced_cache_pred_t)(const _ze_advanced_cache_key_t *key, const void *arg);
+
+// Returns the first index in [lo, hi) for which pred is false, pred being true then false over the range
+static size_t _ze_advanced_cache_partition_point(_ze_advanced_cache_t *cache, size_t lo, size_t hi,
+                                                 _ze_advanced_cache_pred_t pred, const void *arg) {
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        _ze_advanced_cache_key_t key = _ze_advanced_cache_key(cache, mid);
+        if (pred(&key, arg)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static bool _ze_advanced_cache_sn_lt(const _ze_advanced_cache_key_t *key, const void *arg) {
+    return (int64_t)key->sn < *(const int64_t *)arg;
+}
+
+static bool _ze_advanced_cache_sn_le(const _ze_advanced_cache_key_t *key, const void *arg) {
+    return (int64_t)key->sn <= *(const int64_t *)arg;
+}
+
+typedef struct {
+    _z_time_range_t range;
+    _z_ntp64_t now;
+} _ze_advanced_cache_time_arg_t;
+
+static bool _ze_advanced_cache_time_out(const _ze_advanced_cache_key_t *key, const void *arg) {
+    const _ze_advanced_cache_time_arg_t *t = (const _ze_advanced_cache_time_arg_t *)arg;
+    return !_z_time_range_contains_at_time(&t->range, key->time, t->now);
+}
+
+static bool _ze_advanced_cache_time_in(const _ze_advanced_cache_key_t *key, const void *arg) {
+    const _ze_advanced_cache_time_arg_t *t = (const _ze_advanced_cache_time_arg_t *)arg;
+    return _z_time_range_contains_at_time(&t->range, key->time, t->now);
+}
+
+// SAFETY: Must be called with the cache mutex locked
+// Stores references to up to max matching samples in out, newest first, and returns their number.
+// Range and time filters are resolved by binary search while the cached samples are ordered by sequence number and
+// timestamp, which is the case for samples published in order, and by a linear scan otherwise.
+static size_t _ze_advanced_cache_collect(_ze_advanced_cache_t *cache,
+                                         const _ze_advanced_cache_query_parameters_t *params, _z_ntp64_t now,
+                                         _z_sample_rc_t *out, size_t max) {
+    const bool range_filter = (params->range.start != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED) ||
+                              (params->range.end != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED);
+    const bool time_filter =
+        (params->time.start.bound != _Z_TIME_BOUND_UNBOUNDED) || (params->time.end.bound != _Z_TIME_BOUND_UNBOUNDED);
+    bool range_scan = false;
+    bool time_scan = false;
+
+    size_t lo = 0;
+    size_t hi = cache->_len;
+    if (range_filter) {
+        if (cache->_sn_unindexed == 0) {
+            if (params->range.start != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED) {
+                lo = _ze_advanced_cache_partition_point(cache, lo, hi, _ze_advanced_cache_sn_lt, &params->range.start);
+            }
+            if (params->range.end != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED) {
+                hi = _ze_advanced_cache_partition_point(cache, lo, hi, _ze_advanced_cache_sn_le, &params->range.end);
+            }
+        } else {
+            range_scan = true;
+        }
+    }
+    if (time_filter) {
+        if (cache->_time_unindexed == 0) {
+            // The range is convex: split it into its lower and upper bounds
+            _ze_advanced_cache_time_arg_t arg = {.range = params->time, .now = now};
+            arg.range.end.bound = _Z_TIME_BOUND_UNBOUNDED;
+            lo = _ze_advanced_cache_partition_point(cache, lo, hi, _ze_advanced_cache_time_out, &arg);
+            arg.range = params->time;
+            arg.range.start.bound = _Z_TIME_BOUND_UNBOUNDED;
+            hi = _ze_advanced_cache_partition_point(cache, lo, hi, _ze_advanced_cache_time_in, &arg);
+        } else {
+            time_scan = true;
+        }
+    }
+
+    size_t n = 0;
+    for (size_t i = hi; i > lo && n < max; i--) {
+        _ze_advanced_cache_key_t key = _ze_advanced_cache_key(cache, i - 1);
+        if (range_scan && (!key.has_sn || !_ze_advanced_cache_range_contains(&params->range, key.sn))) {
+            continue;
+        }
+        if (time_scan && (!key.has_time || !_z_time_range_contains_at_time(&params->time, key.time, now))) {
+            continue;
+        }
+        out[n] = _ze_advanced_cache_reference(cache, i - 1);
+        if (_Z_RC_IS_NULL(&out[n])) {
+            _Z_ERROR("Sample dropped from advanced cache query reply - failed to reference sample");
+            continue;
+        }
+        n++;
+    }
+    return n;
+}
+
 static void _ze_advanced_cache_query_handler(z_loaned_query_t *query, void *ctx) {
     _ze_advanced_cache_t *cache = (_ze_advanced_cache_t *)ctx;
 
@@ -149,38 +519,11 @@ static void _ze_advanced_cache_query_handler(z_loaned_query_t *query, void *ctx)
         return;
     }
 #endif
-    size_t cap = _z_sample_ring_capacity(&cache->_cache);
-    size_t max = (params.max != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_MAX_UNBOUNDED) ? params.max : cap;
-    if (max > cap) max = cap;
+    size_t max = (params.max != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_MAX_UNBOUNDED) ? params.max : cache->_capacity;
     if (max > cache->_outbox_cap) max = cache->_outbox_cap;
 
-    const bool range_filter = (params.range.start != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED) ||
-                              (params.range.end != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_RANGE_UNBOUNDED);
-    const bool time_filter =
-        (params.time.start.bound != _Z_TIME_BOUND_UNBOUNDED) || (params.time.end.bound != _Z_TIME_BOUND_UNBOUNDED);
-
-    _z_sample_ring_reverse_iterator_t iter = _z_sample_ring_reverse_iterator_make(&cache->_cache);
-
-    size_t to_send = 0;
-    while (max > 0 && _z_sample_ring_reverse_iterator_next(&iter)) {
-        _z_sample_t *sample = _z_sample_ring_reverse_iterator_value(&iter);
-        if (range_filter && (!_z_source_info_check(&sample->source_info) ||
-                             !_ze_advanced_cache_range_contains(&params.range, sample->source_info._source_sn))) {
-            continue;
-        }
-        if (time_filter && (!_z_timestamp_check(&sample->timestamp) ||
-                            !_z_time_range_contains_at_time(&params.time, sample->timestamp.time, now_ntp64))) {
-            continue;
-        }
-
-        res = _z_sample_copy(&cache->_outbox[to_send], sample);
-        if (res != _Z_RES_OK) {
-            _Z_ERROR("Sample dropped from advanced cache query reply - failed to copy sample: %i", res);
-        } else {
-            to_send++;
-            max--;
-        }
-    }
+    // Only references are taken under the lock, the samples are shared with the cache until sent
+    size_t to_send = _ze_advanced_cache_collect(cache, &params, now_ntp64, cache->_outbox, max);
 
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_unlock(&cache->_mutex);
@@ -195,9 +538,9 @@ static void _ze_advanced_cache_query_handler(z_loaned_query_t *query, void *ctx)
     // Send samples in order
     while (to_send > 0) {
         to_send--;
-        _z_sample_t *sample = &cache->_outbox[to_send];
-        res = _z_query_reply_sample(query, sample, &opt);
-        _z_sample_clear(sample);
+        _z_sample_rc_t *rc = &cache->_outbox[to_send];
+        res = _z_query_reply_sample(query, _Z_RC_IN_VAL(rc), &opt);
+        _z_sample_rc_drop(rc);
         if (res != _Z_RES_OK) {
             _Z_ERROR("Sample dropped from advanced cache query reply - failed to send sample: %i", res);
         }
@@ -215,14 +558,13 @@ static z_result_t _ze_advanced_cache_init(_ze_advanced_cache_t *cache, const z_l
         _Z_ERROR_RETURN(_Z_ERR_INVALID);
     }
 
-    _Z_RETURN_IF_ERR(_z_sample_ring_init(&cache->_cache, options.max_samples));
-    cache->_outbox_cap = options.max_samples;
-    cache->_outbox = (_z_sample_t *)z_malloc(sizeof(_z_sample_t) * cache->_outbox_cap);
-    if (cache->_outbox == NULL) {
-        _z_sample_ring_clear(&cache->_cache);
-        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-    }
-    memset(cache->_outbox, 0, sizeof(_z_sample_t) * cache->_outbox_cap);
+    const char *path = NULL;
+    size_t persistence_size = 0;
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+    path = options.persistence_path;
+    persistence_size = options.persistence_size;
+#endif
+    _Z_RETURN_IF_ERR(_ze_advanced_cache_entries_init(cache, options.max_samples, path, persistence_size));
 
     cache->_congestion_control = options.congestion_control;
     cache->_priority = options.priority;
@@ -231,19 +573,16 @@ static z_result_t _ze_advanced_cache_init(_ze_advanced_cache_t *cache, const z_l
     z_owned_keyexpr_t ke;
     z_internal_keyexpr_null(&ke);
     if (suffix != NULL) {
-        _Z_CLEAN_RETURN_IF_ERR(z_keyexpr_join(&ke, keyexpr, suffix), _z_sample_ring_clear(&cache->_cache);
-                               z_free(cache->_outbox); cache->_outbox = NULL);
+        _Z_CLEAN_RETURN_IF_ERR(z_keyexpr_join(&ke, keyexpr, suffix), _ze_advanced_cache_entries_clear(cache));
     } else {
-        _Z_CLEAN_RETURN_IF_ERR(z_keyexpr_clone(&ke, keyexpr), _z_sample_ring_clear(&cache->_cache);
-                               z_free(cache->_outbox); cache->_outbox = NULL);
+        _Z_CLEAN_RETURN_IF_ERR(z_keyexpr_clone(&ke, keyexpr), _ze_advanced_cache_entries_clear(cache));
     }
 
 #if Z_FEATURE_MULTI_THREAD == 1
     _Z_CLEAN_RETURN_IF_ERR(_z_mutex_init(&cache->_mutex), z_keyexpr_drop(z_keyexpr_move(&ke));
-                           _z_sample_ring_clear(&cache->_cache); z_free(cache->_outbox); cache->_outbox = NULL);
+                           _ze_advanced_cache_entries_clear(cache));
     _Z_CLEAN_RETURN_IF_ERR(_z_mutex_init(&cache->_outbox_mutex), z_keyexpr_drop(z_keyexpr_move(&ke));
-                           _z_sample_ring_clear(&cache->_cache); z_free(cache->_outbox); cache->_outbox = NULL;
-                           _z_mutex_drop(&cache->_mutex));
+                           _ze_advanced_cache_entries_clear(cache); _z_mutex_drop(&cache->_mutex));
 #endif
 
     z_result_t res = _Z_RES_OK;
@@ -252,9 +591,7 @@ static z_result_t _ze_advanced_cache_init(_ze_advanced_cache_t *cache, const z_l
         res = z_liveliness_declare_token(zs, &cache->_liveliness, z_keyexpr_loan(&ke), NULL);
         if (res != _Z_RES_OK) {
             z_keyexpr_drop(z_keyexpr_move(&ke));
-            _z_sample_ring_clear(&cache->_cache);
-            z_free(cache->_outbox);
-            cache->_outbox = NULL;
+            _ze_advanced_cache_entries_clear(cache);
 #if Z_FEATURE_MULTI_THREAD == 1
             _z_mutex_drop(&cache->_mutex);
             _z_mutex_drop(&cache->_outbox_mutex);
@@ -269,9 +606,7 @@ static z_result_t _ze_advanced_cache_init(_ze_advanced_cache_t *cache, const z_l
     if (res != _Z_RES_OK) {
         z_keyexpr_drop(z_keyexpr_move(&ke));
         z_liveliness_token_drop(z_liveliness_token_move(&cache->_liveliness));
-        _z_sample_ring_clear(&cache->_cache);
-        z_free(cache->_outbox);
-        cache->_outbox = NULL;
+        _ze_advanced_cache_entries_clear(cache);
 #if Z_FEATURE_MULTI_THREAD == 1
         _z_mutex_drop(&cache->_mutex);
         _z_mutex_drop(&cache->_outbox_mutex);
@@ -283,9 +618,7 @@ static z_result_t _ze_advanced_cache_init(_ze_advanced_cache_t *cache, const z_l
         z_keyexpr_drop(z_keyexpr_move(&ke));
         z_liveliness_token_drop(z_liveliness_token_move(&cache->_liveliness));
         z_closure_query_drop(z_closure_query_move(&callback));
-        _z_sample_ring_clear(&cache->_cache);
-        z_free(cache->_outbox);
-        cache->_outbox = NULL;
+        _ze_advanced_cache_entries_clear(cache);
 #if Z_FEATURE_MULTI_THREAD == 1
         _z_mutex_drop(&cache->_mutex);
         _z_mutex_drop(&cache->_outbox_mutex);
@@ -319,16 +652,38 @@ z_result_t _ze_advanced_cache_add(_ze_advanced_cache_t *cache, _z_sample_t *samp
     if (cache == NULL || sample == NULL) {
         _Z_ERROR_RETURN(_Z_ERR_INVALID);
     }
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+    if (cache->_file != NULL) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        _Z_RETURN_IF_ERR(_z_mutex_lock(&cache->_mutex));
+#endif
+        z_result_t ret = _ze_advanced_cache_push_to_file(cache, sample);
+#if Z_FEATURE_MULTI_THREAD == 1
+        _z_mutex_unlock(&cache->_mutex);
+#endif
+        // The sample is serialized in the file, the caller's copy is released as if it had been moved in
+        if (ret == _Z_RES_OK) {
+            _z_sample_clear(sample);
+        }
+        return ret;
+    }
+#endif
     _z_sample_t *s = (_z_sample_t *)z_malloc(sizeof(_z_sample_t));
     if (s == NULL) {
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
     _Z_CLEAN_RETURN_IF_ERR(_z_sample_move(s, sample), z_free((void *)s));
+    _z_sample_rc_t rc = _z_sample_rc_new(s);
+    if (_Z_RC_IS_NULL(&rc)) {
+        _z_sample_clear(s);
+        z_free((void *)s);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
 
 #if Z_FEATURE_MULTI_THREAD == 1
-    _Z_CLEAN_RETURN_IF_ERR(_z_mutex_lock(&cache->_mutex), z_free((void *)s));
+    _Z_CLEAN_RETURN_IF_ERR(_z_mutex_lock(&cache->_mutex), _z_sample_rc_drop(&rc));
 #endif
-    _z_sample_ring_push_force_drop(&cache->_cache, s);
+    _ze_advanced_cache_push(cache, &rc);
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_unlock(&cache->_mutex);
 #endif
@@ -346,8 +701,7 @@ void _ze_advanced_cache_free(_ze_advanced_cache_t **pcache) {
         _z_mutex_lock(&cache->_outbox_mutex);
         _z_mutex_lock(&cache->_mutex);
 #endif
-        _z_sample_ring_clear(&cache->_cache);
-        z_free(cache->_outbox);
+        _ze_advanced_cache_entries_clear(cache);
 
 #if Z_FEATURE_MULTI_THREAD == 1
         _z_mutex_unlock(&cache->_mutex);
@@ -361,4 +715,68 @@ void _ze_advanced_cache_free(_ze_advanced_cache_t **pcache) {
     }
 }
 
+#if defined(Z_TEST_HOOKS)
+static _ze_advanced_cache_t *_ze_advanced_cache_new_detached_at(size_t max_samples, const char *path,
+                                                                 size_t persistence_size) {
+    _ze_advanced_cache_t *cache = (_ze_advanced_cache_t *)z_malloc(sizeof(_ze_advanced_cache_t));
+    if (cache == NULL) {
+        return NULL;
+    }
+    memset(cache, 0, sizeof(_ze_advanced_cache_t));
+    if (max_samples == 0 || _ze_advanced_cache_entries_init(cache, max_samples, path, persistence_size) != _Z_RES_OK) {
+        z_free(cache);
+        return NULL;
+    }
+#if Z_FEATURE_MULTI_THREAD == 1
+    if (_z_mutex_init(&cache->_mutex) != _Z_RES_OK) {
+        _ze_advanced_cache_entries_clear(cache);
+        z_free(cache);
+        return NULL;
+    }
+    if (_z_mutex_init(&cache->_outbox_mutex) != _Z_RES_OK) {
+        _z_mutex_drop(&cache->_mutex);
+        _ze_advanced_cache_entries_clear(cache);
+        z_free(cache);
+        return NULL;
+    }
+#endif
+    z_internal_queryable_null(&cache->_queryable);
+    z_internal_liveliness_token_null(&cache->_liveliness);
+    return cache;
+}
+
+_ze_advanced_cache_t *_ze_advanced_cache_new_detached(size_t max_samples) {
+    return _ze_advanced_cache_new_detached_at(max_samples, NULL, 0);
+}
+
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+_ze_advanced_cache_t *_ze_advanced_cache_new_detached_persistent(size_t max_samples, const char *path,
+                                                                 size_t persistence_size) {
+    return _ze_advanced_cache_new_detached_at(max_samples, path, persistence_size);
+}
+#endif
+
+size_t _ze_advanced_cache_query(_ze_advanced_cache_t *cache, const char *parameters, _z_ntp64_t now,
+                                _z_sample_rc_t *out, size_t out_cap) {
+    z_view_string_t param_str;
+    if (z_view_string_from_str(&param_str, parameters) != _Z_RES_OK) {
+        return 0;
+    }
+    _ze_advanced_cache_query_parameters_t params;
+    _ze_advanced_cache_query_parse_parameters(&params, z_view_string_loan(&param_str));
+    size_t max = (params.max != _ZE_ADVANCED_CACHE_QUERY_PARAMETERS_MAX_UNBOUNDED) ? params.max : cache->_capacity;
+    if (max > out_cap) max = out_cap;
+#if Z_FEATURE_MULTI_THREAD == 1
+    if (_z_mutex_lock(&cache->_mutex) != _Z_RES_OK) {
+        return 0;
+    }
+#endif
+    size_t n = _ze_advanced_cache_collect(cache, &params, now, out, max);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_unlock(&cache->_mutex);
+#endif
+    return n;
+}
+#endif
+
 #endif  // Z_FEATURE_ADVANCED_PUBLICATION == 1
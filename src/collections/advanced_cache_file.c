@@ -0,0 +1,221 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+#include "zenoh-pico/collections/advanced_cache_file.h"
+
+#include <string.h>
+
+#include "zenoh-pico/collections/atomic.h"
+#include "zenoh-pico/protocol/codec/core.h"
+#include "zenoh-pico/utils/logging.h"
+
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+
+#define _ZE_ADVANCED_CACHE_FILE_SCRATCH_SIZE 256
+
+#define _ZE_ADVANCED_CACHE_FILE_RECORD_HAS_TIMESTAMP 0x01U
+#define _ZE_ADVANCED_CACHE_FILE_RECORD_HAS_SOURCE_INFO 0x02U
+
+static bool _ze_advanced_cache_file_is_valid(const _ze_advanced_cache_file_t *file, size_t capacity,
+                                             size_t data_size) {
+    const _ze_advanced_cache_file_header_t *header = file->_header;
+    if (header->_magic != _ZE_ADVANCED_CACHE_FILE_MAGIC || header->_version != _ZE_ADVANCED_CACHE_FILE_VERSION ||
+        header->_capacity != capacity || header->_data_size != data_size || header->_end < header->_first ||
+        header->_end - header->_first > capacity) {
+        return false;
+    }
+    // Every record must lie in the last data_size bytes of the stream, in order
+    uint64_t prev_end = (header->_head > data_size) ? header->_head - data_size : 0;
+    for (size_t i = 0; i < _ze_advanced_cache_file_len(file); i++) {
+        const _ze_advanced_cache_file_slot_t *slot = _ze_advanced_cache_file_slot(file, i);
+        if (slot->_offset < prev_end || slot->_offset + slot->_len > header->_head ||
+            (slot->_offset % data_size) + slot->_len > data_size) {
+            return false;
+        }
+        prev_end = slot->_offset + slot->_len;
+    }
+    return true;
+}
+
+static void _ze_advanced_cache_file_reset(_ze_advanced_cache_file_t *file, size_t capacity, size_t data_size) {
+    _ze_advanced_cache_file_header_t *header = file->_header;
+    header->_magic = 0;
+    _z_atomic_thread_fence(_z_memory_order_release);
+    header->_version = _ZE_ADVANCED_CACHE_FILE_VERSION;
+    header->_capacity = capacity;
+    header->_data_size = data_size;
+    header->_first = 0;
+    header->_end = 0;
+    header->_head = 0;
+    _z_atomic_thread_fence(_z_memory_order_release);
+    header->_magic = _ZE_ADVANCED_CACHE_FILE_MAGIC;
+}
+
+z_result_t _ze_advanced_cache_file_open(_ze_advanced_cache_file_t *file, const char *path, size_t capacity,
+                                        size_t data_size) {
+    if (path == NULL || capacity == 0 || data_size == 0 ||
+        capacity > (SIZE_MAX - sizeof(_ze_advanced_cache_file_header_t) - data_size) /
+                       sizeof(_ze_advanced_cache_file_slot_t)) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    size_t slots_size = capacity * sizeof(_ze_advanced_cache_file_slot_t);
+    size_t size = sizeof(_ze_advanced_cache_file_header_t) + slots_size + data_size;
+    _Z_RETURN_IF_ERR(_z_mapped_file_open(&file->_map, path, size));
+
+    file->_header = (_ze_advanced_cache_file_header_t *)file->_map._addr;
+    file->_slots = (_ze_advanced_cache_file_slot_t *)(file->_map._addr + sizeof(_ze_advanced_cache_file_header_t));
+    file->_data = file->_map._addr + sizeof(_ze_advanced_cache_file_header_t) + slots_size;
+    file->_scratch = _z_wbuf_make(_ZE_ADVANCED_CACHE_FILE_SCRATCH_SIZE, true);
+    if (_z_wbuf_capacity(&file->_scratch) == 0) {
+        _z_mapped_file_close(&file->_map);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+
+    if (!_ze_advanced_cache_file_is_valid(file, capacity, data_size)) {
+        if (file->_header->_magic != 0) {
+            _Z_WARN("Discarding advanced cache history from %s: incompatible or corrupted file", path);
+        }
+        _ze_advanced_cache_file_reset(file, capacity, data_size);
+    }
+    return _Z_RES_OK;
+}
+
+void _ze_advanced_cache_file_close(_ze_advanced_cache_file_t *file) {
+    _z_wbuf_clear(&file->_scratch);
+    _z_mapped_file_close(&file->_map);
+    file->_header = NULL;
+    file->_slots = NULL;
+    file->_data = NULL;
+}
+
+void _ze_advanced_cache_file_pop_oldest(_ze_advanced_cache_file_t *file) { file->_header->_first++; }
+
+z_result_t _ze_advanced_cache_file_prepare(_ze_advanced_cache_file_t *file, const _z_sample_t *sample, size_t *len) {
+    _z_wbuf_t *wbf = &file->_scratch;
+    _z_wbuf_reset(wbf);
+
+    uint8_t flags = 0;
+    if (_z_timestamp_check(&sample->timestamp)) {
+        flags |= _ZE_ADVANCED_CACHE_FILE_RECORD_HAS_TIMESTAMP;
+    }
+    if (_z_source_info_check(&sample->source_info)) {
+        flags |= _ZE_ADVANCED_CACHE_FILE_RECORD_HAS_SOURCE_INFO;
+    }
+    _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, flags));
+    _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, (uint8_t)sample->kind));
+    _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, sample->qos._val));
+    _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, (uint8_t)sample->reliability));
+    _Z_RETURN_IF_ERR(_z_string_encode(wbf, &sample->keyexpr._inner._keyexpr));
+    _Z_RETURN_IF_ERR(_z_encoding_encode(wbf, &sample->encoding));
+    _Z_RETURN_IF_ERR(_z_bytes_encode(wbf, &sample->payload));
+    _Z_RETURN_IF_ERR(_z_bytes_encode(wbf, &sample->attachment));
+    if ((flags & _ZE_ADVANCED_CACHE_FILE_RECORD_HAS_TIMESTAMP) != 0) {
+        _Z_RETURN_IF_ERR(_z_timestamp_encode(wbf, &sample->timestamp));
+    }
+    if ((flags & _ZE_ADVANCED_CACHE_FILE_RECORD_HAS_SOURCE_INFO) != 0) {
+        _Z_RETURN_IF_ERR(_z_source_info_encode(wbf, &sample->source_info));
+    }
+
+    *len = _z_wbuf_len(wbf);
+    if (*len > file->_header->_data_size || *len > UINT32_MAX) {
+        _Z_ERROR("Sample of %zu bytes does not fit in the advanced cache file", *len);
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    return _Z_RES_OK;
+}
+
+// Returns the stream position at which a record of len bytes is written, skipping the end of the ring if needed
+static uint64_t _ze_advanced_cache_file_record_offset(const _ze_advanced_cache_file_header_t *header, size_t len) {
+    uint64_t pos = header->_head % header->_data_size;
+    return (pos + len > header->_data_size) ? header->_head + (header->_data_size - pos) : header->_head;
+}
+
+bool _ze_advanced_cache_file_fits(const _ze_advanced_cache_file_t *file, size_t len) {
+    const _ze_advanced_cache_file_header_t *header = file->_header;
+    size_t n = _ze_advanced_cache_file_len(file);
+    if (n == 0) {
+        return true;
+    }
+    if (n == header->_capacity) {
+        return false;
+    }
+    uint64_t end = _ze_advanced_cache_file_record_offset(header, len) + len;
+    return _ze_advanced_cache_file_slot(file, 0)->_offset + header->_data_size >= end;
+}
+
+void _ze_advanced_cache_file_commit(_ze_advanced_cache_file_t *file, _ze_advanced_cache_file_slot_t slot) {
+    _ze_advanced_cache_file_header_t *header = file->_header;
+    _z_wbuf_t *wbf = &file->_scratch;
+    size_t len = _z_wbuf_len(wbf);
+
+    slot._offset = _ze_advanced_cache_file_record_offset(header, len);
+    slot._len = (uint32_t)len;
+    slot._reserved = 0;
+    uint8_t *dst = &file->_data[slot._offset % header->_data_size];
+    for (size_t i = 0; i < _z_wbuf_len_iosli(wbf); i++) {
+        _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, i);
+        size_t readable = _z_iosli_readable(ios);
+        memcpy(dst, ios->_buf + ios->_r_pos, readable);
+        dst += readable;
+    }
+    file->_slots[header->_end % header->_capacity] = slot;
+
+    // Publish the sample once its record and slot are written
+    _z_atomic_thread_fence(_z_memory_order_release);
+    header->_head = slot._offset + len;
+    _z_atomic_thread_fence(_z_memory_order_release);
+    header->_end++;
+}
+
+z_result_t _ze_advanced_cache_file_read(const _ze_advanced_cache_file_t *file, size_t i, _z_sample_t *sample) {
+    const _ze_advanced_cache_file_slot_t *slot = _ze_advanced_cache_file_slot(file, i);
+    _z_zbuf_t zbf = _z_slice_as_zbuf(
+        _z_slice_alias_buf(&file->_data[slot->_offset % file->_header->_data_size], (size_t)slot->_len));
+
+    // Decoded fields alias the mapping and are copied into the sample
+    uint8_t flags = 0;
+    uint8_t kind = 0;
+    uint8_t qos = 0;
+    uint8_t reliability = 0;
+    _Z_RETURN_IF_ERR(_z_uint8_decode(&flags, &zbf));
+    _Z_RETURN_IF_ERR(_z_uint8_decode(&kind, &zbf));
+    _Z_RETURN_IF_ERR(_z_uint8_decode(&qos, &zbf));
+    _Z_RETURN_IF_ERR(_z_uint8_decode(&reliability, &zbf));
+    _z_string_t keyexpr = _z_string_null();
+    _Z_RETURN_IF_ERR(_z_string_decode(&keyexpr, &zbf));
+    _z_encoding_t encoding = _z_encoding_null();
+    _Z_RETURN_IF_ERR(_z_encoding_decode(&encoding, &zbf));
+    _z_slice_t payload;
+    _Z_RETURN_IF_ERR(_z_slice_decode(&payload, &zbf));
+    _z_slice_t attachment;
+    _Z_RETURN_IF_ERR(_z_slice_decode(&attachment, &zbf));
+
+    *sample = _z_sample_null();
+    if ((flags & _ZE_ADVANCED_CACHE_FILE_RECORD_HAS_TIMESTAMP) != 0) {
+        _Z_RETURN_IF_ERR(_z_timestamp_decode(&sample->timestamp, &zbf));
+    }
+    if ((flags & _ZE_ADVANCED_CACHE_FILE_RECORD_HAS_SOURCE_INFO) != 0) {
+        _Z_RETURN_IF_ERR(_z_source_info_decode(&sample->source_info, &zbf));
+    }
+    sample->kind = (z_sample_kind_t)kind;
+    sample->qos._val = qos;
+    sample->reliability = (z_reliability_t)reliability;
+    _Z_RETURN_IF_ERR(_z_declared_keyexpr_from_string(&sample->keyexpr, &keyexpr));
+    _Z_CLEAN_RETURN_IF_ERR(_z_encoding_copy(&sample->encoding, &encoding), _z_sample_clear(sample));
+    _Z_CLEAN_RETURN_IF_ERR(_z_bytes_from_buf(&sample->payload, payload.start, payload.len), _z_sample_clear(sample));
+    _Z_CLEAN_RETURN_IF_ERR(_z_bytes_from_buf(&sample->attachment, attachment.start, attachment.len),
+                           _z_sample_clear(sample));
+    return _Z_RES_OK;
+}
+
+#endif  // Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/collections/epoch.h"
+
+#include <stddef.h>
+
+static inline bool _z_epoch_cell_lock(_z_epoch_cell_t *cell, bool wait) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    return (wait ? _z_mutex_lock(&cell->_mutex) : _z_mutex_try_lock(&cell->_mutex)) == _Z_RES_OK;
+#else
+    _ZP_UNUSED(cell);
+    _ZP_UNUSED(wait);
+    return true;
+#endif
+}
+
+static inline void _z_epoch_cell_unlock(_z_epoch_cell_t *cell) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_unlock(&cell->_mutex);
+#else
+    _ZP_UNUSED(cell);
+#endif
+}
+
+static inline bool _z_epoch_cell_can_advance(_z_epoch_cell_t *cell) {
+    size_t epoch = _z_atomic_size_load(&cell->_epoch, _z_memory_order_seq_cst);
+    return _z_atomic_size_load(&cell->_readers[(epoch + 1) & 1], _z_memory_order_seq_cst) == 0;
+}
+
+z_result_t _z_epoch_cell_init(_z_epoch_cell_t *cell, _z_epoch_free_f free_f) {
+    _z_atomic_ptr_init(&cell->_current, NULL);
+    _z_atomic_size_init(&cell->_epoch, 0);
+    _z_atomic_size_init(&cell->_readers[0], 0);
+    _z_atomic_size_init(&cell->_readers[1], 0);
+    _z_atomic_bool_init(&cell->_has_retired, false);
+    _z_atomic_bool_init(&cell->_clearing, false);
+    cell->_retired = NULL;
+    cell->_retired_last = NULL;
+    cell->_grace = 0;
+    cell->_free = free_f;
+#if Z_FEATURE_MULTI_THREAD == 1
+    _Z_RETURN_IF_ERR(_z_mutex_init(&cell->_mutex));
+    _Z_CLEAN_RETURN_IF_ERR(_z_condvar_init(&cell->_condvar), _z_mutex_drop(&cell->_mutex));
+#endif
+    return _Z_RES_OK;
+}
+
+/**
+ * Detaches the retired objects that no reader can use anymore, advancing the epoch each time the readers of the
+ * previous one are gone. Must be called with cell->_mutex locked.
+ */
+static _z_epoch_node_t *__unsafe_z_epoch_cell_collect(_z_epoch_cell_t *cell) {
+    _z_epoch_node_t *ready = NULL;
+    _z_epoch_node_t **ready_tail = &ready;
+    while (cell->_retired != NULL) {
+        // Both reader counters were seen empty since these objects were replaced
+        while ((cell->_retired != NULL) && (cell->_retired->_grace + 2 <= cell->_grace)) {
+            _z_epoch_node_t *node = cell->_retired;
+            cell->_retired = node->_next;
+            node->_next = NULL;
+            *ready_tail = node;
+            ready_tail = &node->_next;
+        }
+        if ((cell->_retired == NULL) || !_z_epoch_cell_can_advance(cell)) {
+            break;
+        }
+        cell->_grace++;
+        size_t epoch = _z_atomic_size_load(&cell->_epoch, _z_memory_order_relaxed);
+        _z_atomic_size_store(&cell->_epoch, epoch + 1, _z_memory_order_seq_cst);
+    }
+    if (cell->_retired == NULL) {
+        cell->_retired_last = NULL;
+    }
+    _z_atomic_bool_store(&cell->_has_retired, cell->_retired != NULL, _z_memory_order_seq_cst);
+    return ready;
+}
+
+static void _z_epoch_cell_free_all(_z_epoch_cell_t *cell, _z_epoch_node_t *ready) {
+    while (ready != NULL) {
+        _z_epoch_node_t *next = ready->_next;
+        cell->_free(ready);
+        ready = next;
+    }
+}
+
+static void _z_epoch_cell_try_reclaim(_z_epoch_cell_t *cell, bool wait) {
+    do {
+        if (!_z_epoch_cell_lock(cell, wait)) {
+            // The holder of the mutex checks again once it is released
+            return;
+        }
+        _z_epoch_node_t *ready = __unsafe_z_epoch_cell_collect(cell);
+        _z_epoch_cell_unlock(cell);
+        _z_epoch_cell_free_all(cell, ready);
+        // A reader may have left while the mutex was held, without being able to take it
+    } while (_z_atomic_bool_load(&cell->_has_retired, _z_memory_order_seq_cst) && _z_epoch_cell_can_advance(cell));
+}
+
+void _z_epoch_cell_exit(_z_epoch_cell_t *cell, size_t token) {
+    if ((_z_atomic_size_fetch_sub(&cell->_readers[token], 1, _z_memory_order_seq_cst) == 1) &&
+        _z_atomic_bool_load(&cell->_has_retired, _z_memory_order_seq_cst)) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        if (_z_atomic_bool_load(&cell->_clearing, _z_memory_order_seq_cst)) {
+            // Signaled under the mutex, so that it can't be missed between the check and the wait of the clearer
+            _z_mutex_lock(&cell->_mutex);
+            _z_condvar_signal_all(&cell->_condvar);
+            _z_mutex_unlock(&cell->_mutex);
+            return;
+        }
+#endif
+        _z_epoch_cell_try_reclaim(cell, false);
+    }
+}
+
+void _z_epoch_cell_publish(_z_epoch_cell_t *cell, _z_epoch_node_t *node) {
+    _z_epoch_node_t *old = (_z_epoch_node_t *)_z_atomic_ptr_load(&cell->_current, _z_memory_order_relaxed);
+    _z_atomic_ptr_store(&cell->_current, node, _z_memory_order_seq_cst);
+    if (old == NULL) {
+        return;
+    }
+    _z_epoch_cell_lock(cell, true);
+    old->_next = NULL;
+    old->_grace = cell->_grace;
+    if (cell->_retired_last == NULL) {
+        cell->_retired = old;
+    } else {
+        cell->_retired_last->_next = old;
+    }
+    cell->_retired_last = old;
+    _z_atomic_bool_store(&cell->_has_retired, true, _z_memory_order_seq_cst);
+    _z_epoch_cell_unlock(cell);
+}
+
+void _z_epoch_cell_reclaim(_z_epoch_cell_t *cell) { _z_epoch_cell_try_reclaim(cell, true); }
+
+void _z_epoch_cell_clear(_z_epoch_cell_t *cell) {
+    _z_epoch_cell_publish(cell, NULL);
+#if Z_FEATURE_MULTI_THREAD == 1
+    // Readers still in a section leave the reclamation to this thread and wake it up
+    _z_atomic_bool_store(&cell->_clearing, true, _z_memory_order_seq_cst);
+    _z_mutex_lock(&cell->_mutex);
+    while (true) {
+        _z_epoch_node_t *ready = __unsafe_z_epoch_cell_collect(cell);
+        bool done = (cell->_retired == NULL);
+        if ((ready == NULL) && !done) {
+            _z_condvar_wait(&cell->_condvar, &cell->_mutex);
+            continue;
+        }
+        _z_mutex_unlock(&cell->_mutex);
+        _z_epoch_cell_free_all(cell, ready);
+        if (done) {
+            break;
+        }
+        _z_mutex_lock(&cell->_mutex);
+    }
+    _z_condvar_drop(&cell->_condvar);
+    _z_mutex_drop(&cell->_mutex);
+#else
+    // Without threads, no reader can be in a section
+    _z_epoch_cell_reclaim(cell);
+#endif
+}
@@ -23,10 +23,12 @@
 #include "zenoh-pico/utils/pointers.h"
 #include "zenoh-pico/utils/result.h"
 
-// Nodes are chained as double linked list for lru insertion/deletion.
+// Nodes are chained as double linked list for lru insertion/deletion, and as single linked list in their bucket.
 typedef struct _z_lru_cache_node_data_t {
-    _z_lru_cache_node_t *prev;  // List previous node
-    _z_lru_cache_node_t *next;  // List next node
+    _z_lru_cache_node_t *prev;         // List previous node
+    _z_lru_cache_node_t *next;         // List next node
+    _z_lru_cache_node_t *bucket_next;  // Next node of the same bucket
+    size_t hash;                       // Hash of the node value
 } _z_lru_cache_node_data_t;
 
 #define NODE_DATA_SIZE sizeof(_z_lru_cache_node_data_t)
@@ -42,17 +44,23 @@ static inline void *_z_lru_cache_node_value(_z_lru_cache_node_t *node) {
     return (void *)_z_ptr_u8_offset((uint8_t *)node, (ptrdiff_t)NODE_DATA_SIZE);
 }
 
-static _z_lru_cache_node_t *_z_lru_cache_node_create(void *value, size_t value_size) {
+static _z_lru_cache_node_t *_z_lru_cache_node_create(void *value, size_t value_size, size_t hash) {
     size_t node_size = NODE_DATA_SIZE + value_size;
     _z_lru_cache_node_t *node = (_z_lru_cache_node_t *)z_malloc(node_size);
     if (node == NULL) {
         return node;
     }
     memset(node, 0, NODE_DATA_SIZE);
+    _z_lru_cache_node_data(node)->hash = hash;
     memcpy(_z_lru_cache_node_value(node), value, value_size);
     return node;
 }
 
+static void _z_lru_cache_node_delete(_z_lru_cache_node_t *node, z_element_clear_f clear) {
+    clear(_z_lru_cache_node_value(node));
+    z_free(node);
+}
+
 // List functions
 static void _z_lru_cache_insert_list_node(_z_lru_cache_t *cache, _z_lru_cache_node_t *node) {
     _z_lru_cache_node_data_t *node_data = _z_lru_cache_node_data(node);
@@ -72,146 +80,96 @@ static void _z_lru_cache_insert_list_node(_z_lru_cache_t *cache, _z_lru_cache_no
 static void _z_lru_cache_remove_list_node(_z_lru_cache_t *cache, _z_lru_cache_node_t *node) {
     _z_lru_cache_node_data_t *node_data = _z_lru_cache_node_data(node);
 
-    // Nominal case
-    if ((node_data->prev != NULL) && (node_data->next != NULL)) {
-        _z_lru_cache_node_data_t *prev_data = _z_lru_cache_node_data(node_data->prev);
-        _z_lru_cache_node_data_t *next_data = _z_lru_cache_node_data(node_data->next);
-        prev_data->next = node_data->next;
-        next_data->prev = node_data->prev;
-    }
-    if (node_data->prev == NULL) {
+    if (node_data->prev != NULL) {
+        _z_lru_cache_node_data(node_data->prev)->next = node_data->next;
+    } else {
         assert(cache->head == node);
         cache->head = node_data->next;
-        if (node_data->next != NULL) {
-            _z_lru_cache_node_data_t *next_data = _z_lru_cache_node_data(node_data->next);
-            next_data->prev = NULL;
-        }
     }
-    if (node_data->next == NULL) {
+    if (node_data->next != NULL) {
+        _z_lru_cache_node_data(node_data->next)->prev = node_data->prev;
+    } else {
         assert(cache->tail == node);
         cache->tail = node_data->prev;
-        if (node_data->prev != NULL) {
-            _z_lru_cache_node_data_t *prev_data = _z_lru_cache_node_data(node_data->prev);
-            prev_data->next = NULL;
-        }
     }
+    node_data->prev = NULL;
+    node_data->next = NULL;
 }
 
 static void _z_lru_cache_update_list(_z_lru_cache_t *cache, _z_lru_cache_node_t *node) {
+    if (cache->head == node) {
+        return;
+    }
     _z_lru_cache_remove_list_node(cache, node);
     _z_lru_cache_insert_list_node(cache, node);
 }
 
-static void _z_lru_cache_clear_list(_z_lru_cache_t *cache, z_element_clear_f clear) {
-    _z_lru_cache_node_data_t *node = cache->head;
-    while (node != NULL) {
-        _z_lru_cache_node_t *tmp = node;
-        _z_lru_cache_node_data_t *node_data = _z_lru_cache_node_data(node);
-        void *node_value = _z_lru_cache_node_value(node);
-        node = node_data->next;
-        clear(node_value);
-        z_free(tmp);
-    }
+// Hash index functions
+static inline size_t _z_lru_cache_bucket_idx(const _z_lru_cache_t *cache, size_t hash) {
+    return hash & (cache->bucket_count - 1);
 }
 
-// Sorted list function
-static _z_lru_cache_node_t *_z_lru_cache_search_slist(_z_lru_cache_t *cache, void *value, _z_lru_val_cmp_f compare,
-                                                      size_t *idx) {
-    int l_idx = 0;
-    int h_idx = (int)cache->len - 1;
-    while (l_idx <= h_idx) {
-        int curr_idx = (l_idx + h_idx) / 2;
-        int res = compare(_z_lru_cache_node_value(cache->slist[curr_idx]), value);
-        if (res == 0) {
-            *idx = (size_t)curr_idx;
-            return cache->slist[curr_idx];
-        } else if (res < 0) {
-            l_idx = curr_idx + 1;
-        } else {
-            h_idx = curr_idx - 1;
-        }
+static z_result_t _z_lru_cache_alloc_buckets(_z_lru_cache_t *cache) {
+    size_t bucket_count = 1;
+    while (bucket_count < cache->capacity) {
+        bucket_count <<= 1;
     }
-    return NULL;
-}
-
-static int _z_lru_cache_find_position(_z_lru_cache_node_t **slist, _z_lru_val_cmp_f compare, void *node_val,
-                                      size_t slist_size) {
-    int start = 0;
-    int end = (int)slist_size - 1;
-    while (start <= end) {
-        int mid = start + (end - start) / 2;
-        if (compare(_z_lru_cache_node_value(slist[mid]), node_val) < 0) {
-            start = mid + 1;
-        } else {
-            end = mid - 1;
-        }
+    cache->buckets = (_z_lru_cache_node_t **)z_malloc(bucket_count * sizeof(_z_lru_cache_node_t *));
+    if (cache->buckets == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
-    return start;
+    memset(cache->buckets, 0, bucket_count * sizeof(_z_lru_cache_node_t *));
+    cache->bucket_count = bucket_count;
+    return _Z_RES_OK;
 }
 
-static void _z_lru_cache_move_elem_slist(_z_lru_cache_t *cache, size_t *add_idx_addr, size_t *del_idx_addr) {
-    size_t del_idx = (del_idx_addr == NULL) ? cache->len : *del_idx_addr;
-    size_t add_idx = *add_idx_addr;
-    if (add_idx == del_idx) {
-        return;
-    }
-    // Move elements between the indices on the right
-    if (del_idx >= add_idx) {
-        memmove(&cache->slist[add_idx + 1], &cache->slist[add_idx],
-                (del_idx - add_idx) * sizeof(_z_lru_cache_node_t *));
-    } else {  // Move them on the left
-        // Rightmost value doesn't move unless we have a new maximum
-        if (add_idx != cache->capacity - 1) {
-            *add_idx_addr -= 1;
-            add_idx -= 1;
-        }
-        memmove(&cache->slist[del_idx], &cache->slist[del_idx + 1],
-                (add_idx - del_idx) * sizeof(_z_lru_cache_node_t *));
-    }
+static void _z_lru_cache_insert_bucket_node(_z_lru_cache_t *cache, _z_lru_cache_node_t *node) {
+    _z_lru_cache_node_data_t *node_data = _z_lru_cache_node_data(node);
+    size_t idx = _z_lru_cache_bucket_idx(cache, node_data->hash);
+    node_data->bucket_next = cache->buckets[idx];
+    cache->buckets[idx] = node;
 }
 
-static void _z_lru_cache_insert_slist(_z_lru_cache_t *cache, _z_lru_cache_node_t *node, _z_lru_val_cmp_f compare,
-                                      size_t *del_idx) {
-    // Find insert position:
-    if (cache->len == 0) {
-        cache->slist[0] = node;
-        return;
+static void _z_lru_cache_remove_bucket_node(_z_lru_cache_t *cache, _z_lru_cache_node_t *node) {
+    _z_lru_cache_node_data_t *node_data = _z_lru_cache_node_data(node);
+    _z_lru_cache_node_t **curr = &cache->buckets[_z_lru_cache_bucket_idx(cache, node_data->hash)];
+    while (*curr != node) {
+        assert(*curr != NULL);
+        curr = &_z_lru_cache_node_data(*curr)->bucket_next;
     }
-    void *node_val = _z_lru_cache_node_value(node);
-    size_t pos = (size_t)_z_lru_cache_find_position(cache->slist, compare, node_val, cache->len);
-    // Move elements
-    _z_lru_cache_move_elem_slist(cache, &pos, del_idx);
-    // Store element
-    cache->slist[pos] = node;
+    *curr = node_data->bucket_next;
+    node_data->bucket_next = NULL;
 }
 
-static size_t _z_lru_cache_delete_slist(_z_lru_cache_t *cache, _z_lru_cache_node_t *node, _z_lru_val_cmp_f compare) {
-    size_t del_idx = 0;
-    // Don't delete, return the index
-    (void)_z_lru_cache_search_slist(cache, _z_lru_cache_node_value(node), compare, &del_idx);
-    return del_idx;
+static _z_lru_cache_node_t *_z_lru_cache_search_node(_z_lru_cache_t *cache, void *value, size_t hash,
+                                                     _z_lru_val_cmp_f compare) {
+    if (cache->buckets == NULL) {
+        return NULL;
+    }
+    _z_lru_cache_node_t *node = cache->buckets[_z_lru_cache_bucket_idx(cache, hash)];
+    while (node != NULL) {
+        _z_lru_cache_node_data_t *node_data = _z_lru_cache_node_data(node);
+        if ((node_data->hash == hash) && (compare(_z_lru_cache_node_value(node), value) == 0)) {
+            return node;
+        }
+        node = node_data->bucket_next;
+    }
+    return NULL;
 }
 
 // Main static functions
-static _z_lru_cache_node_t *_z_lru_cache_detach_last(_z_lru_cache_t *cache, _z_lru_val_cmp_f compare, size_t *del_idx) {
-    _z_lru_cache_node_t *last = cache->tail;
-    assert(last != NULL);
-    _z_lru_cache_remove_list_node(cache, last);
-    *del_idx = _z_lru_cache_delete_slist(cache, last, compare);
+static void _z_lru_cache_detach_node(_z_lru_cache_t *cache, _z_lru_cache_node_t *node) {
+    _z_lru_cache_remove_list_node(cache, node);
+    _z_lru_cache_remove_bucket_node(cache, node);
     cache->len--;
-    return last;
-}
-
-static void _z_lru_cache_insert_node(_z_lru_cache_t *cache, _z_lru_cache_node_t *node, _z_lru_val_cmp_f compare,
-                                     size_t *del_idx) {
-    _z_lru_cache_insert_list_node(cache, node);
-    _z_lru_cache_insert_slist(cache, node, compare, del_idx);
-    cache->len++;
 }
 
-static _z_lru_cache_node_t *_z_lru_cache_search_node(_z_lru_cache_t *cache, void *value, _z_lru_val_cmp_f compare) {
-    size_t idx = 0;
-    return _z_lru_cache_search_slist(cache, value, compare, &idx);
+static void _z_lru_cache_evict(_z_lru_cache_t *cache, size_t len, z_element_clear_f clear) {
+    while (cache->len > len) {
+        _z_lru_cache_node_t *last = cache->tail;
+        _z_lru_cache_detach_node(cache, last);
+        _z_lru_cache_node_delete(last, clear);
+    }
 }
 
 // Public functions
@@ -221,9 +179,9 @@ _z_lru_cache_t _z_lru_cache_init(size_t capacity) {
     return cache;
 }
 
-void *_z_lru_cache_get(_z_lru_cache_t *cache, void *value, _z_lru_val_cmp_f compare) {
+void *_z_lru_cache_get(_z_lru_cache_t *cache, void *value, _z_lru_val_hash_f hash, _z_lru_val_cmp_f compare) {
     // Lookup if node exists.
-    _z_lru_cache_node_t *node = _z_lru_cache_search_node(cache, value, compare);
+    _z_lru_cache_node_t *node = _z_lru_cache_search_node(cache, value, hash(value), compare);
     if (node == NULL) {
         return NULL;
     }
@@ -232,47 +190,76 @@ void *_z_lru_cache_get(_z_lru_cache_t *cache, void *value, _z_lru_val_cmp_f comp
     return _z_lru_cache_node_value(node);
 }
 
-z_result_t _z_lru_cache_insert(_z_lru_cache_t *cache, void *value, size_t value_size, _z_lru_val_cmp_f compare,
+z_result_t _z_lru_cache_insert(_z_lru_cache_t *cache, void *value, size_t value_size, _z_lru_val_hash_f hash,
                                z_element_clear_f clear) {
-    assert(cache->capacity > 0);
-    // Init slist
-    if (cache->slist == NULL) {
-        cache->slist = (_z_lru_cache_node_t **)z_malloc(cache->capacity * sizeof(void *));
-        if (cache->slist == NULL) {
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
-        memset(cache->slist, 0, cache->capacity * sizeof(void *));
+    if (cache->capacity == 0) {
+        clear(value);
+        return _Z_RES_OK;
+    }
+    if (cache->buckets == NULL) {
+        _Z_RETURN_IF_ERR(_z_lru_cache_alloc_buckets(cache));
     }
     // Create node
-    _z_lru_cache_node_t *node = _z_lru_cache_node_create(value, value_size);
-    size_t *del_idx_addr = NULL;
-    size_t del_idx = 0;
-    _z_lru_cache_node_t *deleted = NULL;
+    _z_lru_cache_node_t *node = _z_lru_cache_node_create(value, value_size, hash(value));
     if (node == NULL) {
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
-    // Check capacity
-    if (cache->len == cache->capacity) {
-        // Detach the LRU entry, but keep its value valid until the sorted list has been updated.
-        deleted = _z_lru_cache_detach_last(cache, compare, &del_idx);
-        del_idx_addr = &del_idx;
-    }
+    // Make room for it
+    _z_lru_cache_evict(cache, cache->capacity - 1, clear);
     // Update the cache
-    _z_lru_cache_insert_node(cache, node, compare, del_idx_addr);
-    if (deleted != NULL) {
-        clear(_z_lru_cache_node_value(deleted));
-        z_free(deleted);
-    }
+    _z_lru_cache_insert_list_node(cache, node);
+    _z_lru_cache_insert_bucket_node(cache, node);
+    cache->len++;
     return _Z_RES_OK;
 }
 
+size_t _z_lru_cache_remove_if(_z_lru_cache_t *cache, _z_lru_val_pred_f pred, const void *arg, z_element_clear_f clear) {
+    size_t removed = 0;
+    _z_lru_cache_node_t *node = cache->head;
+    while (node != NULL) {
+        _z_lru_cache_node_t *next = _z_lru_cache_node_data(node)->next;
+        if (pred(_z_lru_cache_node_value(node), arg)) {
+            _z_lru_cache_detach_node(cache, node);
+            _z_lru_cache_node_delete(node, clear);
+            removed++;
+        }
+        node = next;
+    }
+    return removed;
+}
+
+void _z_lru_cache_resize(_z_lru_cache_t *cache, size_t capacity, z_element_clear_f clear) {
+    if (capacity == cache->capacity) {
+        return;
+    }
+    _z_lru_cache_evict(cache, capacity, clear);
+    cache->capacity = capacity;
+    // Re-index the remaining nodes
+    z_free(cache->buckets);
+    cache->buckets = NULL;
+    cache->bucket_count = 0;
+    if ((cache->len > 0) && (_z_lru_cache_alloc_buckets(cache) != _Z_RES_OK)) {
+        _Z_WARN("Failed to re-index the cache, it is emptied");
+        _z_lru_cache_clear(cache, clear);
+        return;
+    }
+    for (_z_lru_cache_node_t *node = cache->head; node != NULL; node = _z_lru_cache_node_data(node)->next) {
+        _z_lru_cache_insert_bucket_node(cache, node);
+    }
+}
+
 void _z_lru_cache_clear(_z_lru_cache_t *cache, z_element_clear_f clear) {
-    // Reset slist
-    if (cache->slist != NULL) {
-        memset(cache->slist, 0, cache->capacity * sizeof(void *));
+    // Reset index
+    if (cache->buckets != NULL) {
+        memset(cache->buckets, 0, cache->bucket_count * sizeof(_z_lru_cache_node_t *));
     }
     // Clear list
-    _z_lru_cache_clear_list(cache, clear);
+    _z_lru_cache_node_t *node = cache->head;
+    while (node != NULL) {
+        _z_lru_cache_node_t *next = _z_lru_cache_node_data(node)->next;
+        _z_lru_cache_node_delete(node, clear);
+        node = next;
+    }
     // Reset cache
     cache->len = 0;
     cache->head = NULL;
@@ -281,6 +268,7 @@ void _z_lru_cache_clear(_z_lru_cache_t *cache, z_element_clear_f clear) {
 
 void _z_lru_cache_delete(_z_lru_cache_t *cache, z_element_clear_f clear) {
     _z_lru_cache_clear(cache, clear);
-    z_free(cache->slist);
-    cache->slist = NULL;
+    z_free(cache->buckets);
+    cache->buckets = NULL;
+    cache->bucket_count = 0;
 }
@@ -33,6 +33,14 @@ z_result_t _z_open_socket(const _z_string_t *locator, const _z_config_t *session
 #if Z_FEATURE_LINK_TLS == 1
     } else if (_z_endpoint_tls_valid(&ep) == _Z_RES_OK) {
         ret = _z_new_peer_tls(&ep, socket, session_cfg);
+#endif
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
+    } else if (_z_endpoint_unixsock_stream_valid(&ep) == _Z_RES_OK) {
+        ret = _z_new_peer_unixsock_stream(&ep, socket);
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+    } else if (_z_endpoint_shm_ring_valid(&ep) == _Z_RES_OK) {
+        ret = _z_new_peer_shm_ring(&ep, socket);
 #endif
     } else {
         _Z_ERROR_LOG(_Z_ERR_CONFIG_LOCATOR_SCHEMA_UNKNOWN);
@@ -79,6 +87,16 @@ z_result_t _z_open_link(_z_link_t *zl, const _z_string_t *locator, const _z_conf
             if (_z_endpoint_tls_valid(&ep) == _Z_RES_OK) {
             ret = _z_new_link_tls(zl, &ep, session_cfg);
         } else
+#endif
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
+            if (_z_endpoint_unixsock_stream_valid(&ep) == _Z_RES_OK) {
+            ret = _z_new_link_unixsock_stream(zl, &ep);
+        } else
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+            if (_z_endpoint_shm_ring_valid(&ep) == _Z_RES_OK) {
+            ret = _z_new_link_shm_ring(zl, &ep);
+        } else
 #endif
         {
             _Z_ERROR_LOG(_Z_ERR_CONFIG_LOCATOR_SCHEMA_UNKNOWN);
@@ -121,6 +139,16 @@ z_result_t _z_listen_link(_z_link_t *zl, const _z_string_t *locator, const _z_co
             ret = _z_new_link_tls(zl, &ep, session_cfg);
         } else
 #endif
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
+            if (_z_endpoint_unixsock_stream_valid(&ep) == _Z_RES_OK) {
+            ret = _z_new_link_unixsock_stream(zl, &ep);
+        } else
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+            if (_z_endpoint_shm_ring_valid(&ep) == _Z_RES_OK) {
+            ret = _z_new_link_shm_ring(zl, &ep);
+        } else
+#endif
 #if Z_FEATURE_LINK_UDP_MULTICAST == 1
             if (_z_endpoint_udp_multicast_valid(&ep) == _Z_RES_OK) {
             ret = _z_new_link_udp_multicast(zl, ep);
@@ -203,6 +231,18 @@ size_t _z_link_socket_recv_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, const _z_
 }
 
 z_result_t _z_link_send_wbuf(const _z_link_t *link, const _z_wbuf_t *wbf, _z_sys_net_socket_t *socket) {
+    _Z_RETURN_IF_ERR(_z_link_write_wbuf(link, wbf, socket));
+    return _z_link_flush(link, socket);
+}
+
+z_result_t _z_link_flush(const _z_link_t *link, _z_sys_net_socket_t *socket) {
+    if (link->_flush_f == NULL) {
+        return _Z_RES_OK;
+    }
+    return link->_flush_f(link, socket);
+}
+
+z_result_t _z_link_write_wbuf(const _z_link_t *link, const _z_wbuf_t *wbf, _z_sys_net_socket_t *socket) {
     z_result_t ret = _Z_RES_OK;
     bool link_is_streamed = link->_cap._flow == Z_LINK_CAP_FLOW_STREAM;
 
@@ -229,6 +269,32 @@ z_result_t _z_link_send_wbuf(const _z_link_t *link, const _z_wbuf_t *wbf, _z_sys
     return ret;
 }
 
+#if Z_FEATURE_IO_URING == 1
+bool _z_link_supports_uring(const _z_link_t *link) {
+    switch (link->_type) {
+#if Z_FEATURE_LINK_TCP == 1
+        case _Z_LINK_TYPE_TCP:
+            return true;
+#endif
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
+        case _Z_LINK_TYPE_UNIXSOCK_STREAM:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+z_result_t _z_link_send_wbuf_uring(const _z_wbuf_t *wbf, _z_socket_uring_t *ring, _z_socket_wait_iter_t *iter) {
+    // Transport buffers are never expandable, a single slice holds the whole batch
+    if (_z_wbuf_len_iosli(wbf) != 1) {
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    _z_slice_t bs = _z_iosli_to_bytes(_z_wbuf_get_iosli(wbf, 0));
+    return _z_socket_uring_send_all(ring, iter, bs.start, bs.len);
+}
+#endif
+
 const _z_sys_net_socket_t *_z_link_get_socket(const _z_link_t *link) {
     switch (link->_type) {
 #if Z_FEATURE_LINK_TCP == 1
@@ -258,6 +324,14 @@ const _z_sys_net_socket_t *_z_link_get_socket(const _z_link_t *link) {
 #if Z_FEATURE_RAWETH_TRANSPORT == 1
         case _Z_LINK_TYPE_RAWETH:
             return &link->_socket._raweth._sock;
+#endif
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
+        case _Z_LINK_TYPE_UNIXSOCK_STREAM:
+            return &link->_socket._unixsock._sock;
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+        case _Z_LINK_TYPE_SHM_RING:
+            return &link->_socket._shm._sock;
 #endif
         default:
             _Z_INFO("Unknown link type");
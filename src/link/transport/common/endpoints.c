@@ -74,6 +74,10 @@ z_result_t _z_socket_get_endpoints(const _z_sys_net_socket_t *sock, char *local,
 #else
 #include <netinet/in.h>
 #include <sys/socket.h>
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
+#include <stdio.h>
+#include <sys/un.h>
+#endif
 #endif
 
 #include "zenoh-pico/link/transport/socket.h"
@@ -89,6 +93,16 @@ static z_result_t _z_sockaddr_to_endpoint(const struct sockaddr *addr, char *dst
         const struct sockaddr_in6 *addr6 = (const struct sockaddr_in6 *)addr;
         const uint8_t *bytes = (const uint8_t *)&addr6->sin6_addr;
         return _z_ip_port_to_endpoint(bytes, sizeof(addr6->sin6_addr), ntohs(addr6->sin6_port), dst, dst_len);
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1 && !defined(ZENOH_ZEPHYR)
+    } else if (addr->sa_family == AF_UNIX) {
+        // The connecting side of a unix socket is usually unnamed, its address is then empty
+        const struct sockaddr_un *addr_un = (const struct sockaddr_un *)addr;
+        int written = snprintf(dst, dst_len, "%.*s", (int)sizeof(addr_un->sun_path), addr_un->sun_path);
+        if ((written < 0) || ((size_t)written >= dst_len)) {
+            _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+        }
+        return _Z_RES_OK;
+#endif
     } else {
         _Z_ERROR_RETURN(_Z_ERR_INVALID);
     }
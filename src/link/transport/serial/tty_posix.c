@@ -49,6 +49,54 @@ static speed_t _z_posix_tty_baudrate_to_speed(uint32_t baudrate) {
 #ifdef B230400
         case 230400:
             return B230400;
+#endif
+#ifdef B460800
+        case 460800:
+            return B460800;
+#endif
+#ifdef B500000
+        case 500000:
+            return B500000;
+#endif
+#ifdef B576000
+        case 576000:
+            return B576000;
+#endif
+#ifdef B921600
+        case 921600:
+            return B921600;
+#endif
+#ifdef B1000000
+        case 1000000:
+            return B1000000;
+#endif
+#ifdef B1152000
+        case 1152000:
+            return B1152000;
+#endif
+#ifdef B1500000
+        case 1500000:
+            return B1500000;
+#endif
+#ifdef B2000000
+        case 2000000:
+            return B2000000;
+#endif
+#ifdef B2500000
+        case 2500000:
+            return B2500000;
+#endif
+#ifdef B3000000
+        case 3000000:
+            return B3000000;
+#endif
+#ifdef B3500000
+        case 3500000:
+            return B3500000;
+#endif
+#ifdef B4000000
+        case 4000000:
+            return B4000000;
 #endif
         default:
             return (speed_t)0;
@@ -0,0 +1,547 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// memfd_create and accept4
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zenoh-pico/link/transport/shm_ring.h"
+
+#include "zenoh-pico/config.h"
+
+#if defined(ZENOH_LINUX) && Z_FEATURE_LINK_SHM_RING == 1
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "zenoh-pico/collections/atomic.h"
+#include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
+
+#define _Z_SHM_RING_MAGIC 0x7a70736872696e67ULL  // "zpshring"
+#define _Z_SHM_RING_VERSION 1
+#define _Z_SHM_RING_CACHE_LINE 64
+#define _Z_SHM_RING_MAX_BACKOFF_US 1000
+#define _Z_SHM_RING_FD_NB 3
+
+// Positions only ever grow, the ring index is the position modulo the capacity
+typedef struct {
+    _z_atomic_size_t _tail;  // Written by the producer
+    uint8_t _pad0[_Z_SHM_RING_CACHE_LINE - sizeof(_z_atomic_size_t)];
+    _z_atomic_size_t _head;  // Written by the consumer
+    uint8_t _pad1[_Z_SHM_RING_CACHE_LINE - sizeof(_z_atomic_size_t)];
+    _z_atomic_bool_t _closed;  // Set by the producer once it stops writing
+    uint8_t _pad2[_Z_SHM_RING_CACHE_LINE - sizeof(_z_atomic_bool_t)];
+} _z_shm_ring_ctrl_t;
+
+// Direction 0 goes from the listener to the connector, direction 1 the other way, the data areas follow the header
+typedef struct {
+    uint64_t _magic;
+    uint32_t _version;
+    uint32_t _word_size;
+    uint64_t _capacity;
+    uint8_t _pad[_Z_SHM_RING_CACHE_LINE - 3 * sizeof(uint64_t)];
+    _z_shm_ring_ctrl_t _ctrl[2];
+} _z_shm_ring_header_t;
+
+typedef struct {
+    _z_shm_ring_header_t *_map;
+    size_t _map_len;
+    size_t _capacity;
+    _z_shm_ring_ctrl_t *_rx;
+    _z_shm_ring_ctrl_t *_tx;
+    uint8_t *_rx_data;
+    uint8_t *_tx_data;
+    int _tx_efd;
+    uint32_t _tout;
+} _z_shm_ring_t;
+
+static size_t _z_shm_ring_map_len(size_t capacity) { return sizeof(_z_shm_ring_header_t) + 2 * capacity; }
+
+static z_result_t _z_shm_ring_sockaddr_init(struct sockaddr_un *addr, const char *path) {
+    size_t len = strlen(path);
+    if ((len == 0) || (len >= sizeof(addr->sun_path))) {
+        _Z_ERROR_RETURN(_Z_ERR_CONFIG_LOCATOR_INVALID);
+    }
+    (void)memset(addr, 0, sizeof(struct sockaddr_un));
+    addr->sun_family = AF_UNIX;
+    (void)memcpy(addr->sun_path, path, len);
+    return _Z_RES_OK;
+}
+
+// A socket file left behind by a listener that did not close cleanly refuses connections
+static bool _z_shm_ring_is_stale(const struct sockaddr_un *addr) {
+    struct stat st;
+    if ((lstat(addr->sun_path, &st) != 0) || !S_ISSOCK(st.st_mode)) {
+        return false;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        return false;
+    }
+    bool stale =
+        (connect(fd, (const struct sockaddr *)addr, sizeof(struct sockaddr_un)) < 0) && (errno == ECONNREFUSED);
+    close(fd);
+    return stale;
+}
+
+static void _z_shm_ring_signal(int efd) {
+    uint64_t one = 1;
+    // Only fails when the counter would overflow, in which case the reader is woken up anyway
+    (void)write(efd, &one, sizeof(one));
+}
+
+static bool _z_shm_ring_is_blocking(int efd) {
+    int flags = fcntl(efd, F_GETFL, 0);
+    return (flags != -1) && ((flags & O_NONBLOCK) == 0);
+}
+
+static void _z_shm_ring_drain(int efd) {
+    uint64_t count;
+    if (_z_shm_ring_is_blocking(efd)) {
+        struct pollfd pfd = {.fd = efd, .events = POLLIN, .revents = 0};
+        if (poll(&pfd, 1, 0) <= 0) {
+            return;
+        }
+    }
+    (void)read(efd, &count, sizeof(count));
+}
+
+static z_result_t _z_shm_ring_attach(_z_sys_net_socket_t *sock, _z_shm_ring_header_t *map, size_t map_len,
+                                     bool is_listener, int rx_efd, int tx_efd, uint32_t tout) {
+    _z_shm_ring_t *ring = (_z_shm_ring_t *)z_malloc(sizeof(_z_shm_ring_t));
+    if (ring == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    size_t rx_dir = is_listener ? 1 : 0;
+    size_t tx_dir = is_listener ? 0 : 1;
+    uint8_t *data = _z_ptr_u8_offset((uint8_t *)map, (ptrdiff_t)sizeof(_z_shm_ring_header_t));
+    ring->_map = map;
+    ring->_map_len = map_len;
+    ring->_capacity = (size_t)map->_capacity;
+    ring->_rx = &map->_ctrl[rx_dir];
+    ring->_tx = &map->_ctrl[tx_dir];
+    ring->_rx_data = _z_ptr_u8_offset(data, (ptrdiff_t)(rx_dir * ring->_capacity));
+    ring->_tx_data = _z_ptr_u8_offset(data, (ptrdiff_t)(tx_dir * ring->_capacity));
+    ring->_tx_efd = tx_efd;
+    ring->_tout = tout;
+    sock->_fd = rx_efd;
+    sock->_shm_ring = ring;
+    return _Z_RES_OK;
+}
+
+z_result_t _z_shm_ring_address_valid(const _z_string_t *address) {
+    struct sockaddr_un addr;
+    size_t len = _z_string_len(address);
+    if ((len == 0) || (len >= sizeof(addr.sun_path)) || (memchr(_z_string_data(address), '\0', len) != NULL)) {
+        _Z_ERROR_RETURN(_Z_ERR_CONFIG_LOCATOR_INVALID);
+    }
+    return _Z_RES_OK;
+}
+
+static z_result_t _z_shm_ring_recv_fds(int fd, int fds[_Z_SHM_RING_FD_NB]) {
+    uint8_t byte = 0;
+    struct iovec iov = {.iov_base = &byte, .iov_len = sizeof(byte)};
+    union {
+        struct cmsghdr align;
+        uint8_t buf[CMSG_SPACE(_Z_SHM_RING_FD_NB * sizeof(int))];
+    } ctrl;
+    struct msghdr msg;
+    (void)memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl.buf;
+    msg.msg_controllen = sizeof(ctrl.buf);
+    if (recvmsg(fd, &msg, MSG_CMSG_CLOEXEC) <= 0) {
+        _Z_DEBUG("recvmsg() failed: %s", strerror(errno));
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if ((cmsg == NULL) || (cmsg->cmsg_level != SOL_SOCKET) || (cmsg->cmsg_type != SCM_RIGHTS) ||
+        (cmsg->cmsg_len != CMSG_LEN(_Z_SHM_RING_FD_NB * sizeof(int))) || ((msg.msg_flags & MSG_CTRUNC) != 0)) {
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    (void)memcpy(fds, CMSG_DATA(cmsg), _Z_SHM_RING_FD_NB * sizeof(int));
+    return _Z_RES_OK;
+}
+
+static z_result_t _z_shm_ring_send_fds(int fd, const int fds[_Z_SHM_RING_FD_NB]) {
+    uint8_t byte = 0;
+    struct iovec iov = {.iov_base = &byte, .iov_len = sizeof(byte)};
+    union {
+        struct cmsghdr align;
+        uint8_t buf[CMSG_SPACE(_Z_SHM_RING_FD_NB * sizeof(int))];
+    } ctrl;
+    (void)memset(&ctrl, 0, sizeof(ctrl));
+    struct msghdr msg;
+    (void)memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl.buf;
+    msg.msg_controllen = sizeof(ctrl.buf);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(_Z_SHM_RING_FD_NB * sizeof(int));
+    (void)memcpy(CMSG_DATA(cmsg), fds, _Z_SHM_RING_FD_NB * sizeof(int));
+    if (sendmsg(fd, &msg, MSG_NOSIGNAL) != (ssize_t)sizeof(byte)) {
+        _Z_DEBUG("sendmsg() failed: %s", strerror(errno));
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    return _Z_RES_OK;
+}
+
+// The connector receives the mapping and its eventfds, then drops the rendezvous connection
+z_result_t _z_shm_ring_open(_z_sys_net_socket_t *sock, const char *path, uint32_t tout) {
+    sock->_fd = -1;
+    sock->_shm_ring = NULL;
+    struct sockaddr_un addr;
+    _Z_RETURN_IF_ERR(_z_shm_ring_sockaddr_init(&addr, path));
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    // The ring is handed over once the listener accepts, which takes as long as a handshake answer
+    z_time_t tv;
+    tv.tv_sec = (time_t)(Z_TRANSPORT_CONNECT_TIMEOUT / 1000);
+    tv.tv_usec = (suseconds_t)((Z_TRANSPORT_CONNECT_TIMEOUT % 1000) * 1000);
+    z_result_t ret = _Z_RES_OK;
+    int fds[_Z_SHM_RING_FD_NB] = {-1, -1, -1};
+    if ((setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (char *)&tv, sizeof(tv)) < 0) ||
+        (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)) {
+        _Z_DEBUG("connect() failed for %s: %s", path, strerror(errno));
+        _Z_ERROR_LOG(_Z_ERR_GENERIC);
+        ret = _Z_ERR_GENERIC;
+    } else {
+        ret = _z_shm_ring_recv_fds(fd, fds);
+    }
+    close(fd);
+    _Z_RETURN_IF_ERR(ret);
+
+    // fds[0] is the memory, fds[1] the eventfd we wait on, fds[2] the one of the listener
+    _z_shm_ring_header_t *map = MAP_FAILED;
+    size_t map_len = 0;
+    struct stat st;
+    if ((fstat(fds[0], &st) == 0) && ((size_t)st.st_size >= sizeof(_z_shm_ring_header_t))) {
+        map_len = (size_t)st.st_size;
+        map = (_z_shm_ring_header_t *)mmap(NULL, map_len, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+    }
+    close(fds[0]);
+    if (map == MAP_FAILED) {
+        _Z_ERROR_LOG(_Z_ERR_GENERIC);
+        ret = _Z_ERR_GENERIC;
+    } else if ((map->_magic != _Z_SHM_RING_MAGIC) || (map->_version != _Z_SHM_RING_VERSION) ||
+               (map->_word_size != (uint32_t)sizeof(size_t)) || (map->_capacity == 0) ||
+               ((map->_capacity & (map->_capacity - 1)) != 0) ||
+               (_z_shm_ring_map_len((size_t)map->_capacity) > map_len)) {
+        _Z_DEBUG("Incompatible shared memory ring behind %s", path);
+        _Z_ERROR_LOG(_Z_ERR_GENERIC);
+        ret = _Z_ERR_GENERIC;
+    } else {
+        ret = _z_shm_ring_attach(sock, map, map_len, false, fds[1], fds[2], tout);
+    }
+    if (ret != _Z_RES_OK) {
+        if (map != MAP_FAILED) {
+            munmap(map, map_len);
+        }
+        close(fds[1]);
+        close(fds[2]);
+    }
+    return ret;
+}
+
+z_result_t _z_shm_ring_listen(_z_sys_net_socket_t *sock, const char *path) {
+    sock->_shm_ring = NULL;
+    struct sockaddr_un addr;
+    _Z_RETURN_IF_ERR(_z_shm_ring_sockaddr_init(&addr, path));
+
+    sock->_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock->_fd == -1) {
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    z_result_t ret = _Z_RES_OK;
+    if (bind(sock->_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        if ((errno == EADDRINUSE) && _z_shm_ring_is_stale(&addr)) {
+            _Z_DEBUG("Removing stale socket file %s", path);
+            (void)unlink(path);
+            if (bind(sock->_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+                ret = _Z_ERR_GENERIC;
+            }
+        } else {
+            ret = _Z_ERR_GENERIC;
+        }
+    }
+    if (ret != _Z_RES_OK) {
+        _Z_DEBUG("bind() failed for %s: %s", path, strerror(errno));
+        _Z_ERROR_LOG(ret);
+    } else if (listen(sock->_fd, Z_LISTEN_MAX_CONNECTION_NB) < 0) {
+        _Z_DEBUG("listen() failed for %s: %s", path, strerror(errno));
+        _Z_ERROR_LOG(_Z_ERR_GENERIC);
+        (void)unlink(path);
+        ret = _Z_ERR_GENERIC;
+    }
+    if (ret != _Z_RES_OK) {
+        close(sock->_fd);
+        sock->_fd = -1;
+    }
+    return ret;
+}
+
+// The listener allocates the rings of every accepted connection and hands them over to the connector
+z_result_t _z_shm_ring_accept(const _z_sys_net_socket_t *sock_in, _z_sys_net_socket_t *sock_out) {
+    sock_out->_fd = -1;
+    sock_out->_shm_ring = NULL;
+    int con_socket = accept4(sock_in->_fd, NULL, NULL, SOCK_CLOEXEC);
+    if (con_socket < 0) {
+        if (errno == EBADF) {
+            _Z_ERROR_RETURN(_Z_ERR_INVALID);
+        } else {
+            _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+        }
+    }
+
+    size_t map_len = _z_shm_ring_map_len(_Z_SHM_RING_CAPACITY);
+    _z_shm_ring_header_t *map = MAP_FAILED;
+    int fds[_Z_SHM_RING_FD_NB] = {-1, -1, -1};
+    fds[0] = memfd_create("zenoh-pico-shm-ring", MFD_CLOEXEC);
+    if ((fds[0] != -1) && (ftruncate(fds[0], (off_t)map_len) == 0)) {
+        map = (_z_shm_ring_header_t *)mmap(NULL, map_len, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+    }
+    fds[1] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    fds[2] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    z_result_t ret = _Z_RES_OK;
+    if ((map == MAP_FAILED) || (fds[1] == -1) || (fds[2] == -1)) {
+        _Z_DEBUG("Failed to allocate a shared memory ring: %s", strerror(errno));
+        _Z_ERROR_LOG(_Z_ERR_GENERIC);
+        ret = _Z_ERR_GENERIC;
+    } else {
+        // The memory comes zeroed, which is the initial state of both rings
+        map->_magic = _Z_SHM_RING_MAGIC;
+        map->_version = _Z_SHM_RING_VERSION;
+        map->_word_size = (uint32_t)sizeof(size_t);
+        map->_capacity = (uint64_t)_Z_SHM_RING_CAPACITY;
+        ret = _z_shm_ring_send_fds(con_socket, fds);
+    }
+    close(con_socket);
+    if (fds[0] != -1) {
+        close(fds[0]);
+    }
+    _Z_SET_IF_OK(ret, _z_shm_ring_attach(sock_out, map, map_len, true, fds[2], fds[1], Z_CONFIG_SOCKET_TIMEOUT));
+    if (ret != _Z_RES_OK) {
+        if (map != MAP_FAILED) {
+            munmap(map, map_len);
+        }
+        if (fds[1] != -1) {
+            close(fds[1]);
+        }
+        if (fds[2] != -1) {
+            close(fds[2]);
+        }
+    }
+    return ret;
+}
+
+void _z_close_shm_ring_socket(_z_sys_net_socket_t *sock) {
+    if ((sock == NULL) || (sock->_shm_ring == NULL)) {
+        return;
+    }
+    _z_shm_ring_t *ring = (_z_shm_ring_t *)sock->_shm_ring;
+    _z_atomic_bool_store(&ring->_tx->_closed, true, _z_memory_order_seq_cst);
+    _z_shm_ring_signal(ring->_tx_efd);
+    munmap(ring->_map, ring->_map_len);
+    close(ring->_tx_efd);
+    z_free(ring);
+    sock->_shm_ring = NULL;
+}
+
+void _z_shm_ring_close(_z_sys_net_socket_t *sock) {
+    _z_close_shm_ring_socket(sock);
+    if (sock->_fd >= 0) {
+        close(sock->_fd);
+        sock->_fd = -1;
+    }
+}
+
+void _z_shm_ring_unlink(const char *path) {
+    if (path != NULL) {
+        (void)unlink(path);
+    }
+}
+
+// Returns SIZE_MAX if the indexes written by the other process are inconsistent, the link is then broken
+static size_t _z_shm_ring_pop(_z_shm_ring_t *ring, uint8_t *ptr, size_t len) {
+    size_t head = _z_atomic_size_load(&ring->_rx->_head, _z_memory_order_relaxed);
+    size_t tail = _z_atomic_size_load(&ring->_rx->_tail, _z_memory_order_acquire);
+    size_t n = tail - head;
+    if (n > ring->_capacity) {
+        _Z_ERROR("Shared memory ring holds %zu bytes for a capacity of %zu", n, ring->_capacity);
+        return SIZE_MAX;
+    }
+    if (n > len) {
+        n = len;
+    }
+    if (n == 0) {
+        return 0;
+    }
+    size_t off = head & (ring->_capacity - 1);
+    size_t first = (n < ring->_capacity - off) ? n : ring->_capacity - off;
+    (void)memcpy(ptr, &ring->_rx_data[off], first);
+    (void)memcpy(&ptr[first], ring->_rx_data, n - first);
+    _z_atomic_size_store(&ring->_rx->_head, head + n, _z_memory_order_seq_cst);
+    return n;
+}
+
+static bool _z_shm_ring_rx_empty(_z_shm_ring_t *ring) {
+    return _z_atomic_size_load(&ring->_rx->_tail, _z_memory_order_seq_cst) ==
+           _z_atomic_size_load(&ring->_rx->_head, _z_memory_order_relaxed);
+}
+
+/**
+ * Called once the ring was found empty. The eventfd is drained before looking at the ring again, so a writer that
+ * publishes afterwards finds it empty and signals. Returns 0 once the other side closed and everything was read.
+ */
+static size_t _z_shm_ring_wait_pop(_z_sys_net_socket_t sock, _z_shm_ring_t *ring, uint8_t *ptr, size_t len) {
+    bool blocking = _z_shm_ring_is_blocking(sock._fd);
+    z_clock_t start = z_clock_now();
+    while (true) {
+        bool closed = _z_atomic_bool_load(&ring->_rx->_closed, _z_memory_order_seq_cst);
+        _z_shm_ring_drain(sock._fd);
+        size_t n = _z_shm_ring_pop(ring, ptr, len);
+        if (n != 0) {
+            return n;
+        }
+        if (closed) {
+            return 0;
+        }
+        unsigned long elapsed = z_clock_elapsed_ms(&start);
+        if (!blocking || (elapsed >= ring->_tout)) {
+            // Reported as a socket with nothing to read
+            errno = EAGAIN;
+            return SIZE_MAX;
+        }
+        struct pollfd pfd = {.fd = sock._fd, .events = POLLIN, .revents = 0};
+        if ((poll(&pfd, 1, (int)(ring->_tout - elapsed)) < 0) && (errno != EINTR)) {
+            return SIZE_MAX;
+        }
+    }
+}
+
+size_t _z_shm_ring_read(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len) {
+    _z_shm_ring_t *ring = (_z_shm_ring_t *)sock._shm_ring;
+    if (ring == NULL) {
+        return SIZE_MAX;
+    }
+    size_t n = _z_shm_ring_pop(ring, ptr, len);
+    if (n == SIZE_MAX) {
+        return SIZE_MAX;
+    }
+    bool drained = false;
+    if (n == 0) {
+        n = _z_shm_ring_wait_pop(sock, ring, ptr, len);
+        if ((n == 0) || (n == SIZE_MAX)) {
+            return n;
+        }
+        drained = true;
+    }
+    if (_z_shm_ring_rx_empty(ring)) {
+        _z_shm_ring_drain(sock._fd);
+        drained = true;
+    }
+    // Keep the eventfd readable as long as data is left or the other side closed, the socket is only waited on
+    // through it and the drain may have taken the close signal
+    if (drained &&
+        (!_z_shm_ring_rx_empty(ring) || _z_atomic_bool_load(&ring->_rx->_closed, _z_memory_order_seq_cst))) {
+        _z_shm_ring_signal(sock._fd);
+    }
+    return n;
+}
+
+size_t _z_shm_ring_read_exact(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len) {
+    size_t n = 0;
+    uint8_t *pos = &ptr[0];
+
+    do {
+        size_t rb = _z_shm_ring_read(sock, pos, len - n);
+        if ((rb == SIZE_MAX) || (rb == 0)) {
+            n = rb;
+            break;
+        }
+
+        n += rb;
+        pos = _z_ptr_u8_offset(pos, (ptrdiff_t)rb);
+    } while (n != len);
+
+    return n;
+}
+
+// Copies the whole buffer, waiting with a growing backoff while the ring is full
+size_t _z_shm_ring_write(_z_sys_net_socket_t sock, const uint8_t *ptr, size_t len) {
+    _z_shm_ring_t *ring = (_z_shm_ring_t *)sock._shm_ring;
+    if (ring == NULL) {
+        return SIZE_MAX;
+    }
+    size_t done = 0;
+    size_t backoff_us = 0;
+    z_clock_t start = {0};
+    while (done < len) {
+        if (_z_atomic_bool_load(&ring->_rx->_closed, _z_memory_order_acquire)) {
+            // The other side is gone
+            return SIZE_MAX;
+        }
+        size_t tail = _z_atomic_size_load(&ring->_tx->_tail, _z_memory_order_relaxed);
+        size_t head = _z_atomic_size_load(&ring->_tx->_head, _z_memory_order_acquire);
+        size_t space = ring->_capacity - (tail - head);
+        if (space == 0) {
+            if (backoff_us == 0) {
+                start = z_clock_now();
+                backoff_us = 1;
+            } else if (z_clock_elapsed_ms(&start) >= ring->_tout) {
+                return SIZE_MAX;
+            } else if (backoff_us < _Z_SHM_RING_MAX_BACKOFF_US) {
+                backoff_us *= 2;
+            }
+            z_sleep_us(backoff_us);
+            continue;
+        }
+        size_t n = (len - done < space) ? len - done : space;
+        size_t off = tail & (ring->_capacity - 1);
+        size_t first = (n < ring->_capacity - off) ? n : ring->_capacity - off;
+        (void)memcpy(&ring->_tx_data[off], &ptr[done], first);
+        (void)memcpy(ring->_tx_data, &ptr[done + first], n - first);
+        _z_atomic_size_store(&ring->_tx->_tail, tail + n, _z_memory_order_seq_cst);
+        // The reader only sleeps on an empty ring, so it needs a wake up only if it had caught up with us
+        if (_z_atomic_size_load(&ring->_tx->_head, _z_memory_order_seq_cst) == tail) {
+            _z_shm_ring_signal(ring->_tx_efd);
+        }
+        done += n;
+        backoff_us = 0;
+    }
+    return len;
+}
+
+#endif /* defined(ZENOH_LINUX) && Z_FEATURE_LINK_SHM_RING == 1 */
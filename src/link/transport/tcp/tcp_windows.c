@@ -16,6 +16,7 @@
 
 #if defined(ZP_PLATFORM_SOCKET_WINDOWS)
 
+#include <errno.h>
 #include <string.h>
 #include <winsock2.h>
 #include <ws2tcpip.h>
@@ -255,6 +256,10 @@ static void _z_tcp_windows_close(_z_sys_net_socket_t *sock) {
 static size_t _z_tcp_windows_read(_z_sys_net_socket_t sock, uint8_t *ptr, size_t len) {
     int rb = recv(sock._sock._fd, (char *)ptr, (int)len, 0);
     if (rb == SOCKET_ERROR) {
+        // Lets the callers tell a non-blocking socket without data from a failure
+        if (WSAGetLastError() == WSAEWOULDBLOCK) {
+            errno = EWOULDBLOCK;
+        }
         return SIZE_MAX;
     }
 
@@ -142,61 +142,85 @@ static size_t _z_serial_write_all(_z_sys_net_socket_t sock, const uint8_t *ptr,
     return total;
 }
 
-static size_t _z_read_serial_internal(const _z_sys_net_socket_t sock, uint8_t *header, uint8_t *ptr, size_t len) {
-    uint8_t *raw_buf = (uint8_t *)z_malloc(_Z_SERIAL_MAX_COBS_BUF_SIZE);
-    if (raw_buf == NULL) {
-        _Z_ERROR("Failed to allocate serial COBS buffer");
-        return SIZE_MAX;
+static void _z_serial_buffers_reset(_z_serial_buffers_t *bufs) {
+    bufs->_rx_start = 0;
+    bufs->_rx_end = 0;
+    bufs->_rx_scanned = 0;
+}
+
+static _z_serial_buffers_t *_z_serial_buffers_new(void) {
+    _z_serial_buffers_t *bufs = (_z_serial_buffers_t *)z_malloc(sizeof(_z_serial_buffers_t));
+    if (bufs == NULL) {
+        _Z_ERROR("Failed to allocate serial buffers");
+        return NULL;
     }
+    _z_serial_buffers_reset(bufs);
+    return bufs;
+}
 
-    size_t rb = 0;
-    while (rb < _Z_SERIAL_MAX_COBS_BUF_SIZE) {
-        size_t chunk = _z_serial_read(sock, &raw_buf[rb], 1);
-        if (chunk != 1) {
-            z_free(raw_buf);
-            return SIZE_MAX;
+/**
+ * Reads from the device, at most chunk bytes at a time, until the buffered bytes hold a whole frame starting at
+ * bufs->_rx_start. Returns the length of the frame including its delimiter, or SIZE_MAX on failure.
+ */
+static size_t _z_serial_fill_frame(const _z_sys_net_socket_t sock, _z_serial_buffers_t *bufs, size_t chunk) {
+    while (true) {
+        const uint8_t *eop = (const uint8_t *)memchr(&bufs->_rx_raw[bufs->_rx_scanned], 0x00,
+                                                     bufs->_rx_end - bufs->_rx_scanned);
+        if (eop != NULL) {
+            return _z_ptr_u8_diff(eop, &bufs->_rx_raw[bufs->_rx_start]) + 1;
         }
+        bufs->_rx_scanned = bufs->_rx_end;
 
-        rb++;
-        if (raw_buf[rb - 1] == (uint8_t)0x00) {
-            break;
+        size_t pending = bufs->_rx_end - bufs->_rx_start;
+        if (pending == _Z_SERIAL_MAX_COBS_BUF_SIZE) {
+            // No delimiter within the largest frame, let the decoder reject it
+            return pending;
         }
+        if (bufs->_rx_end == _Z_SERIAL_MAX_COBS_BUF_SIZE) {
+            // Make room after the start of the frame
+            (void)memmove(bufs->_rx_raw, &bufs->_rx_raw[bufs->_rx_start], pending);
+            bufs->_rx_start = 0;
+            bufs->_rx_end = pending;
+            bufs->_rx_scanned = pending;
+        }
+
+        size_t space = _Z_SERIAL_MAX_COBS_BUF_SIZE - bufs->_rx_end;
+        size_t rb = _z_serial_read(sock, &bufs->_rx_raw[bufs->_rx_end], (chunk < space) ? chunk : space);
+        if ((rb == SIZE_MAX) || (rb == 0)) {
+            return SIZE_MAX;
+        }
+        bufs->_rx_end += rb;
     }
+}
 
-    uint8_t *tmp_buf = (uint8_t *)z_malloc(_Z_SERIAL_MFS_SIZE);
-    if (tmp_buf == NULL) {
-        z_free(raw_buf);
-        _Z_ERROR("Failed to allocate serial MFS buffer");
+static size_t _z_read_serial_internal(const _z_sys_net_socket_t sock, _z_serial_buffers_t *bufs, size_t chunk,
+                                      uint8_t *header, uint8_t *ptr, size_t len) {
+    size_t frame_len = _z_serial_fill_frame(sock, bufs, chunk);
+    if (frame_len == SIZE_MAX) {
+        _z_serial_buffers_reset(bufs);
         return SIZE_MAX;
     }
 
-    size_t ret = _z_serial_msg_deserialize(raw_buf, rb, ptr, len, header, tmp_buf, _Z_SERIAL_MFS_SIZE);
-    z_free(raw_buf);
-    z_free(tmp_buf);
+    size_t ret = _z_serial_msg_deserialize(&bufs->_rx_raw[bufs->_rx_start], frame_len, ptr, len, header,
+                                           bufs->_rx_tmp, sizeof(bufs->_rx_tmp));
+    // Bytes following the frame are kept for the next read
+    bufs->_rx_start += frame_len;
+    bufs->_rx_scanned = bufs->_rx_start;
+    if (bufs->_rx_start == bufs->_rx_end) {
+        _z_serial_buffers_reset(bufs);
+    }
     return ret;
 }
 
-static size_t _z_send_serial_internal(const _z_sys_net_socket_t sock, uint8_t header, const uint8_t *ptr, size_t len) {
-    uint8_t *tmp_buf = (uint8_t *)z_malloc(_Z_SERIAL_MFS_SIZE);
-    uint8_t *raw_buf = (uint8_t *)z_malloc(_Z_SERIAL_MAX_COBS_BUF_SIZE);
-    if ((raw_buf == NULL) || (tmp_buf == NULL)) {
-        z_free(raw_buf);
-        z_free(tmp_buf);
-        _Z_ERROR("Failed to allocate serial COBS and/or MFS buffer");
-        return SIZE_MAX;
-    }
-
-    size_t raw_len =
-        _z_serial_msg_serialize(raw_buf, _Z_SERIAL_MAX_COBS_BUF_SIZE, ptr, len, header, tmp_buf, _Z_SERIAL_MFS_SIZE);
+static size_t _z_send_serial_internal(const _z_sys_net_socket_t sock, _z_serial_buffers_t *bufs, uint8_t header,
+                                      const uint8_t *ptr, size_t len) {
+    size_t raw_len = _z_serial_msg_serialize(bufs->_tx_raw, _Z_SERIAL_MAX_COBS_BUF_SIZE, ptr, len, header,
+                                             bufs->_tx_tmp, _Z_SERIAL_MFS_SIZE);
     if (raw_len == SIZE_MAX) {
-        z_free(raw_buf);
-        z_free(tmp_buf);
         return SIZE_MAX;
     }
 
-    size_t written = _z_serial_write_all(sock, raw_buf, raw_len);
-    z_free(raw_buf);
-    z_free(tmp_buf);
+    size_t written = _z_serial_write_all(sock, bufs->_tx_raw, raw_len);
     return (written == raw_len) ? len : SIZE_MAX;
 }
 
@@ -220,6 +244,12 @@ static z_result_t _z_serial_open_impl(_z_serial_socket_t *sock, const _z_endpoin
         return ret;
     }
 
+    sock->_bufs = _z_serial_buffers_new();
+    if (sock->_bufs == NULL) {
+        _z_serial_endpoint_cfg_clear(&cfg);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+
     if (cfg._from_pins) {
         ret = connect ? _z_serial_open_from_pins(&sock->_sock, cfg._txpin, cfg._rxpin, cfg._baudrate)
                       : _z_serial_listen_from_pins(&sock->_sock, cfg._txpin, cfg._rxpin, cfg._baudrate);
@@ -228,14 +258,18 @@ static z_result_t _z_serial_open_impl(_z_serial_socket_t *sock, const _z_endpoin
                       : _z_serial_listen_from_dev(&sock->_sock, cfg._dev, cfg._baudrate);
     }
 
+    if (ret != _Z_RES_OK) {
+        z_free(sock->_bufs);
+        sock->_bufs = NULL;
+    }
     if (ret != _Z_RES_OK || !connect) {
         _z_serial_endpoint_cfg_clear(&cfg);
         return ret;
     }
 
-    ret = _z_connect_serial(sock->_sock);
+    ret = _z_connect_serial(sock);
     if (ret != _Z_RES_OK) {
-        _z_serial_close(&sock->_sock);
+        _z_serial_protocol_close(sock);
     }
 
     _z_serial_endpoint_cfg_clear(&cfg);
@@ -250,15 +284,20 @@ z_result_t _z_serial_protocol_listen(_z_serial_socket_t *sock, const _z_endpoint
     return _z_serial_open_impl(sock, endpoint, false);
 }
 
-void _z_serial_protocol_close(_z_serial_socket_t *sock) { _z_serial_close(&sock->_sock); }
+void _z_serial_protocol_close(_z_serial_socket_t *sock) {
+    _z_serial_close(&sock->_sock);
+    z_free(sock->_bufs);
+    sock->_bufs = NULL;
+}
 
-z_result_t _z_connect_serial(const _z_sys_net_socket_t sock) {
+z_result_t _z_connect_serial(const _z_serial_socket_t *sock) {
     while (true) {
         uint8_t header = _Z_FLAG_SERIAL_INIT;
 
-        _z_send_serial_internal(sock, header, NULL, 0);
+        _z_send_serial_internal(sock->_sock, sock->_bufs, header, NULL, 0);
         uint8_t tmp;
-        size_t ret = _z_read_serial_internal(sock, &header, &tmp, sizeof(tmp));
+        size_t ret = _z_read_serial_internal(sock->_sock, sock->_bufs, _Z_SERIAL_READ_CHUNK_SIZE, &header, &tmp,
+                                             sizeof(tmp));
         if (ret == SIZE_MAX) {
             _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_RX_FAILED);
         }
@@ -279,20 +318,32 @@ z_result_t _z_connect_serial(const _z_sys_net_socket_t sock) {
     return _Z_RES_OK;
 }
 
-size_t _z_read_serial(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len) {
+size_t _z_read_serial(const _z_serial_socket_t *sock, uint8_t *ptr, size_t len) {
     uint8_t header;
-    return _z_read_serial_internal(sock, &header, ptr, len);
+    return _z_read_serial_internal(sock->_sock, sock->_bufs, _Z_SERIAL_READ_CHUNK_SIZE, &header, ptr, len);
+}
+
+size_t _z_read_serial_socket(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len) {
+    _z_serial_buffers_t *bufs = _z_serial_buffers_new();
+    if (bufs == NULL) {
+        return SIZE_MAX;
+    }
+    // Reading past the frame would lose the bytes of the next one along with the buffers
+    uint8_t header;
+    size_t ret = _z_read_serial_internal(sock, bufs, 1, &header, ptr, len);
+    z_free(bufs);
+    return ret;
 }
 
-size_t _z_send_serial(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t len) {
-    return _z_send_serial_internal(sock, 0, ptr, len);
+size_t _z_send_serial(const _z_serial_socket_t *sock, const uint8_t *ptr, size_t len) {
+    return _z_send_serial_internal(sock->_sock, sock->_bufs, 0, ptr, len);
 }
 
-size_t _z_read_exact_serial(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len) {
+size_t _z_read_exact_serial(const _z_serial_socket_t *sock, uint8_t *ptr, size_t len) {
     size_t n = 0;
 
     do {
-        size_t rb = _z_read_serial(sock, ptr, len - n);
+        size_t rb = _z_read_serial(sock, _z_ptr_u8_offset(ptr, (ptrdiff_t)n), len - n);
         if (rb == SIZE_MAX) {
             n = rb;
             break;
@@ -17,6 +17,7 @@
 #if Z_FEATURE_LINK_TLS == 1
 
 #include <errno.h>
+#include <netdb.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <string.h>
@@ -36,12 +37,19 @@
 #include "mbedtls/version.h"
 #include "mbedtls/x509.h"
 #include "mbedtls/x509_crt.h"
+#include "zenoh-pico/collections/atomic.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/link/config/tls.h"
+#include "zenoh-pico/link/transport/socket.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/pointers.h"
 
 #define Z_TLS_BASE64_MAX_VALUE_LEN (64 * 1024)
+// Number of client sessions kept for resumption, each one is tied to a peer address, hostname and configuration
+#ifndef Z_TLS_SESSION_STORE_SIZE
+#define Z_TLS_SESSION_STORE_SIZE 8
+#endif
+#define Z_TLS_SESSION_TICKET_LIFETIME_S 86400
 
 #ifdef ZENOH_LOG_TRACE
 static void _z_tls_debug(void *ctx, int level, const char *file, int line, const char *str) {
@@ -178,6 +186,189 @@ static int _z_tls_bio_recv(void *ctx, unsigned char *buf, size_t len) {
     return (int)n;
 }
 
+#if defined(MBEDTLS_SSL_CLI_C)
+/**
+ * Sessions of the previous client connections, shared by all the TLS links of the process so that a reconnection
+ * finishes with an abbreviated handshake. Only resumed for the same peer address, hostname and TLS configuration, as a
+ * resumed session skips the certificate verification.
+ */
+typedef struct {
+    _z_slice_t _identity;  // Empty if the entry is unused
+    mbedtls_ssl_session _session;
+} _z_tls_session_entry_t;
+
+#define _Z_TLS_SESSION_STORE_UNINIT 0
+#define _Z_TLS_SESSION_STORE_INITIALIZING 1
+#define _Z_TLS_SESSION_STORE_READY 2
+#define _Z_TLS_SESSION_STORE_FAILED 3
+
+static _z_tls_session_entry_t _z_tls_session_store[Z_TLS_SESSION_STORE_SIZE];
+static size_t _z_tls_session_store_next = 0;  // Entry replaced by the next new identity
+static _z_atomic_size_t _z_tls_session_store_state = {_Z_TLS_SESSION_STORE_UNINIT};
+#if Z_FEATURE_MULTI_THREAD == 1
+static _z_mutex_t _z_tls_session_store_mutex;
+#endif
+
+// Returns whether the store can be used, a caller racing with the thread initializing it does not wait
+static bool _z_tls_session_store_ready(void) {
+    size_t state = _z_atomic_size_load(&_z_tls_session_store_state, _z_memory_order_acquire);
+    if (state == _Z_TLS_SESSION_STORE_READY) {
+        return true;
+    }
+    if ((state == _Z_TLS_SESSION_STORE_UNINIT) &&
+        _z_atomic_size_compare_exchange_strong(&_z_tls_session_store_state, &state,
+                                               _Z_TLS_SESSION_STORE_INITIALIZING, _z_memory_order_acquire,
+                                               _z_memory_order_relaxed)) {
+        state = _Z_TLS_SESSION_STORE_READY;
+#if Z_FEATURE_MULTI_THREAD == 1
+        if (_z_mutex_init(&_z_tls_session_store_mutex) != _Z_RES_OK) {
+            state = _Z_TLS_SESSION_STORE_FAILED;
+        }
+#endif
+        _z_atomic_size_store(&_z_tls_session_store_state, state, _z_memory_order_release);
+        return state == _Z_TLS_SESSION_STORE_READY;
+    }
+    return false;
+}
+
+static void _z_tls_session_store_lock(void) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_lock(&_z_tls_session_store_mutex);
+#endif
+}
+
+static void _z_tls_session_store_unlock(void) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_unlock(&_z_tls_session_store_mutex);
+#endif
+}
+
+// Appends a length prefixed field to the identity at pos, only its size is counted if buf is NULL
+static size_t _z_tls_session_identity_put(uint8_t *buf, size_t pos, const void *data, size_t len) {
+    if (buf != NULL) {
+        memcpy(&buf[pos], &len, sizeof(len));
+        if (len > 0) {
+            memcpy(&buf[pos + sizeof(len)], data, len);
+        }
+    }
+    return pos + sizeof(len) + len;
+}
+
+static size_t _z_tls_session_identity_write(uint8_t *buf, const _z_sys_net_endpoint_t *rep, const char *hostname,
+                                            const _z_str_intmap_t *config) {
+    size_t pos = _z_tls_session_identity_put(buf, 0, rep->_iptcp->ai_addr, (size_t)rep->_iptcp->ai_addrlen);
+    pos = _z_tls_session_identity_put(buf, pos, hostname, strlen(hostname));
+    for (size_t key = TLS_CONFIG_ROOT_CA_CERTIFICATE_KEY; key <= TLS_CONFIG_VERIFY_NAME_ON_CONNECT_KEY; key++) {
+        const char *val = _z_str_intmap_get(config, key);
+        // An unset value differs from an empty one
+        uint8_t set = (val != NULL) ? 1 : 0;
+        pos = _z_tls_session_identity_put(buf, pos, &set, sizeof(set));
+        pos = _z_tls_session_identity_put(buf, pos, val, (val != NULL) ? strlen(val) : 0);
+    }
+    return pos;
+}
+
+// Serializes the peer address, hostname and TLS configuration a session can be resumed with, compared as a whole
+static _z_slice_t _z_tls_session_identity(const _z_sys_net_endpoint_t *rep, const char *hostname,
+                                          const _z_str_intmap_t *config) {
+    _z_slice_t identity = _z_slice_make(_z_tls_session_identity_write(NULL, rep, hostname, config));
+    if (_z_slice_check(&identity)) {
+        _z_tls_session_identity_write((uint8_t *)identity.start, rep, hostname, config);
+    }
+    return identity;
+}
+
+static void _z_tls_session_load(_z_tls_context_t *ctx) {
+    if (!_z_tls_session_store_ready()) {
+        return;
+    }
+    _z_tls_session_store_lock();
+    for (size_t i = 0; i < Z_TLS_SESSION_STORE_SIZE; i++) {
+        _z_tls_session_entry_t *entry = &_z_tls_session_store[i];
+        if (_z_slice_check(&entry->_identity) && _z_slice_eq(&entry->_identity, &ctx->_session_identity)) {
+            int ret = mbedtls_ssl_set_session(&ctx->_ssl, &entry->_session);
+            if (ret != 0) {
+                _Z_DEBUG("Failed to set TLS session to resume: -0x%04x", -ret);
+            }
+            break;
+        }
+    }
+    _z_tls_session_store_unlock();
+}
+
+// Called once the handshake is done, then when a ticket is received and on close as TLS 1.3 tickets come afterwards
+static void _z_tls_session_save(_z_tls_context_t *ctx) {
+    if (!_z_slice_check(&ctx->_session_identity) || !_z_tls_session_store_ready()) {
+        return;
+    }
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    if (mbedtls_ssl_get_session(&ctx->_ssl, &session) != 0) {
+        // No session or ticket to save yet
+        mbedtls_ssl_session_free(&session);
+        return;
+    }
+    _z_tls_session_store_lock();
+    _z_tls_session_entry_t *entry = NULL;
+    for (size_t i = 0; i < Z_TLS_SESSION_STORE_SIZE; i++) {
+        if (_z_slice_check(&_z_tls_session_store[i]._identity) &&
+            _z_slice_eq(&_z_tls_session_store[i]._identity, &ctx->_session_identity)) {
+            entry = &_z_tls_session_store[i];
+            break;
+        }
+    }
+    if (entry == NULL) {
+        _z_slice_t identity = _z_slice_duplicate(&ctx->_session_identity);
+        if (!_z_slice_check(&identity)) {
+            _z_tls_session_store_unlock();
+            mbedtls_ssl_session_free(&session);
+            return;
+        }
+        entry = &_z_tls_session_store[_z_tls_session_store_next];
+        _z_tls_session_store_next = (_z_tls_session_store_next + 1) % Z_TLS_SESSION_STORE_SIZE;
+        _z_slice_clear(&entry->_identity);
+        entry->_identity = identity;
+    }
+    mbedtls_ssl_session_free(&entry->_session);
+    entry->_session = session;
+    _z_tls_session_store_unlock();
+}
+#endif
+
+#if defined(Z_TEST_HOOKS)
+static _z_atomic_size_t _z_tls_resumed_handshakes_count = {0};
+
+size_t _z_tls_resumed_handshakes(void) {
+    return _z_atomic_size_load(&_z_tls_resumed_handshakes_count, _z_memory_order_acquire);
+}
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+static int _z_tls_session_cache_get(void *data, const unsigned char *session_id, size_t session_id_len,
+                                    mbedtls_ssl_session *session) {
+    int ret = mbedtls_ssl_cache_get(data, session_id, session_id_len, session);
+    if (ret == 0) {
+        _z_atomic_size_fetch_add(&_z_tls_resumed_handshakes_count, 1, _z_memory_order_release);
+    }
+    return ret;
+}
+#define _Z_TLS_SESSION_CACHE_GET _z_tls_session_cache_get
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C) && defined(MBEDTLS_SSL_SESSION_TICKETS)
+static int _z_tls_session_ticket_parse(void *p_ticket, mbedtls_ssl_session *session, unsigned char *buf,
+                                       size_t len) {
+    int ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+    if (ret == 0) {
+        _z_atomic_size_fetch_add(&_z_tls_resumed_handshakes_count, 1, _z_memory_order_release);
+    }
+    return ret;
+}
+#define _Z_TLS_SESSION_TICKET_PARSE _z_tls_session_ticket_parse
+#endif
+#else
+#define _Z_TLS_SESSION_CACHE_GET mbedtls_ssl_cache_get
+#define _Z_TLS_SESSION_TICKET_PARSE mbedtls_ssl_ticket_parse
+#endif
+
 static _z_tls_context_t *_z_tls_context_new(void) {
     _z_tls_context_t *ctx = (_z_tls_context_t *)z_malloc(sizeof(_z_tls_context_t));
     if (ctx == NULL) {
@@ -194,6 +385,16 @@ static _z_tls_context_t *_z_tls_context_new(void) {
     mbedtls_pk_init(&ctx->_client_key);
     mbedtls_x509_crt_init(&ctx->_client_cert);
     ctx->_enable_mtls = false;
+#if defined(MBEDTLS_SSL_CACHE_C)
+    mbedtls_ssl_cache_init(&ctx->_session_cache);
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+    mbedtls_ssl_ticket_init(&ctx->_session_ticket);
+#endif
+    ctx->_session_identity = _z_slice_null();
+    ctx->_tx_buf = NULL;
+    ctx->_tx_len = 0;
+    ctx->_tx_cap = 0;
 #ifdef ZENOH_LOG_TRACE
     mbedtls_debug_set_threshold(4);
     mbedtls_ssl_conf_dbg(&ctx->_ssl_config, _z_tls_debug, NULL);
@@ -221,11 +422,31 @@ static void _z_tls_context_free(_z_tls_context_t **ctx) {
         mbedtls_x509_crt_free(&(*ctx)->_listen_cert);
         mbedtls_pk_free(&(*ctx)->_client_key);
         mbedtls_x509_crt_free(&(*ctx)->_client_cert);
+#if defined(MBEDTLS_SSL_CACHE_C)
+        mbedtls_ssl_cache_free(&(*ctx)->_session_cache);
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+        mbedtls_ssl_ticket_free(&(*ctx)->_session_ticket);
+#endif
+        z_free((*ctx)->_tx_buf);
+        _z_slice_clear(&(*ctx)->_session_identity);
         z_free(*ctx);
         *ctx = NULL;
     }
 }
 
+// Once the handshake is done, sizes the write buffer to the payload of a full record. Without it, writes go through.
+static void _z_tls_tx_buf_init(_z_tls_context_t *ctx) {
+    int payload = mbedtls_ssl_get_max_out_record_payload(&ctx->_ssl);
+    if (payload <= 0) {
+        return;
+    }
+    ctx->_tx_buf = (uint8_t *)z_malloc((size_t)payload);
+    if (ctx->_tx_buf != NULL) {
+        ctx->_tx_cap = (size_t)payload;
+    }
+}
+
 static z_result_t _z_tls_load_ca_certificate(_z_tls_context_t *ctx, const _z_str_intmap_t *config) {
     const char *ca_cert_str = _z_str_intmap_get(config, TLS_CONFIG_ROOT_CA_CERTIFICATE_KEY);
     const char *ca_cert_base64 = _z_str_intmap_get(config, TLS_CONFIG_ROOT_CA_CERTIFICATE_BASE64_KEY);
@@ -454,6 +675,11 @@ z_result_t _z_open_tls(_z_tls_socket_t *sock, const _z_sys_net_endpoint_t *rep,
         return _Z_ERR_GENERIC;
     }
 
+#if defined(MBEDTLS_SSL_CLI_C)
+    sock->_tls_ctx->_session_identity = _z_tls_session_identity(rep, hostname, config);
+    _z_tls_session_load(sock->_tls_ctx);
+#endif
+
     mbedtls_ssl_set_bio(&sock->_tls_ctx->_ssl, &sock->_sock._fd, _z_tls_bio_send, _z_tls_bio_recv, NULL);
 
     while ((mbedret = mbedtls_ssl_handshake(&sock->_tls_ctx->_ssl)) != 0) {
@@ -478,6 +704,10 @@ z_result_t _z_open_tls(_z_tls_socket_t *sock, const _z_sys_net_endpoint_t *rep,
             _Z_INFO("TLS client name verification disabled; ignoring certificate name mismatch");
         }
     }
+#if defined(MBEDTLS_SSL_CLI_C)
+    _z_tls_session_save(sock->_tls_ctx);
+#endif
+    _z_tls_tx_buf_init(sock->_tls_ctx);
 
     return _Z_RES_OK;
 }
@@ -553,10 +783,27 @@ z_result_t _z_listen_tls(_z_tls_socket_t *sock, const _z_sys_net_endpoint_t *rep
                               enable_mtls ? MBEDTLS_SSL_VERIFY_REQUIRED : MBEDTLS_SSL_VERIFY_NONE);
     mbedtls_ssl_conf_rng(&sock->_tls_ctx->_ssl_config, mbedtls_hmac_drbg_random, &sock->_tls_ctx->_hmac_drbg);
 
+    // Let reconnecting clients resume their session instead of running a full handshake
+#if defined(MBEDTLS_SSL_CACHE_C)
+    mbedtls_ssl_conf_session_cache(&sock->_tls_ctx->_ssl_config, &sock->_tls_ctx->_session_cache,
+                                   _Z_TLS_SESSION_CACHE_GET, mbedtls_ssl_cache_set);
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C) && defined(MBEDTLS_SSL_SESSION_TICKETS)
+    mbedret = mbedtls_ssl_ticket_setup(&sock->_tls_ctx->_session_ticket, mbedtls_hmac_drbg_random,
+                                       &sock->_tls_ctx->_hmac_drbg, MBEDTLS_CIPHER_AES_256_GCM,
+                                       Z_TLS_SESSION_TICKET_LIFETIME_S);
+    if (mbedret == 0) {
+        mbedtls_ssl_conf_session_tickets_cb(&sock->_tls_ctx->_ssl_config, mbedtls_ssl_ticket_write,
+                                            _Z_TLS_SESSION_TICKET_PARSE, &sock->_tls_ctx->_session_ticket);
+    } else {
+        _Z_INFO("TLS session tickets disabled, failed to setup ticket keys: -0x%04x", -mbedret);
+    }
+#endif
+
     return _Z_RES_OK;
 }
 
-z_result_t _z_tls_accept(_z_sys_net_socket_t *socket, const _z_sys_net_socket_t *listen_sock) {
+z_result_t _z_tls_accept_setup(_z_sys_net_socket_t *socket, const _z_sys_net_socket_t *listen_sock) {
     socket->_tls_sock = z_malloc(sizeof(_z_tls_socket_t));
     if (socket->_tls_sock == NULL) {
         _Z_ERROR("Failed to allocate TLS socket structure");
@@ -607,14 +854,26 @@ z_result_t _z_tls_accept(_z_sys_net_socket_t *socket, const _z_sys_net_socket_t
 
     mbedtls_ssl_set_bio(&tls_sock->_tls_ctx->_ssl, &tls_sock->_sock._fd, _z_tls_bio_send, _z_tls_bio_recv, NULL);
 
-    while ((mbedret = mbedtls_ssl_handshake(&tls_sock->_tls_ctx->_ssl)) != 0) {
-        if (mbedret != MBEDTLS_ERR_SSL_WANT_READ && mbedret != MBEDTLS_ERR_SSL_WANT_WRITE) {
-            _Z_ERROR("TLS server handshake failed: -0x%04x", -mbedret);
-            _z_tls_context_free(&tls_sock->_tls_ctx);
-            z_free(socket->_tls_sock);
-            socket->_tls_sock = NULL;
-            return _Z_ERR_GENERIC;
-        }
+    // From now on the socket is released with _z_close_tls_socket
+    tls_sock->_is_peer_socket = true;
+    tls_sock->_sock._tls_sock = (void *)tls_sock;
+    return _Z_RES_OK;
+}
+
+z_result_t _z_tls_accept_handshake(_z_sys_net_socket_t *socket) {
+    _z_tls_socket_t *tls_sock = (_z_tls_socket_t *)socket->_tls_sock;
+    if (tls_sock == NULL || tls_sock->_tls_ctx == NULL) {
+        _Z_ERROR("TLS context not found in socket");
+        return _Z_ERR_GENERIC;
+    }
+
+    int mbedret = mbedtls_ssl_handshake(&tls_sock->_tls_ctx->_ssl);
+    if (mbedret == MBEDTLS_ERR_SSL_WANT_READ || mbedret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+        return _Z_NO_DATA_PROCESSED;
+    }
+    if (mbedret != 0) {
+        _Z_ERROR("TLS server handshake failed: -0x%04x", -mbedret);
+        return _Z_ERR_GENERIC;
     }
     uint32_t verify_result = mbedtls_ssl_get_verify_result(&tls_sock->_tls_ctx->_ssl);
     if (verify_result != 0) {
@@ -624,20 +883,30 @@ z_result_t _z_tls_accept(_z_sys_net_socket_t *socket, const _z_sys_net_socket_t
         }
         if ((verify_result & ~allowed_flags) != 0u) {
             _Z_ERROR("TLS client certificate verification failed: 0x%08x", verify_result);
-            _z_tls_context_free(&tls_sock->_tls_ctx);
-            z_free(socket->_tls_sock);
-            socket->_tls_sock = NULL;
             return _Z_ERR_GENERIC;
         }
     }
 
-    tls_sock->_is_peer_socket = true;
-    tls_sock->_sock._tls_sock = (void *)tls_sock;
+    _z_tls_tx_buf_init(tls_sock->_tls_ctx);
     socket->_fd = tls_sock->_sock._fd;
-    socket->_tls_sock = (void *)tls_sock;
     return _Z_RES_OK;
 }
 
+z_result_t _z_tls_accept(_z_sys_net_socket_t *socket, const _z_sys_net_socket_t *listen_sock) {
+    _Z_RETURN_IF_ERR(_z_tls_accept_setup(socket, listen_sock));
+    z_result_t ret = _Z_NO_DATA_PROCESSED;
+    while (ret == _Z_NO_DATA_PROCESSED) {
+        ret = _z_tls_accept_handshake(socket);
+    }
+    if (ret != _Z_RES_OK) {
+        _z_tls_socket_t *tls_sock = (_z_tls_socket_t *)socket->_tls_sock;
+        _z_tls_context_free(&tls_sock->_tls_ctx);
+        z_free(tls_sock);
+        socket->_tls_sock = NULL;
+    }
+    return ret;
+}
+
 void _z_close_tls_socket(_z_sys_net_socket_t *socket) {
     if (socket == NULL) {
         return;
@@ -659,6 +928,10 @@ void _z_close_tls_socket(_z_sys_net_socket_t *socket) {
 
 void _z_close_tls(_z_tls_socket_t *sock) {
     if (sock->_tls_ctx != NULL) {
+#if defined(MBEDTLS_SSL_CLI_C)
+        _z_tls_session_save(sock->_tls_ctx);
+#endif
+        _z_flush_tls(sock);
         mbedtls_ssl_close_notify(&sock->_tls_ctx->_ssl);
         _z_tls_context_free(&sock->_tls_ctx);
     }
@@ -680,6 +953,15 @@ size_t _z_read_tls(const _z_tls_socket_t *sock, uint8_t *ptr, size_t len) {
     if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
         return 0;
     }
+#if defined(MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET)
+    // A TLS 1.3 ticket was received, there is no application data yet
+    if (ret == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET) {
+#if defined(MBEDTLS_SSL_CLI_C)
+        _z_tls_session_save(sock->_tls_ctx);
+#endif
+        return 0;
+    }
+#endif
 
     if (ret == 0 || ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY || ret == MBEDTLS_ERR_SSL_CONN_EOF) {
         return SIZE_MAX;
@@ -707,16 +989,80 @@ size_t _z_write_tls(const _z_tls_socket_t *sock, const uint8_t *ptr, size_t len)
     return SIZE_MAX;
 }
 
+/**
+ * Waits for the socket to accept more data after a write returned WANT_WRITE, so that a full send buffer isn't polled
+ * in a loop. Returns false once the socket timeout elapsed since start or if the wait fails.
+ */
+static bool _z_tls_wait_writable(const _z_tls_socket_t *sock, z_clock_t *start) {
+    unsigned long elapsed = z_clock_elapsed_ms(start);
+    if (elapsed >= Z_CONFIG_SOCKET_TIMEOUT) {
+        _Z_ERROR("TLS write timed out");
+        return false;
+    }
+    z_result_t ret = _z_socket_wait_writable(&sock->_sock, (uint32_t)(Z_CONFIG_SOCKET_TIMEOUT - elapsed));
+    if ((ret != _Z_RES_OK) && (ret != _Z_NO_DATA_PROCESSED)) {
+        _Z_ERROR("TLS write wait failed: %d", ret);
+        return false;
+    }
+    return true;
+}
+
 size_t _z_write_all_tls(const _z_tls_socket_t *sock, const uint8_t *ptr, size_t len) {
     size_t n = 0;
+    z_clock_t start = z_clock_now();
     do {
         size_t wb = _z_write_tls(sock, &ptr[n], len - n);
         if (wb == SIZE_MAX) {
             return wb;
         }
+        if ((wb == 0) && !_z_tls_wait_writable(sock, &start)) {
+            return SIZE_MAX;
+        }
         n += wb;
     } while (n < len);
     return n;
 }
 
+size_t _z_write_buffered_tls(const _z_tls_socket_t *sock, const uint8_t *ptr, size_t len) {
+    _z_tls_context_t *ctx = sock->_tls_ctx;
+    if ((ctx == NULL) || (ctx->_tx_buf == NULL)) {
+        return _z_write_all_tls(sock, ptr, len);
+    }
+    size_t n = 0;
+    while (n < len) {
+        size_t left = len - n;
+        if ((ctx->_tx_len == 0) && (left >= ctx->_tx_cap)) {
+            // Full records are written straight from the caller's buffer
+            size_t full = left - (left % ctx->_tx_cap);
+            if (_z_write_all_tls(sock, &ptr[n], full) == SIZE_MAX) {
+                return SIZE_MAX;
+            }
+            n += full;
+            continue;
+        }
+        size_t room = ctx->_tx_cap - ctx->_tx_len;
+        size_t chunk = (left < room) ? left : room;
+        memcpy(&ctx->_tx_buf[ctx->_tx_len], &ptr[n], chunk);
+        ctx->_tx_len += chunk;
+        n += chunk;
+        if ((ctx->_tx_len == ctx->_tx_cap) && (_z_flush_tls(sock) != _Z_RES_OK)) {
+            return SIZE_MAX;
+        }
+    }
+    return len;
+}
+
+z_result_t _z_flush_tls(const _z_tls_socket_t *sock) {
+    _z_tls_context_t *ctx = sock->_tls_ctx;
+    if ((ctx == NULL) || (ctx->_tx_len == 0)) {
+        return _Z_RES_OK;
+    }
+    size_t len = ctx->_tx_len;
+    ctx->_tx_len = 0;
+    if (_z_write_all_tls(sock, ctx->_tx_buf, len) == SIZE_MAX) {
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+    }
+    return _Z_RES_OK;
+}
+
 #endif  // Z_FEATURE_LINK_TLS == 1
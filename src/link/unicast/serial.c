@@ -36,27 +36,27 @@ void _z_f_link_free_serial(_z_link_t *self) { (void)(self); }
 
 size_t _z_f_link_write_serial(const _z_link_t *self, const uint8_t *ptr, size_t len, _z_sys_net_socket_t *socket) {
     _ZP_UNUSED(socket);
-    return _z_send_serial(self->_socket._serial._sock, ptr, len);
+    return _z_send_serial(&self->_socket._serial, ptr, len);
 }
 
 size_t _z_f_link_write_all_serial(const _z_link_t *self, const uint8_t *ptr, size_t len) {
-    return _z_send_serial(self->_socket._serial._sock, ptr, len);
+    return _z_send_serial(&self->_socket._serial, ptr, len);
 }
 
 size_t _z_f_link_read_serial(const _z_link_t *self, uint8_t *ptr, size_t len, _z_slice_t *addr) {
     _ZP_UNUSED(addr);
-    return _z_read_serial(self->_socket._serial._sock, ptr, len);
+    return _z_read_serial(&self->_socket._serial, ptr, len);
 }
 
 size_t _z_f_link_read_exact_serial(const _z_link_t *self, uint8_t *ptr, size_t len, _z_slice_t *addr,
                                    _z_sys_net_socket_t *socket) {
     _ZP_UNUSED(addr);
     _ZP_UNUSED(socket);
-    return _z_read_exact_serial(self->_socket._serial._sock, ptr, len);
+    return _z_read_exact_serial(&self->_socket._serial, ptr, len);
 }
 
 size_t _z_f_link_read_socket_serial(const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len) {
-    return _z_read_serial(socket, ptr, len);
+    return _z_read_serial_socket(socket, ptr, len);
 }
 
 uint16_t _z_get_link_mtu_serial(void) { return _Z_SERIAL_MTU_SIZE; }
@@ -79,6 +79,7 @@ z_result_t _z_new_link_serial(_z_link_t *zl, _z_endpoint_t endpoint) {
 
     zl->_write_f = _z_f_link_write_serial;
     zl->_write_all_f = _z_f_link_write_all_serial;
+    zl->_flush_f = NULL;
     zl->_read_f = _z_f_link_read_serial;
     zl->_read_exact_f = _z_f_link_read_exact_serial;
     zl->_read_socket_f = _z_f_link_read_socket_serial;
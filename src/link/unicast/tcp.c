@@ -120,6 +120,7 @@ z_result_t _z_new_link_tcp(_z_link_t *zl, _z_endpoint_t *endpoint) {
 
     zl->_write_f = _z_f_link_write_tcp;
     zl->_write_all_f = _z_f_link_write_all_tcp;
+    zl->_flush_f = NULL;
     zl->_read_f = _z_f_link_read_tcp;
     zl->_read_exact_f = _z_f_link_read_exact_tcp;
     zl->_read_socket_f = _z_f_link_tcp_read_socket;
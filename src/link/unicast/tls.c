@@ -138,15 +138,28 @@ static z_result_t _z_f_link_listen_tls(_z_link_t *self) {
 static void _z_f_link_close_tls(_z_link_t *self) { _z_close_tls(&self->_socket._tls); }
 
 static size_t _z_f_link_write_tls(const _z_link_t *self, const uint8_t *ptr, size_t len, _z_sys_net_socket_t *socket) {
+    // Batches are coalesced in full records, the rest is written when the transport flushes the link
     // Use provided socket if available, otherwise fall back to link socket
     if (socket != NULL && socket->_tls_sock != NULL) {
-        return _z_write_tls((_z_tls_socket_t *)socket->_tls_sock, ptr, len);
+        return _z_write_buffered_tls((_z_tls_socket_t *)socket->_tls_sock, ptr, len);
     } else {
-        return _z_write_tls(&self->_socket._tls, ptr, len);
+        return _z_write_buffered_tls(&self->_socket._tls, ptr, len);
+    }
+}
+
+static z_result_t _z_f_link_flush_tls(const _z_link_t *self, _z_sys_net_socket_t *socket) {
+    if (socket != NULL && socket->_tls_sock != NULL) {
+        return _z_flush_tls((_z_tls_socket_t *)socket->_tls_sock);
+    } else {
+        return _z_flush_tls(&self->_socket._tls);
     }
 }
 
 static size_t _z_f_link_write_all_tls(const _z_link_t *self, const uint8_t *ptr, size_t len) {
+    // Keeps the order of the pending batches
+    if (_z_flush_tls(&self->_socket._tls) != _Z_RES_OK) {
+        return SIZE_MAX;
+    }
     return _z_write_all_tls(&self->_socket._tls, ptr, len);
 }
 
@@ -208,6 +221,7 @@ z_result_t _z_new_link_tls(_z_link_t *zl, _z_endpoint_t *endpoint, const _z_conf
     zl->_close_f = _z_f_link_close_tls;
     zl->_write_f = _z_f_link_write_tls;
     zl->_write_all_f = _z_f_link_write_all_tls;
+    zl->_flush_f = _z_f_link_flush_tls;
     zl->_read_f = _z_f_link_read_tls;
     zl->_read_exact_f = _z_f_link_read_exact_tls;
     zl->_read_socket_f = _z_f_link_tls_read_socket;
@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/link/transport/unixsock_stream.h"
+
+#include <stdlib.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/link/manager.h"
+
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
+
+z_result_t _z_endpoint_unixsock_stream_valid(_z_endpoint_t *endpoint) {
+    _z_string_t unixsock_str = _z_string_alias_str(UNIXSOCK_STREAM_SCHEMA);
+    if (!_z_string_equals(&endpoint->_locator._protocol, &unixsock_str)) {
+        _Z_ERROR_LOG(_Z_ERR_CONFIG_LOCATOR_INVALID);
+        return _Z_ERR_CONFIG_LOCATOR_INVALID;
+    }
+
+    z_result_t ret = _z_unixsock_stream_address_valid(&endpoint->_locator._address);
+    if (ret != _Z_RES_OK) {
+        _Z_ERROR_LOG(_Z_ERR_CONFIG_LOCATOR_INVALID);
+    }
+    return ret;
+}
+
+static z_result_t _z_f_link_open_unixsock_stream(_z_link_t *zl) {
+    return _z_unixsock_stream_open(&zl->_socket._unixsock._sock, zl->_socket._unixsock._path, Z_CONFIG_SOCKET_TIMEOUT);
+}
+
+static z_result_t _z_f_link_listen_unixsock_stream(_z_link_t *zl) {
+    _Z_RETURN_IF_ERR(_z_unixsock_stream_listen(&zl->_socket._unixsock._sock, zl->_socket._unixsock._path));
+    zl->_socket._unixsock._is_listener = true;
+    return _Z_RES_OK;
+}
+
+static void _z_f_link_close_unixsock_stream(_z_link_t *zl) {
+    _z_unixsock_stream_close(&zl->_socket._unixsock._sock);
+    if (zl->_socket._unixsock._is_listener) {
+        _z_unixsock_stream_unlink(zl->_socket._unixsock._path);
+        zl->_socket._unixsock._is_listener = false;
+    }
+}
+
+static void _z_f_link_free_unixsock_stream(_z_link_t *zl) { z_free(zl->_socket._unixsock._path); }
+
+static size_t _z_f_link_write_unixsock_stream(const _z_link_t *zl, const uint8_t *ptr, size_t len,
+                                              _z_sys_net_socket_t *socket) {
+    if (socket != NULL) {
+        return _z_unixsock_stream_write(*socket, ptr, len);
+    } else {
+        return _z_unixsock_stream_write(zl->_socket._unixsock._sock, ptr, len);
+    }
+}
+
+static size_t _z_f_link_write_all_unixsock_stream(const _z_link_t *zl, const uint8_t *ptr, size_t len) {
+    return _z_unixsock_stream_write(zl->_socket._unixsock._sock, ptr, len);
+}
+
+static size_t _z_f_link_read_unixsock_stream(const _z_link_t *zl, uint8_t *ptr, size_t len, _z_slice_t *addr) {
+    _ZP_UNUSED(addr);
+    return _z_unixsock_stream_read(zl->_socket._unixsock._sock, ptr, len);
+}
+
+static size_t _z_f_link_read_exact_unixsock_stream(const _z_link_t *zl, uint8_t *ptr, size_t len,
+                                                   _z_slice_t *addr, _z_sys_net_socket_t *socket) {
+    _ZP_UNUSED(addr);
+    if (socket != NULL) {
+        return _z_unixsock_stream_read_exact(*socket, ptr, len);
+    } else {
+        return _z_unixsock_stream_read_exact(zl->_socket._unixsock._sock, ptr, len);
+    }
+}
+
+static size_t _z_f_link_unixsock_stream_read_socket(const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len) {
+    return _z_unixsock_stream_read(socket, ptr, len);
+}
+
+static uint16_t _z_get_link_mtu_unixsock_stream(void) {
+    // Same framing as TCP
+    return 65535;
+}
+
+z_result_t _z_new_peer_unixsock_stream(_z_endpoint_t *endpoint, _z_sys_net_socket_t *socket) {
+    char *path = _z_str_from_string_clone(&endpoint->_locator._address);
+    if (path == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    z_result_t ret = _z_unixsock_stream_open(socket, path, Z_CONFIG_SOCKET_TIMEOUT);
+    z_free(path);
+    return ret;
+}
+
+z_result_t _z_new_link_unixsock_stream(_z_link_t *zl, _z_endpoint_t *endpoint) {
+    zl->_type = _Z_LINK_TYPE_UNIXSOCK_STREAM;
+    zl->_cap._transport = Z_LINK_CAP_TRANSPORT_UNICAST;
+    zl->_cap._flow = Z_LINK_CAP_FLOW_STREAM;
+    zl->_cap._is_reliable = true;
+
+    zl->_mtu = _z_get_link_mtu_unixsock_stream();
+
+    zl->_endpoint = *endpoint;
+    zl->_socket._unixsock._sock._fd = -1;
+    zl->_socket._unixsock._is_listener = false;
+    zl->_socket._unixsock._path = _z_str_from_string_clone(&endpoint->_locator._address);
+    z_result_t ret = (zl->_socket._unixsock._path == NULL) ? _Z_ERR_SYSTEM_OUT_OF_MEMORY : _Z_RES_OK;
+
+    zl->_open_f = _z_f_link_open_unixsock_stream;
+    zl->_listen_f = _z_f_link_listen_unixsock_stream;
+    zl->_close_f = _z_f_link_close_unixsock_stream;
+    zl->_free_f = _z_f_link_free_unixsock_stream;
+
+    zl->_write_f = _z_f_link_write_unixsock_stream;
+    zl->_write_all_f = _z_f_link_write_all_unixsock_stream;
+    zl->_flush_f = NULL;
+    zl->_read_f = _z_f_link_read_unixsock_stream;
+    zl->_read_exact_f = _z_f_link_read_exact_unixsock_stream;
+    zl->_read_socket_f = _z_f_link_unixsock_stream_read_socket;
+
+    return ret;
+}
+
+#endif  // Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
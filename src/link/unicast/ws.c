@@ -104,6 +104,7 @@ z_result_t _z_new_link_ws(_z_link_t *zl, _z_endpoint_t *endpoint) {
 
     zl->_write_f = _z_f_link_write_ws;
     zl->_write_all_f = _z_f_link_write_all_ws;
+    zl->_flush_f = NULL;
     zl->_read_f = _z_f_link_read_ws;
     zl->_read_exact_f = _z_f_link_read_exact_ws;
     zl->_read_socket_f = _z_f_link_ws_read_socket;
@@ -36,11 +36,18 @@ z_result_t _z_config_client(_z_config_t *ps, const char *locator) {
         _Z_CLEAN_RETURN_IF_ERR(
             _zp_config_insert(ps, Z_CONFIG_MULTICAST_SCOUTING_KEY, Z_CONFIG_MULTICAST_SCOUTING_DEFAULT),
             _z_config_clear(ps));
-        _Z_CLEAN_RETURN_IF_ERR(
-            _zp_config_insert(ps, Z_CONFIG_MULTICAST_LOCATOR_KEY, Z_CONFIG_MULTICAST_LOCATOR_DEFAULT),
-            _z_config_clear(ps));
         _Z_CLEAN_RETURN_IF_ERR(_zp_config_insert(ps, Z_CONFIG_SCOUTING_TIMEOUT_KEY, Z_CONFIG_SCOUTING_TIMEOUT_DEFAULT),
                                _z_config_clear(ps));
     }
     return _Z_RES_OK;
 }
+
+z_result_t _z_config_get_scouting_locators(const _z_config_t *config, _z_string_svec_t *locators) {
+    size_t len = _z_string_svec_len(locators);
+    _Z_RETURN_IF_ERR(_z_config_get_all(config, locators, Z_CONFIG_MULTICAST_LOCATOR_KEY));
+    if (_z_string_svec_len(locators) == len) {
+        _z_string_t s = _z_string_copy_from_str(Z_CONFIG_MULTICAST_LOCATOR_DEFAULT);
+        _Z_RETURN_IF_ERR(_z_string_svec_append(locators, &s, true));
+    }
+    return _Z_RES_OK;
+}
@@ -16,7 +16,10 @@
 #include <string.h>
 
 #include "zenoh-pico/api/constants.h"
+#include "zenoh-pico/collections/atomic.h"
+#include "zenoh-pico/collections/refcount.h"
 #include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/system/platform.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/result.h"
 
@@ -25,14 +28,142 @@ _z_encoding_t _z_encoding_wrap(uint16_t id, const char *schema) {
                            .schema = (schema == NULL) ? _z_string_null() : _z_string_alias_str((char *)schema)};
 }
 
+// Schemas are interned in a refcounted buffer: the delete context holds the refcount block so that copies of the
+// encoding (e.g. one sample per subscriber) only bump the counter instead of duplicating the schema.
+static void _z_encoding_schema_rc_deleter(void *data, void *context) {
+    _ZP_UNUSED(data);
+    if (_z_simple_rc_decrease(context)) {
+        z_free(context);
+    }
+}
+
+static inline bool _z_encoding_schema_is_interned(const _z_string_t *schema) {
+    return schema->_slice._delete_context.deleter == _z_encoding_schema_rc_deleter;
+}
+
+// The last interned schemas, each holding a reference on its buffer, so that the same custom schema built or copied
+// from an alias again (e.g. a content type set on each message) shares the buffer instead of allocating a new one
+#define _Z_ENCODING_SCHEMA_CACHE_SIZE 8
+#define _Z_ENCODING_SCHEMA_CACHE_UNINIT 0
+#define _Z_ENCODING_SCHEMA_CACHE_INITIALIZING 1
+#define _Z_ENCODING_SCHEMA_CACHE_READY 2
+#define _Z_ENCODING_SCHEMA_CACHE_FAILED 3
+
+typedef struct {
+    void *_rc;
+    size_t _len;
+} _z_encoding_schema_cache_entry_t;
+
+static _z_encoding_schema_cache_entry_t _z_encoding_schema_cache[_Z_ENCODING_SCHEMA_CACHE_SIZE];
+static size_t _z_encoding_schema_cache_next = 0;  // Entry replaced by the next miss
+static _z_atomic_size_t _z_encoding_schema_cache_state = {_Z_ENCODING_SCHEMA_CACHE_UNINIT};
+#if Z_FEATURE_MULTI_THREAD == 1
+static _z_mutex_t _z_encoding_schema_cache_mutex;
+#endif
+
+// Returns whether the cache can be used, a caller racing with the thread initializing it does not wait
+static bool _z_encoding_schema_cache_ready(void) {
+    size_t state = _z_atomic_size_load(&_z_encoding_schema_cache_state, _z_memory_order_acquire);
+    if (state == _Z_ENCODING_SCHEMA_CACHE_READY) {
+        return true;
+    }
+    if ((state == _Z_ENCODING_SCHEMA_CACHE_UNINIT) &&
+        _z_atomic_size_compare_exchange_strong(&_z_encoding_schema_cache_state, &state,
+                                               _Z_ENCODING_SCHEMA_CACHE_INITIALIZING, _z_memory_order_acquire,
+                                               _z_memory_order_relaxed)) {
+        state = _Z_ENCODING_SCHEMA_CACHE_READY;
+#if Z_FEATURE_MULTI_THREAD == 1
+        if (_z_mutex_init(&_z_encoding_schema_cache_mutex) != _Z_RES_OK) {
+            state = _Z_ENCODING_SCHEMA_CACHE_FAILED;
+        }
+#endif
+        _z_atomic_size_store(&_z_encoding_schema_cache_state, state, _z_memory_order_release);
+        return state == _Z_ENCODING_SCHEMA_CACHE_READY;
+    }
+    return false;
+}
+
+// Returns a new reference on the cached buffer holding schema, or NULL if there is none
+static void *_z_encoding_schema_cache_get(const char *schema, size_t len) {
+    for (size_t i = 0; i < _Z_ENCODING_SCHEMA_CACHE_SIZE; i++) {
+        _z_encoding_schema_cache_entry_t *entry = &_z_encoding_schema_cache[i];
+        if ((entry->_rc != NULL) && (entry->_len == len) &&
+            (memcmp(_z_simple_rc_value(entry->_rc), schema, len) == 0)) {
+            return (_z_simple_rc_increase(entry->_rc) == _Z_RES_OK) ? entry->_rc : NULL;
+        }
+    }
+    return NULL;
+}
+
+static void _z_encoding_schema_cache_put(void *rc, size_t len) {
+    if (_z_simple_rc_increase(rc) != _Z_RES_OK) {
+        return;
+    }
+    _z_encoding_schema_cache_entry_t *entry = &_z_encoding_schema_cache[_z_encoding_schema_cache_next];
+    _z_encoding_schema_cache_next = (_z_encoding_schema_cache_next + 1) % _Z_ENCODING_SCHEMA_CACHE_SIZE;
+    if ((entry->_rc != NULL) && _z_simple_rc_decrease(entry->_rc)) {
+        z_free(entry->_rc);
+    }
+    entry->_rc = rc;
+    entry->_len = len;
+}
+
+z_result_t _z_encoding_schema_intern(_z_string_t *dst, const char *schema, size_t len) {
+    if (len == 0) {
+        *dst = _z_string_null();
+        return _Z_RES_OK;
+    }
+    void *rc = NULL;
+    z_result_t ret = _Z_RES_OK;
+    if (_z_encoding_schema_cache_ready()) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        _z_mutex_lock(&_z_encoding_schema_cache_mutex);
+#endif
+        rc = _z_encoding_schema_cache_get(schema, len);
+        if (rc == NULL) {
+            ret = _z_simple_rc_init(&rc, schema, len);
+            if (ret == _Z_RES_OK) {
+                _z_encoding_schema_cache_put(rc, len);
+            }
+        }
+#if Z_FEATURE_MULTI_THREAD == 1
+        _z_mutex_unlock(&_z_encoding_schema_cache_mutex);
+#endif
+    } else {
+        ret = _z_simple_rc_init(&rc, schema, len);
+    }
+    _Z_RETURN_IF_ERR(ret);
+    dst->_slice = _z_slice_from_buf_custom_deleter((const uint8_t *)_z_simple_rc_value(rc), len,
+                                                   _z_delete_context_create(_z_encoding_schema_rc_deleter, rc));
+    return _Z_RES_OK;
+}
+
+static z_result_t _z_encoding_schema_clone(_z_string_t *dst, const _z_string_t *src) {
+    if (_z_encoding_schema_is_interned(src)) {
+        _Z_RETURN_IF_ERR(_z_simple_rc_increase(src->_slice._delete_context.context));
+        *dst = *src;
+        return _Z_RES_OK;
+    }
+    return _z_encoding_schema_intern(dst, _z_string_data(src), _z_string_len(src));
+}
+
+z_result_t _z_encoding_intern(_z_encoding_t *encoding) {
+    if (!_z_string_check(&encoding->schema) || _z_encoding_schema_is_interned(&encoding->schema)) {
+        return _Z_RES_OK;
+    }
+    _z_string_t schema;
+    _Z_RETURN_IF_ERR(_z_encoding_schema_intern(&schema, _z_string_data(&encoding->schema),
+                                               _z_string_len(&encoding->schema)));
+    _z_string_clear(&encoding->schema);
+    encoding->schema = schema;
+    return _Z_RES_OK;
+}
+
 z_result_t _z_encoding_make(_z_encoding_t *encoding, uint16_t id, const char *schema, size_t len) {
     encoding->id = id;
-    // Clone schema
+    // Intern schema
     if (schema != NULL) {
-        encoding->schema = _z_string_copy_from_substr(schema, len);
-        if (_z_string_len(&encoding->schema) != len) {
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
+        _Z_RETURN_IF_ERR(_z_encoding_schema_intern(&encoding->schema, schema, len));
     } else {
         encoding->schema = _z_string_null();
     }
@@ -42,7 +173,7 @@ z_result_t _z_encoding_make(_z_encoding_t *encoding, uint16_t id, const char *sc
 z_result_t _z_encoding_copy(_z_encoding_t *dst, const _z_encoding_t *src) {
     dst->id = src->id;
     if (_z_string_check(&src->schema)) {
-        _Z_RETURN_IF_ERR(_z_string_copy(&dst->schema, &src->schema));
+        _Z_RETURN_IF_ERR(_z_encoding_schema_clone(&dst->schema, &src->schema));
     } else {
         dst->schema = _z_string_null();
     }
@@ -127,31 +127,38 @@ static z_result_t _z_write_filter_session_register(_z_session_t *session, _z_wri
     if (ctx->allow_local) {
 #if Z_FEATURE_LOCAL_SUBSCRIBER == 1
         if (ctx->target_type == _Z_WRITE_FILTER_SUBSCRIBER) {
-            _z_subscription_rc_slist_t *node = session->_subscriptions;
-            while (node != NULL) {
-                _z_subscription_t *sub = _Z_RC_IN_VAL(_z_subscription_rc_slist_value(node));
+            // Held with _mutex_inner so that no subscription is missed between the scan and the registration
+            _z_session_subscriptions_mutex_lock(session);
+            _z_subscription_rc_hmap_t *subs = &session->_subscriptions;
+            for (_z_subscription_rc_hmap_iter_t it = _z_subscription_rc_hmap_begin(subs);
+                 it != _z_subscription_rc_hmap_end(subs); it = _z_subscription_rc_hmap_iter_next(subs, it)) {
+                _z_subscription_t *sub = _Z_RC_IN_VAL(&_z_subscription_rc_hmap_at(subs, it)->val);
+                _z_interned_keyexpr_t sub_key = _z_interned_keyexpr_alias(&sub->_key._inner);
                 if (_z_locality_allows_local(sub->_allowed_origin) &&
-                    _z_keyexpr_intersects(&ctx->key, &sub->_key._inner)) {
+                    _z_interned_keyexpr_intersects(&ctx->key, &sub_key)) {
                     _z_write_filter_ctx_add_local_match(ctx);
                 }
-                node = _z_subscription_rc_slist_next(node);
             }
+            _z_session_subscriptions_mutex_unlock(session);
         }
 #endif
 #if Z_FEATURE_LOCAL_QUERYABLE == 1
         if (ctx->target_type == _Z_WRITE_FILTER_QUERYABLE) {
-            _z_session_queryable_rc_slist_t *node = session->_local_queryable;
-            while (node != NULL) {
-                _z_session_queryable_t *queryable = _Z_RC_IN_VAL(_z_session_queryable_rc_slist_value(node));
+            _z_session_queryables_mutex_lock(session);
+            _z_session_queryable_rc_hmap_t *qles = &session->_local_queryable;
+            for (_z_session_queryable_rc_hmap_iter_t it = _z_session_queryable_rc_hmap_begin(qles);
+                 it != _z_session_queryable_rc_hmap_end(qles); it = _z_session_queryable_rc_hmap_iter_next(qles, it)) {
+                _z_session_queryable_t *queryable = _Z_RC_IN_VAL(&_z_session_queryable_rc_hmap_at(qles, it)->val);
                 if (_z_locality_allows_local(queryable->_allowed_origin)) {
+                    _z_interned_keyexpr_t queryable_key = _z_interned_keyexpr_alias(&queryable->_key._inner);
                     if (ctx->is_complete
-                            ? (queryable->_complete && _z_keyexpr_includes(&queryable->_key._inner, &ctx->key))
-                            : _z_keyexpr_intersects(&ctx->key, &queryable->_key._inner)) {
+                            ? (queryable->_complete && _z_interned_keyexpr_includes(&queryable_key, &ctx->key))
+                            : _z_interned_keyexpr_intersects(&ctx->key, &queryable_key)) {
                         _z_write_filter_ctx_add_local_match(ctx);
                     }
                 }
-                node = _z_session_queryable_rc_slist_next(node);
             }
+            _z_session_queryables_mutex_unlock(session);
         }
 #endif
     }
@@ -204,7 +211,7 @@ static void _z_write_filter_callback(const _z_interest_msg_t *msg, _z_transport_
             bool peer_allowed = _z_write_filter_peer_allowed(ctx, peer);
             if (peer_allowed &&
                 (!ctx->is_complete ||
-                 (msg->is_complete && (ctx->is_aggregate || _z_keyexpr_includes(msg->key, &ctx->key))))) {
+                 (msg->is_complete && (ctx->is_aggregate || _z_keyexpr_includes(msg->key, &ctx->key._key))))) {
                 _z_write_filter_push_target(ctx, peer, msg->id);
             }
             break;
@@ -237,16 +244,17 @@ z_result_t _z_write_filter_create(const _z_session_rc_t *zn, _z_write_filter_t *
         flags |= _Z_INTEREST_FLAG_KEYEXPRS | _Z_INTEREST_FLAG_FUTURE;
     }
     filter->ctx = _z_write_filter_ctx_rc_null();
-    _z_keyexpr_t ke;
-    _Z_RETURN_IF_ERR(_z_keyexpr_copy(&ke, &keyexpr->_inner));
+    // The properties of the key are computed once, the local entities are matched against them
+    _z_interned_keyexpr_t ke = _z_interned_keyexpr_alias(&keyexpr->_inner);
+    _Z_RETURN_IF_ERR(_z_keyexpr_copy(&ke._key, &keyexpr->_inner));
     _z_write_filter_ctx_t *ctx = (_z_write_filter_ctx_t *)z_malloc(sizeof(_z_write_filter_ctx_t));
 
     if (ctx == NULL) {
-        _z_keyexpr_clear(&ke);
+        _z_interned_keyexpr_clear(&ke);
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
 #if Z_FEATURE_MULTI_THREAD == 1
-    _Z_CLEAN_RETURN_IF_ERR(_z_mutex_init(&ctx->mutex), _z_keyexpr_clear(&ke); z_free(ctx));
+    _Z_CLEAN_RETURN_IF_ERR(_z_mutex_init(&ctx->mutex), _z_interned_keyexpr_clear(&ke); z_free(ctx));
 #endif
     ctx->state = WRITE_FILTER_ACTIVE;
     ctx->targets = _z_filter_target_slist_new();
@@ -300,7 +308,7 @@ z_result_t _z_write_filter_ctx_clear(_z_write_filter_ctx_t *ctx) {
 #if Z_FEATURE_MATCHING
     _z_closure_matching_status_intmap_clear(&ctx->callbacks);
 #endif
-    _z_keyexpr_clear(&ctx->key);
+    _z_interned_keyexpr_clear(&ctx->key);
     _z_session_weak_drop(&ctx->zn);
     _z_write_filter_mutex_unlock(ctx);
 
@@ -370,24 +378,20 @@ static void _z_write_filter_match_free(void **value) {
     *value = NULL;
 }
 
-static void _z_write_filter_notify_local_entity(_z_session_t *session, const _z_keyexpr_t *key,
-                                                z_locality_t allowed_origin, bool is_complete,
-                                                _z_write_filter_target_type_t source_type, bool add) {
+// Collects the write filters of source_type that a local entity matches, the session mutex must be held
+static bool _z_write_filter_unsafe_collect_matches(_z_session_t *session, const _z_interned_keyexpr_t *key,
+                                                   z_locality_t allowed_origin, bool is_complete,
+                                                   _z_write_filter_target_type_t source_type, _z_list_t **matches) {
     if (!_z_locality_allows_local(allowed_origin)) {
-        return;
-    }
-
-    if (_z_session_mutex_lock_if_open(session) != _Z_RES_OK) {
-        return;
+        return true;
     }
-
-    _z_list_t *matches = NULL;
     for (_z_write_filter_registration_t *registration = session->_write_filters; registration != NULL;
          registration = registration->next) {
         _z_write_filter_ctx_t *registration_ctx = _Z_RC_IN_VAL(&registration->ctx_rc);
         if (!(registration_ctx->allow_local &&
-              (registration_ctx->is_complete ? (is_complete && _z_keyexpr_includes(key, &registration_ctx->key))
-                                             : _z_keyexpr_intersects(&registration_ctx->key, key)))) {
+              (registration_ctx->is_complete
+                   ? (is_complete && _z_interned_keyexpr_includes(key, &registration_ctx->key))
+                   : _z_interned_keyexpr_intersects(&registration_ctx->key, key)))) {
             continue;
         }
         if (registration_ctx->target_type != source_type) {
@@ -395,19 +399,18 @@ static void _z_write_filter_notify_local_entity(_z_session_t *session, const _z_
         }
         _z_write_filter_ctx_rc_t *ctx_clone = (_z_write_filter_ctx_rc_t *)z_malloc(sizeof(_z_write_filter_ctx_rc_t));
         if (ctx_clone == NULL) {
-            _z_list_free(&matches, _z_write_filter_match_free);
-            _z_session_mutex_unlock(session);
-            return;
+            return false;
         }
         *ctx_clone = _z_write_filter_ctx_rc_clone(&registration->ctx_rc);
-        _z_list_t *new_head = _z_list_push(matches, ctx_clone);
-        assert(new_head != matches && "Failed to allocate write-filter match node");
-        matches = new_head;
+        _z_list_t *new_head = _z_list_push(*matches, ctx_clone);
+        assert(new_head != *matches && "Failed to allocate write-filter match node");
+        *matches = new_head;
     }
+    return true;
+}
 
-    _z_session_mutex_unlock(session);
-
-    _z_list_t *it = matches;
+static void _z_write_filter_apply_matches(_z_list_t **matches, bool add) {
+    _z_list_t *it = *matches;
     while (it != NULL) {
         _z_write_filter_ctx_rc_t *ctx_clone = (_z_write_filter_ctx_rc_t *)_z_list_value(it);
         _z_write_filter_ctx_t *matched_ctx = _Z_RC_IN_VAL(ctx_clone);
@@ -418,7 +421,32 @@ static void _z_write_filter_notify_local_entity(_z_session_t *session, const _z_
         }
         it = _z_list_next(it);
     }
-    _z_list_free(&matches, _z_write_filter_match_free);
+    _z_list_free(matches, _z_write_filter_match_free);
+}
+
+static void _z_write_filter_notify_local_entity(_z_session_t *session, const _z_keyexpr_t *key,
+                                                z_locality_t allowed_origin, bool is_complete,
+                                                _z_write_filter_target_type_t source_type, bool add) {
+    if (!_z_locality_allows_local(allowed_origin)) {
+        return;
+    }
+
+    if (_z_session_mutex_lock_if_open(session) != _Z_RES_OK) {
+        return;
+    }
+
+    _z_list_t *matches = NULL;
+    _z_interned_keyexpr_t interned_key = _z_interned_keyexpr_alias(key);
+    if (!_z_write_filter_unsafe_collect_matches(session, &interned_key, allowed_origin, is_complete, source_type,
+                                                &matches)) {
+        _z_list_free(&matches, _z_write_filter_match_free);
+        _z_session_mutex_unlock(session);
+        return;
+    }
+
+    _z_session_mutex_unlock(session);
+
+    _z_write_filter_apply_matches(&matches, add);
 }
 
 void _z_write_filter_notify_subscriber(_z_session_t *session, const _z_keyexpr_t *key, z_locality_t allowed_origin,
@@ -430,6 +458,46 @@ void _z_write_filter_notify_queryable(_z_session_t *session, const _z_keyexpr_t
                                       bool is_complete, bool add) {
     _z_write_filter_notify_local_entity(session, key, allowed_origin, is_complete, _Z_WRITE_FILTER_QUERYABLE, add);
 }
+
+void _z_write_filter_notify_subscribers(_z_session_t *session, const _z_subscription_rc_t *subs, size_t len,
+                                        bool add) {
+    if (_z_session_mutex_lock_if_open(session) != _Z_RES_OK) {
+        return;
+    }
+    _z_list_t *matches = NULL;
+    for (size_t i = 0; i < len; i++) {
+        const _z_subscription_t *sub = _Z_RC_IN_VAL(&subs[i]);
+        _z_interned_keyexpr_t sub_key = _z_interned_keyexpr_alias(&sub->_key._inner);
+        if (!_z_write_filter_unsafe_collect_matches(session, &sub_key, sub->_allowed_origin, true,
+                                                    _Z_WRITE_FILTER_SUBSCRIBER, &matches)) {
+            _z_list_free(&matches, _z_write_filter_match_free);
+            _z_session_mutex_unlock(session);
+            return;
+        }
+    }
+    _z_session_mutex_unlock(session);
+    _z_write_filter_apply_matches(&matches, add);
+}
+
+void _z_write_filter_notify_queryables(_z_session_t *session, const _z_session_queryable_rc_t *qles, size_t len,
+                                       bool add) {
+    if (_z_session_mutex_lock_if_open(session) != _Z_RES_OK) {
+        return;
+    }
+    _z_list_t *matches = NULL;
+    for (size_t i = 0; i < len; i++) {
+        const _z_session_queryable_t *qle = _Z_RC_IN_VAL(&qles[i]);
+        _z_interned_keyexpr_t qle_key = _z_interned_keyexpr_alias(&qle->_key._inner);
+        if (!_z_write_filter_unsafe_collect_matches(session, &qle_key, qle->_allowed_origin, qle->_complete,
+                                                    _Z_WRITE_FILTER_QUERYABLE, &matches)) {
+            _z_list_free(&matches, _z_write_filter_match_free);
+            _z_session_mutex_unlock(session);
+            return;
+        }
+    }
+    _z_session_mutex_unlock(session);
+    _z_write_filter_apply_matches(&matches, add);
+}
 #else
 void _z_write_filter_notify_subscriber(_z_session_t *session, const _z_keyexpr_t *key, z_locality_t allowed_origin,
                                        bool add) {
@@ -447,6 +515,22 @@ void _z_write_filter_notify_queryable(_z_session_t *session, const _z_keyexpr_t
     _ZP_UNUSED(is_complete);
     _ZP_UNUSED(add);
 }
+
+void _z_write_filter_notify_subscribers(_z_session_t *session, const _z_subscription_rc_t *subs, size_t len,
+                                        bool add) {
+    _ZP_UNUSED(session);
+    _ZP_UNUSED(subs);
+    _ZP_UNUSED(len);
+    _ZP_UNUSED(add);
+}
+
+void _z_write_filter_notify_queryables(_z_session_t *session, const _z_session_queryable_rc_t *qles, size_t len,
+                                       bool add) {
+    _ZP_UNUSED(session);
+    _ZP_UNUSED(qles);
+    _ZP_UNUSED(len);
+    _ZP_UNUSED(add);
+}
 #endif  // Z_FEATURE_LOCAL_SUBSCRIBER == 1 || Z_FEATURE_LOCAL_QUERYABLE == 1
 
 #else  // Z_FEATURE_INTEREST == 0
@@ -484,4 +568,20 @@ void _z_write_filter_notify_queryable(_z_session_t *session, const _z_keyexpr_t
     _ZP_UNUSED(add);
 }
 
+void _z_write_filter_notify_subscribers(_z_session_t *session, const _z_subscription_rc_t *subs, size_t len,
+                                        bool add) {
+    _ZP_UNUSED(session);
+    _ZP_UNUSED(subs);
+    _ZP_UNUSED(len);
+    _ZP_UNUSED(add);
+}
+
+void _z_write_filter_notify_queryables(_z_session_t *session, const _z_session_queryable_rc_t *qles, size_t len,
+                                       bool add) {
+    _ZP_UNUSED(session);
+    _ZP_UNUSED(qles);
+    _ZP_UNUSED(len);
+    _ZP_UNUSED(add);
+}
+
 #endif
@@ -128,6 +128,198 @@ z_result_t _z_undeclare_liveliness_token(_z_liveliness_token_t *token) {
     return ret;
 }
 
+// Builds the declarations, or undeclarations, of len tokens in n_msgs
+static void _z_liveliness_make_token_msgs(_z_session_t *zn, _z_network_message_t *n_msgs, const uint32_t *ids,
+                                          _z_declared_keyexpr_t *const *kes, size_t len, bool declare) {
+    for (size_t i = 0; i < len; i++) {
+        _z_wireexpr_t wireexpr = _z_declared_keyexpr_alias_to_wire(kes[i], zn);
+        _z_declaration_t declaration =
+            declare ? _z_make_decl_token(&wireexpr, ids[i]) : _z_make_undecl_token(ids[i], &wireexpr);
+        _z_n_msg_make_declare(&n_msgs[i], declaration, _z_optional_id_make_none());
+    }
+}
+
+static z_result_t _z_liveliness_send_tokens(_z_session_t *zn, _z_network_message_t *n_msgs, const uint32_t *ids,
+                                            _z_declared_keyexpr_t *const *kes, size_t len, bool declare) {
+    _z_liveliness_make_token_msgs(zn, n_msgs, ids, kes, len, declare);
+    z_result_t ret = declare ? _z_send_declares(zn, n_msgs, len) : _z_send_undeclares(zn, n_msgs, len);
+    for (size_t i = 0; i < len; i++) {
+        _z_n_msg_clear(&n_msgs[i]);
+    }
+    return ret;
+}
+
+// Inserts len tokens in the local tokens map, none of them is inserted on failure
+static z_result_t _z_liveliness_register_tokens(_z_session_t *zn, const uint32_t *ids, _z_declared_keyexpr_t **kes,
+                                                size_t len) {
+    _Z_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn));
+    z_result_t ret = _Z_RES_OK;
+    size_t inserted = 0;
+    for (; (ret == _Z_RES_OK) && (inserted < len); inserted++) {
+        if (_z_declared_keyexpr_intmap_get(&zn->_local_tokens, ids[inserted]) != NULL) {
+            _Z_ERROR("Duplicate token id %i", (int)ids[inserted]);
+            ret = _Z_ERR_ENTITY_DECLARATION_FAILED;
+        } else if (_z_declared_keyexpr_intmap_insert(&zn->_local_tokens, ids[inserted], kes[inserted]) == NULL) {
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        }
+    }
+    if (ret != _Z_RES_OK) {
+        // The failed entry is not in the map, the map only owns the pointers once declared
+        for (size_t i = 0; i + 1 < inserted; i++) {
+            _z_declared_keyexpr_intmap_extract(&zn->_local_tokens, ids[i]);
+        }
+    }
+    _z_session_mutex_unlock(zn);
+    return ret;
+}
+
+z_result_t _z_declare_liveliness_tokens(const _z_session_rc_t *zn, _z_liveliness_token_t *tokens,
+                                        const _z_declared_keyexpr_t *const *keyexprs, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        tokens[i] = _z_liveliness_token_null();
+    }
+    if (len == 0) {
+        return _Z_RES_OK;
+    }
+    _z_session_t *session = _Z_RC_IN_VAL(zn);
+    uint32_t *ids = (uint32_t *)z_malloc(len * sizeof(uint32_t));
+    _z_declared_keyexpr_t **kes = (_z_declared_keyexpr_t **)z_malloc(len * sizeof(_z_declared_keyexpr_t *));
+    _z_network_message_t *n_msgs = (_z_network_message_t *)z_malloc(len * sizeof(_z_network_message_t));
+    z_result_t ret = ((ids != NULL) && (kes != NULL) && (n_msgs != NULL)) ? _Z_RES_OK : _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    bool batching = _z_declare_batch_start(session);
+
+    size_t declared = 0;
+    while ((ret == _Z_RES_OK) && (declared < len)) {
+        ids[declared] = _z_get_entity_id(session);
+        kes[declared] = (_z_declared_keyexpr_t *)z_malloc(sizeof(_z_declared_keyexpr_t));
+        if (kes[declared] == NULL) {
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+            break;
+        }
+        ret = _z_declared_keyexpr_declare(zn, kes[declared], keyexprs[declared]);
+        if (ret != _Z_RES_OK) {
+            z_free(kes[declared]);
+            break;
+        }
+        declared++;
+    }
+    // Once handed to the transport, part of the declarations may be sent even if sending them fails
+    bool handed_out = false;
+    bool cached = false;
+    if (ret == _Z_RES_OK) {
+        ret = _z_liveliness_send_tokens(session, n_msgs, ids, kes, len, true);
+        handed_out = true;
+        cached = (ret == _Z_RES_OK);
+    }
+    if (ret == _Z_RES_OK) {
+        ret = _z_liveliness_register_tokens(session, ids, kes, len);
+    }
+    if ((ret != _Z_RES_OK) && handed_out) {
+        _z_liveliness_make_token_msgs(session, n_msgs, ids, kes, len, false);
+        _z_send_declares_rollback(session, n_msgs, len, cached);
+        for (size_t i = 0; i < len; i++) {
+            _z_n_msg_clear(&n_msgs[i]);
+        }
+    }
+    ret = _z_declare_batch_stop(session, batching, ret);
+
+    if (ret == _Z_RES_OK) {
+        for (size_t i = 0; i < len; i++) {
+            tokens[i]._id = ids[i];
+            tokens[i]._zn = _z_session_rc_clone_as_weak(zn);
+        }
+    } else {
+        for (size_t i = 0; i < declared; i++) {
+            _z_declared_keyexpr_clear(kes[i]);
+            z_free(kes[i]);
+        }
+    }
+    z_free(ids);
+    z_free(kes);
+    z_free(n_msgs);
+    return ret;
+}
+
+static z_result_t _z_undeclare_liveliness_tokens_each(_z_liveliness_token_t *tokens, size_t len) {
+    z_result_t ret = _Z_RES_OK;
+    for (size_t i = 0; i < len; i++) {
+        z_result_t res = _z_undeclare_liveliness_token(&tokens[i]);
+        _Z_SET_IF_OK(ret, res);
+    }
+    return ret;
+}
+
+z_result_t _z_undeclare_liveliness_tokens(_z_liveliness_token_t *tokens, size_t len) {
+    if ((len == 0) || _Z_RC_IS_NULL(&tokens[0]._zn)) {
+        return _z_undeclare_liveliness_tokens_each(tokens, len);
+    }
+#if Z_FEATURE_SESSION_CHECK == 1
+    _z_session_rc_t sess_rc = _z_session_weak_upgrade_if_open(&tokens[0]._zn);
+    if (_Z_RC_IS_NULL(&sess_rc)) {
+        return _Z_ERR_SESSION_CLOSED;
+    }
+    _z_session_t *zn = _Z_RC_IN_VAL(&sess_rc);
+#else
+    _z_session_t *zn = _z_session_weak_as_unsafe_ptr(&tokens[0]._zn);
+#endif
+    uint32_t *ids = (uint32_t *)z_malloc(len * sizeof(uint32_t));
+    _z_declared_keyexpr_t **kes = (_z_declared_keyexpr_t **)z_malloc(len * sizeof(_z_declared_keyexpr_t *));
+    _z_network_message_t *n_msgs = (_z_network_message_t *)z_malloc(len * sizeof(_z_network_message_t));
+    if ((ids == NULL) || (kes == NULL) || (n_msgs == NULL)) {
+        z_free(ids);
+        z_free(kes);
+        z_free(n_msgs);
+#if Z_FEATURE_SESSION_CHECK == 1
+        _z_session_rc_drop(&sess_rc);
+#endif
+        return _z_undeclare_liveliness_tokens_each(tokens, len);
+    }
+
+    // Tokens of another session are undeclared on their own
+    z_result_t ret = _Z_RES_OK;
+    size_t found = 0;
+    _z_session_mutex_lock(zn);
+    for (size_t i = 0; i < len; i++) {
+        if (_Z_RC_IS_NULL(&tokens[i]._zn) || (_z_session_weak_as_unsafe_ptr(&tokens[i]._zn) != zn)) {
+            continue;
+        }
+        _z_declared_keyexpr_t *ke = _z_declared_keyexpr_intmap_extract(&zn->_local_tokens, tokens[i]._id);
+        if (ke == NULL) {
+            _Z_SET_IF_OK(ret, _Z_ERR_ENTITY_UNKNOWN);
+        } else {
+            ids[found] = tokens[i]._id;
+            kes[found] = ke;
+            found++;
+        }
+    }
+    _z_session_mutex_unlock(zn);
+    for (size_t i = 0; i < len; i++) {
+        if (_Z_RC_IS_NULL(&tokens[i]._zn) || (_z_session_weak_as_unsafe_ptr(&tokens[i]._zn) != zn)) {
+            z_result_t res = _z_undeclare_liveliness_token(&tokens[i]);
+            _Z_SET_IF_OK(ret, res);
+        }
+    }
+
+    bool batching = _z_declare_batch_start(zn);
+    if (_z_liveliness_send_tokens(zn, n_msgs, ids, kes, found, false) != _Z_RES_OK) {
+        _Z_SET_IF_OK(ret, _Z_ERR_TRANSPORT_TX_FAILED);
+    }
+    // Key expressions are undeclared outside of the session mutex, since it might trigger resources update
+    for (size_t i = 0; i < found; i++) {
+        _z_declared_keyexpr_clear(kes[i]);
+        z_free(kes[i]);
+    }
+    ret = _z_declare_batch_stop(zn, batching, ret);
+
+#if Z_FEATURE_SESSION_CHECK == 1
+    _z_session_rc_drop(&sess_rc);
+#endif
+    z_free(ids);
+    z_free(kes);
+    z_free(n_msgs);
+    return ret;
+}
+
 /**************** Liveliness Subscriber ****************/
 
 z_result_t _z_liveliness_subscription_trigger_history(_z_session_t *zn, const _z_subscription_t *sub) {
@@ -74,11 +74,83 @@ z_result_t _z_send_undeclare(_z_session_t *zn, const _z_network_message_t *n_msg
 
     return ret;
 }
+
+z_result_t _z_send_declares(_z_session_t *zn, const _z_network_message_t *n_msgs, size_t len) {
+    if (len == 0) {
+        return _Z_RES_OK;
+    }
+    z_result_t ret = _z_send_n_msgs(zn, n_msgs, len, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK);
+
+#if Z_FEATURE_AUTO_RECONNECT == 1
+    if (ret == _Z_RES_OK) {
+        _z_cache_declarations(zn, n_msgs, len);
+    }
+#endif
+
+    return ret;
+}
+
+z_result_t _z_send_undeclares(_z_session_t *zn, const _z_network_message_t *n_msgs, size_t len) {
+    if (len == 0) {
+        return _Z_RES_OK;
+    }
+    z_result_t ret = _z_send_n_msgs(zn, n_msgs, len, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK);
+
+#if Z_FEATURE_AUTO_RECONNECT == 1
+    if (ret == _Z_RES_OK) {
+        _z_prune_declarations(zn, n_msgs, len);
+    }
+#endif
+
+    return ret;
+}
+
+void _z_send_declares_rollback(_z_session_t *zn, const _z_network_message_t *n_msgs, size_t len, bool cached) {
+    if ((len > 0) &&
+        (_z_send_n_msgs(zn, n_msgs, len, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) != _Z_RES_OK)) {
+        _Z_INFO("Failed to undeclare the entities of a failed bulk declaration");
+    }
+#if Z_FEATURE_AUTO_RECONNECT == 1
+    // Not replayed on reconnection either, whether the undeclarations went through or not
+    if (cached) {
+        _z_prune_declarations(zn, n_msgs, len);
+    }
+#else
+    _ZP_UNUSED(cached);
+#endif
+}
+
+bool _z_declare_batch_start(_z_session_t *zn) {
+#if Z_FEATURE_BATCHING == 1
+    return _z_transport_start_batching(&zn->_tp) == _Z_RES_OK;
+#else
+    _ZP_UNUSED(zn);
+    return false;
+#endif
+}
+
+z_result_t _z_declare_batch_stop(_z_session_t *zn, bool started, z_result_t ret) {
+#if Z_FEATURE_BATCHING == 1
+    if (started) {
+        _z_transport_stop_batching(&zn->_tp);
+        // Also flush on error, the batch may hold the undeclarations of a rollback
+        z_result_t flush_ret = _z_send_n_batch(zn, Z_CONGESTION_CONTROL_BLOCK);
+        _Z_SET_IF_OK(ret, flush_ret);
+    }
+#else
+    _ZP_UNUSED(zn);
+    _ZP_UNUSED(started);
+#endif
+    return ret;
+}
+
 /*------------------ Scouting ------------------*/
 #if Z_FEATURE_SCOUTING == 1
-void _z_scout(const z_what_t what, const _z_id_t zid, _z_string_t *locator, const uint32_t timeout,
+void _z_scout(const z_what_t what, const _z_id_t zid, const _z_string_svec_t *locators, const uint32_t timeout,
               _z_closure_hello_callback_t callback, void *arg_call, _z_drop_handler_t dropper, void *arg_drop) {
-    _z_hello_slist_t *hellos = _z_scout_inner(what, zid, locator, timeout, false);
+    _z_zbuf_t zbf = _z_zbuf_null();
+    _z_hello_slist_t *hellos = _z_scout_inner(what, zid, locators, timeout, false, &zbf);
+    _z_zbuf_clear(&zbf);
 
     while (hellos != NULL) {
         _z_hello_t *hello = _z_hello_slist_value(hellos);
@@ -203,29 +275,96 @@ z_result_t _z_write(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, _z_b
 #endif
     return ret;
 }
+
+z_result_t _z_write_loan(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, size_t payload_len,
+                         _z_encoding_t *encoding, z_congestion_control_t cong_ctrl, z_priority_t priority,
+                         bool is_express, const _z_timestamp_t *timestamp, _z_bytes_t *attachment,
+                         z_reliability_t reliability, const _z_source_info_t *source_info,
+                         _z_transport_tx_loan_t *loan) {
+    _z_qos_t qos = _z_n_qos_make(is_express, cong_ctrl == Z_CONGESTION_CONTROL_BLOCK, priority);
+    _z_wireexpr_t wireexpr = _z_declared_keyexpr_alias_to_wire(keyexpr, zn);
+    _z_bytes_t payload = _z_bytes_null();
+    _z_network_message_t msg;
+    _z_n_msg_make_push_put(&msg, &wireexpr, &payload, encoding, qos, timestamp, attachment, reliability, source_info);
+    if (_z_send_n_msg_loan(zn, loan, &msg, payload_len, reliability, cong_ctrl) != _Z_RES_OK) {
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+    }
+    return _Z_RES_OK;
+}
+
+z_result_t _z_write_many(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr, const _z_write_item_t *items,
+                         size_t len, _z_encoding_t *encoding, z_congestion_control_t cong_ctrl, z_priority_t priority,
+                         bool is_express, z_reliability_t reliability, const _z_source_info_t *source_info,
+                         z_locality_t allowed_destination) {
+    z_result_t ret = _Z_RES_OK;
+    _z_qos_t qos = _z_n_qos_make(is_express, cong_ctrl == Z_CONGESTION_CONTROL_BLOCK, priority);
+
+    if (len == 0) {
+        return _Z_RES_OK;
+    }
+    if (_z_locality_allows_remote(allowed_destination)) {
+        _z_network_message_t *msgs = (_z_network_message_t *)z_malloc(len * sizeof(_z_network_message_t));
+        if (msgs == NULL) {
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+        _z_wireexpr_t wireexpr = _z_declared_keyexpr_alias_to_wire(keyexpr, zn);
+        for (size_t i = 0; i < len; i++) {
+            _z_n_msg_make_push_put(&msgs[i], &wireexpr, items[i].payload, encoding, qos, items[i].timestamp,
+                                   items[i].attachment, reliability, source_info);
+        }
+        if (_z_send_n_msgs(zn, msgs, len, reliability, cong_ctrl) != _Z_RES_OK) {
+            _Z_ERROR_LOG(_Z_ERR_TRANSPORT_TX_FAILED);
+            ret = _Z_ERR_TRANSPORT_TX_FAILED;
+        }
+        z_free(msgs);
+    }
+
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+    if (_z_locality_allows_local(allowed_destination)) {
+        for (size_t i = 0; (ret == _Z_RES_OK) && (i < len); i++) {
+            ret = _z_session_deliver_push_locally(zn, &keyexpr->_inner, items[i].payload, encoding, Z_SAMPLE_KIND_PUT,
+                                                  qos, items[i].timestamp, items[i].attachment, reliability,
+                                                  source_info);
+        }
+    }
+#endif
+    return ret;
+}
 #endif
 
 #if Z_FEATURE_SUBSCRIPTION == 1
 /*------------------ Subscriber Declaration ------------------*/
-z_result_t _z_register_subscriber(uint32_t *sub_id, const _z_session_rc_t *zn, const _z_declared_keyexpr_t *keyexpr,
-                                  _z_closure_sample_callback_t callback, _z_drop_handler_t dropper, void *arg,
-                                  z_locality_t allowed_origin, const _z_sync_group_t *callback_drop_sync_group) {
-    _z_subscription_t s = {0};
-    s._id = _z_get_entity_id(_Z_RC_IN_VAL(zn));
-    s._callback = callback;
-    s._dropper = dropper;
-    s._arg = arg;
-    s._allowed_origin = allowed_origin;
-    _Z_CLEAN_RETURN_IF_ERR(_z_declared_keyexpr_declare_non_wild_prefix(zn, &s._key, keyexpr),
-                           _z_subscription_clear(&s));
+// Builds the session entry of a subscriber, the dropper is called on failure
+static z_result_t _z_subscription_init(_z_subscription_t *s, const _z_session_rc_t *zn,
+                                       const _z_declared_keyexpr_t *keyexpr, _z_closure_sample_callback_t callback,
+                                       _z_drop_handler_t dropper, void *arg, z_locality_t allowed_origin,
+                                       const _z_sync_group_t *callback_drop_sync_group) {
+    _z_session_t *session = _Z_RC_IN_VAL(zn);
+    *s = _z_subscription_null();
+    s->_id = _z_get_entity_id(session);
+    s->_callback = callback;
+    s->_dropper = dropper;
+    s->_arg = arg;
+    s->_allowed_origin = allowed_origin;
+    _Z_CLEAN_RETURN_IF_ERR(_z_declared_keyexpr_declare_non_wild_prefix(zn, &s->_key, keyexpr),
+                           _z_subscription_clear(s));
     _Z_CLEAN_RETURN_IF_ERR(
-        _z_sync_group_create_notifier(&_Z_RC_IN_VAL(zn)->_callback_drop_sync_group, &s._session_callback_drop_notifier),
-        _z_subscription_clear(&s));
+        _z_sync_group_create_notifier(&session->_callback_drop_sync_group, &s->_session_callback_drop_notifier),
+        _z_subscription_clear(s));
     if (callback_drop_sync_group != NULL) {
         _Z_CLEAN_RETURN_IF_ERR(
-            _z_sync_group_create_notifier(callback_drop_sync_group, &s._subscriber_callback_drop_notifier),
-            _z_subscription_clear(&s));
+            _z_sync_group_create_notifier(callback_drop_sync_group, &s->_subscriber_callback_drop_notifier),
+            _z_subscription_clear(s));
     }
+    return _Z_RES_OK;
+}
+
+z_result_t _z_register_subscriber(uint32_t *sub_id, const _z_session_rc_t *zn, const _z_declared_keyexpr_t *keyexpr,
+                                  _z_closure_sample_callback_t callback, _z_drop_handler_t dropper, void *arg,
+                                  z_locality_t allowed_origin, const _z_sync_group_t *callback_drop_sync_group) {
+    _z_subscription_t s;
+    _Z_RETURN_IF_ERR(
+        _z_subscription_init(&s, zn, keyexpr, callback, dropper, arg, allowed_origin, callback_drop_sync_group));
 
     _z_subscription_rc_t sp_s = _z_register_subscription(_Z_RC_IN_VAL(zn), _Z_SUBSCRIBER_KIND_SUBSCRIBER, &s);
     if (_Z_RC_IS_NULL(&sp_s)) {
@@ -313,31 +452,250 @@ z_result_t _z_undeclare_subscriber(_z_subscriber_t *sub) {
                               : _Z_RES_OK;
     return ret == _Z_RES_OK ? wait_ret : ret;
 }
+
+static void _z_subscription_make_undecl(_z_session_t *zn, const _z_subscription_t *s, _z_network_message_t *n_msg) {
+    _z_declaration_t declaration;
+    if (zn->_mode == Z_WHATAMI_CLIENT) {
+        declaration = _z_make_undecl_subscriber(s->_id, NULL);
+    } else {
+        _z_wireexpr_t expr = _z_declared_keyexpr_alias_to_wire(&s->_key, zn);
+        declaration = _z_make_undecl_subscriber(s->_id, &expr);
+    }
+    _z_n_msg_make_declare(n_msg, declaration, _z_optional_id_make_none());
+}
+
+// Undeclares the subscriptions of a failed bulk declaration, some declarations may have been sent before the failure
+static void _z_subscriptions_rollback_remote(_z_session_t *zn, const _z_subscription_rc_t *rcs, size_t len,
+                                             bool cached) {
+    _z_network_message_t *n_msgs = (_z_network_message_t *)z_malloc(len * sizeof(_z_network_message_t));
+    if (n_msgs == NULL) {
+        _Z_ERROR("Not enough memory to undeclare the subscribers of a failed declaration");
+        return;
+    }
+    for (size_t i = 0; i < len; i++) {
+        _z_subscription_make_undecl(zn, _Z_RC_IN_VAL(&rcs[i]), &n_msgs[i]);
+    }
+    _z_send_declares_rollback(zn, n_msgs, len, cached);
+    for (size_t i = 0; i < len; i++) {
+        _z_n_msg_clear(&n_msgs[i]);
+    }
+    z_free(n_msgs);
+}
+
+z_result_t _z_declare_subscribers(_z_subscriber_t *subscribers, const _z_session_rc_t *zn,
+                                  const _z_subscriber_item_t *items, size_t len, z_locality_t allowed_origin) {
+    for (size_t i = 0; i < len; i++) {
+        subscribers[i] = _z_subscriber_null();
+    }
+    if (len == 0) {
+        return _Z_RES_OK;
+    }
+    _z_session_t *session = _Z_RC_IN_VAL(zn);
+    _z_subscription_t *subs = (_z_subscription_t *)z_malloc(len * sizeof(_z_subscription_t));
+    _z_subscription_rc_t *rcs = (_z_subscription_rc_t *)z_malloc(len * sizeof(_z_subscription_rc_t));
+    z_result_t ret = ((subs != NULL) && (rcs != NULL)) ? _Z_RES_OK : _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    bool batching = _z_declare_batch_start(session);
+
+    // Items up to handed gave their closure away, either to a subscription entry or to its dropper
+    size_t handed = 0;
+    for (; (ret == _Z_RES_OK) && (handed < len); handed++) {
+        _z_subscriber_t *subscriber = &subscribers[handed];
+        const _z_subscriber_item_t *item = &items[handed];
+        subscriber->_zn = _z_session_rc_clone_as_weak(zn);
+        ret = _z_sync_group_create(&subscriber->_callback_drop_sync_group);
+        if (ret == _Z_RES_OK) {
+            ret = _z_subscription_init(&subs[handed], zn, item->keyexpr, item->callback, item->dropper, item->arg,
+                                       allowed_origin, &subscriber->_callback_drop_sync_group);
+        } else if (item->dropper != NULL) {
+            item->dropper(item->arg);
+        }
+    }
+    if (ret == _Z_RES_OK) {
+        ret = _z_register_subscriptions(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, subs, len, rcs);
+    } else {
+        for (size_t i = 0; i + 1 < handed; i++) {
+            _z_subscription_clear(&subs[i]);
+        }
+        for (size_t i = handed; i < len; i++) {
+            if (items[i].dropper != NULL) {
+                items[i].dropper(items[i].arg);
+            }
+        }
+    }
+    bool registered = (ret == _Z_RES_OK);
+    // Once handed to the transport, part of the declarations may be sent even if sending them fails
+    bool handed_out = false;
+    bool cached = false;
+
+    if ((ret == _Z_RES_OK) && _z_locality_allows_remote(allowed_origin)) {
+        _z_network_message_t *n_msgs = (_z_network_message_t *)z_malloc(len * sizeof(_z_network_message_t));
+        if (n_msgs == NULL) {
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        } else {
+            for (size_t i = 0; i < len; i++) {
+                const _z_subscription_t *s = _Z_RC_IN_VAL(&rcs[i]);
+                _z_wireexpr_t wire_expr = _z_declared_keyexpr_alias_to_wire(&s->_key, session);
+                _z_n_msg_make_declare(&n_msgs[i], _z_make_decl_subscriber(&wire_expr, s->_id),
+                                      _z_optional_id_make_none());
+            }
+            ret = _z_send_declares(session, n_msgs, len);
+            handed_out = true;
+            cached = (ret == _Z_RES_OK);
+            for (size_t i = 0; i < len; i++) {
+                _z_n_msg_clear(&n_msgs[i]);
+            }
+            z_free(n_msgs);
+        }
+    }
+    ret = _z_declare_batch_stop(session, batching, ret);
+
+    if (ret == _Z_RES_OK) {
+        for (size_t i = 0; i < len; i++) {
+            subscribers[i]._entity_id = _Z_RC_IN_VAL(&rcs[i])->_id;
+            _z_subscription_rc_drop(&rcs[i]);
+        }
+    } else {
+        if (handed_out) {
+            _z_subscriptions_rollback_remote(session, rcs, len, cached);
+        }
+        if (registered) {
+            _z_unregister_subscriptions(session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, rcs, len);
+        }
+        for (size_t i = 0; i < len; i++) {
+            _z_subscriber_clear(&subscribers[i]);
+        }
+    }
+    z_free(subs);
+    z_free(rcs);
+    return ret;
+}
+
+static z_result_t _z_undeclare_subscribers_each(_z_subscriber_t *subs, size_t len) {
+    z_result_t ret = _Z_RES_OK;
+    for (size_t i = 0; i < len; i++) {
+        z_result_t res = _z_undeclare_subscriber(&subs[i]);
+        _Z_SET_IF_OK(ret, res);
+    }
+    return ret;
+}
+
+z_result_t _z_undeclare_subscribers(_z_subscriber_t *subs, size_t len) {
+    if ((len == 0) || _Z_RC_IS_NULL(&subs[0]._zn)) {
+        return _z_undeclare_subscribers_each(subs, len);
+    }
+#if Z_FEATURE_SESSION_CHECK == 1
+    _z_session_rc_t sess_rc = _z_session_weak_upgrade_if_open(&subs[0]._zn);
+    if (_Z_RC_IS_NULL(&sess_rc)) {
+        return _Z_ERR_SESSION_CLOSED;
+    }
+    _z_session_t *zn = _Z_RC_IN_VAL(&sess_rc);
+#else
+    _z_session_t *zn = _z_session_weak_as_unsafe_ptr(&subs[0]._zn);
+#endif
+    uint32_t *ids = (uint32_t *)z_malloc(len * sizeof(uint32_t));
+    size_t *pos = (size_t *)z_malloc(len * sizeof(size_t));
+    _z_subscription_rc_t *rcs = (_z_subscription_rc_t *)z_malloc(len * sizeof(_z_subscription_rc_t));
+    _z_network_message_t *n_msgs = (_z_network_message_t *)z_malloc(len * sizeof(_z_network_message_t));
+    if ((ids == NULL) || (pos == NULL) || (rcs == NULL) || (n_msgs == NULL)) {
+        z_free(ids);
+        z_free(pos);
+        z_free(rcs);
+        z_free(n_msgs);
+#if Z_FEATURE_SESSION_CHECK == 1
+        _z_session_rc_drop(&sess_rc);
+#endif
+        return _z_undeclare_subscribers_each(subs, len);
+    }
+    for (size_t i = 0; i < len; i++) {
+        ids[i] = subs[i]._entity_id;
+    }
+    _z_get_subscriptions_by_id(zn, _Z_SUBSCRIBER_KIND_SUBSCRIBER, ids, len, rcs);
+
+    // Subscribers of another session or unknown to this one, such as liveliness ones, are undeclared on their own
+    z_result_t ret = _Z_RES_OK;
+    size_t found = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (!_Z_RC_IS_NULL(&rcs[i]) && (_z_session_weak_as_unsafe_ptr(&subs[i]._zn) == zn)) {
+            rcs[found] = rcs[i];
+            pos[found] = i;
+            found++;
+        } else {
+            _z_subscription_rc_drop(&rcs[i]);
+            z_result_t res = _z_undeclare_subscriber(&subs[i]);
+            _Z_SET_IF_OK(ret, res);
+        }
+    }
+
+    bool batching = _z_declare_batch_start(zn);
+    size_t n_len = 0;
+    for (size_t i = 0; i < found; i++) {
+        const _z_subscription_t *s = _Z_RC_IN_VAL(&rcs[i]);
+        if (!_z_locality_allows_remote(s->_allowed_origin)) {
+            continue;
+        }
+        _z_subscription_make_undecl(zn, s, &n_msgs[n_len++]);
+    }
+    if (_z_send_undeclares(zn, n_msgs, n_len) != _Z_RES_OK) {
+        _Z_SET_IF_OK(ret, _Z_ERR_TRANSPORT_TX_FAILED);
+    }
+    for (size_t i = 0; i < n_len; i++) {
+        _z_n_msg_clear(&n_msgs[i]);
+    }
+    _z_unregister_subscriptions(zn, _Z_SUBSCRIBER_KIND_SUBSCRIBER, rcs, found);
+    ret = _z_declare_batch_stop(zn, batching, ret);
+#if Z_FEATURE_SESSION_CHECK == 1
+    _z_session_rc_drop(&sess_rc);
+#endif
+
+    for (size_t i = 0; i < found; i++) {
+        _z_sync_group_t *group = &subs[pos[i]]._callback_drop_sync_group;
+        z_result_t wait_ret = _z_sync_group_check(group) ? _z_sync_group_wait(group) : _Z_RES_OK;
+        _Z_SET_IF_OK(ret, wait_ret);
+    }
+    z_free(ids);
+    z_free(pos);
+    z_free(rcs);
+    z_free(n_msgs);
+    return ret;
+}
 #endif
 
 #if Z_FEATURE_QUERYABLE == 1
 /*------------------ Queryable Declaration ------------------*/
-z_result_t _z_register_queryable(uint32_t *queryable_id, const _z_session_rc_t *zn,
-                                 const _z_declared_keyexpr_t *keyexpr, bool complete,
-                                 _z_closure_query_callback_t callback, _z_drop_handler_t dropper, void *arg,
-                                 z_locality_t allowed_origin, const _z_sync_group_t *callback_drop_sync_group) {
-    _z_session_queryable_t q = {0};
-    q._id = _z_get_entity_id(_Z_RC_IN_VAL(zn));
-    q._complete = complete;
-    q._callback = callback;
-    q._dropper = dropper;
-    q._arg = arg;
-    q._allowed_origin = allowed_origin;
-    _Z_CLEAN_RETURN_IF_ERR(_z_declared_keyexpr_declare_non_wild_prefix(zn, &q._key, keyexpr),
-                           _z_session_queryable_clear(&q));
+// Builds the session entry of a queryable, the dropper is called on failure
+static z_result_t _z_session_queryable_init(_z_session_queryable_t *q, const _z_session_rc_t *zn,
+                                            const _z_declared_keyexpr_t *keyexpr, bool complete,
+                                            _z_closure_query_callback_t callback, _z_drop_handler_t dropper,
+                                            void *arg, z_locality_t allowed_origin,
+                                            const _z_sync_group_t *callback_drop_sync_group) {
+    _z_session_t *session = _Z_RC_IN_VAL(zn);
+    *q = _z_session_queryable_null();
+    q->_id = _z_get_entity_id(session);
+    q->_complete = complete;
+    q->_callback = callback;
+    q->_dropper = dropper;
+    q->_arg = arg;
+    q->_allowed_origin = allowed_origin;
+    _Z_CLEAN_RETURN_IF_ERR(_z_declared_keyexpr_declare_non_wild_prefix(zn, &q->_key, keyexpr),
+                           _z_session_queryable_clear(q));
     _Z_CLEAN_RETURN_IF_ERR(
-        _z_sync_group_create_notifier(&_Z_RC_IN_VAL(zn)->_callback_drop_sync_group, &q._session_callback_drop_notifier),
-        _z_session_queryable_clear(&q));
+        _z_sync_group_create_notifier(&session->_callback_drop_sync_group, &q->_session_callback_drop_notifier),
+        _z_session_queryable_clear(q));
     if (callback_drop_sync_group != NULL) {
         _Z_CLEAN_RETURN_IF_ERR(
-            _z_sync_group_create_notifier(callback_drop_sync_group, &q._queryable_callback_drop_notifier),
-            _z_session_queryable_clear(&q));
+            _z_sync_group_create_notifier(callback_drop_sync_group, &q->_queryable_callback_drop_notifier),
+            _z_session_queryable_clear(q));
     }
+    return _Z_RES_OK;
+}
+
+z_result_t _z_register_queryable(uint32_t *queryable_id, const _z_session_rc_t *zn,
+                                 const _z_declared_keyexpr_t *keyexpr, bool complete,
+                                 _z_closure_query_callback_t callback, _z_drop_handler_t dropper, void *arg,
+                                 z_locality_t allowed_origin, const _z_sync_group_t *callback_drop_sync_group) {
+    _z_session_queryable_t q;
+    _Z_RETURN_IF_ERR(_z_session_queryable_init(&q, zn, keyexpr, complete, callback, dropper, arg, allowed_origin,
+                                               callback_drop_sync_group));
 
     // Create session_queryable entry, stored at session-level, do not drop it by the end of this function.
     _z_session_queryable_rc_t sp_q = _z_register_session_queryable(_Z_RC_IN_VAL(zn), &q);
@@ -390,7 +748,7 @@ z_result_t _z_undeclare_queryable(_z_queryable_t *qle) {
     }
     _z_session_t *zn = _Z_RC_IN_VAL(&sess_rc);
 #else
-    _z_session_t *zn = _z_session_weak_as_unsafe_ptr(&sub->_zn);
+    _z_session_t *zn = _z_session_weak_as_unsafe_ptr(&qle->_zn);
 #endif
     // Find session_queryable entry
     _z_session_queryable_rc_t q = _z_get_session_queryable_by_id(zn, qle->_entity_id);
@@ -429,6 +787,215 @@ z_result_t _z_undeclare_queryable(_z_queryable_t *qle) {
     return ret;
 }
 
+static void _z_session_queryable_make_undecl(_z_session_t *zn, const _z_session_queryable_t *q,
+                                             _z_network_message_t *n_msg) {
+    _z_declaration_t declaration;
+    if (zn->_mode == Z_WHATAMI_CLIENT) {
+        declaration = _z_make_undecl_queryable(q->_id, NULL);
+    } else {
+        _z_wireexpr_t expr = _z_declared_keyexpr_alias_to_wire(&q->_key, zn);
+        declaration = _z_make_undecl_queryable(q->_id, &expr);
+    }
+    _z_n_msg_make_declare(n_msg, declaration, _z_optional_id_make_none());
+}
+
+// Undeclares the queryables of a failed bulk declaration, some declarations may have been sent before the failure
+static void _z_session_queryables_rollback_remote(_z_session_t *zn, const _z_session_queryable_rc_t *rcs, size_t len,
+                                                  bool cached) {
+    _z_network_message_t *n_msgs = (_z_network_message_t *)z_malloc(len * sizeof(_z_network_message_t));
+    if (n_msgs == NULL) {
+        _Z_ERROR("Not enough memory to undeclare the queryables of a failed declaration");
+        return;
+    }
+    for (size_t i = 0; i < len; i++) {
+        _z_session_queryable_make_undecl(zn, _Z_RC_IN_VAL(&rcs[i]), &n_msgs[i]);
+    }
+    _z_send_declares_rollback(zn, n_msgs, len, cached);
+    for (size_t i = 0; i < len; i++) {
+        _z_n_msg_clear(&n_msgs[i]);
+    }
+    z_free(n_msgs);
+}
+
+z_result_t _z_declare_queryables(_z_queryable_t *queryables, const _z_session_rc_t *zn,
+                                 const _z_queryable_item_t *items, size_t len, bool complete,
+                                 z_locality_t allowed_origin) {
+    for (size_t i = 0; i < len; i++) {
+        queryables[i] = _z_queryable_null();
+    }
+    if (len == 0) {
+        return _Z_RES_OK;
+    }
+    _z_session_t *session = _Z_RC_IN_VAL(zn);
+    _z_session_queryable_t *qles = (_z_session_queryable_t *)z_malloc(len * sizeof(_z_session_queryable_t));
+    _z_session_queryable_rc_t *rcs = (_z_session_queryable_rc_t *)z_malloc(len * sizeof(_z_session_queryable_rc_t));
+    z_result_t ret = ((qles != NULL) && (rcs != NULL)) ? _Z_RES_OK : _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    bool batching = _z_declare_batch_start(session);
+
+    // Items up to handed gave their closure away, either to a queryable entry or to its dropper
+    size_t handed = 0;
+    for (; (ret == _Z_RES_OK) && (handed < len); handed++) {
+        _z_queryable_t *queryable = &queryables[handed];
+        const _z_queryable_item_t *item = &items[handed];
+        queryable->_zn = _z_session_rc_clone_as_weak(zn);
+        ret = _z_sync_group_create(&queryable->_callback_drop_sync_group);
+        if (ret == _Z_RES_OK) {
+            ret = _z_session_queryable_init(&qles[handed], zn, item->keyexpr, complete, item->callback, item->dropper,
+                                            item->arg, allowed_origin, &queryable->_callback_drop_sync_group);
+        } else if (item->dropper != NULL) {
+            item->dropper(item->arg);
+        }
+    }
+    if (ret == _Z_RES_OK) {
+        ret = _z_register_session_queryables(session, qles, len, rcs);
+    } else {
+        for (size_t i = 0; i + 1 < handed; i++) {
+            _z_session_queryable_clear(&qles[i]);
+        }
+        for (size_t i = handed; i < len; i++) {
+            if (items[i].dropper != NULL) {
+                items[i].dropper(items[i].arg);
+            }
+        }
+    }
+    bool registered = (ret == _Z_RES_OK);
+    // Once handed to the transport, part of the declarations may be sent even if sending them fails
+    bool handed_out = false;
+    bool cached = false;
+
+    if ((ret == _Z_RES_OK) && _z_locality_allows_remote(allowed_origin)) {
+        _z_network_message_t *n_msgs = (_z_network_message_t *)z_malloc(len * sizeof(_z_network_message_t));
+        if (n_msgs == NULL) {
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        } else {
+            for (size_t i = 0; i < len; i++) {
+                const _z_session_queryable_t *q = _Z_RC_IN_VAL(&rcs[i]);
+                _z_wireexpr_t wire_expr = _z_declared_keyexpr_alias_to_wire(&q->_key, session);
+                _z_declaration_t declaration =
+                    _z_make_decl_queryable(&wire_expr, q->_id, q->_complete, _Z_QUERYABLE_DISTANCE_DEFAULT);
+                _z_n_msg_make_declare(&n_msgs[i], declaration, _z_optional_id_make_none());
+            }
+            ret = _z_send_declares(session, n_msgs, len);
+            handed_out = true;
+            cached = (ret == _Z_RES_OK);
+            for (size_t i = 0; i < len; i++) {
+                _z_n_msg_clear(&n_msgs[i]);
+            }
+            z_free(n_msgs);
+        }
+    }
+    ret = _z_declare_batch_stop(session, batching, ret);
+
+    if (ret == _Z_RES_OK) {
+        for (size_t i = 0; i < len; i++) {
+            queryables[i]._entity_id = _Z_RC_IN_VAL(&rcs[i])->_id;
+            _z_session_queryable_rc_drop(&rcs[i]);
+        }
+    } else {
+        if (handed_out) {
+            _z_session_queryables_rollback_remote(session, rcs, len, cached);
+        }
+        if (registered) {
+            _z_unregister_session_queryables(session, rcs, len);
+        }
+        for (size_t i = 0; i < len; i++) {
+            _z_queryable_clear(&queryables[i]);
+        }
+    }
+    z_free(qles);
+    z_free(rcs);
+    return ret;
+}
+
+static z_result_t _z_undeclare_queryables_each(_z_queryable_t *qles, size_t len) {
+    z_result_t ret = _Z_RES_OK;
+    for (size_t i = 0; i < len; i++) {
+        z_result_t res = _z_undeclare_queryable(&qles[i]);
+        _Z_SET_IF_OK(ret, res);
+    }
+    return ret;
+}
+
+z_result_t _z_undeclare_queryables(_z_queryable_t *qles, size_t len) {
+    if ((len == 0) || _Z_RC_IS_NULL(&qles[0]._zn)) {
+        return _z_undeclare_queryables_each(qles, len);
+    }
+#if Z_FEATURE_SESSION_CHECK == 1
+    _z_session_rc_t sess_rc = _z_session_weak_upgrade_if_open(&qles[0]._zn);
+    if (_Z_RC_IS_NULL(&sess_rc)) {
+        return _Z_ERR_SESSION_CLOSED;
+    }
+    _z_session_t *zn = _Z_RC_IN_VAL(&sess_rc);
+#else
+    _z_session_t *zn = _z_session_weak_as_unsafe_ptr(&qles[0]._zn);
+#endif
+    uint32_t *ids = (uint32_t *)z_malloc(len * sizeof(uint32_t));
+    size_t *pos = (size_t *)z_malloc(len * sizeof(size_t));
+    _z_session_queryable_rc_t *rcs = (_z_session_queryable_rc_t *)z_malloc(len * sizeof(_z_session_queryable_rc_t));
+    _z_network_message_t *n_msgs = (_z_network_message_t *)z_malloc(len * sizeof(_z_network_message_t));
+    if ((ids == NULL) || (pos == NULL) || (rcs == NULL) || (n_msgs == NULL)) {
+        z_free(ids);
+        z_free(pos);
+        z_free(rcs);
+        z_free(n_msgs);
+#if Z_FEATURE_SESSION_CHECK == 1
+        _z_session_rc_drop(&sess_rc);
+#endif
+        return _z_undeclare_queryables_each(qles, len);
+    }
+    for (size_t i = 0; i < len; i++) {
+        ids[i] = qles[i]._entity_id;
+    }
+    _z_get_session_queryables_by_id(zn, ids, len, rcs);
+
+    // Queryables of another session or unknown to this one are undeclared on their own
+    z_result_t ret = _Z_RES_OK;
+    size_t found = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (!_Z_RC_IS_NULL(&rcs[i]) && (_z_session_weak_as_unsafe_ptr(&qles[i]._zn) == zn)) {
+            rcs[found] = rcs[i];
+            pos[found] = i;
+            found++;
+        } else {
+            _z_session_queryable_rc_drop(&rcs[i]);
+            z_result_t res = _z_undeclare_queryable(&qles[i]);
+            _Z_SET_IF_OK(ret, res);
+        }
+    }
+
+    bool batching = _z_declare_batch_start(zn);
+    size_t n_len = 0;
+    for (size_t i = 0; i < found; i++) {
+        const _z_session_queryable_t *q = _Z_RC_IN_VAL(&rcs[i]);
+        if (!_z_locality_allows_remote(q->_allowed_origin)) {
+            continue;
+        }
+        _z_session_queryable_make_undecl(zn, q, &n_msgs[n_len++]);
+    }
+    if (_z_send_undeclares(zn, n_msgs, n_len) != _Z_RES_OK) {
+        _Z_SET_IF_OK(ret, _Z_ERR_TRANSPORT_TX_FAILED);
+    }
+    for (size_t i = 0; i < n_len; i++) {
+        _z_n_msg_clear(&n_msgs[i]);
+    }
+    _z_unregister_session_queryables(zn, rcs, found);
+    ret = _z_declare_batch_stop(zn, batching, ret);
+
+    for (size_t i = 0; i < found; i++) {
+        _z_sync_group_t *group = &qles[pos[i]]._callback_drop_sync_group;
+        z_result_t wait_ret = _z_sync_group_check(group) ? _z_sync_group_wait(group) : _Z_RES_OK;
+        _Z_SET_IF_OK(ret, wait_ret);
+    }
+#if Z_FEATURE_SESSION_CHECK == 1
+    _z_session_rc_drop(&sess_rc);
+#endif
+    z_free(ids);
+    z_free(pos);
+    z_free(rcs);
+    z_free(n_msgs);
+    return ret;
+}
+
 z_result_t _z_send_reply(const _z_query_t *query, const _z_session_rc_t *zsrc, const _z_declared_keyexpr_t *keyexpr,
                          _z_bytes_t *payload, _z_encoding_t *encoding, const z_sample_kind_t kind, bool is_express,
                          const _z_timestamp_t *timestamp, _z_bytes_t *att, _z_source_info_t *source_info) {
@@ -580,11 +1147,11 @@ z_result_t _z_query(const _z_session_rc_t *session, _z_optional_id_t querier_id,
     // Add the pending query to the current session
     _z_zint_t qid;
     z_result_t ret = _Z_RES_OK;
-    _Z_CLEAN_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn), _z_keyexpr_clear(&ke_query);
+    _Z_CLEAN_RETURN_IF_ERR(_z_session_queries_mutex_lock_if_open(zn), _z_keyexpr_clear(&ke_query);
                            _z_drop_handler_execute(dropper, arg));
     _z_pending_query_t *pq = _z_unsafe_register_pending_query(zn);
     if (pq == NULL) {
-        _z_session_mutex_unlock(zn);
+        _z_session_queries_mutex_unlock(zn);
         _z_keyexpr_clear(&ke_query);
         _z_drop_handler_execute(dropper, arg);
         return _Z_ERR_SYSTEM_OUT_OF_MEMORY;
@@ -609,7 +1176,7 @@ z_result_t _z_query(const _z_session_rc_t *session, _z_optional_id_t querier_id,
 #else
     _ZP_UNUSED(opt_cancellation_token);
 #endif
-    _z_session_mutex_unlock(zn);
+    _z_session_queries_mutex_unlock(zn);
     // Send query message
     _z_slice_t params =
         (parameters == NULL) ? _z_slice_null() : _z_slice_alias_buf((uint8_t *)parameters, parameters_len);
@@ -647,10 +1214,7 @@ uint32_t _z_add_interest(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr,
     }
 
     // Create interest entry, stored at session-level, do not drop it by the end of this function.
-    _z_session_interest_rc_t *sintr = _z_register_interest(zn, &intr);
-    if (sintr == NULL) {
-        _z_void_rc_drop(&intr._arg);
-        _z_keyexpr_clear(&intr._key);
+    if (_z_register_interest(zn, &intr) != _Z_RES_OK) {
         return 0;
     }
     // Build the interest message to send on the wire (only needed in client mode or multicast transport or when
@@ -665,7 +1229,7 @@ uint32_t _z_add_interest(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr,
         _z_network_message_t n_msg;
         _z_n_msg_make_interest(&n_msg, interest);
         if (_z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) != _Z_RES_OK) {
-            _z_unregister_interest(zn, sintr);
+            _z_unregister_interest(zn, intr._id);
             return 0;
         }
 #if Z_FEATURE_AUTO_RECONNECT == 1
@@ -680,17 +1244,18 @@ uint32_t _z_add_interest(_z_session_t *zn, const _z_declared_keyexpr_t *keyexpr,
 
 z_result_t _z_remove_interest(_z_session_t *zn, uint32_t interest_id) {
     // Find interest entry
-    _z_session_interest_rc_t *sintr = _z_get_interest_by_id(zn, interest_id);
-    if (sintr == NULL) {
+    _z_session_interest_rc_t sintr = _z_get_interest_by_id(zn, interest_id);
+    if (_Z_RC_IS_NULL(&sintr)) {
         _Z_ERROR_RETURN(_Z_ERR_ENTITY_UNKNOWN);
     }
+    _z_session_interest_rc_drop(&sintr);
     // Build the declare message to send on the wire (only needed in client mode or multicast transport)
     if (zn->_mode == Z_WHATAMI_CLIENT
 #if Z_FEATURE_MULTICAST_DECLARATIONS == 1
         || (zn->_tp._type == _Z_TRANSPORT_MULTICAST_TYPE)
 #endif
     ) {
-        _z_interest_t interest = _z_make_interest_final(_Z_RC_IN_VAL(sintr)->_id);
+        _z_interest_t interest = _z_make_interest_final(interest_id);
         _z_network_message_t n_msg;
         _z_n_msg_make_interest(&n_msg, interest);
         if (_z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) != _Z_RES_OK) {
@@ -702,7 +1267,7 @@ z_result_t _z_remove_interest(_z_session_t *zn, uint32_t interest_id) {
         _z_n_msg_clear(&n_msg);
     }
     // Only if message is successfully send, session interest can be removed
-    _z_unregister_interest(zn, sintr);
+    _z_unregister_interest(zn, interest_id);
     return _Z_RES_OK;
 }
 #endif
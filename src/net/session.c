@@ -22,6 +22,7 @@
 #include "zenoh-pico/api/constants.h"
 #include "zenoh-pico/collections/string.h"
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/net/config.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/definitions/declarations.h"
 #include "zenoh-pico/protocol/definitions/network.h"
@@ -47,7 +48,8 @@
 #include "zenoh-pico/utils/uuid.h"
 
 #if Z_FEATURE_SCOUTING == 1
-static z_result_t _z_locators_by_scout(const _z_config_t *config, const _z_id_t *zid, _z_string_svec_t *locators) {
+static z_result_t _z_locators_by_scout(_z_session_t *zn, const _z_config_t *config, const _z_id_t *zid,
+                                       _z_string_svec_t *locators) {
     z_result_t ret = _Z_RES_OK;
 
     char *opt_as_str = _z_config_get(config, Z_CONFIG_SCOUTING_WHAT_KEY);
@@ -56,11 +58,9 @@ static z_result_t _z_locators_by_scout(const _z_config_t *config, const _z_id_t
     }
     z_what_t what = strtol(opt_as_str, NULL, 10);
 
-    opt_as_str = _z_config_get(config, Z_CONFIG_MULTICAST_LOCATOR_KEY);
-    if (opt_as_str == NULL) {
-        opt_as_str = (char *)Z_CONFIG_MULTICAST_LOCATOR_DEFAULT;
-    }
-    _z_string_t mcast_locator = _z_string_alias_str(opt_as_str);
+    _z_string_svec_t mcast_locators = _z_string_svec_make(1);
+    _Z_CLEAN_RETURN_IF_ERR(_z_config_get_scouting_locators(config, &mcast_locators),
+                           _z_string_svec_clear(&mcast_locators));
 
     opt_as_str = _z_config_get(config, Z_CONFIG_SCOUTING_TIMEOUT_KEY);
     if (opt_as_str == NULL) {
@@ -69,7 +69,8 @@ static z_result_t _z_locators_by_scout(const _z_config_t *config, const _z_id_t
     uint32_t timeout = (uint32_t)strtoul(opt_as_str, NULL, 10);
 
     // Scout and return upon the first result
-    _z_hello_slist_t *hellos = _z_scout_inner(what, *zid, &mcast_locator, timeout, true);
+    _z_hello_slist_t *hellos = _z_scout_inner(what, *zid, &mcast_locators, timeout, true, &zn->_scout_zbuf);
+    _z_string_svec_clear(&mcast_locators);
     if (hellos != NULL) {
         _z_hello_t *hello = _z_hello_slist_value(hellos);
         _z_string_svec_copy(locators, &hello->_locators, true);
@@ -78,7 +79,9 @@ static z_result_t _z_locators_by_scout(const _z_config_t *config, const _z_id_t
     return ret;
 }
 #else
-static z_result_t _z_locators_by_scout(const _z_config_t *config, const _z_id_t *zid, _z_string_svec_t *locators) {
+static z_result_t _z_locators_by_scout(_z_session_t *zn, const _z_config_t *config, const _z_id_t *zid,
+                                       _z_string_svec_t *locators) {
+    _ZP_UNUSED(zn);
     _ZP_UNUSED(config);
     _ZP_UNUSED(zid);
     _ZP_UNUSED(locators);
@@ -466,6 +469,24 @@ z_result_t _z_open_locators(_z_session_rc_t *zn, const _z_string_svec_t *listen_
     }
 }
 
+#if (Z_FEATURE_SUBSCRIPTION == 1 || Z_FEATURE_QUERYABLE == 1) && Z_FEATURE_RX_CACHE == 1
+// Applies Z_CONFIG_RX_CACHE_SIZE_KEY, the cache keeps its current capacity when the key is not set
+static z_result_t _z_open_rx_cache(_z_session_t *zn, _z_config_t *config) {
+    const char *opt_as_str = _z_config_get(config, Z_CONFIG_RX_CACHE_SIZE_KEY);
+    if (opt_as_str == NULL) {
+        return _Z_RES_OK;
+    }
+    int32_t capacity = 0;
+    if (!_z_str_parse_i32(opt_as_str, &capacity) || (capacity < 0)) {
+        _Z_ERROR("Invalid rx cache size: %s", opt_as_str);
+        _Z_ERROR_RETURN(_Z_ERR_CONFIG_INVALID_VALUE);
+    }
+#if Z_FEATURE_SUBSCRIPTION == 1
+    _z_session_subscription_cache_mutex_lock(zn);
+    _z_subscription_lru_cache_resize(&zn->_subscription_cache, (size_t)capacity);
+    _z_session_subscription_cache_mutex_unlock(zn);
+#endif
+
 /**
  * Open transports based on the configured listen and connect locators.
  *
@@ -507,6 +528,15 @@ z_result_t _z_open_locators(_z_session_rc_t *zn, const _z_string_svec_t *listen_
  * - An error if no primary transport could be established, or if peer policy requires
  *   failure (e.g. exit-on-failure with incomplete connectivity).
  */
+#if Z_FEATURE_QUERYABLE == 1
+    _z_session_queryables_mutex_lock(zn);
+    _z_queryable_lru_cache_resize(&zn->_queryable_cache, (size_t)capacity);
+    _z_session_queryables_mutex_unlock(zn);
+#endif
+    return _Z_RES_OK;
+}
+#endif
+
 z_result_t _z_open(_z_session_rc_t *zn, _z_config_t *config, const _z_id_t *zid) {
     z_result_t ret = _Z_RES_OK;
     _Z_RC_IN_VAL(zn)->_tp._type = _Z_TRANSPORT_NONE;
@@ -514,6 +544,9 @@ z_result_t _z_open(_z_session_rc_t *zn, _z_config_t *config, const _z_id_t *zid)
     _z_string_svec_t listen_locators = _z_string_svec_null();
     _z_string_svec_t connect_locators = _z_string_svec_null();
 
+#if (Z_FEATURE_SUBSCRIPTION == 1 || Z_FEATURE_QUERYABLE == 1) && Z_FEATURE_RX_CACHE == 1
+    _Z_RETURN_IF_ERR(_z_open_rx_cache(_Z_RC_IN_VAL(zn), config));
+#endif
     ret = _z_locators_by_config(config, &listen_locators, &connect_locators);
     if (ret == _Z_RES_OK) {
         z_whatami_t mode;
@@ -524,7 +557,7 @@ z_result_t _z_open(_z_session_rc_t *zn, _z_config_t *config, const _z_id_t *zid)
             if ((_z_string_svec_len(&listen_locators) > 0) || (_z_string_svec_len(&connect_locators) > 0)) {
                 ret = _z_open_locators(zn, &listen_locators, &connect_locators, zid, config, mode);
             } else {
-                ret = _z_locators_by_scout(config, zid, &connect_locators);
+                ret = _z_locators_by_scout(_Z_RC_IN_VAL(zn), config, zid, &connect_locators);
                 if (ret == _Z_RES_OK) {
                     if (_z_string_svec_len(&connect_locators) == 0) {
                         ret = _Z_ERR_SCOUT_NO_RESULTS;
@@ -584,22 +617,14 @@ _z_fut_fn_result_t _z_client_reopen_task_fn(void *ztc_arg, _z_executor_t *execut
     }
 
     tc->_tasks = tasks_handles;
-    if (!_z_network_message_slist_is_empty(s->_declaration_cache)) {
-        _z_network_message_slist_t *iter = s->_declaration_cache;
-        while (iter != NULL) {
-            _z_network_message_t *n_msg = _z_network_message_slist_value(iter);
-            ret = _z_send_n_msg(s, n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL);
-            if (ret != _Z_RES_OK) {
-                _Z_DEBUG("Send message during reopen failed: %i", ret);
-                _z_transport_clear(&s->_tp);
-                tc->_session = _z_session_rc_clone_as_weak(&zs);
-                tc->_state = _Z_TRANSPORT_STATE_RECONNECTING;
-                _z_session_rc_drop(&zs);
-                return _z_fut_fn_result_continue();
-            }
-
-            iter = _z_network_message_slist_next(iter);
-        }
+    ret = _z_replay_declarations(s);
+    if (ret != _Z_RES_OK) {
+        _Z_DEBUG("Send message during reopen failed: %i", ret);
+        _z_transport_clear(&s->_tp);
+        tc->_session = _z_session_rc_clone_as_weak(&zs);
+        tc->_state = _Z_TRANSPORT_STATE_RECONNECTING;
+        _z_session_rc_drop(&zs);
+        return _z_fut_fn_result_continue();
     }
     _z_session_rc_drop(&zs);
     _Z_DEBUG("Reconnected successfully");
@@ -610,71 +635,48 @@ _z_fut_fn_result_t _z_client_reopen_task_fn(void *ztc_arg, _z_executor_t *execut
     return _z_fut_fn_result_ready();
 }
 
-void _z_cache_declaration(_z_session_t *zs, const _z_network_message_t *n_msg) {
+void _z_cache_declaration(_z_session_t *zs, const _z_network_message_t *n_msg) { _z_cache_declarations(zs, n_msg, 1); }
+
+void _z_cache_declarations(_z_session_t *zs, const _z_network_message_t *n_msgs, size_t len) {
     if (_z_config_is_empty(&zs->_config)) {
         return;
     }
-    zs->_declaration_cache = _z_network_message_slist_push_back(zs->_declaration_cache, n_msg);
+    z_result_t ret = _z_declaration_cache_insert_many(&zs->_declaration_cache, n_msgs, len);
+    if (ret != _Z_RES_OK) {
+        _Z_ERROR("Failed to cache declaration, it will not be restored on reconnection: %i", ret);
+    }
 }
 
-#define _Z_CACHE_DECLARATION_UNDECLARE_FILTER(tp)                                                                     \
-    static bool _z_cache_declaration_undeclare_filter_##tp(const _z_network_message_t *left,                          \
-                                                           const _z_network_message_t *right) {                       \
-        return left->_tag == _Z_N_DECLARE && right->_tag == _Z_N_DECLARE &&                                           \
-               left->_body._declare._decl._body._undecl_##tp._id == right->_body._declare._decl._body._decl_##tp._id; \
-    }
-_Z_CACHE_DECLARATION_UNDECLARE_FILTER(kexpr)
-_Z_CACHE_DECLARATION_UNDECLARE_FILTER(subscriber)
-_Z_CACHE_DECLARATION_UNDECLARE_FILTER(queryable)
-_Z_CACHE_DECLARATION_UNDECLARE_FILTER(token)
-
-static bool _z_cache_declaration_undeclare_filter_interest(const _z_network_message_t *left,
-                                                           const _z_network_message_t *right) {
-    return left->_tag == _Z_N_INTEREST && right->_tag == _Z_N_INTEREST &&
-           left->_body._interest._interest._id == right->_body._interest._interest._id;
-}
+void _z_prune_declaration(_z_session_t *zs, const _z_network_message_t *n_msg) { _z_prune_declarations(zs, n_msg, 1); }
 
-void _z_prune_declaration(_z_session_t *zs, const _z_network_message_t *n_msg) {
+void _z_prune_declarations(_z_session_t *zs, const _z_network_message_t *n_msgs, size_t len) {
+    size_t removed = _z_declaration_cache_remove_many(&zs->_declaration_cache, n_msgs, len);
 #ifdef Z_BUILD_DEBUG
-    size_t cnt_before = _z_network_message_slist_len(zs->_declaration_cache);
+    assert((removed == len) || _z_config_is_empty(&zs->_config));
+#else
+    _ZP_UNUSED(removed);
 #endif
-    switch (n_msg->_tag) {
-        case _Z_N_DECLARE: {
-            const _z_declaration_t *decl = &n_msg->_body._declare._decl;
-            switch (decl->_tag) {
-                case _Z_UNDECL_KEXPR:
-                    zs->_declaration_cache = _z_network_message_slist_drop_first_filter(
-                        zs->_declaration_cache, _z_cache_declaration_undeclare_filter_kexpr, n_msg);
-                    break;
-                case _Z_UNDECL_SUBSCRIBER:
-                    zs->_declaration_cache = _z_network_message_slist_drop_first_filter(
-                        zs->_declaration_cache, _z_cache_declaration_undeclare_filter_subscriber, n_msg);
-                    break;
-                case _Z_UNDECL_QUERYABLE:
-                    zs->_declaration_cache = _z_network_message_slist_drop_first_filter(
-                        zs->_declaration_cache, _z_cache_declaration_undeclare_filter_queryable, n_msg);
-                    break;
-                case _Z_UNDECL_TOKEN:
-                    zs->_declaration_cache = _z_network_message_slist_drop_first_filter(
-                        zs->_declaration_cache, _z_cache_declaration_undeclare_filter_token, n_msg);
-                    break;
-                default:
-                    _Z_ERROR("Invalid decl for _z_prune_declaration: %i", decl->_tag);
-            };
-            break;
+}
+
+static z_result_t _z_replay_declarations_send(const _z_network_message_t *n_msgs, size_t len, void *arg) {
+    return _z_send_n_msgs((_z_session_t *)arg, n_msgs, len, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK);
+}
+
+z_result_t _z_replay_declarations(_z_session_t *zs) {
+#if Z_FEATURE_BATCHING == 1
+    // Chunks of declarations are appended back to back to the same batch, which is only flushed when full
+    bool batching = (_z_transport_start_batching(&zs->_tp) == _Z_RES_OK);
+#endif
+    z_result_t ret = _z_declaration_cache_replay(&zs->_declaration_cache, _z_replay_declarations_send, zs);
+#if Z_FEATURE_BATCHING == 1
+    if (batching) {
+        _z_transport_stop_batching(&zs->_tp);
+        if (ret == _Z_RES_OK) {
+            ret = _z_send_n_batch(zs, Z_CONGESTION_CONTROL_BLOCK);
         }
-        case _Z_N_INTEREST:
-            zs->_declaration_cache = _z_network_message_slist_drop_first_filter(
-                zs->_declaration_cache, _z_cache_declaration_undeclare_filter_interest, n_msg);
-            break;
-        default:
-            _Z_ERROR("Invalid net message for _z_prune_declaration: %i", n_msg->_tag);
-            return;
-    };
-#ifdef Z_BUILD_DEBUG
-    size_t cnt_after = _z_network_message_slist_len(zs->_declaration_cache);
-    assert(cnt_before == cnt_after + 1);
+    }
 #endif
+    return ret;
 }
 #endif  // Z_FEATURE_AUTO_RECONNECT == 1
 
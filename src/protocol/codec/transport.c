@@ -203,10 +203,15 @@ z_result_t _z_init_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_init_t
         _Z_RETURN_IF_ERR(_z_slice_encode(wbf, &msg->_cookie))
     }
 
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    bool has_compression = msg->_compression;
+#else
+    bool has_compression = false;
+#endif
 #if Z_FEATURE_FRAGMENTATION == 1
     if (msg->_patch != _Z_NO_PATCH) {
         if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
-            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_PATCH));
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_INIT_PATCH | _Z_MSG_EXT_MORE(has_compression)));
             _Z_RETURN_IF_ERR(_z_zint64_encode(wbf, msg->_patch));
         } else {
             _Z_DEBUG("Attempted to serialize Patch extension, but the header extension flag was unset");
@@ -214,6 +219,14 @@ z_result_t _z_init_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_init_t
         }
     }
 #endif
+    if (has_compression) {
+        if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_INIT_COMPRESSION));
+        } else {
+            _Z_DEBUG("Attempted to serialize Compression extension, but the header extension flag was unset");
+            ret |= _Z_ERR_MESSAGE_SERIALIZATION_FAILED;
+        }
+    }
 
     return ret;
 }
@@ -226,6 +239,11 @@ z_result_t _z_init_decode_ext(_z_msg_ext_t *extension, void *ctx) {
     } else if (_Z_EXT_FULL_ID(extension->_header) == _Z_MSG_EXT_ID_INIT_PATCH) {
         _z_t_msg_init_t *msg = (_z_t_msg_init_t *)ctx;
         msg->_patch = (uint8_t)extension->_body._zint._val;
+#endif
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    } else if (_Z_EXT_FULL_ID(extension->_header) == _Z_MSG_EXT_ID_INIT_COMPRESSION) {
+        _z_t_msg_init_t *msg = (_z_t_msg_init_t *)ctx;
+        msg->_compression = true;
 #endif
     } else if (_Z_MSG_EXT_IS_MANDATORY(extension->_header)) {
         _Z_ERROR_LOG(_Z_ERR_MESSAGE_EXTENSION_MANDATORY_AND_UNKNOWN);
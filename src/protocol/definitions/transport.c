@@ -146,6 +146,9 @@ _z_transport_message_t _z_t_msg_make_init_syn(z_whatami_t whatami, _z_id_t zid)
 #if Z_FEATURE_FRAGMENTATION == 1
     msg._body._init._patch = _Z_CURRENT_PATCH;
 #endif
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    msg._body._init._compression = false;
+#endif
 
     if ((msg._body._init._batch_size != _Z_DEFAULT_UNICAST_BATCH_SIZE) ||
         (msg._body._init._seq_num_res != _Z_DEFAULT_RESOLUTION_SIZE) ||
@@ -177,6 +180,9 @@ _z_transport_message_t _z_t_msg_make_init_ack(z_whatami_t whatami, _z_id_t zid,
 #if Z_FEATURE_FRAGMENTATION == 1
     msg._body._init._patch = _Z_CURRENT_PATCH;
 #endif
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    msg._body._init._compression = false;
+#endif
 
     if ((msg._body._init._batch_size != _Z_DEFAULT_UNICAST_BATCH_SIZE) ||
         (msg._body._init._seq_num_res != _Z_DEFAULT_RESOLUTION_SIZE) ||
@@ -331,6 +337,9 @@ void _z_t_msg_copy_init(_z_t_msg_init_t *clone, _z_t_msg_init_t *msg) {
 #if Z_FEATURE_FRAGMENTATION == 1
     clone->_patch = msg->_patch;
 #endif
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    clone->_compression = msg->_compression;
+#endif
 }
 
 void _z_t_msg_copy_open(_z_t_msg_open_t *clone, _z_t_msg_open_t *msg) {
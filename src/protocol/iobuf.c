@@ -348,6 +348,28 @@ z_result_t _z_wbuf_write_bytes(_z_wbuf_t *wbf, const uint8_t *bs, size_t offset,
     return _Z_RES_OK;
 }
 
+uint8_t *_z_wbuf_reserve(_z_wbuf_t *wbf, size_t length) {
+    _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, wbf->_w_idx);
+    if (_z_iosli_writable(ios) < length) {
+        // Reserved bytes must be contiguous, so they can only go in a new slice appended at the end
+        if ((wbf->_expansion_step == 0) || (wbf->_ioss._len > wbf->_w_idx + 1)) {
+            return NULL;
+        }
+        _z_iosli_t tmp = _z_iosli_make((length > wbf->_expansion_step) ? length : wbf->_expansion_step);
+        if (tmp._capacity < length) {
+            return NULL;
+        }
+        if (_z_wbuf_add_iosli(wbf, &tmp) != _Z_RES_OK) {
+            _z_iosli_clear(&tmp);
+            return NULL;
+        }
+        ios = _z_wbuf_get_iosli(wbf, wbf->_w_idx);
+    }
+    uint8_t *ptr = ios->_buf + ios->_w_pos;
+    ios->_w_pos += length;
+    return ptr;
+}
+
 z_result_t _z_wbuf_wrap_bytes(_z_wbuf_t *wbf, const uint8_t *bs, size_t offset, size_t length) {
     z_result_t ret = _Z_RES_OK;
 
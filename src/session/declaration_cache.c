@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/session/declaration_cache.h"
+
+#include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
+
+#if Z_FEATURE_AUTO_RECONNECT == 1
+
+static inline void _z_declaration_cache_lock(_z_declaration_cache_t *cache) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_lock(&cache->_mutex);
+#else
+    _ZP_UNUSED(cache);
+#endif
+}
+
+static inline void _z_declaration_cache_unlock(_z_declaration_cache_t *cache) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_unlock(&cache->_mutex);
+#else
+    _ZP_UNUSED(cache);
+#endif
+}
+
+// Returns the map holding the declaration of the entity a message declares or undeclares, and the entity id
+static _z_n_msg_id_hmap_t *_z_declaration_cache_map(_z_declaration_cache_t *cache, const _z_network_message_t *n_msg,
+                                                    uint32_t *id) {
+    if (n_msg->_tag == _Z_N_INTEREST) {
+        *id = n_msg->_body._interest._interest._id;
+        return &cache->_interests;
+    }
+    if (n_msg->_tag != _Z_N_DECLARE) {
+        return NULL;
+    }
+    const _z_declaration_t *decl = &n_msg->_body._declare._decl;
+    switch (decl->_tag) {
+        case _Z_DECL_KEXPR:
+            *id = decl->_body._decl_kexpr._id;
+            return &cache->_kexprs;
+        case _Z_UNDECL_KEXPR:
+            *id = decl->_body._undecl_kexpr._id;
+            return &cache->_kexprs;
+        case _Z_DECL_SUBSCRIBER:
+            *id = decl->_body._decl_subscriber._id;
+            return &cache->_subscribers;
+        case _Z_UNDECL_SUBSCRIBER:
+            *id = decl->_body._undecl_subscriber._id;
+            return &cache->_subscribers;
+        case _Z_DECL_QUERYABLE:
+            *id = decl->_body._decl_queryable._id;
+            return &cache->_queryables;
+        case _Z_UNDECL_QUERYABLE:
+            *id = decl->_body._undecl_queryable._id;
+            return &cache->_queryables;
+        case _Z_DECL_TOKEN:
+            *id = decl->_body._decl_token._id;
+            return &cache->_tokens;
+        case _Z_UNDECL_TOKEN:
+            *id = decl->_body._undecl_token._id;
+            return &cache->_tokens;
+        default:
+            return NULL;
+    }
+}
+
+z_result_t _z_declaration_cache_init(_z_declaration_cache_t *cache) {
+    cache->_kexprs = _z_n_msg_id_hmap_new();
+    cache->_subscribers = _z_n_msg_id_hmap_new();
+    cache->_queryables = _z_n_msg_id_hmap_new();
+    cache->_tokens = _z_n_msg_id_hmap_new();
+    cache->_interests = _z_n_msg_id_hmap_new();
+#if Z_FEATURE_MULTI_THREAD == 1
+    _Z_RETURN_IF_ERR(_z_mutex_init(&cache->_mutex));
+#endif
+    return _Z_RES_OK;
+}
+
+void _z_declaration_cache_clear(_z_declaration_cache_t *cache) {
+    _z_declaration_cache_lock(cache);
+    _z_n_msg_id_hmap_destroy(&cache->_kexprs);
+    _z_n_msg_id_hmap_destroy(&cache->_subscribers);
+    _z_n_msg_id_hmap_destroy(&cache->_queryables);
+    _z_n_msg_id_hmap_destroy(&cache->_tokens);
+    _z_n_msg_id_hmap_destroy(&cache->_interests);
+    _z_declaration_cache_unlock(cache);
+}
+
+void _z_declaration_cache_drop(_z_declaration_cache_t *cache) {
+    _z_declaration_cache_clear(cache);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_drop(&cache->_mutex);
+#endif
+}
+
+size_t _z_declaration_cache_len(_z_declaration_cache_t *cache) {
+    _z_declaration_cache_lock(cache);
+    size_t len = _z_n_msg_id_hmap_size(&cache->_kexprs) + _z_n_msg_id_hmap_size(&cache->_subscribers) +
+                 _z_n_msg_id_hmap_size(&cache->_queryables) + _z_n_msg_id_hmap_size(&cache->_tokens) +
+                 _z_n_msg_id_hmap_size(&cache->_interests);
+    _z_declaration_cache_unlock(cache);
+    return len;
+}
+
+static z_result_t _z_declaration_cache_unsafe_insert(_z_declaration_cache_t *cache, const _z_network_message_t *n_msg) {
+    uint32_t id = 0;
+    _z_n_msg_id_hmap_t *map = _z_declaration_cache_map(cache, n_msg, &id);
+    if (map == NULL) {
+        _Z_ERROR("Invalid message for the declaration cache: %i", n_msg->_tag);
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    _z_network_message_t copy;
+    _Z_RETURN_IF_ERR(_z_n_msg_copy(&copy, n_msg));
+    if (_z_n_msg_id_hmap_insert(map, &id, &copy) == _z_n_msg_id_hmap_end(map)) {
+        _z_n_msg_clear(&copy);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _Z_RES_OK;
+}
+
+z_result_t _z_declaration_cache_insert(_z_declaration_cache_t *cache, const _z_network_message_t *n_msg) {
+    return _z_declaration_cache_insert_many(cache, n_msg, 1);
+}
+
+z_result_t _z_declaration_cache_insert_many(_z_declaration_cache_t *cache, const _z_network_message_t *n_msgs,
+                                            size_t len) {
+    z_result_t ret = _Z_RES_OK;
+    _z_declaration_cache_lock(cache);
+    for (size_t i = 0; (ret == _Z_RES_OK) && (i < len); i++) {
+        ret = _z_declaration_cache_unsafe_insert(cache, &n_msgs[i]);
+    }
+    _z_declaration_cache_unlock(cache);
+    return ret;
+}
+
+bool _z_declaration_cache_remove(_z_declaration_cache_t *cache, const _z_network_message_t *n_msg) {
+    return _z_declaration_cache_remove_many(cache, n_msg, 1) == 1;
+}
+
+size_t _z_declaration_cache_remove_many(_z_declaration_cache_t *cache, const _z_network_message_t *n_msgs,
+                                        size_t len) {
+    size_t removed = 0;
+    _z_declaration_cache_lock(cache);
+    for (size_t i = 0; i < len; i++) {
+        uint32_t id = 0;
+        _z_n_msg_id_hmap_t *map = _z_declaration_cache_map(cache, &n_msgs[i], &id);
+        if (map == NULL) {
+            _Z_ERROR("Invalid message for the declaration cache: %i", n_msgs[i]._tag);
+        } else if (_z_n_msg_id_hmap_remove(map, &id, NULL)) {
+            removed++;
+        }
+    }
+    _z_declaration_cache_unlock(cache);
+    return removed;
+}
+
+// Hands the messages of map to fn through chunk, which holds count pending messages on entry and on return
+static z_result_t _z_declaration_cache_replay_map(_z_n_msg_id_hmap_t *map, _z_network_message_t *chunk,
+                                                  size_t *count, _z_declaration_cache_replay_fn fn, void *arg) {
+    for (_z_n_msg_id_hmap_iter_t it = _z_n_msg_id_hmap_begin(map); it != _z_n_msg_id_hmap_end(map);
+         it = _z_n_msg_id_hmap_iter_next(map, it)) {
+        // Borrowed bitwise copy, the map keeps ownership
+        chunk[(*count)++] = _z_n_msg_id_hmap_at(map, it)->val;
+        if (*count == _Z_DECLARATION_CACHE_REPLAY_CHUNK) {
+            *count = 0;
+            _Z_RETURN_IF_ERR(fn(chunk, _Z_DECLARATION_CACHE_REPLAY_CHUNK, arg));
+        }
+    }
+    return _Z_RES_OK;
+}
+
+z_result_t _z_declaration_cache_replay(_z_declaration_cache_t *cache, _z_declaration_cache_replay_fn fn, void *arg) {
+    _z_network_message_t *chunk =
+        (_z_network_message_t *)z_malloc(sizeof(_z_network_message_t) * _Z_DECLARATION_CACHE_REPLAY_CHUNK);
+    if (chunk == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    _z_n_msg_id_hmap_t *maps[] = {&cache->_kexprs, &cache->_subscribers, &cache->_queryables, &cache->_tokens,
+                                  &cache->_interests};
+    size_t count = 0;
+    z_result_t ret = _Z_RES_OK;
+
+    _z_declaration_cache_lock(cache);
+    for (size_t i = 0; (ret == _Z_RES_OK) && (i < _ZP_ARRAY_SIZE(maps)); i++) {
+        ret = _z_declaration_cache_replay_map(maps[i], chunk, &count, fn, arg);
+    }
+    if ((ret == _Z_RES_OK) && (count > 0)) {
+        ret = fn(chunk, count, arg);
+    }
+    _z_declaration_cache_unlock(cache);
+
+    z_free(chunk);
+    return ret;
+}
+
+#endif  // Z_FEATURE_AUTO_RECONNECT == 1
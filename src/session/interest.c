@@ -63,12 +63,13 @@ static z_result_t _z_interest_send_decl_resource(_z_session_t *zn, uint32_t inte
 #if Z_FEATURE_SUBSCRIPTION == 1
 static z_result_t _z_interest_send_decl_subscriber(_z_session_t *zn, uint32_t interest_id, void *peer,
                                                    const _z_keyexpr_t *restr_key) {
-    _Z_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn));
-    _z_subscription_rc_slist_t *sub_list = _z_subscription_rc_slist_clone(zn->_subscriptions);
-    _z_session_mutex_unlock(zn);
-    _z_subscription_rc_slist_t *xs = sub_list;
-    while (xs != NULL) {
-        _z_subscription_rc_t *sub = _z_subscription_rc_slist_value(xs);
+    _Z_RETURN_IF_ERR(_z_session_subscriptions_mutex_lock_if_open(zn));
+    _z_subscription_rc_svec_t sub_list = _z_subscription_rc_svec_null();
+    z_result_t ret = _z_subscription_rc_hmap_snapshot(&zn->_subscriptions, &sub_list);
+    _z_session_subscriptions_mutex_unlock(zn);
+    _Z_RETURN_IF_ERR(ret);
+    for (size_t i = 0; i < _z_subscription_rc_svec_len(&sub_list); i++) {
+        _z_subscription_rc_t *sub = _z_subscription_rc_svec_get(&sub_list, i);
         // Check if key is concerned
         if (restr_key == NULL || _z_keyexpr_intersects(restr_key, &_Z_RC_IN_VAL(sub)->_key._inner)) {
             // Build the declare message to send on the wire
@@ -76,16 +77,15 @@ static z_result_t _z_interest_send_decl_subscriber(_z_session_t *zn, uint32_t in
             _z_declaration_t declaration = _z_make_decl_subscriber(&wireexpr, _Z_RC_IN_VAL(sub)->_id);
             _z_network_message_t n_msg;
             _z_n_msg_make_declare(&n_msg, declaration, _z_optional_id_make_some(interest_id));
-            z_result_t ret = _z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, peer);
+            ret = _z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, peer);
             _z_n_msg_clear(&n_msg);
             if (ret != _Z_RES_OK) {
-                _z_subscription_rc_slist_free(&sub_list);
+                _z_subscription_rc_svec_clear(&sub_list);
                 _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
             }
         }
-        xs = _z_subscription_rc_slist_next(xs);
     }
-    _z_subscription_rc_slist_free(&sub_list);
+    _z_subscription_rc_svec_clear(&sub_list);
     return _Z_RES_OK;
 }
 #else
@@ -102,12 +102,13 @@ static z_result_t _z_interest_send_decl_subscriber(_z_session_t *zn, uint32_t in
 #if Z_FEATURE_QUERYABLE == 1
 static z_result_t _z_interest_send_decl_queryable(_z_session_t *zn, uint32_t interest_id, void *peer,
                                                   const _z_keyexpr_t *restr_key) {
-    _Z_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn));
-    _z_session_queryable_rc_slist_t *qle_list = _z_session_queryable_rc_slist_clone(zn->_local_queryable);
-    _z_session_mutex_unlock(zn);
-    _z_session_queryable_rc_slist_t *xs = qle_list;
-    while (xs != NULL) {
-        _z_session_queryable_rc_t *qle = _z_session_queryable_rc_slist_value(xs);
+    _Z_RETURN_IF_ERR(_z_session_queryables_mutex_lock_if_open(zn));
+    _z_session_queryable_rc_svec_t qle_list = _z_session_queryable_rc_svec_null();
+    z_result_t ret = _z_session_queryable_rc_hmap_snapshot(&zn->_local_queryable, &qle_list);
+    _z_session_queryables_mutex_unlock(zn);
+    _Z_RETURN_IF_ERR(ret);
+    for (size_t i = 0; i < _z_session_queryable_rc_svec_len(&qle_list); i++) {
+        _z_session_queryable_rc_t *qle = _z_session_queryable_rc_svec_get(&qle_list, i);
         // Check if key is concerned
         if (restr_key == NULL || _z_keyexpr_intersects(restr_key, &_Z_RC_IN_VAL(qle)->_key._inner)) {
             // Build the declare message to send on the wire
@@ -116,16 +117,15 @@ static z_result_t _z_interest_send_decl_queryable(_z_session_t *zn, uint32_t int
                 &wireexpr, _Z_RC_IN_VAL(qle)->_id, _Z_RC_IN_VAL(qle)->_complete, _Z_QUERYABLE_DISTANCE_DEFAULT);
             _z_network_message_t n_msg;
             _z_n_msg_make_declare(&n_msg, declaration, _z_optional_id_make_some(interest_id));
-            z_result_t ret = _z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, peer);
+            ret = _z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, peer);
             _z_n_msg_clear(&n_msg);
             if (ret != _Z_RES_OK) {
-                _z_session_queryable_rc_slist_free(&qle_list);
+                _z_session_queryable_rc_svec_clear(&qle_list);
                 _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
             }
         }
-        xs = _z_session_queryable_rc_slist_next(xs);
     }
-    _z_session_queryable_rc_slist_free(&qle_list);
+    _z_session_queryable_rc_svec_clear(&qle_list);
     return _Z_RES_OK;
 }
 #else
@@ -240,125 +240,121 @@ void _z_session_interest_clear(_z_session_interest_t *intr) {
 }
 
 /*------------------ interest ------------------*/
-static _z_session_interest_rc_t *__z_get_interest_by_id(_z_session_interest_rc_slist_t *intrs, const _z_zint_t id) {
-    _z_session_interest_rc_t *ret = NULL;
-    _z_session_interest_rc_slist_t *xs = intrs;
-    while (xs != NULL) {
-        _z_session_interest_rc_t *intr = _z_session_interest_rc_slist_value(xs);
-        if (id == _Z_RC_IN_VAL(intr)->_id) {
-            ret = intr;
-            break;
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static z_result_t __unsafe_z_get_interest_by_key_and_flags(_z_session_t *zn, uint8_t flags, const _z_keyexpr_t *key,
+                                                           _z_optional_id_t interest_id,
+                                                           _z_session_interest_rc_svec_t *out) {
+    *out = _z_session_interest_rc_svec_null();
+    _z_session_interest_rc_hmap_t *intrs = &zn->_local_interests;
+    // consider only interests with matching id if specified (which corresponds to CURRENT interest response)
+    // ignore 0 id, since it is the one initially used by peers for declarations propagation
+    if (interest_id.has_value && interest_id.value != 0) {
+        _z_session_interest_rc_t *intr = _z_session_interest_rc_hmap_get(intrs, &interest_id.value);
+        if ((intr == NULL) || ((_Z_RC_IN_VAL(intr)->_flags & flags) == 0)) {
+            return _Z_RES_OK;
         }
-        xs = _z_session_interest_rc_slist_next(xs);
     }
-    return ret;
-}
-
-static _z_session_interest_rc_slist_t *__z_get_interest_by_key_and_flags(_z_session_interest_rc_slist_t *intrs,
-                                                                         uint8_t flags, const _z_keyexpr_t *key,
-                                                                         _z_optional_id_t interest_id) {
-    _z_session_interest_rc_slist_t *ret = NULL;
-    _z_session_interest_rc_slist_t *xs = intrs;
-    while (xs != NULL) {
-        _z_session_interest_rc_t *intr = _z_session_interest_rc_slist_value(xs);
+    for (_z_session_interest_rc_hmap_iter_t it = _z_session_interest_rc_hmap_begin(intrs);
+         it != _z_session_interest_rc_hmap_end(intrs); it = _z_session_interest_rc_hmap_iter_next(intrs, it)) {
+        _z_session_interest_rc_t *intr = &_z_session_interest_rc_hmap_at(intrs, it)->val;
         if ((_Z_RC_IN_VAL(intr)->_flags & flags) == 0) {
-            xs = _z_session_interest_rc_slist_next(xs);
             continue;
         }
-        // consider only interests with matching id if specified (which corresponds to CURRENT interest response)
-        // ignore 0 id, since it is the one initially used by peers for declarations propagation
         if (interest_id.has_value && interest_id.value != 0 && interest_id.value != _Z_RC_IN_VAL(intr)->_id) {
-            xs = _z_session_interest_rc_slist_next(xs);
             continue;
         }
         bool is_matching = _z_session_interest_is_aggregate(_Z_RC_IN_VAL(intr))
                                ? _z_keyexpr_equals(&_Z_RC_IN_VAL(intr)->_key, key)
                                : _z_keyexpr_intersects(&_Z_RC_IN_VAL(intr)->_key, key);
-
         if (is_matching) {
-            ret = _z_session_interest_rc_slist_push_empty(ret);
-            _z_session_interest_rc_t *new_intr = _z_session_interest_rc_slist_value(ret);
-            *new_intr = _z_session_interest_rc_clone(intr);
+            _z_session_interest_rc_t new_intr = _z_session_interest_rc_clone(intr);
+            _Z_CLEAN_RETURN_IF_ERR(_z_session_interest_rc_svec_append(out, &new_intr, false),
+                                   _z_session_interest_rc_drop(&new_intr);
+                                   _z_session_interest_rc_svec_clear(out));
         }
-        xs = _z_session_interest_rc_slist_next(xs);
     }
-    return ret;
-}
-
-/**
- * This function is unsafe because it operates in potentially concurrent data.
- * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
- */
-static _z_session_interest_rc_t *__unsafe_z_get_interest_by_id(_z_session_t *zn, const _z_zint_t id) {
-    _z_session_interest_rc_slist_t *intrs = zn->_local_interests;
-    return __z_get_interest_by_id(intrs, id);
+    return _Z_RES_OK;
 }
 
-/**
- * This function is unsafe because it operates in potentially concurrent data.
- * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
- */
-static _z_session_interest_rc_slist_t *__unsafe_z_get_interest_by_key_and_flags(_z_session_t *zn, uint8_t flags,
-                                                                                const _z_keyexpr_t *key,
-                                                                                _z_optional_id_t interest_id) {
-    _z_session_interest_rc_slist_t *intrs = zn->_local_interests;
-    return __z_get_interest_by_key_and_flags(intrs, flags, key, interest_id);
+static void _z_interest_trigger_callbacks(_z_session_interest_rc_svec_t *intrs, const _z_interest_msg_t *msg,
+                                          _z_transport_peer_common_t *peer) {
+    for (size_t i = 0; i < _z_session_interest_rc_svec_len(intrs); i++) {
+        _z_session_interest_t *intr = _Z_RC_IN_VAL(_z_session_interest_rc_svec_get(intrs, i));
+        if (intr->_callback != NULL) {
+            intr->_callback(msg, peer, _Z_RC_IN_VAL(&intr->_arg));
+        }
+    }
+    _z_session_interest_rc_svec_clear(intrs);
 }
 
-_z_session_interest_rc_t *_z_get_interest_by_id(_z_session_t *zn, const _z_zint_t id) {
+_z_session_interest_rc_t _z_get_interest_by_id(_z_session_t *zn, const _z_zint_t id) {
+    _z_session_interest_rc_t out = _z_session_interest_rc_null();
+    uint32_t key = (uint32_t)id;
     _z_session_mutex_lock(zn);
-    _z_session_interest_rc_t *intr = __unsafe_z_get_interest_by_id(zn, id);
+    _z_session_interest_rc_t *intr = _z_session_interest_rc_hmap_get(&zn->_local_interests, &key);
+    if (intr != NULL) {
+        out = _z_session_interest_rc_clone(intr);
+    }
     _z_session_mutex_unlock(zn);
-    return intr;
+    return out;
 }
 
-_z_session_interest_rc_t *_z_register_interest(_z_session_t *zn, _z_session_interest_t *intr) {
+z_result_t _z_register_interest(_z_session_t *zn, _z_session_interest_t *intr) {
     _Z_DEBUG(">>> Allocating interest for (%.*s)", (int)_z_string_len(&intr->_key._keyexpr),
              _z_string_data(&intr->_key._keyexpr));
-    _z_session_interest_rc_t *ret = NULL;
-
-    if (_z_session_mutex_lock_if_open(zn) != _Z_RES_OK) {
+    _z_session_interest_rc_t stored = _z_session_interest_rc_new_from_val(intr);
+    if (_Z_RC_IS_NULL(&stored)) {
+        _z_session_interest_clear(intr);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    z_result_t ret = _z_session_mutex_lock_if_open(zn);
+    if (ret != _Z_RES_OK) {
         _Z_WARN("Failed to acquire session mutex for registering interest for (%.*s) - session is closed",
                 (int)_z_string_len(&intr->_key._keyexpr), _z_string_data(&intr->_key._keyexpr));
+        _z_session_interest_rc_drop(&stored);
         return ret;
     }
-    zn->_local_interests = _z_session_interest_rc_slist_push_empty(zn->_local_interests);
-    ret = _z_session_interest_rc_slist_value(zn->_local_interests);
-    *ret = _z_session_interest_rc_new_from_val(intr);
+    uint32_t key = intr->_id;
+    if (_z_session_interest_rc_hmap_insert(&zn->_local_interests, &key, &stored) ==
+        _z_session_interest_rc_hmap_end(&zn->_local_interests)) {
+        ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    }
     _z_session_mutex_unlock(zn);
+    if (ret != _Z_RES_OK) {
+        _z_session_interest_rc_drop(&stored);
+    }
     return ret;
 }
 
 static z_result_t _unsafe_z_register_declare(_z_session_t *zn, const _z_keyexpr_t *key, uint32_t id, uint8_t type,
                                              bool complete, _z_transport_peer_common_t *peer) {
-    zn->_remote_declares = _z_declare_data_slist_push_empty(zn->_remote_declares);
-    _z_declare_data_t *decl = _z_declare_data_slist_value(zn->_remote_declares);
-    _z_keyexpr_copy(&decl->_key, key);
-    decl->_id = id;
-    decl->_type = type;
-    decl->_complete = complete;
-    decl->_peer = peer;
+    _z_declare_data_t decl;
+    _Z_RETURN_IF_ERR(_z_keyexpr_copy(&decl._key, key));
+    decl._id = id;
+    decl._type = type;
+    decl._complete = complete;
+    decl._peer = peer;
+    uint64_t decl_key = _z_declare_data_key(type, id);
+    if (_z_declare_data_hmap_insert(&zn->_remote_declares, &decl_key, &decl) ==
+        _z_declare_data_hmap_end(&zn->_remote_declares)) {
+        _z_declare_data_clear(&decl);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
     return _Z_RES_OK;
 }
 
 static _z_declare_data_t *_unsafe_z_get_declare(_z_session_t *zn, uint32_t id, uint8_t type) {
-    _z_declare_data_slist_t *xs = zn->_remote_declares;
-    _z_declare_data_t comp = {._key = _z_keyexpr_null(), ._id = id, ._type = type, ._complete = false};
-    while (xs != NULL) {
-        _z_declare_data_t *decl = _z_declare_data_slist_value(xs);
-        if (_z_declare_data_eq(&comp, decl)) {
-            return decl;
-        }
-        xs = _z_declare_data_slist_next(xs);
-    }
-    return NULL;
+    uint64_t decl_key = _z_declare_data_key(type, id);
+    return _z_declare_data_hmap_get(&zn->_remote_declares, &decl_key);
 }
 
 static z_result_t _unsafe_z_unregister_declare(_z_session_t *zn, uint32_t id, uint8_t type) {
-    _z_declare_data_t decl = {._key = _z_keyexpr_null(), ._id = id, ._type = type, ._complete = false};
-    zn->_remote_declares = _z_declare_data_slist_drop_first_filter(zn->_remote_declares, _z_declare_data_eq, &decl);
+    uint64_t decl_key = _z_declare_data_key(type, id);
+    _z_declare_data_hmap_remove(&zn->_remote_declares, &decl_key, NULL);
     return _Z_RES_OK;
 }
 
@@ -405,29 +401,24 @@ z_result_t _z_interest_process_declares(_z_session_t *zn, const _z_n_msg_declare
     msg.key = &key;
     // NOTE: it is possible that it is a redeclare of an existing entity - so we might need to update it
     _z_declare_data_t *prev_decl = _unsafe_z_get_declare(zn, msg.id, decl_type);
+    z_result_t ret = _Z_RES_OK;
     if (prev_decl != NULL) {  // possible change in queryable completness
         prev_decl->_complete = msg.is_complete;
     } else {
         // register new declare
-        _unsafe_z_register_declare(zn, &key, msg.id, decl_type, msg.is_complete, peer);
+        ret = _unsafe_z_register_declare(zn, &key, msg.id, decl_type, msg.is_complete, peer);
     }
     // Retrieve interests
-    _z_session_interest_rc_slist_t *intrs =
-        __unsafe_z_get_interest_by_key_and_flags(zn, flags, &key, decl->_interest_id);
+    _z_session_interest_rc_svec_t intrs = _z_session_interest_rc_svec_null();
+    _Z_SET_IF_OK(ret, __unsafe_z_get_interest_by_key_and_flags(zn, flags, &key, decl->_interest_id, &intrs));
     _z_session_mutex_unlock(zn);
     // update interests with new value
-    _z_session_interest_rc_slist_t *xs = intrs;
-    while (xs != NULL) {
-        _z_session_interest_rc_t *intr = _z_session_interest_rc_slist_value(xs);
-        if (_Z_RC_IN_VAL(intr)->_callback != NULL) {
-            _Z_RC_IN_VAL(intr)->_callback(&msg, peer, _Z_RC_IN_VAL(&_Z_RC_IN_VAL(intr)->_arg));
-        }
-        xs = _z_session_interest_rc_slist_next(xs);
+    if (ret == _Z_RES_OK) {
+        _z_interest_trigger_callbacks(&intrs, &msg, peer);
     }
     // Clean up
     _z_keyexpr_clear(&key);
-    _z_session_interest_rc_slist_free(&intrs);
-    return _Z_RES_OK;
+    return ret;
 }
 
 z_result_t _z_interest_process_undeclares(_z_session_t *zn, const _z_declaration_t *decl,
@@ -464,44 +455,37 @@ z_result_t _z_interest_process_undeclares(_z_session_t *zn, const _z_declaration
         _z_session_mutex_unlock(zn);
         _Z_ERROR_RETURN(_Z_ERR_MESSAGE_ZENOH_DECLARATION_UNKNOWN);
     }
-    _z_session_interest_rc_slist_t *intrs =
-        __unsafe_z_get_interest_by_key_and_flags(zn, flags, &prev_decl->_key, _z_optional_id_make_none());
+    _z_session_interest_rc_svec_t intrs;
+    z_result_t ret =
+        __unsafe_z_get_interest_by_key_and_flags(zn, flags, &prev_decl->_key, _z_optional_id_make_none(), &intrs);
     // Remove declare
     _unsafe_z_unregister_declare(zn, msg.id, decl_type);
     _z_session_mutex_unlock(zn);
 
     // Parse session_interest list
-    _z_session_interest_rc_slist_t *xs = intrs;
-    while (xs != NULL) {
-        _z_session_interest_rc_t *intr = _z_session_interest_rc_slist_value(xs);
-        if (_Z_RC_IN_VAL(intr)->_callback != NULL) {
-            _Z_RC_IN_VAL(intr)->_callback(&msg, peer, _Z_RC_IN_VAL(&_Z_RC_IN_VAL(intr)->_arg));
-        }
-        xs = _z_session_interest_rc_slist_next(xs);
+    if (ret == _Z_RES_OK) {
+        _z_interest_trigger_callbacks(&intrs, &msg, peer);
     }
-    // Clean up
-    _z_session_interest_rc_slist_free(&intrs);
-    return _Z_RES_OK;
+    return ret;
 }
 
-void _z_unregister_interest(_z_session_t *zn, _z_session_interest_rc_t *intr) {
+void _z_unregister_interest(_z_session_t *zn, uint32_t id) {
     _z_session_mutex_lock(zn);
-    zn->_local_interests =
-        _z_session_interest_rc_slist_drop_first_filter(zn->_local_interests, _z_session_interest_rc_eq, intr);
+    _z_session_interest_rc_hmap_remove(&zn->_local_interests, &id, NULL);
     _z_session_mutex_unlock(zn);
 }
 
 void _z_interest_init(_z_session_t *zn) {
     _z_session_mutex_lock(zn);
-    zn->_local_interests = NULL;
-    zn->_remote_declares = NULL;
+    zn->_local_interests = _z_session_interest_rc_hmap_new();
+    zn->_remote_declares = _z_declare_data_hmap_new();
     _z_session_mutex_unlock(zn);
 }
 
 void _z_flush_interest(_z_session_t *zn) {
     _z_session_mutex_lock(zn);
-    _z_session_interest_rc_slist_free(&zn->_local_interests);
-    _z_declare_data_slist_free(&zn->_remote_declares);
+    _z_session_interest_rc_hmap_destroy(&zn->_local_interests);
+    _z_declare_data_hmap_destroy(&zn->_remote_declares);
     _z_session_mutex_unlock(zn);
 }
 
@@ -509,15 +493,18 @@ z_result_t _z_interest_process_declare_final(_z_session_t *zn, uint32_t id, _z_t
     _z_interest_msg_t msg = {.type = _Z_INTEREST_MSG_TYPE_FINAL, .id = id};
     // Retrieve interest
     _Z_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn));
-    _z_session_interest_rc_t *intr = __unsafe_z_get_interest_by_id(zn, id);
+    _z_session_interest_rc_t *stored = _z_session_interest_rc_hmap_get(&zn->_local_interests, &id);
+    _z_session_interest_rc_t intr =
+        (stored != NULL) ? _z_session_interest_rc_clone(stored) : _z_session_interest_rc_null();
     _z_session_mutex_unlock(zn);
-    if (intr == NULL) {
+    if (_Z_RC_IS_NULL(&intr)) {
         return _Z_RES_OK;
     }
     // Trigger callback
-    if (_Z_RC_IN_VAL(intr)->_callback != NULL) {
-        _Z_RC_IN_VAL(intr)->_callback(&msg, peer, _Z_RC_IN_VAL(&_Z_RC_IN_VAL(intr)->_arg));
+    if (_Z_RC_IN_VAL(&intr)->_callback != NULL) {
+        _Z_RC_IN_VAL(&intr)->_callback(&msg, peer, _Z_RC_IN_VAL(&_Z_RC_IN_VAL(&intr)->_arg));
     }
+    _z_session_interest_rc_drop(&intr);
     return _Z_RES_OK;
 }
 
@@ -577,33 +564,31 @@ void _z_interest_peer_disconnected(_z_session_t *zn, _z_transport_peer_common_t
     if (_z_session_mutex_lock_if_open(zn) != _Z_RES_OK) {
         return;
     }
-    _z_session_interest_rc_slist_t *intrs = _z_session_interest_rc_slist_clone(zn->_local_interests);
+    _z_session_interest_rc_svec_t intrs = _z_session_interest_rc_svec_null();
+    z_result_t ret = _z_session_interest_rc_hmap_snapshot(&zn->_local_interests, &intrs);
     _z_session_mutex_unlock(zn);
+    if (ret != _Z_RES_OK) {
+        return;
+    }
 
     // Parse session_interest list
     _z_interest_msg_t msg = {.id = 0, .type = _Z_INTEREST_MSG_TYPE_CONNECTION_DROPPED};
-    _z_session_interest_rc_slist_t *xs = intrs;
-    while (xs != NULL) {
-        _z_session_interest_rc_t *intr = _z_session_interest_rc_slist_value(xs);
-        if (_Z_RC_IN_VAL(intr)->_callback != NULL) {
-            _Z_RC_IN_VAL(intr)->_callback(&msg, peer, _Z_RC_IN_VAL(&_Z_RC_IN_VAL(intr)->_arg));
-        }
-        xs = _z_session_interest_rc_slist_next(xs);
-    }
-    // Clean up
-    _z_session_interest_rc_slist_free(&intrs);
+    _z_interest_trigger_callbacks(&intrs, &msg, peer);
 }
 
 void _z_interest_replay_declare(_z_session_t *zn, _z_session_interest_t *interest) {
     if (_z_session_mutex_lock_if_open(zn) != _Z_RES_OK) {
         return;
     }
-    _z_declare_data_slist_t *res_list = _z_declare_data_slist_clone(zn->_remote_declares);
+    _z_declare_data_svec_t res_list = _z_declare_data_svec_null();
+    z_result_t ret = _z_declare_data_hmap_snapshot(&zn->_remote_declares, &res_list);
     _z_session_mutex_unlock(zn);
+    if (ret != _Z_RES_OK) {
+        return;
+    }
 
-    _z_declare_data_slist_t *xs = res_list;
-    while (xs != NULL) {
-        _z_declare_data_t *res = _z_declare_data_slist_value(xs);
+    for (size_t i = 0; i < _z_declare_data_svec_len(&res_list); i++) {
+        _z_declare_data_t *res = _z_declare_data_svec_get(&res_list, i);
         bool is_matching = _z_session_interest_is_aggregate(interest)
                                ? _z_keyexpr_equals(&interest->_key, &res->_key)
                                : _z_keyexpr_intersects(&interest->_key, &res->_key);
@@ -627,9 +612,8 @@ void _z_interest_replay_declare(_z_session_t *zn, _z_session_interest_t *interes
             }
             interest->_callback(&msg, res->_peer, _Z_RC_IN_VAL(&interest->_arg));
         }
-        xs = _z_declare_data_slist_next(xs);
     }
-    _z_declare_data_slist_free(&res_list);
+    _z_declare_data_svec_clear(&res_list);
 }
 
 #else
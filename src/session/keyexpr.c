@@ -21,6 +21,8 @@
 #include "zenoh-pico/net/primitives.h"
 #include "zenoh-pico/net/session.h"
 #include "zenoh-pico/protocol/core.h"
+#include "zenoh-pico/session/keyexpr_scan.h"
+#include "zenoh-pico/utils/hash.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/pointers.h"
 #include "zenoh-pico/utils/string.h"
@@ -116,11 +118,11 @@ zp_keyexpr_canon_status_t __zp_canon_prefix(const char *start, size_t *len) {
     bool in_big_wild = false;
     char const *chunk_start = start;
     const char *end = _z_cptr_char_offset(start, (ptrdiff_t)(*len));
-    char const *next_slash;
+    // First byte that needs to be checked, looked up across chunks so that plain chunks are not scanned twice
+    char const *next_special = _z_ke_scan_special(start, end);
 
     do {
-        next_slash = memchr(chunk_start, '/', _z_ptr_char_diff(end, chunk_start));
-        const char *chunk_end = next_slash ? next_slash : end;
+        const char *chunk_end = _z_ke_scan_delimiter(chunk_start, end);
         size_t chunk_len = _z_ptr_char_diff(chunk_end, chunk_start);
         switch (chunk_len) {
             case 0: {
@@ -133,6 +135,7 @@ zp_keyexpr_canon_status_t __zp_canon_prefix(const char *start, size_t *len) {
                     ret = Z_KEYEXPR_CANON_SINGLE_STAR_AFTER_DOUBLE_STAR;
                 } else {
                     chunk_start = _z_cptr_char_offset(chunk_end, 1);
+                    in_big_wild = false;
                     continue;
                 }
             } break;
@@ -140,7 +143,8 @@ zp_keyexpr_canon_status_t __zp_canon_prefix(const char *start, size_t *len) {
             case 2:
                 if (chunk_start[1] == '*') {
                     if (chunk_start[0] == '$') {
-                        *len = _z_ptr_char_diff(chunk_start, start);
+                        // "**/$*" needs to be reordered once "$*" becomes "*", so it has to be rewritten as well
+                        *len = _z_ptr_char_diff(chunk_start, start) - (in_big_wild ? (size_t)3 : (size_t)0);
                         ret = Z_KEYEXPR_CANON_LONE_DOLLAR_STAR;
                     } else if (chunk_start[0] == '*') {
                         if (in_big_wild) {
@@ -163,8 +167,11 @@ zp_keyexpr_canon_status_t __zp_canon_prefix(const char *start, size_t *len) {
                 break;
         }
 
+        if (next_special < chunk_start) {
+            next_special = _z_ke_scan_special(chunk_start, end);
+        }
         unsigned char in_dollar = 0;
-        for (char const *c = chunk_start; (c < chunk_end) && (ret == Z_KEYEXPR_CANON_SUCCESS);
+        for (char const *c = next_special; (c < chunk_end) && (ret == Z_KEYEXPR_CANON_SUCCESS);
              c = _z_cptr_char_offset(c, 1)) {
             switch (c[0]) {
                 case '#':
@@ -271,7 +278,6 @@ void __zp_ke_write_chunk(char **writer, const char *chunk, size_t len, const cha
 /*------------------ Common helpers ------------------*/
 typedef bool (*_z_ke_chunk_matcher)(_z_str_se_t l, _z_str_se_t r);
 
-enum _zp_wildness_t { _ZP_WILDNESS_ANY = 1, _ZP_WILDNESS_SUPERCHUNKS = 2, _ZP_WILDNESS_SUBCHUNK_DSL = 4 };
 int8_t _zp_ke_wildness(_z_str_se_t ke, size_t *n_segments, size_t *n_verbatims) {
     const char *start = ke.start;
     const char *end = ke.end;
@@ -323,8 +329,7 @@ zp_keyexpr_canon_status_t _z_keyexpr_canonize(char *start, size_t *len) {
         char *reader = _z_ptr_char_offset(start, (ptrdiff_t)canon_len);
         const char *write_start = reader;
         char *writer = reader;
-        char *next_slash = memchr(reader, '/', _z_ptr_char_diff(end, reader));
-        char const *chunk_end = (next_slash != NULL) ? next_slash : end;
+        char const *chunk_end = _z_ke_scan_delimiter(reader, end);
 
         bool in_big_wild = false;
         if ((_z_ptr_char_diff(chunk_end, reader) == 2) && (reader[1] == '*')) {
@@ -339,10 +344,9 @@ zp_keyexpr_canon_status_t _z_keyexpr_canonize(char *start, size_t *len) {
         } else {
             assert(false);  // anything before "$*" or "**" must be part of the canon prefix
         }
-        while (next_slash != NULL) {
-            reader = _z_ptr_char_offset(next_slash, 1);
-            next_slash = memchr(reader, '/', _z_ptr_char_diff(end, reader));
-            chunk_end = next_slash ? next_slash : end;
+        while (chunk_end < end) {
+            reader = _z_ptr_char_offset((char *)chunk_end, 1);
+            chunk_end = _z_ke_scan_delimiter(reader, end);
             switch (_z_ptr_char_diff(chunk_end, reader)) {
                 case 0: {
                     ret = Z_KEYEXPR_CANON_EMPTY_CHUNK;
@@ -374,7 +378,8 @@ zp_keyexpr_canon_status_t _z_keyexpr_canonize(char *start, size_t *len) {
             }
 
             unsigned char in_dollar = 0;
-            for (char const *c = reader; (c < end) && (ret == Z_KEYEXPR_CANON_SUCCESS); c = _z_cptr_char_offset(c, 1)) {
+            for (char const *c = _z_ke_scan_special(reader, chunk_end);
+                 (c < chunk_end) && (ret == Z_KEYEXPR_CANON_SUCCESS); c = _z_cptr_char_offset(c, 1)) {
                 switch (*c) {
                     case '#':
                     case '?': {
@@ -434,6 +439,14 @@ zp_keyexpr_canon_status_t _z_keyexpr_canonize(char *start, size_t *len) {
 
 zp_keyexpr_canon_status_t _z_keyexpr_is_canon(const char *start, size_t len) { return __zp_canon_prefix(start, &len); }
 
+#if defined(Z_TEST_HOOKS)
+static bool _z_ke_scan_simd_enabled = true;
+
+void _z_ke_scan_set_simd_enabled(bool enabled) { _z_ke_scan_simd_enabled = enabled; }
+
+bool _z_ke_scan_simd_is_enabled(void) { return _z_ke_scan_simd_enabled; }
+#endif
+
 z_result_t _z_keyexpr_concat(_z_keyexpr_t *key, const _z_keyexpr_t *left, const char *right, size_t len) {
     *key = _z_keyexpr_null();
     size_t left_len = _z_string_len(&left->_keyexpr);
@@ -553,6 +566,17 @@ size_t _z_keyexpr_non_wild_prefix_len(const _z_keyexpr_t *key) {
     return _z_ptr_char_diff(pos, data);
 }
 
+size_t _z_keyexpr_hash(const _z_keyexpr_t *key) {
+    const uint8_t *data = (const uint8_t *)_z_string_data(&key->_keyexpr);
+    size_t len = _z_string_len(&key->_keyexpr);
+    size_t hash = (size_t)_Z_FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= _Z_FNV_PRIME;
+    }
+    return hash;
+}
+
 z_result_t _z_declared_keyexpr_declare_non_wild_prefix(const _z_session_rc_t *zs, _z_declared_keyexpr_t *out,
                                                        const _z_declared_keyexpr_t *keyexpr) {
     if (_z_declared_keyexpr_is_non_wild_prefix_optimized(keyexpr, _Z_RC_IN_VAL(zs))) {
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/session/keyexpr_intern.h"
+
+#include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
+
+#define _Z_KEYEXPR_INTERN_TABLE_MIN_PURGE_LEN 16
+
+_z_interned_keyexpr_t _z_interned_keyexpr_alias(const _z_keyexpr_t *key) {
+    _z_interned_keyexpr_t ike;
+    ike._key = _z_keyexpr_alias(key);
+    ike._hash = _z_keyexpr_hash(key);
+    size_t len = _z_string_len(&key->_keyexpr);
+    const char *start = _z_string_data(&key->_keyexpr);
+    _z_str_se_t se = {.start = start, .end = _z_cptr_char_offset(start, (ptrdiff_t)len)};
+    size_t n_segments = 0;
+    size_t n_verbatims = 0;
+    ike._wildness = _zp_ke_wildness(se, &n_segments, &n_verbatims);
+    ike._n_chunks = (len == 0) ? 0 : n_segments + 1;
+    return ike;
+}
+
+bool _z_interned_keyexpr_intersects(const _z_interned_keyexpr_t *left, const _z_interned_keyexpr_t *right) {
+    if (_z_interned_keyexpr_is_verbatim(left) && _z_interned_keyexpr_is_verbatim(right)) {
+        return _z_interned_keyexpr_equals(left, right);
+    }
+    // Without '**' each chunk matches exactly one chunk of the other side
+    if ((((left->_wildness | right->_wildness) & _ZP_WILDNESS_SUPERCHUNKS) == 0) &&
+        (left->_n_chunks != right->_n_chunks)) {
+        return false;
+    }
+    return _z_keyexpr_intersects(&left->_key, &right->_key);
+}
+
+bool _z_interned_keyexpr_includes(const _z_interned_keyexpr_t *left, const _z_interned_keyexpr_t *right) {
+    // A verbatim key expression only includes itself
+    if (_z_interned_keyexpr_is_verbatim(left)) {
+        return _z_interned_keyexpr_is_verbatim(right) && _z_interned_keyexpr_equals(left, right);
+    }
+    if ((((left->_wildness | right->_wildness) & _ZP_WILDNESS_SUPERCHUNKS) == 0) &&
+        (left->_n_chunks != right->_n_chunks)) {
+        return false;
+    }
+    return _z_keyexpr_includes(&left->_key, &right->_key);
+}
+
+void _z_keyexpr_intern_table_init(_z_keyexpr_intern_table_t *table) {
+    table->_map = _z_interned_keyexpr_hmap_new();
+    table->_purge_len = _Z_KEYEXPR_INTERN_TABLE_MIN_PURGE_LEN;
+}
+
+void _z_keyexpr_intern_table_clear(_z_keyexpr_intern_table_t *table) {
+    _z_interned_keyexpr_hmap_destroy(&table->_map);
+    table->_purge_len = _Z_KEYEXPR_INTERN_TABLE_MIN_PURGE_LEN;
+}
+
+// Removes the entries of the instances that were freed, the next purge happens once the table has doubled
+static void _z_keyexpr_intern_table_purge(_z_keyexpr_intern_table_t *table) {
+    _z_interned_keyexpr_hmap_t *map = &table->_map;
+    _z_interned_keyexpr_hmap_iter_t it = _z_interned_keyexpr_hmap_begin(map);
+    while (it != _z_interned_keyexpr_hmap_end(map)) {
+        if (_z_interned_keyexpr_weak_strong_count(&_z_interned_keyexpr_hmap_at(map, it)->val) == 0) {
+            _z_interned_keyexpr_hmap_remove_at(map, it, NULL, &it);
+        } else {
+            it = _z_interned_keyexpr_hmap_iter_next(map, it);
+        }
+    }
+    size_t purge_len = 2 * _z_interned_keyexpr_hmap_size(map);
+    table->_purge_len = (purge_len > _Z_KEYEXPR_INTERN_TABLE_MIN_PURGE_LEN) ? purge_len
+                                                                            : _Z_KEYEXPR_INTERN_TABLE_MIN_PURGE_LEN;
+}
+
+z_result_t _z_keyexpr_intern(_z_keyexpr_intern_table_t *table, const _z_keyexpr_t *key,
+                             _z_interned_keyexpr_rc_t *out) {
+    _z_interned_keyexpr_weak_t *entry = _z_interned_keyexpr_hmap_get(&table->_map, key);
+    if (entry != NULL) {
+        *out = _z_interned_keyexpr_weak_upgrade(entry);
+        if (!_Z_RC_IS_NULL(out)) {
+            return _Z_RES_OK;
+        }
+    }
+
+    _z_interned_keyexpr_t ike = _z_interned_keyexpr_alias(key);
+    _Z_RETURN_IF_ERR(_z_keyexpr_copy(&ike._key, key));
+    *out = _z_interned_keyexpr_rc_new_from_val(&ike);
+    if (_Z_RC_IS_NULL(out)) {
+        _z_interned_keyexpr_clear(&ike);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+
+    // Failing to record the instance only prevents it from being shared
+    _z_interned_keyexpr_weak_t weak = _z_interned_keyexpr_rc_clone_as_weak(out);
+    if (entry != NULL) {
+        _z_interned_keyexpr_weak_drop(entry);
+        *entry = weak;
+        return _Z_RES_OK;
+    }
+    if (_z_interned_keyexpr_hmap_size(&table->_map) >= table->_purge_len) {
+        _z_keyexpr_intern_table_purge(table);
+    }
+    _z_keyexpr_t map_key;
+    if (_z_keyexpr_copy(&map_key, key) != _Z_RES_OK) {
+        _z_interned_keyexpr_weak_drop(&weak);
+        return _Z_RES_OK;
+    }
+    if (_z_interned_keyexpr_hmap_insert(&table->_map, &map_key, &weak) == _z_interned_keyexpr_hmap_end(&table->_map)) {
+        _Z_DEBUG("Failed to record interned key expression");
+        _z_keyexpr_clear(&map_key);
+        _z_interned_keyexpr_weak_drop(&weak);
+    }
+    return _Z_RES_OK;
+}
@@ -40,13 +40,11 @@ void _z_pending_query_clear(_z_pending_query_t *pen_qry) {
 #endif
 }
 
-bool _z_pending_query_eq(const _z_pending_query_t *one, const _z_pending_query_t *two) { return one->_id == two->_id; }
 bool _z_pending_query_querier_eq(const _z_pending_query_t *one, const _z_pending_query_t *two) {
     return one->_querier_id.has_value == two->_querier_id.has_value && one->_querier_id.value == two->_querier_id.value;
 }
 
-static bool _z_pending_query_timeout(const _z_pending_query_t *foo, const _z_pending_query_t *pq) {
-    _ZP_UNUSED(foo);
+static bool _z_pending_query_timeout(const _z_pending_query_t *pq) {
     bool result = z_clock_elapsed_ms((z_clock_t *)&pq->_start_time) >= pq->_timeout;
     if (result) {
         _Z_INFO("Dropping query because of timeout");
@@ -55,10 +53,18 @@ static bool _z_pending_query_timeout(const _z_pending_query_t *foo, const _z_pen
 }
 
 void _z_pending_query_process_timeout(_z_session_t *zn) {
-    _z_session_mutex_lock(zn);
+    _z_session_queries_mutex_lock(zn);
     // Extract all queries with timeout elapsed
-    zn->_pending_queries = _z_pending_query_slist_drop_all_filter(zn->_pending_queries, _z_pending_query_timeout, NULL);
-    _z_session_mutex_unlock(zn);
+    _z_pending_query_hmap_t *queries = &zn->_pending_queries;
+    _z_pending_query_hmap_iter_t it = _z_pending_query_hmap_begin(queries);
+    while (it != _z_pending_query_hmap_end(queries)) {
+        if (_z_pending_query_timeout(&_z_pending_query_hmap_at(queries, it)->val)) {
+            _z_pending_query_hmap_remove_at(queries, it, NULL, &it);
+        } else {
+            it = _z_pending_query_hmap_iter_next(queries, it);
+        }
+    }
+    _z_session_queries_mutex_unlock(zn);
 }
 
 _z_fut_fn_result_t _z_pending_query_process_timeout_task_fn(void *session_arg, _z_executor_t *executor) {
@@ -72,46 +78,39 @@ _z_fut_fn_result_t _z_pending_query_process_timeout_task_fn(void *session_arg, _
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
+ *  - zn->_mutex_queries
  */
 _z_pending_query_t *_z_unsafe_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t id) {
-    _z_pending_query_t *ret = NULL;
-
-    _z_pending_query_slist_t *xs = zn->_pending_queries;
-    while (xs != NULL) {
-        _z_pending_query_t *pql = _z_pending_query_slist_value(xs);
-        if (pql->_id == id) {
-            ret = pql;
-            break;
-        }
-
-        xs = _z_pending_query_slist_next(xs);
-    }
-    return ret;
+    return _z_pending_query_hmap_get(&zn->_pending_queries, &id);
 }
 
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
+ *  - zn->_mutex_queries
+ *
+ * The returned pointer is only valid until the mutex is released.
  */
 _z_pending_query_t *_z_unsafe_register_pending_query(_z_session_t *zn) {
     _z_zint_t qid = zn->_query_id++;
-    zn->_pending_queries = _z_pending_query_slist_push_empty(zn->_pending_queries);
-    _z_pending_query_t *pq = _z_pending_query_slist_value(zn->_pending_queries);
-    pq->_id = qid;
-    return pq;
+    _z_pending_query_t pq = {0};
+    pq._id = qid;
+    _z_pending_query_hmap_iter_t it = _z_pending_query_hmap_insert(&zn->_pending_queries, &qid, &pq);
+    if (it == _z_pending_query_hmap_end(&zn->_pending_queries)) {
+        return NULL;
+    }
+    return &_z_pending_query_hmap_at(&zn->_pending_queries, it)->val;
 }
 
 static z_result_t _z_trigger_query_reply_partial_inner(_z_session_t *zn, const _z_zint_t id, _z_keyexpr_t *keyexpr,
                                                        _z_msg_put_t *msg, z_sample_kind_t kind,
                                                        _z_entity_global_id_t *replier_id) {
-    _Z_CLEAN_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn), _z_keyexpr_clear(keyexpr); _z_msg_put_clear(msg));
+    _Z_CLEAN_RETURN_IF_ERR(_z_session_queries_mutex_lock_if_open(zn), _z_keyexpr_clear(keyexpr); _z_msg_put_clear(msg));
 
     // Get query infos
     _z_pending_query_t *pen_qry = _z_unsafe_get_pending_query_by_id(zn, id);
     if (pen_qry == NULL) {
-        _z_session_mutex_unlock(zn);
+        _z_session_queries_mutex_unlock(zn);
         _z_keyexpr_clear(keyexpr);
         _z_msg_put_clear(msg);
         // Not concerned by the reply
@@ -119,7 +118,7 @@ static z_result_t _z_trigger_query_reply_partial_inner(_z_session_t *zn, const _
     }
 
     if (!pen_qry->_anyke && !_z_keyexpr_intersects(&pen_qry->_key, keyexpr)) {
-        _z_session_mutex_unlock(zn);
+        _z_session_queries_mutex_unlock(zn);
         _z_keyexpr_clear(keyexpr);
         _z_msg_put_clear(msg);
         // Not concerned by the reply
@@ -133,6 +132,7 @@ static z_result_t _z_trigger_query_reply_partial_inner(_z_session_t *zn, const _
     if ((pen_qry->_consolidation == Z_CONSOLIDATION_MODE_LATEST) ||
         (pen_qry->_consolidation == Z_CONSOLIDATION_MODE_MONOTONIC)) {
         bool drop = false;
+        size_t hash = _z_keyexpr_hash(&reply.data._result.sample.keyexpr._inner);
         _z_pending_reply_slist_t *curr_node = pen_qry->_pending_replies;
         _z_pending_reply_t *pen_rep = NULL;
 
@@ -140,8 +140,8 @@ static z_result_t _z_trigger_query_reply_partial_inner(_z_session_t *zn, const _
         while (curr_node != NULL) {
             pen_rep = _z_pending_reply_slist_value(curr_node);
             // Check if this is the same resource key
-            if (_z_declared_keyexpr_equals(&pen_rep->_reply.data._result.sample.keyexpr,
-                                           &reply.data._result.sample.keyexpr)) {
+            if ((pen_rep->_hash == hash) && _z_declared_keyexpr_equals(&pen_rep->_reply.data._result.sample.keyexpr,
+                                                                       &reply.data._result.sample.keyexpr)) {
                 if (msg->_commons._timestamp.time <= pen_rep->_tstamp.time) {
                     drop = true;
                 } else {
@@ -162,23 +162,28 @@ static z_result_t _z_trigger_query_reply_partial_inner(_z_session_t *zn, const _
                 _Z_CLEAN_RETURN_IF_ERR(_z_declared_keyexpr_copy(&tmp_rep._reply.data._result.sample.keyexpr,
                                                                 &reply.data._result.sample.keyexpr),
                                        _z_reply_clear(&reply);
-                                       _z_session_mutex_unlock(zn));
+                                       _z_session_queries_mutex_unlock(zn));
             } else {
                 // Copy the reply to store it out of context
                 _Z_CLEAN_RETURN_IF_ERR(_z_reply_move(&tmp_rep._reply, &reply), _z_reply_clear(&reply);
-                                       _z_session_mutex_unlock(zn));
+                                       _z_session_queries_mutex_unlock(zn));
             }
             tmp_rep._tstamp = _z_timestamp_duplicate(&msg->_commons._timestamp);
+            tmp_rep._hash = hash;
             pen_qry->_pending_replies = _z_pending_reply_slist_push(pen_qry->_pending_replies, &tmp_rep);
             _Z_DEBUG("stored reply for id=%jd consolidation=%d", (intmax_t)id, pen_qry->_consolidation);
         }
     }
-    _z_session_mutex_unlock(zn);
+    // The pending query may be moved by a concurrent registration once the mutex is released
+    bool immediate = (pen_qry->_consolidation != Z_CONSOLIDATION_MODE_LATEST);
+    _z_closure_reply_callback_t callback = pen_qry->_callback;
+    void *arg = pen_qry->_arg;
+    _z_session_queries_mutex_unlock(zn);
 
     // Trigger callback if applicable
-    if (pen_qry->_consolidation != Z_CONSOLIDATION_MODE_LATEST) {
+    if (immediate) {
         _Z_DEBUG("immediate callback for id=%jd", (intmax_t)id);
-        pen_qry->_callback(&reply, pen_qry->_arg);
+        callback(&reply, arg);
     }
     _z_reply_clear(&reply);
     return _Z_RES_OK;
@@ -201,30 +206,33 @@ z_result_t _z_trigger_query_reply_partial(_z_session_t *zn, const _z_zint_t id,
 z_result_t _z_trigger_query_reply_err(_z_session_t *zn, _z_zint_t id, _z_msg_err_t *msg,
                                       _z_entity_global_id_t *replier_id) {
     // Retrieve query
-    _Z_CLEAN_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn), _z_bytes_drop(&msg->_payload);
+    _Z_CLEAN_RETURN_IF_ERR(_z_session_queries_mutex_lock_if_open(zn), _z_bytes_drop(&msg->_payload);
                            _z_encoding_clear(&msg->_encoding));
     _z_pending_query_t *pen_qry = _z_unsafe_get_pending_query_by_id(zn, id);
-    _z_session_mutex_unlock(zn);
     if (pen_qry == NULL) {
+        _z_session_queries_mutex_unlock(zn);
         // Not concerned by the reply
         _z_bytes_drop(&msg->_payload);
         _z_encoding_clear(&msg->_encoding);
         return _Z_RES_OK;
     }
+    _z_closure_reply_callback_t callback = pen_qry->_callback;
+    void *arg = pen_qry->_arg;
+    _z_session_queries_mutex_unlock(zn);
     // Trigger the user callback
     _z_reply_t reply;
     _z_reply_err_steal_data(&reply, &msg->_payload, &msg->_encoding, *replier_id);
-    pen_qry->_callback(&reply, pen_qry->_arg);
+    callback(&reply, arg);
     _z_reply_clear(&reply);
     return _Z_RES_OK;
 }
 
 z_result_t _z_trigger_query_reply_final(_z_session_t *zn, _z_zint_t id) {
     // Retrieve query
-    _Z_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn));
+    _Z_RETURN_IF_ERR(_z_session_queries_mutex_lock_if_open(zn));
     _z_pending_query_t *pen_qry = _z_unsafe_get_pending_query_by_id(zn, id);
     if (pen_qry == NULL) {
-        _z_session_mutex_unlock(zn);
+        _z_session_queries_mutex_unlock(zn);
         // Not concerned by the reply
         return _Z_RES_OK;
     }
@@ -249,36 +257,40 @@ z_result_t _z_trigger_query_reply_final(_z_session_t *zn, _z_zint_t id) {
     // Finalize query if requested: drop pending query and trigger dropper callback,
     // which is equivalent to a reply with FINAL.
     if (do_finalize) {
-        zn->_pending_queries =
-            _z_pending_query_slist_drop_first_filter(zn->_pending_queries, _z_pending_query_eq, pen_qry);
+        _z_pending_query_hmap_remove(&zn->_pending_queries, &id, NULL);
     }
-    _z_session_mutex_unlock(zn);
+    _z_session_queries_mutex_unlock(zn);
     return _Z_RES_OK;
 }
 
 void _z_unregister_pending_query(_z_session_t *zn, _z_zint_t qid) {
-    _z_pending_query_t target = {0};
-    target._id = qid;
-    _z_session_mutex_lock(zn);
-    zn->_pending_queries = _z_pending_query_slist_drop_first_filter(zn->_pending_queries, _z_pending_query_eq, &target);
-    _z_session_mutex_unlock(zn);
+    _z_session_queries_mutex_lock(zn);
+    _z_pending_query_hmap_remove(&zn->_pending_queries, &qid, NULL);
+    _z_session_queries_mutex_unlock(zn);
 }
 
 void _z_unregister_pending_queries_from_querier(_z_session_t *zn, uint32_t querier_id) {
     _z_pending_query_t target = {0};
     target._querier_id = _z_optional_id_make_some(querier_id);
-    _z_session_mutex_lock(zn);
-    zn->_pending_queries =
-        _z_pending_query_slist_drop_all_filter(zn->_pending_queries, _z_pending_query_querier_eq, &target);
-    _z_session_mutex_unlock(zn);
+    _z_session_queries_mutex_lock(zn);
+    _z_pending_query_hmap_t *queries = &zn->_pending_queries;
+    _z_pending_query_hmap_iter_t it = _z_pending_query_hmap_begin(queries);
+    while (it != _z_pending_query_hmap_end(queries)) {
+        if (_z_pending_query_querier_eq(&_z_pending_query_hmap_at(queries, it)->val, &target)) {
+            _z_pending_query_hmap_remove_at(queries, it, NULL, &it);
+        } else {
+            it = _z_pending_query_hmap_iter_next(queries, it);
+        }
+    }
+    _z_session_queries_mutex_unlock(zn);
 }
 
 void _z_flush_pending_queries(_z_session_t *zn) {
-    _z_session_mutex_lock(zn);
-    _z_pending_query_slist_t *queries = zn->_pending_queries;
-    zn->_pending_queries = _z_pending_query_slist_new();
-    _z_session_mutex_unlock(zn);
-    _z_pending_query_slist_free(&queries);
+    _z_session_queries_mutex_lock(zn);
+    _z_pending_query_hmap_t queries = zn->_pending_queries;
+    zn->_pending_queries = _z_pending_query_hmap_new();
+    _z_session_queries_mutex_unlock(zn);
+    _z_pending_query_hmap_destroy(&queries);
 }
 #ifdef Z_FEATURE_UNSTABLE_API
 
@@ -25,6 +25,7 @@
 #include "zenoh-pico/session/keyexpr.h"
 #include "zenoh-pico/session/resource.h"
 #include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/utils/hash.h"
 #include "zenoh-pico/utils/locality.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/pointers.h"
@@ -39,14 +40,6 @@ static inline _z_queryable_cache_data_t _z_queryable_cache_data_null(void) {
     return ret;
 }
 
-void _z_unsafe_queryable_cache_invalidate(_z_session_t *zn) {
-#if Z_FEATURE_RX_CACHE == 1
-    _z_queryable_lru_cache_clear(&zn->_queryable_cache);
-#else
-    _ZP_UNUSED(zn);
-#endif
-}
-
 #if Z_FEATURE_RX_CACHE == 1
 int _z_queryable_cache_data_compare(const void *first, const void *second) {
     const _z_queryable_cache_data_t *first_data = (const _z_queryable_cache_data_t *)first;
@@ -56,8 +49,27 @@ int _z_queryable_cache_data_compare(const void *first, const void *second) {
     }
     return _z_keyexpr_compare(&first_data->ke, &second_data->ke);
 }
+
+size_t _z_queryable_cache_data_hash(const void *val) { return ((const _z_queryable_cache_data_t *)val)->hash; }
+
+static bool _z_queryable_cache_data_intersects(const void *val, const void *key) {
+    return _z_keyexpr_intersects(&((const _z_queryable_cache_data_t *)val)->ke, (const _z_keyexpr_t *)key);
+}
 #endif  // Z_FEATURE_RX_CACHE == 1
 
+void _z_unsafe_queryable_cache_invalidate(_z_session_t *zn, const _z_keyexpr_t *key) {
+#if Z_FEATURE_RX_CACHE == 1
+    if (key == NULL) {
+        _z_queryable_lru_cache_clear(&zn->_queryable_cache);
+    } else {
+        _z_queryable_lru_cache_remove_if(&zn->_queryable_cache, _z_queryable_cache_data_intersects, key);
+    }
+#else
+    _ZP_UNUSED(zn);
+    _ZP_UNUSED(key);
+#endif
+}
+
 void _z_queryable_cache_data_clear(_z_queryable_cache_data_t *val) {
     _z_session_queryable_rc_svec_rc_drop(&val->infos);
     _z_keyexpr_clear(&val->ke);
@@ -73,62 +85,65 @@ void _z_session_queryable_clear(_z_session_queryable_t *qle) {
         qle->_dropper = NULL;
     }
     _z_declared_keyexpr_clear(&qle->_key);
+    _z_interned_keyexpr_rc_drop(&qle->_interned_key);
     _z_sync_group_notifier_drop(&qle->_session_callback_drop_notifier);
     _z_sync_group_notifier_drop(&qle->_queryable_callback_drop_notifier);
 }
 
 /*------------------ Queryable ------------------*/
-static _z_session_queryable_rc_t *__z_get_session_queryable_by_id(_z_session_queryable_rc_slist_t *qles,
-                                                                  const _z_zint_t id) {
-    _z_session_queryable_rc_t *ret = NULL;
-
-    _z_session_queryable_rc_slist_t *xs = qles;
-    while (xs != NULL) {
-        _z_session_queryable_rc_t *qle = _z_session_queryable_rc_slist_value(xs);
-        if (id == _Z_RC_IN_VAL(qle)->_id) {
-            ret = qle;
-            break;
-        }
-        xs = _z_session_queryable_rc_slist_next(xs);
-    }
-
-    return ret;
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_queryables
+ */
+static _z_session_queryable_rc_t *__unsafe_z_get_session_queryable_by_id(_z_session_t *zn, const _z_zint_t id) {
+    uint32_t key = (uint32_t)id;
+    return _z_session_queryable_rc_hmap_get(&zn->_local_queryable, &key);
 }
 
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
+ *  - zn->_mutex_queryables
+ *
+ * Failing to intern the key is not an error, the queryable is then matched by its plain key expression.
  */
-static _z_session_queryable_rc_t *__unsafe_z_get_session_queryable_by_id(_z_session_t *zn, const _z_zint_t id) {
-    _z_session_queryable_rc_slist_t *qles = zn->_local_queryable;
-    return __z_get_session_queryable_by_id(qles, id);
+static void __unsafe_z_session_queryable_intern_key(_z_session_t *zn, _z_session_queryable_t *qle) {
+    if (_z_keyexpr_intern(&zn->_queryable_keyexprs, &qle->_key._inner, &qle->_interned_key) != _Z_RES_OK) {
+        _Z_DEBUG("Failed to intern queryable key expression");
+    }
+}
+
+static inline bool _z_session_queryable_intersects(const _z_session_queryable_t *qle,
+                                                   const _z_interned_keyexpr_t *key) {
+    return !_Z_RC_IS_NULL(&qle->_interned_key)
+               ? _z_interned_keyexpr_intersects(_Z_RC_IN_VAL(&qle->_interned_key), key)
+               : _z_keyexpr_intersects(&qle->_key._inner, &key->_key);
 }
 
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
+ *  - zn->_mutex_queryables
  */
 static z_result_t __unsafe_z_get_session_queryables_by_key(_z_session_t *zn, const _z_keyexpr_t *key, bool is_remote,
                                                            _z_session_queryable_rc_svec_t *qle_infos) {
-    _z_session_queryable_rc_slist_t *qles = zn->_local_queryable;
+    _z_session_queryable_rc_hmap_t *qles = &zn->_local_queryable;
+    _z_interned_keyexpr_t query_key = _z_interned_keyexpr_alias(key);
 
     *qle_infos = _z_session_queryable_rc_svec_make(_Z_QLEINFOS_VEC_SIZE);
     _Z_RETURN_ERR_OOM_IF_TRUE(qle_infos->_val == NULL);
-    _z_session_queryable_rc_slist_t *xs = qles;
-    while (xs != NULL) {
-        // Parse queryable list
-        _z_session_queryable_rc_t *qle = _z_session_queryable_rc_slist_value(xs);
+    for (_z_session_queryable_rc_hmap_iter_t it = _z_session_queryable_rc_hmap_begin(qles);
+         it != _z_session_queryable_rc_hmap_end(qles); it = _z_session_queryable_rc_hmap_iter_next(qles, it)) {
+        _z_session_queryable_rc_t *qle = &_z_session_queryable_rc_hmap_at(qles, it)->val;
         const _z_session_queryable_t *qle_val = _Z_RC_IN_VAL(qle);
         bool origin_allowed = is_remote ? _z_locality_allows_remote(qle_val->_allowed_origin)
                                         : _z_locality_allows_local(qle_val->_allowed_origin);
-        if (origin_allowed && _z_keyexpr_intersects(&qle_val->_key._inner, key)) {
+        if (origin_allowed && _z_session_queryable_intersects(qle_val, &query_key)) {
             _z_session_queryable_rc_t qle_clone = _z_session_queryable_rc_clone(qle);
             _Z_CLEAN_RETURN_IF_ERR(_z_session_queryable_rc_svec_append(qle_infos, &qle_clone, false),
                                    _z_session_queryable_rc_svec_clear(qle_infos));
         }
-        xs = _z_session_queryable_rc_slist_next(xs);
     }
     return _Z_RES_OK;
 }
@@ -136,7 +151,7 @@ static z_result_t __unsafe_z_get_session_queryables_by_key(_z_session_t *zn, con
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
+ *  - zn->_mutex_queryables
  */
 static z_result_t __unsafe_z_get_session_queryables_rc_by_key(_z_session_t *zn, const _z_keyexpr_t *key, bool is_remote,
                                                               _z_session_queryable_rc_svec_rc_t *qle_infos) {
@@ -151,13 +166,13 @@ static z_result_t __unsafe_z_get_session_queryables_rc_by_key(_z_session_t *zn,
 
 _z_session_queryable_rc_t _z_get_session_queryable_by_id(_z_session_t *zn, const _z_zint_t id) {
     _z_session_queryable_rc_t out = _z_session_queryable_rc_null();
-    _z_session_mutex_lock(zn);
+    _z_session_queryables_mutex_lock(zn);
 
     _z_session_queryable_rc_t *qle = __unsafe_z_get_session_queryable_by_id(zn, id);
     if (qle != NULL) {
         out = _z_session_queryable_rc_clone(qle);
     }
-    _z_session_mutex_unlock(zn);
+    _z_session_queryables_mutex_unlock(zn);
 
     return out;
 }
@@ -170,18 +185,23 @@ _z_session_queryable_rc_t _z_register_session_queryable(_z_session_t *zn, _z_ses
     if (_Z_RC_IS_NULL(&out)) {
         return out;
     }
-    if (_z_session_mutex_lock_if_open(zn) != _Z_RES_OK) {
+    if (_z_session_queryables_mutex_lock_if_open(zn) != _Z_RES_OK) {
         _Z_WARN("Failed to acquire session mutex for registering queryable - session is closed");
         _z_session_queryable_rc_drop(&out);
         *q = _z_session_queryable_null();
         return out;
     }
-    _z_unsafe_queryable_cache_invalidate(zn);
-    zn->_local_queryable = _z_session_queryable_rc_slist_push_empty(zn->_local_queryable);
-    _z_session_queryable_rc_t *ret = _z_session_queryable_rc_slist_value(zn->_local_queryable);
-    *ret = _z_session_queryable_rc_clone(
-        &out);  // immediately increase reference count to prevent eventual drop by concurrent session close
-    _z_session_mutex_unlock(zn);
+    __unsafe_z_session_queryable_intern_key(zn, _Z_RC_IN_VAL(&out));
+    _z_unsafe_queryable_cache_invalidate(zn, &_Z_RC_IN_VAL(&out)->_key._inner);
+    uint32_t key = _Z_RC_IN_VAL(&out)->_id;
+    // immediately increase reference count to prevent eventual drop by concurrent session close
+    _z_session_queryable_rc_t stored = _z_session_queryable_rc_clone(&out);
+    if (_z_session_queryable_rc_hmap_insert(&zn->_local_queryable, &key, &stored) ==
+        _z_session_queryable_rc_hmap_end(&zn->_local_queryable)) {
+        _z_session_queryable_rc_drop(&stored);
+        _z_session_queryable_rc_drop(&out);
+    }
+    _z_session_queryables_mutex_unlock(zn);
 
 #if Z_FEATURE_LOCAL_QUERYABLE == 1
     if (!_Z_RC_IS_NULL(&out) && _z_locality_allows_local(q->_allowed_origin)) {
@@ -193,18 +213,85 @@ _z_session_queryable_rc_t _z_register_session_queryable(_z_session_t *zn, _z_ses
     return out;
 }
 
+void _z_get_session_queryables_by_id(_z_session_t *zn, const uint32_t *ids, size_t len,
+                                     _z_session_queryable_rc_t *out) {
+    _z_session_queryables_mutex_lock(zn);
+    for (size_t i = 0; i < len; i++) {
+        _z_session_queryable_rc_t *qle = __unsafe_z_get_session_queryable_by_id(zn, ids[i]);
+        out[i] = (qle != NULL) ? _z_session_queryable_rc_clone(qle) : _z_session_queryable_rc_null();
+    }
+    _z_session_queryables_mutex_unlock(zn);
+}
+
+z_result_t _z_register_session_queryables(_z_session_t *zn, _z_session_queryable_t *qles, size_t len,
+                                          _z_session_queryable_rc_t *out) {
+    z_result_t ret = _Z_RES_OK;
+    size_t created = 0;
+    for (; created < len; created++) {
+        out[created] = _z_session_queryable_rc_new_from_val(&qles[created]);
+        if (_Z_RC_IS_NULL(&out[created])) {
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+            break;
+        }
+    }
+    if (ret == _Z_RES_OK) {
+        ret = _z_session_queryables_mutex_lock_if_open(zn);
+    }
+    if (ret == _Z_RES_OK) {
+        _z_session_queryable_rc_hmap_t *map = &zn->_local_queryable;
+        size_t inserted = 0;
+        for (; inserted < len; inserted++) {
+            __unsafe_z_session_queryable_intern_key(zn, _Z_RC_IN_VAL(&out[inserted]));
+            _z_unsafe_queryable_cache_invalidate(zn, &_Z_RC_IN_VAL(&out[inserted])->_key._inner);
+            uint32_t key = _Z_RC_IN_VAL(&out[inserted])->_id;
+            _z_session_queryable_rc_t stored = _z_session_queryable_rc_clone(&out[inserted]);
+            if (_z_session_queryable_rc_hmap_insert(map, &key, &stored) == _z_session_queryable_rc_hmap_end(map)) {
+                _z_session_queryable_rc_drop(&stored);
+                ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+                break;
+            }
+        }
+        for (size_t i = 0; (ret != _Z_RES_OK) && (i < inserted); i++) {
+            uint32_t key = _Z_RC_IN_VAL(&out[i])->_id;
+            _z_session_queryable_rc_hmap_remove(map, &key, NULL);
+        }
+        _z_session_queryables_mutex_unlock(zn);
+    }
+    if (ret != _Z_RES_OK) {
+        for (size_t i = 0; i < len; i++) {
+            if (i < created) {
+                _z_session_queryable_rc_drop(&out[i]);
+            } else {
+                _z_session_queryable_clear(&qles[i]);
+            }
+        }
+    }
+    // Queryables were either moved into the refcounts or cleared
+    for (size_t i = 0; i < len; i++) {
+        qles[i] = _z_session_queryable_null();
+    }
+
+#if Z_FEATURE_LOCAL_QUERYABLE == 1
+    if (ret == _Z_RES_OK) {
+        _z_write_filter_notify_queryables(zn, out, len, true);
+    }
+#endif
+    return ret;
+}
+
 static z_result_t _z_session_queryable_get_infos(_z_session_t *zn, _z_queryable_cache_data_t *out,
                                                  const _z_wireexpr_t *wireexpr, _z_transport_peer_common_t *peer) {
     out->is_remote = (peer != NULL);
     _Z_RETURN_IF_ERR(_z_get_keyexpr_from_wireexpr(zn, &out->ke, wireexpr, peer, true));
     _z_queryable_cache_data_t *cache_entry = NULL;
     z_result_t ret = _Z_RES_OK;
-    _Z_CLEAN_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn), _z_keyexpr_clear(&out->ke));
+#if Z_FEATURE_RX_CACHE == 1
+    // Hashed before locking, the cache only compares the key expressions of the entries with the same hash
+    out->hash = _z_hash_combine(_z_keyexpr_hash(&out->ke), (size_t)out->is_remote);
+#endif
+    _Z_CLEAN_RETURN_IF_ERR(_z_session_queryables_mutex_lock_if_open(zn), _z_keyexpr_clear(&out->ke));
 #if Z_FEATURE_RX_CACHE == 1
     cache_entry = _z_queryable_lru_cache_get(&zn->_queryable_cache, out);
-    if (cache_entry != NULL && cache_entry->is_remote != out->is_remote) {
-        cache_entry = NULL;
-    }
 #endif
     if (cache_entry != NULL) {  // Copy cache entry
         out->infos = _z_session_queryable_rc_svec_rc_clone(&cache_entry->infos);
@@ -215,6 +302,7 @@ static z_result_t _z_session_queryable_get_infos(_z_session_t *zn, _z_queryable_
         _z_queryable_cache_data_t cache_storage = _z_queryable_cache_data_null();
         cache_storage.infos = _z_session_queryable_rc_svec_rc_clone(&out->infos);
         cache_storage.is_remote = out->is_remote;
+        cache_storage.hash = out->hash;
         _Z_SET_IF_OK(ret, _z_keyexpr_copy(&cache_storage.ke, &out->ke));
         _Z_SET_IF_OK(ret, _z_queryable_lru_cache_insert(&zn->_queryable_cache, &cache_storage));
         if (ret != _Z_RES_OK) {
@@ -222,7 +310,7 @@ static z_result_t _z_session_queryable_get_infos(_z_session_t *zn, _z_queryable_
         }
 #endif
     }
-    _z_session_mutex_unlock(zn);
+    _z_session_queryables_mutex_unlock(zn);
     if (ret != _Z_RES_OK) {
         _z_queryable_cache_data_clear(out);
     }
@@ -285,25 +373,53 @@ void _z_unregister_session_queryable(_z_session_t *zn, _z_session_queryable_rc_t
     _z_session_queryable_t *qle_val = _Z_RC_IN_VAL(qle);
     _z_write_filter_notify_queryable(zn, &qle_val->_key._inner, qle_val->_allowed_origin, qle_val->_complete, false);
 #endif
-    _z_session_mutex_lock(zn);
-    _z_unsafe_queryable_cache_invalidate(zn);
-    zn->_local_queryable =
-        _z_session_queryable_rc_slist_drop_first_filter(zn->_local_queryable, _z_session_queryable_rc_eq, qle);
-    _z_session_mutex_unlock(zn);
+    _z_session_queryables_mutex_lock(zn);
+    _z_unsafe_queryable_cache_invalidate(zn, &_Z_RC_IN_VAL(qle)->_key._inner);
+    uint32_t key = _Z_RC_IN_VAL(qle)->_id;
+    _z_session_queryable_rc_t *stored = _z_session_queryable_rc_hmap_get(&zn->_local_queryable, &key);
+    if ((stored != NULL) && _z_session_queryable_rc_eq(stored, qle)) {
+        _z_session_queryable_rc_hmap_remove(&zn->_local_queryable, &key, NULL);
+    }
+    _z_session_queryables_mutex_unlock(zn);
     _z_session_queryable_rc_drop(qle);
 }
 
+void _z_unregister_session_queryables(_z_session_t *zn, _z_session_queryable_rc_t *qles, size_t len) {
+#if Z_FEATURE_LOCAL_QUERYABLE == 1
+    _z_write_filter_notify_queryables(zn, qles, len, false);
+#endif
+    _z_session_queryables_mutex_lock(zn);
+    for (size_t i = 0; i < len; i++) {
+        _z_unsafe_queryable_cache_invalidate(zn, &_Z_RC_IN_VAL(&qles[i])->_key._inner);
+        uint32_t key = _Z_RC_IN_VAL(&qles[i])->_id;
+        _z_session_queryable_rc_t *stored = _z_session_queryable_rc_hmap_get(&zn->_local_queryable, &key);
+        if ((stored != NULL) && _z_session_queryable_rc_eq(stored, &qles[i])) {
+            _z_session_queryable_rc_hmap_remove(&zn->_local_queryable, &key, NULL);
+        }
+    }
+    _z_session_queryables_mutex_unlock(zn);
+    for (size_t i = 0; i < len; i++) {
+        _z_session_queryable_rc_drop(&qles[i]);
+    }
+}
+
 void _z_flush_session_queryable(_z_session_t *zn) {
-    _z_session_queryable_rc_slist_t *queryables;
-    _z_session_mutex_lock(zn);
-    _z_unsafe_queryable_cache_invalidate(zn);
+    _z_session_queryable_rc_hmap_t queryables;
+    _z_session_queryables_mutex_lock(zn);
+#if Z_FEATURE_RX_CACHE == 1
+    _z_queryable_lru_cache_delete(&zn->_queryable_cache);
+#endif
     queryables = zn->_local_queryable;
-    zn->_local_queryable = _z_session_queryable_rc_slist_new();
-    _z_session_mutex_unlock(zn);
-    _z_session_queryable_rc_slist_free(&queryables);
+    zn->_local_queryable = _z_session_queryable_rc_hmap_new();
+    _z_keyexpr_intern_table_clear(&zn->_queryable_keyexprs);
+    _z_session_queryables_mutex_unlock(zn);
+    _z_session_queryable_rc_hmap_destroy(&queryables);
 }
 #else  //  Z_FEATURE_QUERYABLE == 0
 
-void _z_unsafe_queryable_cache_invalidate(_z_session_t *zn) { _ZP_UNUSED(zn); }
+void _z_unsafe_queryable_cache_invalidate(_z_session_t *zn, const _z_keyexpr_t *key) {
+    _ZP_UNUSED(zn);
+    _ZP_UNUSED(key);
+}
 
 #endif  // Z_FEATURE_QUERYABLE == 1
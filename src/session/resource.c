@@ -38,6 +38,7 @@ size_t _z_resource_size(_z_resource_t *p) {
 
 void _z_resource_copy(_z_resource_t *dst, const _z_resource_t *src) {
     _z_keyexpr_copy(&dst->_key, &src->_key);
+    dst->_hash = src->_hash;
     dst->_id = src->_id;
 }
 
@@ -77,10 +78,11 @@ _z_resource_t *_z_get_resource_by_id_inner(_z_resource_slist_t *rl, const _z_zin
 
 _z_resource_t *_z_get_resource_by_key_inner(_z_resource_slist_t *rl, const _z_keyexpr_t *keyexpr) {
     _z_resource_t *ret = NULL;
+    size_t hash = _z_keyexpr_hash(keyexpr);
     _z_resource_slist_t *xs = rl;
     while (xs != NULL) {
         _z_resource_t *r = _z_resource_slist_value(xs);
-        if (_z_keyexpr_equals(&r->_key, keyexpr)) {
+        if ((r->_hash == hash) && _z_keyexpr_equals(&r->_key, keyexpr)) {
             ret = r;
             break;
         }
@@ -173,6 +175,7 @@ z_result_t _z_register_resource_inner(_z_session_t *zn, const _z_wireexpr_t *exp
     _z_resource_t *res = _z_resource_slist_value(*resources);
     res->_refcount = 1;
     res->_key = ke;
+    res->_hash = _z_keyexpr_hash(&ke);
     res->_id = id == Z_RESOURCE_ID_NONE ? _z_get_resource_id(zn) : id;
     *out_id = res->_id;
     return _Z_RES_OK;
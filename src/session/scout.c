@@ -16,6 +16,7 @@
 #include <string.h>
 
 #include "zenoh-pico/link/manager.h"
+#include "zenoh-pico/link/transport/socket.h"
 #include "zenoh-pico/protocol/codec/transport.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/system/platform.h"
@@ -26,121 +27,214 @@
 
 #define SCOUT_BUFFER_SIZE 32
 
-static _z_hello_slist_t *__z_scout_loop(const _z_wbuf_t *wbf, _z_string_t *locator, unsigned long period,
-                                        bool exit_on_first) {
-    // Define an empty array
-    _z_hello_slist_t *ret = NULL;
-    z_result_t err = _Z_RES_OK;
+// A link on which the scout message was sent, waiting for the hellos
+typedef struct {
+    _z_link_t _link;
+    bool _ready;
+} _z_scout_link_t;
 
-    _z_endpoint_t ep;
-    err = _z_endpoint_from_string(&ep, locator);
+typedef struct {
+    _z_scout_link_t *_val;
+    size_t _len;
+} _z_scout_links_t;
+
+static void __z_scout_wait_iter_reset(_z_socket_wait_iter_t *iter) { iter->_current_entry = NULL; }
+
+static bool __z_scout_wait_iter_next(_z_socket_wait_iter_t *iter) {
+    _z_scout_links_t *links = (_z_scout_links_t *)iter->_ctx;
+    _z_scout_link_t *next =
+        (iter->_current_entry == NULL) ? &links->_val[0] : (_z_scout_link_t *)iter->_current_entry + 1;
+    if (next == &links->_val[links->_len]) {
+        return false;
+    }
+    iter->_current_entry = next;
+    return true;
+}
+
+static const _z_sys_net_socket_t *__z_scout_wait_iter_get_socket(const _z_socket_wait_iter_t *iter) {
+    return _z_link_get_socket(&((_z_scout_link_t *)iter->_current_entry)->_link);
+}
+
+static void __z_scout_wait_iter_set_ready(_z_socket_wait_iter_t *iter, bool ready) {
+    ((_z_scout_link_t *)iter->_current_entry)->_ready = ready;
+}
+
+// Opens a link on each UDP locator and sends the scout message on it, the locators that fail are skipped
+static z_result_t __z_scout_open_links(_z_scout_links_t *links, const _z_wbuf_t *wbf,
+                                       const _z_string_svec_t *locators) {
+    size_t n_loc = _z_string_svec_len(locators);
+    links->_len = 0;
+    links->_val = (_z_scout_link_t *)z_malloc(n_loc * sizeof(_z_scout_link_t));
+    if (links->_val == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
 
-#if Z_FEATURE_SCOUTING == 1
     _z_string_t cmp_str = _z_string_alias_str(UDP_SCHEMA);
-    if ((err == _Z_RES_OK) && _z_string_equals(&ep._locator._protocol, &cmp_str)) {
-        _z_endpoint_clear(&ep);
-    } else
-#endif
-        if (err == _Z_RES_OK) {
+    for (size_t i = 0; i < n_loc; i++) {
+        _z_string_t *locator = _z_string_svec_get(locators, i);
+        _z_endpoint_t ep;
+        if (_z_endpoint_from_string(&ep, locator) != _Z_RES_OK) {
+            continue;
+        }
+        bool is_udp = _z_string_equals(&ep._locator._protocol, &cmp_str);
         _z_endpoint_clear(&ep);
-        _Z_ERROR_LOG(_Z_ERR_TRANSPORT_NOT_AVAILABLE);
-        err = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+        if (!is_udp) {
+            _Z_ERROR("Scouting locator %.*s is not an UDP locator", (int)_z_string_len(locator),
+                     _z_string_data(locator));
+            continue;
+        }
+
+        _z_link_t *zl = &links->_val[links->_len]._link;
+        memset(zl, 0, sizeof(_z_link_t));
+        if (_z_open_link(zl, locator, NULL) != _Z_RES_OK) {
+            _Z_ERROR_LOG(_Z_ERR_TRANSPORT_OPEN_FAILED);
+            continue;
+        }
+        // Send the scout message
+        if (_z_link_send_wbuf(zl, wbf, NULL) != _Z_RES_OK) {
+            _Z_ERROR_LOG(_Z_ERR_TRANSPORT_TX_FAILED);
+            _z_link_clear(zl);
+            continue;
+        }
+        links->_val[links->_len]._ready = false;
+        links->_len++;
+    }
+    if (links->_len == 0) {
+        z_free(links->_val);
+        links->_val = NULL;
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NOT_AVAILABLE);
+    }
+    return _Z_RES_OK;
+}
+
+static void __z_scout_close_links(_z_scout_links_t *links) {
+    for (size_t i = 0; i < links->_len; i++) {
+        _z_link_clear(&links->_val[i]._link);
+    }
+    z_free(links->_val);
+    links->_val = NULL;
+    links->_len = 0;
+}
+
+static z_result_t __z_scout_add_hello(_z_hello_slist_t **hellos, const _z_s_msg_hello_t *msg) {
+    // The same node answers once per group and interface it was reached on
+    for (_z_hello_slist_t *it = *hellos; it != NULL; it = _z_hello_slist_next(it)) {
+        if (_z_id_eq(&_z_hello_slist_value(it)->_zid, &msg->_zid)) {
+            return _Z_RES_OK;
+        }
+    }
+
+    // The list is left as is if the node can't be allocated
+    _z_hello_slist_t *ret = _z_hello_slist_push_empty(*hellos);
+    if (ret == *hellos) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    *hellos = ret;
+    _z_hello_t *hello = _z_hello_slist_value(ret);
+    hello->_version = msg->_version;
+    hello->_whatami = msg->_whatami;
+    memcpy(hello->_zid.id, msg->_zid.id, 16);
+
+    size_t n_loc = _z_locator_array_len(&msg->_locators);
+    if (n_loc > 0) {
+        hello->_locators = _z_string_svec_make(n_loc);
+
+        for (size_t i = 0; i < n_loc; i++) {
+            _z_string_t s = _z_locator_to_string(&msg->_locators._val[i]);
+            _Z_RETURN_IF_ERR(_z_string_svec_append(&hello->_locators, &s, true));
+        }
+    } else {
+        // @TODO: construct the locator departing from the sock address
+        hello->_locators = _z_string_svec_null();
+    }
+    return _Z_RES_OK;
+}
+
+// Reads one message from a link that has data and records it if it is a hello
+static void __z_scout_recv(_z_link_t *zl, _z_zbuf_t *zbf, _z_hello_slist_t **hellos) {
+    _z_zbuf_reset(zbf);
+
+    // Read bytes from the socket
+    size_t len = _z_link_recv_zbuf(zl, zbf, NULL);
+    if (len == SIZE_MAX) {
+        return;
+    }
+
+    _z_scouting_message_t s_msg;
+    if (_z_scouting_message_decode(&s_msg, zbf) != _Z_RES_OK) {
+        _Z_ERROR("Scouting loop received malformed message");
+        return;
     }
 
-    if (err == _Z_RES_OK) {
-        _z_link_t zl;
-        memset(&zl, 0, sizeof(_z_link_t));
-
-        err = _z_open_link(&zl, locator, NULL);
-        if (err == _Z_RES_OK) {
-            // Send the scout message
-            err = _z_link_send_wbuf(&zl, wbf, NULL);
-            if (err == _Z_RES_OK) {
-                // The receiving buffer
-                _z_zbuf_t zbf = _z_zbuf_make(Z_BATCH_UNICAST_SIZE);
-
-                z_clock_t start = z_clock_now();
-                while (z_clock_elapsed_ms(&start) < period) {
-                    // Eventually read hello messages
-                    _z_zbuf_reset(&zbf);
-
-                    // Read bytes from the socket
-                    size_t len = _z_link_recv_zbuf(&zl, &zbf, NULL);
-                    if (len == SIZE_MAX) {
-                        continue;
-                    }
-
-                    _z_scouting_message_t s_msg;
-                    err = _z_scouting_message_decode(&s_msg, &zbf);
-                    if (err != _Z_RES_OK) {
-                        _Z_ERROR("Scouting loop received malformed message");
-                        continue;
-                    }
-
-                    switch (_Z_MID(s_msg._header)) {
-                        case _Z_MID_HELLO: {
-                            _Z_DEBUG("Received _Z_HELLO message");
-                            ret = _z_hello_slist_push_empty(ret);
-                            if (ret == NULL) {
-                                _Z_ERROR_LOG(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-                                err = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
-                                break;
-                            }
-                            _z_hello_t *hello = _z_hello_slist_value(ret);
-                            hello->_version = s_msg._body._hello._version;
-                            hello->_whatami = s_msg._body._hello._whatami;
-                            memcpy(hello->_zid.id, s_msg._body._hello._zid.id, 16);
-
-                            size_t n_loc = _z_locator_array_len(&s_msg._body._hello._locators);
-                            if (n_loc > 0) {
-                                hello->_locators = _z_string_svec_make(n_loc);
-
-                                for (size_t i = 0; i < n_loc; i++) {
-                                    _z_string_t s = _z_locator_to_string(&s_msg._body._hello._locators._val[i]);
-                                    err = _z_string_svec_append(&hello->_locators, &s, true);
-                                    if (err != _Z_RES_OK) {
-                                        _Z_ERROR_LOG(err);
-                                        break;  // bail out of locator loop; case-level break follows below
-                                    }
-                                }
-                            } else {
-                                // @TODO: construct the locator departing from the sock address
-                                _z_string_svec_clear(&hello->_locators);
-                            }
-                            break;
-                        }
-                        default: {
-                            _Z_ERROR_LOG(_Z_ERR_MESSAGE_UNEXPECTED);
-                            err = _Z_ERR_MESSAGE_UNEXPECTED;
-                            _Z_ERROR("Scouting loop received unexpected message");
-                            break;
-                        }
-                    }
-                    _z_s_msg_clear(&s_msg);
-
-                    if (!_z_hello_slist_is_empty(ret) && exit_on_first) {
-                        break;
-                    }
-                }
-
-                _z_link_clear(&zl);
-                _z_zbuf_clear(&zbf);
-            } else {
-                _Z_ERROR_LOG(_Z_ERR_TRANSPORT_TX_FAILED);
-                err = _Z_ERR_TRANSPORT_TX_FAILED;
-                _z_link_clear(&zl);
+    switch (_Z_MID(s_msg._header)) {
+        case _Z_MID_HELLO: {
+            _Z_DEBUG("Received _Z_HELLO message");
+            z_result_t err = __z_scout_add_hello(hellos, &s_msg._body._hello);
+            if (err != _Z_RES_OK) {
+                _Z_ERROR_LOG(err);
+            }
+            break;
+        }
+        default: {
+            _Z_ERROR_LOG(_Z_ERR_MESSAGE_UNEXPECTED);
+            _Z_ERROR("Scouting loop received unexpected message");
+            break;
+        }
+    }
+    _z_s_msg_clear(&s_msg);
+}
+
+static _z_hello_slist_t *__z_scout_loop(const _z_wbuf_t *wbf, const _z_string_svec_t *locators, unsigned long period,
+                                        bool exit_on_first, _z_zbuf_t *zbf) {
+    _z_hello_slist_t *ret = NULL;
+
+    // The receiving buffer, shared by all the links as a single message is processed at a time
+    if (_z_zbuf_capacity(zbf) == 0) {
+        *zbf = _z_zbuf_make(Z_BATCH_UNICAST_SIZE);
+        if (_z_zbuf_capacity(zbf) == 0) {
+            _Z_ERROR_LOG(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+            return NULL;
+        }
+    }
+    _z_scout_links_t links;
+    if (__z_scout_open_links(&links, wbf, locators) != _Z_RES_OK) {
+        return NULL;
+    }
+
+    _z_socket_wait_iter_t iter = {
+        ._ctx = &links,
+        ._current_entry = NULL,
+        ._reset = __z_scout_wait_iter_reset,
+        ._next = __z_scout_wait_iter_next,
+        ._get_socket = __z_scout_wait_iter_get_socket,
+        ._set_ready = __z_scout_wait_iter_set_ready,
+    };
+    z_clock_t start = z_clock_now();
+    unsigned long elapsed = 0;
+    while (((elapsed = z_clock_elapsed_ms(&start)) < period) && !(exit_on_first && (ret != NULL))) {
+        // Sleep until a hello arrives on any of the links or the period is over
+        z_result_t wait_ret = _z_socket_wait_readable(&iter, (uint32_t)(period - elapsed));
+        if (wait_ret == _Z_NO_DATA_PROCESSED) {
+            continue;
+        }
+        for (size_t i = 0; i < links._len; i++) {
+            // Fall back on reading all the links, within the socket timeout, if the wait failed
+            if ((wait_ret == _Z_RES_OK) && !links._val[i]._ready) {
+                continue;
+            }
+            __z_scout_recv(&links._val[i]._link, zbf, &ret);
+            if (exit_on_first && (ret != NULL)) {
+                break;
             }
-        } else {
-            _Z_ERROR_LOG(_Z_ERR_TRANSPORT_OPEN_FAILED);
-            err = _Z_ERR_TRANSPORT_OPEN_FAILED;
         }
     }
-    _ZP_UNUSED(err);
+
+    __z_scout_close_links(&links);
     return ret;
 }
 
-_z_hello_slist_t *_z_scout_inner(const z_what_t what, _z_id_t zid, _z_string_t *locator, const uint32_t timeout,
-                                 const bool exit_on_first) {
+_z_hello_slist_t *_z_scout_inner(const z_what_t what, _z_id_t zid, const _z_string_svec_t *locators,
+                                 const uint32_t timeout, const bool exit_on_first, _z_zbuf_t *zbf) {
     _z_hello_slist_t *ret = NULL;
 
     // Create the buffer to serialize the scout message on
@@ -156,8 +250,8 @@ _z_hello_slist_t *_z_scout_inner(const z_what_t what, _z_id_t zid, _z_string_t *
         return NULL;
     }
 
-    // Scout on multicast
-    ret = __z_scout_loop(&wbf, locator, timeout, exit_on_first);
+    // Scout on all the multicast groups at once
+    ret = __z_scout_loop(&wbf, locators, timeout, exit_on_first, zbf);
 
     _z_wbuf_clear(&wbf);
 
@@ -165,11 +259,12 @@ _z_hello_slist_t *_z_scout_inner(const z_what_t what, _z_id_t zid, _z_string_t *
 }
 #else
 
-_z_hello_slist_t *_z_scout_inner(const z_what_t what, _z_id_t zid, _z_string_t *locator, const uint32_t timeout,
-                                 const bool exit_on_first) {
+_z_hello_slist_t *_z_scout_inner(const z_what_t what, _z_id_t zid, const _z_string_svec_t *locators,
+                                 const uint32_t timeout, const bool exit_on_first, _z_zbuf_t *zbf) {
     _ZP_UNUSED(what);
+    _ZP_UNUSED(zbf);
     _ZP_UNUSED(zid);
-    _ZP_UNUSED(locator);
+    _ZP_UNUSED(locators);
     _ZP_UNUSED(timeout);
     _ZP_UNUSED(exit_on_first);
     return NULL;
@@ -28,135 +28,346 @@
 #include "zenoh-pico/session/resource.h"
 #include "zenoh-pico/session/session.h"
 #include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/utils/hash.h"
 #include "zenoh-pico/utils/locality.h"
 #include "zenoh-pico/utils/logging.h"
 
 #if Z_FEATURE_SUBSCRIPTION == 1
 
-#define _Z_SUBINFOS_VEC_SIZE 4  // Arbitrary initial size
+bool _z_subscription_eq(const _z_subscription_t *other, const _z_subscription_t *this_) {
+    return this_->_id == other->_id;
+}
 
-void _z_unsafe_subscription_cache_invalidate(_z_session_t *zn) {
-#if Z_FEATURE_RX_CACHE == 1
-    _z_subscription_lru_cache_clear(&zn->_subscription_cache);
-#else
-    _ZP_UNUSED(zn);
-#endif
+void _z_subscription_clear(_z_subscription_t *sub) {
+    if (sub->_dropper != NULL) {
+        sub->_dropper(sub->_arg);
+        sub->_dropper = NULL;
+    }
+    _z_declared_keyexpr_clear(&sub->_key);
+    _z_sync_group_notifier_drop(&sub->_session_callback_drop_notifier);
+    _z_sync_group_notifier_drop(&sub->_subscriber_callback_drop_notifier);
+}
+
+static inline _z_subscription_rc_hmap_t *_z_subscriptions_of_kind(_z_session_t *zn, _z_subscriber_kind_t kind) {
+    return (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) ? &zn->_subscriptions : &zn->_liveliness_subscriptions;
+}
+
+static inline _z_epoch_cell_t *_z_subscriptions_snapshot_of_kind(_z_session_t *zn, _z_subscriber_kind_t kind) {
+    return (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) ? &zn->_subscriptions_snapshot
+                                                   : &zn->_liveliness_subscriptions_snapshot;
+}
+
+void _z_subscription_entry_clear(_z_subscription_entry_t *entry) {
+    _z_subscription_rc_drop(&entry->_sub);
+    _z_interned_keyexpr_rc_drop(&entry->_key);
+}
+
+static inline bool _z_subscription_entry_matches(const _z_subscription_entry_t *entry,
+                                                 const _z_interned_keyexpr_t *key, bool is_remote) {
+    bool origin_allowed = is_remote ? _z_locality_allows_remote(entry->_allowed_origin)
+                                    : _z_locality_allows_local(entry->_allowed_origin);
+    return origin_allowed && _z_interned_keyexpr_intersects(_Z_RC_IN_VAL(&entry->_key), key);
 }
 
 #if Z_FEATURE_RX_CACHE == 1
 int _z_subscription_cache_data_compare(const void *first, const void *second) {
     const _z_subscription_cache_data_t *first_data = (const _z_subscription_cache_data_t *)first;
     const _z_subscription_cache_data_t *second_data = (const _z_subscription_cache_data_t *)second;
+    if (first_data->kind != second_data->kind) {
+        return (int)first_data->kind - (int)second_data->kind;
+    }
     if (first_data->is_remote != second_data->is_remote) {
         return (int)first_data->is_remote - (int)second_data->is_remote;
     }
     return _z_keyexpr_compare(&first_data->ke, &second_data->ke);
 }
-#endif  // Z_FEATURE_RX_CACHE == 1
+
+size_t _z_subscription_cache_data_hash(const void *val) { return ((const _z_subscription_cache_data_t *)val)->hash; }
 
 void _z_subscription_cache_data_clear(_z_subscription_cache_data_t *val) {
-    _z_subscription_rc_svec_rc_drop(&val->infos);
+    _z_subscription_entry_rc_svec_rc_drop(&val->infos);
     _z_keyexpr_clear(&val->ke);
 }
 
-bool _z_subscription_eq(const _z_subscription_t *other, const _z_subscription_t *this_) {
-    return this_->_id == other->_id;
+typedef struct {
+    const _z_subscription_t *sub;
+    _z_subscriber_kind_t kind;
+} _z_subscription_cache_invalidation_t;
+
+static bool _z_subscription_cache_data_intersects(const void *val, const void *arg) {
+    const _z_subscription_cache_data_t *data = (const _z_subscription_cache_data_t *)val;
+    const _z_subscription_cache_invalidation_t *inv = (const _z_subscription_cache_invalidation_t *)arg;
+    return (data->kind == inv->kind) && _z_keyexpr_intersects(&data->ke, &inv->sub->_key._inner);
 }
+#endif  // Z_FEATURE_RX_CACHE == 1
 
-void _z_subscription_clear(_z_subscription_t *sub) {
-    if (sub->_dropper != NULL) {
-        sub->_dropper(sub->_arg);
-        sub->_dropper = NULL;
+/**
+ * Immutable view of the subscriptions of one kind. Entries are shared with the previous and next snapshots, so that a
+ * change only creates the entries of the added subscriptions.
+ */
+typedef struct {
+    _z_epoch_node_t _node;  // Must come first
+    size_t _len;
+    _z_subscription_entry_rc_t *_entries;
+#if Z_FEATURE_RX_CACHE == 1
+    // Matches looked up without locking, taken from the cache once per key expression and never replaced
+    size_t _matches_len;
+    _z_atomic_ptr_t *_matches;
+    size_t _generation;  // Of the cache once invalidated for this snapshot, guarded by zn->_mutex_subscription_cache
+#endif
+} _z_subscription_snapshot_t;
+
+static _z_subscription_snapshot_t *_z_subscription_snapshot_alloc(_z_session_t *zn, size_t capacity) {
+    _z_subscription_snapshot_t *snapshot = (_z_subscription_snapshot_t *)z_malloc(sizeof(_z_subscription_snapshot_t));
+    if (snapshot == NULL) {
+        return NULL;
     }
-    _z_declared_keyexpr_clear(&sub->_key);
-    _z_sync_group_notifier_drop(&sub->_session_callback_drop_notifier);
-    _z_sync_group_notifier_drop(&sub->_subscriber_callback_drop_notifier);
+    snapshot->_len = 0;
+    snapshot->_entries = NULL;
+    if (capacity > 0) {
+        snapshot->_entries = (_z_subscription_entry_rc_t *)z_malloc(capacity * sizeof(_z_subscription_entry_rc_t));
+        if (snapshot->_entries == NULL) {
+            z_free(snapshot);
+            return NULL;
+        }
+    }
+#if Z_FEATURE_RX_CACHE == 1
+    _z_session_subscription_cache_mutex_lock(zn);
+    snapshot->_matches_len = zn->_subscription_cache.capacity;
+    // Not consistent with the cache until published and stamped by __unsafe_z_subscription_cache_invalidate
+    snapshot->_generation = zn->_subscription_cache_generation - 1;
+    _z_session_subscription_cache_mutex_unlock(zn);
+    snapshot->_matches = NULL;
+    if (snapshot->_matches_len > 0) {
+        snapshot->_matches = (_z_atomic_ptr_t *)z_malloc(snapshot->_matches_len * sizeof(_z_atomic_ptr_t));
+        if (snapshot->_matches == NULL) {
+            z_free(snapshot->_entries);
+            z_free(snapshot);
+            return NULL;
+        }
+    }
+    for (size_t i = 0; i < snapshot->_matches_len; i++) {
+        _z_atomic_ptr_init(&snapshot->_matches[i], NULL);
+    }
+#else
+    _ZP_UNUSED(zn);
+#endif
+    return snapshot;
 }
 
-_z_subscription_rc_t *__z_get_subscription_by_id(_z_subscription_rc_slist_t *subs, const _z_zint_t id) {
-    _z_subscription_rc_t *ret = NULL;
-
-    _z_subscription_rc_slist_t *xs = subs;
-    while (xs != NULL) {
-        _z_subscription_rc_t *sub = _z_subscription_rc_slist_value(xs);
-        if (id == _Z_RC_IN_VAL(sub)->_id) {
-            ret = sub;
-            break;
+static void _z_subscription_snapshot_delete(_z_subscription_snapshot_t *snapshot) {
+    for (size_t i = 0; i < snapshot->_len; i++) {
+        _z_subscription_entry_rc_drop(&snapshot->_entries[i]);
+    }
+#if Z_FEATURE_RX_CACHE == 1
+    for (size_t i = 0; i < snapshot->_matches_len; i++) {
+        _z_subscription_cache_data_t *data =
+            (_z_subscription_cache_data_t *)_z_atomic_ptr_load(&snapshot->_matches[i], _z_memory_order_acquire);
+        if (data != NULL) {
+            _z_subscription_cache_data_clear(data);
+            z_free(data);
         }
-        xs = _z_subscription_rc_slist_next(xs);
     }
+    z_free(snapshot->_matches);
+#endif
+    z_free(snapshot->_entries);
+    z_free(snapshot);
+}
+
+static void _z_subscription_snapshot_free(_z_epoch_node_t *node) {
+    _z_subscription_snapshot_delete((_z_subscription_snapshot_t *)node);
+}
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_subscriptions
+ */
+static z_result_t __unsafe_z_subscription_entry_new(_z_session_t *zn, const _z_subscription_rc_t *sub,
+                                                    _z_subscription_entry_rc_t *out) {
+    _z_subscription_entry_t entry;
+    _Z_RETURN_IF_ERR(_z_keyexpr_intern(&zn->_subscription_keyexprs, &_Z_RC_IN_VAL(sub)->_key._inner, &entry._key));
+    entry._sub = _z_subscription_rc_clone(sub);
+    entry._allowed_origin = _Z_RC_IN_VAL(sub)->_allowed_origin;
+    entry._id = _Z_RC_IN_VAL(sub)->_id;
+    *out = _z_subscription_entry_rc_new_from_val(&entry);
+    if (_Z_RC_IS_NULL(out)) {
+        _z_subscription_entry_clear(&entry);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _Z_RES_OK;
+}
 
-    return ret;
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_subscriptions
+ *
+ * Creates an entry for each registered subscription, used when there is no previous snapshot to start from.
+ */
+static _z_subscription_snapshot_t *__unsafe_z_subscription_snapshot_new(_z_session_t *zn, _z_subscriber_kind_t kind) {
+    _z_subscription_rc_hmap_t *subs = _z_subscriptions_of_kind(zn, kind);
+    _z_subscription_snapshot_t *snapshot = _z_subscription_snapshot_alloc(zn, _z_subscription_rc_hmap_size(subs));
+    if (snapshot == NULL) {
+        return NULL;
+    }
+    for (_z_subscription_rc_hmap_iter_t it = _z_subscription_rc_hmap_begin(subs);
+         it != _z_subscription_rc_hmap_end(subs); it = _z_subscription_rc_hmap_iter_next(subs, it)) {
+        const _z_subscription_rc_t *sub = &_z_subscription_rc_hmap_at(subs, it)->val;
+        if (__unsafe_z_subscription_entry_new(zn, sub, &snapshot->_entries[snapshot->_len]) != _Z_RES_OK) {
+            _z_subscription_snapshot_delete(snapshot);
+            return NULL;
+        }
+        snapshot->_len++;
+    }
+    return snapshot;
 }
 
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
+ *  - zn->_mutex_subscriptions
+ *
+ * Shares the entries of current that are still registered, which are only looked up if some were removed, and appends
+ * an entry for each of the added subscriptions.
  */
-_z_subscription_rc_t *__unsafe_z_get_subscription_by_id(_z_session_t *zn, _z_subscriber_kind_t kind,
-                                                        const _z_zint_t id) {
-    _z_subscription_rc_slist_t *subs =
-        (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) ? zn->_subscriptions : zn->_liveliness_subscriptions;
-    return __z_get_subscription_by_id(subs, id);
+static _z_subscription_snapshot_t *__unsafe_z_subscription_snapshot_next(_z_session_t *zn, _z_subscriber_kind_t kind,
+                                                                         const _z_subscription_snapshot_t *current,
+                                                                         const _z_subscription_rc_t *added,
+                                                                         size_t added_len, bool removed) {
+    _z_subscription_rc_hmap_t *subs = _z_subscriptions_of_kind(zn, kind);
+    _z_subscription_snapshot_t *snapshot = _z_subscription_snapshot_alloc(zn, current->_len + added_len);
+    if (snapshot == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < current->_len; i++) {
+        uint32_t key = _Z_RC_IN_VAL(&current->_entries[i])->_id;
+        if (removed && (_z_subscription_rc_hmap_get(subs, &key) == NULL)) {
+            continue;
+        }
+        snapshot->_entries[snapshot->_len++] = _z_subscription_entry_rc_clone(&current->_entries[i]);
+    }
+    for (size_t i = 0; i < added_len; i++) {
+        if (__unsafe_z_subscription_entry_new(zn, &added[i], &snapshot->_entries[snapshot->_len]) != _Z_RES_OK) {
+            _z_subscription_snapshot_delete(snapshot);
+            return NULL;
+        }
+        snapshot->_len++;
+    }
+    return snapshot;
 }
 
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
+ *  - zn->_mutex_subscriptions
+ *
+ * Drops the cached matches of the key expressions intersecting one of subs, or all of them if subs is NULL. Called once
+ * the snapshot reflecting the change is published, the generation is advanced so that matches computed from a previous
+ * snapshot are not cached afterwards. The published snapshots of both kinds are then consistent with the cache, the
+ * matches of the other kind being left untouched.
  */
-static z_result_t __unsafe_z_get_subscriptions_by_key(_z_session_t *zn, _z_subscriber_kind_t kind,
-                                                      const _z_keyexpr_t *key, bool is_remote,
-                                                      _z_subscription_rc_svec_t *sub_infos) {
-    _z_subscription_rc_slist_t *subs =
-        (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) ? zn->_subscriptions : zn->_liveliness_subscriptions;
-
-    *sub_infos = _z_subscription_rc_svec_make(_Z_SUBINFOS_VEC_SIZE);
-    _Z_RETURN_ERR_OOM_IF_TRUE(sub_infos->_val == NULL);
-    _z_subscription_rc_slist_t *xs = subs;
-    while (xs != NULL) {
-        // Parse subscription list
-        _z_subscription_rc_t *sub = _z_subscription_rc_slist_value(xs);
-        const _z_subscription_t *sub_val = _Z_RC_IN_VAL(sub);
-        bool origin_allowed = is_remote ? _z_locality_allows_remote(sub_val->_allowed_origin)
-                                        : _z_locality_allows_local(sub_val->_allowed_origin);
-        if (origin_allowed && _z_keyexpr_intersects(&sub_val->_key._inner, key)) {
-            _z_subscription_rc_t sub_clone = _z_subscription_rc_clone(sub);
-            _Z_CLEAN_RETURN_IF_ERR(_z_subscription_rc_svec_append(sub_infos, &sub_clone, false),
-                                   _z_subscription_rc_svec_clear(sub_infos));
+static void __unsafe_z_subscription_cache_invalidate(_z_session_t *zn, _z_subscriber_kind_t kind,
+                                                     const _z_subscription_rc_t *subs, size_t len) {
+#if Z_FEATURE_RX_CACHE == 1
+    _z_session_subscription_cache_mutex_lock(zn);
+    if (subs == NULL) {
+        _z_subscription_lru_cache_clear(&zn->_subscription_cache);
+    }
+    for (size_t i = 0; (subs != NULL) && (i < len); i++) {
+        _z_subscription_cache_invalidation_t inv = {.sub = _Z_RC_IN_VAL(&subs[i]), .kind = kind};
+        _z_subscription_lru_cache_remove_if(&zn->_subscription_cache, _z_subscription_cache_data_intersects, &inv);
+    }
+    zn->_subscription_cache_generation++;
+    _z_subscription_snapshot_t *snapshots[] = {
+        (_z_subscription_snapshot_t *)_z_epoch_cell_load(&zn->_subscriptions_snapshot),
+        (_z_subscription_snapshot_t *)_z_epoch_cell_load(&zn->_liveliness_subscriptions_snapshot)};
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(snapshots); i++) {
+        if (snapshots[i] != NULL) {
+            snapshots[i]->_generation = zn->_subscription_cache_generation;
         }
-        xs = _z_subscription_rc_slist_next(xs);
     }
-    return _Z_RES_OK;
+    _z_session_subscription_cache_mutex_unlock(zn);
+#else
+    _ZP_UNUSED(zn);
+    _ZP_UNUSED(kind);
+    _ZP_UNUSED(subs);
+    _ZP_UNUSED(len);
+#endif
 }
 
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
+ *  - zn->_mutex_subscriptions
+ *
+ * Publishes the snapshot following the registration or, if removed is set, the removal of subs, then invalidates the
+ * cached matches they affect. If subs is NULL, all the subscriptions may have changed. The replaced snapshot is freed
+ * by _z_epoch_cell_reclaim, to be called once the mutex is released. If no snapshot can be allocated, none is
+ * published and samples are dispatched from snapshots taken under the mutex until the next change.
  */
-static z_result_t __unsafe_z_get_subscriptions_rc_by_key(_z_session_t *zn, _z_subscriber_kind_t kind,
-                                                         const _z_keyexpr_t *key, bool is_remote,
-                                                         _z_subscription_rc_svec_rc_t *sub_infos) {
-    *sub_infos = _z_subscription_rc_svec_rc_new_undefined();
-    z_result_t ret = !_Z_RC_IS_NULL(sub_infos) ? _Z_RES_OK : _Z_ERR_SYSTEM_OUT_OF_MEMORY;
-    _Z_SET_IF_OK(ret, __unsafe_z_get_subscriptions_by_key(zn, kind, key, is_remote, _Z_RC_IN_VAL(sub_infos)));
-    if (ret != _Z_RES_OK) {
-        _z_subscription_rc_svec_rc_drop(sub_infos);
+static void __unsafe_z_subscription_snapshot_publish(_z_session_t *zn, _z_subscriber_kind_t kind,
+                                                     const _z_subscription_rc_t *subs, size_t len, bool removed) {
+    _z_epoch_cell_t *cell = _z_subscriptions_snapshot_of_kind(zn, kind);
+    // Writers hold the mutex, the published snapshot can't be replaced and reclaimed meanwhile
+    const _z_subscription_snapshot_t *current = (const _z_subscription_snapshot_t *)_z_epoch_cell_load(cell);
+    const _z_subscription_rc_t *added = removed ? NULL : subs;
+    _z_subscription_snapshot_t *snapshot =
+        ((current != NULL) && (subs != NULL))
+            ? __unsafe_z_subscription_snapshot_next(zn, kind, current, added, (added != NULL) ? len : 0, removed)
+            : __unsafe_z_subscription_snapshot_new(zn, kind);
+    if (snapshot == NULL) {
+        _Z_WARN("Failed to allocate subscriptions snapshot, dispatching under lock");
     }
+    _z_epoch_cell_publish(cell, (snapshot != NULL) ? &snapshot->_node : NULL);
+    __unsafe_z_subscription_cache_invalidate(zn, kind, subs, len);
+}
+
+z_result_t _z_subscription_snapshots_init(_z_session_t *zn) {
+    _z_keyexpr_intern_table_init(&zn->_subscription_keyexprs);
+#if Z_FEATURE_RX_CACHE == 1
+    zn->_subscription_cache = _z_subscription_lru_cache_init(Z_RX_CACHE_SIZE);
+    zn->_subscription_cache_generation = 0;
+#endif
+    _Z_RETURN_IF_ERR(_z_epoch_cell_init(&zn->_subscriptions_snapshot, _z_subscription_snapshot_free));
+    _Z_CLEAN_RETURN_IF_ERR(
+        _z_epoch_cell_init(&zn->_liveliness_subscriptions_snapshot, _z_subscription_snapshot_free),
+        _z_epoch_cell_clear(&zn->_subscriptions_snapshot));
+    // The session is not shared yet and there is no previous snapshot to reclaim
+    __unsafe_z_subscription_snapshot_publish(zn, _Z_SUBSCRIBER_KIND_SUBSCRIBER, NULL, 0, false);
+    __unsafe_z_subscription_snapshot_publish(zn, _Z_SUBSCRIBER_KIND_LIVELINESS_SUBSCRIBER, NULL, 0, false);
     return _Z_RES_OK;
 }
 
+void _z_subscription_snapshots_clear(_z_session_t *zn) {
+#if Z_FEATURE_RX_CACHE == 1
+    _z_subscription_lru_cache_delete(&zn->_subscription_cache);
+#endif
+    _z_epoch_cell_clear(&zn->_subscriptions_snapshot);
+    _z_epoch_cell_clear(&zn->_liveliness_subscriptions_snapshot);
+    _z_keyexpr_intern_table_clear(&zn->_subscription_keyexprs);
+}
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_subscriptions
+ */
+_z_subscription_rc_t *__unsafe_z_get_subscription_by_id(_z_session_t *zn, _z_subscriber_kind_t kind,
+                                                        const _z_zint_t id) {
+    uint32_t key = (uint32_t)id;
+    return _z_subscription_rc_hmap_get(_z_subscriptions_of_kind(zn, kind), &key);
+}
+
 _z_subscription_rc_t _z_get_subscription_by_id(_z_session_t *zn, _z_subscriber_kind_t kind, const _z_zint_t id) {
     _z_subscription_rc_t out = _z_subscription_rc_null();
-    _z_session_mutex_lock(zn);
+    _z_session_subscriptions_mutex_lock(zn);
 
     _z_subscription_rc_t *sub = __unsafe_z_get_subscription_by_id(zn, kind, id);
     if (sub != NULL) {
         out = _z_subscription_rc_clone(sub);
     }
-    _z_session_mutex_unlock(zn);
+    _z_session_subscriptions_mutex_unlock(zn);
 
     return out;
 }
@@ -165,30 +376,27 @@ _z_subscription_rc_t _z_register_subscription(_z_session_t *zn, _z_subscriber_ki
     _Z_DEBUG(">>> Allocating sub decl for (%.*s)", (int)_z_string_len(&s->_key._inner._keyexpr),
              _z_string_data(&s->_key._inner._keyexpr));
 
-    _z_subscription_rc_t *ret = NULL;
     _z_subscription_rc_t out = _z_subscription_rc_new_from_val(s);
     if (_Z_RC_IS_NULL(&out)) {
         return out;
     }
-    if (_z_session_mutex_lock_if_open(zn) != _Z_RES_OK) {
+    if (_z_session_subscriptions_mutex_lock_if_open(zn) != _Z_RES_OK) {
         _z_subscription_rc_drop(&out);
         *s = _z_subscription_null();
         return _z_subscription_rc_null();
     }
-    if (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) {
-        zn->_subscriptions = _z_subscription_rc_slist_push_empty(zn->_subscriptions);
-        ret = _z_subscription_rc_slist_value(zn->_subscriptions);
-    } else {
-        zn->_liveliness_subscriptions = _z_subscription_rc_slist_push_empty(zn->_liveliness_subscriptions);
-        ret = _z_subscription_rc_slist_value(zn->_liveliness_subscriptions);
-    }
-    if (ret == NULL) {
+    _z_subscription_rc_hmap_t *subs = _z_subscriptions_of_kind(zn, kind);
+    uint32_t key = _Z_RC_IN_VAL(&out)->_id;
+    // immediately increase reference count to prevent eventual drop by concurrent session close
+    _z_subscription_rc_t stored = _z_subscription_rc_clone(&out);
+    if (_z_subscription_rc_hmap_insert(subs, &key, &stored) == _z_subscription_rc_hmap_end(subs)) {
+        _z_subscription_rc_drop(&stored);
         _z_subscription_rc_drop(&out);
     } else {
-        // immediately increase reference count to prevent eventual drop by concurrent session close
-        *ret = _z_subscription_rc_clone(&out);
+        __unsafe_z_subscription_snapshot_publish(zn, kind, &out, 1, false);
     }
-    _z_session_mutex_unlock(zn);
+    _z_session_subscriptions_mutex_unlock(zn);
+    _z_epoch_cell_reclaim(_z_subscriptions_snapshot_of_kind(zn, kind));
 
 #if Z_FEATURE_LOCAL_SUBSCRIBER == 1
     if (!_Z_RC_IS_NULL(&out) && kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) {
@@ -202,6 +410,74 @@ _z_subscription_rc_t _z_register_subscription(_z_session_t *zn, _z_subscriber_ki
     return out;
 }
 
+void _z_get_subscriptions_by_id(_z_session_t *zn, _z_subscriber_kind_t kind, const uint32_t *ids, size_t len,
+                                _z_subscription_rc_t *out) {
+    _z_session_subscriptions_mutex_lock(zn);
+    for (size_t i = 0; i < len; i++) {
+        _z_subscription_rc_t *sub = __unsafe_z_get_subscription_by_id(zn, kind, ids[i]);
+        out[i] = (sub != NULL) ? _z_subscription_rc_clone(sub) : _z_subscription_rc_null();
+    }
+    _z_session_subscriptions_mutex_unlock(zn);
+}
+
+z_result_t _z_register_subscriptions(_z_session_t *zn, _z_subscriber_kind_t kind, _z_subscription_t *subs, size_t len,
+                                     _z_subscription_rc_t *out) {
+    z_result_t ret = _Z_RES_OK;
+    size_t created = 0;
+    for (; created < len; created++) {
+        out[created] = _z_subscription_rc_new_from_val(&subs[created]);
+        if (_Z_RC_IS_NULL(&out[created])) {
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+            break;
+        }
+    }
+    if (ret == _Z_RES_OK) {
+        ret = _z_session_subscriptions_mutex_lock_if_open(zn);
+    }
+    if (ret == _Z_RES_OK) {
+        _z_subscription_rc_hmap_t *map = _z_subscriptions_of_kind(zn, kind);
+        size_t inserted = 0;
+        for (; inserted < len; inserted++) {
+            uint32_t key = _Z_RC_IN_VAL(&out[inserted])->_id;
+            _z_subscription_rc_t stored = _z_subscription_rc_clone(&out[inserted]);
+            if (_z_subscription_rc_hmap_insert(map, &key, &stored) == _z_subscription_rc_hmap_end(map)) {
+                _z_subscription_rc_drop(&stored);
+                ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+                break;
+            }
+        }
+        for (size_t i = 0; (ret != _Z_RES_OK) && (i < inserted); i++) {
+            uint32_t key = _Z_RC_IN_VAL(&out[i])->_id;
+            _z_subscription_rc_hmap_remove(map, &key, NULL);
+        }
+        if (ret == _Z_RES_OK) {
+            __unsafe_z_subscription_snapshot_publish(zn, kind, out, len, false);
+        }
+        _z_session_subscriptions_mutex_unlock(zn);
+        _z_epoch_cell_reclaim(_z_subscriptions_snapshot_of_kind(zn, kind));
+    }
+    if (ret != _Z_RES_OK) {
+        for (size_t i = 0; i < len; i++) {
+            if (i < created) {
+                _z_subscription_rc_drop(&out[i]);
+            } else {
+                _z_subscription_clear(&subs[i]);
+            }
+        }
+    }
+    // Subscriptions were either moved into the refcounts or cleared
+    for (size_t i = 0; i < len; i++) {
+        subs[i] = _z_subscription_null();
+    }
+
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+    if ((ret == _Z_RES_OK) && (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER)) {
+        _z_write_filter_notify_subscribers(zn, out, len, true);
+    }
+#endif
+    return ret;
+}
+
 z_result_t _z_trigger_liveliness_subscriptions_declare(_z_session_t *zn, const _z_wireexpr_t *wireexpr,
                                                        const _z_timestamp_t *timestamp,
                                                        _z_transport_peer_common_t *peer) {
@@ -227,83 +503,276 @@ z_result_t _z_trigger_liveliness_subscriptions_undeclare(_z_session_t *zn, const
                                          Z_RELIABILITY_RELIABLE, &source_info, NULL);
 }
 
-static z_result_t _z_subscription_get_infos(_z_session_t *zn, _z_subscriber_kind_t kind,
-                                            _z_subscription_cache_data_t *out, const _z_wireexpr_t *wireexpr,
-                                            _z_transport_peer_common_t *peer) {
-    out->is_remote = (peer != NULL);
-    _Z_RETURN_IF_ERR(_z_get_keyexpr_from_wireexpr(zn, &out->ke, wireexpr, peer, true));
-    _Z_CLEAN_RETURN_IF_ERR(_z_session_mutex_lock_if_open(zn), _z_keyexpr_clear(&out->ke));
-    _z_subscription_cache_data_t *cache_entry = NULL;
+/**
+ * Calls the callbacks of the subscriptions of entries, the last one is handed sample itself and the others a copy of
+ * it. Unless matched is set, the entries that do not accept sample are skipped. The caller keeps the entries, and thus
+ * their subscriptions, alive.
+ */
+static z_result_t _z_subscription_dispatch(const _z_subscription_entry_rc_t *entries, size_t len, bool matched,
+                                           bool is_remote, _z_sample_t *sample) {
     z_result_t ret = _Z_RES_OK;
-#if Z_FEATURE_RX_CACHE == 1
-    cache_entry = _z_subscription_lru_cache_get(&zn->_subscription_cache, out);
-    if (cache_entry != NULL && cache_entry->is_remote != out->is_remote) {
-        cache_entry = NULL;
+    const _z_subscription_t *pending = NULL;
+    bool interned = false;
+    _z_interned_keyexpr_t sample_key =
+        matched ? _z_interned_keyexpr_null() : _z_interned_keyexpr_alias(&sample->keyexpr._inner);
+    for (size_t i = 0; (ret == _Z_RES_OK) && (i < len); i++) {
+        const _z_subscription_entry_t *entry = _Z_RC_IN_VAL(&entries[i]);
+        if (!matched && !_z_subscription_entry_matches(entry, &sample_key, is_remote)) {
+            continue;
+        }
+        if (pending != NULL) {
+            if (!interned) {
+                // Intern the schema once so that sample copies share it
+                ret = _z_encoding_intern(&sample->encoding);
+                interned = true;
+            }
+            _z_sample_t sample_copy;
+            _Z_SET_IF_OK(ret, _z_sample_copy(&sample_copy, sample));
+            if (ret == _Z_RES_OK) {
+                pending->_callback(&sample_copy, pending->_arg);
+                _z_sample_clear(&sample_copy);
+            }
+        }
+        pending = _Z_RC_IN_VAL(&entry->_sub);
     }
-#endif
-    if (cache_entry != NULL) {  // Copy cache entry
-        out->infos = _z_subscription_rc_svec_rc_clone(&cache_entry->infos);
-    } else {  // Construct data and add to cache
-        _Z_SET_IF_OK(ret, __unsafe_z_get_subscriptions_rc_by_key(zn, kind, &out->ke, out->is_remote, &out->infos));
+    if ((pending != NULL) && (ret == _Z_RES_OK)) {
+        pending->_callback(sample, pending->_arg);
+    }
+    return ret;
+}
+
+typedef z_result_t (*_z_subscription_entries_f)(const _z_subscription_entry_rc_t *entries, size_t len, void *arg);
+
+// Calls f with the entries of the published snapshot, or of a snapshot taken under the mutex if none is published
+static z_result_t _z_subscription_visit(_z_session_t *zn, _z_subscriber_kind_t kind, _z_subscription_entries_f f,
+                                        void *arg) {
+    z_result_t ret = _Z_RES_OK;
+    _z_epoch_cell_t *cell = _z_subscriptions_snapshot_of_kind(zn, kind);
+    size_t token = _z_epoch_cell_enter(cell);
+    const _z_subscription_snapshot_t *snapshot = (const _z_subscription_snapshot_t *)_z_epoch_cell_load(cell);
+    if (snapshot != NULL) {
+        ret = f(snapshot->_entries, snapshot->_len, arg);
+        _z_epoch_cell_exit(cell, token);
+        return ret;
+    }
+    _z_epoch_cell_exit(cell, token);
+    _Z_RETURN_IF_ERR(_z_session_subscriptions_mutex_lock_if_open(zn));
+    _z_subscription_snapshot_t *private_snapshot = __unsafe_z_subscription_snapshot_new(zn, kind);
+    _z_session_subscriptions_mutex_unlock(zn);
+    if (private_snapshot == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    ret = f(private_snapshot->_entries, private_snapshot->_len, arg);
+    _z_subscription_snapshot_delete(private_snapshot);
+    return ret;
+}
+
+typedef struct {
+    _z_sample_t *sample;
+    bool is_remote;
+} _z_subscription_dispatch_ctx_t;
+
+static z_result_t _z_subscription_dispatch_visitor(const _z_subscription_entry_rc_t *entries, size_t len, void *arg) {
+    _z_subscription_dispatch_ctx_t *ctx = (_z_subscription_dispatch_ctx_t *)arg;
+    return _z_subscription_dispatch(entries, len, false, ctx->is_remote, ctx->sample);
+}
+
 #if Z_FEATURE_RX_CACHE == 1
-        _z_subscription_cache_data_t cache_storage = _z_subscription_cache_data_null();
-        cache_storage.infos = _z_subscription_rc_svec_rc_clone(&out->infos);
-        cache_storage.is_remote = out->is_remote;
-        _Z_SET_IF_OK(ret, _z_keyexpr_copy(&cache_storage.ke, &out->ke));
-        _Z_SET_IF_OK(ret, _z_subscription_lru_cache_insert(&zn->_subscription_cache, &cache_storage));
+typedef struct {
+    const _z_interned_keyexpr_t *key;
+    bool is_remote;
+    _z_subscription_entry_rc_svec_t *out;
+} _z_subscription_match_ctx_t;
+
+static z_result_t _z_subscription_match_visitor(const _z_subscription_entry_rc_t *entries, size_t len, void *arg) {
+    _z_subscription_match_ctx_t *ctx = (_z_subscription_match_ctx_t *)arg;
+    for (size_t i = 0; i < len; i++) {
+        if (_z_subscription_entry_matches(_Z_RC_IN_VAL(&entries[i]), ctx->key, ctx->is_remote)) {
+            _z_subscription_entry_rc_t entry = _z_subscription_entry_rc_clone(&entries[i]);
+            _Z_CLEAN_RETURN_IF_ERR(_z_subscription_entry_rc_svec_append(ctx->out, &entry, false),
+                                   _z_subscription_entry_rc_drop(&entry));
+        }
+    }
+    return _Z_RES_OK;
+}
+
+// Caches the matches of lookup, unless the cache was invalidated since generation or they were cached meanwhile
+static void _z_subscription_cache_insert(_z_session_t *zn, const _z_subscription_cache_data_t *lookup,
+                                         size_t generation) {
+    _z_subscription_cache_data_t storage = _z_subscription_cache_data_null();
+    storage.infos = _z_subscription_entry_rc_svec_rc_clone(&lookup->infos);
+    storage.kind = lookup->kind;
+    storage.is_remote = lookup->is_remote;
+    storage.hash = lookup->hash;
+    bool inserted = false;
+    if (_z_keyexpr_copy(&storage.ke, &lookup->ke) == _Z_RES_OK) {
+        _z_session_subscription_cache_mutex_lock(zn);
+        if ((generation == zn->_subscription_cache_generation) &&
+            (_z_subscription_lru_cache_get(&zn->_subscription_cache, &storage) == NULL)) {
+            inserted = (_z_subscription_lru_cache_insert(&zn->_subscription_cache, &storage) == _Z_RES_OK);
+        }
+        _z_session_subscription_cache_mutex_unlock(zn);
+    }
+    if (!inserted) {
+        _z_subscription_cache_data_clear(&storage);
+    }
+}
+
+// Returns the matches of lookup kept in snapshot, probed linearly from the slot of its hash
+static const _z_subscription_cache_data_t *_z_subscription_snapshot_kept(_z_subscription_snapshot_t *snapshot,
+                                                                         const _z_subscription_cache_data_t *lookup) {
+    for (size_t i = 0; i < snapshot->_matches_len; i++) {
+        _z_atomic_ptr_t *slot = &snapshot->_matches[(lookup->hash + i) % snapshot->_matches_len];
+        const _z_subscription_cache_data_t *data =
+            (const _z_subscription_cache_data_t *)_z_atomic_ptr_load(slot, _z_memory_order_acquire);
+        if (data == NULL) {
+            break;
+        }
+        if (_z_subscription_cache_data_compare(data, lookup) == 0) {
+            return data;
+        }
+    }
+    return NULL;
+}
+
+// Keeps the matches of lookup in the first free slot of snapshot, unless it is full or they were kept meanwhile
+static void _z_subscription_snapshot_keep(_z_subscription_snapshot_t *snapshot,
+                                          const _z_subscription_cache_data_t *lookup) {
+    if (snapshot->_matches_len == 0) {
+        return;
+    }
+    _z_subscription_cache_data_t *data = (_z_subscription_cache_data_t *)z_malloc(sizeof(_z_subscription_cache_data_t));
+    if (data == NULL) {
+        return;
+    }
+    *data = _z_subscription_cache_data_null();
+    data->infos = _z_subscription_entry_rc_svec_rc_clone(&lookup->infos);
+    data->kind = lookup->kind;
+    data->is_remote = lookup->is_remote;
+    data->hash = lookup->hash;
+    bool kept = false;
+    if (_z_keyexpr_copy(&data->ke, &lookup->ke) == _Z_RES_OK) {
+        for (size_t i = 0; !kept && (i < snapshot->_matches_len); i++) {
+            _z_atomic_ptr_t *slot = &snapshot->_matches[(lookup->hash + i) % snapshot->_matches_len];
+            void *expected = NULL;
+            kept = _z_atomic_ptr_compare_exchange_strong(slot, &expected, data, _z_memory_order_acq_rel,
+                                                         _z_memory_order_acquire);
+            if (!kept && (_z_subscription_cache_data_compare(expected, lookup) == 0)) {
+                break;
+            }
+        }
+    }
+    if (!kept) {
+        _z_subscription_cache_data_clear(data);
+        z_free(data);
+    }
+}
+
+/**
+ * Sets lookup->infos to the entries of snapshot matching it, taken from the cache or collected from the snapshot. They
+ * are only cached, and kept in the snapshot, if the cache is consistent with it: the cache may already be invalidated
+ * for a newer snapshot, or not yet for this one.
+ */
+static z_result_t _z_subscription_snapshot_match(_z_session_t *zn, _z_subscription_snapshot_t *snapshot,
+                                                 _z_subscription_cache_data_t *lookup) {
+    _z_session_subscription_cache_mutex_lock(zn);
+    size_t generation = zn->_subscription_cache_generation;
+    bool consistent = (snapshot->_generation == generation);
+    _z_subscription_cache_data_t *cache_entry =
+        consistent ? _z_subscription_lru_cache_get(&zn->_subscription_cache, lookup) : NULL;
+    if (cache_entry != NULL) {
+        lookup->infos = _z_subscription_entry_rc_svec_rc_clone(&cache_entry->infos);
+    }
+    _z_session_subscription_cache_mutex_unlock(zn);
+
+    if (cache_entry == NULL) {
+        _z_subscription_entry_rc_svec_t matches = _z_subscription_entry_rc_svec_null();
+        _z_interned_keyexpr_t key = _z_interned_keyexpr_alias(&lookup->ke);
+        _z_subscription_match_ctx_t ctx = {.key = &key, .is_remote = lookup->is_remote, .out = &matches};
+        z_result_t ret = _z_subscription_match_visitor(snapshot->_entries, snapshot->_len, &ctx);
+        if (ret == _Z_RES_OK) {
+            lookup->infos = _z_subscription_entry_rc_svec_rc_new_from_val(&matches);
+            if (_Z_RC_IS_NULL(&lookup->infos)) {
+                ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+            }
+        }
         if (ret != _Z_RES_OK) {
-            _z_subscription_cache_data_clear(&cache_storage);
+            _z_subscription_entry_rc_svec_clear(&matches);
+            return ret;
+        }
+        if (consistent) {
+            _z_subscription_cache_insert(zn, lookup, generation);
         }
-#endif
     }
-    _z_session_mutex_unlock(zn);
-    if (ret != _Z_RES_OK) {
-        _z_subscription_cache_data_clear(out);
+    if (consistent) {
+        _z_subscription_snapshot_keep(snapshot, lookup);
+    }
+    return _Z_RES_OK;
+}
+
+/**
+ * Dispatches sample to the subscriptions matching it, looked up by the hash of its key expression, kind and origin
+ * among the matches kept in the published snapshot, without locking. On a miss, they are taken from the cache or
+ * collected from the snapshot, then kept in it.
+ */
+static z_result_t _z_subscription_dispatch_cached(_z_session_t *zn, _z_subscriber_kind_t kind, bool is_remote,
+                                                  _z_sample_t *sample) {
+    _z_subscription_cache_data_t lookup = _z_subscription_cache_data_null();
+    lookup.ke = _z_keyexpr_alias(&sample->keyexpr._inner);
+    lookup.kind = kind;
+    lookup.is_remote = is_remote;
+    // Hashed once, the lookups only compare the key expressions of the matches with the same hash
+    lookup.hash = _z_hash_combine(_z_hash_combine(_z_keyexpr_hash(&lookup.ke), (size_t)kind), (size_t)is_remote);
+
+    _z_epoch_cell_t *cell = _z_subscriptions_snapshot_of_kind(zn, kind);
+    size_t token = _z_epoch_cell_enter(cell);
+    _z_subscription_snapshot_t *snapshot = (_z_subscription_snapshot_t *)_z_epoch_cell_load(cell);
+    if (snapshot == NULL) {
+        _z_epoch_cell_exit(cell, token);
+        _z_subscription_dispatch_ctx_t ctx = {.sample = sample, .is_remote = is_remote};
+        return _z_subscription_visit(zn, kind, _z_subscription_dispatch_visitor, &ctx);
     }
+    z_result_t ret = _Z_RES_OK;
+    const _z_subscription_cache_data_t *matches = _z_subscription_snapshot_kept(snapshot, &lookup);
+    if (matches == NULL) {
+        ret = _z_subscription_snapshot_match(zn, snapshot, &lookup);
+        matches = &lookup;
+    }
+    if (ret == _Z_RES_OK) {
+        const _z_subscription_entry_rc_svec_t *infos = _Z_RC_IN_VAL(&matches->infos);
+        ret = _z_subscription_dispatch((const _z_subscription_entry_rc_t *)infos->_val,
+                                       _z_subscription_entry_rc_svec_len(infos), true, is_remote, sample);
+    }
+    _z_epoch_cell_exit(cell, token);
+    _z_subscription_entry_rc_svec_rc_drop(&lookup.infos);
     return ret;
 }
+#endif  // Z_FEATURE_RX_CACHE == 1
 
 z_result_t _z_trigger_subscriptions_impl(_z_session_t *zn, _z_subscriber_kind_t sub_kind, _z_wireexpr_t *wireexpr,
                                          _z_bytes_t *payload, _z_encoding_t *encoding, const _z_zint_t sample_kind,
                                          const _z_timestamp_t *timestamp, const _z_n_qos_t qos, _z_bytes_t *attachment,
                                          z_reliability_t reliability, _z_source_info_t *source_info,
                                          _z_transport_peer_common_t *peer) {
-    _z_subscription_cache_data_t sub_infos = _z_subscription_cache_data_null();
-    _Z_CLEAN_RETURN_IF_ERR(_z_subscription_get_infos(zn, sub_kind, &sub_infos, wireexpr, peer),
-                           _z_wireexpr_clear(wireexpr);
-                           _z_encoding_clear(encoding); _z_bytes_drop(payload); _z_bytes_drop(attachment););
-    const _z_subscription_rc_svec_t *subs = _Z_RC_IN_VAL(&sub_infos.infos);
-    size_t sub_nb = _z_subscription_rc_svec_len(subs);
-    _Z_DEBUG("Triggering %ju subs for key %.*s", (uintmax_t)sub_nb, (int)_z_string_len(&sub_infos.ke._keyexpr),
-             _z_string_data(&sub_infos.ke._keyexpr));
+    _z_keyexpr_t ke;
+    z_result_t ret = _z_session_is_closed(zn) ? _Z_ERR_SESSION_CLOSED : _Z_RES_OK;
+    _Z_SET_IF_OK(ret, _z_get_keyexpr_from_wireexpr(zn, &ke, wireexpr, peer, true));
+    _Z_CLEAN_RETURN_IF_ERR(ret, _z_wireexpr_clear(wireexpr); _z_encoding_clear(encoding); _z_bytes_drop(payload);
+                           _z_bytes_drop(attachment));
+    _Z_DEBUG("Triggering subs for key %.*s", (int)_z_string_len(&ke._keyexpr), _z_string_data(&ke._keyexpr));
     // Create sample
-    z_result_t ret = _Z_RES_OK;
     _z_sample_t sample;
-    _z_sample_steal_data(&sample, &sub_infos.ke, payload, timestamp, encoding, sample_kind, qos, attachment,
-                         reliability, source_info);
-    // Parse subscription infos svec
-    if (sub_nb == 1) {
-        _z_subscription_t *sub_info = _Z_RC_IN_VAL(_z_subscription_rc_svec_get(subs, 0));
-        sub_info->_callback(&sample, sub_info->_arg);
-    } else {
-        for (size_t i = 0; i < sub_nb; i++) {
-            _z_subscription_t *sub_info = _Z_RC_IN_VAL(_z_subscription_rc_svec_get(subs, i));
-            if (i + 1 == sub_nb) {
-                sub_info->_callback(&sample, sub_info->_arg);
-            } else {
-                _z_sample_t sample_copy;
-                ret = _z_sample_copy(&sample_copy, &sample);
-                if (ret != _Z_RES_OK) {
-                    break;
-                }
-                sub_info->_callback(&sample_copy, sub_info->_arg);
-                _z_sample_clear(&sample_copy);
-            }
-        }
-    }
+    _z_sample_steal_data(&sample, &ke, payload, timestamp, encoding, sample_kind, qos, attachment, reliability,
+                         source_info);
+
+#if Z_FEATURE_RX_CACHE == 1
+    ret = _z_subscription_dispatch_cached(zn, sub_kind, peer != NULL, &sample);
+#else
+    _z_subscription_dispatch_ctx_t ctx = {.sample = &sample, .is_remote = (peer != NULL)};
+    ret = _z_subscription_visit(zn, sub_kind, _z_subscription_dispatch_visitor, &ctx);
+#endif
     _z_wireexpr_clear(wireexpr);
     _z_sample_clear(&sample);
-    _z_subscription_cache_data_clear(&sub_infos);
     return ret;
 }
 
@@ -314,29 +783,60 @@ void _z_unregister_subscription(_z_session_t *zn, _z_subscriber_kind_t kind, _z_
         _z_write_filter_notify_subscriber(zn, &sub_val->_key._inner, sub_val->_allowed_origin, false);
     }
 #endif
-    _z_session_mutex_lock(zn);
-    _z_unsafe_subscription_cache_invalidate(zn);
-    if (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) {
-        zn->_subscriptions = _z_subscription_rc_slist_drop_first_filter(zn->_subscriptions, _z_subscription_rc_eq, sub);
-    } else {
-        zn->_liveliness_subscriptions =
-            _z_subscription_rc_slist_drop_first_filter(zn->_liveliness_subscriptions, _z_subscription_rc_eq, sub);
+    _z_session_subscriptions_mutex_lock(zn);
+    _z_subscription_rc_hmap_t *subs = _z_subscriptions_of_kind(zn, kind);
+    uint32_t key = _Z_RC_IN_VAL(sub)->_id;
+    _z_subscription_rc_t *stored = _z_subscription_rc_hmap_get(subs, &key);
+    if ((stored != NULL) && _z_subscription_rc_eq(stored, sub)) {
+        _z_subscription_rc_hmap_remove(subs, &key, NULL);
+        __unsafe_z_subscription_snapshot_publish(zn, kind, sub, 1, true);
     }
-    _z_session_mutex_unlock(zn);
+    _z_session_subscriptions_mutex_unlock(zn);
+    _z_epoch_cell_reclaim(_z_subscriptions_snapshot_of_kind(zn, kind));
     _z_subscription_rc_drop(sub);
 }
 
+void _z_unregister_subscriptions(_z_session_t *zn, _z_subscriber_kind_t kind, _z_subscription_rc_t *subs, size_t len) {
+#if Z_FEATURE_LOCAL_SUBSCRIBER == 1
+    if (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) {
+        _z_write_filter_notify_subscribers(zn, subs, len, false);
+    }
+#endif
+    _z_session_subscriptions_mutex_lock(zn);
+    _z_subscription_rc_hmap_t *map = _z_subscriptions_of_kind(zn, kind);
+    bool removed = false;
+    for (size_t i = 0; i < len; i++) {
+        uint32_t key = _Z_RC_IN_VAL(&subs[i])->_id;
+        _z_subscription_rc_t *stored = _z_subscription_rc_hmap_get(map, &key);
+        if ((stored != NULL) && _z_subscription_rc_eq(stored, &subs[i])) {
+            _z_subscription_rc_hmap_remove(map, &key, NULL);
+            removed = true;
+        }
+    }
+    if (removed) {
+        __unsafe_z_subscription_snapshot_publish(zn, kind, subs, len, true);
+    }
+    _z_session_subscriptions_mutex_unlock(zn);
+    _z_epoch_cell_reclaim(_z_subscriptions_snapshot_of_kind(zn, kind));
+    for (size_t i = 0; i < len; i++) {
+        _z_subscription_rc_drop(&subs[i]);
+    }
+}
+
 void _z_flush_subscriptions(_z_session_t *zn) {
-    _z_subscription_rc_slist_t *subscriptions, *liveliness_subscriptions;
-    _z_session_mutex_lock(zn);
-    _z_unsafe_subscription_cache_invalidate(zn);
+    _z_subscription_rc_hmap_t subscriptions, liveliness_subscriptions;
+    _z_session_subscriptions_mutex_lock(zn);
     subscriptions = zn->_subscriptions;
     liveliness_subscriptions = zn->_liveliness_subscriptions;
-    zn->_subscriptions = _z_subscription_rc_slist_new();
-    zn->_liveliness_subscriptions = _z_subscription_rc_slist_new();
-    _z_session_mutex_unlock(zn);
-    _z_subscription_rc_slist_free(&subscriptions);
-    _z_subscription_rc_slist_free(&liveliness_subscriptions);
+    zn->_subscriptions = _z_subscription_rc_hmap_new();
+    zn->_liveliness_subscriptions = _z_subscription_rc_hmap_new();
+    __unsafe_z_subscription_snapshot_publish(zn, _Z_SUBSCRIBER_KIND_SUBSCRIBER, NULL, 0, true);
+    __unsafe_z_subscription_snapshot_publish(zn, _Z_SUBSCRIBER_KIND_LIVELINESS_SUBSCRIBER, NULL, 0, true);
+    _z_session_subscriptions_mutex_unlock(zn);
+    _z_epoch_cell_reclaim(&zn->_subscriptions_snapshot);
+    _z_epoch_cell_reclaim(&zn->_liveliness_subscriptions_snapshot);
+    _z_subscription_rc_hmap_destroy(&subscriptions);
+    _z_subscription_rc_hmap_destroy(&liveliness_subscriptions);
 }
 #else  // Z_FEATURE_SUBSCRIPTION == 0
 z_result_t _z_trigger_liveliness_subscriptions_declare(_z_session_t *zn, const _z_wireexpr_t *wireexpr,
@@ -357,6 +857,4 @@ z_result_t _z_trigger_liveliness_subscriptions_undeclare(_z_session_t *zn, const
     return _Z_RES_OK;
 }
 
-void _z_unsafe_subscription_cache_invalidate(_z_session_t *zn) { _ZP_UNUSED(zn); }
-
 #endif  // Z_FEATURE_SUBSCRIPTION == 1
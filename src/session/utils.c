@@ -54,6 +54,84 @@ z_result_t _z_session_generate_zid(_z_id_t *bs, uint8_t size) {
 }
 
 /*------------------ Init/Free/Close session ------------------*/
+#if Z_FEATURE_MULTI_THREAD == 1
+static z_result_t _z_session_registry_mutexes_init(_z_session_t *zn) {
+    _ZP_UNUSED(zn);
+    z_result_t ret = _Z_RES_OK;
+#if Z_FEATURE_SUBSCRIPTION == 1
+    _Z_RETURN_IF_ERR(_z_mutex_init(&zn->_mutex_subscriptions));
+#if Z_FEATURE_RX_CACHE == 1
+    ret = _z_mutex_init(&zn->_mutex_subscription_cache);
+    if (ret != _Z_RES_OK) {
+        _z_mutex_drop(&zn->_mutex_subscriptions);
+        _Z_ERROR_RETURN(ret);
+    }
+#endif
+#endif
+#if Z_FEATURE_QUERYABLE == 1
+    ret = _z_mutex_init(&zn->_mutex_queryables);
+    if (ret != _Z_RES_OK) {
+#if Z_FEATURE_SUBSCRIPTION == 1
+#if Z_FEATURE_RX_CACHE == 1
+        _z_mutex_drop(&zn->_mutex_subscription_cache);
+#endif
+        _z_mutex_drop(&zn->_mutex_subscriptions);
+#endif
+        _Z_ERROR_RETURN(ret);
+    }
+#endif
+#if Z_FEATURE_QUERY == 1
+    ret = _z_mutex_init(&zn->_mutex_queries);
+    if (ret != _Z_RES_OK) {
+#if Z_FEATURE_QUERYABLE == 1
+        _z_mutex_drop(&zn->_mutex_queryables);
+#endif
+#if Z_FEATURE_SUBSCRIPTION == 1
+#if Z_FEATURE_RX_CACHE == 1
+        _z_mutex_drop(&zn->_mutex_subscription_cache);
+#endif
+        _z_mutex_drop(&zn->_mutex_subscriptions);
+#endif
+        _Z_ERROR_RETURN(ret);
+    }
+#endif
+    return ret;
+}
+
+static z_result_t _z_session_last_timestamp_mutex_init(_z_session_t *zn) {
+#if _Z_SESSION_ATOMIC_LAST_TIMESTAMP == 0
+    return _z_mutex_init(&zn->_mutex_last_timestamp);
+#else
+    _ZP_UNUSED(zn);
+    return _Z_RES_OK;
+#endif
+}
+
+static void _z_session_last_timestamp_mutex_drop(_z_session_t *zn) {
+#if _Z_SESSION_ATOMIC_LAST_TIMESTAMP == 0
+    _z_mutex_drop(&zn->_mutex_last_timestamp);
+#else
+    _ZP_UNUSED(zn);
+#endif
+}
+
+static void _z_session_registry_mutexes_drop(_z_session_t *zn) {
+    _ZP_UNUSED(zn);
+#if Z_FEATURE_QUERY == 1
+    _z_mutex_drop(&zn->_mutex_queries);
+#endif
+#if Z_FEATURE_QUERYABLE == 1
+    _z_mutex_drop(&zn->_mutex_queryables);
+#endif
+#if Z_FEATURE_SUBSCRIPTION == 1
+#if Z_FEATURE_RX_CACHE == 1
+    _z_mutex_drop(&zn->_mutex_subscription_cache);
+#endif
+    _z_mutex_drop(&zn->_mutex_subscriptions);
+#endif
+}
+#endif
+
 z_result_t _z_session_init(_z_session_t *zn, const _z_id_t *zid) {
     z_result_t ret = _Z_RES_OK;
     _z_atomic_bool_init(&zn->_is_closed, true);
@@ -65,17 +143,26 @@ z_result_t _z_session_init(_z_session_t *zn, const _z_id_t *zid) {
         _z_mutex_drop(&zn->_mutex_inner);
         _Z_ERROR_RETURN(ret);
     }
-    ret = _z_mutex_init(&zn->_mutex_last_timestamp);
+    ret = _z_session_last_timestamp_mutex_init(zn);
     if (ret != _Z_RES_OK) {
         _z_mutex_rec_drop(&zn->_mutex_transport);
-        _z_mutex_drop(&zn->_mutex_last_timestamp);
+        _z_session_last_timestamp_mutex_drop(zn);
+        _z_mutex_drop(&zn->_mutex_inner);
+        _Z_ERROR_RETURN(ret);
+    }
+    ret = _z_session_registry_mutexes_init(zn);
+    if (ret != _Z_RES_OK) {
+        _z_mutex_rec_drop(&zn->_mutex_transport);
+        _z_session_last_timestamp_mutex_drop(zn);
         _z_mutex_drop(&zn->_mutex_inner);
         _Z_ERROR_RETURN(ret);
     }
 #if Z_FEATURE_ADMIN_SPACE == 1
     ret = _z_mutex_init(&zn->_mutex_admin_space);
     if (ret != _Z_RES_OK) {
+        _z_session_registry_mutexes_drop(zn);
         _z_mutex_rec_drop(&zn->_mutex_transport);
+        _z_session_last_timestamp_mutex_drop(zn);
         _z_mutex_drop(&zn->_mutex_inner);
         _Z_ERROR_RETURN(ret);
     }
@@ -87,30 +174,63 @@ z_result_t _z_session_init(_z_session_t *zn, const _z_id_t *zid) {
     zn->_entity_id = 1;
     zn->_resource_id = 1;
     zn->_query_id = 1;
+#if _Z_SESSION_ATOMIC_LAST_TIMESTAMP == 1
+    _z_atomic_size_init(&zn->_last_timestamp, 0);
+#else
     zn->_last_timestamp = 0;
+#endif
 
     _z_config_init(&zn->_config);
+#if Z_FEATURE_SCOUTING == 1
+    zn->_scout_zbuf = _z_zbuf_null();
+#endif
 #if Z_FEATURE_AUTO_RECONNECT == 1
-    zn->_declaration_cache = NULL;
+    ret = _z_declaration_cache_init(&zn->_declaration_cache);
+    if (ret != _Z_RES_OK) {
+#if Z_FEATURE_MULTI_THREAD == 1
+#if Z_FEATURE_ADMIN_SPACE == 1
+        _z_mutex_drop(&zn->_mutex_admin_space);
+#endif
+        _z_session_registry_mutexes_drop(zn);
+        _z_mutex_rec_drop(&zn->_mutex_transport);
+        _z_session_last_timestamp_mutex_drop(zn);
+        _z_mutex_drop(&zn->_mutex_inner);
+#endif
+        _Z_ERROR_RETURN(ret);
+    }
 #endif
 
     // Initialize the data structs
     zn->_local_resources = NULL;
 #if Z_FEATURE_SUBSCRIPTION == 1
-    zn->_subscriptions = NULL;
-    zn->_liveliness_subscriptions = NULL;
-#if Z_FEATURE_RX_CACHE == 1
-    zn->_subscription_cache = _z_subscription_lru_cache_init(Z_RX_CACHE_SIZE);
+    zn->_subscriptions = _z_subscription_rc_hmap_new();
+    zn->_liveliness_subscriptions = _z_subscription_rc_hmap_new();
+    ret = _z_subscription_snapshots_init(zn);
+    if (ret != _Z_RES_OK) {
+#if Z_FEATURE_MULTI_THREAD == 1
+#if Z_FEATURE_ADMIN_SPACE == 1
+        _z_mutex_drop(&zn->_mutex_admin_space);
 #endif
+        _z_session_registry_mutexes_drop(zn);
+        _z_mutex_rec_drop(&zn->_mutex_transport);
+        _z_session_last_timestamp_mutex_drop(zn);
+        _z_mutex_drop(&zn->_mutex_inner);
+#endif
+#if Z_FEATURE_AUTO_RECONNECT == 1
+        _z_declaration_cache_drop(&zn->_declaration_cache);
+#endif
+        _Z_ERROR_RETURN(ret);
+    }
 #endif
 #if Z_FEATURE_QUERYABLE == 1
-    zn->_local_queryable = NULL;
+    zn->_local_queryable = _z_session_queryable_rc_hmap_new();
+    _z_keyexpr_intern_table_init(&zn->_queryable_keyexprs);
 #if Z_FEATURE_RX_CACHE == 1
     zn->_queryable_cache = _z_queryable_lru_cache_init(Z_RX_CACHE_SIZE);
 #endif
 #endif
 #if Z_FEATURE_QUERY == 1
-    zn->_pending_queries = NULL;
+    zn->_pending_queries = _z_pending_query_hmap_new();
 #endif
 
 #if Z_FEATURE_LIVELINESS == 1
@@ -157,9 +277,16 @@ z_result_t _z_session_init(_z_session_t *zn, const _z_id_t *zid) {
 #if Z_FEATURE_ADMIN_SPACE == 1
         _z_mutex_drop(&zn->_mutex_admin_space);
 #endif
+        _z_session_registry_mutexes_drop(zn);
         _z_mutex_rec_drop(&zn->_mutex_transport);
-        _z_mutex_drop(&zn->_mutex_last_timestamp);
+        _z_session_last_timestamp_mutex_drop(zn);
         _z_mutex_drop(&zn->_mutex_inner);
+#endif
+#if Z_FEATURE_AUTO_RECONNECT == 1
+        _z_declaration_cache_drop(&zn->_declaration_cache);
+#endif
+#if Z_FEATURE_SUBSCRIPTION == 1
+        _z_subscription_snapshots_clear(zn);
 #endif
         _z_sync_group_drop(&zn->_callback_drop_sync_group);
         _z_runtime_clear(&zn->_runtime);
@@ -188,7 +315,7 @@ z_result_t _z_session_close(_z_session_t *zn) {
     _Z_RETURN_IF_ERR(_z_runtime_stop(&zn->_runtime));
     _Z_RETURN_IF_ERR(_z_session_mutex_lock(zn));
 #if Z_FEATURE_AUTO_RECONNECT == 1
-    _z_network_message_slist_free(&zn->_declaration_cache);
+    _z_declaration_cache_clear(&zn->_declaration_cache);
 #endif
     _z_session_mutex_unlock(zn);
     _z_flush_local_resources(zn);
@@ -240,6 +367,9 @@ void _z_session_clear(_z_session_t *zn) {
     _z_session_close(zn);
     _z_runtime_clear(&zn->_runtime);
     _z_config_clear(&zn->_config);
+#if Z_FEATURE_SCOUTING == 1
+    _z_zbuf_clear(&zn->_scout_zbuf);
+#endif
     _z_session_transport_mutex_lock(zn);
     _z_transport_clear(&zn->_tp);
     _z_session_transport_mutex_unlock(zn);
@@ -248,9 +378,16 @@ void _z_session_clear(_z_session_t *zn) {
 #if Z_FEATURE_ADMIN_SPACE == 1
     _z_mutex_drop(&zn->_mutex_admin_space);
 #endif
+    _z_session_registry_mutexes_drop(zn);
     _z_mutex_rec_drop(&zn->_mutex_transport);
-    _z_mutex_drop(&zn->_mutex_last_timestamp);
+    _z_session_last_timestamp_mutex_drop(zn);
     _z_mutex_drop(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
+#if Z_FEATURE_AUTO_RECONNECT == 1
+    _z_declaration_cache_drop(&zn->_declaration_cache);
+#endif
+#if Z_FEATURE_SUBSCRIPTION == 1
+    _z_subscription_snapshots_clear(zn);
+#endif
     _z_sync_group_drop(&zn->_callback_drop_sync_group);
 }
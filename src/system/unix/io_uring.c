@@ -0,0 +1,244 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/link/transport/socket.h"
+
+#if defined(ZENOH_LINUX) && Z_FEATURE_IO_URING == 1
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
+
+#define _Z_SOCKET_URING_ENTRIES 64
+
+/*
+ * The submission and completion rings are shared with the kernel: the kernel moves the submission head and the
+ * completion tail, we move the submission tail and the completion head. Accesses are serialized by the caller (the
+ * transport tx mutex), so only the indices written by the kernel need acquire loads.
+ */
+struct _z_socket_uring_t {
+    int _fd;
+    unsigned _sq_entries;
+    void *_sq_ring;
+    size_t _sq_ring_len;
+    void *_cq_ring;
+    size_t _cq_ring_len;
+    struct io_uring_sqe *_sqes;
+    size_t _sqes_len;
+    unsigned *_sq_head;
+    unsigned *_sq_tail;
+    unsigned *_sq_mask;
+    unsigned *_sq_array;
+    unsigned *_cq_head;
+    unsigned *_cq_tail;
+    unsigned *_cq_mask;
+    struct io_uring_cqe *_cqes;
+    bool _broken;  // A submission failed half-way, the ring is not used anymore
+};
+
+static inline unsigned *_z_socket_uring_field(void *ring, uint32_t offset) {
+    return (unsigned *)_z_ptr_u8_offset((uint8_t *)ring, (ptrdiff_t)offset);
+}
+
+static void _z_socket_uring_unmap(_z_socket_uring_t *ring) {
+    if (ring->_sqes != MAP_FAILED) {
+        munmap(ring->_sqes, ring->_sqes_len);
+    }
+    if ((ring->_cq_ring != MAP_FAILED) && (ring->_cq_ring != ring->_sq_ring)) {
+        munmap(ring->_cq_ring, ring->_cq_ring_len);
+    }
+    if (ring->_sq_ring != MAP_FAILED) {
+        munmap(ring->_sq_ring, ring->_sq_ring_len);
+    }
+    if (ring->_fd >= 0) {
+        close(ring->_fd);
+    }
+}
+
+static z_result_t _z_socket_uring_map(_z_socket_uring_t *ring) {
+    struct io_uring_params params;
+    (void)memset(&params, 0, sizeof(params));
+    ring->_fd = (int)syscall(__NR_io_uring_setup, _Z_SOCKET_URING_ENTRIES, &params);
+    if (ring->_fd < 0) {
+        _Z_DEBUG("io_uring_setup() failed: %s", strerror(errno));
+        return _Z_ERR_GENERIC;
+    }
+    // IORING_OP_SEND came one release before fast poll, so the flag tells whether the kernel knows about it
+    if ((params.features & IORING_FEAT_FAST_POLL) == 0) {
+        _Z_DEBUG("io_uring is too old to send on sockets");
+        return _Z_ERR_GENERIC;
+    }
+
+    ring->_sq_entries = params.sq_entries;
+    ring->_sq_ring_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->_cq_ring_len = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        if (ring->_cq_ring_len > ring->_sq_ring_len) {
+            ring->_sq_ring_len = ring->_cq_ring_len;
+        }
+        ring->_cq_ring_len = ring->_sq_ring_len;
+    }
+
+    ring->_sq_ring = mmap(NULL, ring->_sq_ring_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->_fd,
+                          IORING_OFF_SQ_RING);
+    if (ring->_sq_ring == MAP_FAILED) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    if (single_mmap) {
+        ring->_cq_ring = ring->_sq_ring;
+    } else {
+        ring->_cq_ring = mmap(NULL, ring->_cq_ring_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->_fd,
+                              IORING_OFF_CQ_RING);
+        if (ring->_cq_ring == MAP_FAILED) {
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+    }
+    ring->_sqes_len = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->_sqes = (struct io_uring_sqe *)mmap(NULL, ring->_sqes_len, PROT_READ | PROT_WRITE,
+                                              MAP_SHARED | MAP_POPULATE, ring->_fd, IORING_OFF_SQES);
+    if (ring->_sqes == MAP_FAILED) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+
+    ring->_sq_head = _z_socket_uring_field(ring->_sq_ring, params.sq_off.head);
+    ring->_sq_tail = _z_socket_uring_field(ring->_sq_ring, params.sq_off.tail);
+    ring->_sq_mask = _z_socket_uring_field(ring->_sq_ring, params.sq_off.ring_mask);
+    ring->_sq_array = _z_socket_uring_field(ring->_sq_ring, params.sq_off.array);
+    ring->_cq_head = _z_socket_uring_field(ring->_cq_ring, params.cq_off.head);
+    ring->_cq_tail = _z_socket_uring_field(ring->_cq_ring, params.cq_off.tail);
+    ring->_cq_mask = _z_socket_uring_field(ring->_cq_ring, params.cq_off.ring_mask);
+    ring->_cqes = (struct io_uring_cqe *)_z_socket_uring_field(ring->_cq_ring, params.cq_off.cqes);
+    return _Z_RES_OK;
+}
+
+z_result_t _z_socket_uring_new(_z_socket_uring_t **ring) {
+    _z_socket_uring_t *r = (_z_socket_uring_t *)z_malloc(sizeof(_z_socket_uring_t));
+    if (r == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    (void)memset(r, 0, sizeof(_z_socket_uring_t));
+    r->_fd = -1;
+    r->_sq_ring = MAP_FAILED;
+    r->_cq_ring = MAP_FAILED;
+    r->_sqes = MAP_FAILED;
+
+    z_result_t ret = _z_socket_uring_map(r);
+    if (ret != _Z_RES_OK) {
+        _z_socket_uring_unmap(r);
+        z_free(r);
+        return ret;
+    }
+    *ring = r;
+    return _Z_RES_OK;
+}
+
+void _z_socket_uring_free(_z_socket_uring_t **ring) {
+    _z_socket_uring_t *r = *ring;
+    if (r != NULL) {
+        _z_socket_uring_unmap(r);
+        z_free(r);
+        *ring = NULL;
+    }
+}
+
+// Consumes the available completions, failed or short sends are only logged like the sequential sends ignore them
+static unsigned _z_socket_uring_reap(_z_socket_uring_t *ring, size_t len) {
+    unsigned head = *ring->_cq_head;
+    unsigned tail = __atomic_load_n(ring->_cq_tail, __ATOMIC_ACQUIRE);
+    unsigned nb = tail - head;
+    for (; head != tail; head++) {
+        const struct io_uring_cqe *cqe = &ring->_cqes[head & *ring->_cq_mask];
+        if (cqe->res < 0) {
+            _Z_DEBUG("Send on socket %d failed: %s", (int)cqe->user_data, strerror(-cqe->res));
+        } else if ((size_t)cqe->res != len) {
+            _Z_DEBUG("Send on socket %d was short: %d of %zu bytes", (int)cqe->user_data, cqe->res, len);
+        }
+    }
+    __atomic_store_n(ring->_cq_head, tail, __ATOMIC_RELEASE);
+    return nb;
+}
+
+// Submits the queued sends and waits for all of them to complete, returns how many the kernel took
+static unsigned _z_socket_uring_submit(_z_socket_uring_t *ring, unsigned nb, size_t len) {
+    unsigned submitted = 0;
+    unsigned completed = 0;
+    while (completed < nb) {
+        unsigned to_submit = *ring->_sq_tail - __atomic_load_n(ring->_sq_head, __ATOMIC_ACQUIRE);
+        int res = (int)syscall(__NR_io_uring_enter, ring->_fd, to_submit, submitted + to_submit - completed,
+                               IORING_ENTER_GETEVENTS, NULL, 0);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            _Z_ERROR("io_uring_enter() failed: %s", strerror(errno));
+            // Drop what the kernel did not take so that it is not sent later with a stale buffer
+            __atomic_store_n(ring->_sq_tail, __atomic_load_n(ring->_sq_head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+            ring->_broken = true;
+            break;
+        }
+        submitted += (unsigned)res;
+        completed += _z_socket_uring_reap(ring, len);
+    }
+    return submitted;
+}
+
+z_result_t _z_socket_uring_send_all(_z_socket_uring_t *ring, _z_socket_wait_iter_t *iter, const uint8_t *ptr,
+                                    size_t len) {
+    if (ring->_broken) {
+        return _Z_ERR_GENERIC;
+    }
+    _z_socket_wait_iter_reset(iter);
+    bool more = _z_socket_wait_iter_next(iter);
+    bool sent = !more;
+    while (more && !ring->_broken) {
+        unsigned tail = *ring->_sq_tail;
+        unsigned nb = 0;
+        for (; more && (nb < ring->_sq_entries); nb++) {
+            unsigned idx = (tail + nb) & *ring->_sq_mask;
+            struct io_uring_sqe *sqe = &ring->_sqes[idx];
+            int fd = _z_socket_wait_iter_get_socket(iter)->_fd;
+            (void)memset(sqe, 0, sizeof(struct io_uring_sqe));
+            sqe->opcode = IORING_OP_SEND;
+            sqe->fd = fd;
+            sqe->addr = (__u64)(uintptr_t)ptr;
+            sqe->len = (uint32_t)len;
+            // Same semantics as the sequential send on a non-blocking socket: never park the request in the kernel
+            sqe->msg_flags = MSG_NOSIGNAL | MSG_DONTWAIT;
+            sqe->user_data = (__u64)(unsigned int)fd;
+            ring->_sq_array[idx] = idx;
+            more = _z_socket_wait_iter_next(iter);
+        }
+        __atomic_store_n(ring->_sq_tail, tail + nb, __ATOMIC_RELEASE);
+        if (_z_socket_uring_submit(ring, nb, len) > 0) {
+            sent = true;
+        }
+    }
+    if (!sent) {
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+    }
+    return _Z_RES_OK;
+}
+
+#endif /* defined(ZENOH_LINUX) && Z_FEATURE_IO_URING == 1 */
@@ -99,6 +99,26 @@ z_result_t _z_socket_wait_readable(_z_socket_wait_iter_t *iter, uint32_t timeout
     return has_data ? _Z_RES_OK : _Z_NO_DATA_PROCESSED;
 }
 
+z_result_t _z_socket_wait_writable(const _z_sys_net_socket_t *sock, uint32_t timeout_ms) {
+    fd_set write_fds;
+    FD_ZERO(&write_fds);
+    FD_SET(sock->_fd, &write_fds);
+
+    struct timeval timeout = {
+        .tv_sec = (time_t)(timeout_ms / 1000U),
+        .tv_usec = (suseconds_t)((timeout_ms % 1000U) * 1000U),
+    };
+    int result = select(sock->_fd + 1, NULL, &write_fds, NULL, &timeout);
+    if (result < 0) {
+        if (errno == EINTR) {
+            return _Z_NO_DATA_PROCESSED;
+        }
+        _Z_DEBUG("Errno: %d\n", errno);
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    return (result > 0) ? _Z_RES_OK : _Z_NO_DATA_PROCESSED;
+}
+
 #if Z_FEATURE_LINK_BLUETOOTH == 1
 #error "Bluetooth not supported yet on Unix port of Zenoh-Pico"
 #endif
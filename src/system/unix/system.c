@@ -32,6 +32,12 @@
 #include "zenoh-pico/system/common/system_error.h"
 #include "zenoh-pico/system/platform.h"
 
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 /*------------------ Random ------------------*/
 uint8_t z_random_u8(void) {
     uint8_t ret = 0;
@@ -337,3 +343,52 @@ z_result_t _z_get_time_since_epoch(_z_time_since_epoch *t) {
     t->nanos = (uint32_t)now.tv_nsec;
     return _Z_RES_OK;
 }
+
+/*------------------ Mapped files ------------------*/
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+z_result_t _z_mapped_file_open(_z_mapped_file_t *file, const char *path, size_t size) {
+    if (size == 0) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        _z_report_system_error(errno);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_GENERIC);
+    }
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (((size_t)st.st_size != size) && (ftruncate(fd, (off_t)size) != 0))) {
+        _z_report_system_error(errno);
+        close(fd);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_GENERIC);
+    }
+    void *addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        _z_report_system_error(errno);
+        close(fd);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_GENERIC);
+    }
+    file->_addr = (uint8_t *)addr;
+    file->_size = size;
+    file->_fd = fd;
+    return _Z_RES_OK;
+}
+
+z_result_t _z_mapped_file_flush(_z_mapped_file_t *file) {
+    if (msync(file->_addr, file->_size, MS_ASYNC) != 0) {
+        _z_report_system_error(errno);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_GENERIC);
+    }
+    return _Z_RES_OK;
+}
+
+void _z_mapped_file_close(_z_mapped_file_t *file) {
+    if (file->_addr != NULL) {
+        msync(file->_addr, file->_size, MS_SYNC);
+        munmap(file->_addr, file->_size);
+        close(file->_fd);
+        file->_addr = NULL;
+        file->_size = 0;
+        file->_fd = -1;
+    }
+}
+#endif
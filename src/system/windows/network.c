@@ -82,6 +82,22 @@ z_result_t _z_socket_wait_readable(_z_socket_wait_iter_t *iter, uint32_t timeout
     return has_data ? _Z_RES_OK : _Z_NO_DATA_PROCESSED;
 }
 
+z_result_t _z_socket_wait_writable(const _z_sys_net_socket_t *sock, uint32_t timeout_ms) {
+    fd_set write_fds;
+    FD_ZERO(&write_fds);
+    FD_SET(sock->_sock._fd, &write_fds);
+
+    struct timeval timeout = {
+        .tv_sec = (long)(timeout_ms / 1000U),
+        .tv_usec = (long)((timeout_ms % 1000U) * 1000U),
+    };
+    int result = select(0, NULL, &write_fds, NULL, &timeout);
+    if (result < 0) {
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    return (result > 0) ? _Z_RES_OK : _Z_NO_DATA_PROCESSED;
+}
+
 #if Z_FEATURE_LINK_BLUETOOTH == 1
 #error "Bluetooth not supported yet on Windows port of Zenoh-Pico"
 #endif
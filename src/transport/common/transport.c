@@ -29,6 +29,14 @@ void _z_transport_common_clear(_z_transport_common_t *ztc) {
     // Clean up the buffers
     _z_wbuf_clear(&ztc->_wbuf);
     _z_zbuf_clear(&ztc->_zbuf);
+#if Z_FEATURE_IO_URING == 1
+    _z_socket_uring_free(&ztc->_uring);
+#endif
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    z_free(ztc->_compression_buf);
+    z_free(ztc->_compression_ctx);
+    _z_zbuf_clear(&ztc->_zbuf_decompressed);
+#endif
 
     _z_link_free(&ztc->_link);
     _z_session_weak_drop(&ztc->_session);
@@ -14,6 +14,8 @@
 
 #include "zenoh-pico/transport/common/tx.h"
 
+#include <string.h>
+
 #include "zenoh-pico/api/constants.h"
 #include "zenoh-pico/protocol/codec/core.h"
 #include "zenoh-pico/protocol/codec/network.h"
@@ -61,39 +63,164 @@ static _z_zint_t _z_transport_tx_get_sn(_z_transport_common_t *ztc, z_reliabilit
     return sn;
 }
 
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+// Smaller batches, like keep alives, are not worth compressing
+#define _Z_TRANSPORT_TX_COMPRESSION_MIN_LEN 64
+
+static inline size_t _z_transport_tx_batch_header_pos(const _z_transport_common_t *ztc) {
+    return (ztc->_link->_cap._flow == Z_LINK_CAP_FLOW_STREAM) ? _Z_MSG_LEN_ENC_SIZE : 0;
+}
+
+// Replaces the batch content by its compressed form when it is smaller, and flags it in the batch header
+static void _z_transport_tx_compress_batch(_z_transport_common_t *ztc) {
+    size_t hdr_pos = _z_transport_tx_batch_header_pos(ztc);
+    size_t start = hdr_pos + _Z_BATCH_HEADER_SIZE;
+    size_t len = _z_wbuf_get_wpos(&ztc->_wbuf) - start;
+    if (len < _Z_TRANSPORT_TX_COMPRESSION_MIN_LEN) {
+        return;
+    }
+    uint8_t *buf = _z_wbuf_get_iosli(&ztc->_wbuf, 0)->_buf;
+    size_t clen = _z_lz4_compress(ztc->_compression_ctx, &buf[start], len, ztc->_compression_buf, len - 1);
+    if (clen == 0) {
+        return;
+    }
+    (void)memcpy(&buf[start], ztc->_compression_buf, clen);
+    _z_wbuf_put(&ztc->_wbuf, _Z_BATCH_HEADER_COMPRESSION, hdr_pos);
+    _z_wbuf_set_wpos(&ztc->_wbuf, start + clen);
+}
+#endif
+
+static void _z_transport_tx_prepare_batch(_z_transport_common_t *ztc) {
+    __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    if (ztc->_compression) {
+        size_t hdr_pos = _z_transport_tx_batch_header_pos(ztc);
+        _z_wbuf_put(&ztc->_wbuf, 0, hdr_pos);
+        _z_wbuf_set_wpos(&ztc->_wbuf, hdr_pos + _Z_BATCH_HEADER_SIZE);
+    }
+#endif
+}
+
+static void _z_transport_tx_finalize_batch(_z_transport_common_t *ztc) {
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    if (ztc->_compression) {
+        _z_transport_tx_compress_batch(ztc);
+    }
+#endif
+    __unsafe_z_finalize_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+}
+
+#if Z_FEATURE_IO_URING == 1
+static void _z_transport_tx_peers_iter_reset(_z_socket_wait_iter_t *iter) { iter->_current_entry = NULL; }
+
+static bool _z_transport_tx_peers_iter_next(_z_socket_wait_iter_t *iter) {
+    if (iter->_current_entry == NULL) {
+        iter->_current_entry = iter->_ctx;
+    } else {
+        iter->_current_entry =
+            _z_transport_peer_unicast_slist_next((_z_transport_peer_unicast_slist_t *)iter->_current_entry);
+    }
+    return iter->_current_entry != NULL;
+}
+
+static const _z_sys_net_socket_t *_z_transport_tx_peers_iter_get_socket(const _z_socket_wait_iter_t *iter) {
+    _z_transport_peer_unicast_t *peer =
+        _z_transport_peer_unicast_slist_value((_z_transport_peer_unicast_slist_t *)iter->_current_entry);
+    return &peer->_socket;
+}
+#endif
+
+// Send the buffer on every peer socket, a peer failing doesn't prevent the others from receiving it
+static void _z_transport_tx_send_to_peers(_z_transport_common_t *ztc, _z_transport_peer_unicast_slist_t *peers) {
+#if Z_FEATURE_IO_URING == 1
+    if (ztc->_uring != NULL) {
+        _z_socket_wait_iter_t iter = {
+            ._ctx = peers,
+            ._current_entry = NULL,
+            ._reset = _z_transport_tx_peers_iter_reset,
+            ._next = _z_transport_tx_peers_iter_next,
+            ._get_socket = _z_transport_tx_peers_iter_get_socket,
+            ._set_ready = NULL,
+        };
+        if (_z_link_send_wbuf_uring(&ztc->_wbuf, ztc->_uring, &iter) == _Z_RES_OK) {
+            return;
+        }
+        // Nothing was sent, don't try again and go on with sequential sends
+        _z_socket_uring_free(&ztc->_uring);
+    }
+#endif
+    _z_transport_peer_unicast_slist_t *curr_list = peers;
+    while (curr_list != NULL) {
+        _z_transport_peer_unicast_t *curr_peer = _z_transport_peer_unicast_slist_value(curr_list);
+        // Send on peer socket
+        _z_link_write_wbuf(ztc->_link, &ztc->_wbuf, &curr_peer->_socket);
+        curr_list = _z_transport_peer_unicast_slist_next(curr_list);
+    }
+}
+
+static inline bool _z_transport_tx_user_batching(const _z_transport_common_t *ztc) {
+#if Z_FEATURE_BATCHING == 1
+    return ztc->_batch_state == _Z_BATCHING_ACTIVE;
+#else
+    _ZP_UNUSED(ztc);
+    return false;
+#endif
+}
+
+// Writes out what the link kept of the batches written, a peer failing doesn't prevent the others from being flushed
+static z_result_t _z_transport_tx_flush_link(_z_transport_common_t *ztc, _z_transport_peer_unicast_slist_t *peers) {
+    if (ztc->_link->_flush_f == NULL) {
+        return _Z_RES_OK;
+    }
+    if (peers == NULL) {
+        return _z_link_flush(ztc->_link, NULL);
+    }
+    _z_transport_peer_unicast_slist_t *curr_list = peers;
+    while (curr_list != NULL) {
+        _z_transport_peer_unicast_t *curr_peer = _z_transport_peer_unicast_slist_value(curr_list);
+        _z_link_flush(ztc->_link, &curr_peer->_socket);
+        curr_list = _z_transport_peer_unicast_slist_next(curr_list);
+    }
+    return _Z_RES_OK;
+}
+
+/**
+ * Batches are written without flushing the link, so that a link buffering its writes fills its frames across them.
+ * The link is flushed once a send is done, a user batch defers it to its own flush unless the message is express.
+ */
+static z_result_t _z_transport_tx_end_send(_z_transport_common_t *ztc, _z_transport_peer_unicast_slist_t *peers,
+                                           bool express, z_result_t ret) {
+    if (express || !_z_transport_tx_user_batching(ztc)) {
+        z_result_t flush_ret = _z_transport_tx_flush_link(ztc, peers);
+        _Z_SET_IF_OK(ret, flush_ret);
+    }
+    return ret;
+}
+
 #if Z_FEATURE_FRAGMENTATION == 1
-static z_result_t _z_transport_tx_send_fragment_inner(_z_transport_common_t *ztc, _z_wbuf_t *frag_buff,
-                                                      const _z_network_message_t *n_msg, z_reliability_t reliability,
-                                                      _z_zint_t first_sn, _z_transport_peer_unicast_slist_t *peers) {
+static z_result_t _z_transport_tx_send_fragments(_z_transport_common_t *ztc, _z_wbuf_t *frag_buff,
+                                                 z_reliability_t reliability, _z_zint_t first_sn,
+                                                 _z_transport_peer_unicast_slist_t *peers) {
     bool is_first = true;
     _z_zint_t sn = first_sn;
-    // Encode message on temp buffer
-    _Z_RETURN_IF_ERR(_z_network_message_encode(frag_buff, n_msg));
-    // Fragment message
     while (_z_wbuf_len(frag_buff) > 0) {
         // Get fragment sequence number
         if (!is_first) {
             sn = _z_transport_tx_get_sn(ztc, reliability);
         }
         // Serialize fragment
-        __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+        _z_transport_tx_prepare_batch(ztc);
         z_result_t ret = __unsafe_z_serialize_zenoh_fragment(&ztc->_wbuf, frag_buff, reliability, sn, is_first);
         if (ret != _Z_RES_OK) {
             _Z_ERROR("Fragment serialization failed with err %d", ret);
             return ret;
         }
         // Send fragment
-        __unsafe_z_finalize_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+        _z_transport_tx_finalize_batch(ztc);
         if (peers == NULL) {
-            _Z_RETURN_IF_ERR(_z_link_send_wbuf(ztc->_link, &ztc->_wbuf, NULL));
+            _Z_RETURN_IF_ERR(_z_link_write_wbuf(ztc->_link, &ztc->_wbuf, NULL));
         } else {
-            _z_transport_peer_unicast_slist_t *curr_list = peers;
-            while (curr_list != NULL) {
-                _z_transport_peer_unicast_t *curr_peer = _z_transport_peer_unicast_slist_value(curr_list);
-                // Send on peer socket
-                _z_link_send_wbuf(ztc->_link, &ztc->_wbuf, &curr_peer->_socket);
-                curr_list = _z_transport_peer_unicast_slist_next(curr_list);
-            }
+            _z_transport_tx_send_to_peers(ztc, peers);
         }
         ztc->_transmitted = true;  // Tell session we transmitted data
         is_first = false;
@@ -101,6 +228,15 @@ static z_result_t _z_transport_tx_send_fragment_inner(_z_transport_common_t *ztc
     return _Z_RES_OK;
 }
 
+static z_result_t _z_transport_tx_send_fragment_inner(_z_transport_common_t *ztc, _z_wbuf_t *frag_buff,
+                                                      const _z_network_message_t *n_msg, z_reliability_t reliability,
+                                                      _z_zint_t first_sn, _z_transport_peer_unicast_slist_t *peers) {
+    // Encode message on temp buffer
+    _Z_RETURN_IF_ERR(_z_network_message_encode(frag_buff, n_msg));
+    // Fragment message
+    return _z_transport_tx_send_fragments(ztc, frag_buff, reliability, first_sn, peers);
+}
+
 static z_result_t _z_transport_tx_send_fragment(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
                                                 z_reliability_t reliability, _z_zint_t first_sn,
                                                 _z_transport_peer_unicast_slist_t *peers) {
@@ -137,18 +273,12 @@ static inline bool _z_transport_tx_batch_has_data(_z_transport_common_t *ztc) {
 }
 
 static z_result_t _z_transport_tx_flush_buffer(_z_transport_common_t *ztc, _z_transport_peer_unicast_slist_t *peers) {
-    __unsafe_z_finalize_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+    _z_transport_tx_finalize_batch(ztc);
     // Send network message
     if (peers == NULL) {
-        _Z_RETURN_IF_ERR(_z_link_send_wbuf(ztc->_link, &ztc->_wbuf, NULL));
+        _Z_RETURN_IF_ERR(_z_link_write_wbuf(ztc->_link, &ztc->_wbuf, NULL));
     } else {
-        _z_transport_peer_unicast_slist_t *curr_list = peers;
-        while (curr_list != NULL) {
-            _z_transport_peer_unicast_t *curr_peer = _z_transport_peer_unicast_slist_value(curr_list);
-            // Send on peer socket
-            _z_link_send_wbuf(ztc->_link, &ztc->_wbuf, &curr_peer->_socket);
-            curr_list = _z_transport_peer_unicast_slist_next(curr_list);
-        }
+        _z_transport_tx_send_to_peers(ztc, peers);
     }
     ztc->_transmitted = true;  // Tell session we transmitted data
 #if Z_FEATURE_BATCHING == 1
@@ -181,7 +311,7 @@ static z_result_t _z_transport_tx_batch_overflow(_z_transport_common_t *ztc, con
     // Send batch
     _Z_RETURN_IF_ERR(_z_transport_tx_flush_buffer(ztc, peers));
     // Init buffer
-    __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+    _z_transport_tx_prepare_batch(ztc);
     sn = _z_transport_tx_get_sn(ztc, reliability);
     _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, reliability);
     _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, &t_msg));
@@ -227,7 +357,7 @@ static z_result_t _z_transport_tx_send_n_msg_inner(_z_transport_common_t *ztc, c
     _z_zint_t sn = 0;
     bool batch_has_data = _z_transport_tx_batch_has_data(ztc);
     if (!batch_has_data) {
-        __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+        _z_transport_tx_prepare_batch(ztc);
         sn = _z_transport_tx_get_sn(ztc, reliability);
         _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, reliability);
         _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, &t_msg));
@@ -260,7 +390,7 @@ static z_result_t _z_transport_tx_send_t_msg_inner(_z_transport_common_t *ztc, c
         _Z_RETURN_IF_ERR(_z_transport_tx_flush_buffer(ztc, peers));
     }
     // Encode transport message
-    __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+    _z_transport_tx_prepare_batch(ztc);
     _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, t_msg));
     // Send message
     return _z_transport_tx_flush_buffer(ztc, peers);
@@ -274,6 +404,7 @@ z_result_t _z_transport_tx_send_t_msg(_z_transport_common_t *ztc, const _z_trans
     _z_transport_tx_mutex_lock(ztc, true);
 
     ret = _z_transport_tx_send_t_msg_inner(ztc, t_msg, peers);
+    ret = _z_transport_tx_end_send(ztc, peers, true, ret);
 
     _z_transport_tx_mutex_unlock(ztc);
     return ret;
@@ -299,6 +430,65 @@ static z_result_t _z_transport_tx_send_n_msg(_z_transport_common_t *ztc, const _
     }
     // Process message
     ret = _z_transport_tx_send_n_msg_inner(ztc, n_msg, reliability, peers);
+    ret = _z_transport_tx_end_send(ztc, peers, _z_transport_tx_get_express_status(n_msg), ret);
+    if (!_z_transport_batch_hold_tx_mutex()) {
+        _z_transport_tx_mutex_unlock(ztc);
+    }
+    return ret;
+}
+
+static z_result_t _z_transport_tx_send_n_msgs(_z_transport_common_t *ztc, const _z_network_message_t *n_msgs,
+                                              size_t len, z_reliability_t reliability, z_congestion_control_t cong_ctrl,
+                                              _z_transport_peer_unicast_slist_t *peers) {
+    z_result_t ret = _Z_RES_OK;
+    _Z_DEBUG("Send %zu network messages", len);
+
+    // Acquire the lock once for all the messages and drop them if needed
+    if (!_z_transport_batch_hold_tx_mutex()) {
+        ret = _z_transport_tx_mutex_lock(ztc, cong_ctrl == Z_CONGESTION_CONTROL_BLOCK);
+    }
+    if (ret != _Z_RES_OK) {
+        _Z_INFO("Dropping zenoh messages because of congestion control");
+        return ret;
+    }
+#if Z_FEATURE_BATCHING == 1
+    // Encode the messages back to back and only flush at the end, unless they are appended to a user batch
+    bool own_batch = (ztc->_batch_state != _Z_BATCHING_ACTIVE);
+    if (own_batch) {
+        ztc->_batch_count = 0;
+        ztc->_batch_state = _Z_BATCHING_ACTIVE;
+    }
+    size_t good_wpos = _z_wbuf_get_wpos(&ztc->_wbuf);
+    size_t good_count = ztc->_batch_count;
+#endif
+    bool express = false;
+    for (size_t i = 0; (ret == _Z_RES_OK) && (i < len); i++) {
+#if Z_FEATURE_BATCHING == 1
+        good_wpos = _z_wbuf_get_wpos(&ztc->_wbuf);
+        good_count = ztc->_batch_count;
+#endif
+        express = express || _z_transport_tx_get_express_status(&n_msgs[i]);
+        ret = _z_transport_tx_send_n_msg_inner(ztc, &n_msgs[i], reliability, peers);
+    }
+#if Z_FEATURE_BATCHING == 1
+    // A message that failed without flushing the batch may have left part of its encoding after the messages that
+    // precede it, drop it so that only whole messages are sent
+    if ((ret != _Z_RES_OK) && (good_count > 0) && (ztc->_batch_count == good_count)) {
+        _z_wbuf_set_wpos(&ztc->_wbuf, good_wpos);
+    }
+    if (own_batch) {
+        // The messages encoded before a failure are still sent, the error is reported once they are
+        if (ztc->_batch_count > 0) {
+            z_result_t flush_ret = _z_transport_tx_flush_buffer(ztc, peers);
+            if (ret == _Z_RES_OK) {
+                ret = flush_ret;
+            }
+        }
+        ztc->_batch_count = 0;
+        ztc->_batch_state = _Z_BATCHING_IDLE;
+    }
+#endif
+    ret = _z_transport_tx_end_send(ztc, peers, express, ret);
     if (!_z_transport_batch_hold_tx_mutex()) {
         _z_transport_tx_mutex_unlock(ztc);
     }
@@ -309,8 +499,8 @@ static z_result_t _z_transport_tx_send_n_batch(_z_transport_common_t *ztc, z_con
                                                _z_transport_peer_unicast_slist_t *peers) {
 #if Z_FEATURE_BATCHING == 1
     z_result_t ret = _Z_RES_OK;
-    // Check batch size
-    if (ztc->_batch_count > 0) {
+    // An empty batch may still leave data kept by the link from the batches written before
+    if ((ztc->_batch_count > 0) || (ztc->_link->_flush_f != NULL)) {
         // Acquire the lock and drop the message if needed
         if (!_z_transport_batch_hold_tx_mutex()) {
             ret = _z_transport_tx_mutex_lock(ztc, cong_ctrl == Z_CONGESTION_CONTROL_BLOCK);
@@ -320,8 +510,12 @@ static z_result_t _z_transport_tx_send_n_batch(_z_transport_common_t *ztc, z_con
             return ret;
         }
         // Send batch
-        _Z_DEBUG("Send network batch");
-        ret = _z_transport_tx_flush_buffer(ztc, peers);
+        if (ztc->_batch_count > 0) {
+            _Z_DEBUG("Send network batch");
+            ret = _z_transport_tx_flush_buffer(ztc, peers);
+        }
+        z_result_t flush_ret = _z_transport_tx_flush_link(ztc, peers);
+        _Z_SET_IF_OK(ret, flush_ret);
         if (!_z_transport_batch_hold_tx_mutex()) {
             _z_transport_tx_mutex_unlock(ztc);
         }
@@ -336,6 +530,128 @@ static z_result_t _z_transport_tx_send_n_batch(_z_transport_common_t *ztc, z_con
 #endif
 }
 
+// The payload is the last field of a push message: the message is encoded with an empty payload, whose zero length
+// is then replaced by the actual one, followed by the reserved payload bytes
+static uint8_t *_z_transport_tx_encode_loaned(_z_wbuf_t *wbf, const _z_network_message_t *n_msg, size_t payload_len) {
+    if (_z_network_message_encode(wbf, n_msg) != _Z_RES_OK) {
+        return NULL;
+    }
+    _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, wbf->_w_idx);
+    ios->_w_pos--;
+    if (_z_zsize_encode(wbf, payload_len) != _Z_RES_OK) {
+        return NULL;
+    }
+    return _z_wbuf_reserve(wbf, payload_len);
+}
+
+static z_result_t _z_transport_tx_loan_n_msg_inner(_z_transport_common_t *ztc, _z_transport_tx_loan_t *loan,
+                                                   const _z_network_message_t *n_msg, size_t payload_len) {
+    // Init buffer
+    _z_zint_t sn = 0;
+    bool batch_has_data = _z_transport_tx_batch_has_data(ztc);
+    if (!batch_has_data) {
+        _z_transport_tx_prepare_batch(ztc);
+        sn = _z_transport_tx_get_sn(ztc, loan->_reliability);
+        _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, loan->_reliability);
+        _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, &t_msg));
+    }
+    loan->_prev_wpos = _z_wbuf_get_wpos(&ztc->_wbuf);
+    loan->_buf = _z_transport_tx_encode_loaned(&ztc->_wbuf, n_msg, payload_len);
+    if (loan->_buf != NULL) {
+        return _Z_RES_OK;
+    }
+    _z_wbuf_set_wpos(&ztc->_wbuf, loan->_prev_wpos);
+    if (batch_has_data) {
+        // Buffer is too full for message, send the batch and retry on an empty one
+        _Z_RETURN_IF_ERR(_z_transport_tx_flush_buffer(ztc, loan->_peers));
+        _z_transport_tx_prepare_batch(ztc);
+        sn = _z_transport_tx_get_sn(ztc, loan->_reliability);
+        _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, loan->_reliability);
+        _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, &t_msg));
+        loan->_prev_wpos = _z_wbuf_get_wpos(&ztc->_wbuf);
+        loan->_buf = _z_transport_tx_encode_loaned(&ztc->_wbuf, n_msg, payload_len);
+        if (loan->_buf != NULL) {
+            return _Z_RES_OK;
+        }
+        _z_wbuf_set_wpos(&ztc->_wbuf, loan->_prev_wpos);
+    }
+#if Z_FEATURE_FRAGMENTATION == 1
+    // Message doesn't fit in buffer, reserve the payload in the buffer it will be fragmented from
+    loan->_frag_buff = _z_wbuf_make(_Z_FRAG_BUFF_BASE_SIZE, true);
+    if (_z_wbuf_capacity(&loan->_frag_buff) != _Z_FRAG_BUFF_BASE_SIZE) {
+        _z_wbuf_clear(&loan->_frag_buff);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    loan->_buf = _z_transport_tx_encode_loaned(&loan->_frag_buff, n_msg, payload_len);
+    if (loan->_buf == NULL) {
+        _z_wbuf_clear(&loan->_frag_buff);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    loan->_is_fragmented = true;
+    loan->_first_sn = sn;
+#endif
+    // Without fragmentation no buffer is lent, the caller falls back to a regular send
+    return _Z_RES_OK;
+}
+
+static void _z_transport_tx_loan_release(_z_transport_tx_loan_t *loan) {
+    if (!_z_transport_batch_hold_tx_mutex()) {
+        _z_transport_tx_mutex_unlock(loan->_ztc);
+    }
+    if (loan->_is_peer_locked) {
+        _z_transport_peer_mutex_unlock(loan->_ztc);
+        loan->_is_peer_locked = false;
+    }
+    loan->_buf = NULL;
+    loan->_ztc = NULL;
+}
+
+static void _z_transport_tx_loan_revert(_z_transport_tx_loan_t *loan) {
+    _z_transport_common_t *ztc = loan->_ztc;
+    // Give back the sequence numbers and drop the partially encoded message, a flushed batch leaves the buffer empty
+    if (loan->_reliability == Z_RELIABILITY_RELIABLE) {
+        ztc->_sn_tx_reliable = loan->_prev_sn;
+    } else {
+        ztc->_sn_tx_best_effort = loan->_prev_sn;
+    }
+    _z_wbuf_set_wpos(&ztc->_wbuf, loan->_prev_wpos);
+#if Z_FEATURE_FRAGMENTATION == 1
+    if (loan->_is_fragmented) {
+        _z_wbuf_clear(&loan->_frag_buff);
+        loan->_is_fragmented = false;
+    }
+#endif
+}
+
+static z_result_t _z_transport_tx_loan_n_msg(_z_transport_common_t *ztc, _z_transport_tx_loan_t *loan,
+                                             const _z_network_message_t *n_msg, size_t payload_len,
+                                             z_reliability_t reliability, z_congestion_control_t cong_ctrl,
+                                             _z_transport_peer_unicast_slist_t *peers) {
+    z_result_t ret = _Z_RES_OK;
+    _Z_DEBUG("Loan network message buffer");
+
+    // Acquire the lock and drop the message if needed
+    if (!_z_transport_batch_hold_tx_mutex()) {
+        ret = _z_transport_tx_mutex_lock(ztc, cong_ctrl == Z_CONGESTION_CONTROL_BLOCK);
+    }
+    if (ret != _Z_RES_OK) {
+        _Z_INFO("Dropping zenoh message because of congestion control");
+        return ret;
+    }
+    loan->_ztc = ztc;
+    loan->_peers = peers;
+    loan->_reliability = reliability;
+    loan->_is_express = _z_transport_tx_get_express_status(n_msg);
+    loan->_prev_sn = (reliability == Z_RELIABILITY_RELIABLE) ? ztc->_sn_tx_reliable : ztc->_sn_tx_best_effort;
+    ret = _z_transport_tx_loan_n_msg_inner(ztc, loan, n_msg, payload_len);
+    if ((ret != _Z_RES_OK) || (loan->_buf == NULL)) {
+        _z_transport_tx_loan_revert(loan);
+        _z_transport_tx_loan_release(loan);
+    }
+    // The tx mutex is kept until the loan is committed or aborted
+    return ret;
+}
+
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
@@ -540,6 +856,137 @@ z_result_t _z_send_n_msg(_z_session_t *zn, const _z_network_message_t *z_msg, z_
     return ret;
 }
 
+z_result_t _z_send_n_msgs(_z_session_t *zn, const _z_network_message_t *n_msgs, size_t len,
+                          z_reliability_t reliability, z_congestion_control_t cong_ctrl) {
+#if defined(Z_TEST_HOOKS)
+    if (_z_send_n_msg_override != NULL) {
+        bool handled = false;
+        z_result_t override_ret = _Z_RES_OK;
+        for (size_t i = 0; (override_ret == _Z_RES_OK) && (i < len); i++) {
+            override_ret = _z_send_n_msg_override(zn, &n_msgs[i], reliability, cong_ctrl, NULL, &handled);
+        }
+        if (handled) {
+            return override_ret;
+        }
+    }
+#endif
+    z_result_t ret = _Z_RES_OK;
+    // Call transport function
+    switch (zn->_tp._type) {
+        case _Z_TRANSPORT_UNICAST_TYPE: {
+            _z_transport_common_t *ztc = &zn->_tp._transport._unicast._common;
+            if (zn->_mode == Z_WHATAMI_CLIENT) {
+                ret = _z_transport_tx_send_n_msgs(ztc, n_msgs, len, reliability, cong_ctrl, NULL);
+            } else if (!_z_transport_peer_unicast_slist_is_empty(zn->_tp._transport._unicast._peers)) {
+                if (!_z_transport_batch_hold_peer_mutex()) {
+                    _z_transport_peer_mutex_lock(ztc);
+                }
+                ret = _z_transport_tx_send_n_msgs(ztc, n_msgs, len, reliability, cong_ctrl,
+                                                  zn->_tp._transport._unicast._peers);
+                if (!_z_transport_batch_hold_peer_mutex()) {
+                    _z_transport_peer_mutex_unlock(ztc);
+                }
+            }
+        } break;
+        case _Z_TRANSPORT_MULTICAST_TYPE:
+            ret = _z_transport_tx_send_n_msgs(&zn->_tp._transport._multicast._common, n_msgs, len, reliability,
+                                              cong_ctrl, NULL);
+            break;
+        case _Z_TRANSPORT_RAWETH_TYPE:
+            // Raweth frames are sent one message at a time
+            for (size_t i = 0; (ret == _Z_RES_OK) && (i < len); i++) {
+                ret = _z_raweth_send_n_msg(zn, &n_msgs[i], reliability, cong_ctrl);
+            }
+            break;
+        default:
+            _Z_ERROR_LOG(_Z_ERR_TRANSPORT_NOT_AVAILABLE);
+            ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+            break;
+    }
+    return ret;
+}
+
+z_result_t _z_send_n_msg_loan(_z_session_t *zn, _z_transport_tx_loan_t *loan, const _z_network_message_t *n_msg,
+                              size_t payload_len, z_reliability_t reliability, z_congestion_control_t cong_ctrl) {
+    *loan = (_z_transport_tx_loan_t){0};
+#if defined(Z_TEST_HOOKS)
+    if (_z_send_n_msg_override != NULL) {
+        // The override only sees complete messages, let the caller send one
+        return _Z_RES_OK;
+    }
+#endif
+    z_result_t ret = _Z_RES_OK;
+    switch (zn->_tp._type) {
+        case _Z_TRANSPORT_UNICAST_TYPE: {
+            _z_transport_common_t *ztc = &zn->_tp._transport._unicast._common;
+            if (zn->_mode == Z_WHATAMI_CLIENT) {
+                ret = _z_transport_tx_loan_n_msg(ztc, loan, n_msg, payload_len, reliability, cong_ctrl, NULL);
+            } else if (!_z_transport_peer_unicast_slist_is_empty(zn->_tp._transport._unicast._peers)) {
+                if (!_z_transport_batch_hold_peer_mutex()) {
+                    _z_transport_peer_mutex_lock(ztc);
+                    loan->_is_peer_locked = true;
+                }
+                ret = _z_transport_tx_loan_n_msg(ztc, loan, n_msg, payload_len, reliability, cong_ctrl,
+                                                 zn->_tp._transport._unicast._peers);
+                if (loan->_buf == NULL && loan->_is_peer_locked) {
+                    _z_transport_peer_mutex_unlock(ztc);
+                    loan->_is_peer_locked = false;
+                }
+            }
+        } break;
+        case _Z_TRANSPORT_MULTICAST_TYPE:
+            ret = _z_transport_tx_loan_n_msg(&zn->_tp._transport._multicast._common, loan, n_msg, payload_len,
+                                             reliability, cong_ctrl, NULL);
+            break;
+        case _Z_TRANSPORT_RAWETH_TYPE:
+            // Raweth frames are built one message at a time, no buffer is lent
+            break;
+        default:
+            _Z_ERROR_LOG(_Z_ERR_TRANSPORT_NOT_AVAILABLE);
+            ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+            break;
+    }
+    return ret;
+}
+
+z_result_t _z_send_n_msg_loan_commit(_z_transport_tx_loan_t *loan) {
+    _z_transport_common_t *ztc = loan->_ztc;
+    if (ztc == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    z_result_t ret = _Z_RES_OK;
+#if Z_FEATURE_FRAGMENTATION == 1
+    if (loan->_is_fragmented) {
+        // Send message as fragments
+        ret = _z_transport_tx_send_fragments(ztc, &loan->_frag_buff, loan->_reliability, loan->_first_sn,
+                                             loan->_peers);
+        ret = _z_transport_tx_end_send(ztc, loan->_peers, loan->_is_express, ret);
+        _z_wbuf_clear(&loan->_frag_buff);
+        loan->_is_fragmented = false;
+        _z_transport_tx_loan_release(loan);
+        return ret;
+    }
+#endif
+    if (loan->_is_express) {
+        // Send immediately
+        ret = _z_transport_tx_flush_buffer(ztc, loan->_peers);
+    } else {
+        // Flush buffer or increase batch
+        ret = _z_transport_tx_flush_or_incr_batch(ztc, loan->_peers);
+    }
+    ret = _z_transport_tx_end_send(ztc, loan->_peers, loan->_is_express, ret);
+    _z_transport_tx_loan_release(loan);
+    return ret;
+}
+
+void _z_send_n_msg_loan_abort(_z_transport_tx_loan_t *loan) {
+    if (loan->_ztc == NULL) {
+        return;
+    }
+    _z_transport_tx_loan_revert(loan);
+    _z_transport_tx_loan_release(loan);
+}
+
 z_result_t _z_send_n_batch(_z_session_t *zn, z_congestion_control_t cong_ctrl) {
     z_result_t ret = _Z_RES_OK;
     // Call transport function
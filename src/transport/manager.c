@@ -21,6 +21,9 @@
 #if Z_FEATURE_LINK_TLS == 1
 #include "zenoh-pico/link/transport/tls_stream.h"
 #endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+#include "zenoh-pico/link/transport/shm_ring.h"
+#endif
 #include "zenoh-pico/link/link.h"
 #include "zenoh-pico/runtime/runtime.h"
 #include "zenoh-pico/session/interest.h"
@@ -151,17 +154,24 @@ static z_result_t _z_new_transport_peer(_z_transport_t *zt, const _z_string_t *l
             }
             ret = _z_unicast_transport_create(zt, zl, &tp_param);
             _Z_SET_IF_OK(ret, _z_socket_set_blocking(_z_link_get_socket(zl), false));
+#if Z_FEATURE_IO_URING == 1
+            if ((ret == _Z_RES_OK) && _z_link_supports_uring(zl) &&
+                (_z_socket_uring_new(&zt->_transport._unicast._common._uring) != _Z_RES_OK)) {
+                _Z_INFO("io_uring not available, sending to peers one at a time");
+            }
+#endif
             if (ret == _Z_RES_OK) {
                 if (peer_op == _Z_PEER_OP_OPEN) {
                     ret = _z_transport_peer_unicast_add(&zt->_transport._unicast, &tp_param, *_z_link_get_socket(zl),
                                                         false, NULL);
                 } else {
-#if Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_TLS == 1
+#if Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_TLS == 1 || Z_FEATURE_LINK_UNIXSOCK_STREAM == 1 || \
+    Z_FEATURE_LINK_SHM_RING == 1
                     _z_fut_t f = _z_fut_null();
-                    f._fut_arg = &zt->_transport._unicast;
-                    f._fut_fn = _zp_unicast_accept_task_fn;
-                    if (_z_fut_handle_is_null(_z_runtime_spawn(runtime, &f))) {
+                    ret = _zp_unicast_accept_fut_new(&zt->_transport._unicast, &f);
+                    if ((ret == _Z_RES_OK) && _z_fut_handle_is_null(_z_runtime_spawn(runtime, &f))) {
                         _Z_ERROR("Failed to spawn unicast accept task after transport creation.");
+                        _z_fut_destroy(&f);
                         ret = _Z_ERR_FAILED_TO_SPAWN_TASK;
                     }
 #else
@@ -227,6 +237,9 @@ z_result_t _z_new_peer(_z_transport_t *zt, const _z_id_t *session_id, const _z_s
             if (ret != _Z_RES_OK) {
 #if Z_FEATURE_LINK_TLS == 1
                 _z_close_tls_socket(&socket);
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+                _z_close_shm_ring_socket(&socket);
 #endif
                 _z_socket_close(&socket);
                 return ret;
@@ -235,6 +248,9 @@ z_result_t _z_new_peer(_z_transport_t *zt, const _z_id_t *session_id, const _z_s
             if (ret != _Z_RES_OK) {
 #if Z_FEATURE_LINK_TLS == 1
                 _z_close_tls_socket(&socket);
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+                _z_close_shm_ring_socket(&socket);
 #endif
                 _z_socket_close(&socket);
                 return ret;
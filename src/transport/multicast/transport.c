@@ -50,6 +50,15 @@ z_result_t _z_multicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
 
     // Initialize persistent address buffer
     ztm->_zbuf_addr = _z_slice_alias_buf(ztm->_zbuf_addr_buf, sizeof(ztm->_zbuf_addr_buf));
+#if Z_FEATURE_IO_URING == 1
+    ztm->_common._uring = NULL;
+#endif
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    ztm->_common._compression = false;
+    ztm->_common._compression_buf = NULL;
+    ztm->_common._compression_ctx = NULL;
+    ztm->_common._zbuf_decompressed = _z_zbuf_null();
+#endif
 
 // Initialize batching data
 #if Z_FEATURE_BATCHING == 1
@@ -16,6 +16,9 @@
 #if Z_FEATURE_LINK_TLS == 1
 #include "zenoh-pico/link/transport/tls_stream.h"
 #endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+#include "zenoh-pico/link/transport/shm_ring.h"
+#endif
 #include "zenoh-pico/link/endpoint.h"
 #include "zenoh-pico/net/session.h"
 #include "zenoh-pico/protocol/core.h"
@@ -154,6 +157,9 @@ void _z_transport_peer_unicast_clear(_z_transport_peer_unicast_t *src) {
     if (src->_owns_socket) {
 #if Z_FEATURE_LINK_TLS == 1
         _z_close_tls_socket(&src->_socket);
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+        _z_close_shm_ring_socket(&src->_socket);
 #endif
         _z_socket_close(&src->_socket);
     }
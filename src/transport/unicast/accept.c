@@ -11,23 +11,33 @@
 // Contributors:
 //   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
 
+#include <errno.h>
+
 #include "zenoh-pico/link/transport/socket.h"
 #if Z_FEATURE_LINK_TLS == 1
 #include "zenoh-pico/link/transport/tls_stream.h"
 #endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+#include "zenoh-pico/link/transport/shm_ring.h"
+#endif
+#include "zenoh-pico/protocol/codec/transport.h"
 #include "zenoh-pico/runtime/runtime.h"
 #include "zenoh-pico/session/interest.h"
 #include "zenoh-pico/session/liveliness.h"
 #include "zenoh-pico/session/query.h"
 #include "zenoh-pico/system/common/platform.h"
+#include "zenoh-pico/transport/common/rx.h"
 #include "zenoh-pico/transport/common/tx.h"
 #include "zenoh-pico/transport/transport.h"
+#include "zenoh-pico/transport/unicast/accept.h"
 #include "zenoh-pico/transport/unicast/lease.h"
 #include "zenoh-pico/transport/unicast/transport.h"
+#include "zenoh-pico/utils/endianness.h"
 #include "zenoh-pico/utils/logging.h"
 
-#if Z_FEATURE_UNICAST_TRANSPORT == 1 && Z_FEATURE_UNICAST_PEER == 1 && \
-    (Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_TLS == 1)
+#if Z_FEATURE_UNICAST_TRANSPORT == 1 && Z_FEATURE_UNICAST_PEER == 1 &&                               \
+    (Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_TLS == 1 || Z_FEATURE_LINK_UNIXSOCK_STREAM == 1 || \
+     Z_FEATURE_LINK_SHM_RING == 1)
 #if Z_FEATURE_CONNECTIVITY == 1
 static void _zp_unicast_dispatch_connected_event(_z_transport_unicast_t *ztu, const _z_transport_peer_unicast_t *peer) {
     if (ztu == NULL || peer == NULL) {
@@ -62,87 +72,272 @@ static void _zp_unicast_dispatch_connected_event(_z_transport_unicast_t *ztu, co
 }
 #endif
 
-_z_fut_fn_result_t _zp_unicast_accept_task_fn(void *ctx, _z_executor_t *executor) {
-    _ZP_UNUSED(executor);
-    _z_transport_unicast_t *ztu = (_z_transport_unicast_t *)ctx;
-    const _z_sys_net_socket_t *socket_ptr = _z_link_get_socket(ztu->_common._link);
-    if (socket_ptr == NULL) {
-        _Z_ERROR_LOG(_Z_ERR_INVALID);
-        return _z_fut_fn_result_ready();
+typedef enum {
+    _ZP_UNICAST_ACCEPT_STATE_TLS_HANDSHAKE,
+    _ZP_UNICAST_ACCEPT_STATE_WAIT_INIT,
+    _ZP_UNICAST_ACCEPT_STATE_WAIT_OPEN,
+} _zp_unicast_accept_state_t;
+
+// A connection going through the TLS and transport handshakes
+typedef struct {
+    _z_sys_net_socket_t _socket;
+    _z_transport_unicast_establish_param_t _param;
+    _z_zbuf_t _zbuf;
+    z_clock_t _deadline;
+    _zp_unicast_accept_state_t _state;
+    bool _ready;
+} _zp_unicast_pending_accept_t;
+
+typedef struct {
+    _z_transport_unicast_t *_ztu;
+    _z_sys_net_socket_t _listen_socket;
+    size_t _pending_len;
+    _zp_unicast_pending_accept_t _pending[Z_LISTEN_MAX_CONNECTION_NB];
+} _zp_unicast_accept_task_t;
+
+static void _zp_unicast_accept_close_socket(_z_sys_net_socket_t *socket) {
+#if Z_FEATURE_LINK_TLS == 1
+    _z_close_tls_socket(socket);
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1
+    _z_close_shm_ring_socket(socket);
+#endif
+    _z_socket_close(socket);
+}
+
+static void _zp_unicast_accept_task_drop(void *arg) {
+    _zp_unicast_accept_task_t *task = (_zp_unicast_accept_task_t *)arg;
+    for (size_t i = 0; i < task->_pending_len; i++) {
+        _zp_unicast_accept_close_socket(&task->_pending[i]._socket);
+        _z_zbuf_clear(&task->_pending[i]._zbuf);
     }
+    z_free(task);
+}
 
-    _z_sys_net_socket_t listen_socket = *socket_ptr;
-    _z_sys_net_socket_t con_socket = {0};
-    z_result_t ret = _z_tcp_accept(&listen_socket, &con_socket);
-    if (ret != _Z_RES_OK) {
-        if (ret == _Z_ERR_INVALID) {
-            _Z_INFO("Accept socket was closed");
-            return _z_fut_fn_result_ready();
+z_result_t _zp_unicast_accept_fut_new(_z_transport_unicast_t *ztu, _z_fut_t *fut) {
+    _zp_unicast_accept_task_t *task = (_zp_unicast_accept_task_t *)z_malloc(sizeof(_zp_unicast_accept_task_t));
+    if (task == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    task->_ztu = ztu;
+    task->_listen_socket = (_z_sys_net_socket_t){0};
+    task->_pending_len = 0;
+    *fut = _z_fut_new(task, _zp_unicast_accept_task_fn, _zp_unicast_accept_task_drop);
+    return _Z_RES_OK;
+}
+
+static void _zp_unicast_accept_remove(_zp_unicast_accept_task_t *task, size_t idx, bool close_socket) {
+    _zp_unicast_pending_accept_t *pending = &task->_pending[idx];
+    if (close_socket) {
+        _zp_unicast_accept_close_socket(&pending->_socket);
+    }
+    _z_zbuf_clear(&pending->_zbuf);
+    task->_pending_len--;
+    if (idx != task->_pending_len) {
+        *pending = task->_pending[task->_pending_len];
+    }
+}
+
+static void _zp_unicast_accept_wait_iter_reset(_z_socket_wait_iter_t *iter) { iter->_current_entry = NULL; }
+
+// Visits the listening socket first, then the pending connections
+static bool _zp_unicast_accept_wait_iter_next(_z_socket_wait_iter_t *iter) {
+    _zp_unicast_accept_task_t *task = (_zp_unicast_accept_task_t *)iter->_ctx;
+    _zp_unicast_pending_accept_t *next = NULL;
+    if (iter->_current_entry == NULL) {
+        iter->_current_entry = task;
+        return true;
+    } else if (iter->_current_entry == task) {
+        next = &task->_pending[0];
+    } else {
+        next = (_zp_unicast_pending_accept_t *)iter->_current_entry + 1;
+    }
+    if (next == &task->_pending[task->_pending_len]) {
+        return false;
+    }
+    iter->_current_entry = next;
+    return true;
+}
+
+static const _z_sys_net_socket_t *_zp_unicast_accept_wait_iter_get_socket(const _z_socket_wait_iter_t *iter) {
+    if (iter->_current_entry == iter->_ctx) {
+        return &((_zp_unicast_accept_task_t *)iter->_ctx)->_listen_socket;
+    }
+    return &((_zp_unicast_pending_accept_t *)iter->_current_entry)->_socket;
+}
+
+static void _zp_unicast_accept_wait_iter_set_ready(_z_socket_wait_iter_t *iter, bool ready) {
+    // New connections are accepted on every run, the listening socket only has to end the wait
+    if (iter->_current_entry != iter->_ctx) {
+        ((_zp_unicast_pending_accept_t *)iter->_current_entry)->_ready = ready;
+    }
+}
+
+// Waits until a connection arrives, a pending connection has data to read or the first handshake deadline passes
+static z_result_t _zp_unicast_accept_wait(_zp_unicast_accept_task_t *task) {
+    uint32_t timeout_ms = Z_CONFIG_SOCKET_TIMEOUT;
+    z_clock_t now = z_clock_now();
+    for (size_t i = 0; i < task->_pending_len; i++) {
+        unsigned long remaining = zp_clock_elapsed_ms_since(&task->_pending[i]._deadline, &now);
+        if (remaining < timeout_ms) {
+            timeout_ms = (uint32_t)remaining;
         }
-        return _z_fut_fn_result_wake_up_after(1000);
     }
+    _z_socket_wait_iter_t iter = {
+        ._ctx = task,
+        ._current_entry = NULL,
+        ._reset = _zp_unicast_accept_wait_iter_reset,
+        ._next = _zp_unicast_accept_wait_iter_next,
+        ._get_socket = _zp_unicast_accept_wait_iter_get_socket,
+        ._set_ready = _zp_unicast_accept_wait_iter_set_ready,
+    };
+    return _z_socket_wait_readable(&iter, timeout_ms);
+}
 
-    if (_z_transport_peer_unicast_slist_len(ztu->_peers) >= Z_LISTEN_MAX_CONNECTION_NB) {
-        _Z_INFO("Refusing connection as max connections currently reached");
+static inline bool _zp_unicast_accept_is_tls(const _zp_unicast_accept_task_t *task) {
 #if Z_FEATURE_LINK_TLS == 1
-        _z_close_tls_socket(&con_socket);
+    return task->_ztu->_common._link->_type == _Z_LINK_TYPE_TLS;
+#else
+    _ZP_UNUSED(task);
+    return false;
 #endif
-        _z_socket_close(&con_socket);
-        return _z_fut_fn_result_wake_up_after(1000);
-    }
+}
 
-    ret = _z_socket_set_blocking(&con_socket, true);
-    if (ret != _Z_RES_OK) {
-        _Z_INFO("Failed to set socket blocking with error %d", ret);
-#if Z_FEATURE_LINK_TLS == 1
-        _z_close_tls_socket(&con_socket);
+static z_result_t _zp_unicast_accept_socket(const _zp_unicast_accept_task_t *task,
+                                            const _z_sys_net_socket_t *listen_socket, _z_sys_net_socket_t *con_socket) {
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1
+    if (task->_ztu->_common._link->_type == _Z_LINK_TYPE_UNIXSOCK_STREAM) {
+        return _z_unixsock_stream_accept(listen_socket, con_socket);
+    }
 #endif
-        _z_socket_close(&con_socket);
-        return _z_fut_fn_result_continue();
+#if Z_FEATURE_LINK_SHM_RING == 1
+    if (task->_ztu->_common._link->_type == _Z_LINK_TYPE_SHM_RING) {
+        return _z_shm_ring_accept(listen_socket, con_socket);
     }
+#endif
+#if Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_TLS == 1
+    _ZP_UNUSED(task);
+    return _z_tcp_accept(listen_socket, con_socket);
+#else
+    _ZP_UNUSED(task);
+    _ZP_UNUSED(listen_socket);
+    _ZP_UNUSED(con_socket);
+    _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NOT_AVAILABLE);
+#endif
+}
 
-#if Z_FEATURE_LINK_TLS == 1
-    if (ztu->_common._link->_type == _Z_LINK_TYPE_TLS) {
-        ret = _z_tls_accept(&con_socket, &listen_socket);
+/**
+ * Accepts the connections waiting on the listening socket without blocking. Returns _Z_ERR_INVALID once the listening
+ * socket was closed.
+ */
+static z_result_t _zp_unicast_accept_new_connections(_zp_unicast_accept_task_t *task,
+                                                     const _z_sys_net_socket_t *listen_socket, bool *progress) {
+    _z_transport_unicast_t *ztu = task->_ztu;
+    for (size_t n = 0; n < Z_LISTEN_MAX_CONNECTION_NB; n++) {
+        _z_sys_net_socket_t con_socket = {0};
+        z_result_t ret = _zp_unicast_accept_socket(task, listen_socket, &con_socket);
         if (ret != _Z_RES_OK) {
-            _Z_INFO("TLS handshake failed with error %d", ret);
-            _z_close_tls_socket(&con_socket);
-            _z_socket_close(&con_socket);
-            return _z_fut_fn_result_continue();
+            return (ret == _Z_ERR_INVALID) ? ret : _Z_RES_OK;
         }
-    }
-#endif
+        *progress = true;
 
-    _z_transport_unicast_establish_param_t param = {0};
-    ret = _z_unicast_handshake_listen(&param, ztu->_common._link,
-                                      &_z_transport_common_get_session(&ztu->_common)->_local_zid, Z_WHATAMI_PEER,
-                                      &con_socket);
-    if (ret != _Z_RES_OK) {
-        _Z_INFO("Connection accept handshake failed with error %d", ret);
+        if (_z_transport_peer_unicast_slist_len(ztu->_peers) + task->_pending_len >= Z_LISTEN_MAX_CONNECTION_NB) {
+            _Z_INFO("Refusing connection as max connections currently reached");
+            _zp_unicast_accept_close_socket(&con_socket);
+            continue;
+        }
+        ret = _z_socket_set_blocking(&con_socket, false);
+        if (ret != _Z_RES_OK) {
+            _Z_INFO("Failed to set socket non blocking with error %d", ret);
+            _zp_unicast_accept_close_socket(&con_socket);
+            continue;
+        }
+
+        _zp_unicast_pending_accept_t *pending = &task->_pending[task->_pending_len];
+        pending->_state = _ZP_UNICAST_ACCEPT_STATE_WAIT_INIT;
 #if Z_FEATURE_LINK_TLS == 1
-        _z_close_tls_socket(&con_socket);
+        if (_zp_unicast_accept_is_tls(task)) {
+            ret = _z_tls_accept_setup(&con_socket, listen_socket);
+            if (ret != _Z_RES_OK) {
+                _Z_INFO("TLS accept setup failed with error %d", ret);
+                _zp_unicast_accept_close_socket(&con_socket);
+                continue;
+            }
+            pending->_state = _ZP_UNICAST_ACCEPT_STATE_TLS_HANDSHAKE;
+        }
 #endif
-        _z_socket_close(&con_socket);
-        return _z_fut_fn_result_continue();
+        pending->_zbuf = _z_zbuf_make(Z_BATCH_UNICAST_SIZE);
+        if (_z_zbuf_capacity(&pending->_zbuf) != Z_BATCH_UNICAST_SIZE) {
+            _Z_ERROR("Not enough memory to allocate handshake buffer");
+            _zp_unicast_accept_close_socket(&con_socket);
+            continue;
+        }
+        pending->_socket = con_socket;
+        pending->_param = (_z_transport_unicast_establish_param_t){0};
+        pending->_deadline = z_clock_now();
+        z_clock_advance_ms(&pending->_deadline, Z_TRANSPORT_ACCEPT_TIMEOUT);
+        pending->_ready = false;
+        task->_pending_len++;
     }
+    return _Z_RES_OK;
+}
 
-    if (_z_socket_set_blocking(&con_socket, false) != _Z_RES_OK) {
-        _Z_INFO("Failed to set socket non blocking");
-#if Z_FEATURE_LINK_TLS == 1
-        _z_close_tls_socket(&con_socket);
-#endif
-        _z_socket_close(&con_socket);
-        return _z_fut_fn_result_continue();
+/**
+ * Reads what is available of the next length-prefixed transport message, never past its end as the following bytes
+ * belong to the established transport. Returns _Z_NO_DATA_PROCESSED until the message is complete.
+ */
+static z_result_t _zp_unicast_accept_recv_t_msg(_zp_unicast_accept_task_t *task, _zp_unicast_pending_accept_t *pending,
+                                                _z_transport_message_t *t_msg) {
+    const _z_link_t *zl = task->_ztu->_common._link;
+    size_t len = _z_zbuf_len(&pending->_zbuf);
+    size_t expected = _Z_MSG_LEN_ENC_SIZE;
+    if (len >= _Z_MSG_LEN_ENC_SIZE) {
+        expected += _z_host_le_load16(_z_zbuf_get_rptr(&pending->_zbuf));
+        if (expected > _z_zbuf_capacity(&pending->_zbuf)) {
+            _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NO_SPACE);
+        }
+    }
+    if (len < expected) {
+        errno = 0;
+        size_t rb = zl->_read_socket_f(pending->_socket, _z_zbuf_get_wptr(&pending->_zbuf), expected - len);
+        if (_zp_unicast_accept_is_tls(task)) {
+            // Nothing was decrypted yet
+            if (rb == 0) {
+                return _Z_NO_DATA_PROCESSED;
+            }
+        } else if (rb == 0) {
+            _Z_INFO("Socket closed during accept handshake");
+            _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_RX_FAILED);
+        }
+        if (rb == SIZE_MAX) {
+            // The socket was reported readable but the data isn't there yet, what was read so far is kept
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                return _Z_NO_DATA_PROCESSED;
+            }
+            _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_RX_FAILED);
+        }
+        _z_zbuf_set_wpos(&pending->_zbuf, _z_zbuf_get_wpos(&pending->_zbuf) + rb);
+        // Once the prefix is complete the body length is known, once the body is complete it can be decoded
+        return (len + rb == expected) ? _zp_unicast_accept_recv_t_msg(task, pending, t_msg) : _Z_NO_DATA_PROCESSED;
     }
 
+    _z_read_stream_size(&pending->_zbuf);
+    _z_transport_message_t l_t_msg;
+    z_result_t ret = _z_transport_message_decode(&l_t_msg, &pending->_zbuf);
+    if (ret == _Z_RES_OK) {
+        _z_t_msg_copy(t_msg, &l_t_msg);
+    }
+    _z_zbuf_reset(&pending->_zbuf);
+    return ret;
+}
+
+static void _zp_unicast_accept_complete(_zp_unicast_accept_task_t *task, _zp_unicast_pending_accept_t *pending) {
+    _z_transport_unicast_t *ztu = task->_ztu;
     _z_transport_peer_unicast_t *new_peer = NULL;
-    ret = _z_transport_peer_unicast_add(ztu, &param, con_socket, true, &new_peer);
+    z_result_t ret = _z_transport_peer_unicast_add(ztu, &pending->_param, pending->_socket, true, &new_peer);
     if (ret != _Z_RES_OK) {
-#if Z_FEATURE_LINK_TLS == 1
-        _z_close_tls_socket(&con_socket);
-#endif
-        _z_socket_close(&con_socket);
-        return _z_fut_fn_result_continue();
+        _zp_unicast_accept_close_socket(&pending->_socket);
+        return;
     }
 
     if (new_peer != NULL) {
@@ -151,7 +346,119 @@ _z_fut_fn_result_t _zp_unicast_accept_task_fn(void *ctx, _z_executor_t *executor
         _zp_unicast_dispatch_connected_event(ztu, new_peer);
 #endif
     }
+}
+
+/**
+ * Moves the handshake of a pending connection forward with the data available. Returns _Z_NO_DATA_PROCESSED while it
+ * has to wait for the peer, _Z_RES_OK once the connection was handed to the transport.
+ */
+static z_result_t _zp_unicast_accept_step(_zp_unicast_accept_task_t *task, _zp_unicast_pending_accept_t *pending) {
+    _z_transport_unicast_t *ztu = task->_ztu;
+    z_result_t ret = _Z_RES_OK;
+#if Z_FEATURE_LINK_TLS == 1
+    if (pending->_state == _ZP_UNICAST_ACCEPT_STATE_TLS_HANDSHAKE) {
+        ret = _z_tls_accept_handshake(&pending->_socket);
+        if (ret != _Z_RES_OK) {
+            if (ret != _Z_NO_DATA_PROCESSED) {
+                _Z_INFO("TLS handshake failed with error %d", ret);
+            }
+            return ret;
+        }
+        // The transport handshake gets the same time as a connection without TLS
+        pending->_state = _ZP_UNICAST_ACCEPT_STATE_WAIT_INIT;
+        pending->_deadline = z_clock_now();
+        z_clock_advance_ms(&pending->_deadline, Z_TRANSPORT_ACCEPT_TIMEOUT);
+    }
+#endif
 
+    _z_transport_message_t t_msg = {0};
+    _Z_RETURN_IF_ERR(_zp_unicast_accept_recv_t_msg(task, pending, &t_msg));
+    if (pending->_state == _ZP_UNICAST_ACCEPT_STATE_WAIT_INIT) {
+        ret = _z_unicast_handshake_listen_init(&pending->_param, ztu->_common._link,
+                                               &_z_transport_common_get_session(&ztu->_common)->_local_zid,
+                                               Z_WHATAMI_PEER, &pending->_socket, &t_msg);
+        _z_t_msg_clear(&t_msg);
+        if (ret != _Z_RES_OK) {
+            _Z_INFO("Connection accept handshake failed with error %d", ret);
+            return ret;
+        }
+        pending->_state = _ZP_UNICAST_ACCEPT_STATE_WAIT_OPEN;
+        return _Z_NO_DATA_PROCESSED;
+    }
+
+    ret = _z_unicast_handshake_listen_open(&pending->_param, ztu->_common._link, &pending->_socket, &t_msg);
+    _z_t_msg_clear(&t_msg);
+    if (ret != _Z_RES_OK) {
+        _Z_INFO("Connection accept handshake failed with error %d", ret);
+        return ret;
+    }
+    _zp_unicast_accept_complete(task, pending);
+    return _Z_RES_OK;
+}
+
+static bool _zp_unicast_accept_process_pending(_zp_unicast_accept_task_t *task) {
+    bool progress = false;
+    z_clock_t now = z_clock_now();
+    size_t i = 0;
+    while (i < task->_pending_len) {
+        _zp_unicast_pending_accept_t *pending = &task->_pending[i];
+        if (!pending->_ready) {
+            if (zp_clock_elapsed_ms_since(&pending->_deadline, &now) == 0) {
+                _Z_INFO("Connection accept handshake timed out");
+                _zp_unicast_accept_remove(task, i, true);
+                progress = true;
+                continue;
+            }
+            i++;
+            continue;
+        }
+        size_t prev_wpos = _z_zbuf_get_wpos(&pending->_zbuf);
+        _zp_unicast_accept_state_t prev_state = pending->_state;
+        z_result_t ret = _zp_unicast_accept_step(task, pending);
+        if (ret == _Z_RES_OK) {
+            // The socket now belongs to the transport
+            _zp_unicast_accept_remove(task, i, false);
+            progress = true;
+        } else if (ret != _Z_NO_DATA_PROCESSED) {
+            _zp_unicast_accept_remove(task, i, true);
+            progress = true;
+        } else if (zp_clock_elapsed_ms_since(&pending->_deadline, &now) == 0) {
+            _Z_INFO("Connection accept handshake timed out");
+            _zp_unicast_accept_remove(task, i, true);
+            progress = true;
+        } else {
+            // A step stops once it has read all the socket had or moved to the next state, in which case TLS may
+            // still hold decrypted data, so the connection is stepped again before waiting
+            pending->_ready = (prev_state != pending->_state) || (prev_wpos != _z_zbuf_get_wpos(&pending->_zbuf));
+            progress |= pending->_ready;
+            i++;
+        }
+    }
+    return progress;
+}
+
+_z_fut_fn_result_t _zp_unicast_accept_task_fn(void *ctx, _z_executor_t *executor) {
+    _ZP_UNUSED(executor);
+    _zp_unicast_accept_task_t *task = (_zp_unicast_accept_task_t *)ctx;
+    const _z_sys_net_socket_t *socket_ptr = _z_link_get_socket(task->_ztu->_common._link);
+    if (socket_ptr == NULL) {
+        _Z_ERROR_LOG(_Z_ERR_INVALID);
+        return _z_fut_fn_result_ready();
+    }
+
+    // Connections are accepted right away, their handshakes then progress independently of each other
+    bool progress = false;
+    task->_listen_socket = *socket_ptr;
+    if (_zp_unicast_accept_new_connections(task, &task->_listen_socket, &progress) == _Z_ERR_INVALID) {
+        _Z_INFO("Accept socket was closed");
+        return _z_fut_fn_result_ready();
+    }
+    progress |= _zp_unicast_accept_process_pending(task);
+    if (!progress && (_zp_unicast_accept_wait(task) == _Z_ERR_GENERIC)) {
+        // The listening socket may have been closed meanwhile, which the next accept reports
+        _Z_INFO("Failed to wait for connections");
+        return _z_fut_fn_result_wake_up_after(Z_CONFIG_SOCKET_TIMEOUT);
+    }
     return _z_fut_fn_result_continue();
 }
 #endif
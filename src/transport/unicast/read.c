@@ -46,6 +46,13 @@ static z_result_t _z_unicast_process_messages(_z_transport_unicast_t *ztu, _z_tr
     } else {
         zbuf = _z_zbuf_view(&ztu->_common._zbuf, to_read);
     }
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    z_result_t res = _z_unicast_decompress_batch(ztu, &zbuf);
+    if (res != _Z_RES_OK) {
+        _Z_INFO("Connection compromised due to malformed batch: %d", res);
+        return res;
+    }
+#endif
 
     peer->common._received = true;
     while (_z_zbuf_len(&zbuf) > 0) {
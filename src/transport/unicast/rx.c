@@ -17,6 +17,7 @@
 #include <stddef.h>
 
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/protocol/codec/core.h"
 #include "zenoh-pico/protocol/codec/network.h"
 #include "zenoh-pico/protocol/codec/transport.h"
 #include "zenoh-pico/protocol/core.h"
@@ -81,14 +82,25 @@ z_result_t _z_unicast_recv_t_msg(_z_transport_unicast_t *ztu, _z_transport_messa
 
         // Wrap the main buffer to_read bytes
         _z_zbuf_t zbuf = _z_zbuf_view(&ztu->_common._zbuf, to_read);
+        size_t consumed = 0;
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+        ret = _z_unicast_decompress_batch(ztu, &zbuf);
+        if (ret == _Z_RES_OK) {
+            ret = _z_transport_message_decode(t_msg, &zbuf);
+        }
+        // The batch header is followed by a whole batch, which may be compressed
+        consumed = ztu->_common._compression ? to_read : _z_zbuf_get_rpos(&zbuf);
+#else
         ret = _z_transport_message_decode(t_msg, &zbuf);
+        consumed = _z_zbuf_get_rpos(&zbuf);
+#endif
 
         if (ret == _Z_RES_OK) {
             // Mark the session that we have received data
             peer->common._received = true;
 
             // Update the actual buffer pointers
-            _z_zbuf_set_rpos(&ztu->_common._zbuf, _z_zbuf_get_rpos(&ztu->_common._zbuf) + _z_zbuf_get_rpos(&zbuf));
+            _z_zbuf_set_rpos(&ztu->_common._zbuf, _z_zbuf_get_rpos(&ztu->_common._zbuf) + consumed);
         } else {
             _Z_ERROR("Malformed transport message: %d", ret);
             _z_zbuf_set_rpos(&ztu->_common._zbuf, _z_zbuf_get_rpos(&ztu->_common._zbuf) + to_read);
@@ -324,6 +336,39 @@ z_result_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_t
     return ret;
 }
 
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+z_result_t _z_unicast_decompress_batch(_z_transport_unicast_t *ztu, _z_zbuf_t *zbf) {
+    if (!ztu->_common._compression) {
+        return _Z_RES_OK;
+    }
+    uint8_t header = 0;
+    _Z_RETURN_IF_ERR(_z_uint8_decode(&header, zbf));
+    if (!_Z_HAS_FLAG(header, _Z_BATCH_HEADER_COMPRESSION)) {
+        return _Z_RES_OK;
+    }
+    _z_zbuf_t *dbuf = &ztu->_common._zbuf_decompressed;
+    // Decoded payloads may still point into the previous batch, it is then left to them
+    if ((_z_zbuf_capacity(dbuf) == 0) || (_z_zbuf_get_ref_count(dbuf) != 1)) {
+        _z_zbuf_clear(dbuf);
+        size_t buff_capacity = _z_zbuf_capacity(&ztu->_common._zbuf);
+        *dbuf = _z_zbuf_make(buff_capacity);
+        if (_z_zbuf_capacity(dbuf) != buff_capacity) {
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+    }
+    _z_zbuf_reset(dbuf);
+    size_t len = _z_lz4_decompress(_z_zbuf_get_rptr(zbf), _z_zbuf_len(zbf), _z_zbuf_get_wptr(dbuf),
+                                   _z_zbuf_capacity(dbuf));
+    if (len == SIZE_MAX) {
+        _Z_INFO("Malformed compressed batch");
+        _Z_ERROR_RETURN(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
+    }
+    _z_zbuf_set_wpos(dbuf, len);
+    *zbf = _z_zbuf_view(dbuf, len);
+    return _Z_RES_OK;
+}
+#endif
+
 z_result_t _z_unicast_update_rx_buffer(_z_transport_unicast_t *ztu) {
     // Check if user or defragment buffer took ownership of buffer
     if (_z_zbuf_get_ref_count(&ztu->_common._zbuf) != 1) {
@@ -56,6 +56,17 @@ static z_result_t _z_unicast_transport_create_inner(_z_transport_unicast_t *ztu,
         _Z_ERROR("Not enough memory to allocate transport buffers!");
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    ztu->_common._compression = param->_compression;
+    if (param->_compression) {
+        ztu->_common._compression_buf = (uint8_t *)z_malloc(wbuf_size);
+        ztu->_common._compression_ctx = (_z_lz4_ctx_t *)z_malloc(sizeof(_z_lz4_ctx_t));
+        if ((ztu->_common._compression_buf == NULL) || (ztu->_common._compression_ctx == NULL)) {
+            _Z_ERROR("Not enough memory to allocate compression buffers!");
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+    }
+#endif
     // Set default SN resolution
     ztu->_common._sn_res = _z_sn_max(param->_seq_num_res);
     // The initial SN at TX side
@@ -88,6 +99,10 @@ z_result_t _z_unicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
 #endif
         _z_wbuf_clear(&ztu->_common._wbuf);
         _z_zbuf_clear(&ztu->_common._zbuf);
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+        z_free(ztu->_common._compression_buf);
+        z_free(ztu->_common._compression_ctx);
+#endif
     }
     return ret;
 }
@@ -98,6 +113,14 @@ static z_result_t _z_unicast_handshake_open(_z_transport_unicast_establish_param
     z_clock_advance_ms(&recv_deadline, Z_TRANSPORT_CONNECT_TIMEOUT);
 
     _z_transport_message_t ism = _z_t_msg_make_init_syn(mode, *local_zid);
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    // A peer writes each batch once for all its peers, so only a client, with a single peer, compresses them
+    if (mode == Z_WHATAMI_CLIENT) {
+        ism._body._init._compression = true;
+        _Z_SET_FLAG(ism._header, _Z_FLAG_T_Z);
+    }
+    param->_compression = ism._body._init._compression;
+#endif
     param->_seq_num_res = ism._body._init._seq_num_res;  // The announced sn resolution
     param->_req_id_res = ism._body._init._req_id_res;    // The announced req id resolution
     param->_batch_size = ism._body._init._batch_size;    // The announced batch size
@@ -147,6 +170,9 @@ static z_result_t _z_unicast_handshake_open(_z_transport_unicast_establish_param
         _Z_ERROR_LOG(_Z_ERR_GENERIC);
         ret = _Z_ERR_GENERIC;
     }
+#endif
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    param->_compression = param->_compression && iam._body._init._compression;
 #endif
     if (ret != _Z_RES_OK) {
         _z_t_msg_clear(&iam);
@@ -199,20 +225,12 @@ static z_result_t _z_unicast_handshake_open(_z_transport_unicast_establish_param
     return _Z_RES_OK;
 }
 
-z_result_t _z_unicast_handshake_listen(_z_transport_unicast_establish_param_t *param, const _z_link_t *zl,
-                                       const _z_id_t *local_zid, z_whatami_t mode, _z_sys_net_socket_t *socket) {
-    z_clock_t recv_deadline = z_clock_now();
-    z_clock_advance_ms(&recv_deadline, Z_TRANSPORT_ACCEPT_TIMEOUT);
+z_result_t _z_unicast_handshake_listen_init(_z_transport_unicast_establish_param_t *param, const _z_link_t *zl,
+                                            const _z_id_t *local_zid, z_whatami_t mode, _z_sys_net_socket_t *socket,
+                                            const _z_transport_message_t *tmsg) {
     assert(mode == Z_WHATAMI_PEER);
-    // Read t message from link
-    _z_transport_message_t tmsg = {0};
-    z_result_t ret = _z_link_recv_t_msg(&tmsg, zl, socket, recv_deadline);
-    if (ret != _Z_RES_OK) {
-        return ret;
-    }
     // Receive InitSyn
-    if (_Z_MID(tmsg._header) != _Z_MID_T_INIT || _Z_HAS_FLAG(tmsg._header, _Z_FLAG_T_INIT_A)) {
-        _z_t_msg_clear(&tmsg);
+    if (_Z_MID(tmsg->_header) != _Z_MID_T_INIT || _Z_HAS_FLAG(tmsg->_header, _Z_FLAG_T_INIT_A)) {
         _Z_ERROR_RETURN(_Z_ERR_MESSAGE_UNEXPECTED);
     }
     _Z_DEBUG("Received Z_INIT(Syn)");
@@ -221,55 +239,54 @@ z_result_t _z_unicast_handshake_listen(_z_transport_unicast_establish_param_t *p
     _z_transport_message_t iam = _z_t_msg_make_init_ack(mode, *local_zid, cookie);
 
     // If the new node has less representing capabilities adjust settings
-    if (tmsg._body._init._seq_num_res < iam._body._init._seq_num_res) {
-        _Z_DEBUG("Adjusting SN resolution from %u to %u", iam._body._init._seq_num_res, tmsg._body._init._seq_num_res);
-        iam._body._init._seq_num_res = tmsg._body._init._seq_num_res;
+    if (tmsg->_body._init._seq_num_res < iam._body._init._seq_num_res) {
+        _Z_DEBUG("Adjusting SN resolution from %u to %u", iam._body._init._seq_num_res,
+                 tmsg->_body._init._seq_num_res);
+        iam._body._init._seq_num_res = tmsg->_body._init._seq_num_res;
     }
-    if (tmsg._body._init._req_id_res < iam._body._init._req_id_res) {
+    if (tmsg->_body._init._req_id_res < iam._body._init._req_id_res) {
         _Z_DEBUG("Adjusting Req ID resolution from %u to %u", iam._body._init._req_id_res,
-                 tmsg._body._init._req_id_res);
-        iam._body._init._req_id_res = tmsg._body._init._req_id_res;
+                 tmsg->_body._init._req_id_res);
+        iam._body._init._req_id_res = tmsg->_body._init._req_id_res;
     }
-    if (tmsg._body._init._batch_size < iam._body._init._batch_size) {
-        _Z_DEBUG("Adjusting Batch Size from %u to %u", iam._body._init._batch_size, tmsg._body._init._batch_size);
-        iam._body._init._batch_size = tmsg._body._init._batch_size;
+    if (tmsg->_body._init._batch_size < iam._body._init._batch_size) {
+        _Z_DEBUG("Adjusting Batch Size from %u to %u", iam._body._init._batch_size, tmsg->_body._init._batch_size);
+        iam._body._init._batch_size = tmsg->_body._init._batch_size;
     }
 
 #if Z_FEATURE_FRAGMENTATION == 1
-    if (iam._body._init._patch > tmsg._body._init._patch) {
-        iam._body._init._patch = tmsg._body._init._patch;
+    if (iam._body._init._patch > tmsg->_body._init._patch) {
+        iam._body._init._patch = tmsg->_body._init._patch;
     }
+#endif
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    // Batches are shared by all the peers, compression is never accepted
+    param->_compression = false;
 #endif
     param->_seq_num_res = iam._body._init._seq_num_res;
     param->_req_id_res = iam._body._init._req_id_res;
     param->_batch_size = iam._body._init._batch_size;
-    param->_remote_zid = tmsg._body._init._zid;
-    param->_remote_whatami = tmsg._body._init._whatami;
+    param->_remote_zid = tmsg->_body._init._zid;
+    param->_remote_whatami = tmsg->_body._init._whatami;
     param->_key_id_res = 0x08 << param->_key_id_res;
     param->_req_id_res = 0x08 << param->_req_id_res;
-    _z_t_msg_clear(&tmsg);
     // Send InitAck
     _Z_DEBUG("Sending Z_INIT(Ack)");
-    ret = _z_link_send_t_msg(zl, &iam, socket);
+    z_result_t ret = _z_link_send_t_msg(zl, &iam, socket);
     _z_t_msg_clear(&iam);
-    if (ret != _Z_RES_OK) {
-        return ret;
-    }
-    // Read t message from link
-    ret = _z_link_recv_t_msg(&tmsg, zl, socket, recv_deadline);
-    if (ret != _Z_RES_OK) {
-        return ret;
-    }
+    return ret;
+}
+
+z_result_t _z_unicast_handshake_listen_open(_z_transport_unicast_establish_param_t *param, const _z_link_t *zl,
+                                            _z_sys_net_socket_t *socket, const _z_transport_message_t *tmsg) {
     // Receive OpenSyn
-    if (_Z_MID(tmsg._header) != _Z_MID_T_OPEN || _Z_HAS_FLAG(tmsg._header, _Z_FLAG_T_INIT_A)) {
-        _z_t_msg_clear(&tmsg);
+    if (_Z_MID(tmsg->_header) != _Z_MID_T_OPEN || _Z_HAS_FLAG(tmsg->_header, _Z_FLAG_T_INIT_A)) {
         _Z_ERROR_RETURN(_Z_ERR_MESSAGE_UNEXPECTED);
     }
     _Z_DEBUG("Received Z_OPEN(Syn)");
     // Process message
-    param->_lease = (tmsg._body._open._lease < Z_TRANSPORT_LEASE) ? tmsg._body._open._lease : Z_TRANSPORT_LEASE;
-    param->_initial_sn_rx = tmsg._body._open._initial_sn;
-    _z_t_msg_clear(&tmsg);
+    param->_lease = (tmsg->_body._open._lease < Z_TRANSPORT_LEASE) ? tmsg->_body._open._lease : Z_TRANSPORT_LEASE;
+    param->_initial_sn_rx = tmsg->_body._open._initial_sn;
 
     // Encode OpenAck
     _z_zint_t lease = Z_TRANSPORT_LEASE;
@@ -278,13 +295,10 @@ z_result_t _z_unicast_handshake_listen(_z_transport_unicast_establish_param_t *p
 
     // Encode and send the message
     _Z_DEBUG("Sending Z_OPEN(Ack)");
-    ret = _z_link_send_t_msg(zl, &oam, socket);
+    z_result_t ret = _z_link_send_t_msg(zl, &oam, socket);
     _z_t_msg_clear(&oam);
-    if (ret != _Z_RES_OK) {
-        return ret;
-    }
     // Handshake finished
-    return _Z_RES_OK;
+    return ret;
 }
 
 z_result_t _z_unicast_open_client(_z_transport_unicast_establish_param_t *param, const _z_link_t *zl,
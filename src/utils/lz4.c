@@ -0,0 +1,202 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/utils/lz4.h"
+
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+
+#include <stdbool.h>
+#include <string.h>
+
+/*
+ * A block is a list of sequences, each made of a token, literals copied as is and a match copied from the output
+ * already produced:
+ *
+ *   token (4 bits literal length, 4 bits match length - 4), [literal length bytes], literals,
+ *   offset (u16 little endian), [match length bytes]
+ *
+ * A nibble of 15 is followed by bytes added to the length until one is below 255. The last sequence only has literals,
+ * and the format requires the last 5 bytes to be literals and the last match to start 12 bytes before the end.
+ */
+#define _Z_LZ4_MIN_MATCH 4
+#define _Z_LZ4_LAST_LITERALS 5
+#define _Z_LZ4_MF_LIMIT 12
+#define _Z_LZ4_MAX_DISTANCE 65535
+#define _Z_LZ4_RUN_MASK 15
+#define _Z_LZ4_ML_MASK 15
+// Each miss in a row makes the search step grow, so that incompressible data is skipped quickly
+#define _Z_LZ4_SKIP_TRIGGER 6
+
+static inline uint32_t _z_lz4_read32(const uint8_t *p) {
+    uint32_t v;
+    (void)memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t _z_lz4_hash(uint32_t seq) { return (seq * 2654435761U) >> (32 - _Z_LZ4_HASH_LOG); }
+
+static inline size_t _z_lz4_length_size(size_t len, size_t mask) {
+    return (len >= mask) ? ((len - mask) / 255 + 1) : 0;
+}
+
+static size_t _z_lz4_write_length(uint8_t *dst, size_t op, size_t len) {
+    while (len >= 255) {
+        dst[op++] = 255;
+        len -= 255;
+    }
+    dst[op++] = (uint8_t)len;
+    return op;
+}
+
+// Appends a sequence at op, a match_len of 0 writes the final literals. Returns SIZE_MAX if dst is too small.
+static size_t _z_lz4_write_sequence(uint8_t *dst, size_t op, size_t dst_cap, const uint8_t *lit, size_t lit_len,
+                                    size_t offset, size_t match_len) {
+    size_t ml = (match_len > 0) ? (match_len - _Z_LZ4_MIN_MATCH) : 0;
+    size_t needed = 1 + _z_lz4_length_size(lit_len, _Z_LZ4_RUN_MASK) + lit_len;
+    if (match_len > 0) {
+        needed += 2 + _z_lz4_length_size(ml, _Z_LZ4_ML_MASK);
+    }
+    if (needed > dst_cap - op) {
+        return SIZE_MAX;
+    }
+
+    size_t token = op++;
+    dst[token] = (uint8_t)(((lit_len >= _Z_LZ4_RUN_MASK) ? _Z_LZ4_RUN_MASK : lit_len) << 4);
+    if (lit_len >= _Z_LZ4_RUN_MASK) {
+        op = _z_lz4_write_length(dst, op, lit_len - _Z_LZ4_RUN_MASK);
+    }
+    if (lit_len > 0) {
+        (void)memcpy(&dst[op], lit, lit_len);
+        op += lit_len;
+    }
+    if (match_len > 0) {
+        dst[op++] = (uint8_t)(offset & 0xFF);
+        dst[op++] = (uint8_t)(offset >> 8);
+        dst[token] |= (uint8_t)((ml >= _Z_LZ4_ML_MASK) ? _Z_LZ4_ML_MASK : ml);
+        if (ml >= _Z_LZ4_ML_MASK) {
+            op = _z_lz4_write_length(dst, op, ml - _Z_LZ4_ML_MASK);
+        }
+    }
+    return op;
+}
+
+size_t _z_lz4_compress(_z_lz4_ctx_t *ctx, const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap) {
+    if (src_len > _Z_LZ4_MAX_INPUT_SIZE) {
+        return 0;
+    }
+    size_t op = 0;
+    size_t anchor = 0;
+    if (src_len > _Z_LZ4_MF_LIMIT) {
+        (void)memset(ctx->_table, 0, sizeof(ctx->_table));
+        size_t match_start_limit = src_len - _Z_LZ4_MF_LIMIT;
+        size_t match_end_limit = src_len - _Z_LZ4_LAST_LITERALS;
+        size_t ip = 0;
+        size_t misses = (size_t)1 << _Z_LZ4_SKIP_TRIGGER;
+        while (ip < match_start_limit) {
+            uint32_t seq = _z_lz4_read32(&src[ip]);
+            uint32_t h = _z_lz4_hash(seq);
+            size_t ref = ctx->_table[h];
+            ctx->_table[h] = (uint16_t)ip;
+            if ((ref >= ip) || ((ip - ref) > _Z_LZ4_MAX_DISTANCE) || (_z_lz4_read32(&src[ref]) != seq)) {
+                ip += misses++ >> _Z_LZ4_SKIP_TRIGGER;
+                continue;
+            }
+            misses = (size_t)1 << _Z_LZ4_SKIP_TRIGGER;
+            // Take back the pending literals that are part of the match
+            while ((ip > anchor) && (ref > 0) && (src[ip - 1] == src[ref - 1])) {
+                ip--;
+                ref--;
+            }
+            size_t match_len = _Z_LZ4_MIN_MATCH;
+            while (((ip + match_len) < match_end_limit) && (src[ref + match_len] == src[ip + match_len])) {
+                match_len++;
+            }
+            op = _z_lz4_write_sequence(dst, op, dst_cap, &src[anchor], ip - anchor, ip - ref, match_len);
+            if (op == SIZE_MAX) {
+                return 0;
+            }
+            ip += match_len;
+            anchor = ip;
+        }
+    }
+    op = _z_lz4_write_sequence(dst, op, dst_cap, &src[anchor], src_len - anchor, 0, 0);
+    return (op == SIZE_MAX) ? 0 : op;
+}
+
+static bool _z_lz4_read_length(const uint8_t *src, size_t src_len, size_t *ip, size_t *len) {
+    uint8_t b = 0;
+    do {
+        if (*ip >= src_len) {
+            return false;
+        }
+        b = src[(*ip)++];
+        *len += b;
+    } while (b == 255);
+    return true;
+}
+
+size_t _z_lz4_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap) {
+    size_t ip = 0;
+    size_t op = 0;
+    while (ip < src_len) {
+        uint8_t token = src[ip++];
+        size_t lit_len = (size_t)(token >> 4);
+        if ((lit_len == _Z_LZ4_RUN_MASK) && !_z_lz4_read_length(src, src_len, &ip, &lit_len)) {
+            return SIZE_MAX;
+        }
+        if ((lit_len > (src_len - ip)) || (lit_len > (dst_cap - op))) {
+            return SIZE_MAX;
+        }
+        if (lit_len > 0) {
+            (void)memcpy(&dst[op], &src[ip], lit_len);
+            ip += lit_len;
+            op += lit_len;
+        }
+        if (ip == src_len) {
+            // The last sequence has no match
+            return op;
+        }
+
+        if ((src_len - ip) < 2) {
+            return SIZE_MAX;
+        }
+        size_t offset = (size_t)src[ip] | ((size_t)src[ip + 1] << 8);
+        ip += 2;
+        if ((offset == 0) || (offset > op)) {
+            return SIZE_MAX;
+        }
+        size_t match_len = (size_t)(token & _Z_LZ4_ML_MASK);
+        if ((match_len == _Z_LZ4_ML_MASK) && !_z_lz4_read_length(src, src_len, &ip, &match_len)) {
+            return SIZE_MAX;
+        }
+        match_len += _Z_LZ4_MIN_MATCH;
+        if (match_len > (dst_cap - op)) {
+            return SIZE_MAX;
+        }
+        if (offset >= match_len) {
+            (void)memcpy(&dst[op], &dst[op - offset], match_len);
+            op += match_len;
+        } else {
+            // The match overlaps the bytes it produces, e.g. a run of a repeated pattern
+            for (size_t i = 0; i < match_len; i++) {
+                dst[op] = dst[op - offset];
+                op++;
+            }
+        }
+    }
+    // Empty input or a block ending with a match
+    return SIZE_MAX;
+}
+
+#endif /* Z_FEATURE_TRANSPORT_COMPRESSION == 1 */
@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/assert_helpers.h"
+#include "zenoh-pico.h"
+#include "zenoh-pico/protocol/codec/transport.h"
+#include "zenoh-pico/protocol/definitions/transport.h"
+
+#if Z_FEATURE_UNICAST_PEER == 1 && Z_FEATURE_LINK_TCP == 1 && Z_FEATURE_MULTI_THREAD == 1 && defined(ZENOH_LINUX)
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define ACCEPT_TEST_PORT 18201
+#define ACCEPT_TEST_LOCATOR "tcp/127.0.0.1:18201"
+// Lets the accept task go back to waiting with nothing in progress
+#define ACCEPT_TEST_SETTLE_MS 100
+
+static int accept_test_connect(void) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_TRUE(fd >= 0);
+    struct timeval tv = {.tv_sec = 5, .tv_usec = 0};
+    ASSERT_TRUE(setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == 0);
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(ACCEPT_TEST_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_TRUE(connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+    return fd;
+}
+
+static void accept_test_send(int fd, const uint8_t *ptr, size_t len) {
+    ASSERT_TRUE(send(fd, ptr, len, MSG_NOSIGNAL) == (ssize_t)len);
+}
+
+// Returns true once the listener closed the connection, false if it is still open
+static bool accept_test_is_closed(int fd, bool wait) {
+    uint8_t byte;
+    ssize_t rb = recv(fd, &byte, 1, MSG_PEEK | (wait ? 0 : MSG_DONTWAIT));
+    if (rb < 0) {
+        ASSERT_TRUE(!wait && ((errno == EAGAIN) || (errno == EWOULDBLOCK)));
+        return false;
+    }
+    return rb == 0;
+}
+
+static size_t accept_test_encode_init_syn(uint8_t *buf, size_t len) {
+    _z_id_t zid = {0};
+    zid.id[0] = 1;
+    _z_transport_message_t t_msg = _z_t_msg_make_init_syn(Z_WHATAMI_PEER, zid);
+    _z_wbuf_t wbf = _z_wbuf_make(Z_BATCH_UNICAST_SIZE, false);
+    ASSERT_OK(_z_transport_message_encode(&wbf, &t_msg));
+    size_t msg_len = _z_wbuf_len(&wbf);
+    ASSERT_TRUE(msg_len + _Z_MSG_LEN_ENC_SIZE <= len);
+    buf[0] = (uint8_t)(msg_len & 0xFF);
+    buf[1] = (uint8_t)(msg_len >> 8);
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+    (void)memcpy(&buf[_Z_MSG_LEN_ENC_SIZE], _z_zbuf_get_rptr(&zbf), msg_len);
+    _z_zbuf_clear(&zbf);
+    _z_wbuf_clear(&wbf);
+    _z_t_msg_clear(&t_msg);
+    return msg_len + _Z_MSG_LEN_ENC_SIZE;
+}
+
+static void accept_test_recv_init_ack(int fd) {
+    uint8_t prefix[_Z_MSG_LEN_ENC_SIZE];
+    ASSERT_TRUE(recv(fd, prefix, sizeof(prefix), MSG_WAITALL) == (ssize_t)sizeof(prefix));
+    size_t msg_len = (size_t)prefix[0] | ((size_t)prefix[1] << 8);
+    _z_zbuf_t zbf = _z_zbuf_make(msg_len);
+    ASSERT_TRUE(recv(fd, _z_zbuf_get_wptr(&zbf), msg_len, MSG_WAITALL) == (ssize_t)msg_len);
+    _z_zbuf_set_wpos(&zbf, msg_len);
+    _z_transport_message_t t_msg;
+    ASSERT_OK(_z_transport_message_decode(&t_msg, &zbf));
+    ASSERT_TRUE(_Z_MID(t_msg._header) == _Z_MID_T_INIT);
+    ASSERT_TRUE(_Z_HAS_FLAG(t_msg._header, _Z_FLAG_T_INIT_A));
+    _z_t_msg_clear(&t_msg);
+    _z_zbuf_clear(&zbf);
+}
+
+static void test_accept_split_message(void) {
+    printf(">>> Testing an InitSyn split across reads...\n");
+    uint8_t buf[256];
+    size_t len = accept_test_encode_init_syn(buf, sizeof(buf));
+    int fd = accept_test_connect();
+    // Each byte of the length prefix on its own, then the body in two parts
+    const size_t cuts[] = {0, 1, _Z_MSG_LEN_ENC_SIZE, _Z_MSG_LEN_ENC_SIZE + (len - _Z_MSG_LEN_ENC_SIZE) / 2, len};
+    for (size_t i = 0; i + 1 < _ZP_ARRAY_SIZE(cuts); i++) {
+        accept_test_send(fd, &buf[cuts[i]], cuts[i + 1] - cuts[i]);
+        z_sleep_ms(50);
+        ASSERT_FALSE(accept_test_is_closed(fd, false));
+    }
+    accept_test_recv_init_ack(fd);
+    close(fd);
+}
+
+static void test_accept_timeout(void) {
+    printf(">>> Testing a silent connection timing out...\n");
+    int fd = accept_test_connect();
+    z_clock_t start = z_clock_now();
+    ASSERT_TRUE(accept_test_is_closed(fd, true));
+    unsigned long elapsed = z_clock_elapsed_ms(&start);
+    // Closed once the handshake deadline passed, the accept task waits for it
+    ASSERT_TRUE(elapsed + ACCEPT_TEST_SETTLE_MS >= Z_TRANSPORT_ACCEPT_TIMEOUT);
+    ASSERT_TRUE(elapsed <= 3 * Z_TRANSPORT_ACCEPT_TIMEOUT);
+    close(fd);
+}
+
+static void test_accept_pending_limit(void) {
+    printf(">>> Testing the pending connections limit...\n");
+    int fds[Z_LISTEN_MAX_CONNECTION_NB];
+    for (size_t i = 0; i < Z_LISTEN_MAX_CONNECTION_NB; i++) {
+        fds[i] = accept_test_connect();
+    }
+    // No slot is left for this one, it is closed without waiting for the handshake deadline
+    int extra = accept_test_connect();
+    ASSERT_TRUE(accept_test_is_closed(extra, true));
+    for (size_t i = 0; i < Z_LISTEN_MAX_CONNECTION_NB; i++) {
+        ASSERT_FALSE(accept_test_is_closed(fds[i], false));
+    }
+    close(extra);
+    // The slots are released once the handshakes time out
+    for (size_t i = 0; i < Z_LISTEN_MAX_CONNECTION_NB; i++) {
+        ASSERT_TRUE(accept_test_is_closed(fds[i], true));
+        close(fds[i]);
+    }
+    z_sleep_ms(ACCEPT_TEST_SETTLE_MS);
+    int fd = accept_test_connect();
+    uint8_t buf[256];
+    size_t len = accept_test_encode_init_syn(buf, sizeof(buf));
+    accept_test_send(fd, buf, len);
+    accept_test_recv_init_ack(fd);
+    close(fd);
+}
+
+int main(void) {
+    z_owned_config_t c;
+    z_config_default(&c);
+    zp_config_insert(z_loan_mut(c), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(c), Z_CONFIG_LISTEN_KEY, ACCEPT_TEST_LOCATOR);
+    z_owned_session_t s;
+    ASSERT_OK(z_open(&s, z_move(c), NULL));
+    z_sleep_ms(ACCEPT_TEST_SETTLE_MS);
+
+    test_accept_split_message();
+    test_accept_timeout();
+    test_accept_pending_limit();
+
+    z_drop(z_move(s));
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Unicast peer TCP accept not enabled, skipping tests\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,308 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Checks the samples selected by the advanced publisher cache against a linear scan of the cached samples.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/collections/advanced_cache.h"
+#include "zenoh-pico/net/sample.h"
+#include "zenoh-pico/utils/query_params.h"
+#include "zenoh-pico/utils/time_range.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_ADVANCED_PUBLICATION == 1
+
+#define CACHE_SIZE 64
+#define PUSHED 150
+
+typedef struct {
+    bool has_sn;
+    uint32_t sn;
+    bool has_ts;
+    _z_ntp64_t time;
+} sample_desc_t;
+
+static sample_desc_t g_history[PUSHED + CACHE_SIZE];
+static size_t g_pushed = 0;
+static _z_ntp64_t g_now;
+static size_t g_reply_refs = 2;  // References to a replied sample held by the query output and the cache
+static uint32_t rng_state = 0x2545F491;
+
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void push(_ze_advanced_cache_t *cache, const sample_desc_t *desc) {
+    _z_sample_t sample = _z_sample_null();
+    sample.keyexpr = _z_declared_keyexpr_alias_from_str("test/advanced/cache");
+    if (desc->has_sn) {
+        sample.source_info._source_id.zid.id[0] = 1;
+        sample.source_info._source_id.eid = 1;
+        sample.source_info._source_sn = desc->sn;
+    }
+    if (desc->has_ts) {
+        sample.timestamp.valid = true;
+        sample.timestamp.id.id[0] = 1;
+        sample.timestamp.time = desc->time;
+    }
+    assert(_ze_advanced_cache_add(cache, &sample) == _Z_RES_OK);
+    g_history[g_pushed++] = *desc;
+}
+
+// Linear scan of the last CACHE_SIZE pushed samples, newest first
+static size_t reference(const char *sn_range, const char *time_range, size_t max, sample_desc_t *out) {
+    int64_t start = -1;
+    int64_t end = -1;
+    if (sn_range != NULL) {
+        const char *dots = strstr(sn_range, "..");
+        if (dots != sn_range) start = atoi(sn_range);
+        if (dots[2] != '\0') end = atoi(dots + 2);
+    }
+    _z_time_range_t time;
+    if (time_range != NULL) {
+        assert(_z_time_range_from_str(time_range, strlen(time_range), &time));
+    }
+    size_t oldest = g_pushed > CACHE_SIZE ? g_pushed - CACHE_SIZE : 0;
+    size_t n = 0;
+    for (size_t i = g_pushed; i > oldest && n < max; i--) {
+        const sample_desc_t *d = &g_history[i - 1];
+        if (sn_range != NULL && (!d->has_sn || (start != -1 && d->sn < start) || (end != -1 && d->sn > end))) {
+            continue;
+        }
+        if (time_range != NULL && (!d->has_ts || !_z_time_range_contains_at_time(&time, d->time, g_now))) {
+            continue;
+        }
+        out[n++] = *d;
+    }
+    return n;
+}
+
+static void check_query(_ze_advanced_cache_t *cache, const char *sn_range, const char *time_range, size_t max) {
+    char params[128] = {0};
+    size_t len = 0;
+    if (sn_range != NULL) {
+        len += (size_t)snprintf(params + len, sizeof(params) - len, "%s=%s;", _Z_QUERY_PARAMS_KEY_RANGE, sn_range);
+    }
+    if (time_range != NULL) {
+        len += (size_t)snprintf(params + len, sizeof(params) - len, "%s=%s;", _Z_QUERY_PARAMS_KEY_TIME, time_range);
+    }
+    if (max != SIZE_MAX) {
+        len += (size_t)snprintf(params + len, sizeof(params) - len, "%s=%zu;", _Z_QUERY_PARAMS_KEY_MAX, max);
+    }
+
+    static sample_desc_t expected[CACHE_SIZE];
+    static _z_sample_rc_t got[CACHE_SIZE];
+    size_t n_expected = reference(sn_range, time_range, max, expected);
+    size_t n_got = _ze_advanced_cache_query(cache, params, g_now, got, CACHE_SIZE);
+    if (n_got != n_expected) {
+        printf("Mismatch for '%s': got %zu, expected %zu\n", params, n_got, n_expected);
+    }
+    assert(n_got == n_expected);
+    for (size_t i = 0; i < n_got; i++) {
+        _z_sample_t *s = _Z_RC_IN_VAL(&got[i]);
+        assert(_z_source_info_check(&s->source_info) == expected[i].has_sn);
+        assert(!expected[i].has_sn || s->source_info._source_sn == expected[i].sn);
+        assert(_z_timestamp_check(&s->timestamp) == expected[i].has_ts);
+        assert(!expected[i].has_ts || s->timestamp.time == expected[i].time);
+        // Replies share the cached sample, unless it is decoded from the persistence file
+        assert(_z_sample_rc_strong_count(&got[i]) == g_reply_refs);
+        _z_sample_rc_drop(&got[i]);
+    }
+}
+
+static _z_ntp64_t seconds_ago(uint32_t ms) { return g_now - (((_z_ntp64_t)ms << 32) / 1000); }
+
+static void run_queries(_ze_advanced_cache_t *cache) {
+    const char *sn_ranges[] = {NULL, "0..", "..100", "120..130", "90..95", "140..", "..10", "200..300", "125..125"};
+    const char *time_ranges[] = {NULL, "[now(-1s)..]", "[..now(-1s)]", "[now(-5s)..now(-1s)[", "]now(-100ms)..now()]",
+                                 "[now(-1h)..now(-30m)]"};
+    const size_t maxes[] = {SIZE_MAX, 0, 1, 5, 1000};
+    for (size_t a = 0; a < _ZP_ARRAY_SIZE(sn_ranges); a++) {
+        for (size_t b = 0; b < _ZP_ARRAY_SIZE(time_ranges); b++) {
+            for (size_t c = 0; c < _ZP_ARRAY_SIZE(maxes); c++) {
+                check_query(cache, sn_ranges[a], time_ranges[b], maxes[c]);
+            }
+        }
+    }
+}
+
+static void test_ordered(void) {
+    g_pushed = 0;
+    _ze_advanced_cache_t *cache = _ze_advanced_cache_new_detached(CACHE_SIZE);
+    assert(cache != NULL);
+    // Samples published in order, ~100ms apart, the oldest ones being evicted
+    for (uint32_t i = 0; i < PUSHED; i++) {
+        sample_desc_t d = {.has_sn = true, .sn = i, .has_ts = true, .time = seconds_ago((PUSHED - i) * 100)};
+        push(cache, &d);
+    }
+    run_queries(cache);
+    _ze_advanced_cache_free(&cache);
+    printf("test_ordered: OK\n");
+}
+
+static void test_unordered(void) {
+    g_pushed = 0;
+    _ze_advanced_cache_t *cache = _ze_advanced_cache_new_detached(CACHE_SIZE);
+    assert(cache != NULL);
+    // Some samples lack a sequence number or a timestamp, or come out of order: the cache must fall back to scanning
+    for (uint32_t i = 0; i < PUSHED; i++) {
+        uint32_t r = rng_next();
+        sample_desc_t d = {.has_sn = (r % 7) != 0,
+                           .sn = ((r % 11) == 0) ? i / 2 : i,
+                           .has_ts = (r % 5) != 0,
+                           .time = seconds_ago((PUSHED - i) * 100 + (((r % 13) == 0) ? 5000 : 0))};
+        push(cache, &d);
+        if (i % 10 == 0) {
+            run_queries(cache);
+        }
+    }
+    run_queries(cache);
+
+    // Once the offending samples are evicted, lookups are indexed again and must still agree
+    for (uint32_t i = 0; i < CACHE_SIZE; i++) {
+        sample_desc_t d = {.has_sn = true, .sn = 1000 + i, .has_ts = true, .time = seconds_ago(CACHE_SIZE - i)};
+        push(cache, &d);
+    }
+    run_queries(cache);
+    check_query(cache, "1010..1020", NULL, SIZE_MAX);
+    _ze_advanced_cache_free(&cache);
+    printf("test_unordered: OK\n");
+}
+
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+static char g_path[64];
+
+static void test_persistent(void) {
+    g_pushed = 0;
+    g_reply_refs = 1;
+    (void)remove(g_path);
+    _ze_advanced_cache_t *cache = _ze_advanced_cache_new_detached_persistent(CACHE_SIZE, g_path, 64 * 1024);
+    assert(cache != NULL);
+    for (uint32_t i = 0; i < PUSHED; i++) {
+        uint32_t r = rng_next();
+        sample_desc_t d = {.has_sn = (r % 7) != 0,
+                           .sn = ((r % 11) == 0) ? i / 2 : i,
+                           .has_ts = (r % 5) != 0,
+                           .time = seconds_ago((PUSHED - i) * 100 + (((r % 13) == 0) ? 5000 : 0))};
+        push(cache, &d);
+        if (i % 25 == 0) {
+            run_queries(cache);
+        }
+    }
+    run_queries(cache);
+    _ze_advanced_cache_free(&cache);
+
+    // The history survives a restart, indexes included
+    cache = _ze_advanced_cache_new_detached_persistent(CACHE_SIZE, g_path, 64 * 1024);
+    assert(cache != NULL);
+    run_queries(cache);
+    for (uint32_t i = 0; i < CACHE_SIZE; i++) {
+        sample_desc_t d = {.has_sn = true, .sn = 1000 + i, .has_ts = true, .time = seconds_ago(CACHE_SIZE - i)};
+        push(cache, &d);
+    }
+    run_queries(cache);
+    check_query(cache, "1010..1020", NULL, SIZE_MAX);
+    _ze_advanced_cache_free(&cache);
+
+    // A file written with another layout is discarded
+    cache = _ze_advanced_cache_new_detached_persistent(CACHE_SIZE / 2, g_path, 64 * 1024);
+    assert(cache != NULL);
+    _z_sample_rc_t got[1];
+    assert(_ze_advanced_cache_query(cache, "", g_now, got, 1) == 0);
+    _ze_advanced_cache_free(&cache);
+    g_reply_refs = 2;
+    printf("test_persistent: OK\n");
+}
+
+static void test_persistent_content(void) {
+    (void)remove(g_path);
+    // A small data ring evicts samples before the capacity is reached
+    _ze_advanced_cache_t *cache = _ze_advanced_cache_new_detached_persistent(CACHE_SIZE, g_path, 1024);
+    assert(cache != NULL);
+    for (uint32_t i = 0; i < PUSHED; i++) {
+        char payload[32];
+        int len = snprintf(payload, sizeof(payload), "payload %u", (unsigned)i);
+        _z_sample_t sample = _z_sample_null();
+        sample.keyexpr = _z_declared_keyexpr_alias_from_str("test/advanced/cache");
+        sample.kind = Z_SAMPLE_KIND_PUT;
+        sample.source_info._source_id.zid.id[0] = 1;
+        sample.source_info._source_id.eid = 1;
+        sample.source_info._source_sn = i;
+        sample.timestamp.valid = true;
+        sample.timestamp.id.id[0] = 1;
+        sample.timestamp.time = seconds_ago(PUSHED - i);
+        assert(_z_bytes_from_buf(&sample.payload, (const uint8_t *)payload, (size_t)len) == _Z_RES_OK);
+        assert(_ze_advanced_cache_add(cache, &sample) == _Z_RES_OK);
+        if (i == PUSHED / 2) {
+            // A restarted cache appends after the samples it restored
+            _ze_advanced_cache_free(&cache);
+            cache = _ze_advanced_cache_new_detached_persistent(CACHE_SIZE, g_path, 1024);
+            assert(cache != NULL);
+        }
+    }
+
+    static _z_sample_rc_t got[CACHE_SIZE];
+    size_t n = _ze_advanced_cache_query(cache, "", g_now, got, CACHE_SIZE);
+    assert(n > 0 && n < CACHE_SIZE);
+    for (size_t i = 0; i < n; i++) {
+        _z_sample_t *s = _Z_RC_IN_VAL(&got[i]);
+        uint32_t sn = (uint32_t)(PUSHED - 1 - i);
+        assert(s->source_info._source_sn == sn);
+        assert(s->timestamp.valid && s->timestamp.time == seconds_ago(PUSHED - sn));
+        assert(s->kind == Z_SAMPLE_KIND_PUT);
+        const _z_string_t *key = &s->keyexpr._inner._keyexpr;
+        assert(_z_string_len(key) == strlen("test/advanced/cache"));
+        assert(memcmp(_z_string_data(key), "test/advanced/cache", _z_string_len(key)) == 0);
+        char expected[32];
+        int len = snprintf(expected, sizeof(expected), "payload %u", (unsigned)sn);
+        _z_slice_t payload = _z_slice_null();
+        assert(_z_bytes_to_slice(&s->payload, &payload) == _Z_RES_OK);
+        assert(payload.len == (size_t)len && memcmp(payload.start, expected, (size_t)len) == 0);
+        _z_slice_clear(&payload);
+        _z_sample_rc_drop(&got[i]);
+    }
+    _ze_advanced_cache_free(&cache);
+    (void)remove(g_path);
+    printf("test_persistent_content: OK\n");
+}
+#endif
+
+int main(void) {
+    _z_time_since_epoch now;
+    assert(_z_get_time_since_epoch(&now) == _Z_RES_OK);
+    g_now = _z_timestamp_ntp64_from_time(now.secs, now.nanos);
+    test_ordered();
+    test_unordered();
+#if Z_FEATURE_ADVANCED_CACHE_PERSISTENCE == 1
+    (void)snprintf(g_path, sizeof(g_path), "z_advanced_cache_test_%u.bin", (unsigned)z_random_u32());
+    test_persistent();
+    test_persistent_content();
+#endif
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("This test requires: Z_FEATURE_ADVANCED_PUBLICATION.\n");
+    return 0;
+}
+#endif
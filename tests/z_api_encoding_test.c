@@ -5,6 +5,7 @@
 #include "zenoh-pico/api/encoding.h"
 #include "zenoh-pico/api/primitives.h"
 #include "zenoh-pico/api/types.h"
+#include "zenoh-pico/net/encoding.h"
 
 #undef NDEBUG
 #include <assert.h>
@@ -120,6 +121,73 @@ void test_equals(void) {
 #endif
 }
 
+void test_known_values_lookup(void) {
+#if Z_FEATURE_ENCODING_VALUES == 1
+    // Every predefined id must round-trip through its string representation
+    for (uint16_t id = 0; id < _z_encoding_values_len; id++) {
+        _z_encoding_t src = _z_encoding_wrap(id, NULL);
+        z_owned_string_t s;
+        z_encoding_to_string(&src, &s);
+        z_owned_encoding_t e;
+        z_encoding_from_substr(&e, z_string_data(z_string_loan(&s)), z_string_len(z_string_loan(&s)));
+        assert(z_encoding_loan(&e)->id == id);
+        assert(!_z_string_check(&z_encoding_loan(&e)->schema));
+        z_encoding_drop(z_encoding_move(&e));
+        z_string_drop(z_string_move(&s));
+    }
+    // Prefixes and extensions of a known value are not that value
+    z_owned_encoding_t e;
+    z_encoding_from_str(&e, "text/j");
+    assert(z_encoding_loan(&e)->id == _Z_ENCODING_ID_DEFAULT);
+    assert(_z_string_len(&z_encoding_loan(&e)->schema) == 6);
+    z_encoding_drop(z_encoding_move(&e));
+
+    z_encoding_from_str(&e, "text/json5x;schema");
+    assert(z_encoding_loan(&e)->id == _Z_ENCODING_ID_DEFAULT);
+    z_encoding_drop(z_encoding_move(&e));
+
+    z_encoding_from_str(&e, "text/json5;schema");
+    assert(z_encoding_loan(&e)->id == 11);
+    z_encoding_drop(z_encoding_move(&e));
+#endif
+}
+
+void test_schema_sharing(void) {
+    z_owned_encoding_t e1;
+    z_encoding_from_str(&e1, "zenoh/string;my_schema");
+    z_owned_encoding_t e2;
+    z_encoding_clone(&e2, z_encoding_loan(&e1));
+    // Clones share the interned schema
+    assert(_z_string_data(&z_encoding_loan(&e1)->schema) == _z_string_data(&z_encoding_loan(&e2)->schema));
+    assert(z_encoding_equals(z_encoding_loan(&e1), z_encoding_loan(&e2)));
+    z_encoding_drop(z_encoding_move(&e1));
+    // The schema outlives the original
+    assert(strncmp("my_schema", _z_string_data(&z_encoding_loan(&e2)->schema), 9) == 0);
+    z_encoding_drop(z_encoding_move(&e2));
+
+    // Aliased schemas are interned on copy
+    _z_encoding_t alias = _z_encoding_wrap(_Z_ENCODING_ID_DEFAULT, "aliased");
+    _z_encoding_t copy1 = _z_encoding_null();
+    _z_encoding_t copy2 = _z_encoding_null();
+    assert(_z_encoding_copy(&copy1, &alias) == _Z_RES_OK);
+    assert(_z_string_data(&copy1.schema) != _z_string_data(&alias.schema));
+    assert(_z_encoding_copy(&copy2, &copy1) == _Z_RES_OK);
+    assert(_z_string_data(&copy1.schema) == _z_string_data(&copy2.schema));
+    _z_encoding_clear(&copy2);
+    // Copying the alias again reuses the schema interned by the first copy
+    assert(_z_encoding_copy(&copy2, &alias) == _Z_RES_OK);
+    assert(_z_string_data(&copy1.schema) == _z_string_data(&copy2.schema));
+    _z_encoding_clear(&copy1);
+    _z_encoding_clear(&copy2);
+
+    // As do encodings built again from the same string
+    z_encoding_from_str(&e1, "text/csv;my_schema");
+    z_encoding_from_str(&e2, "text/csv;my_schema");
+    assert(_z_string_data(&z_encoding_loan(&e1)->schema) == _z_string_data(&z_encoding_loan(&e2)->schema));
+    z_encoding_drop(z_encoding_move(&e1));
+    z_encoding_drop(z_encoding_move(&e2));
+}
+
 int main(void) {
     test_null_encoding();
     test_encoding_without_id();
@@ -127,4 +195,6 @@ int main(void) {
     test_with_schema();
     test_constants();
     test_equals();
+    test_known_values_lookup();
+    test_schema_sharing();
 }
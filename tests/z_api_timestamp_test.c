@@ -12,6 +12,8 @@
 //   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
 
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "zenoh-pico/api/primitives.h"
 #include "zenoh-pico/api/types.h"
@@ -19,6 +21,7 @@
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/session/session.h"
 #include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/system/platform.h"
 
 #undef NDEBUG
 #include <assert.h>
@@ -107,8 +110,74 @@ static void test_timestamp_new_with_repeated_time(void) {
     cleanup_session(&fixture);
 }
 
+#if Z_FEATURE_MULTI_THREAD == 1
+
+#define CONCURRENT_TASKS 4
+#define CONCURRENT_TIMESTAMPS 5000
+
+typedef struct {
+    _z_session_rc_t *session_rc;
+    _z_ntp64_t times[CONCURRENT_TIMESTAMPS];
+} timestamp_task_arg_t;
+
+static void *timestamp_task(void *arg) {
+    timestamp_task_arg_t *typed = (timestamp_task_arg_t *)arg;
+    for (size_t i = 0; i < CONCURRENT_TIMESTAMPS; i++) {
+        z_timestamp_t ts;
+        assert(z_timestamp_new(&ts, typed->session_rc) == _Z_RES_OK);
+        typed->times[i] = z_timestamp_ntp64_time(&ts);
+        // Each thread sees its own timestamps strictly increase
+        assert((i == 0) || (typed->times[i] > typed->times[i - 1]));
+    }
+    return NULL;
+}
+
+static int compare_ntp64(const void *left, const void *right) {
+    _z_ntp64_t l = *(const _z_ntp64_t *)left;
+    _z_ntp64_t r = *(const _z_ntp64_t *)right;
+    return (l > r) - (l < r);
+}
+
+static void test_timestamp_new_concurrent(void) {
+    timestamp_test_fixture_t fixture;
+    setup_session_with_fake_clock(&fixture, 42, 100);
+
+    _z_task_t tasks[CONCURRENT_TASKS];
+    timestamp_task_arg_t *args = (timestamp_task_arg_t *)z_malloc(CONCURRENT_TASKS * sizeof(timestamp_task_arg_t));
+    assert(args != NULL);
+    for (size_t i = 0; i < CONCURRENT_TASKS; i++) {
+        args[i].session_rc = &fixture.session_rc;
+        assert(_z_task_init(&tasks[i], NULL, timestamp_task, &args[i]) == _Z_RES_OK);
+    }
+    for (size_t i = 0; i < CONCURRENT_TASKS; i++) {
+        _z_task_join(&tasks[i]);
+    }
+
+    // With a stuck clock, the generated timestamps are exactly the values following it
+    size_t n = CONCURRENT_TASKS * CONCURRENT_TIMESTAMPS;
+    _z_ntp64_t *all = (_z_ntp64_t *)z_malloc(n * sizeof(_z_ntp64_t));
+    assert(all != NULL);
+    for (size_t i = 0; i < CONCURRENT_TASKS; i++) {
+        memcpy(&all[i * CONCURRENT_TIMESTAMPS], args[i].times, sizeof(args[i].times));
+    }
+    qsort(all, n, sizeof(_z_ntp64_t), compare_ntp64);
+    _z_ntp64_t timestamp = _z_timestamp_ntp64_from_time(42, 100);
+    for (size_t i = 0; i < n; i++) {
+        assert(all[i] == timestamp + i);
+    }
+
+    z_free(all);
+    z_free(args);
+    cleanup_session(&fixture);
+}
+
+#endif
+
 int main(void) {
     test_timestamp_new_with_real_clock();
     test_timestamp_new_with_repeated_time();
+#if Z_FEATURE_MULTI_THREAD == 1
+    test_timestamp_new_concurrent();
+#endif
     return 0;
 }
@@ -0,0 +1,241 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/protocol/definitions/declarations.h"
+#include "zenoh-pico/protocol/definitions/interest.h"
+#include "zenoh-pico/session/declaration_cache.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_AUTO_RECONNECT == 1
+
+#define N 5000
+
+enum { KIND_KEXPR, KIND_SUBSCRIBER, KIND_QUERYABLE, KIND_TOKEN, KIND_INTEREST, KIND_COUNT };
+
+static _z_wireexpr_t wireexpr(void) {
+    _z_wireexpr_t expr = _z_wireexpr_null();
+    expr._suffix = _z_string_alias_str("test/declaration/cache");
+    return expr;
+}
+
+static _z_network_message_t make_declare(int kind, uint32_t id) {
+    _z_network_message_t n_msg;
+    _z_wireexpr_t expr = wireexpr();
+    switch (kind) {
+        case KIND_KEXPR:
+            _z_n_msg_make_declare(&n_msg, _z_make_decl_keyexpr((uint16_t)id, &expr), _z_optional_id_make_none());
+            break;
+        case KIND_SUBSCRIBER:
+            _z_n_msg_make_declare(&n_msg, _z_make_decl_subscriber(&expr, id), _z_optional_id_make_none());
+            break;
+        case KIND_QUERYABLE:
+            _z_n_msg_make_declare(&n_msg, _z_make_decl_queryable(&expr, id, true, 0), _z_optional_id_make_none());
+            break;
+        case KIND_TOKEN:
+            _z_n_msg_make_declare(&n_msg, _z_make_decl_token(&expr, id), _z_optional_id_make_none());
+            break;
+        default:
+            _z_n_msg_make_interest(&n_msg, _z_make_interest(&expr, id,
+                                                            _Z_INTEREST_FLAG_SUBSCRIBERS | _Z_INTEREST_FLAG_CURRENT |
+                                                                _Z_INTEREST_FLAG_FUTURE));
+            break;
+    }
+    return n_msg;
+}
+
+static _z_network_message_t make_undeclare(int kind, uint32_t id) {
+    _z_network_message_t n_msg;
+    switch (kind) {
+        case KIND_KEXPR:
+            _z_n_msg_make_declare(&n_msg, _z_make_undecl_keyexpr((uint16_t)id), _z_optional_id_make_none());
+            break;
+        case KIND_SUBSCRIBER:
+            _z_n_msg_make_declare(&n_msg, _z_make_undecl_subscriber(id, NULL), _z_optional_id_make_none());
+            break;
+        case KIND_QUERYABLE:
+            _z_n_msg_make_declare(&n_msg, _z_make_undecl_queryable(id, NULL), _z_optional_id_make_none());
+            break;
+        case KIND_TOKEN:
+            _z_n_msg_make_declare(&n_msg, _z_make_undecl_token(id, NULL), _z_optional_id_make_none());
+            break;
+        default:
+            _z_n_msg_make_interest(&n_msg, _z_make_interest_final(id));
+            break;
+    }
+    return n_msg;
+}
+
+static int kind_of(const _z_network_message_t *n_msg, uint32_t *id) {
+    if (n_msg->_tag == _Z_N_INTEREST) {
+        assert((n_msg->_body._interest._interest.flags & _Z_INTEREST_NOT_FINAL_MASK) != 0);
+        *id = n_msg->_body._interest._interest._id;
+        return KIND_INTEREST;
+    }
+    assert(n_msg->_tag == _Z_N_DECLARE);
+    const _z_declaration_t *decl = &n_msg->_body._declare._decl;
+    switch (decl->_tag) {
+        case _Z_DECL_KEXPR:
+            *id = decl->_body._decl_kexpr._id;
+            return KIND_KEXPR;
+        case _Z_DECL_SUBSCRIBER:
+            *id = decl->_body._decl_subscriber._id;
+            return KIND_SUBSCRIBER;
+        case _Z_DECL_QUERYABLE:
+            *id = decl->_body._decl_queryable._id;
+            return KIND_QUERYABLE;
+        case _Z_DECL_TOKEN:
+            *id = decl->_body._decl_token._id;
+            return KIND_TOKEN;
+        default:
+            assert(false);
+            return KIND_COUNT;
+    }
+}
+
+typedef struct {
+    bool seen[KIND_COUNT][N];
+    size_t count;
+    size_t calls;
+    size_t short_chunks;
+    int last_kind;
+    size_t fail_at_call;
+} replay_ctx_t;
+
+static z_result_t record(const _z_network_message_t *n_msgs, size_t len, void *arg) {
+    replay_ctx_t *ctx = (replay_ctx_t *)arg;
+    ctx->calls++;
+    if (ctx->calls == ctx->fail_at_call) {
+        return _Z_ERR_TRANSPORT_TX_FAILED;
+    }
+    assert(len > 0 && len <= _Z_DECLARATION_CACHE_REPLAY_CHUNK);
+    if (len < _Z_DECLARATION_CACHE_REPLAY_CHUNK) {
+        ctx->short_chunks++;
+    }
+    for (size_t i = 0; i < len; i++) {
+        uint32_t id = 0;
+        int kind = kind_of(&n_msgs[i], &id);
+        // Key expressions come first and interests last
+        assert(kind >= ctx->last_kind);
+        ctx->last_kind = kind;
+        assert(!ctx->seen[kind][id]);
+        ctx->seen[kind][id] = true;
+        ctx->count++;
+    }
+    return _Z_RES_OK;
+}
+
+static replay_ctx_t g_ctx;
+
+static void reset_ctx(void) {
+    memset(&g_ctx, 0, sizeof(g_ctx));
+    g_ctx.last_kind = KIND_KEXPR;
+}
+
+static void test_replay(void) {
+    _z_declaration_cache_t cache;
+    assert(_z_declaration_cache_init(&cache) == _Z_RES_OK);
+
+    // Interleaved declarations of every kind, as an application would do
+    for (uint32_t i = 1; i < N; i++) {
+        int kind = (int)((KIND_COUNT - 1) - (i % KIND_COUNT));
+        _z_network_message_t n_msg = make_declare(kind, i);
+        assert(_z_declaration_cache_insert(&cache, &n_msg) == _Z_RES_OK);
+        _z_n_msg_clear(&n_msg);
+    }
+    assert(_z_declaration_cache_len(&cache) == N - 1);
+
+    // Undeclare every third entity
+    size_t removed = 0;
+    for (uint32_t i = 1; i < N; i += 3) {
+        int kind = (int)((KIND_COUNT - 1) - (i % KIND_COUNT));
+        _z_network_message_t n_msg = make_undeclare(kind, i);
+        assert(_z_declaration_cache_remove(&cache, &n_msg));
+        // Undeclaring twice, or with the wrong kind, does not remove anything
+        assert(!_z_declaration_cache_remove(&cache, &n_msg));
+        _z_n_msg_clear(&n_msg);
+        n_msg = make_undeclare((kind + 1) % KIND_COUNT, i);
+        assert(!_z_declaration_cache_remove(&cache, &n_msg));
+        _z_n_msg_clear(&n_msg);
+        removed++;
+    }
+    assert(_z_declaration_cache_len(&cache) == N - 1 - removed);
+
+    // Declaring an entity again replaces its cached declaration
+    _z_network_message_t n_msg = make_declare(KIND_SUBSCRIBER, 3);
+    assert(_z_declaration_cache_insert(&cache, &n_msg) == _Z_RES_OK);
+    assert(_z_declaration_cache_insert(&cache, &n_msg) == _Z_RES_OK);
+    _z_n_msg_clear(&n_msg);
+    size_t expected = N - 1 - removed;
+    assert(_z_declaration_cache_len(&cache) == expected);
+
+    reset_ctx();
+    assert(_z_declaration_cache_replay(&cache, record, &g_ctx) == _Z_RES_OK);
+    assert(g_ctx.count == expected);
+    // Only the last chunk may be partial
+    assert(g_ctx.short_chunks <= 1);
+    assert(g_ctx.calls == (expected + _Z_DECLARATION_CACHE_REPLAY_CHUNK - 1) / _Z_DECLARATION_CACHE_REPLAY_CHUNK);
+    for (uint32_t i = 1; i < N; i++) {
+        int kind = (int)((KIND_COUNT - 1) - (i % KIND_COUNT));
+        assert(g_ctx.seen[kind][i] == ((i - 1) % 3 != 0));
+    }
+    assert(g_ctx.seen[KIND_SUBSCRIBER][3]);
+
+    // A failing replay stops at the failing chunk and leaves the cache untouched
+    reset_ctx();
+    g_ctx.fail_at_call = 2;
+    assert(_z_declaration_cache_replay(&cache, record, &g_ctx) == _Z_ERR_TRANSPORT_TX_FAILED);
+    assert(g_ctx.calls == 2);
+    assert(_z_declaration_cache_len(&cache) == expected);
+
+    _z_declaration_cache_clear(&cache);
+    assert(_z_declaration_cache_len(&cache) == 0);
+    reset_ctx();
+    assert(_z_declaration_cache_replay(&cache, record, &g_ctx) == _Z_RES_OK);
+    assert(g_ctx.calls == 0);
+
+    _z_declaration_cache_drop(&cache);
+    printf("test_replay: OK\n");
+}
+
+static void test_invalid(void) {
+    _z_declaration_cache_t cache;
+    assert(_z_declaration_cache_init(&cache) == _Z_RES_OK);
+    _z_network_message_t n_msg;
+    _z_n_msg_make_declare(&n_msg, _z_make_decl_final(), _z_optional_id_make_some(1));
+    assert(_z_declaration_cache_insert(&cache, &n_msg) != _Z_RES_OK);
+    assert(!_z_declaration_cache_remove(&cache, &n_msg));
+    assert(_z_declaration_cache_len(&cache) == 0);
+    _z_n_msg_clear(&n_msg);
+    _z_declaration_cache_drop(&cache);
+    printf("test_invalid: OK\n");
+}
+
+int main(void) {
+    test_replay();
+    test_invalid();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("This test requires: Z_FEATURE_AUTO_RECONNECT.\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/collections/epoch.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+typedef struct {
+    _z_epoch_node_t _node;
+    size_t value;
+} test_object_t;
+
+static size_t freed = 0;
+
+static void test_object_free(_z_epoch_node_t *node) {
+    freed++;
+    z_free(node);
+}
+
+static _z_epoch_node_t *test_object_new(size_t value) {
+    test_object_t *obj = (test_object_t *)z_malloc(sizeof(test_object_t));
+    assert(obj != NULL);
+    obj->value = value;
+    return &obj->_node;
+}
+
+void test_epoch_publish_without_readers(void) {
+    printf("test_epoch_publish_without_readers\n");
+    freed = 0;
+    _z_epoch_cell_t cell;
+    assert(_z_epoch_cell_init(&cell, test_object_free) == _Z_RES_OK);
+    _z_epoch_cell_publish(&cell, test_object_new(1));
+    _z_epoch_cell_reclaim(&cell);
+    assert(freed == 0);
+
+    _z_epoch_cell_publish(&cell, test_object_new(2));
+    _z_epoch_cell_reclaim(&cell);
+    assert(freed == 1);
+
+    size_t token = _z_epoch_cell_enter(&cell);
+    assert(((test_object_t *)_z_epoch_cell_load(&cell))->value == 2);
+    _z_epoch_cell_exit(&cell, token);
+
+    _z_epoch_cell_clear(&cell);
+    assert(freed == 2);
+}
+
+void test_epoch_reader_keeps_object(void) {
+    printf("test_epoch_reader_keeps_object\n");
+    freed = 0;
+    _z_epoch_cell_t cell;
+    assert(_z_epoch_cell_init(&cell, test_object_free) == _Z_RES_OK);
+    _z_epoch_cell_publish(&cell, test_object_new(1));
+
+    size_t token = _z_epoch_cell_enter(&cell);
+    test_object_t *obj = (test_object_t *)_z_epoch_cell_load(&cell);
+    _z_epoch_cell_publish(&cell, test_object_new(2));
+    _z_epoch_cell_reclaim(&cell);
+    // Still in use by the reader
+    assert(freed == 0);
+    assert(obj->value == 1);
+
+    // New readers see the new object while the old one is still in use
+    size_t token2 = _z_epoch_cell_enter(&cell);
+    assert(((test_object_t *)_z_epoch_cell_load(&cell))->value == 2);
+    _z_epoch_cell_exit(&cell, token2);
+    assert(freed == 0);
+
+    // The last reader leaving frees it
+    _z_epoch_cell_exit(&cell, token);
+    assert(freed == 1);
+
+    _z_epoch_cell_clear(&cell);
+    assert(freed == 2);
+}
+
+void test_epoch_many_replacements(void) {
+    printf("test_epoch_many_replacements\n");
+    freed = 0;
+    _z_epoch_cell_t cell;
+    assert(_z_epoch_cell_init(&cell, test_object_free) == _Z_RES_OK);
+    size_t token = _z_epoch_cell_enter(&cell);
+    for (size_t i = 0; i < 10; i++) {
+        _z_epoch_cell_publish(&cell, test_object_new(i));
+        _z_epoch_cell_reclaim(&cell);
+    }
+    assert(freed == 0);
+    _z_epoch_cell_exit(&cell, token);
+    _z_epoch_cell_reclaim(&cell);
+    assert(freed == 9);
+    _z_epoch_cell_clear(&cell);
+    assert(freed == 10);
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+
+#define READERS 4
+#define READS 20000
+#define PUBLICATIONS 2000
+
+typedef struct {
+    _z_epoch_cell_t *cell;
+    size_t reads;
+} reader_arg_t;
+
+static void *reader_task(void *arg) {
+    reader_arg_t *typed = (reader_arg_t *)arg;
+    for (size_t i = 0; i < READS; i++) {
+        size_t token = _z_epoch_cell_enter(typed->cell);
+        test_object_t *obj = (test_object_t *)_z_epoch_cell_load(typed->cell);
+        if (obj != NULL) {
+            // Freed objects are poisoned, see test_object_poison_free
+            assert(obj->value < PUBLICATIONS + 1);
+            typed->reads++;
+        }
+        _z_epoch_cell_exit(typed->cell, token);
+    }
+    return NULL;
+}
+
+static void test_object_poison_free(_z_epoch_node_t *node) {
+    ((test_object_t *)node)->value = SIZE_MAX;
+    test_object_free(node);
+}
+
+void test_epoch_concurrent_readers(void) {
+    printf("test_epoch_concurrent_readers\n");
+    freed = 0;
+    _z_epoch_cell_t cell;
+    assert(_z_epoch_cell_init(&cell, test_object_poison_free) == _Z_RES_OK);
+    _z_epoch_cell_publish(&cell, test_object_new(0));
+
+    _z_task_t tasks[READERS];
+    reader_arg_t args[READERS];
+    for (size_t i = 0; i < READERS; i++) {
+        args[i].cell = &cell;
+        args[i].reads = 0;
+        assert(_z_task_init(&tasks[i], NULL, reader_task, &args[i]) == _Z_RES_OK);
+    }
+    for (size_t i = 1; i <= PUBLICATIONS; i++) {
+        _z_epoch_cell_publish(&cell, test_object_new(i));
+        _z_epoch_cell_reclaim(&cell);
+    }
+    for (size_t i = 0; i < READERS; i++) {
+        _z_task_join(&tasks[i]);
+        assert(args[i].reads == READS);
+    }
+    _z_epoch_cell_reclaim(&cell);
+    assert(freed == PUBLICATIONS);
+    _z_epoch_cell_clear(&cell);
+    assert(freed == PUBLICATIONS + 1);
+}
+
+static _z_atomic_bool_t reader_entered;
+
+static void *slow_reader_task(void *arg) {
+    _z_epoch_cell_t *cell = (_z_epoch_cell_t *)arg;
+    size_t token = _z_epoch_cell_enter(cell);
+    test_object_t *obj = (test_object_t *)_z_epoch_cell_load(cell);
+    _z_atomic_bool_store(&reader_entered, true, _z_memory_order_seq_cst);
+    z_sleep_ms(100);
+    // Not freed while the reader is in its section
+    assert(obj->value == 1);
+    _z_epoch_cell_exit(cell, token);
+    return NULL;
+}
+
+void test_epoch_clear_waits_for_reader(void) {
+    printf("test_epoch_clear_waits_for_reader\n");
+    freed = 0;
+    _z_epoch_cell_t cell;
+    assert(_z_epoch_cell_init(&cell, test_object_poison_free) == _Z_RES_OK);
+    _z_epoch_cell_publish(&cell, test_object_new(1));
+    _z_atomic_bool_init(&reader_entered, false);
+
+    _z_task_t task;
+    assert(_z_task_init(&task, NULL, slow_reader_task, &cell) == _Z_RES_OK);
+    while (!_z_atomic_bool_load(&reader_entered, _z_memory_order_seq_cst)) {
+        z_sleep_ms(1);
+    }
+    _z_epoch_cell_clear(&cell);
+    assert(freed == 1);
+    _z_task_join(&task);
+}
+
+#endif
+
+int main(void) {
+    test_epoch_publish_without_readers();
+    test_epoch_reader_keeps_object();
+    test_epoch_many_replacements();
+#if Z_FEATURE_MULTI_THREAD == 1
+    test_epoch_concurrent_readers();
+    test_epoch_clear_waits_for_reader();
+#endif
+    return 0;
+}
@@ -0,0 +1,201 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Differential test of the SIMD and scalar key expression scanning paths.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/keyexpr_scan.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#define BUF_SIZE 256
+#define RANDOM_ROUNDS 20000
+
+static uint32_t rng_state = 0x2545F491;
+
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static size_t rng_below(size_t n) { return (n == 0) ? 0 : (size_t)rng_next() % n; }
+
+static void fill_random(char *buf, size_t len, const char *alphabet) {
+    size_t alen = strlen(alphabet);
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = alphabet[rng_below(alen)];
+    }
+}
+
+#if _Z_KE_SIMD == 1
+static void test_primitives(void) {
+    // Mostly plain bytes so that the interesting ones are found at every position, including vector tails
+    const char *alphabet = "abcdefghijklmnopqrstuvwxyz0123456789abcdefghij/*$#?@";
+    char lbuf[BUF_SIZE];
+    char rbuf[BUF_SIZE];
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        size_t off = rng_below(32);
+        size_t len = rng_below(BUF_SIZE - off);
+        fill_random(lbuf, BUF_SIZE, alphabet);
+        memcpy(rbuf, lbuf, BUF_SIZE);
+        if (len > 0 && rng_below(4) != 0) {
+            rbuf[off + rng_below(len)] = 'Z';
+        }
+        const char *l = lbuf + off;
+        const char *r = rbuf + off;
+
+        assert(_z_ke_scan_delimiter_simd(l, l + len) == _z_ke_scan_delimiter_scalar(l, l + len));
+        assert(_z_ke_scan_special_simd(l, l + len) == _z_ke_scan_special_scalar(l, l + len));
+        assert(_z_ke_scan_common_prefix_simd(l, r, len) == _z_ke_scan_common_prefix_scalar(l, r, len));
+        assert(_z_ke_scan_common_suffix_simd(l + len, r + len, len) ==
+               _z_ke_scan_common_suffix_scalar(l + len, r + len, len));
+    }
+
+    // Plain inputs only stop on a mismatch or at the end
+    memset(lbuf, 'a', BUF_SIZE);
+    memcpy(rbuf, lbuf, BUF_SIZE);
+    for (size_t len = 0; len < 100; len++) {
+        assert(_z_ke_scan_delimiter_simd(lbuf, lbuf + len) == lbuf + len);
+        assert(_z_ke_scan_special_simd(lbuf, lbuf + len) == lbuf + len);
+        assert(_z_ke_scan_common_prefix_simd(lbuf, rbuf, len) == len);
+        assert(_z_ke_scan_common_suffix_simd(lbuf + len, rbuf + len, len) == len);
+    }
+    printf("test_primitives: OK\n");
+}
+#endif
+
+static const char *CHUNKS[] = {
+    "a",   "b",   "robot",       "unit-042",   "sensors", "lidar-front-points-cloud-high-resolution",
+    "*",   "**",  "$*",          "ab$*cd",     "$*x",     "x$*",
+    "@v",  "@v2", "e?",          "x#",         "",        "building-tower-a-floor-17-room-1742",
+    "$*$*", "a*", "hvac-zone-3", "thermostat", "**",      "*"};
+
+static size_t random_keyexpr(char *buf, size_t cap) {
+    size_t n_chunks = 1 + rng_below(12);
+    size_t len = 0;
+    for (size_t i = 0; i < n_chunks; i++) {
+        const char *chunk = CHUNKS[rng_below(_ZP_ARRAY_SIZE(CHUNKS))];
+        size_t clen = strlen(chunk);
+        if (len + clen + 1 >= cap) {
+            break;
+        }
+        if (i > 0) {
+            buf[len++] = '/';
+        }
+        memcpy(buf + len, chunk, clen);
+        len += clen;
+    }
+    return len;
+}
+
+static zp_keyexpr_canon_status_t canonize_with(bool simd, const char *src, size_t len, char *dst, size_t *dst_len) {
+    _z_ke_scan_set_simd_enabled(simd);
+    memcpy(dst, src, len);
+    *dst_len = len;
+    zp_keyexpr_canon_status_t ret = _z_keyexpr_canonize(dst, dst_len);
+    _z_ke_scan_set_simd_enabled(true);
+    return ret;
+}
+
+static void test_canonize_differential(void) {
+    char src[BUF_SIZE];
+    char simd_out[BUF_SIZE];
+    char scalar_out[BUF_SIZE];
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        size_t len = random_keyexpr(src, BUF_SIZE);
+        size_t simd_len;
+        size_t scalar_len;
+        zp_keyexpr_canon_status_t simd_ret = canonize_with(true, src, len, simd_out, &simd_len);
+        zp_keyexpr_canon_status_t scalar_ret = canonize_with(false, src, len, scalar_out, &scalar_len);
+        assert(simd_ret == scalar_ret);
+        if (simd_ret == Z_KEYEXPR_CANON_SUCCESS) {
+            assert(simd_len == scalar_len);
+            assert(memcmp(simd_out, scalar_out, simd_len) == 0);
+            assert(_z_keyexpr_is_canon(simd_out, simd_len) == Z_KEYEXPR_CANON_SUCCESS);
+        }
+        _z_ke_scan_set_simd_enabled(false);
+        zp_keyexpr_canon_status_t scalar_is_canon = _z_keyexpr_is_canon(src, len);
+        _z_ke_scan_set_simd_enabled(true);
+        assert(_z_keyexpr_is_canon(src, len) == scalar_is_canon);
+    }
+    printf("test_canonize_differential: OK\n");
+}
+
+static bool random_canon_keyexpr(char *buf, size_t *len) {
+    char src[BUF_SIZE];
+    size_t src_len = random_keyexpr(src, BUF_SIZE);
+    return canonize_with(false, src, src_len, buf, len) == Z_KEYEXPR_CANON_SUCCESS;
+}
+
+static void test_match_differential(void) {
+    char lbuf[BUF_SIZE];
+    char rbuf[BUF_SIZE];
+    size_t matches = 0;
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        size_t llen;
+        size_t rlen;
+        if (!random_canon_keyexpr(lbuf, &llen)) {
+            continue;
+        }
+        if (rng_below(2) == 0) {
+            // Derive right from left so that long common prefixes and suffixes are exercised
+            memcpy(rbuf, lbuf, llen);
+            rlen = llen;
+            if (rlen > 0 && rng_below(2) == 0) {
+                size_t pos = rng_below(rlen);
+                if (rbuf[pos] != '/' && rbuf[pos] != '*' && rbuf[pos] != '$' && rbuf[pos] != '@') {
+                    rbuf[pos] = 'Z';
+                }
+            }
+        } else if (!random_canon_keyexpr(rbuf, &rlen)) {
+            continue;
+        }
+        _z_keyexpr_t l = _z_keyexpr_alias_from_substr(lbuf, llen);
+        _z_keyexpr_t r = _z_keyexpr_alias_from_substr(rbuf, rlen);
+
+        bool simd_intersects = _z_keyexpr_intersects(&l, &r);
+        bool simd_includes = _z_keyexpr_includes(&l, &r);
+        _z_ke_scan_set_simd_enabled(false);
+        bool scalar_intersects = _z_keyexpr_intersects(&l, &r);
+        bool scalar_includes = _z_keyexpr_includes(&l, &r);
+        _z_ke_scan_set_simd_enabled(true);
+        if (simd_intersects != scalar_intersects || simd_includes != scalar_includes) {
+            printf("Mismatch: %.*s vs %.*s\n", (int)llen, lbuf, (int)rlen, rbuf);
+        }
+        assert(simd_intersects == scalar_intersects);
+        assert(simd_includes == scalar_includes);
+        matches += simd_intersects ? 1u : 0u;
+    }
+    // Make sure that the generator produces both outcomes
+    assert(matches > 0);
+    printf("test_match_differential: OK (%zu intersections)\n", matches);
+}
+
+int main(void) {
+#if _Z_KE_SIMD == 1
+    test_primitives();
+#else
+    printf("SIMD scanning not available on this target, only checking the scalar path\n");
+#endif
+    test_canonize_differential();
+    test_match_differential();
+    return 0;
+}
@@ -16,29 +16,44 @@
 
 #include "zenoh-pico/api/primitives.h"
 #include "zenoh-pico/session/keyexpr.h"
+#include "zenoh-pico/session/keyexpr_intern.h"
 
 #undef NDEBUG
 #include <assert.h>
 
-#define TEST_TRUE_INTERSECT(a, b)        \
-    ke_a = _z_keyexpr_alias_from_str(a); \
-    ke_b = _z_keyexpr_alias_from_str(b); \
-    assert(_z_keyexpr_intersects(&ke_a, &ke_b));
-
-#define TEST_FALSE_INTERSECT(a, b)       \
-    ke_a = _z_keyexpr_alias_from_str(a); \
-    ke_b = _z_keyexpr_alias_from_str(b); \
-    assert(!_z_keyexpr_intersects(&ke_a, &ke_b));
-
-#define TEST_TRUE_INCLUDE(a, b)          \
-    ke_a = _z_keyexpr_alias_from_str(a); \
-    ke_b = _z_keyexpr_alias_from_str(b); \
-    assert(_z_keyexpr_includes(&ke_a, &ke_b));
-
-#define TEST_FALSE_INCLUDE(a, b)         \
-    ke_a = _z_keyexpr_alias_from_str(a); \
-    ke_b = _z_keyexpr_alias_from_str(b); \
-    assert(!_z_keyexpr_includes(&ke_a, &ke_b));
+#define TEST_TRUE_INTERSECT(a, b)                           \
+    ke_a = _z_keyexpr_alias_from_str(a);                    \
+    ke_b = _z_keyexpr_alias_from_str(b);                    \
+    assert(_z_keyexpr_intersects(&ke_a, &ke_b));            \
+    ike_a = _z_interned_keyexpr_alias(&ke_a);               \
+    ike_b = _z_interned_keyexpr_alias(&ke_b);               \
+    assert(_z_interned_keyexpr_intersects(&ike_a, &ike_b)); \
+    assert(_z_interned_keyexpr_intersects(&ike_b, &ike_a));
+
+#define TEST_FALSE_INTERSECT(a, b)                           \
+    ke_a = _z_keyexpr_alias_from_str(a);                     \
+    ke_b = _z_keyexpr_alias_from_str(b);                     \
+    assert(!_z_keyexpr_intersects(&ke_a, &ke_b));            \
+    ike_a = _z_interned_keyexpr_alias(&ke_a);                \
+    ike_b = _z_interned_keyexpr_alias(&ke_b);                \
+    assert(!_z_interned_keyexpr_intersects(&ike_a, &ike_b)); \
+    assert(!_z_interned_keyexpr_intersects(&ike_b, &ike_a));
+
+#define TEST_TRUE_INCLUDE(a, b)                           \
+    ke_a = _z_keyexpr_alias_from_str(a);                  \
+    ke_b = _z_keyexpr_alias_from_str(b);                  \
+    assert(_z_keyexpr_includes(&ke_a, &ke_b));            \
+    ike_a = _z_interned_keyexpr_alias(&ke_a);             \
+    ike_b = _z_interned_keyexpr_alias(&ke_b);             \
+    assert(_z_interned_keyexpr_includes(&ike_a, &ike_b));
+
+#define TEST_FALSE_INCLUDE(a, b)                           \
+    ke_a = _z_keyexpr_alias_from_str(a);                   \
+    ke_b = _z_keyexpr_alias_from_str(b);                   \
+    assert(!_z_keyexpr_includes(&ke_a, &ke_b));            \
+    ike_a = _z_interned_keyexpr_alias(&ke_a);              \
+    ike_b = _z_interned_keyexpr_alias(&ke_b);              \
+    assert(!_z_interned_keyexpr_includes(&ike_a, &ike_b));
 
 #define TEST_TRUE_EQUAL(a, b)            \
     ke_a = _z_keyexpr_alias_from_str(a); \
@@ -52,6 +67,7 @@
 
 void test_intersects(void) {
     _z_keyexpr_t ke_a, ke_b;
+    _z_interned_keyexpr_t ike_a, ike_b;
     TEST_TRUE_INTERSECT("a", "a")
     TEST_TRUE_INTERSECT("a/b", "a/b")
     TEST_TRUE_INTERSECT("*", "abc")
@@ -152,10 +168,14 @@ void test_intersects(void) {
     TEST_FALSE_INTERSECT("**/@a/b/c/**", "@b/b/c");
     TEST_TRUE_INTERSECT("**/@a/@b/@c/**", "@a/@b/@c");
     TEST_FALSE_INTERSECT("**/@a/@b/@c/**", "@a/@a/@c");
+    TEST_FALSE_INTERSECT("*", "**/b/**/x/**");
+    TEST_TRUE_INTERSECT("*/*/*", "**/b/**/x/s/**");
+    TEST_FALSE_INTERSECT("x/b", "**/b/**/x/**");
 }
 
 void test_includes(void) {
     _z_keyexpr_t ke_a, ke_b;
+    _z_interned_keyexpr_t ike_a, ike_b;
     TEST_TRUE_INCLUDE("a", "a")
     TEST_TRUE_INCLUDE("a/b", "a/b")
     TEST_TRUE_INCLUDE("*", "a")
@@ -208,12 +228,14 @@ void test_includes(void) {
     TEST_FALSE_INCLUDE("**/@a/b/c/**", "@b/b/c");
     TEST_TRUE_INCLUDE("**/@a/@b/@c/**", "@a/@b/@c");
     TEST_FALSE_INCLUDE("**/@a/@b/@c/**", "@a/@a/@c");
+    TEST_TRUE_INCLUDE("**/b/**/x/**", "b/c/x");
+    TEST_FALSE_INCLUDE("**/b/**/x/**", "x/b");
 }
 
 void test_canonize(void) {
     // clang-format off
 
-#define N 31
+#define N 36
     const char *input[N] = {"greetings/hello/there",
                             "greetings/good/*/morning",
                             "greetings/*",
@@ -244,7 +266,12 @@ void test_canonize(void) {
                             "greetings/**/*/e?",
                             "greetings/**/*/e#",
                             "greetings/**/*/e$",
-                            "greetings/**/*/$e"};
+                            "greetings/**/*/$e",
+                            "greetings/**/*/a/**",
+                            "greetings/$*/b/*",
+                            "**/b/**/*/a",
+                            "greetings/**/$*/b",
+                            "**/$*$*"};
     const zp_keyexpr_canon_status_t expected[N] = {Z_KEYEXPR_CANON_SUCCESS,
                                                    Z_KEYEXPR_CANON_SUCCESS,
                                                    Z_KEYEXPR_CANON_SUCCESS,
@@ -275,7 +302,12 @@ void test_canonize(void) {
                                                    Z_KEYEXPR_CANON_CONTAINS_SHARP_OR_QMARK,
                                                    Z_KEYEXPR_CANON_CONTAINS_SHARP_OR_QMARK,
                                                    Z_KEYEXPR_CANON_CONTAINS_UNBOUND_DOLLAR,
-                                                   Z_KEYEXPR_CANON_CONTAINS_UNBOUND_DOLLAR};
+                                                   Z_KEYEXPR_CANON_CONTAINS_UNBOUND_DOLLAR,
+                                                   Z_KEYEXPR_CANON_SUCCESS,
+                                                   Z_KEYEXPR_CANON_SUCCESS,
+                                                   Z_KEYEXPR_CANON_SUCCESS,
+                                                   Z_KEYEXPR_CANON_SUCCESS,
+                                                   Z_KEYEXPR_CANON_SUCCESS};
     const char *canonized[N] = {"greetings/hello/there",
                                 "greetings/good/*/morning",
                                 "greetings/*",
@@ -306,7 +338,12 @@ void test_canonize(void) {
                                 "greetings/**/*/e?",
                                 "greetings/**/*/e#",
                                 "greetings/**/*/e$",
-                                "greetings/**/*/$e"};
+                                "greetings/**/*/$e",
+                                "greetings/*/**/a/**",
+                                "greetings/*/b/*",
+                                "**/b/*/**/a",
+                                "greetings/*/**/b",
+                                "*/**"};
 
     // clang-format on
 
@@ -353,6 +390,32 @@ void test_equals(void) {
     TEST_TRUE_EQUAL("greetings/hello/there", "greetings/hello/there");
 }
 
+void test_declared_equals(void) {
+    // Key expressions extending the same declaration only differ by their suffixes
+    _z_keyexpr_wire_declaration_t declaration = _z_keyexpr_wire_declaration_null();
+    declaration._prefix_len = 4;
+    _z_keyexpr_wire_declaration_rc_t rc = _z_keyexpr_wire_declaration_rc_new_from_val(&declaration);
+    assert(!_Z_RC_IS_NULL(&rc));
+    _z_declared_keyexpr_t prefix = _z_declared_keyexpr_alias_from_str("a/bc");
+    _z_declared_keyexpr_t left = _z_declared_keyexpr_alias_from_str("a/bc/d");
+    _z_declared_keyexpr_t right = _z_declared_keyexpr_alias_from_str("a/bc/e");
+    _z_declared_keyexpr_t other = _z_declared_keyexpr_alias_from_str("a/bc/d");
+    prefix._declaration = rc;
+    left._declaration = rc;
+    right._declaration = rc;
+    assert(_z_declared_keyexpr_equals(&prefix, &prefix));
+    assert(!_z_declared_keyexpr_equals(&prefix, &left));
+    assert(!_z_declared_keyexpr_equals(&left, &right));
+    right._inner = _z_keyexpr_alias_from_str("a/bc/d");
+    assert(_z_declared_keyexpr_equals(&left, &right));
+    // Otherwise the whole key expressions are compared
+    assert(_z_declared_keyexpr_equals(&left, &other));
+    assert(_z_declared_keyexpr_equals(&other, &left));
+    other._inner = _z_keyexpr_alias_from_str("a/bd/d");
+    assert(!_z_declared_keyexpr_equals(&left, &other));
+    _z_keyexpr_wire_declaration_rc_drop(&rc);
+}
+
 bool keyexpr_equals_string(const z_loaned_keyexpr_t *ke, const char *s) {
     z_view_string_t vs;
     z_keyexpr_as_view_string(ke, &vs);
@@ -458,6 +521,55 @@ void test_non_wild_prefix_len(void) {
     assert(_z_keyexpr_non_wild_prefix_len(&ke5) == 0);
 }
 
+void test_intern_table(void) {
+    _z_keyexpr_intern_table_t table;
+    _z_keyexpr_intern_table_init(&table);
+
+    _z_keyexpr_t ke = _z_keyexpr_alias_from_str("foo/bar");
+    _z_interned_keyexpr_rc_t first, second;
+    assert(_z_keyexpr_intern(&table, &ke, &first) == _Z_RES_OK);
+    assert(_z_keyexpr_intern(&table, &ke, &second) == _Z_RES_OK);
+    // Equal key expressions share the same instance, with its properties computed once
+    assert(_Z_RC_IN_VAL(&first) == _Z_RC_IN_VAL(&second));
+    assert(_Z_RC_IN_VAL(&first)->_hash == _z_keyexpr_hash(&ke));
+    assert(_Z_RC_IN_VAL(&first)->_n_chunks == 2);
+    assert(_z_interned_keyexpr_is_verbatim(_Z_RC_IN_VAL(&first)));
+    assert(_z_keyexpr_intern_table_len(&table) == 1);
+    _z_interned_keyexpr_rc_drop(&second);
+
+    _z_keyexpr_t wild = _z_keyexpr_alias_from_str("foo/**");
+    assert(_z_keyexpr_intern(&table, &wild, &second) == _Z_RES_OK);
+    assert(_Z_RC_IN_VAL(&first) != _Z_RC_IN_VAL(&second));
+    assert((_Z_RC_IN_VAL(&second)->_wildness & _ZP_WILDNESS_SUPERCHUNKS) != 0);
+    assert(_z_interned_keyexpr_intersects(_Z_RC_IN_VAL(&first), _Z_RC_IN_VAL(&second)));
+    _z_interned_keyexpr_rc_drop(&second);
+
+    // A released key expression is interned again
+    _z_interned_keyexpr_rc_drop(&first);
+    assert(_z_keyexpr_intern(&table, &ke, &first) == _Z_RES_OK);
+    _z_interned_keyexpr_t alias = _z_interned_keyexpr_alias(&ke);
+    assert(_z_interned_keyexpr_equals(_Z_RC_IN_VAL(&first), &alias));
+
+    // Entries of released key expressions are purged as the table grows
+    char buf[32];
+    for (int i = 0; i < 256; i++) {
+        snprintf(buf, sizeof(buf), "key/%d", i);
+        _z_keyexpr_t tmp = _z_keyexpr_alias_from_str(buf);
+        _z_interned_keyexpr_rc_t rc;
+        assert(_z_keyexpr_intern(&table, &tmp, &rc) == _Z_RES_OK);
+        _z_interned_keyexpr_rc_drop(&rc);
+    }
+    assert(_z_keyexpr_intern_table_len(&table) <= 64);
+    assert(_z_keyexpr_intern(&table, &ke, &second) == _Z_RES_OK);
+    assert(_Z_RC_IN_VAL(&first) == _Z_RC_IN_VAL(&second));
+    _z_interned_keyexpr_rc_drop(&second);
+
+    // Instances outlive the table
+    _z_keyexpr_intern_table_clear(&table);
+    assert(_z_keyexpr_equals(&_Z_RC_IN_VAL(&first)->_key, &ke));
+    _z_interned_keyexpr_rc_drop(&first);
+}
+
 int main(void) {
     test_intersects();
     test_includes();
@@ -468,6 +580,8 @@ int main(void) {
     test_join();
     test_relation_to();
     test_non_wild_prefix_len();
+    test_intern_table();
+    test_declared_equals();
 
     return 0;
 }
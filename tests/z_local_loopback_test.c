@@ -20,6 +20,7 @@
 #include <stdio.h>
 
 #include "zenoh-pico/api/constants.h"
+#include "zenoh-pico/api/liveliness.h"
 #include "zenoh-pico/api/macros.h"
 #include "zenoh-pico/api/primitives.h"
 #include "zenoh-pico/api/types.h"
@@ -48,6 +49,8 @@ static atomic_uint g_local_put_delivery_count = 0;
 static atomic_uint g_local_query_delivery_count = 0;
 static atomic_uint g_query_drop_callback_count = 0;
 static atomic_uint g_query_reply_callback_count = 0;
+static atomic_uint g_network_declare_count = 0;
+static atomic_uint g_closure_drop_count = 0;
 
 static _z_session_t g_session;
 static _z_session_rc_t g_session_rc = {0};
@@ -73,6 +76,11 @@ static z_result_t z_send_override(_z_session_t *zn, const _z_network_message_t *
         if (n_msg->_tag == _Z_N_RESPONSE_FINAL) {
             atomic_fetch_add_explicit(&g_network_final_send_count, 1, memory_order_relaxed);
         }
+        // Only count the entity (un)declarations, not the key expressions they declare
+        if ((n_msg->_tag == _Z_N_DECLARE) && (n_msg->_body._declare._decl._tag != _Z_DECL_KEXPR) &&
+            (n_msg->_body._declare._decl._tag != _Z_UNDECL_KEXPR)) {
+            atomic_fetch_add_explicit(&g_network_declare_count, 1, memory_order_relaxed);
+        }
     }
     if (handled != NULL) {
         *handled = true;
@@ -184,9 +192,16 @@ static _z_subscription_rc_t register_local_subscription(const _z_declared_keyexp
     return subscription_rc;
 }
 
+static _z_pending_query_t *first_pending_query(void) {
+    _z_pending_query_hmap_t *pqs = &g_session._pending_queries;
+    assert(!_z_pending_query_hmap_is_empty(pqs));
+    return &_z_pending_query_hmap_at(pqs, _z_pending_query_hmap_begin(pqs))->val;
+}
+
 static _z_session_queryable_rc_t register_local_queryable(const _z_declared_keyexpr_t *keyexpr, atomic_uint *counter,
                                                           z_locality_t allowed_origin) {
     _z_session_queryable_t queryable_entry = {0};
+    queryable_entry._id = _z_get_entity_id(&g_session);
     _z_declared_keyexpr_copy(&queryable_entry._key, keyexpr);
     queryable_entry._callback = local_query_callback;
     queryable_entry._dropper = NULL;
@@ -226,6 +241,37 @@ static void test_put_local_only_single(void) {
     cleanup_session();
 }
 
+#if Z_FEATURE_MULTI_THREAD == 1
+static void test_put_local_while_queryables_locked(void) {
+    setup_session();
+    _z_declared_keyexpr_t keyexpr = create_local_resource("zenoh-pico/tests/local/put/sharded");
+    _z_subscription_rc_t subscription_rc =
+        register_local_subscription(&keyexpr, &g_local_put_delivery_count, Z_LOCALITY_SESSION_LOCAL);
+    atomic_store_explicit(&g_local_put_delivery_count, 0, memory_order_relaxed);
+
+    // Sample dispatch does not depend on the queryable and query registries, e.g. while a queryable is declared
+    _z_session_queryables_mutex_lock(&g_session);
+    _z_session_queries_mutex_lock(&g_session);
+    const char payload_data[] = "payload";
+    _z_bytes_t payload;
+    assert(_z_bytes_from_buf(&payload, (const uint8_t *)payload_data, sizeof(payload_data) - 1) == _Z_RES_OK);
+    _z_n_qos_t qos = _z_n_qos_make(false, false, Z_PRIORITY_DEFAULT);
+    _z_encoding_t encoding = _z_encoding_null();
+    _z_timestamp_t ts = _z_timestamp_null();
+    _z_source_info_t source_info = _z_source_info_null();
+    assert(_z_session_deliver_push_locally(&g_session, &keyexpr._inner, &payload, &encoding, Z_SAMPLE_KIND_PUT, qos,
+                                           &ts, NULL, Z_RELIABILITY_RELIABLE, &source_info) == _Z_RES_OK);
+    _z_session_queries_mutex_unlock(&g_session);
+    _z_session_queryables_mutex_unlock(&g_session);
+    assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == 1);
+
+    _z_bytes_drop(&payload);
+    _z_unregister_subscription(&g_session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &subscription_rc);
+    cleanup_local_resource(&keyexpr);
+    cleanup_session();
+}
+#endif
+
 static void test_put_local_only_via_api(void) {
     setup_session();
 
@@ -332,7 +378,7 @@ static void test_query_local_only_single(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, &queryable_rc);
     cleanup_local_resource(&keyexpr);
@@ -379,6 +425,64 @@ static void test_put_local_only_multiple(void) {
     cleanup_session();
 }
 
+static void deliver_local_put(const _z_declared_keyexpr_t *keyexpr) {
+    const char payload_data[] = "payload";
+    _z_bytes_t payload;
+    assert(_z_bytes_from_buf(&payload, (const uint8_t *)payload_data, sizeof(payload_data) - 1) == _Z_RES_OK);
+    _z_n_qos_t qos = _z_n_qos_make(false, false, Z_PRIORITY_DEFAULT);
+    _z_encoding_t encoding = _z_encoding_null();
+    _z_timestamp_t ts = _z_timestamp_null();
+    _z_source_info_t source_info = _z_source_info_null();
+    assert(_z_session_deliver_push_locally(&g_session, &keyexpr->_inner, &payload, &encoding, Z_SAMPLE_KIND_PUT, qos,
+                                           &ts, NULL, Z_RELIABILITY_RELIABLE, &source_info) == _Z_RES_OK);
+    _z_bytes_drop(&payload);
+}
+
+static void test_put_local_after_declarations(void) {
+    setup_session();
+
+    _z_declared_keyexpr_t keyexpr = create_local_resource("zenoh-pico/tests/local/put/changes/a");
+    _z_declared_keyexpr_t wild_keyexpr = create_local_resource("zenoh-pico/tests/local/put/changes/*");
+    _z_declared_keyexpr_t other_keyexpr = create_local_resource("zenoh-pico/tests/local/put/other");
+
+    atomic_uint first_count = 0;
+    atomic_uint wild_count = 0;
+    atomic_uint other_count = 0;
+    _z_subscription_rc_t first = register_local_subscription(&keyexpr, &first_count, Z_LOCALITY_SESSION_LOCAL);
+    _z_subscription_rc_t other = register_local_subscription(&other_keyexpr, &other_count, Z_LOCALITY_SESSION_LOCAL);
+    deliver_local_put(&keyexpr);
+    deliver_local_put(&other_keyexpr);
+    assert(atomic_load_explicit(&first_count, memory_order_relaxed) == 1);
+    assert(atomic_load_explicit(&other_count, memory_order_relaxed) == 1);
+
+    // The matches of the key delivered before are recomputed once an intersecting subscription is declared
+    _z_subscription_rc_t wild = register_local_subscription(&wild_keyexpr, &wild_count, Z_LOCALITY_SESSION_LOCAL);
+#if Z_FEATURE_RX_CACHE == 1
+    // Only the matches of the intersecting key were dropped
+    assert(g_session._subscription_cache.len == 1);
+#endif
+    deliver_local_put(&keyexpr);
+    assert(atomic_load_explicit(&first_count, memory_order_relaxed) == 2);
+    assert(atomic_load_explicit(&wild_count, memory_order_relaxed) == 1);
+
+    _z_unregister_subscription(&g_session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &first);
+    deliver_local_put(&keyexpr);
+    deliver_local_put(&other_keyexpr);
+    assert(atomic_load_explicit(&first_count, memory_order_relaxed) == 2);
+    assert(atomic_load_explicit(&wild_count, memory_order_relaxed) == 2);
+    assert(atomic_load_explicit(&other_count, memory_order_relaxed) == 2);
+
+    _z_unregister_subscription(&g_session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &wild);
+    _z_unregister_subscription(&g_session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &other);
+    deliver_local_put(&keyexpr);
+    assert(atomic_load_explicit(&wild_count, memory_order_relaxed) == 2);
+    cleanup_local_resource(&other_keyexpr);
+    cleanup_local_resource(&wild_keyexpr);
+    cleanup_local_resource(&keyexpr);
+
+    cleanup_session();
+}
+
 static void test_put_local_and_remote(void) {
     setup_session();
     add_fake_peer();
@@ -452,7 +556,7 @@ static void test_query_local_only_multiple(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, &queryable_secondary);
     _z_unregister_session_queryable(&g_session, &queryable_primary);
@@ -487,7 +591,7 @@ static void test_query_local_and_remote(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     atomic_store_explicit(&g_local_query_delivery_count, 0, memory_order_relaxed);
     atomic_store_explicit(&g_query_reply_callback_count, 0, memory_order_relaxed);
@@ -505,10 +609,10 @@ static void test_query_local_and_remote(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries != NULL);
+    assert(!_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     // Simulate REPLY from remote queryable
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     _z_zint_t request_id = pq->_id;
 
     const char remote_data[] = "remote-response";
@@ -533,7 +637,7 @@ static void test_query_local_and_remote(void) {
     // will be delivered on RESPONSE_FINAL
     assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries != NULL);
+    assert(!_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     // Receiving RESPONSE_FINAL from remote queryable
     _z_network_message_t final_msg;
@@ -544,7 +648,7 @@ static void test_query_local_and_remote(void) {
     // Remote reply delivered, query finalized
     assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, &queryable_primary);
     cleanup_local_resource(&keyexpr);
@@ -593,7 +697,7 @@ static void test_query_local_and_remote_via_api(void) {
                 z_move(r_closure), &gopt);
     assert(res == Z_OK);
 
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     assert(pq != NULL);
     _z_zint_t request_id = pq->_id;
 
@@ -622,7 +726,7 @@ static void test_query_local_and_remote_via_api(void) {
 
     assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     z_moved_queryable_t *mq = z_queryable_move(&queryable);
     z_queryable_drop(mq);
@@ -665,6 +769,138 @@ static void test_put_remote_only_destination(void) {
     cleanup_session();
 }
 
+#define PUT_MANY_COUNT 8
+
+static void test_write_many_local_and_remote(void) {
+    setup_session();
+    add_fake_peer();
+
+    _z_declared_keyexpr_t keyexpr = create_local_resource("zenoh-pico/tests/local/put/many");
+    _z_subscription_rc_t sub = register_local_subscription(&keyexpr, &g_local_put_delivery_count, Z_LOCALITY_ANY);
+
+    atomic_store_explicit(&g_local_put_delivery_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_network_send_count, 0, memory_order_relaxed);
+
+    const char payload_data[] = "payload";
+    _z_bytes_t payloads[PUT_MANY_COUNT];
+    _z_write_item_t items[PUT_MANY_COUNT];
+    for (size_t i = 0; i < PUT_MANY_COUNT; i++) {
+        assert(_z_bytes_from_buf(&payloads[i], (const uint8_t *)payload_data, sizeof(payload_data) - 1) ==
+               _Z_RES_OK);
+        items[i].payload = &payloads[i];
+        items[i].attachment = NULL;
+        items[i].timestamp = NULL;
+    }
+    _z_encoding_t encoding = _z_encoding_null();
+
+    z_result_t res = _z_write_many(&g_session, &keyexpr, items, PUT_MANY_COUNT, &encoding, Z_CONGESTION_CONTROL_BLOCK,
+                                   Z_PRIORITY_DEFAULT, false, Z_RELIABILITY_RELIABLE, NULL, Z_LOCALITY_ANY);
+    assert(res == _Z_RES_OK);
+    assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == PUT_MANY_COUNT);
+    assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == PUT_MANY_COUNT);
+
+    // Nothing to send
+    res = _z_write_many(&g_session, &keyexpr, items, 0, &encoding, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT,
+                        false, Z_RELIABILITY_RELIABLE, NULL, Z_LOCALITY_ANY);
+    assert(res == _Z_RES_OK);
+    assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == PUT_MANY_COUNT);
+
+    for (size_t i = 0; i < PUT_MANY_COUNT; i++) {
+        _z_bytes_drop(&payloads[i]);
+    }
+    _z_unregister_subscription(&g_session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    cleanup_local_resource(&keyexpr);
+
+    cleanup_session();
+}
+
+static void test_publisher_put_many_local_only_via_api(void) {
+    setup_session();
+
+    _z_declared_keyexpr_t keyexpr = create_local_resource("zenoh-pico/tests/local/put/many/api");
+    _z_subscription_rc_t sub =
+        register_local_subscription(&keyexpr, &g_local_put_delivery_count, Z_LOCALITY_SESSION_LOCAL);
+
+    z_publisher_options_t pub_opt;
+    z_publisher_options_default(&pub_opt);
+    pub_opt.allowed_destination = Z_LOCALITY_SESSION_LOCAL;
+    z_owned_publisher_t pub;
+    assert(z_declare_publisher(&g_session_rc, &pub, (const z_loaned_keyexpr_t *)&keyexpr, &pub_opt) == Z_OK);
+
+    atomic_store_explicit(&g_local_put_delivery_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_network_send_count, 0, memory_order_relaxed);
+
+    const char payload_data[] = "payload";
+    z_owned_bytes_t payloads[PUT_MANY_COUNT];
+    z_owned_bytes_t attachments[PUT_MANY_COUNT];
+    z_moved_bytes_t *moved_payloads[PUT_MANY_COUNT];
+    z_moved_bytes_t *moved_attachments[PUT_MANY_COUNT];
+    for (size_t i = 0; i < PUT_MANY_COUNT; i++) {
+        assert(z_bytes_from_buf(&payloads[i], (uint8_t *)payload_data, sizeof(payload_data) - 1, NULL, NULL) == Z_OK);
+        assert(z_bytes_copy_from_str(&attachments[i], "attachment") == Z_OK);
+        moved_payloads[i] = z_move(payloads[i]);
+        // Attachments are optional for every sample
+        moved_attachments[i] = (i % 2 == 0) ? z_move(attachments[i]) : NULL;
+    }
+
+    z_publisher_put_many_options_t opt;
+    z_publisher_put_many_options_default(&opt);
+    opt.attachments = moved_attachments;
+    assert(z_publisher_put_many(z_loan(pub), moved_payloads, PUT_MANY_COUNT, &opt) == Z_OK);
+    assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == PUT_MANY_COUNT);
+    assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
+    for (size_t i = 0; i < PUT_MANY_COUNT; i++) {
+        assert(!z_internal_check(payloads[i]));
+        if (i % 2 == 0) {
+            assert(!z_internal_check(attachments[i]));
+        } else {
+            z_drop(z_move(attachments[i]));
+        }
+    }
+
+    z_drop(z_move(pub));
+    _z_unregister_subscription(&g_session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    cleanup_local_resource(&keyexpr);
+
+    cleanup_session();
+}
+
+static void test_publisher_tx_buf_via_api(void) {
+    setup_session();
+    add_fake_peer();
+
+    _z_declared_keyexpr_t keyexpr = create_local_resource("zenoh-pico/tests/local/put/tx-buf");
+    _z_subscription_rc_t sub = register_local_subscription(&keyexpr, &g_local_put_delivery_count, Z_LOCALITY_ANY);
+
+    z_owned_publisher_t pub;
+    assert(z_declare_publisher(&g_session_rc, &pub, (const z_loaned_keyexpr_t *)&keyexpr, NULL) == Z_OK);
+
+    atomic_store_explicit(&g_local_put_delivery_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_network_send_count, 0, memory_order_relaxed);
+
+    const char payload_data[] = "payload";
+    zp_publisher_tx_buf_t buf;
+    assert(zp_publisher_loan_tx_buf(z_loan(pub), &buf, sizeof(payload_data) - 1, NULL) == Z_OK);
+    memcpy(zp_publisher_tx_buf_data(&buf), payload_data, sizeof(payload_data) - 1);
+    assert(zp_publisher_tx_buf_commit(&buf) == Z_OK);
+    assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == 1);
+    assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
+
+    // An aborted buffer sends nothing
+    atomic_store_explicit(&g_local_put_delivery_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_network_send_count, 0, memory_order_relaxed);
+    assert(zp_publisher_loan_tx_buf(z_loan(pub), &buf, sizeof(payload_data) - 1, NULL) == Z_OK);
+    zp_publisher_tx_buf_abort(&buf);
+    assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == 0);
+    assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
+
+    z_drop(z_move(pub));
+    _z_unregister_subscription(&g_session, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub);
+    cleanup_local_resource(&keyexpr);
+
+    cleanup_session();
+}
+
 static void test_subscriber_remote_only_origin(void) {
     setup_session();
     add_fake_peer();
@@ -720,13 +956,13 @@ static void test_query_remote_only_destination(void) {
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
 
     // Clean pending query by simulating RESPONSE_FINAL
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     assert(pq != NULL);
     _z_network_message_t final_msg;
     _z_n_msg_make_response_final(&final_msg, pq->_id);
     res = _z_handle_network_message(&g_fake_transport, &final_msg, NULL);
     assert(res == _Z_RES_OK);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_hmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, &queryable_rc);
     cleanup_local_resource(&keyexpr);
@@ -754,7 +990,7 @@ static void test_queryable_remote_only_origin(void) {
     assert(atomic_load_explicit(&g_local_query_delivery_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
 
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     assert(pq != NULL);
     _z_network_message_t final_msg2;
     _z_n_msg_make_response_final(&final_msg2, pq->_id);
@@ -767,20 +1003,222 @@ static void test_queryable_remote_only_origin(void) {
     cleanup_session();
 }
 
+static void api_sample_callback(z_loaned_sample_t *sample, void *arg) {
+    _ZP_UNUSED(sample);
+    atomic_fetch_add_explicit((atomic_uint *)arg, 1, memory_order_relaxed);
+}
+
+static void api_query_callback(z_loaned_query_t *query, void *arg) {
+    _ZP_UNUSED(query);
+    atomic_fetch_add_explicit((atomic_uint *)arg, 1, memory_order_relaxed);
+}
+
+static void closure_dropper(void *arg) {
+    _ZP_UNUSED(arg);
+    atomic_fetch_add_explicit(&g_closure_drop_count, 1, memory_order_relaxed);
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+static atomic_bool g_dispatch_entered = false;
+static atomic_bool g_dispatch_done = false;
+
+static void slow_sample_callback(z_loaned_sample_t *sample, void *arg) {
+    _ZP_UNUSED(sample);
+    _ZP_UNUSED(arg);
+    atomic_store(&g_dispatch_entered, true);
+    z_sleep_ms(100);
+    atomic_store(&g_dispatch_done, true);
+}
+
+static void dispatch_checking_dropper(void *arg) {
+    _ZP_UNUSED(arg);
+    // The dispatch snapshot keeps the subscription until the dispatch is over
+    assert(atomic_load(&g_dispatch_done));
+    atomic_fetch_add_explicit(&g_closure_drop_count, 1, memory_order_relaxed);
+}
+
+static void *undeclaring_task(void *arg) {
+    z_owned_subscriber_t *other = (z_owned_subscriber_t *)arg;
+    while (!atomic_load(&g_dispatch_entered)) {
+        z_sleep_ms(1);
+    }
+    assert(z_undeclare_subscriber(z_move(*other)) == Z_OK);
+    assert(atomic_load(&g_dispatch_done));
+    assert(atomic_load_explicit(&g_closure_drop_count, memory_order_relaxed) == 1);
+    return NULL;
+}
+
+static void test_undeclare_subscriber_waits_for_dispatch(void) {
+    setup_session();
+
+    _z_declared_keyexpr_t first_ke = _z_declared_keyexpr_alias_from_str("zenoh-pico/tests/local/undeclare/first");
+    _z_declared_keyexpr_t other_ke = _z_declared_keyexpr_alias_from_str("zenoh-pico/tests/local/undeclare/other");
+    z_owned_subscriber_t other;
+    z_owned_closure_sample_t other_closure;
+    z_closure_sample(&other_closure, api_sample_callback, dispatch_checking_dropper, &g_local_put_delivery_count);
+    assert(z_declare_subscriber(&g_session_rc, &other, (const z_loaned_keyexpr_t *)&other_ke, z_move(other_closure),
+                                NULL) == Z_OK);
+    z_owned_subscriber_t first;
+    z_owned_closure_sample_t first_closure;
+    z_closure_sample(&first_closure, slow_sample_callback, NULL, NULL);
+    assert(z_declare_subscriber(&g_session_rc, &first, (const z_loaned_keyexpr_t *)&first_ke, z_move(first_closure),
+                                NULL) == Z_OK);
+
+    // The other subscriber is undeclared while the dispatching snapshot references it, the undeclaration waits for the
+    // dispatch to end
+    atomic_store_explicit(&g_closure_drop_count, 0, memory_order_relaxed);
+    atomic_store(&g_dispatch_entered, false);
+    atomic_store(&g_dispatch_done, false);
+    _z_task_t task;
+    assert(_z_task_init(&task, NULL, undeclaring_task, &other) == _Z_RES_OK);
+    z_owned_bytes_t payload;
+    assert(z_bytes_copy_from_str(&payload, "payload") == Z_OK);
+    z_put_options_t opt;
+    z_put_options_default(&opt);
+    opt.allowed_destination = Z_LOCALITY_SESSION_LOCAL;
+    assert(z_put(&g_session_rc, (const z_loaned_keyexpr_t *)&first_ke, z_move(payload), &opt) == Z_OK);
+    _z_task_join(&task);
+    assert(!z_internal_check(other));
+    assert(_z_subscription_rc_hmap_size(&g_session._subscriptions) == 1);
+
+    assert(z_undeclare_subscriber(z_move(first)) == Z_OK);
+    cleanup_session();
+}
+#endif
+
+#define BULK_LEN 8
+
+static void test_bulk_declarations_via_api(void) {
+    setup_session();
+    add_fake_peer();
+
+    char keys[BULK_LEN][64];
+    _z_declared_keyexpr_t keyexprs[BULK_LEN];
+    const z_loaned_keyexpr_t *loaned[BULK_LEN];
+    for (size_t i = 0; i < BULK_LEN; i++) {
+        snprintf(keys[i], sizeof(keys[i]), "zenoh-pico/tests/local/bulk/%u", (unsigned)i);
+        keyexprs[i] = _z_declared_keyexpr_alias_from_str(keys[i]);
+        loaned[i] = (const z_loaned_keyexpr_t *)&keyexprs[i];
+    }
+
+    // Subscribers
+    z_owned_closure_sample_t sample_closures[BULK_LEN];
+    z_moved_closure_sample_t *moved_sample_closures[BULK_LEN];
+    for (size_t i = 0; i < BULK_LEN; i++) {
+        z_closure_sample(&sample_closures[i], api_sample_callback, closure_dropper, &g_local_put_delivery_count);
+        moved_sample_closures[i] = z_move(sample_closures[i]);
+    }
+    atomic_store_explicit(&g_network_declare_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_closure_drop_count, 0, memory_order_relaxed);
+    z_owned_subscriber_t subs[BULK_LEN];
+    assert(z_declare_subscribers(&g_session_rc, subs, loaned, moved_sample_closures, BULK_LEN, NULL) == Z_OK);
+    assert(atomic_load_explicit(&g_network_declare_count, memory_order_relaxed) == BULK_LEN);
+    assert(_z_subscription_rc_hmap_size(&g_session._subscriptions) == BULK_LEN);
+    for (size_t i = 0; i < BULK_LEN; i++) {
+        assert(z_internal_check(subs[i]));
+        assert(!z_internal_check(sample_closures[i]));
+    }
+
+    // Each subscriber only receives the samples of its own key
+    atomic_store_explicit(&g_local_put_delivery_count, 0, memory_order_relaxed);
+    z_owned_bytes_t payload;
+    assert(z_bytes_copy_from_str(&payload, "payload") == Z_OK);
+    z_put_options_t put_opt;
+    z_put_options_default(&put_opt);
+    put_opt.allowed_destination = Z_LOCALITY_SESSION_LOCAL;
+    assert(z_put(&g_session_rc, loaned[BULK_LEN - 1], z_move(payload), &put_opt) == Z_OK);
+    assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == 1);
+
+    z_moved_subscriber_t *moved_subs[BULK_LEN];
+    for (size_t i = 0; i < BULK_LEN; i++) {
+        moved_subs[i] = z_move(subs[i]);
+    }
+    atomic_store_explicit(&g_network_declare_count, 0, memory_order_relaxed);
+    assert(z_undeclare_subscribers(moved_subs, BULK_LEN) == Z_OK);
+    assert(atomic_load_explicit(&g_network_declare_count, memory_order_relaxed) == BULK_LEN);
+    assert(atomic_load_explicit(&g_closure_drop_count, memory_order_relaxed) == BULK_LEN);
+    assert(_z_subscription_rc_hmap_is_empty(&g_session._subscriptions));
+    for (size_t i = 0; i < BULK_LEN; i++) {
+        assert(!z_internal_check(subs[i]));
+    }
+
+    // Queryables
+    z_owned_closure_query_t query_closures[BULK_LEN];
+    z_moved_closure_query_t *moved_query_closures[BULK_LEN];
+    for (size_t i = 0; i < BULK_LEN; i++) {
+        z_closure_query(&query_closures[i], api_query_callback, closure_dropper, &g_local_query_delivery_count);
+        moved_query_closures[i] = z_move(query_closures[i]);
+    }
+    atomic_store_explicit(&g_network_declare_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_closure_drop_count, 0, memory_order_relaxed);
+    z_owned_queryable_t queryables[BULK_LEN];
+    assert(z_declare_queryables(&g_session_rc, queryables, loaned, moved_query_closures, BULK_LEN, NULL) == Z_OK);
+    assert(atomic_load_explicit(&g_network_declare_count, memory_order_relaxed) == BULK_LEN);
+    assert(_z_session_queryable_rc_hmap_size(&g_session._local_queryable) == BULK_LEN);
+
+    z_moved_queryable_t *moved_queryables[BULK_LEN];
+    for (size_t i = 0; i < BULK_LEN; i++) {
+        moved_queryables[i] = z_move(queryables[i]);
+    }
+    atomic_store_explicit(&g_network_declare_count, 0, memory_order_relaxed);
+    assert(z_undeclare_queryables(moved_queryables, BULK_LEN) == Z_OK);
+    assert(atomic_load_explicit(&g_network_declare_count, memory_order_relaxed) == BULK_LEN);
+    assert(atomic_load_explicit(&g_closure_drop_count, memory_order_relaxed) == BULK_LEN);
+    assert(_z_session_queryable_rc_hmap_is_empty(&g_session._local_queryable));
+
+#if Z_FEATURE_LIVELINESS == 1
+    // Liveliness tokens
+    atomic_store_explicit(&g_network_declare_count, 0, memory_order_relaxed);
+    z_owned_liveliness_token_t tokens[BULK_LEN];
+    assert(z_liveliness_declare_tokens(&g_session_rc, tokens, loaned, BULK_LEN, NULL) == Z_OK);
+    assert(atomic_load_explicit(&g_network_declare_count, memory_order_relaxed) == BULK_LEN);
+    assert(_z_declared_keyexpr_intmap_len(&g_session._local_tokens) == BULK_LEN);
+
+    z_moved_liveliness_token_t *moved_tokens[BULK_LEN];
+    for (size_t i = 0; i < BULK_LEN; i++) {
+        moved_tokens[i] = z_move(tokens[i]);
+    }
+    atomic_store_explicit(&g_network_declare_count, 0, memory_order_relaxed);
+    assert(z_liveliness_undeclare_tokens(moved_tokens, BULK_LEN) == Z_OK);
+    assert(atomic_load_explicit(&g_network_declare_count, memory_order_relaxed) == BULK_LEN);
+    assert(_z_declared_keyexpr_intmap_is_empty(&g_session._local_tokens));
+    for (size_t i = 0; i < BULK_LEN; i++) {
+        assert(!z_internal_check(tokens[i]));
+    }
+#endif
+
+    // Nothing to do
+    assert(z_declare_subscribers(&g_session_rc, subs, loaned, moved_sample_closures, 0, NULL) == Z_OK);
+    assert(z_undeclare_subscribers(moved_subs, 0) == Z_OK);
+
+    cleanup_session();
+}
+
 int main(void) {
     test_put_local_only_single();
+#if Z_FEATURE_MULTI_THREAD == 1
+    test_put_local_while_queryables_locked();
+#endif
     test_put_local_only_via_api();
     test_put_local_and_remote_via_api();
     test_put_local_only_multiple();
+    test_put_local_after_declarations();
     test_put_local_and_remote();
     test_query_local_only_single();
     test_query_local_only_multiple();
     test_query_local_and_remote();
     test_query_local_and_remote_via_api();
     test_put_remote_only_destination();
+    test_write_many_local_and_remote();
+    test_publisher_put_many_local_only_via_api();
+    test_publisher_tx_buf_via_api();
     test_subscriber_remote_only_origin();
     test_query_remote_only_destination();
     test_queryable_remote_only_origin();
+    test_bulk_declarations_via_api();
+#if Z_FEATURE_MULTI_THREAD == 1
+    test_undeclare_subscriber_waits_for_dispatch();
+#endif
     return 0;
 }
 
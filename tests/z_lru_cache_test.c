@@ -48,7 +48,10 @@ int _dummy_compare(const void *first, const void *second) {
 
 static inline void _dummy_elem_clear(void *e) { _z_noop_clear((_dummy_t *)e); }
 
-_Z_LRU_CACHE_DEFINE(_dummy, _dummy_t, _dummy_compare)
+// Few buckets get several values, to exercise collisions
+size_t _dummy_hash(const void *val) { return (size_t)((const _dummy_t *)val)->foo % 7; }
+
+_Z_LRU_CACHE_DEFINE(_dummy, _dummy_t, _dummy_compare, _dummy_hash)
 
 int _owned_dummy_compare(const void *first, const void *second) {
     const _owned_dummy_t *d_first = (const _owned_dummy_t *)first;
@@ -69,7 +72,9 @@ static inline void _owned_dummy_elem_clear(void *e) {
     }
 }
 
-_Z_LRU_CACHE_DEFINE(_owned_dummy, _owned_dummy_t, _owned_dummy_compare)
+size_t _owned_dummy_hash(const void *val) { return (size_t)((const _owned_dummy_t *)val)->foo; }
+
+_Z_LRU_CACHE_DEFINE(_owned_dummy, _owned_dummy_t, _owned_dummy_compare, _owned_dummy_hash)
 
 void test_lru_init(void) {
     _dummy_lru_cache_t dcache = _dummy_lru_cache_init(CACHE_CAPACITY);
@@ -77,17 +82,17 @@ void test_lru_init(void) {
     assert(dcache.len == 0);
     assert(dcache.head == NULL);
     assert(dcache.tail == NULL);
-    assert(dcache.slist == NULL);
+    assert(dcache.buckets == NULL);
 }
 
 void test_lru_cache_insert(void) {
     _dummy_lru_cache_t dcache = _dummy_lru_cache_init(CACHE_CAPACITY);
 
     _dummy_t v0 = {0};
-    assert(dcache.slist == NULL);
+    assert(dcache.buckets == NULL);
     assert(_dummy_lru_cache_get(&dcache, &v0) == NULL);
     assert(_dummy_lru_cache_insert(&dcache, &v0) == 0);
-    assert(dcache.slist != NULL);
+    assert(dcache.buckets != NULL);
     _dummy_t *res = _dummy_lru_cache_get(&dcache, &v0);
     assert(res != NULL);
     assert(res->foo == v0.foo);
@@ -116,7 +121,7 @@ void test_lru_cache_clear(void) {
     _dummy_lru_cache_clear(&dcache);
     assert(dcache.capacity == CACHE_CAPACITY);
     assert(dcache.len == 0);
-    assert(dcache.slist != NULL);
+    assert(dcache.buckets != NULL);
     assert(dcache.head == NULL);
     assert(dcache.tail == NULL);
     for (size_t i = 0; i < CACHE_CAPACITY; i++) {
@@ -190,6 +195,67 @@ void test_lru_cache_update(void) {
     _dummy_lru_cache_delete(&dcache);
 }
 
+static bool _owned_dummy_is_odd(const void *val, const void *arg) {
+    _ZP_UNUSED(arg);
+    return (((const _owned_dummy_t *)val)->foo % 2) != 0;
+}
+
+void test_lru_cache_remove_if(void) {
+    _owned_dummy_lru_cache_t dcache = _owned_dummy_lru_cache_init(CACHE_CAPACITY);
+
+    int clear_count = 0;
+    _owned_dummy_t data[CACHE_CAPACITY];
+    for (size_t i = 0; i < CACHE_CAPACITY; i++) {
+        data[i] = (_owned_dummy_t){(int)i, &clear_count};
+        assert(_owned_dummy_lru_cache_insert(&dcache, &data[i]) == 0);
+    }
+    assert(_owned_dummy_lru_cache_remove_if(&dcache, _owned_dummy_is_odd, NULL) == CACHE_CAPACITY / 2);
+    assert(clear_count == CACHE_CAPACITY / 2);
+    assert(dcache.len == CACHE_CAPACITY - CACHE_CAPACITY / 2);
+    for (size_t i = 0; i < CACHE_CAPACITY; i++) {
+        _owned_dummy_t *res = _owned_dummy_lru_cache_get(&dcache, &data[i]);
+        assert((res == NULL) == ((i % 2) != 0));
+    }
+    // Freed room is used before evicting
+    for (size_t i = 1; i < CACHE_CAPACITY; i += 2) {
+        assert(_owned_dummy_lru_cache_insert(&dcache, &data[i]) == 0);
+    }
+    assert(clear_count == CACHE_CAPACITY / 2);
+    assert(dcache.len == CACHE_CAPACITY);
+    _owned_dummy_lru_cache_delete(&dcache);
+}
+
+void test_lru_cache_resize(void) {
+    _dummy_lru_cache_t dcache = _dummy_lru_cache_init(CACHE_CAPACITY);
+
+    _dummy_t data[CACHE_CAPACITY] = {0};
+    for (size_t i = 0; i < CACHE_CAPACITY; i++) {
+        data[i].foo = (int)i;
+        assert(_dummy_lru_cache_insert(&dcache, &data[i]) == 0);
+    }
+    // Shrinking evicts the least recently used values
+    _dummy_lru_cache_resize(&dcache, 3);
+    assert(dcache.len == 3);
+    for (size_t i = 0; i < CACHE_CAPACITY; i++) {
+        assert((_dummy_lru_cache_get(&dcache, &data[i]) != NULL) == (i >= CACHE_CAPACITY - 3));
+    }
+    // Growing keeps them
+    _dummy_lru_cache_resize(&dcache, 2 * CACHE_CAPACITY);
+    assert(dcache.len == 3);
+    for (size_t i = 0; i < CACHE_CAPACITY - 3; i++) {
+        assert(_dummy_lru_cache_insert(&dcache, &data[i]) == 0);
+    }
+    for (size_t i = 0; i < CACHE_CAPACITY; i++) {
+        assert(_dummy_lru_cache_get(&dcache, &data[i]) != NULL);
+    }
+    // A null capacity disables the cache
+    _dummy_lru_cache_resize(&dcache, 0);
+    assert(dcache.len == 0);
+    assert(_dummy_lru_cache_insert(&dcache, &data[0]) == 0);
+    assert(_dummy_lru_cache_get(&dcache, &data[0]) == NULL);
+    _dummy_lru_cache_delete(&dcache);
+}
+
 static bool val_in_array(int val, int *array, size_t array_size) {
     for (size_t i = 0; i < array_size; i++) {
         if (val == array[i]) {
@@ -316,6 +382,8 @@ int main(void) {
     test_lru_cache_deletion_clear();
     test_lru_cache_update();
     test_lru_cache_random_val();
+    test_lru_cache_remove_if();
+    test_lru_cache_resize();
 #if 0
     test_benchmark();
 #endif
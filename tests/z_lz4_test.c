@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/utils/lz4.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+
+#define BUF_LEN 8192
+
+static _z_lz4_ctx_t ctx;
+static uint8_t src[BUF_LEN];
+static uint8_t cmp[BUF_LEN];
+static uint8_t out[BUF_LEN];
+
+static void test_round_trip(const uint8_t *data, size_t len) {
+    size_t clen = _z_lz4_compress(&ctx, data, len, cmp, sizeof(cmp));
+    assert(clen > 0);
+    size_t dlen = _z_lz4_decompress(cmp, clen, out, sizeof(out));
+    assert(dlen == len);
+    assert(memcmp(out, data, len) == 0);
+}
+
+static void test_redundant(void) {
+    printf(">>> Testing redundant data...\n");
+    size_t len = 0;
+    for (int i = 0; len + 64 < BUF_LEN; i++) {
+        len += (size_t)snprintf((char *)&src[len], BUF_LEN - len, "{\"id\":%d,\"temperature\":21.%d,\"unit\":\"C\"}", i,
+                                i % 10);
+    }
+    test_round_trip(src, len);
+    size_t clen = _z_lz4_compress(&ctx, src, len, cmp, sizeof(cmp));
+    assert(clen < len / 2);
+
+    // A run of a single byte produces matches overlapping their own output
+    (void)memset(src, 'a', 1000);
+    test_round_trip(src, 1000);
+}
+
+static void test_small(void) {
+    printf(">>> Testing small inputs...\n");
+    for (size_t len = 1; len < 32; len++) {
+        for (size_t i = 0; i < len; i++) {
+            src[i] = (uint8_t)(i % 3);
+        }
+        test_round_trip(src, len);
+    }
+    // An empty input is a single token without literals
+    size_t clen = _z_lz4_compress(&ctx, src, 0, cmp, sizeof(cmp));
+    assert(clen == 1);
+    assert(_z_lz4_decompress(cmp, clen, out, sizeof(out)) == 0);
+}
+
+static void test_incompressible(void) {
+    printf(">>> Testing incompressible data...\n");
+    srand(42);
+    for (size_t i = 0; i < BUF_LEN; i++) {
+        src[i] = (uint8_t)rand();
+    }
+    test_round_trip(src, BUF_LEN / 2);
+    // The output can't be smaller than the input
+    assert(_z_lz4_compress(&ctx, src, BUF_LEN / 2, cmp, BUF_LEN / 2 - 1) == 0);
+    assert(_z_lz4_compress(&ctx, src, _Z_LZ4_MAX_INPUT_SIZE + 1, cmp, sizeof(cmp)) == 0);
+}
+
+static void test_reference_block(void) {
+    printf(">>> Testing reference block...\n");
+    // "abc" followed by a match of 16 bytes at offset 3, then 5 literals
+    const uint8_t block[] = {0x3C, 'a', 'b', 'c', 0x03, 0x00, 0x50, 'x', 'y', 'z', 'x', 'y'};
+    const char *expected = "abcabcabcabcabcabcaxyzxy";
+    size_t dlen = _z_lz4_decompress(block, sizeof(block), out, sizeof(out));
+    assert(dlen == strlen(expected));
+    assert(memcmp(out, expected, dlen) == 0);
+}
+
+static void test_malformed(void) {
+    printf(">>> Testing malformed blocks...\n");
+    // Match before the start of the output
+    const uint8_t bad_offset[] = {0x10, 'a', 0x02, 0x00, 0x50, 'a', 'a', 'a', 'a', 'a'};
+    assert(_z_lz4_decompress(bad_offset, sizeof(bad_offset), out, sizeof(out)) == SIZE_MAX);
+    // Null offset
+    const uint8_t null_offset[] = {0x10, 'a', 0x00, 0x00, 0x50, 'a', 'a', 'a', 'a', 'a'};
+    assert(_z_lz4_decompress(null_offset, sizeof(null_offset), out, sizeof(out)) == SIZE_MAX);
+    // Literals past the end of the input
+    const uint8_t truncated[] = {0x50, 'a', 'a'};
+    assert(_z_lz4_decompress(truncated, sizeof(truncated), out, sizeof(out)) == SIZE_MAX);
+    // Unterminated length
+    const uint8_t long_length[] = {0xF0, 255, 255};
+    assert(_z_lz4_decompress(long_length, sizeof(long_length), out, sizeof(out)) == SIZE_MAX);
+    // Block ending with a match
+    const uint8_t no_last_literals[] = {0x10, 'a', 0x01, 0x00};
+    assert(_z_lz4_decompress(no_last_literals, sizeof(no_last_literals), out, sizeof(out)) == SIZE_MAX);
+    // Output larger than the destination
+    (void)memset(src, 'a', 1000);
+    size_t clen = _z_lz4_compress(&ctx, src, 1000, cmp, sizeof(cmp));
+    assert(clen > 0);
+    assert(_z_lz4_decompress(cmp, clen, out, 999) == SIZE_MAX);
+    assert(_z_lz4_decompress(cmp, 0, out, sizeof(out)) == SIZE_MAX);
+}
+
+int main(void) {
+    test_redundant();
+    test_small();
+    test_incompressible();
+    test_reference_block();
+    test_malformed();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("transport compression feature not enabled, skipping tests\n");
+    return 0;
+}
+#endif
@@ -1825,11 +1825,19 @@ void join_message(void) {
 }
 
 _z_transport_message_t gen_init(void) {
+    _z_transport_message_t t_msg;
     if (gen_bool()) {
-        return _z_t_msg_make_init_syn(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zid());
+        t_msg = _z_t_msg_make_init_syn(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zid());
     } else {
-        return _z_t_msg_make_init_ack(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zid(), gen_slice(16));
+        t_msg = _z_t_msg_make_init_ack(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zid(), gen_slice(16));
     }
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    if (gen_bool()) {
+        t_msg._body._init._compression = true;
+        _Z_SET_FLAG(t_msg._header, _Z_FLAG_T_Z);
+    }
+#endif
+    return t_msg;
 }
 void assert_eq_init(const _z_t_msg_init_t *left, const _z_t_msg_init_t *right) {
     assert(left->_batch_size == right->_batch_size);
@@ -1839,6 +1847,9 @@ void assert_eq_init(const _z_t_msg_init_t *left, const _z_t_msg_init_t *right) {
     assert(memcmp(left->_zid.id, right->_zid.id, 16) == 0);
     assert(left->_version == right->_version);
     assert(left->_whatami == right->_whatami);
+#if Z_FEATURE_TRANSPORT_COMPRESSION == 1
+    assert(left->_compression == right->_compression);
+#endif
 }
 void init_message(void) {
     printf("\n>> Init message\n");
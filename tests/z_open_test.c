@@ -12,6 +12,7 @@
 //   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
 //
 
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -30,6 +31,12 @@
 #include "zenoh-pico/net/session.h"
 #include "zenoh-pico/transport/transport.h"
 
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1 || Z_FEATURE_LINK_SHM_RING == 1
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
 #define OPEN_TEST_UNUSED_LOCATOR_1 "tcp/127.0.0.1:18101"
 #define OPEN_TEST_UNUSED_LOCATOR_2 "tcp/127.0.0.1:18102"
 #define OPEN_TEST_UNUSED_LOCATOR_3 "tcp/127.0.0.1:18103"
@@ -48,6 +55,11 @@
 #define OPEN_TEST_ST_LOCATOR_2 "tcp/127.0.0.1:18122"
 #define OPEN_TEST_ST_LOCATOR_3 "tcp/127.0.0.1:18123"
 
+#define OPEN_TEST_UNIXSOCK_PATH "/tmp/zenoh-pico-open-test.sock"
+#define OPEN_TEST_UNIXSOCK_LOCATOR "unixsock-stream/" OPEN_TEST_UNIXSOCK_PATH
+#define OPEN_TEST_SHM_RING_PATH "/tmp/zenoh-pico-open-test-shm.sock"
+#define OPEN_TEST_SHM_RING_LOCATOR "shm-ring/" OPEN_TEST_SHM_RING_PATH
+
 // Keep this conservative: busy CI runners may delay executor progress after z_open().
 #define OPEN_TEST_LISTENER_SETTLE_MS 1000
 
@@ -383,6 +395,116 @@ static void test_open_peer_uses_next_connect_locator_for_primary_transport(void)
     z_drop(z_move(s1));
 }
 
+#if (Z_FEATURE_LINK_UNIXSOCK_STREAM == 1 || Z_FEATURE_LINK_SHM_RING == 1) && Z_FEATURE_UNICAST_PEER == 1
+// Leaves a socket file behind as a listener that crashed would
+static void open_test_make_stale_unixsock(const char *path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_TRUE(fd >= 0);
+    (void)unlink(path);
+    ASSERT_TRUE(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+    close(fd);
+}
+
+static bool open_test_path_exists(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f != NULL) {
+        fclose(f);
+        return true;
+    }
+    return errno != ENOENT;
+}
+#endif
+
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1 && Z_FEATURE_UNICAST_PEER == 1
+static void test_open_peer_unixsock_stream(void) {
+    printf("Running test_open_peer_unixsock_stream() ...\n");
+
+    z_owned_config_t c1;
+    z_owned_config_t c2;
+
+    z_config_default(&c1);
+    z_config_default(&c2);
+
+    zp_config_insert(z_loan_mut(c1), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(c1), Z_CONFIG_LISTEN_KEY, OPEN_TEST_UNIXSOCK_LOCATOR);
+
+    zp_config_insert(z_loan_mut(c2), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(c2), Z_CONFIG_CONNECT_KEY, OPEN_TEST_UNIXSOCK_LOCATOR);
+
+    open_test_make_stale_unixsock(OPEN_TEST_UNIXSOCK_PATH);
+    z_owned_session_t s1;
+    ASSERT_OK(z_open(&s1, z_move(c1), NULL));
+    ASSERT_TRUE(open_test_path_exists(OPEN_TEST_UNIXSOCK_PATH));
+    z_owned_session_t *listener_sessions[] = {&s1};
+    open_test_settle_listener(listener_sessions, _ZP_ARRAY_SIZE(listener_sessions));
+
+    open_test_task_t task;
+    open_test_async_open_t ctx;
+    open_test_start_async_open(&task, &ctx, c2, 0);
+    open_test_wait_for_async_open(&ctx, listener_sessions, _ZP_ARRAY_SIZE(listener_sessions), 3000);
+    ASSERT_OK(open_test_task_join(&task));
+    ASSERT_OK(ctx.ret);
+
+    z_owned_session_t *sessions[] = {&s1, &ctx.session};
+    ASSERT_TRUE(open_test_wait_for_peer_count(&s1, 1, sessions, _ZP_ARRAY_SIZE(sessions), 1000));
+
+    z_drop(z_move(ctx.session));
+    z_drop(z_move(s1));
+    // The listener removes its socket file
+    ASSERT_FALSE(open_test_path_exists(OPEN_TEST_UNIXSOCK_PATH));
+}
+#endif
+
+#if Z_FEATURE_LINK_SHM_RING == 1 && Z_FEATURE_UNICAST_PEER == 1
+static void test_open_peer_shm_ring(void) {
+    printf("Running test_open_peer_shm_ring() ...\n");
+
+    z_owned_config_t c1;
+    z_owned_config_t c2;
+
+    z_config_default(&c1);
+    z_config_default(&c2);
+
+    zp_config_insert(z_loan_mut(c1), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(c1), Z_CONFIG_LISTEN_KEY, OPEN_TEST_SHM_RING_LOCATOR);
+
+    zp_config_insert(z_loan_mut(c2), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(c2), Z_CONFIG_CONNECT_KEY, OPEN_TEST_SHM_RING_LOCATOR);
+
+    open_test_make_stale_unixsock(OPEN_TEST_SHM_RING_PATH);
+    z_owned_session_t s1;
+    ASSERT_OK(z_open(&s1, z_move(c1), NULL));
+    z_owned_session_t *listener_sessions[] = {&s1};
+    open_test_settle_listener(listener_sessions, _ZP_ARRAY_SIZE(listener_sessions));
+
+    // The handshake goes through both rings
+    open_test_task_t task;
+    open_test_async_open_t ctx;
+    open_test_start_async_open(&task, &ctx, c2, 0);
+    open_test_wait_for_async_open(&ctx, listener_sessions, _ZP_ARRAY_SIZE(listener_sessions), 3000);
+    ASSERT_OK(open_test_task_join(&task));
+    ASSERT_OK(ctx.ret);
+
+    z_owned_session_t *sessions[] = {&s1, &ctx.session};
+    ASSERT_TRUE(open_test_wait_for_peer_count(&s1, 1, sessions, _ZP_ARRAY_SIZE(sessions), 1000));
+
+    // The listener sees the other side leave
+    z_drop(z_move(ctx.session));
+    z_clock_t start = z_clock_now();
+    while ((open_test_peer_count(&s1) != 0) && (z_clock_elapsed_ms(&start) < 3000)) {
+        open_test_spin_once(&s1);
+        z_sleep_ms(50);
+    }
+    ASSERT_TRUE(open_test_peer_count(&s1) == 0);
+    z_drop(z_move(s1));
+    ASSERT_FALSE(open_test_path_exists(OPEN_TEST_SHM_RING_PATH));
+}
+#endif
+
 #if Z_FEATURE_UNICAST_PEER == 1 && defined(Z_FEATURE_UNSTABLE_API)
 static void _test_open_timeout_partial_connectivity(const char *connect_exit_on_failure, z_result_t expected_ret,
                                                     const char *good_locator, const char *bad_locator) {
@@ -635,6 +757,13 @@ int main(void) {
     test_open_peer_listen_succeeds();
     test_open_peer_uses_next_connect_locator_for_primary_transport();
 
+#if Z_FEATURE_LINK_UNIXSOCK_STREAM == 1 && Z_FEATURE_UNICAST_PEER == 1
+    test_open_peer_unixsock_stream();
+#endif
+#if Z_FEATURE_LINK_SHM_RING == 1 && Z_FEATURE_UNICAST_PEER == 1
+    test_open_peer_shm_ring();
+#endif
+
 #if Z_FEATURE_UNICAST_PEER == 1 && defined(Z_FEATURE_UNSTABLE_API)
     test_open_timeout_partial_connectivity_exit_on_failure_false();
     test_open_timeout_partial_connectivity_exit_on_failure_true();
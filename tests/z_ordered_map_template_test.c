@@ -0,0 +1,276 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#undef NDEBUG
+#include <assert.h>
+
+// ── Instantiate uint32_t -> uint32_t with the default comparison ─────────────
+
+#define _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE uint32_t
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE uint32_t
+#define _ZP_ORDERED_MAP_TEMPLATE_NAME u32omap
+#include "zenoh-pico/collections/ordered_map_template.h"
+
+// ── Instantiate with a reverse comparison and a small level count ────────────
+
+static inline int u32_rcmp(const uint32_t *a, const uint32_t *b) { return (*a < *b) ? 1 : ((*a > *b) ? -1 : 0); }
+
+#define _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE uint32_t
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE uint32_t
+#define _ZP_ORDERED_MAP_TEMPLATE_NAME rev_omap
+#define _ZP_ORDERED_MAP_TEMPLATE_KEY_CMP_FN u32_rcmp
+#define _ZP_ORDERED_MAP_TEMPLATE_MAX_LEVEL 2
+#include "zenoh-pico/collections/ordered_map_template.h"
+
+// ── Instantiate with owning values to check move / destroy semantics ─────────
+
+typedef struct {
+    uint32_t *ptr;
+} box_t;
+
+static size_t g_box_destroyed = 0;
+
+static inline void box_destroy(box_t *b) {
+    if (b->ptr != NULL) {
+        g_box_destroyed++;
+        free(b->ptr);
+        b->ptr = NULL;
+    }
+}
+
+static inline void box_move(box_t *dst, box_t *src) {
+    dst->ptr = src->ptr;
+    src->ptr = NULL;
+}
+
+static box_t box_make(uint32_t v) {
+    box_t b;
+    b.ptr = (uint32_t *)malloc(sizeof(uint32_t));
+    assert(b.ptr != NULL);
+    *b.ptr = v;
+    return b;
+}
+
+#define _ZP_ORDERED_MAP_TEMPLATE_KEY_TYPE uint32_t
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_TYPE box_t
+#define _ZP_ORDERED_MAP_TEMPLATE_NAME box_omap
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_DESTROY_FN box_destroy
+#define _ZP_ORDERED_MAP_TEMPLATE_VAL_MOVE_FN box_move
+#include "zenoh-pico/collections/ordered_map_template.h"
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void test_empty(void) {
+    u32omap_t map = u32omap_new();
+    uint32_t k = 1;
+    assert(u32omap_size(&map) == 0);
+    assert(u32omap_is_empty(&map));
+    assert(u32omap_get(&map, &k) == NULL);
+    assert(!u32omap_contains(&map, &k));
+    assert(!u32omap_remove(&map, &k, NULL));
+    assert(!u32omap_pop_first(&map, NULL, NULL));
+    assert(u32omap_front(&map) == NULL);
+    assert(u32omap_begin(&map) == u32omap_end(&map));
+    assert(u32omap_lower_bound(&map, &k) == u32omap_end(&map));
+    u32omap_destroy(&map);
+    printf("test_empty: OK\n");
+}
+
+static void test_insert_get_replace(void) {
+    u32omap_t map = u32omap_new();
+    uint32_t keys[] = {5, 1, 9, 3, 7};
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+        uint32_t k = keys[i];
+        uint32_t v = keys[i] * 10;
+        u32omap_iter_t it = u32omap_insert(&map, &k, &v);
+        assert(it != u32omap_end(&map));
+        assert(u32omap_at(&map, it)->key == keys[i]);
+    }
+    assert(u32omap_size(&map) == 5);
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+        uint32_t *v = u32omap_get(&map, &keys[i]);
+        assert(v != NULL && *v == keys[i] * 10);
+    }
+    uint32_t absent = 4;
+    assert(u32omap_get(&map, &absent) == NULL);
+
+    // Replacing keeps the size and updates the value
+    uint32_t k = 9;
+    uint32_t v = 99;
+    u32omap_insert(&map, &k, &v);
+    assert(u32omap_size(&map) == 5);
+    assert(*u32omap_get(&map, &k) == 99);
+
+    // lower_bound finds the first key not less than the probe
+    assert(u32omap_at(&map, u32omap_lower_bound(&map, &absent))->key == 5);
+    k = 10;
+    assert(u32omap_lower_bound(&map, &k) == u32omap_end(&map));
+    k = 0;
+    assert(u32omap_at(&map, u32omap_lower_bound(&map, &k))->key == 1);
+
+    u32omap_destroy(&map);
+    assert(u32omap_is_empty(&map));
+    printf("test_insert_get_replace: OK\n");
+}
+
+static void test_order_and_removal(void) {
+    enum { N = 5000 };
+    static bool present[N];
+    memset(present, 0, sizeof(present));
+    u32omap_t map = u32omap_new();
+    size_t expected = 0;
+    for (size_t i = 0; i < 4 * N; i++) {
+        uint32_t k = rng_next() % N;
+        uint32_t v = k + 1;
+        if (rng_next() % 3 == 0) {
+            uint32_t out = 0;
+            bool removed = u32omap_remove(&map, &k, &out);
+            assert(removed == present[k]);
+            if (removed) {
+                assert(out == k + 1);
+                present[k] = false;
+                expected--;
+            }
+        } else {
+            assert(u32omap_insert(&map, &k, &v) != u32omap_end(&map));
+            if (!present[k]) {
+                present[k] = true;
+                expected++;
+            }
+        }
+    }
+    assert(u32omap_size(&map) == expected);
+
+    // In-order traversal visits exactly the present keys, in increasing order
+    size_t visited = 0;
+    uint32_t prev = 0;
+    for (u32omap_iter_t it = u32omap_begin(&map); it != u32omap_end(&map); it = u32omap_iter_next(&map, it)) {
+        u32omap_elem_t *e = u32omap_at(&map, it);
+        assert(present[e->key]);
+        assert(e->val == e->key + 1);
+        assert(visited == 0 || e->key > prev);
+        prev = e->key;
+        visited++;
+    }
+    assert(visited == expected);
+
+    // Draining from the front yields the same sequence
+    uint32_t key;
+    uint32_t val;
+    size_t popped = 0;
+    bool first = true;
+    while (u32omap_pop_first(&map, &key, &val)) {
+        assert(present[key]);
+        assert(val == key + 1);
+        assert(first || key > prev);
+        prev = key;
+        first = false;
+        popped++;
+    }
+    assert(popped == expected);
+    assert(u32omap_is_empty(&map));
+    assert(u32omap_begin(&map) == u32omap_end(&map));
+
+    // The map is still usable once drained
+    key = 42;
+    val = 43;
+    assert(u32omap_insert(&map, &key, &val) != u32omap_end(&map));
+    assert(*u32omap_get(&map, &key) == 43);
+    u32omap_destroy(&map);
+    printf("test_order_and_removal: OK\n");
+}
+
+static void test_custom_cmp(void) {
+    rev_omap_t map = rev_omap_new();
+    // Ascending insertion with only two levels still produces a valid, reversed order
+    for (uint32_t i = 0; i < 1000; i++) {
+        uint32_t k = i;
+        uint32_t v = i;
+        assert(rev_omap_insert(&map, &k, &v) != rev_omap_end(&map));
+    }
+    uint32_t expected = 999;
+    for (rev_omap_iter_t it = rev_omap_begin(&map); it != rev_omap_end(&map); it = rev_omap_iter_next(&map, it)) {
+        assert(rev_omap_at(&map, it)->key == expected);
+        expected--;
+    }
+    assert(rev_omap_front(&map)->key == 999);
+    uint32_t k = 500;
+    assert(rev_omap_remove(&map, &k, NULL));
+    assert(rev_omap_at(&map, rev_omap_lower_bound(&map, &k))->key == 499);
+    rev_omap_destroy(&map);
+    printf("test_custom_cmp: OK\n");
+}
+
+static void test_move_and_destroy(void) {
+    g_box_destroyed = 0;
+    box_omap_t map = box_omap_new();
+    for (uint32_t i = 0; i < 10; i++) {
+        uint32_t k = i;
+        box_t b = box_make(i);
+        assert(box_omap_insert(&map, &k, &b) != box_omap_end(&map));
+        assert(b.ptr == NULL);  // moved in
+    }
+    // Replacing destroys the previous value
+    uint32_t k = 3;
+    box_t b = box_make(33);
+    box_omap_insert(&map, &k, &b);
+    assert(g_box_destroyed == 1);
+    assert(*box_omap_get(&map, &k)->ptr == 33);
+
+    // Removing into out_val moves the value out
+    box_t out = {NULL};
+    assert(box_omap_remove(&map, &k, &out));
+    assert(g_box_destroyed == 1);
+    assert(*out.ptr == 33);
+    box_destroy(&out);
+    assert(g_box_destroyed == 2);
+
+    // Removing without out_val destroys it
+    k = 4;
+    assert(box_omap_remove(&map, &k, NULL));
+    assert(g_box_destroyed == 3);
+
+    // pop_first without outputs destroys the entry
+    assert(box_omap_pop_first(&map, NULL, NULL));
+    assert(g_box_destroyed == 4);
+
+    // destroy releases every remaining entry
+    size_t remaining = box_omap_size(&map);
+    box_omap_destroy(&map);
+    assert(g_box_destroyed == 4 + remaining);
+    assert(box_omap_is_empty(&map));
+    printf("test_move_and_destroy: OK\n");
+}
+
+int main(void) {
+    test_empty();
+    test_insert_get_replace();
+    test_order_and_removal();
+    test_custom_cmp();
+    test_move_and_destroy();
+    return 0;
+}
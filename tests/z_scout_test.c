@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/config.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_SCOUTING == 1 && Z_FEATURE_MULTI_THREAD == 1 && defined(ZENOH_LINUX)
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "zenoh-pico/collections/atomic.h"
+#include "zenoh-pico/protocol/codec/transport.h"
+#include "zenoh-pico/protocol/definitions/transport.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/system/platform.h"
+
+#define SCOUT_TEST_BASE_PORT 18301
+// Nothing listens on this one
+#define SCOUT_TEST_SILENT_PORT 18309
+#define RESPONDER_NB 3
+
+// Fake nodes answering the scout messages sent to 127.0.0.1 with a hello, the last two are the same node
+typedef struct {
+    int _fd[RESPONDER_NB];
+    uint8_t _zid[RESPONDER_NB];
+    _z_atomic_bool_t _stop;
+    pthread_t _thread;
+} responders_t;
+
+static responders_t responders;
+
+static void responder_reply(int fd, uint8_t zid_byte) {
+    uint8_t buf[256];
+    struct sockaddr_in from;
+    socklen_t from_len = sizeof(from);
+    ssize_t rb = recvfrom(fd, buf, sizeof(buf), 0, (struct sockaddr *)&from, &from_len);
+    if (rb <= 0) {
+        return;
+    }
+    _z_id_t zid = {0};
+    zid.id[0] = zid_byte;
+    _z_scouting_message_t hello = _z_s_msg_make_hello(Z_WHATAMI_ROUTER, zid, _z_locator_array_empty());
+    _z_wbuf_t wbf = _z_wbuf_make(sizeof(buf), false);
+    assert(_z_scouting_message_encode(&wbf, &hello) == _Z_RES_OK);
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+    size_t len = _z_zbuf_len(&zbf);
+    assert(sendto(fd, _z_zbuf_get_rptr(&zbf), len, 0, (struct sockaddr *)&from, from_len) == (ssize_t)len);
+    _z_zbuf_clear(&zbf);
+    _z_wbuf_clear(&wbf);
+    _z_s_msg_clear(&hello);
+}
+
+static void *responders_run(void *arg) {
+    responders_t *r = (responders_t *)arg;
+    while (!_z_atomic_bool_load(&r->_stop, _z_memory_order_acquire)) {
+        struct pollfd pfds[RESPONDER_NB];
+        for (size_t i = 0; i < RESPONDER_NB; i++) {
+            pfds[i] = (struct pollfd){.fd = r->_fd[i], .events = POLLIN, .revents = 0};
+        }
+        if (poll(pfds, RESPONDER_NB, 50) <= 0) {
+            continue;
+        }
+        for (size_t i = 0; i < RESPONDER_NB; i++) {
+            if ((pfds[i].revents & POLLIN) != 0) {
+                responder_reply(r->_fd[i], r->_zid[i]);
+            }
+        }
+    }
+    return NULL;
+}
+
+static void responders_start(void) {
+    const uint8_t zids[RESPONDER_NB] = {1, 2, 2};
+    for (size_t i = 0; i < RESPONDER_NB; i++) {
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        assert(fd >= 0);
+        struct sockaddr_in addr = {0};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)(SCOUT_TEST_BASE_PORT + i));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        assert(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+        responders._fd[i] = fd;
+        responders._zid[i] = zids[i];
+    }
+    _z_atomic_bool_init(&responders._stop, false);
+    assert(pthread_create(&responders._thread, NULL, responders_run, &responders) == 0);
+}
+
+static void responders_stop(void) {
+    _z_atomic_bool_store(&responders._stop, true, _z_memory_order_release);
+    assert(pthread_join(responders._thread, NULL) == 0);
+    for (size_t i = 0; i < RESPONDER_NB; i++) {
+        close(responders._fd[i]);
+    }
+}
+
+static void locators_add(_z_string_svec_t *locators, uint16_t port) {
+    char locator[64];
+    (void)snprintf(locator, sizeof(locator), "udp/127.0.0.1:%u", (unsigned)port);
+    _z_string_t s = _z_string_copy_from_str(locator);
+    assert(_z_string_svec_append(locators, &s, true) == _Z_RES_OK);
+}
+
+// Shared by all the scouting rounds, as a session does for its reconnections
+static _z_zbuf_t scout_zbf;
+
+static _z_hello_slist_t *scout(const _z_string_svec_t *locators, uint32_t timeout, bool exit_on_first,
+                               unsigned long *elapsed) {
+    _z_id_t zid = {0};
+    zid.id[0] = 0xFF;
+    z_clock_t start = z_clock_now();
+    _z_hello_slist_t *hellos = _z_scout_inner(Z_WHAT_ROUTER_PEER, zid, locators, timeout, exit_on_first, &scout_zbf);
+    *elapsed = z_clock_elapsed_ms(&start);
+    return hellos;
+}
+
+static void test_several_locators(void) {
+    printf(">>> Testing scouting on several locators...\n");
+    _z_string_svec_t locators = _z_string_svec_make(RESPONDER_NB + 1);
+    for (uint16_t i = 0; i < RESPONDER_NB; i++) {
+        locators_add(&locators, (uint16_t)(SCOUT_TEST_BASE_PORT + i));
+    }
+    locators_add(&locators, SCOUT_TEST_SILENT_PORT);
+
+    unsigned long elapsed;
+    _z_hello_slist_t *hellos = scout(&locators, 500, false, &elapsed);
+    // Every responder answered, the node reached on two locators is reported once
+    assert(_z_hello_slist_len(hellos) == 2);
+    bool seen[3] = {false, false, false};
+    for (_z_hello_slist_t *it = hellos; it != NULL; it = _z_hello_slist_next(it)) {
+        uint8_t id = _z_hello_slist_value(it)->_zid.id[0];
+        assert((id == 1) || (id == 2));
+        assert(!seen[id]);
+        seen[id] = true;
+    }
+    // Without exit_on_first the whole period is waited for
+    assert(elapsed >= 500);
+    _z_hello_slist_free(&hellos);
+    _z_string_svec_clear(&locators);
+}
+
+static void test_exit_on_first(void) {
+    printf(">>> Testing early exit on the first hello...\n");
+    _z_string_svec_t locators = _z_string_svec_make(2);
+    locators_add(&locators, SCOUT_TEST_SILENT_PORT);
+    locators_add(&locators, SCOUT_TEST_BASE_PORT);
+
+    // The buffer of the previous round is reused
+    const uint8_t *buf = scout_zbf._ios._buf;
+    assert(buf != NULL);
+    unsigned long elapsed;
+    _z_hello_slist_t *hellos = scout(&locators, 5000, true, &elapsed);
+    assert(scout_zbf._ios._buf == buf);
+    assert(_z_hello_slist_len(hellos) == 1);
+    assert(_z_hello_slist_value(hellos)->_zid.id[0] == 1);
+    // Returns with the hello rather than at the end of the period
+    assert(elapsed < 1000);
+    _z_hello_slist_free(&hellos);
+    _z_string_svec_clear(&locators);
+}
+
+static void test_no_responder(void) {
+    printf(">>> Testing the timeout without any responder...\n");
+    _z_string_svec_t locators = _z_string_svec_make(1);
+    locators_add(&locators, SCOUT_TEST_SILENT_PORT);
+
+    unsigned long elapsed;
+    _z_hello_slist_t *hellos = scout(&locators, 300, true, &elapsed);
+    assert(hellos == NULL);
+    assert(elapsed >= 300);
+    assert(elapsed < 300 + 2 * Z_CONFIG_SOCKET_TIMEOUT + 200);
+    _z_string_svec_clear(&locators);
+}
+
+int main(void) {
+    scout_zbf = _z_zbuf_null();
+    responders_start();
+    test_several_locators();
+    test_exit_on_first();
+    test_no_responder();
+    responders_stop();
+    _z_zbuf_clear(&scout_zbf);
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Scouting not enabled, skipping tests\n");
+    return 0;
+}
+#endif
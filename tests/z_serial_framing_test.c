@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/config.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_LINK_SERIAL == 1 && Z_FEATURE_MULTI_THREAD == 1 && defined(ZENOH_LINUX)
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "zenoh-pico/link/endpoint.h"
+#include "zenoh-pico/link/transport/serial_protocol.h"
+#include "zenoh-pico/protocol/codec/serial.h"
+#include "zenoh-pico/system/platform.h"
+
+#define BENCH_FRAMES 2000
+#define BENCH_BURST 4
+#define BENCH_MAX_LEN 1000
+
+static int master_fd = -1;
+static _z_serial_socket_t sock;
+static uint8_t payload[_Z_SERIAL_MTU_SIZE];
+static uint8_t out[_Z_SERIAL_MTU_SIZE];
+
+// Frames of len bytes whose content depends on seed, so that a frame read in place of another is noticed
+static size_t make_frame(uint8_t *dst, size_t dst_len, size_t len, uint8_t seed) {
+    uint8_t tmp[_Z_SERIAL_MFS_SIZE];
+    for (size_t i = 0; i < len; i++) {
+        payload[i] = (uint8_t)(seed + i);
+    }
+    size_t raw_len = _z_serial_msg_serialize(dst, dst_len, payload, len, 0, tmp, sizeof(tmp));
+    assert(raw_len != SIZE_MAX);
+    return raw_len;
+}
+
+static void write_master(const uint8_t *ptr, size_t len) {
+    size_t n = 0;
+    while (n < len) {
+        ssize_t wb = write(master_fd, &ptr[n], len - n);
+        assert(wb > 0);
+        n += (size_t)wb;
+    }
+}
+
+static void expect_frame(size_t len, uint8_t seed) {
+    size_t rb = _z_read_serial(&sock, out, sizeof(out));
+    assert(rb == len);
+    for (size_t i = 0; i < len; i++) {
+        assert(out[i] == (uint8_t)(seed + i));
+    }
+}
+
+static void open_link(void) {
+    master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    assert(master_fd >= 0);
+    assert(grantpt(master_fd) == 0);
+    assert(unlockpt(master_fd) == 0);
+    char locator[128];
+    (void)snprintf(locator, sizeof(locator), "serial/%s#baudrate=115200", ptsname(master_fd));
+
+    _z_endpoint_t ep;
+    _z_string_t str = _z_string_alias_str(locator);
+    assert(_z_endpoint_from_string(&ep, &str) == _Z_RES_OK);
+    // Listening skips the connection handshake, the frames written on the master side are read as they come
+    assert(_z_serial_protocol_listen(&sock, &ep) == _Z_RES_OK);
+    _z_endpoint_clear(&ep);
+}
+
+static void close_link(void) {
+    _z_serial_protocol_close(&sock);
+    close(master_fd);
+}
+
+static void test_frames_per_read(void) {
+    printf(">>> Testing several frames per read...\n");
+    uint8_t raw[3 * _Z_SERIAL_MAX_COBS_BUF_SIZE];
+    size_t len = 0;
+    len += make_frame(&raw[len], sizeof(raw) - len, 10, 1);
+    len += make_frame(&raw[len], sizeof(raw) - len, 300, 2);
+    len += make_frame(&raw[len], sizeof(raw) - len, 1, 3);
+    write_master(raw, len);
+    expect_frame(10, 1);
+    expect_frame(300, 2);
+    expect_frame(1, 3);
+}
+
+static void test_frame_split_across_reads(void) {
+    printf(">>> Testing a frame split across reads...\n");
+    uint8_t raw[2 * _Z_SERIAL_MAX_COBS_BUF_SIZE];
+    size_t first = make_frame(raw, sizeof(raw), 20, 4);
+    size_t second = make_frame(&raw[first], sizeof(raw) - first, _Z_SERIAL_MTU_SIZE, 5);
+    // The read of the first frame also takes the start of the second one
+    write_master(raw, first + second / 2);
+    expect_frame(20, 4);
+    write_master(&raw[first + second / 2], second - second / 2);
+    expect_frame(_Z_SERIAL_MTU_SIZE, 5);
+}
+
+static void test_resync_after_garbage(void) {
+    printf(">>> Testing resynchronization after garbage...\n");
+    uint8_t raw[4 * _Z_SERIAL_MAX_COBS_BUF_SIZE];
+    // A corrupted frame, then more bytes than the largest frame without any delimiter
+    size_t len = make_frame(raw, sizeof(raw), 50, 6);
+    raw[len / 2] ^= 0x55;
+    (void)memset(&raw[len], 0xAA, 2 * _Z_SERIAL_MAX_COBS_BUF_SIZE);
+    len += 2 * _Z_SERIAL_MAX_COBS_BUF_SIZE;
+    raw[len++] = 0x00;
+    len += make_frame(&raw[len], sizeof(raw) - len, 100, 7);
+    write_master(raw, len);
+
+    size_t rejected = 0;
+    size_t rb;
+    while ((rb = _z_read_serial(&sock, out, sizeof(out))) == SIZE_MAX) {
+        rejected++;
+        assert(rejected < 8);
+    }
+    assert(rejected > 0);
+    assert(rb == 100);
+    for (size_t i = 0; i < rb; i++) {
+        assert(out[i] == (uint8_t)(7 + i));
+    }
+    // The link keeps working afterwards
+    len = make_frame(raw, sizeof(raw), 8, 8);
+    write_master(raw, len);
+    expect_frame(8, 8);
+}
+
+static size_t bench_len(size_t i) { return 1 + (i * 37) % BENCH_MAX_LEN; }
+
+static void *bench_writer(void *arg) {
+    (void)arg;
+    static uint8_t raw[BENCH_BURST * _Z_SERIAL_MAX_COBS_BUF_SIZE];
+    for (size_t i = 0; i < BENCH_FRAMES; i += BENCH_BURST) {
+        size_t len = 0;
+        for (size_t j = i; (j < i + BENCH_BURST) && (j < BENCH_FRAMES); j++) {
+            len += make_frame(&raw[len], sizeof(raw) - len, bench_len(j), (uint8_t)j);
+        }
+        write_master(raw, len);
+    }
+    return NULL;
+}
+
+static void test_bench(void) {
+    printf(">>> Benchmarking frame reads...\n");
+    pthread_t writer;
+    z_clock_t start = z_clock_now();
+    assert(pthread_create(&writer, NULL, bench_writer, NULL) == 0);
+    size_t bytes = 0;
+    for (size_t i = 0; i < BENCH_FRAMES; i++) {
+        size_t rb = _z_read_serial(&sock, out, sizeof(out));
+        assert(rb == bench_len(i));
+        assert((out[0] == (uint8_t)i) && (out[rb - 1] == (uint8_t)(i + rb - 1)));
+        bytes += rb;
+    }
+    assert(pthread_join(writer, NULL) == 0);
+    unsigned long elapsed = z_clock_elapsed_ms(&start);
+    printf("    %d frames, %zu bytes in %lu ms\n", BENCH_FRAMES, bytes, elapsed);
+}
+
+int main(void) {
+    open_link();
+    test_frames_per_read();
+    test_frame_split_across_reads();
+    test_resync_after_garbage();
+    test_bench();
+    close_link();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Serial links not enabled, skipping tests\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/link/transport/socket.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_IO_URING == 1
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+// More sockets than the ring holds, so that sends are submitted in several rounds
+#define SOCKET_NB 100
+#define PAYLOAD_LEN 4096
+
+typedef struct {
+    _z_sys_net_socket_t *socks;
+    size_t len;
+} test_sockets_t;
+
+static void test_iter_reset(_z_socket_wait_iter_t *iter) { iter->_current_entry = NULL; }
+
+static bool test_iter_next(_z_socket_wait_iter_t *iter) {
+    test_sockets_t *ctx = (test_sockets_t *)iter->_ctx;
+    _z_sys_net_socket_t *next = (iter->_current_entry == NULL) ? ctx->socks
+                                                               : (_z_sys_net_socket_t *)iter->_current_entry + 1;
+    iter->_current_entry = (next < ctx->socks + ctx->len) ? next : NULL;
+    return iter->_current_entry != NULL;
+}
+
+static const _z_sys_net_socket_t *test_iter_get_socket(const _z_socket_wait_iter_t *iter) {
+    return (const _z_sys_net_socket_t *)iter->_current_entry;
+}
+
+static _z_socket_wait_iter_t test_iter(test_sockets_t *ctx) {
+    _z_socket_wait_iter_t iter = {
+        ._ctx = ctx,
+        ._current_entry = NULL,
+        ._reset = test_iter_reset,
+        ._next = test_iter_next,
+        ._get_socket = test_iter_get_socket,
+        ._set_ready = NULL,
+    };
+    return iter;
+}
+
+static void test_send_all(_z_socket_uring_t *ring) {
+    printf(">>> Testing send to %d sockets...\n", SOCKET_NB);
+    _z_sys_net_socket_t senders[SOCKET_NB];
+    int receivers[SOCKET_NB];
+    for (size_t i = 0; i < SOCKET_NB; i++) {
+        int fds[2];
+        assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        senders[i]._fd = fds[0];
+        receivers[i] = fds[1];
+        assert(_z_socket_set_blocking(&senders[i], false) == _Z_RES_OK);
+    }
+    // A peer gone away must not prevent the others from receiving
+    close(receivers[SOCKET_NB / 2]);
+    receivers[SOCKET_NB / 2] = -1;
+
+    uint8_t payload[PAYLOAD_LEN];
+    for (size_t i = 0; i < PAYLOAD_LEN; i++) {
+        payload[i] = (uint8_t)(i * 7);
+    }
+    test_sockets_t ctx = {.socks = senders, .len = SOCKET_NB};
+    _z_socket_wait_iter_t iter = test_iter(&ctx);
+    for (int round = 0; round < 2; round++) {
+        assert(_z_socket_uring_send_all(ring, &iter, payload, PAYLOAD_LEN) == _Z_RES_OK);
+    }
+
+    uint8_t buf[2 * PAYLOAD_LEN];
+    for (size_t i = 0; i < SOCKET_NB; i++) {
+        if (receivers[i] >= 0) {
+            size_t n = 0;
+            while (n < sizeof(buf)) {
+                ssize_t rb = recv(receivers[i], buf + n, sizeof(buf) - n, 0);
+                assert(rb > 0);
+                n += (size_t)rb;
+            }
+            assert(memcmp(buf, payload, PAYLOAD_LEN) == 0);
+            assert(memcmp(buf + PAYLOAD_LEN, payload, PAYLOAD_LEN) == 0);
+            close(receivers[i]);
+        }
+        close(senders[i]._fd);
+    }
+}
+
+static void test_send_none(_z_socket_uring_t *ring) {
+    printf(">>> Testing send without sockets...\n");
+    uint8_t payload[1] = {0};
+    test_sockets_t ctx = {.socks = NULL, .len = 0};
+    _z_socket_wait_iter_t iter = test_iter(&ctx);
+    assert(_z_socket_uring_send_all(ring, &iter, payload, sizeof(payload)) == _Z_RES_OK);
+}
+
+int main(void) {
+    _z_socket_uring_t *ring = NULL;
+    if (_z_socket_uring_new(&ring) != _Z_RES_OK) {
+        printf("io_uring not available on this kernel, skipping tests\n");
+        return 0;
+    }
+    test_send_all(ring);
+    test_send_none(ring);
+    _z_socket_uring_free(&ring);
+    assert(ring == NULL);
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("io_uring feature not enabled, skipping tests\n");
+    return 0;
+}
+#endif
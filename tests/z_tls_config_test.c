@@ -24,6 +24,7 @@
 #if Z_FEATURE_LINK_TLS == 1
 
 #include "mbedtls/base64.h"
+#include "zenoh-pico/link/transport/tls_stream.h"
 
 static const char SERVER_CA_PEM[] =
     "-----BEGIN CERTIFICATE-----\n"
@@ -143,6 +144,15 @@ static void tls_sample_handler(z_loaned_sample_t *sample, void *ctx) {
     z_drop(z_move(payload));
 }
 
+static z_result_t open_tls_client(z_owned_session_t *client, const char *locator, const char *ca_base64) {
+    z_owned_config_t connect_cfg;
+    z_config_default(&connect_cfg);
+    zp_config_insert(z_loan_mut(connect_cfg), Z_CONFIG_CONNECT_KEY, locator);
+    zp_config_insert(z_loan_mut(connect_cfg), Z_CONFIG_TLS_ROOT_CA_CERTIFICATE_BASE64_KEY, ca_base64);
+    zp_config_insert(z_loan_mut(connect_cfg), Z_CONFIG_TLS_VERIFY_NAME_ON_CONNECT_KEY, "false");
+    return z_open(client, z_move(connect_cfg), NULL);
+}
+
 int main(void) {
     char locator_buf[64];
     snprintf(locator_buf, sizeof(locator_buf), "tls/127.0.0.1:7447");
@@ -150,6 +160,7 @@ int main(void) {
     static const char *const keyexpr_str = "test/tls/config";
     static const char *const payload_str = "tls-config-ok";
 
+    bool resumed = false;
     char *ca_base64 = encode_base64_strdup(SERVER_CA_PEM);
     char *cert_base64 = encode_base64_strdup(SERVER_CERT_PEM);
     char *key_base64 = encode_base64_strdup(SERVER_KEY_PEM);
@@ -194,14 +205,8 @@ int main(void) {
         goto cleanup_server;
     }
 
-    z_owned_config_t connect_cfg;
-    z_config_default(&connect_cfg);
-    zp_config_insert(z_loan_mut(connect_cfg), Z_CONFIG_CONNECT_KEY, locator);
-    zp_config_insert(z_loan_mut(connect_cfg), Z_CONFIG_TLS_ROOT_CA_CERTIFICATE_BASE64_KEY, ca_base64);
-    zp_config_insert(z_loan_mut(connect_cfg), Z_CONFIG_TLS_VERIFY_NAME_ON_CONNECT_KEY, "false");
-
     z_owned_session_t client;
-    res = z_open(&client, z_move(connect_cfg), NULL);
+    res = open_tls_client(&client, locator, ca_base64);
     if (res != Z_OK) {
         fprintf(stderr, "client z_open failed: %d\n", res);
         return 1;
@@ -238,6 +243,26 @@ int main(void) {
         fprintf(stderr, "subscriber: did not receive payload\n");
     }
 
+    // A new connection to the same peer with the same configuration resumes the session saved by the previous one
+    if (z_internal_check(publisher)) {
+        z_drop(z_move(publisher));
+    }
+    z_session_drop(z_session_move(&client));
+    (void)z_sleep_ms(50);
+    size_t resumed_before = _z_tls_resumed_handshakes();
+    res = open_tls_client(&client, locator, ca_base64);
+    if (res != Z_OK) {
+        fprintf(stderr, "client z_open on reconnection failed: %d\n", res);
+        goto cleanup_client;
+    }
+    for (int i = 0; (i < 200) && !resumed; ++i) {
+        resumed = _z_tls_resumed_handshakes() > resumed_before;
+        z_sleep_ms(10);
+    }
+    if (!resumed) {
+        fprintf(stderr, "client: TLS session was not resumed on reconnection\n");
+    }
+
 cleanup_pub:
     if (z_internal_check(publisher)) {
         z_drop(z_move(publisher));
@@ -260,7 +285,7 @@ cleanup_buffers:
     if (ca_base64 != NULL) {
         free(ca_base64);
     }
-    return g_received ? 0 : 1;
+    return (g_received && resumed) ? 0 : 1;
 }
 
 #else
@@ -0,0 +1,277 @@
+//
+// Copyright (c) 2026 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Checks that a put whose payload is written in a lent tx buffer produces the same bytes on the link as a regular put.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/net/primitives.h"
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/common/tx.h"
+#include "zenoh-pico/transport/utils.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_PUBLICATION == 1
+
+#define TEST_BATCH_SIZE 256
+#define TEST_CAPTURE_SIZE 8192
+
+typedef struct {
+    uint8_t data[TEST_CAPTURE_SIZE];
+    size_t len;
+    size_t writes;
+} capture_t;
+
+static capture_t g_capture;
+static _z_session_t g_session;
+static _z_link_t g_link;
+static _z_declared_keyexpr_t g_keyexpr;
+
+static size_t capture_write(const _z_link_t *self, const uint8_t *ptr, size_t len, _z_sys_net_socket_t *socket) {
+    _ZP_UNUSED(self);
+    _ZP_UNUSED(socket);
+    assert(g_capture.len + len <= TEST_CAPTURE_SIZE);
+    memcpy(g_capture.data + g_capture.len, ptr, len);
+    g_capture.len += len;
+    g_capture.writes++;
+    return len;
+}
+
+static _z_transport_common_t *common(void) { return &g_session._tp._transport._unicast._common; }
+
+static void setup(void) {
+    memset(&g_session, 0, sizeof(g_session));
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    assert(_z_session_init(&g_session, &zid) == _Z_RES_OK);
+    g_session._mode = Z_WHATAMI_CLIENT;
+    g_session._tp._type = _Z_TRANSPORT_UNICAST_TYPE;
+
+    memset(&g_link, 0, sizeof(g_link));
+    g_link._write_f = capture_write;
+    g_link._mtu = TEST_BATCH_SIZE;
+    g_link._cap._flow = Z_LINK_CAP_FLOW_DATAGRAM;
+
+    _z_transport_common_t *ztc = common();
+    ztc->_link = &g_link;
+    ztc->_wbuf = _z_wbuf_make(TEST_BATCH_SIZE, false);
+    ztc->_sn_res = _z_sn_max(Z_SN_RESOLUTION);
+#if Z_FEATURE_MULTI_THREAD == 1
+    assert(_z_mutex_init(&ztc->_mutex_tx) == _Z_RES_OK);
+    assert(_z_mutex_rec_init(&ztc->_mutex_peer) == _Z_RES_OK);
+#endif
+    g_keyexpr = _z_declared_keyexpr_alias_from_str("zenoh-pico/tests/tx/loan");
+}
+
+static void cleanup(void) {
+    _z_transport_common_t *ztc = common();
+    _z_wbuf_clear(&ztc->_wbuf);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_drop(&ztc->_mutex_tx);
+    _z_mutex_rec_drop(&ztc->_mutex_peer);
+#endif
+    ztc->_link = NULL;
+    g_session._tp._type = _Z_TRANSPORT_NONE;
+    _z_session_clear(&g_session);
+}
+
+static void capture_reset(void) {
+    g_capture.len = 0;
+    g_capture.writes = 0;
+}
+
+static void fill_payload(uint8_t *buf, size_t len, uint8_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(seed + i);
+    }
+}
+
+static void write_regular(size_t len, uint8_t seed) {
+    uint8_t *data = (uint8_t *)z_malloc(len + 1);
+    assert(data != NULL);
+    fill_payload(data, len, seed);
+    _z_bytes_t payload;
+    assert(_z_bytes_from_buf(&payload, data, len) == _Z_RES_OK);
+    _z_encoding_t encoding = _z_encoding_null();
+    _z_timestamp_t ts = _z_timestamp_null();
+    assert(_z_write(&g_session, &g_keyexpr, &payload, &encoding, Z_SAMPLE_KIND_PUT, Z_CONGESTION_CONTROL_BLOCK,
+                    Z_PRIORITY_DEFAULT, false, &ts, NULL, Z_RELIABILITY_RELIABLE, NULL,
+                    Z_LOCALITY_REMOTE) == _Z_RES_OK);
+    _z_bytes_drop(&payload);
+    z_free(data);
+}
+
+static z_result_t loan(_z_transport_tx_loan_t *tx_loan, size_t len) {
+    _z_encoding_t encoding = _z_encoding_null();
+    _z_timestamp_t ts = _z_timestamp_null();
+    return _z_write_loan(&g_session, &g_keyexpr, len, &encoding, Z_CONGESTION_CONTROL_BLOCK, Z_PRIORITY_DEFAULT, false,
+                         &ts, NULL, Z_RELIABILITY_RELIABLE, NULL, tx_loan);
+}
+
+static void write_loaned(size_t len, uint8_t seed) {
+    _z_transport_tx_loan_t tx_loan;
+    assert(loan(&tx_loan, len) == _Z_RES_OK);
+    assert(tx_loan._buf != NULL);
+    fill_payload(tx_loan._buf, len, seed);
+    assert(_z_send_n_msg_loan_commit(&tx_loan) == _Z_RES_OK);
+}
+
+// Runs the same sequence of puts through the regular and the loaned path from the same sequence number
+static void check_same_bytes(const size_t *lens, size_t n, bool batched, size_t *writes) {
+    static capture_t expected;
+    _z_transport_common_t *ztc = common();
+    _z_zint_t sn = ztc->_sn_tx_reliable;
+
+    capture_reset();
+#if Z_FEATURE_BATCHING == 1
+    if (batched) {
+        assert(_z_transport_start_batching(&g_session._tp) == _Z_RES_OK);
+    }
+#endif
+    for (size_t i = 0; i < n; i++) {
+        write_regular(lens[i], (uint8_t)i);
+    }
+#if Z_FEATURE_BATCHING == 1
+    if (batched) {
+        assert(_z_send_n_batch(&g_session, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+        assert(_z_transport_stop_batching(&g_session._tp) == _Z_RES_OK);
+    }
+#endif
+    expected = g_capture;
+    _z_zint_t next_sn = ztc->_sn_tx_reliable;
+
+    ztc->_sn_tx_reliable = sn;
+    capture_reset();
+#if Z_FEATURE_BATCHING == 1
+    if (batched) {
+        assert(_z_transport_start_batching(&g_session._tp) == _Z_RES_OK);
+    }
+#endif
+    for (size_t i = 0; i < n; i++) {
+        // Mix both paths in a batch
+        if (batched && (i % 2 == 0)) {
+            write_regular(lens[i], (uint8_t)i);
+        } else {
+            write_loaned(lens[i], (uint8_t)i);
+        }
+    }
+#if Z_FEATURE_BATCHING == 1
+    if (batched) {
+        assert(_z_send_n_batch(&g_session, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+        assert(_z_transport_stop_batching(&g_session._tp) == _Z_RES_OK);
+    }
+#else
+    _ZP_UNUSED(batched);
+#endif
+    assert(g_capture.len == expected.len);
+    assert(g_capture.writes == expected.writes);
+    assert(memcmp(g_capture.data, expected.data, expected.len) == 0);
+    assert(ztc->_sn_tx_reliable == next_sn);
+    *writes = expected.writes;
+}
+
+static void test_loan_small(void) {
+    setup();
+    const size_t lens[] = {0, 1, 32, 128};
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(lens); i++) {
+        size_t writes = 0;
+        check_same_bytes(&lens[i], 1, false, &writes);
+        assert(writes == 1);
+    }
+    cleanup();
+    printf("test_loan_small: OK\n");
+}
+
+static void test_loan_fragmented(void) {
+#if Z_FEATURE_FRAGMENTATION == 1
+    setup();
+    const size_t lens[] = {TEST_BATCH_SIZE, 1000, 3000};
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(lens); i++) {
+        size_t writes = 0;
+        check_same_bytes(&lens[i], 1, false, &writes);
+        assert(writes > 1);
+    }
+    cleanup();
+    printf("test_loan_fragmented: OK\n");
+#endif
+}
+
+static void test_loan_batched(void) {
+#if Z_FEATURE_BATCHING == 1
+    setup();
+    size_t writes = 0;
+    // All the puts fit in a single batch
+    const size_t fitting[] = {16, 16, 16, 16};
+    check_same_bytes(fitting, _ZP_ARRAY_SIZE(fitting), true, &writes);
+    assert(writes == 1);
+    // The loaned put overflows the batch which is sent first
+    const size_t overflowing[] = {64, 180, 64, 180};
+    check_same_bytes(overflowing, _ZP_ARRAY_SIZE(overflowing), true, &writes);
+    assert(writes > 1);
+#if Z_FEATURE_FRAGMENTATION == 1
+    // The loaned put doesn't even fit in an empty batch
+    const size_t fragmented[] = {64, 1000, 64};
+    check_same_bytes(fragmented, _ZP_ARRAY_SIZE(fragmented), true, &writes);
+    assert(writes > 2);
+#endif
+    cleanup();
+    printf("test_loan_batched: OK\n");
+#endif
+}
+
+static void test_loan_abort(void) {
+    setup();
+    _z_transport_common_t *ztc = common();
+#if Z_FEATURE_FRAGMENTATION == 1
+    const size_t lens[] = {32, 1000};
+#else
+    const size_t lens[] = {32};
+#endif
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(lens); i++) {
+        _z_zint_t sn = ztc->_sn_tx_reliable;
+        capture_reset();
+        _z_transport_tx_loan_t tx_loan;
+        assert(loan(&tx_loan, lens[i]) == _Z_RES_OK);
+        assert(tx_loan._buf != NULL);
+        _z_send_n_msg_loan_abort(&tx_loan);
+        // Nothing was sent and the sequence number is given back
+        assert(g_capture.writes == 0);
+        assert(ztc->_sn_tx_reliable == sn);
+    }
+    // The transport is still usable
+    size_t writes = 0;
+    check_same_bytes(lens, 1, false, &writes);
+    cleanup();
+    printf("test_loan_abort: OK\n");
+}
+
+int main(void) {
+    test_loan_small();
+    test_loan_fragmented();
+    test_loan_batched();
+    test_loan_abort();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("This test requires: Z_FEATURE_PUBLICATION.\n");
+    return 0;
+}
+#endif